@@ -37,6 +37,18 @@
 #endif
 
 
+// Constructors, common values, simple factories and scalar operators are constexpr when the compiler
+// supports it, so they can be used to build compile-time constant tables. Operations with a SIMD
+// implementation are not constexpr, so runtime code still uses DirectXMath for those.
+// WINDOWS_NUMERICS_HAS_CONSTEXPR tells callers whether this is the case.
+#if !defined _WINDOWS_NUMERICS_CX_PROJECTION_ && (!defined _MSC_VER || _MSC_VER >= 1900)
+#define _WINDOWS_NUMERICS_CONSTEXPR_ constexpr
+#define WINDOWS_NUMERICS_HAS_CONSTEXPR
+#else
+#define _WINDOWS_NUMERICS_CONSTEXPR_
+#endif
+
+
 #ifdef _WINDOWS_NUMERICS_INTEROP_NAMESPACE_
 
 // Define conversion operators between these C++ structs and a set of WinRT ABI types with matching layouts.
@@ -75,8 +87,8 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float2() = default;
-        float2(float x, float y);
-        explicit float2(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float2(float x, float y);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float2(float value);
 
         // Conversion operators.
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float2, Vector2)
@@ -90,39 +102,39 @@ namespace Windows { namespace Foundation { namespace Numerics
 #endif
 
         // Common values.
-        static float2 zero();
-        static float2 one();
-        static float2 unit_x();
-        static float2 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 unit_y();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Operators.
-    float2 operator +(float2 const& value1, float2 const& value2);
-    float2 operator -(float2 const& value1, float2 const& value2);
-    float2 operator *(float2 const& value1, float2 const& value2);
-    float2 operator *(float2 const& value1, float value2);
-    float2 operator *(float value1, float2 const& value2);
-    float2 operator /(float2 const& value1, float2 const& value2);
-    float2 operator /(float2 const& value1, float value2);
-    float2 operator -(float2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator +(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value);
     float2& operator +=(float2& value1, float2 const& value2);
     float2& operator -=(float2& value1, float2 const& value2);
     float2& operator *=(float2& value1, float2 const& value2);
     float2& operator *=(float2& value1, float value2);
     float2& operator /=(float2& value1, float2 const& value2);
     float2& operator /=(float2& value1, float value2);
-    bool operator ==(float2 const& value1, float2 const& value2);
-    bool operator !=(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float2 const& value1, float2 const& value2);
 
     // Functions.
     float length(float2 const& value);
     float length_squared(float2 const& value);
     float distance(float2 const& value1, float2 const& value2);
     float distance_squared(float2 const& value1, float2 const& value2);
-    float dot(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float2 const& value1, float2 const& value2);
     float2 normalize(float2 const& value);
     float2 reflect(float2 const& vector, float2 const& normal);
     float2 (min)(float2 const& value1, float2 const& value2);
@@ -144,47 +156,47 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float3() = default;
-        float3(float x, float y, float z);
-        float3(float2 value, float z);
-        explicit float3(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3(float x, float y, float z);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3(float2 value, float z);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float3(float value);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float3, Vector3)
 
         // Common values.
-        static float3 zero();
-        static float3 one();
-        static float3 unit_x();
-        static float3 unit_y();
-        static float3 unit_z();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 unit_z();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Operators.
-    float3 operator +(float3 const& value1, float3 const& value2);
-    float3 operator -(float3 const& value1, float3 const& value2);
-    float3 operator *(float3 const& value1, float3 const& value2);
-    float3 operator *(float3 const& value1, float value2);
-    float3 operator *(float value1, float3 const& value2);
-    float3 operator /(float3 const& value1, float3 const& value2);
-    float3 operator /(float3 const& value1, float value2);
-    float3 operator -(float3 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator +(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value);
     float3& operator +=(float3& value1, float3 const& value2);
     float3& operator -=(float3& value1, float3 const& value2);
     float3& operator *=(float3& value1, float3 const& value2);
     float3& operator *=(float3& value1, float value2);
     float3& operator /=(float3& value1, float3 const& value2);
     float3& operator /=(float3& value1, float value2);
-    bool operator ==(float3 const& value1, float3 const& value2);
-    bool operator !=(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3 const& value1, float3 const& value2);
 
     // Functions.
     float length(float3 const& value);
     float length_squared(float3 const& value);
     float distance(float3 const& value1, float3 const& value2);
     float distance_squared(float3 const& value1, float3 const& value2);
-    float dot(float3 const& vector1, float3 const& vector2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float3 const& vector1, float3 const& vector2);
     float3 normalize(float3 const& value);
     float3 cross(float3 const& vector1, float3 const& vector2);
     float3 reflect(float3 const& vector, float3 const& normal);
@@ -205,20 +217,20 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float4() = default;
-        float4(float x, float y, float z, float w);
-        float4(float2 value, float z, float w);
-        float4(float3 value, float w);
-        explicit float4(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4(float x, float y, float z, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4(float2 value, float z, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4(float3 value, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float4(float value);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float4, Vector4)
 
         // Common values.
-        static float4 zero();
-        static float4 one();
-        static float4 unit_x();
-        static float4 unit_y();
-        static float4 unit_z();
-        static float4 unit_w();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_z();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_w();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
@@ -239,8 +251,8 @@ namespace Windows { namespace Foundation { namespace Numerics
     float4& operator *=(float4& value1, float value2);
     float4& operator /=(float4& value1, float4 const& value2);
     float4& operator /=(float4& value1, float value2);
-    bool operator ==(float4 const& value1, float4 const& value2);
-    bool operator !=(float4 const& value1, float4 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float4 const& value1, float4 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float4 const& value1, float4 const& value2);
 
     // Functions.
     float length(float4 const& value);
@@ -271,25 +283,25 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float3x2() = default;
-        float3x2(float m11, float m12, float m21, float m22, float m31, float m32);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3x2(float m11, float m12, float m21, float m22, float m31, float m32);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float3x2, Matrix3x2)
 
         // Common values.
-        static float3x2 identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Factory functions.
-    float3x2 make_float3x2_translation(float2 const& position);
-    float3x2 make_float3x2_translation(float xPosition, float yPosition);
-    float3x2 make_float3x2_scale(float xScale, float yScale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float2 const& position);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float xPosition, float yPosition);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale);
     float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint);
-    float3x2 make_float3x2_scale(float2 const& scales);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales);
     float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint);
-    float3x2 make_float3x2_scale(float scale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale);
     float3x2 make_float3x2_scale(float scale, float2 const& centerPoint);
     float3x2 make_float3x2_skew(float radiansX, float radiansY);
     float3x2 make_float3x2_skew(float radiansX, float radiansY, float2 const& centerPoint);
@@ -297,17 +309,17 @@ namespace Windows { namespace Foundation { namespace Numerics
     float3x2 make_float3x2_rotation(float radians, float2 const& centerPoint);
 
     // Operators.
-    float3x2 operator +(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator -(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator *(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator *(float3x2 const& value1, float value2);
-    float3x2 operator -(float3x2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator +(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value);
     float3x2& operator +=(float3x2& value1, float3x2 const& value2);
     float3x2& operator -=(float3x2& value1, float3x2 const& value2);
     float3x2& operator *=(float3x2& value1, float3x2 const& value2);
     float3x2& operator *=(float3x2& value1, float value2);
-    bool operator ==(float3x2 const& value1, float3x2 const& value2);
-    bool operator !=(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3x2 const& value1, float3x2 const& value2);
 
     // Functions.
     bool is_identity(float3x2 const& value);
@@ -328,13 +340,13 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float4x4() = default;
-        float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44);
-        explicit float4x4(float3x2 value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float4x4(float3x2 value);
         
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float4x4, Matrix4x4)
 
         // Common values.
-        static float4x4 identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
@@ -343,13 +355,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     // Factory functions.
     float4x4 make_float4x4_billboard(float3 const& objectPosition, float3 const& cameraPosition, float3 const& cameraUpVector, float3 const& cameraForwardVector);
     float4x4 make_float4x4_constrained_billboard(float3 const& objectPosition, float3 const& cameraPosition, float3 const& rotateAxis, float3 const& cameraForwardVector, float3 const& objectForwardVector);
-    float4x4 make_float4x4_translation(float3 const& position);
-    float4x4 make_float4x4_translation(float xPosition, float yPosition, float zPosition);
-    float4x4 make_float4x4_scale(float xScale, float yScale, float zScale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_translation(float3 const& position);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_translation(float xPosition, float yPosition, float zPosition);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_scale(float xScale, float yScale, float zScale);
     float4x4 make_float4x4_scale(float xScale, float yScale, float zScale, float3 const& centerPoint);
-    float4x4 make_float4x4_scale(float3 const& scales);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_scale(float3 const& scales);
     float4x4 make_float4x4_scale(float3 const& scales, float3 const& centerPoint);
-    float4x4 make_float4x4_scale(float scale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_scale(float scale);
     float4x4 make_float4x4_scale(float scale, float3 const& centerPoint);
     float4x4 make_float4x4_rotation_x(float radians);
     float4x4 make_float4x4_rotation_x(float radians, float3 const& centerPoint);
@@ -380,8 +392,8 @@ namespace Windows { namespace Foundation { namespace Numerics
     float4x4& operator -=(float4x4& value1, float4x4 const& value2);
     float4x4& operator *=(float4x4& value1, float4x4 const& value2);
     float4x4& operator *=(float4x4& value1, float value2);
-    bool operator ==(float4x4 const& value1, float4x4 const& value2);
-    bool operator !=(float4x4 const& value1, float4x4 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float4x4 const& value1, float4x4 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float4x4 const& value1, float4x4 const& value2);
 
     // Functions.
     bool is_identity(float4x4 const& value);
@@ -403,9 +415,9 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         plane() = default;
-        plane(float x, float y, float z, float d);
-        plane(float3 normal, float d);
-        explicit plane(float4 value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ plane(float x, float y, float z, float d);
+        _WINDOWS_NUMERICS_CONSTEXPR_ plane(float3 normal, float d);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit plane(float4 value);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(plane, Plane)
     };
@@ -417,8 +429,8 @@ namespace Windows { namespace Foundation { namespace Numerics
     plane make_plane_from_vertices(float3 const& point1, float3 const& point2, float3 const& point3);
 
     // Operators.
-    bool operator ==(plane const& value1, plane const& value2);
-    bool operator !=(plane const& value1, plane const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(plane const& value1, plane const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(plane const& value1, plane const& value2);
 
     // Functions.
     plane normalize(plane const& value);
@@ -437,13 +449,13 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         quaternion() = default;
-        quaternion(float x, float y, float z, float w);
-        quaternion(float3 vectorPart, float scalarPart);
+        _WINDOWS_NUMERICS_CONSTEXPR_ quaternion(float x, float y, float z, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ quaternion(float3 vectorPart, float scalarPart);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(quaternion, Quaternion)
 
         // Common values.
-        static quaternion identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ quaternion identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
@@ -466,8 +478,8 @@ namespace Windows { namespace Foundation { namespace Numerics
     quaternion& operator *=(quaternion& value1, quaternion const& value2);
     quaternion& operator *=(quaternion& value1, float value2);
     quaternion& operator /=(quaternion& value1, quaternion const& value2);
-    bool operator ==(quaternion const& value1, quaternion const& value2);
-    bool operator !=(quaternion const& value1, quaternion const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(quaternion const& value1, quaternion const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(quaternion const& value1, quaternion const& value2);
 
     // Functions.
     bool is_identity(quaternion const& value);
@@ -510,3 +522,4 @@ namespace DirectX
 #undef _WINDOWS_NUMERICS_CX_PROJECTION_
 #undef _WINDOWS_NUMERICS_INTEROP_NAMESPACE_
 #undef _DEFINE_WINDOWS_NUMERICS_INTEROP_
+#undef _WINDOWS_NUMERICS_CONSTEXPR_
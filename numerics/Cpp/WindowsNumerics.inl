@@ -143,12 +143,12 @@ namespace DirectX
 
 namespace Windows { namespace Foundation { namespace Numerics
 {
-    inline float2::float2(float x, float y)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2::float2(float x, float y)
         : x(x), y(y)
     { }
 
 
-    inline float2::float2(float value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2::float2(float value)
         : x(value), y(value)
     { }
 
@@ -208,78 +208,78 @@ namespace Windows { namespace Foundation { namespace Numerics
 #endif  // __cpluspluswinrt && !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
-    inline float2 float2::zero()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::zero()
     {
         return float2(0, 0);
     }
 
 
-    inline float2 float2::one()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::one()
     {
         return float2(1, 1);
     }
 
 
-    inline float2 float2::unit_x()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::unit_x()
     {
         return float2(1, 0);
     }
 
 
-    inline float2 float2::unit_y()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::unit_y()
     {
         return float2(0, 1);
     }
 
 
-    inline float2 operator +(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator +(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x + value2.x,
                       value1.y + value2.y);
     }
 
 
-    inline float2 operator -(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x - value2.x,
                       value1.y - value2.y);
     }
 
 
-    inline float2 operator *(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x * value2.x,
                       value1.y * value2.y);
     }
 
 
-    inline float2 operator *(float2 const& value1, float value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float value2)
     {
         return float2(value1.x * value2,
                       value1.y * value2);
     }
 
 
-    inline float2 operator *(float value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float value1, float2 const& value2)
     {
         return value2 * value1;
     }
 
 
-    inline float2 operator /(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x / value2.x,
                       value1.y / value2.y);
     }
 
 
-    inline float2 operator /(float2 const& value1, float value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float value2)
     {
         return value1 * (1.0f / value2);
     }
 
 
-    inline float2 operator -(float2 const& value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value)
     {
         return float2(-value.x,
                       -value.y);
@@ -334,14 +334,14 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float2 const& value1, float2 const& value2)
     {
         return value1.x == value2.x &&
                value1.y == value2.y;
     }
 
 
-    inline bool operator !=(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float2 const& value1, float2 const& value2)
     {
         return value1.x != value2.x ||
                value1.y != value2.y;
@@ -372,7 +372,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float dot(float2 const& value1, float2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float2 const& value1, float2 const& value2)
     {
         return value1.x * value2.x +
                value1.y * value2.y;
@@ -471,52 +471,52 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3::float3(float x, float y, float z)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3::float3(float x, float y, float z)
         : x(x), y(y), z(z)
     { }
 
 
-    inline float3::float3(float2 value, float z)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3::float3(float2 value, float z)
         : x(value.x), y(value.y), z(z)
     { }
 
 
-    inline float3::float3(float value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3::float3(float value)
         : x(value), y(value), z(value)
     { }
 
 
-    inline float3 float3::zero()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::zero()
     {
         return float3(0, 0, 0);
     }
 
 
-    inline float3 float3::one()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::one()
     {
         return float3(1, 1, 1);
     }
 
 
-    inline float3 float3::unit_x()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::unit_x()
     {
         return float3(1, 0, 0);
     }
 
 
-    inline float3 float3::unit_y()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::unit_y()
     {
         return float3(0, 1, 0);
     }
 
 
-    inline float3 float3::unit_z()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::unit_z()
     {
         return float3(0, 0, 1);
     }
 
 
-    inline float3 operator +(float3 const& value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator +(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x + value2.x,
                       value1.y + value2.y,
@@ -524,7 +524,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator -(float3 const& value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x - value2.x,
                       value1.y - value2.y,
@@ -532,7 +532,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator *(float3 const& value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x * value2.x,
                       value1.y * value2.y,
@@ -540,7 +540,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator *(float3 const& value1, float value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float value2)
     {
         return float3(value1.x * value2,
                       value1.y * value2,
@@ -548,13 +548,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator *(float value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float value1, float3 const& value2)
     {
         return value2 * value1;
     }
 
 
-    inline float3 operator /(float3 const& value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x / value2.x,
                       value1.y / value2.y,
@@ -562,13 +562,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator /(float3 const& value1, float value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float value2)
     {
         return value1 * (1.0f / value2);
     }
 
 
-    inline float3 operator -(float3 const& value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value)
     {
         return float3(-value.x,
                       -value.y,
@@ -624,7 +624,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float3 const& value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3 const& value1, float3 const& value2)
     {
         return value1.x == value2.x &&
                value1.y == value2.y &&
@@ -632,7 +632,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(float3 const& value1, float3 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3 const& value1, float3 const& value2)
     {
         return value1.x != value2.x ||
                value1.y != value2.y ||
@@ -664,7 +664,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float dot(float3 const& vector1, float3 const& vector2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float3 const& vector1, float3 const& vector2)
     {
         return vector1.x * vector2.x +
                vector1.y * vector2.y +
@@ -767,57 +767,57 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4::float4(float x, float y, float z, float w)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float x, float y, float z, float w)
         : x(x), y(y), z(z), w(w)
     { }
 
 
-    inline float4::float4(float2 value, float z, float w)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float2 value, float z, float w)
         : x(value.x), y(value.y), z(z), w(w)
     { }
 
 
-    inline float4::float4(float3 value, float w)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float3 value, float w)
         : x(value.x), y(value.y), z(value.z), w(w)
     { }
 
 
-    inline float4::float4(float value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float value)
         : x(value), y(value), z(value), w(value)
     { }
 
 
-    inline float4 float4::zero()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::zero()
     {
         return float4(0, 0, 0, 0);
     }
 
 
-    inline float4 float4::one()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::one()
     {
         return float4(1, 1, 1, 1);
     }
 
 
-    inline float4 float4::unit_x()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_x()
     {
         return float4(1, 0, 0, 0);
     }
 
 
-    inline float4 float4::unit_y()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_y()
     {
         return float4(0, 1, 0, 0);
     }
 
 
-    inline float4 float4::unit_z()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_z()
     {
         return float4(0, 0, 1, 0);
     }
 
 
-    inline float4 float4::unit_w()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_w()
     {
         return float4(0, 0, 0, 1);
     }
@@ -985,7 +985,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float4 const& value1, float4 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float4 const& value1, float4 const& value2)
     {
         return value1.x == value2.x &&
                value1.y == value2.y &&
@@ -994,7 +994,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(float4 const& value1, float4 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float4 const& value1, float4 const& value2)
     {
         return value1.x != value2.x ||
                value1.y != value2.y ||
@@ -1201,12 +1201,12 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2::float3x2(float m11, float m12, float m21, float m22, float m31, float m32)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2::float3x2(float m11, float m12, float m21, float m22, float m31, float m32)
         : m11(m11), m12(m12), m21(m21), m22(m22), m31(m31), m32(m32)
     { }
 
 
-    inline float3x2 float3x2::identity()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 float3x2::identity()
     {
         return float3x2(1, 0,
                         0, 1,
@@ -1214,7 +1214,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_translation(float2 const& position)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float2 const& position)
     {
         return float3x2(1, 0,
                         0, 1,
@@ -1222,7 +1222,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_translation(float xPosition, float yPosition)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float xPosition, float yPosition)
     {
         return float3x2(1, 0,
                         0, 1,
@@ -1230,7 +1230,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float xScale, float yScale)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale)
     {
         return float3x2(xScale, 0,
                         0,      yScale,
@@ -1249,7 +1249,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float2 const& scales)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales)
     {
         return float3x2(scales.x, 0,
                         0,        scales.y,
@@ -1267,7 +1267,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float scale)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale)
     {
         return float3x2(scale, 0,
                         0,     scale,
@@ -1367,7 +1367,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator +(float3x2 const& value1, float3x2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator +(float3x2 const& value1, float3x2 const& value2)
     {
         return float3x2(value1.m11 + value2.m11,  value1.m12 + value2.m12,
                         value1.m21 + value2.m21,  value1.m22 + value2.m22,
@@ -1375,7 +1375,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator -(float3x2 const& value1, float3x2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value1, float3x2 const& value2)
     {
         return float3x2(value1.m11 - value2.m11,  value1.m12 - value2.m12,
                         value1.m21 - value2.m21,  value1.m22 - value2.m22,
@@ -1383,7 +1383,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator *(float3x2 const& value1, float3x2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float3x2 const& value2)
     {
         return float3x2
         (
@@ -1402,7 +1402,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator *(float3x2 const& value1, float value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float value2)
     {
         return float3x2(value1.m11 * value2,  value1.m12 * value2,
                         value1.m21 * value2,  value1.m22 * value2,
@@ -1410,7 +1410,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator -(float3x2 const& value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value)
     {
         return float3x2(-value.m11, -value.m12,
                         -value.m21, -value.m22,
@@ -1450,7 +1450,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float3x2 const& value1, float3x2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3x2 const& value1, float3x2 const& value2)
     {
         return value1.m11 == value2.m11 && value1.m22 == value2.m22 && // Check diagonal element first for early out.
                                            value1.m12 == value2.m12 &&
@@ -1459,7 +1459,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(float3x2 const& value1, float3x2 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3x2 const& value1, float3x2 const& value2)
     {
         return value1.m11 != value2.m11 || value1.m12 != value2.m12 ||
                value1.m21 != value2.m21 || value1.m22 != value2.m22 ||
@@ -1526,7 +1526,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4::float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4::float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44)
         : m11(m11), m12(m12), m13(m13), m14(m14),
           m21(m21), m22(m22), m23(m23), m24(m24),
           m31(m31), m32(m32), m33(m33), m34(m34),
@@ -1534,7 +1534,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     { }
 
 
-    inline float4x4::float4x4(float3x2 value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4::float4x4(float3x2 value)
         : m11(value.m11), m12(value.m12), m13(0), m14(0),
           m21(value.m21), m22(value.m22), m23(0), m24(0),
           m31(0),         m32(0),         m33(1), m34(0),
@@ -1542,7 +1542,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     { }
 
 
-    inline float4x4 float4x4::identity()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 float4x4::identity()
     {
         return float4x4(1, 0, 0, 0,
                         0, 1, 0, 0,
@@ -1628,7 +1628,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4 make_float4x4_translation(float3 const& position)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_translation(float3 const& position)
     {
         return float4x4(1, 0, 0, 0,
                         0, 1, 0, 0,
@@ -1637,7 +1637,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4 make_float4x4_translation(float xPosition, float yPosition, float zPosition)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_translation(float xPosition, float yPosition, float zPosition)
     {
         return float4x4(1, 0, 0, 0,
                         0, 1, 0, 0,
@@ -1646,7 +1646,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4 make_float4x4_scale(float xScale, float yScale, float zScale)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_scale(float xScale, float yScale, float zScale)
     {
         return float4x4(xScale, 0,      0,      0,
                         0,      yScale, 0,      0,
@@ -1668,7 +1668,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4 make_float4x4_scale(float3 const& scales)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_scale(float3 const& scales)
     {
         return float4x4(scales.x, 0,        0,        0,
                         0,        scales.y, 0,        0,
@@ -1688,7 +1688,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4 make_float4x4_scale(float scale)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 make_float4x4_scale(float scale)
     {
         return float4x4(scale, 0,     0,     0,
                         0,     scale, 0,     0,
@@ -2139,7 +2139,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float4x4 const& value1, float4x4 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float4x4 const& value1, float4x4 const& value2)
     {
         return value1.m11 == value2.m11 && value1.m22 == value2.m22 && value1.m33 == value2.m33 && value1.m44 == value2.m44 && // Check diagonal element first for early out.
                                            value1.m12 == value2.m12 && value1.m13 == value2.m13 && value1.m14 == value2.m14 &&
@@ -2149,7 +2149,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(float4x4 const& value1, float4x4 const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float4x4 const& value1, float4x4 const& value2)
     {
         return value1.m11 != value2.m11 || value1.m12 != value2.m12 || value1.m13 != value2.m13 || value1.m14 != value2.m14 ||
                value1.m21 != value2.m21 || value1.m22 != value2.m22 || value1.m23 != value2.m23 || value1.m24 != value2.m24 ||
@@ -2218,6 +2218,7 @@ namespace Windows { namespace Foundation { namespace Numerics
 
     inline bool invert(float4x4 const& matrix, _Out_ float4x4* result)
     {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
         //                                       -1
         // If you have matrix M, inverse Matrix M   can compute
         //
@@ -2375,6 +2376,27 @@ namespace Windows { namespace Foundation { namespace Numerics
         result->m44 = +(a * fk_gj - b * ek_gi + c * ej_fi) * invDet;
 
         return true;
+#else
+        using namespace ::DirectX;
+
+        XMVECTOR det;
+        XMMATRIX inverse = XMMatrixInverse(&det, XMLoadFloat4x4(&matrix));
+
+        // Match the scalar implementation's rules for what counts as singular.
+        if (fabs(XMVectorGetX(det)) < FLT_EPSILON)
+        {
+            const float nan = _WINDOWS_NUMERICS_NAN_;
+
+            *result = float4x4(nan, nan, nan, nan,
+                               nan, nan, nan, nan,
+                               nan, nan, nan, nan,
+                               nan, nan, nan, nan);
+            return false;
+        }
+
+        XMStoreFloat4x4(result, inverse);
+        return true;
+#endif
     }
 
 
@@ -2478,17 +2500,17 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline plane::plane(float x, float y, float z, float d)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ plane::plane(float x, float y, float z, float d)
         : normal(x, y, z), d(d)
     { }
 
 
-    inline plane::plane(float3 normal, float d)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ plane::plane(float3 normal, float d)
         : normal(normal), d(d)
     { }
 
 
-    inline plane::plane(float4 value)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ plane::plane(float4 value)
         : normal(value.x, value.y, value.z), d(value.w)
     { }
 
@@ -2505,7 +2527,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(plane const& value1, plane const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(plane const& value1, plane const& value2)
     {
         return value1.normal.x == value2.normal.x &&
                value1.normal.y == value2.normal.y &&
@@ -2514,7 +2536,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(plane const& value1, plane const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(plane const& value1, plane const& value2)
     {
         return value1.normal.x != value2.normal.x ||
                value1.normal.y != value2.normal.y || 
@@ -2599,17 +2621,17 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline quaternion::quaternion(float x, float y, float z, float w)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ quaternion::quaternion(float x, float y, float z, float w)
         : x(x), y(y), z(z), w(w)
     { }
 
 
-    inline quaternion::quaternion(float3 vectorPart, float scalarPart)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ quaternion::quaternion(float3 vectorPart, float scalarPart)
         : x(vectorPart.x), y(vectorPart.y), z(vectorPart.z), w(scalarPart)
     { }
 
 
-    inline quaternion quaternion::identity()
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ quaternion quaternion::identity()
     {
         return quaternion(0, 0, 0, 1);
     }
@@ -2827,7 +2849,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(quaternion const& value1, quaternion const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(quaternion const& value1, quaternion const& value2)
     {
         return value1.x == value2.x &&
                value1.y == value2.y &&
@@ -2836,7 +2858,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(quaternion const& value1, quaternion const& value2)
+    inline _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(quaternion const& value1, quaternion const& value2)
     {
         return value1.x != value2.x ||
                value1.y != value2.y ||
@@ -2906,6 +2928,7 @@ namespace Windows { namespace Foundation { namespace Numerics
 
     inline quaternion slerp(quaternion const& quaternion1, quaternion const& quaternion2, float amount)
     {
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
         const float epsilon = 1e-6f;
 
         float t = amount;
@@ -2936,7 +2959,6 @@ namespace Windows { namespace Foundation { namespace Numerics
                       :  sinf(t * omega) * invSinOmega;
         }
 
-#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
         return quaternion(s1 * quaternion1.x + s2 * quaternion2.x,
                           s1 * quaternion1.y + s2 * quaternion2.y,
                           s1 * quaternion1.z + s2 * quaternion2.z,
@@ -2944,11 +2966,8 @@ namespace Windows { namespace Foundation { namespace Numerics
 #else
         using namespace ::DirectX;
 
-        XMVECTOR q1 = XMVectorScale(XMLoadQuaternion(&quaternion1), s1);
-        XMVECTOR q2 = XMVectorScale(XMLoadQuaternion(&quaternion2), s2);
-
         quaternion result;
-        XMStoreQuaternion(&result, XMVectorAdd(q1, q2));
+        XMStoreQuaternion(&result, XMQuaternionSlerp(XMLoadQuaternion(&quaternion1), XMLoadQuaternion(&quaternion2), amount));
         return result;
 #endif
     }
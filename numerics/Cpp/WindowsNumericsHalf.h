@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "WindowsNumerics.h"
+
+#include <stdint.h>
+
+
+namespace Windows { namespace Foundation { namespace Numerics
+{
+    struct half;
+    struct half2;
+    struct half4;
+
+
+    // IEEE 754 half precision (binary16) value, with the same layout as DXGI_FORMAT_R16_FLOAT.
+    // This is a storage format: there are no arithmetic operators, so values are converted
+    // to float for math and back to half when stored. Conversion rounds to nearest even.
+    struct half
+    {
+        uint16_t bits;
+
+        // Constructors.
+        half() = default;
+        explicit half(float value);
+
+        static half from_bits(uint16_t bits);
+
+        // Conversion operators.
+        operator float() const;
+    };
+
+
+    // Operators.
+    bool operator ==(half const& value1, half const& value2);
+    bool operator !=(half const& value1, half const& value2);
+
+
+    // Pair of half values, with the same layout as DXGI_FORMAT_R16G16_FLOAT.
+    struct half2
+    {
+        half x, y;
+
+        // Constructors.
+        half2() = default;
+        half2(half x, half y);
+        explicit half2(float2 const& value);
+
+        // Conversion operators.
+        operator float2() const;
+    };
+
+
+    // Operators.
+    bool operator ==(half2 const& value1, half2 const& value2);
+    bool operator !=(half2 const& value1, half2 const& value2);
+
+
+    // Four half values, with the same layout as DXGI_FORMAT_R16G16B16A16_FLOAT.
+    struct half4
+    {
+        half x, y, z, w;
+
+        // Constructors.
+        half4() = default;
+        half4(half x, half y, half z, half w);
+        explicit half4(float4 const& value);
+
+        // Conversion operators.
+        operator float4() const;
+    };
+
+
+    // Operators.
+    bool operator ==(half4 const& value1, half4 const& value2);
+    bool operator !=(half4 const& value1, half4 const& value2);
+
+
+    // Bulk conversions, using F16C instructions when the CPU supports them. The results
+    // are identical to converting each value individually.
+    void convert_to_half(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) half* destination);
+    void convert_to_half(_In_reads_(count) float2 const* source, size_t count, _Out_writes_(count) half2* destination);
+    void convert_to_half(_In_reads_(count) float4 const* source, size_t count, _Out_writes_(count) half4* destination);
+
+    void convert_to_float(_In_reads_(count) half const* source, size_t count, _Out_writes_(count) float* destination);
+    void convert_to_float(_In_reads_(count) half2 const* source, size_t count, _Out_writes_(count) float2* destination);
+    void convert_to_float(_In_reads_(count) half4 const* source, size_t count, _Out_writes_(count) float4* destination);
+}}}
+
+
+#include "WindowsNumericsHalf.inl"
@@ -0,0 +1,374 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+
+// The F16C conversion instructions are only available on x86 and x64, and are
+// selected at runtime because not every CPU of those architectures has them.
+#if !defined WINDOWS_NUMERICS_DISABLE_SIMD && (defined _M_IX86 || defined _M_X64 || defined __i386__ || defined __x86_64__)
+
+#define _WINDOWS_NUMERICS_F16C_
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define _WINDOWS_NUMERICS_F16C_TARGET_
+#else
+#include <cpuid.h>
+#define _WINDOWS_NUMERICS_F16C_TARGET_ __attribute__((target("f16c")))
+#endif
+
+#endif
+
+
+namespace Windows { namespace Foundation { namespace Numerics
+{
+    namespace half_details
+    {
+        inline uint32_t float_to_bits(float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+
+        inline float bits_to_float(uint32_t bits)
+        {
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+
+        // Portable conversion, rounding to nearest even. This gives the same results
+        // as the F16C instructions, including the treatment of NaN payloads.
+        inline uint16_t float_to_half(float value)
+        {
+            uint32_t f = float_to_bits(value);
+            uint32_t sign = (f >> 16) & 0x8000;
+
+            f &= 0x7FFFFFFF;
+
+            if (f >= 0x7F800000)
+            {
+                // Infinity stays infinity, while NaN is quieted and keeps the top of its payload.
+                return static_cast<uint16_t>(sign | ((f > 0x7F800000) ? (0x7E00 | ((f >> 13) & 0x3FF)) : 0x7C00));
+            }
+
+            if (f >= 0x477FF000)
+            {
+                // Too large for half, including values that round up past the largest finite half.
+                return static_cast<uint16_t>(sign | 0x7C00);
+            }
+
+            if (f < 0x38800000)
+            {
+                // Below the smallest normal half, so the result is denormal or zero.
+                uint32_t exponent = f >> 23;
+
+                if (exponent < 102)
+                    return static_cast<uint16_t>(sign);
+
+                uint32_t mantissa = (f & 0x7FFFFF) | 0x800000;
+                uint32_t shift = 126 - exponent;
+                uint32_t result = mantissa >> shift;
+                uint32_t remainder = mantissa & ((1u << shift) - 1);
+                uint32_t halfway = 1u << (shift - 1);
+
+                if (remainder > halfway || (remainder == halfway && (result & 1)))
+                    result++;
+
+                return static_cast<uint16_t>(sign | result);
+            }
+
+            // Normal values: rebias the exponent and round away the low 13 mantissa bits.
+            // Rounding up can carry into the exponent, which gives the correct result.
+            f -= 112u << 23;
+            f += 0xFFF + ((f >> 13) & 1);
+
+            return static_cast<uint16_t>(sign | (f >> 13));
+        }
+
+
+        inline float half_to_float(uint16_t value)
+        {
+            uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+            uint32_t exponent = (value >> 10) & 0x1F;
+            uint32_t mantissa = value & 0x3FF;
+
+            if (exponent == 0x1F)
+            {
+                // Infinity or NaN. Signaling NaNs are quieted, as with the F16C instructions.
+                return bits_to_float(sign | 0x7F800000 | (mantissa ? (0x400000 | (mantissa << 13)) : 0));
+            }
+
+            if (exponent == 0)
+            {
+                // Zero or denormal, which is always a normal float.
+                float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+
+                return sign ? -magnitude : magnitude;
+            }
+
+            return bits_to_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+        }
+
+
+        inline void convert_to_half_portable(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) half* destination)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                destination[i].bits = float_to_half(source[i]);
+            }
+        }
+
+
+        inline void convert_to_float_portable(_In_reads_(count) half const* source, size_t count, _Out_writes_(count) float* destination)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                destination[i] = half_to_float(source[i].bits);
+            }
+        }
+
+
+#ifdef _WINDOWS_NUMERICS_F16C_
+
+        // F16C uses VEX encoded instructions, so as well as the CPUID feature
+        // bit we need the OS to have enabled saving the AVX register state.
+        inline bool detect_f16c()
+        {
+            const uint32_t osxsaveBit = 1u << 27;
+            const uint32_t avxBit = 1u << 28;
+            const uint32_t f16cBit = 1u << 29;
+            const uint32_t requiredBits = osxsaveBit | avxBit | f16cBit;
+
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 1);
+            uint32_t features = static_cast<uint32_t>(info[2]);
+#else
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+                return false;
+            uint32_t features = ecx;
+#endif
+
+            if ((features & requiredBits) != requiredBits)
+                return false;
+
+#ifdef _MSC_VER
+            unsigned long long xcr0 = _xgetbv(0);
+#else
+            unsigned int xcr0Low, xcr0High;
+            __asm__ ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+            unsigned long long xcr0 = xcr0Low;
+#endif
+
+            // XMM and YMM state.
+            return (xcr0 & 6) == 6;
+        }
+
+
+        inline bool has_f16c()
+        {
+            static const bool result = detect_f16c();
+            return result;
+        }
+
+
+        _WINDOWS_NUMERICS_F16C_TARGET_
+        inline void convert_to_half_f16c(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) half* destination)
+        {
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 value = _mm_loadu_ps(source + i);
+                __m128i result = _mm_cvtps_ph(value, 0);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i), result);
+            }
+
+            convert_to_half_portable(source + i, count - i, destination + i);
+        }
+
+
+        _WINDOWS_NUMERICS_F16C_TARGET_
+        inline void convert_to_float_f16c(_In_reads_(count) half const* source, size_t count, _Out_writes_(count) float* destination)
+        {
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i value = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(source + i));
+                __m128 result = _mm_cvtph_ps(value);
+                _mm_storeu_ps(destination + i, result);
+            }
+
+            convert_to_float_portable(source + i, count - i, destination + i);
+        }
+
+#endif
+    }
+
+
+    inline half::half(float value)
+        : bits(half_details::float_to_half(value))
+    { }
+
+
+    inline half half::from_bits(uint16_t bits)
+    {
+        half result;
+        result.bits = bits;
+        return result;
+    }
+
+
+    inline half::operator float() const
+    {
+        return half_details::half_to_float(bits);
+    }
+
+
+    inline bool operator ==(half const& value1, half const& value2)
+    {
+        return static_cast<float>(value1) == static_cast<float>(value2);
+    }
+
+
+    inline bool operator !=(half const& value1, half const& value2)
+    {
+        return !(value1 == value2);
+    }
+
+
+    inline half2::half2(half x, half y)
+        : x(x), y(y)
+    { }
+
+
+    inline half2::half2(float2 const& value)
+        : x(value.x), y(value.y)
+    { }
+
+
+    inline half2::operator float2() const
+    {
+        return float2(x, y);
+    }
+
+
+    inline bool operator ==(half2 const& value1, half2 const& value2)
+    {
+        return value1.x == value2.x
+            && value1.y == value2.y;
+    }
+
+
+    inline bool operator !=(half2 const& value1, half2 const& value2)
+    {
+        return !(value1 == value2);
+    }
+
+
+    inline half4::half4(half x, half y, half z, half w)
+        : x(x), y(y), z(z), w(w)
+    { }
+
+
+    inline half4::half4(float4 const& value)
+        : x(value.x), y(value.y), z(value.z), w(value.w)
+    { }
+
+
+    inline half4::operator float4() const
+    {
+        return float4(x, y, z, w);
+    }
+
+
+    inline bool operator ==(half4 const& value1, half4 const& value2)
+    {
+        return value1.x == value2.x
+            && value1.y == value2.y
+            && value1.z == value2.z
+            && value1.w == value2.w;
+    }
+
+
+    inline bool operator !=(half4 const& value1, half4 const& value2)
+    {
+        return !(value1 == value2);
+    }
+
+
+    inline void convert_to_half(_In_reads_(count) float const* source, size_t count, _Out_writes_(count) half* destination)
+    {
+#ifdef _WINDOWS_NUMERICS_F16C_
+        if (half_details::has_f16c())
+        {
+            half_details::convert_to_half_f16c(source, count, destination);
+            return;
+        }
+#endif
+
+        half_details::convert_to_half_portable(source, count, destination);
+    }
+
+
+    inline void convert_to_half(_In_reads_(count) float2 const* source, size_t count, _Out_writes_(count) half2* destination)
+    {
+        convert_to_half(&source->x, count * 2, &destination->x);
+    }
+
+
+    inline void convert_to_half(_In_reads_(count) float4 const* source, size_t count, _Out_writes_(count) half4* destination)
+    {
+        convert_to_half(&source->x, count * 4, &destination->x);
+    }
+
+
+    inline void convert_to_float(_In_reads_(count) half const* source, size_t count, _Out_writes_(count) float* destination)
+    {
+#ifdef _WINDOWS_NUMERICS_F16C_
+        if (half_details::has_f16c())
+        {
+            half_details::convert_to_float_f16c(source, count, destination);
+            return;
+        }
+#endif
+
+        half_details::convert_to_float_portable(source, count, destination);
+    }
+
+
+    inline void convert_to_float(_In_reads_(count) half2 const* source, size_t count, _Out_writes_(count) float2* destination)
+    {
+        convert_to_float(&source->x, count * 2, &destination->x);
+    }
+
+
+    inline void convert_to_float(_In_reads_(count) half4 const* source, size_t count, _Out_writes_(count) float4* destination)
+    {
+        convert_to_float(&source->x, count * 4, &destination->x);
+    }
+}}}
+
+
+#ifdef _WINDOWS_NUMERICS_F16C_
+#undef _WINDOWS_NUMERICS_F16C_
+#undef _WINDOWS_NUMERICS_F16C_TARGET_
+#endif
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "WindowsNumerics.h"
+
+
+namespace Windows { namespace Foundation { namespace Numerics
+{
+    // Structure-of-arrays container for float2, float3 or float4 values. Rather than
+    // storing whole vectors one after another, each component is kept in its own
+    // stream of floats. The streams are 16 byte aligned and padded to a multiple of
+    // four elements, so bulk operations can process four vectors per SIMD instruction
+    // without any special handling for a partial block at the end.
+    template<typename T>
+    class soa_array
+    {
+    public:
+        static const size_t component_count = sizeof(T) / sizeof(float);
+
+        // Constructors.
+        soa_array();
+        explicit soa_array(size_t size);
+        soa_array(_In_reads_(count) T const* values, size_t count);
+        soa_array(soa_array const& value);
+        soa_array(soa_array&& value);
+        ~soa_array();
+
+        // Assignment.
+        soa_array& operator =(soa_array const& value);
+        soa_array& operator =(soa_array&& value);
+
+        // Size management. Newly added elements are zero.
+        size_t size() const;
+        size_t capacity() const;
+        bool empty() const;
+        void resize(size_t size);
+        void reserve(size_t capacity);
+        void clear();
+
+        // Element access, converting individual values to and from their AoS form.
+        T get(size_t index) const;
+        void set(size_t index, T const& value);
+        void push_back(T const& value);
+
+        // Bulk conversion to and from arrays of AoS values.
+        void assign(_In_reads_(count) T const* values, size_t count);
+        void copy_to(_Out_writes_(size()) T* values) const;
+
+        // Component streams.
+        float* component(size_t index);
+        float const* component(size_t index) const;
+
+        float* x();
+        float* y();
+        float* z();
+        float* w();
+
+        float const* x() const;
+        float const* y() const;
+        float const* z() const;
+        float const* w() const;
+
+    private:
+        void reallocate(size_t capacity);
+
+        float* m_allocation;
+        float* m_data;
+        size_t m_size;
+        size_t m_capacity;
+    };
+
+
+    typedef soa_array<float2> float2_soa;
+    typedef soa_array<float3> float3_soa;
+    typedef soa_array<float4> float4_soa;
+
+
+    // Element-wise operations. The inputs must all have the same size. The result is
+    // resized to match, and may be the same object as one of the inputs.
+    template<typename T> void add(soa_array<T> const& value1, soa_array<T> const& value2, _Out_ soa_array<T>* result);
+    template<typename T> void subtract(soa_array<T> const& value1, soa_array<T> const& value2, _Out_ soa_array<T>* result);
+    template<typename T> void multiply(soa_array<T> const& value1, soa_array<T> const& value2, _Out_ soa_array<T>* result);
+    template<typename T> void scale(soa_array<T> const& value, float factor, _Out_ soa_array<T>* result);
+    template<typename T> void lerp(soa_array<T> const& value1, soa_array<T> const& value2, float amount, _Out_ soa_array<T>* result);
+    template<typename T> void normalize(soa_array<T> const& value, _Out_ soa_array<T>* result);
+
+    // Per-element reductions, writing one float for each element of the input.
+    template<typename T> void dot(soa_array<T> const& value1, soa_array<T> const& value2, _Out_writes_(value1.size()) float* result);
+    template<typename T> void length(soa_array<T> const& value, _Out_writes_(value.size()) float* result);
+    template<typename T> void length_squared(soa_array<T> const& value, _Out_writes_(value.size()) float* result);
+
+    // Transforms.
+    void transform(float2_soa const& positions, float3x2 const& matrix, _Out_ float2_soa* result);
+    void transform(float2_soa const& positions, float4x4 const& matrix, _Out_ float2_soa* result);
+    void transform(float3_soa const& positions, float4x4 const& matrix, _Out_ float3_soa* result);
+    void transform(float4_soa const& vectors, float4x4 const& matrix, _Out_ float4_soa* result);
+}}}
+
+
+#include "WindowsNumericsSoA.inl"
@@ -0,0 +1,906 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma warning(push)
+#pragma warning(disable: 4702) // unreachable code (after a throw)
+
+#include <stdint.h>
+#include <string.h>
+
+
+#ifdef _CPPUNWIND
+
+#include <stdexcept>
+
+#define _WINDOWS_NUMERICS_THROW_(e) throw e
+
+#else
+
+#define _WINDOWS_NUMERICS_THROW_(e) (void)0
+
+#endif
+
+
+namespace Windows { namespace Foundation { namespace Numerics
+{
+    namespace soa_details
+    {
+        // Component streams are always padded to a multiple of four floats.
+        inline size_t padded_size(size_t size)
+        {
+            return (size + 3) & ~static_cast<size_t>(3);
+        }
+
+
+        template<typename T>
+        inline bool validate_sizes(soa_array<T> const& value1, soa_array<T> const& value2)
+        {
+            if (value1.size() == value2.size())
+                return true;
+
+            _WINDOWS_NUMERICS_THROW_(std::invalid_argument("soa_array sizes do not match"));
+            return false;
+        }
+
+
+#ifndef WINDOWS_NUMERICS_DISABLE_SIMD
+
+        inline ::DirectX::XMVECTOR XM_CALLCONV load(float const* source)
+        {
+            return ::DirectX::XMLoadFloat4A(reinterpret_cast<::DirectX::XMFLOAT4A const*>(source));
+        }
+
+
+        inline void XM_CALLCONV store(float* destination, ::DirectX::FXMVECTOR value)
+        {
+            ::DirectX::XMStoreFloat4A(reinterpret_cast<::DirectX::XMFLOAT4A*>(destination), value);
+        }
+
+
+        // Stores up to four lanes to caller-provided memory, which is neither aligned nor padded.
+        inline void XM_CALLCONV store_unpadded(float* destination, ::DirectX::FXMVECTOR value, size_t count)
+        {
+            if (count >= 4)
+            {
+                ::DirectX::XMStoreFloat4(reinterpret_cast<::DirectX::XMFLOAT4*>(destination), value);
+            }
+            else
+            {
+                ::DirectX::XMFLOAT4A lanes;
+                ::DirectX::XMStoreFloat4A(&lanes, value);
+                memcpy(destination, &lanes, count * sizeof(float));
+            }
+        }
+
+#endif
+    }
+
+
+    template<typename T>
+    inline soa_array<T>::soa_array()
+        : m_allocation(nullptr), m_data(nullptr), m_size(0), m_capacity(0)
+    { }
+
+
+    template<typename T>
+    inline soa_array<T>::soa_array(size_t size)
+        : m_allocation(nullptr), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        resize(size);
+    }
+
+
+    template<typename T>
+    inline soa_array<T>::soa_array(_In_reads_(count) T const* values, size_t count)
+        : m_allocation(nullptr), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        assign(values, count);
+    }
+
+
+    template<typename T>
+    inline soa_array<T>::soa_array(soa_array const& value)
+        : m_allocation(nullptr), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        *this = value;
+    }
+
+
+    template<typename T>
+    inline soa_array<T>::soa_array(soa_array&& value)
+        : m_allocation(value.m_allocation), m_data(value.m_data), m_size(value.m_size), m_capacity(value.m_capacity)
+    {
+        value.m_allocation = nullptr;
+        value.m_data = nullptr;
+        value.m_size = 0;
+        value.m_capacity = 0;
+    }
+
+
+    template<typename T>
+    inline soa_array<T>::~soa_array()
+    {
+        delete[] m_allocation;
+    }
+
+
+    template<typename T>
+    inline soa_array<T>& soa_array<T>::operator =(soa_array const& value)
+    {
+        if (this != &value)
+        {
+            resize(value.m_size);
+
+            for (size_t c = 0; c < component_count; c++)
+            {
+                memcpy(component(c), value.component(c), m_size * sizeof(float));
+            }
+        }
+
+        return *this;
+    }
+
+
+    template<typename T>
+    inline soa_array<T>& soa_array<T>::operator =(soa_array&& value)
+    {
+        if (this != &value)
+        {
+            delete[] m_allocation;
+
+            m_allocation = value.m_allocation;
+            m_data = value.m_data;
+            m_size = value.m_size;
+            m_capacity = value.m_capacity;
+
+            value.m_allocation = nullptr;
+            value.m_data = nullptr;
+            value.m_size = 0;
+            value.m_capacity = 0;
+        }
+
+        return *this;
+    }
+
+
+    template<typename T>
+    inline size_t soa_array<T>::size() const
+    {
+        return m_size;
+    }
+
+
+    template<typename T>
+    inline size_t soa_array<T>::capacity() const
+    {
+        return m_capacity;
+    }
+
+
+    template<typename T>
+    inline bool soa_array<T>::empty() const
+    {
+        return m_size == 0;
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::resize(size_t size)
+    {
+        if (size > m_capacity)
+        {
+            reallocate(soa_details::padded_size(size));
+        }
+
+        if (size > m_size)
+        {
+            // Bulk operations write to the padding lanes, so these may not be zero even
+            // if they have never been part of the array. Clear through to the end of the
+            // last block, which leaves no stale values anywhere after the new size.
+            size_t clearCount = soa_details::padded_size(size) - m_size;
+
+            for (size_t c = 0; c < component_count; c++)
+            {
+                memset(component(c) + m_size, 0, clearCount * sizeof(float));
+            }
+        }
+
+        m_size = size;
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::reserve(size_t capacity)
+    {
+        if (capacity > m_capacity)
+        {
+            reallocate(soa_details::padded_size(capacity));
+        }
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::clear()
+    {
+        m_size = 0;
+    }
+
+
+    template<typename T>
+    inline T soa_array<T>::get(size_t index) const
+    {
+        T result;
+        float* components = reinterpret_cast<float*>(&result);
+
+        for (size_t c = 0; c < component_count; c++)
+        {
+            components[c] = component(c)[index];
+        }
+
+        return result;
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::set(size_t index, T const& value)
+    {
+        float const* components = reinterpret_cast<float const*>(&value);
+
+        for (size_t c = 0; c < component_count; c++)
+        {
+            component(c)[index] = components[c];
+        }
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::push_back(T const& value)
+    {
+        if (m_size == m_capacity)
+        {
+            reallocate(m_capacity ? m_capacity * 2 : 4);
+        }
+
+        set(m_size++, value);
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::assign(_In_reads_(count) T const* values, size_t count)
+    {
+        // Discard the old contents before growing, so reallocate has nothing to copy.
+        m_size = 0;
+
+        if (count > m_capacity)
+        {
+            reallocate(soa_details::padded_size(count));
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            float const* components = reinterpret_cast<float const*>(&values[i]);
+
+            for (size_t c = 0; c < component_count; c++)
+            {
+                component(c)[i] = components[c];
+            }
+        }
+
+        size_t paddingCount = soa_details::padded_size(count) - count;
+
+        for (size_t c = 0; c < component_count; c++)
+        {
+            memset(component(c) + count, 0, paddingCount * sizeof(float));
+        }
+
+        m_size = count;
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::copy_to(_Out_writes_(size()) T* values) const
+    {
+        for (size_t i = 0; i < m_size; i++)
+        {
+            float* components = reinterpret_cast<float*>(&values[i]);
+
+            for (size_t c = 0; c < component_count; c++)
+            {
+                components[c] = component(c)[i];
+            }
+        }
+    }
+
+
+    template<typename T>
+    inline float* soa_array<T>::component(size_t index)
+    {
+        return m_data + index * m_capacity;
+    }
+
+
+    template<typename T>
+    inline float const* soa_array<T>::component(size_t index) const
+    {
+        return m_data + index * m_capacity;
+    }
+
+
+    template<typename T>
+    inline float* soa_array<T>::x()
+    {
+        return component(0);
+    }
+
+
+    template<typename T>
+    inline float* soa_array<T>::y()
+    {
+        return component(1);
+    }
+
+
+    template<typename T>
+    inline float* soa_array<T>::z()
+    {
+        static_assert(component_count >= 3, "soa_array has no z component");
+        return component(2);
+    }
+
+
+    template<typename T>
+    inline float* soa_array<T>::w()
+    {
+        static_assert(component_count >= 4, "soa_array has no w component");
+        return component(3);
+    }
+
+
+    template<typename T>
+    inline float const* soa_array<T>::x() const
+    {
+        return component(0);
+    }
+
+
+    template<typename T>
+    inline float const* soa_array<T>::y() const
+    {
+        return component(1);
+    }
+
+
+    template<typename T>
+    inline float const* soa_array<T>::z() const
+    {
+        static_assert(component_count >= 3, "soa_array has no z component");
+        return component(2);
+    }
+
+
+    template<typename T>
+    inline float const* soa_array<T>::w() const
+    {
+        static_assert(component_count >= 4, "soa_array has no w component");
+        return component(3);
+    }
+
+
+    template<typename T>
+    inline void soa_array<T>::reallocate(size_t capacity)
+    {
+        // All the component streams share a single allocation. This is zero initialized (so
+        // padding lanes start out zero) and has three floats of slack, enough to round the
+        // data pointer up to the 16 byte alignment needed for aligned SIMD loads and stores.
+        float* allocation = new float[capacity * component_count + 3]();
+        float* data = reinterpret_cast<float*>((reinterpret_cast<uintptr_t>(allocation) + 15) & ~static_cast<uintptr_t>(15));
+
+        for (size_t c = 0; c < component_count; c++)
+        {
+            if (m_size)
+            {
+                memcpy(data + c * capacity, component(c), m_size * sizeof(float));
+            }
+        }
+
+        delete[] m_allocation;
+
+        m_allocation = allocation;
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+
+    template<typename T>
+    inline void add(soa_array<T> const& value1, soa_array<T> const& value2, _Out_ soa_array<T>* result)
+    {
+        if (!soa_details::validate_sizes(value1, value2))
+            return;
+
+        size_t size = value1.size();
+        result->resize(size);
+
+        for (size_t c = 0; c < soa_array<T>::component_count; c++)
+        {
+            float const* a = value1.component(c);
+            float const* b = value2.component(c);
+            float* r = result->component(c);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+            for (size_t i = 0; i < size; i++)
+            {
+                r[i] = a[i] + b[i];
+            }
+#else
+            using namespace ::DirectX;
+            using namespace soa_details;
+
+            for (size_t i = 0; i < size; i += 4)
+            {
+                store(r + i, XMVectorAdd(load(a + i), load(b + i)));
+            }
+#endif
+        }
+    }
+
+
+    template<typename T>
+    inline void subtract(soa_array<T> const& value1, soa_array<T> const& value2, _Out_ soa_array<T>* result)
+    {
+        if (!soa_details::validate_sizes(value1, value2))
+            return;
+
+        size_t size = value1.size();
+        result->resize(size);
+
+        for (size_t c = 0; c < soa_array<T>::component_count; c++)
+        {
+            float const* a = value1.component(c);
+            float const* b = value2.component(c);
+            float* r = result->component(c);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+            for (size_t i = 0; i < size; i++)
+            {
+                r[i] = a[i] - b[i];
+            }
+#else
+            using namespace ::DirectX;
+            using namespace soa_details;
+
+            for (size_t i = 0; i < size; i += 4)
+            {
+                store(r + i, XMVectorSubtract(load(a + i), load(b + i)));
+            }
+#endif
+        }
+    }
+
+
+    template<typename T>
+    inline void multiply(soa_array<T> const& value1, soa_array<T> const& value2, _Out_ soa_array<T>* result)
+    {
+        if (!soa_details::validate_sizes(value1, value2))
+            return;
+
+        size_t size = value1.size();
+        result->resize(size);
+
+        for (size_t c = 0; c < soa_array<T>::component_count; c++)
+        {
+            float const* a = value1.component(c);
+            float const* b = value2.component(c);
+            float* r = result->component(c);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+            for (size_t i = 0; i < size; i++)
+            {
+                r[i] = a[i] * b[i];
+            }
+#else
+            using namespace ::DirectX;
+            using namespace soa_details;
+
+            for (size_t i = 0; i < size; i += 4)
+            {
+                store(r + i, XMVectorMultiply(load(a + i), load(b + i)));
+            }
+#endif
+        }
+    }
+
+
+    template<typename T>
+    inline void scale(soa_array<T> const& value, float factor, _Out_ soa_array<T>* result)
+    {
+        size_t size = value.size();
+        result->resize(size);
+
+        for (size_t c = 0; c < soa_array<T>::component_count; c++)
+        {
+            float const* a = value.component(c);
+            float* r = result->component(c);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+            for (size_t i = 0; i < size; i++)
+            {
+                r[i] = a[i] * factor;
+            }
+#else
+            using namespace ::DirectX;
+            using namespace soa_details;
+
+            for (size_t i = 0; i < size; i += 4)
+            {
+                store(r + i, XMVectorScale(load(a + i), factor));
+            }
+#endif
+        }
+    }
+
+
+    template<typename T>
+    inline void lerp(soa_array<T> const& value1, soa_array<T> const& value2, float amount, _Out_ soa_array<T>* result)
+    {
+        if (!soa_details::validate_sizes(value1, value2))
+            return;
+
+        size_t size = value1.size();
+        result->resize(size);
+
+        for (size_t c = 0; c < soa_array<T>::component_count; c++)
+        {
+            float const* a = value1.component(c);
+            float const* b = value2.component(c);
+            float* r = result->component(c);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+            for (size_t i = 0; i < size; i++)
+            {
+                r[i] = a[i] + (b[i] - a[i]) * amount;
+            }
+#else
+            using namespace ::DirectX;
+            using namespace soa_details;
+
+            XMVECTOR t = XMVectorReplicate(amount);
+
+            for (size_t i = 0; i < size; i += 4)
+            {
+                XMVECTOR va = load(a + i);
+                store(r + i, XMVectorMultiplyAdd(XMVectorSubtract(load(b + i), va), t, va));
+            }
+#endif
+        }
+    }
+
+
+    template<typename T>
+    inline void normalize(soa_array<T> const& value, _Out_ soa_array<T>* result)
+    {
+        const size_t componentCount = soa_array<T>::component_count;
+
+        size_t size = value.size();
+        result->resize(size);
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float lengthSquared = 0;
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                float v = value.component(c)[i];
+                lengthSquared += v * v;
+            }
+
+            float invLength = 1.0f / sqrtf(lengthSquared);
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                result->component(c)[i] = value.component(c)[i] * invLength;
+            }
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR v[componentCount];
+            XMVECTOR lengthSquared = XMVectorZero();
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                v[c] = load(value.component(c) + i);
+                lengthSquared = XMVectorMultiplyAdd(v[c], v[c], lengthSquared);
+            }
+
+            XMVECTOR lengths = XMVectorSqrt(lengthSquared);
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                store(result->component(c) + i, XMVectorDivide(v[c], lengths));
+            }
+        }
+#endif
+    }
+
+
+    template<typename T>
+    inline void dot(soa_array<T> const& value1, soa_array<T> const& value2, _Out_writes_(value1.size()) float* result)
+    {
+        const size_t componentCount = soa_array<T>::component_count;
+
+        if (!soa_details::validate_sizes(value1, value2))
+            return;
+
+        size_t size = value1.size();
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float sum = 0;
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                sum += value1.component(c)[i] * value2.component(c)[i];
+            }
+
+            result[i] = sum;
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR sum = XMVectorZero();
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                sum = XMVectorMultiplyAdd(load(value1.component(c) + i), load(value2.component(c) + i), sum);
+            }
+
+            store_unpadded(result + i, sum, size - i);
+        }
+#endif
+    }
+
+
+    template<typename T>
+    inline void length_squared(soa_array<T> const& value, _Out_writes_(value.size()) float* result)
+    {
+        dot(value, value, result);
+    }
+
+
+    template<typename T>
+    inline void length(soa_array<T> const& value, _Out_writes_(value.size()) float* result)
+    {
+        const size_t componentCount = soa_array<T>::component_count;
+
+        size_t size = value.size();
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float sum = 0;
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                float v = value.component(c)[i];
+                sum += v * v;
+            }
+
+            result[i] = sqrtf(sum);
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR sum = XMVectorZero();
+
+            for (size_t c = 0; c < componentCount; c++)
+            {
+                XMVECTOR v = load(value.component(c) + i);
+                sum = XMVectorMultiplyAdd(v, v, sum);
+            }
+
+            store_unpadded(result + i, XMVectorSqrt(sum), size - i);
+        }
+#endif
+    }
+
+
+    inline void transform(float2_soa const& positions, float3x2 const& matrix, _Out_ float2_soa* result)
+    {
+        size_t size = positions.size();
+        result->resize(size);
+
+        float const* px = positions.x();
+        float const* py = positions.y();
+        float* rx = result->x();
+        float* ry = result->y();
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float x = px[i];
+            float y = py[i];
+
+            rx[i] = x * matrix.m11 + y * matrix.m21 + matrix.m31;
+            ry[i] = x * matrix.m12 + y * matrix.m22 + matrix.m32;
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31), m32 = XMVectorReplicate(matrix.m32);
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR x = load(px + i);
+            XMVECTOR y = load(py + i);
+
+            store(rx + i, XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, m31)));
+            store(ry + i, XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, m32)));
+        }
+#endif
+    }
+
+
+    inline void transform(float2_soa const& positions, float4x4 const& matrix, _Out_ float2_soa* result)
+    {
+        size_t size = positions.size();
+        result->resize(size);
+
+        float const* px = positions.x();
+        float const* py = positions.y();
+        float* rx = result->x();
+        float* ry = result->y();
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float x = px[i];
+            float y = py[i];
+
+            rx[i] = x * matrix.m11 + y * matrix.m21 + matrix.m41;
+            ry[i] = x * matrix.m12 + y * matrix.m22 + matrix.m42;
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22);
+        XMVECTOR m41 = XMVectorReplicate(matrix.m41), m42 = XMVectorReplicate(matrix.m42);
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR x = load(px + i);
+            XMVECTOR y = load(py + i);
+
+            store(rx + i, XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, m41)));
+            store(ry + i, XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, m42)));
+        }
+#endif
+    }
+
+
+    inline void transform(float3_soa const& positions, float4x4 const& matrix, _Out_ float3_soa* result)
+    {
+        size_t size = positions.size();
+        result->resize(size);
+
+        float const* px = positions.x();
+        float const* py = positions.y();
+        float const* pz = positions.z();
+        float* rx = result->x();
+        float* ry = result->y();
+        float* rz = result->z();
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float x = px[i];
+            float y = py[i];
+            float z = pz[i];
+
+            rx[i] = x * matrix.m11 + y * matrix.m21 + z * matrix.m31 + matrix.m41;
+            ry[i] = x * matrix.m12 + y * matrix.m22 + z * matrix.m32 + matrix.m42;
+            rz[i] = x * matrix.m13 + y * matrix.m23 + z * matrix.m33 + matrix.m43;
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12), m13 = XMVectorReplicate(matrix.m13);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22), m23 = XMVectorReplicate(matrix.m23);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31), m32 = XMVectorReplicate(matrix.m32), m33 = XMVectorReplicate(matrix.m33);
+        XMVECTOR m41 = XMVectorReplicate(matrix.m41), m42 = XMVectorReplicate(matrix.m42), m43 = XMVectorReplicate(matrix.m43);
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR x = load(px + i);
+            XMVECTOR y = load(py + i);
+            XMVECTOR z = load(pz + i);
+
+            store(rx + i, XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, XMVectorMultiplyAdd(z, m31, m41))));
+            store(ry + i, XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, XMVectorMultiplyAdd(z, m32, m42))));
+            store(rz + i, XMVectorMultiplyAdd(x, m13, XMVectorMultiplyAdd(y, m23, XMVectorMultiplyAdd(z, m33, m43))));
+        }
+#endif
+    }
+
+
+    inline void transform(float4_soa const& vectors, float4x4 const& matrix, _Out_ float4_soa* result)
+    {
+        size_t size = vectors.size();
+        result->resize(size);
+
+        float const* vx = vectors.x();
+        float const* vy = vectors.y();
+        float const* vz = vectors.z();
+        float const* vw = vectors.w();
+        float* rx = result->x();
+        float* ry = result->y();
+        float* rz = result->z();
+        float* rw = result->w();
+
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+        for (size_t i = 0; i < size; i++)
+        {
+            float x = vx[i];
+            float y = vy[i];
+            float z = vz[i];
+            float w = vw[i];
+
+            rx[i] = x * matrix.m11 + y * matrix.m21 + z * matrix.m31 + w * matrix.m41;
+            ry[i] = x * matrix.m12 + y * matrix.m22 + z * matrix.m32 + w * matrix.m42;
+            rz[i] = x * matrix.m13 + y * matrix.m23 + z * matrix.m33 + w * matrix.m43;
+            rw[i] = x * matrix.m14 + y * matrix.m24 + z * matrix.m34 + w * matrix.m44;
+        }
+#else
+        using namespace ::DirectX;
+        using namespace soa_details;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12), m13 = XMVectorReplicate(matrix.m13), m14 = XMVectorReplicate(matrix.m14);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22), m23 = XMVectorReplicate(matrix.m23), m24 = XMVectorReplicate(matrix.m24);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31), m32 = XMVectorReplicate(matrix.m32), m33 = XMVectorReplicate(matrix.m33), m34 = XMVectorReplicate(matrix.m34);
+        XMVECTOR m41 = XMVectorReplicate(matrix.m41), m42 = XMVectorReplicate(matrix.m42), m43 = XMVectorReplicate(matrix.m43), m44 = XMVectorReplicate(matrix.m44);
+
+        for (size_t i = 0; i < size; i += 4)
+        {
+            XMVECTOR x = load(vx + i);
+            XMVECTOR y = load(vy + i);
+            XMVECTOR z = load(vz + i);
+            XMVECTOR w = load(vw + i);
+
+            store(rx + i, XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, XMVectorMultiplyAdd(z, m31, XMVectorMultiply(w, m41)))));
+            store(ry + i, XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, XMVectorMultiplyAdd(z, m32, XMVectorMultiply(w, m42)))));
+            store(rz + i, XMVectorMultiplyAdd(x, m13, XMVectorMultiplyAdd(y, m23, XMVectorMultiplyAdd(z, m33, XMVectorMultiply(w, m43)))));
+            store(rw + i, XMVectorMultiplyAdd(x, m14, XMVectorMultiplyAdd(y, m24, XMVectorMultiplyAdd(z, m34, XMVectorMultiply(w, m44)))));
+        }
+#endif
+    }
+}}}
+
+
+#undef _WINDOWS_NUMERICS_THROW_
+
+#pragma warning(pop)
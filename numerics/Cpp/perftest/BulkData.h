@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+
+// Bulk tests process whole arrays of vectors rather than one value at a time, comparing
+// a plain array of structures against the structure-of-arrays soa_array container.
+const int BulkElementCount = 1024;
+
+// Each bulk repetition touches BulkElementCount vectors, so we need fewer repetitions
+// to do the same total amount of work as the single value tests.
+const int BulkRepetitions = InnerRepetitions / BulkElementCount;
+
+
+// Transform matrix used by the bulk tests for each vector type.
+template<typename T> struct BulkTransformMatrix         { typedef float4x4 type; };
+template<>           struct BulkTransformMatrix<float2> { typedef float3x2 type; };
+
+
+// Input and output arrays for a bulk test, in either AoS or SoA layout. Operations
+// read from values and params, writing to result or scalars. Because nothing feeds
+// back into the inputs, repeated operations cannot overflow or decay into denormals.
+template<typename T>
+struct AoSBulkData
+{
+    std::vector<T> values;
+    std::vector<T> params;
+    std::vector<T> result;
+    std::vector<float> scalars;
+    typename BulkTransformMatrix<T>::type matrix;
+};
+
+
+template<typename T>
+struct SoABulkData
+{
+    soa_array<T> values;
+    soa_array<T> params;
+    soa_array<T> result;
+    std::vector<float> scalars;
+    typename BulkTransformMatrix<T>::type matrix;
+};
+
+
+// Stores a list of values into either an AoS or SoA array.
+template<typename T>
+void StoreBulkArray(std::vector<T> const& source, std::vector<T>* dest)
+{
+    *dest = source;
+}
+
+
+template<typename T>
+void StoreBulkArray(std::vector<T> const& source, soa_array<T>* dest)
+{
+    dest->assign(source.data(), source.size());
+}
+
+
+// Generates random bulk test data.
+template<typename T, typename TBulkData>
+TBulkData MakeRandomBulkData()
+{
+    auto values = MakeRandom<T, BulkElementCount>();
+    auto params = MakeRandom<T, BulkElementCount>();
+
+    TBulkData data;
+
+    StoreBulkArray(std::vector<T>(values.begin(), values.end()), &data.values);
+    StoreBulkArray(std::vector<T>(params.begin(), params.end()), &data.params);
+    StoreBulkArray(std::vector<T>(BulkElementCount), &data.result);
+
+    data.scalars.resize(BulkElementCount);
+    data.matrix = MakeRandom<typename BulkTransformMatrix<T>::type>();
+
+    return data;
+}
+
+
+template<> inline AoSBulkData<float2> MakeRandom<AoSBulkData<float2>>() { return MakeRandomBulkData<float2, AoSBulkData<float2>>(); }
+template<> inline AoSBulkData<float3> MakeRandom<AoSBulkData<float3>>() { return MakeRandomBulkData<float3, AoSBulkData<float3>>(); }
+template<> inline AoSBulkData<float4> MakeRandom<AoSBulkData<float4>>() { return MakeRandomBulkData<float4, AoSBulkData<float4>>(); }
+
+template<> inline SoABulkData<float2> MakeRandom<SoABulkData<float2>>() { return MakeRandomBulkData<float2, SoABulkData<float2>>(); }
+template<> inline SoABulkData<float3> MakeRandom<SoABulkData<float3>>() { return MakeRandomBulkData<float3, SoABulkData<float3>>(); }
+template<> inline SoABulkData<float4> MakeRandom<SoABulkData<float4>>() { return MakeRandomBulkData<float4, SoABulkData<float4>>(); }
+
+
+// Feeds the bulk test outputs into EnsureNotOptimizedAway.
+template<typename T>
+void EnsureNotOptimizedAway(AoSBulkData<T> const& data)
+{
+    for (size_t i = 0; i < data.result.size(); i++)
+    {
+        EnsureNotOptimizedAway(data.result[i]);
+        EnsureNotOptimizedAway(data.scalars[i]);
+    }
+}
+
+
+template<typename T>
+void EnsureNotOptimizedAway(SoABulkData<T> const& data)
+{
+    for (size_t i = 0; i < data.result.size(); i++)
+    {
+        EnsureNotOptimizedAway(data.result.get(i));
+        EnsureNotOptimizedAway(data.scalars[i]);
+    }
+}
+
+
+// Input and output arrays for the half precision conversion tests, sized like
+// a row of R16G16B16A16_FLOAT pixels.
+struct HalfBulkData
+{
+    std::vector<float4> floats;
+    std::vector<half4> halves;
+    std::vector<float4> result;
+};
+
+
+template<> inline HalfBulkData MakeRandom<HalfBulkData>()
+{
+    auto values = MakeRandom<float4, BulkElementCount>();
+
+    HalfBulkData data;
+
+    data.floats.assign(values.begin(), values.end());
+    data.halves.resize(BulkElementCount);
+    data.result.resize(BulkElementCount);
+
+    convert_to_half(data.floats.data(), BulkElementCount, data.halves.data());
+
+    return data;
+}
+
+
+inline void EnsureNotOptimizedAway(HalfBulkData const& data)
+{
+    for (size_t i = 0; i < data.result.size(); i++)
+    {
+        EnsureNotOptimizedAway(data.result[i]);
+        EnsureNotOptimizedAway(static_cast<float4>(data.halves[i]));
+    }
+}
+
+
+// Runs a bulk test, counting each vector processed as one operation.
+template<typename TBulkData, typename TOperation>
+void RunBulkPerfTest(std::string const& testName, TOperation const& operation)
+{
+    RunPerfTest<TBulkData, float, BulkRepetitions>(testName, operation, BulkElementCount);
+}
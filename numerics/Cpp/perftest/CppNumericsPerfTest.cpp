@@ -15,6 +15,8 @@
 
 float valueTheOptimizerCannotRemove = 0;
 
+PerfTestOptions perfTestOptions;
+
 
 // Measures operations that are common to all the vector, matrix and quaternion types.
 template<typename T>
@@ -226,6 +228,24 @@ void RunFloat4x4Tests()
         param = *value;
         *value = transpose(t);
     });
+
+    RunPerfTest<float4x4, float4x4>("float4x4 invert", [](float4x4* value, float4x4& param)
+    {
+        auto t = param;
+        param = *value;
+        invert(t, value);
+    });
+
+    RunPerfTest<float4x4, float4x4>("float4x4 decompose", [](float4x4* value, float4x4 const& param)
+    {
+        float3 scale;
+        quaternion rotation;
+        float3 translation;
+
+        decompose(param, &scale, &rotation, &translation);
+
+        value->m11 += scale.x + rotation.x + translation.x;
+    });
 }
 
 
@@ -295,9 +315,171 @@ void RunQuaternionTests()
 }
 
 
-int __cdecl main()
+// Measures bulk operations on a plain array of vectors, for comparison with the SoA versions below.
+template<typename T>
+void RunAoSBulkTests(std::string const& typeName)
+{
+    typedef AoSBulkData<T> TData;
+
+    RunBulkPerfTest<TData>(typeName + " array add (AoS)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->result[i] = data->values[i] + data->params[i];
+        }
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array scale (AoS)", [](TData* data, float param)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->result[i] = data->values[i] * param;
+        }
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array lerp (AoS)", [](TData* data, float param)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->result[i] = lerp(data->values[i], data->params[i], param);
+        }
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array normalize (AoS)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->result[i] = normalize(data->values[i]);
+        }
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array dot (AoS)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->scalars[i] = dot(data->values[i], data->params[i]);
+        }
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array length (AoS)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->scalars[i] = length(data->values[i]);
+        }
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array transform (AoS)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->result[i] = transform(data->values[i], data->matrix);
+        }
+    });
+}
+
+
+// Measures the same bulk operations using soa_array.
+template<typename T>
+void RunSoABulkTests(std::string const& typeName)
+{
+    typedef SoABulkData<T> TData;
+
+    RunBulkPerfTest<TData>(typeName + " array add (SoA)", [](TData* data, float)
+    {
+        add(data->values, data->params, &data->result);
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array scale (SoA)", [](TData* data, float param)
+    {
+        scale(data->values, param, &data->result);
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array lerp (SoA)", [](TData* data, float param)
+    {
+        lerp(data->values, data->params, param, &data->result);
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array normalize (SoA)", [](TData* data, float)
+    {
+        normalize(data->values, &data->result);
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array dot (SoA)", [](TData* data, float)
+    {
+        dot(data->values, data->params, data->scalars.data());
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array length (SoA)", [](TData* data, float)
+    {
+        length(data->values, data->scalars.data());
+    });
+
+    RunBulkPerfTest<TData>(typeName + " array transform (SoA)", [](TData* data, float)
+    {
+        transform(data->values, data->matrix, &data->result);
+    });
+}
+
+
+// Compares converting half precision values one at a time against the bulk conversion functions.
+void RunHalfBulkTests()
 {
-    printf("name, time, deviation\n");
+    typedef HalfBulkData TData;
+
+    RunBulkPerfTest<TData>("half4 array to half (per element)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->halves[i] = half4(data->floats[i]);
+        }
+    });
+
+    RunBulkPerfTest<TData>("half4 array to half (bulk)", [](TData* data, float)
+    {
+        convert_to_half(data->floats.data(), BulkElementCount, data->halves.data());
+    });
+
+    RunBulkPerfTest<TData>("half4 array to float (per element)", [](TData* data, float)
+    {
+        for (size_t i = 0; i < BulkElementCount; i++)
+        {
+            data->result[i] = data->halves[i];
+        }
+    });
+
+    RunBulkPerfTest<TData>("half4 array to float (bulk)", [](TData* data, float)
+    {
+        convert_to_float(data->halves.data(), BulkElementCount, data->result.data());
+    });
+}
+
+
+void RunBulkTests()
+{
+    RunAoSBulkTests<float2>("float2");
+    RunSoABulkTests<float2>("float2");
+
+    RunAoSBulkTests<float3>("float3");
+    RunSoABulkTests<float3>("float3");
+
+    RunAoSBulkTests<float4>("float4");
+    RunSoABulkTests<float4>("float4");
+
+    RunHalfBulkTests();
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (!ParsePerfTestOptions(argc, argv, &perfTestOptions))
+        return 2;
+
+    if (perfTestOptions.cpu >= 0 && !PinToCpu(perfTestOptions.cpu))
+    {
+        fprintf(stderr, "Unable to pin to CPU %d\n", perfTestOptions.cpu);
+        return 2;
+    }
 
     RunFloat2Tests();
     RunFloat3Tests();
@@ -306,8 +488,16 @@ int __cdecl main()
     RunFloat4x4Tests();
     RunPlaneTests();
     RunQuaternionTests();
+    RunBulkTests();
+
+    fprintf(stderr, "\nEnsureNotOptimizedAway: %f\n", valueTheOptimizerCannotRemove);
+
+    if (!WritePerfTestResults(perfTestOptions))
+        return 2;
 
-    printf("\nEnsureNotOptimizedAway: %f\n", valueTheOptimizerCannotRemove);
+    // Exit code 1 lets automated builds detect performance regressions.
+    if (!perfTestOptions.baselineFile.empty() && !CompareWithBaseline(perfTestOptions))
+        return 1;
 
     return 0;
 }
@@ -13,6 +13,14 @@
 #pragma once
 
 
+// Generates a single random value. Only the specializations below are implemented.
+template<typename T>
+T MakeRandom()
+{
+    static_assert(sizeof(T) == 0, "Unknown MakeRandom type.");
+}
+
+
 // Generates an array of random values.
 template<typename T, size_t Count>
 std::array<T, Count> MakeRandom()
@@ -25,14 +33,6 @@ std::array<T, Count> MakeRandom()
 }
 
 
-// Generates a single random value.
-template<typename T>
-T MakeRandom()
-{
-    static_assert(false, "Unknown MakeRandom type.");
-}
-
-
 template<>
 inline float MakeRandom<float>()
 {
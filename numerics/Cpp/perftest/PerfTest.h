@@ -25,21 +25,77 @@ const int InnerRepetitions = 1000000;
 const int ParamCount = 64;
 
 
+// Compiler specific ways of spelling "do not inline this function".
+#ifdef _MSC_VER
+#define PERFTEST_NOINLINE __declspec(noinline)
+#else
+#define PERFTEST_NOINLINE __attribute__((noinline))
+#endif
+
+
+// Stops the compiler from moving memory accesses across this point, so that setup work
+// and the final result read cannot be folded into (or out of) the timed region.
+inline void CompilerBarrier()
+{
+#ifdef _MSC_VER
+    _ReadWriteBarrier();
+#else
+    asm volatile("" ::: "memory");
+#endif
+}
+
+
+// Clock used to time each test pass. The VS2013 steady_clock only ticks at system timer
+// resolution, so on that compiler we wrap QueryPerformanceCounter in a chrono clock.
+#if defined(_MSC_VER) && _MSC_VER < 1900
+
+struct PerfClock
+{
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<PerfClock> time_point;
+
+    static const bool is_steady = true;
+
+    static time_point now()
+    {
+        LARGE_INTEGER counter;
+        LARGE_INTEGER frequency;
+
+        QueryPerformanceCounter(&counter);
+        QueryPerformanceFrequency(&frequency);
+
+        // Split into whole seconds and remainder to avoid overflowing the multiply.
+        auto seconds = counter.QuadPart / frequency.QuadPart;
+        auto remainder = counter.QuadPart % frequency.QuadPart;
+
+        return time_point(duration(seconds * 1000000000 + remainder * 1000000000 / frequency.QuadPart));
+    }
+};
+
+#else
+
+typedef std::chrono::steady_clock PerfClock;
+
+#endif
+
+
 // The core thing being measured: repeats a simple operation a large number of times.
 // Marked as noinline to encourage inlining of the operation lambda, and to
 // keep this as separate as possible from the surrounding infrastructure goop.
-template<typename TValue, typename TParams, typename TOperation>
-__declspec(noinline) void RunInnerLoop(TValue* value, TParams& params, TOperation const& operation)
+template<int Repetitions, typename TValue, typename TParams, typename TOperation>
+PERFTEST_NOINLINE void RunInnerLoop(TValue* value, TParams& params, TOperation const& operation)
 {
-    for (int i = 0; i < InnerRepetitions; i++)
+    for (int i = 0; i < Repetitions; i++)
     {
         operation(value, params[i % ParamCount]);
     }
 }
 
 
-// Runs a single test pass, returning how long it took.
-template<typename TValue, typename TParam, typename TOperation>
+// Runs a single test pass, returning how long it took in seconds.
+template<typename TValue, typename TParam, int Repetitions, typename TOperation>
 double RunTestPass(TOperation const& operation)
 {
     // Generate a random (but identical for every pass) starting value and parameter list.
@@ -49,21 +105,20 @@ double RunTestPass(TOperation const& operation)
     auto params = MakeRandom<TParam, ParamCount>();
     
     // Run the test, and time how long it takes.
-    LARGE_INTEGER startTime;
-    QueryPerformanceCounter(&startTime);
+    CompilerBarrier();
+
+    auto startTime = PerfClock::now();
+
+    RunInnerLoop<Repetitions>(&value, params, operation);
 
-    RunInnerLoop(&value, params, operation);
+    auto endTime = PerfClock::now();
 
-    LARGE_INTEGER endTime;
-    QueryPerformanceCounter(&endTime);
+    CompilerBarrier();
 
     // Make sure the compiler doesn't try to optimize out our computation!
     EnsureNotOptimizedAway(value);
 
-    LARGE_INTEGER frequency;
-    QueryPerformanceFrequency(&frequency);
-
-    return static_cast<double>(endTime.QuadPart - startTime.QuadPart) / frequency.QuadPart;
+    return std::chrono::duration<double>(endTime - startTime).count();
 }
 
 
@@ -93,23 +148,31 @@ double GetDeviationPercentage(T const& results)
 }
 
 
-// The main test entrypoint.
-template<typename TValue, typename TParam, typename TOperation>
-__declspec(noinline) void RunPerfTest(std::string const& testName, TOperation const& operation)
+// The main test entrypoint. Repetitions can be overridden by tests that do more work per
+// iteration, in which case opsPerRepetition tells the throughput calculation how much.
+template<typename TValue, typename TParam, int Repetitions = InnerRepetitions, typename TOperation>
+PERFTEST_NOINLINE void RunPerfTest(std::string const& testName, TOperation const& operation, int opsPerRepetition = 1)
 {
+    if (!perfTestOptions.filter.empty() && testName.find(perfTestOptions.filter) == std::string::npos)
+        return;
+
     // Repeat the test multiple times.
     std::array<double, TestPasses> results;
 
     std::generate(results.begin(), results.end(), [&]
     {
-        return RunTestPass<TValue, TParam>(operation);
+        return RunTestPass<TValue, TParam, Repetitions>(operation);
     });
 
     // Analyze the results.
     std::sort(results.begin(), results.end());
 
-    auto median = results[TestPasses / 2];
-    auto deviation = GetDeviationPercentage(results);
+    PerfTestResult result;
+
+    result.name = testName;
+    result.time = results[TestPasses / 2];
+    result.deviation = GetDeviationPercentage(results);
+    result.opsPerNanosecond = static_cast<double>(Repetitions) * opsPerRepetition / (result.time * 1e9);
 
-    printf("%s, %f, %f%%\n", testName.c_str(), median, deviation);
+    RecordPerfTestResult(result);
 }
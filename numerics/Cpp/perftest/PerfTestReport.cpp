@@ -0,0 +1,420 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include "pch.h"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#if !defined(_WIN32) && defined(__linux__)
+#include <sched.h>
+#endif
+
+
+PerfTestOptions::PerfTestOptions()
+    : format(PerfTestOutputFormat::Csv)
+    , cpu(-1)
+    , regressionThreshold(10)
+{
+}
+
+
+static std::vector<PerfTestResult> perfTestResults;
+
+
+// Identifies which WindowsNumerics implementation was measured, so results from
+// builds with and without WINDOWS_NUMERICS_DISABLE_SIMD can be told apart.
+static char const* GetNumericsBackendName()
+{
+#ifdef WINDOWS_NUMERICS_DISABLE_SIMD
+    return "scalar";
+#else
+    return "directxmath";
+#endif
+}
+
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: CppNumericsPerfTest [options]\n"
+        "\n"
+        "Measuring the %s WindowsNumerics implementation.\n"
+        "\n"
+        "  --format=csv|json      Output format (default csv).\n"
+        "  --output=<file>        Write results to a file rather than stdout.\n"
+        "  --filter=<text>        Only run tests whose name contains this text.\n"
+        "  --cpu=<index>          Pin the test thread to the specified CPU.\n"
+        "  --baseline=<file>      Compare against previous CSV or JSON results.\n"
+        "  --threshold=<percent>  Slowdown that counts as a regression (default 10).\n",
+        GetNumericsBackendName());
+}
+
+
+// Matches "--name=value" style arguments.
+static bool MatchOption(std::string const& arg, char const* name, std::string* value)
+{
+    std::string prefix = std::string("--") + name + "=";
+
+    if (arg.compare(0, prefix.size(), prefix) != 0)
+        return false;
+
+    *value = arg.substr(prefix.size());
+    return true;
+}
+
+
+// Parses a number, failing if there is anything other than whitespace left over.
+static bool ParseNumber(std::string const& text, double* value)
+{
+    char const* begin = text.c_str();
+    char* end;
+
+    *value = strtod(begin, &end);
+
+    if (end == begin)
+        return false;
+
+    while (isspace(static_cast<unsigned char>(*end)))
+        end++;
+
+    return *end == 0;
+}
+
+
+static bool ParseOption(std::string const& arg, PerfTestOptions* options)
+{
+    std::string value;
+    double number;
+
+    if (MatchOption(arg, "format", &value))
+    {
+        if (value == "csv")
+            options->format = PerfTestOutputFormat::Csv;
+        else if (value == "json")
+            options->format = PerfTestOutputFormat::Json;
+        else
+            return false;
+    }
+    else if (MatchOption(arg, "output", &value))
+    {
+        options->outputFile = value;
+    }
+    else if (MatchOption(arg, "filter", &value))
+    {
+        options->filter = value;
+    }
+    else if (MatchOption(arg, "baseline", &value))
+    {
+        options->baselineFile = value;
+    }
+    else if (MatchOption(arg, "cpu", &value))
+    {
+        if (!ParseNumber(value, &number) || number < 0 || number != floor(number))
+            return false;
+
+        options->cpu = static_cast<int>(number);
+    }
+    else if (MatchOption(arg, "threshold", &value))
+    {
+        if (!ParseNumber(value, &number) || number < 0)
+            return false;
+
+        options->regressionThreshold = number;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+bool ParsePerfTestOptions(int argc, char* argv[], PerfTestOptions* options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--help") == 0)
+        {
+            PrintUsage();
+            return false;
+        }
+
+        if (!ParseOption(argv[i], options))
+        {
+            fprintf(stderr, "Invalid argument: %s\n\n", argv[i]);
+            PrintUsage();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// Pinning the test thread to a single CPU stops the OS migrating it between cores
+// (which flushes caches and can land on a slower core) partway through a run.
+bool PinToCpu(int cpu)
+{
+#if defined(_WIN32)
+
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+        return false;
+
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+
+#elif defined(__linux__)
+
+    if (cpu >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+
+    return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+
+#else
+
+    (void)cpu;
+    return false;
+
+#endif
+}
+
+
+void RecordPerfTestResult(PerfTestResult const& result)
+{
+    perfTestResults.push_back(result);
+
+    // Report progress on stderr, so stdout only contains the final results.
+    fprintf(stderr, "%s: %f, %f%%\n", result.name.c_str(), result.time, result.deviation);
+}
+
+
+static std::string EscapeJsonString(std::string const& value)
+{
+    std::string result;
+
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+
+        result += c;
+    }
+
+    return result;
+}
+
+
+static void WriteCsv(std::ostream& output)
+{
+    output << "name, time, deviation, ops_per_ns\n";
+
+    for (auto& result : perfTestResults)
+    {
+        output << result.name << ", "
+               << result.time << ", "
+               << result.deviation << ", "
+               << result.opsPerNanosecond << "\n";
+    }
+}
+
+
+static void WriteJson(std::ostream& output)
+{
+    output << "{\n";
+    output << "  \"backend\": \"" << GetNumericsBackendName() << "\",\n";
+    output << "  \"tests\": [\n";
+
+    for (size_t i = 0; i < perfTestResults.size(); i++)
+    {
+        auto& result = perfTestResults[i];
+
+        output << "    { "
+               << "\"name\": \"" << EscapeJsonString(result.name) << "\", "
+               << "\"time\": " << result.time << ", "
+               << "\"deviation\": " << result.deviation << ", "
+               << "\"ops_per_ns\": " << result.opsPerNanosecond
+               << " }" << (i + 1 < perfTestResults.size() ? "," : "") << "\n";
+    }
+
+    output << "  ]\n";
+    output << "}\n";
+}
+
+
+bool WritePerfTestResults(PerfTestOptions const& options)
+{
+    std::ofstream file;
+
+    if (!options.outputFile.empty())
+    {
+        file.open(options.outputFile);
+
+        if (!file)
+        {
+            fprintf(stderr, "Unable to write %s\n", options.outputFile.c_str());
+            return false;
+        }
+    }
+
+    std::ostream& output = options.outputFile.empty() ? std::cout : file;
+
+    output.precision(9);
+
+    switch (options.format)
+    {
+    case PerfTestOutputFormat::Csv:
+        WriteCsv(output);
+        break;
+
+    case PerfTestOutputFormat::Json:
+        WriteJson(output);
+        break;
+    }
+
+    output.flush();
+
+    return !output.fail();
+}
+
+
+// Reads the test times from a file previously written by WriteCsv.
+static bool ReadCsvBaseline(std::istream& input, std::map<std::string, double>* times)
+{
+    std::string line;
+
+    // Skip the header.
+    std::getline(input, line);
+
+    while (std::getline(input, line))
+    {
+        auto nameEnd = line.find(',');
+
+        if (nameEnd == std::string::npos)
+            continue;
+
+        double time;
+
+        if (!ParseNumber(line.substr(nameEnd + 1, line.find(',', nameEnd + 1) - nameEnd - 1), &time))
+            return false;
+
+        (*times)[line.substr(0, nameEnd)] = time;
+    }
+
+    return true;
+}
+
+
+// Reads the test times from a file previously written by WriteJson. This is not a general
+// purpose JSON parser: it relies on WriteJson putting each test on a single line.
+static bool ReadJsonBaseline(std::istream& input, std::map<std::string, double>* times)
+{
+    const std::string namePrefix = "\"name\": \"";
+    const std::string timePrefix = "\"time\": ";
+
+    std::string line;
+
+    while (std::getline(input, line))
+    {
+        auto namePos = line.find(namePrefix);
+
+        if (namePos == std::string::npos)
+            continue;
+
+        std::string name;
+        size_t i = namePos + namePrefix.size();
+
+        while (i < line.size() && line[i] != '"')
+        {
+            if (line[i] == '\\')
+                i++;
+
+            if (i < line.size())
+                name += line[i++];
+        }
+
+        auto timePos = line.find(timePrefix, i);
+
+        if (timePos == std::string::npos)
+            return false;
+
+        timePos += timePrefix.size();
+
+        double time;
+
+        if (!ParseNumber(line.substr(timePos, line.find(',', timePos) - timePos), &time))
+            return false;
+
+        (*times)[name] = time;
+    }
+
+    return true;
+}
+
+
+bool CompareWithBaseline(PerfTestOptions const& options)
+{
+    std::ifstream input(options.baselineFile);
+
+    if (!input)
+    {
+        fprintf(stderr, "Unable to read baseline %s\n", options.baselineFile.c_str());
+        return false;
+    }
+
+    // Work out which format the baseline is in.
+    std::map<std::string, double> baselineTimes;
+
+    bool isJson = (input.peek() == '{');
+
+    if (!(isJson ? ReadJsonBaseline(input, &baselineTimes) : ReadCsvBaseline(input, &baselineTimes)))
+    {
+        fprintf(stderr, "Unable to parse baseline %s\n", options.baselineFile.c_str());
+        return false;
+    }
+
+    // Compare each test result against the baseline.
+    int regressionCount = 0;
+
+    fprintf(stderr, "\nComparing against baseline %s (threshold %g%%)\n", options.baselineFile.c_str(), options.regressionThreshold);
+
+    for (auto& result : perfTestResults)
+    {
+        auto baseline = baselineTimes.find(result.name);
+
+        if (baseline == baselineTimes.end())
+        {
+            fprintf(stderr, "  %s: not in baseline\n", result.name.c_str());
+            continue;
+        }
+
+        double change = (result.time / baseline->second - 1) * 100;
+
+        if (change > options.regressionThreshold)
+        {
+            fprintf(stderr, "  REGRESSION %s: %f -> %f (%+.1f%%)\n", result.name.c_str(), baseline->second, result.time, change);
+            regressionCount++;
+        }
+    }
+
+    fprintf(stderr, "%d of %d tests regressed\n", regressionCount, static_cast<int>(perfTestResults.size()));
+
+    return regressionCount == 0;
+}
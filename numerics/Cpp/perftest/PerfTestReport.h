@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+
+// Command line options controlling which tests run and how results are reported.
+enum class PerfTestOutputFormat
+{
+    Csv,
+    Json,
+};
+
+
+struct PerfTestOptions
+{
+    PerfTestOptions();
+
+    // Results format, and where to write them (stdout if no file is specified).
+    PerfTestOutputFormat format;
+    std::string outputFile;
+
+    // Only tests whose name contains this string are run.
+    std::string filter;
+
+    // Optional CPU to pin the test thread to, or -1 to leave scheduling up to the OS.
+    int cpu;
+
+    // When set, results are compared against this previous output file (CSV or JSON),
+    // and the run fails if any test got slower by more than regressionThreshold percent.
+    std::string baselineFile;
+    double regressionThreshold;
+};
+
+
+// Timing results for a single test.
+struct PerfTestResult
+{
+    std::string name;
+
+    // Median time of one test pass, in seconds.
+    double time;
+
+    // Standard deviation as a percentage of the mean, excluding outliers.
+    double deviation;
+
+    // Throughput, in operations per nanosecond.
+    double opsPerNanosecond;
+};
+
+
+extern PerfTestOptions perfTestOptions;
+
+
+bool ParsePerfTestOptions(int argc, char* argv[], PerfTestOptions* options);
+bool PinToCpu(int cpu);
+
+void RecordPerfTestResult(PerfTestResult const& result);
+bool WritePerfTestResults(PerfTestOptions const& options);
+bool CompareWithBaseline(PerfTestOptions const& options);
@@ -13,18 +13,33 @@
 #pragma once
 
 #include "../WindowsNumerics.h"
+#include "../WindowsNumericsSoA.h"
+#include "../WindowsNumericsHalf.h"
 
 using namespace Windows::Foundation::Numerics;
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <numeric>
 #include <string>
+#include <vector>
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 #include "EnsureNotOptimizedAway.h"
 #include "MakeRandom.h"
+#include "PerfTestReport.h"
 #include "PerfTest.h"
+#include "BulkData.h"
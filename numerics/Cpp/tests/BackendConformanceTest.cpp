@@ -0,0 +1,273 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+namespace NumericsTests
+{
+    // These tests check that the float4x4 and quaternion operations which have both a scalar
+    // and a DirectXMath implementation (selected by WINDOWS_NUMERICS_DISABLE_SIMD) give the
+    // same results as DirectXMath itself, and as a plain reference implementation. Building
+    // and running them with and without WINDOWS_NUMERICS_DISABLE_SIMD verifies both backends.
+    NUMERICS_TEST_CLASS(BackendConformanceTest)
+    {
+        NUMERICS_TEST_CLASS_INNER(BackendConformanceTest)
+
+        static std::vector<float4x4> GetTestMatrices()
+        {
+            std::vector<float4x4> matrices;
+
+            matrices.push_back(float4x4::identity());
+            matrices.push_back(make_float4x4_translation(1, -2, 3));
+            matrices.push_back(make_float4x4_scale(2, 0.5f, -3));
+            matrices.push_back(make_float4x4_rotation_x(ToRadians(30.0f)) * make_float4x4_rotation_y(ToRadians(40.0f)) * make_float4x4_rotation_z(ToRadians(50.0f)));
+            matrices.push_back(make_float4x4_from_yaw_pitch_roll(0.3f, -1.2f, 2.5f) * make_float4x4_scale(1.5f) * make_float4x4_translation(-4, 5, 6));
+            matrices.push_back(make_float4x4_perspective_field_of_view(ToRadians(60.0f), 1.5f, 1.0f, 100.0f));
+            matrices.push_back(make_float4x4_look_at(float3(1, 2, 3), float3(-1, 0, 4), float3(0, 1, 0)));
+
+            // A general matrix with no special structure.
+            matrices.push_back(float4x4( 3.0f, -1.0f,  0.5f,  2.0f,
+                                         0.25f, 4.0f,  1.0f, -1.5f,
+                                        -2.0f,  0.75f, 5.0f,  0.5f,
+                                         1.0f,  2.0f, -0.5f,  6.0f));
+
+            return matrices;
+        }
+
+        static std::vector<quaternion> GetTestQuaternions()
+        {
+            float3 axis = normalize(float3(1.0f, 2.0f, 3.0f));
+
+            std::vector<quaternion> quaternions;
+
+            quaternions.push_back(quaternion::identity());
+            quaternions.push_back(make_quaternion_from_axis_angle(axis, ToRadians(10.0f)));
+            quaternions.push_back(make_quaternion_from_axis_angle(axis, ToRadians(10.01f)));
+            quaternions.push_back(make_quaternion_from_axis_angle(axis, ToRadians(170.0f)));
+            quaternions.push_back(-make_quaternion_from_axis_angle(axis, ToRadians(30.0f)));
+            quaternions.push_back(make_quaternion_from_yaw_pitch_roll(0.3f, -1.2f, 2.5f));
+            quaternions.push_back(make_quaternion_from_yaw_pitch_roll(-2.0f, 0.7f, 0.1f));
+
+            return quaternions;
+        }
+
+        static float4x4 ReferenceMultiply(float4x4 const& a, float4x4 const& b)
+        {
+            float const* m1 = &a.m11;
+            float const* m2 = &b.m11;
+
+            float4x4 result;
+            float* r = &result.m11;
+
+            for (int row = 0; row < 4; row++)
+            {
+                for (int column = 0; column < 4; column++)
+                {
+                    float sum = 0;
+
+                    for (int i = 0; i < 4; i++)
+                    {
+                        sum += m1[row * 4 + i] * m2[i * 4 + column];
+                    }
+
+                    r[row * 4 + column] = sum;
+                }
+            }
+
+            return result;
+        }
+
+        static quaternion ReferenceSlerp(quaternion const& q1, quaternion const& q2, float t)
+        {
+            float cosOmega = dot(q1, q2);
+            float sign = (cosOmega < 0) ? -1.0f : 1.0f;
+
+            cosOmega *= sign;
+
+            float s1, s2;
+
+            if (cosOmega > 0.99999f)
+            {
+                s1 = 1 - t;
+                s2 = t;
+            }
+            else
+            {
+                float omega = acosf(cosOmega);
+
+                s1 = sinf((1 - t) * omega) / sinf(omega);
+                s2 = sinf(t * omega) / sinf(omega);
+            }
+
+            return q1 * s1 + q2 * (s2 * sign);
+        }
+
+        static quaternion ReferenceConcatenate(quaternion const& q1, quaternion const& q2)
+        {
+            // Hamilton product q2 * q1, ie. rotation q1 followed by rotation q2.
+            return quaternion(q2.w * q1.x + q2.x * q1.w + q2.y * q1.z - q2.z * q1.y,
+                              q2.w * q1.y - q2.x * q1.z + q2.y * q1.w + q2.z * q1.x,
+                              q2.w * q1.z + q2.x * q1.y - q2.y * q1.x + q2.z * q1.w,
+                              q2.w * q1.w - q2.x * q1.x - q2.y * q1.y - q2.z * q1.z);
+        }
+
+        // Compares matrices with a tolerance relative to their magnitude, as the
+        // projection matrices have elements too large for the absolute Equal check.
+        static bool EqualRelative(float4x4 const& a, float4x4 const& b)
+        {
+            float const* m1 = &a.m11;
+            float const* m2 = &b.m11;
+
+            for (int i = 0; i < 16; i++)
+            {
+                float magnitude = fabs(m1[i]) > fabs(m2[i]) ? fabs(m1[i]) : fabs(m2[i]);
+                float tolerance = 1e-5f * (magnitude > 1 ? magnitude : 1);
+
+                if (fabs(m1[i] - m2[i]) > tolerance)
+                    return false;
+            }
+
+            return true;
+        }
+
+    public:
+        // A test for operator * (float4x4, float4x4)
+        TEST_METHOD(Float4x4MultiplyConformanceTest)
+        {
+            using namespace ::DirectX;
+
+            auto matrices = GetTestMatrices();
+
+            for (auto& a : matrices)
+            {
+                for (auto& b : matrices)
+                {
+                    float4x4 actual = a * b;
+
+                    float4x4 expected;
+                    XMStoreFloat4x4(&expected, XMMatrixMultiply(XMLoadFloat4x4(&a), XMLoadFloat4x4(&b)));
+
+                    Assert::IsTrue(EqualRelative(expected, actual), L"operator * did not match XMMatrixMultiply.");
+                    Assert::IsTrue(EqualRelative(ReferenceMultiply(a, b), actual), L"operator * did not match the reference implementation.");
+                }
+            }
+        }
+
+        // A test for invert (float4x4)
+        TEST_METHOD(Float4x4InvertConformanceTest)
+        {
+            using namespace ::DirectX;
+
+            for (auto& matrix : GetTestMatrices())
+            {
+                float4x4 actual;
+                Assert::IsTrue(invert(matrix, &actual), L"invert failed on an invertible matrix.");
+
+                float4x4 expected;
+                XMStoreFloat4x4(&expected, XMMatrixInverse(nullptr, XMLoadFloat4x4(&matrix)));
+
+                Assert::IsTrue(EqualRelative(expected, actual), L"invert did not match XMMatrixInverse.");
+                Assert::IsTrue(EqualRelative(ReferenceMultiply(matrix, actual), float4x4::identity()), L"invert did not produce the inverse.");
+            }
+
+            // Both backends must agree on what counts as singular.
+            float4x4 singular[] =
+            {
+                make_float4x4_scale(1, 0, 1),
+                float4x4(1, 2, 3, 4,
+                         2, 4, 6, 8,
+                         0, 1, 0, 1,
+                         1, 0, 1, 0),
+                make_float4x4_scale(1e-3f),
+            };
+
+            for (auto& matrix : singular)
+            {
+                float4x4 actual;
+                Assert::IsFalse(invert(matrix, &actual), L"invert did not fail on a singular matrix.");
+                Assert::IsTrue(isnan(actual.m11) && isnan(actual.m44), L"invert did not return NaN for a singular matrix.");
+            }
+        }
+
+        // A test for slerp (quaternion, quaternion, float)
+        TEST_METHOD(QuaternionSlerpConformanceTest)
+        {
+            using namespace ::DirectX;
+
+            float amounts[] = { 0.0f, 0.25f, 0.5f, 0.9f, 1.0f };
+
+            auto quaternions = GetTestQuaternions();
+
+            for (auto& a : quaternions)
+            {
+                for (auto& b : quaternions)
+                {
+                    for (float t : amounts)
+                    {
+                        quaternion actual = slerp(a, b, t);
+
+                        quaternion expected;
+                        XMStoreQuaternion(&expected, XMQuaternionSlerp(XMLoadQuaternion(&a), XMLoadQuaternion(&b), t));
+
+                        Assert::IsTrue(Equal(expected, actual), L"slerp did not match XMQuaternionSlerp.");
+                        Assert::IsTrue(Equal(ReferenceSlerp(a, b, t), actual), L"slerp did not match the reference implementation.");
+                    }
+                }
+            }
+        }
+
+        // A test for concatenate (quaternion, quaternion)
+        TEST_METHOD(QuaternionConcatenateConformanceTest)
+        {
+            using namespace ::DirectX;
+
+            auto quaternions = GetTestQuaternions();
+
+            for (auto& a : quaternions)
+            {
+                for (auto& b : quaternions)
+                {
+                    quaternion actual = concatenate(a, b);
+
+                    quaternion expected;
+                    XMStoreQuaternion(&expected, XMQuaternionMultiply(XMLoadQuaternion(&a), XMLoadQuaternion(&b)));
+
+                    Assert::IsTrue(Equal(expected, actual), L"concatenate did not match XMQuaternionMultiply.");
+                    Assert::IsTrue(Equal(ReferenceConcatenate(a, b), actual), L"concatenate did not match the reference implementation.");
+                }
+            }
+        }
+
+        // A test for decompose (float4x4)
+        TEST_METHOD(Float4x4DecomposeConformanceTest)
+        {
+            float3 scales(2, 0.5f, 3);
+            quaternion rotation = make_quaternion_from_yaw_pitch_roll(0.3f, -1.2f, 2.5f);
+            float3 translation(-4, 5, 6);
+
+            float4x4 matrix = make_float4x4_scale(scales) * make_float4x4_from_quaternion(rotation) * make_float4x4_translation(translation);
+
+            float3 actualScales;
+            quaternion actualRotation;
+            float3 actualTranslation;
+
+            Assert::IsTrue(decompose(matrix, &actualScales, &actualRotation, &actualTranslation), L"decompose failed.");
+
+            Assert::IsTrue(Equal(scales, actualScales), L"decompose did not return the expected scale.");
+            Assert::IsTrue(EqualRotation(rotation, actualRotation), L"decompose did not return the expected rotation.");
+            Assert::IsTrue(Equal(translation, actualTranslation), L"decompose did not return the expected translation.");
+        }
+    };
+}
@@ -1035,6 +1035,44 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction, common values and arithmetic (float2)
+        TEST_METHOD(Float2ConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            constexpr float2 a(1.0f, 2.0f);
+            constexpr float2 b(3.0f, 4.0f);
+
+            static_assert(a.x == 1.0f && a.y == 2.0f, "float2 constructor is not constexpr.");
+            static_assert(float2(5.0f) == float2(5.0f, 5.0f), "float2 constructor is not constexpr.");
+
+            static_assert(float2::zero() == float2(0, 0), "float2::zero is not constexpr.");
+            static_assert(float2::one() == float2(1, 1), "float2::one is not constexpr.");
+            static_assert(float2::unit_x() == float2(1, 0), "float2::unit_x is not constexpr.");
+            static_assert(float2::unit_y() == float2(0, 1), "float2::unit_y is not constexpr.");
+
+            static_assert(a + b == float2(4, 6), "float2 operator + is not constexpr.");
+            static_assert(b - a == float2(2, 2), "float2 operator - is not constexpr.");
+            static_assert(a * b == float2(3, 8), "float2 operator * is not constexpr.");
+            static_assert(a * 2.0f == float2(2, 4), "float2 operator * is not constexpr.");
+            static_assert(2.0f * a == float2(2, 4), "float2 operator * is not constexpr.");
+            static_assert(b / a == float2(3, 2), "float2 operator / is not constexpr.");
+            static_assert(b / 2.0f == float2(1.5f, 2), "float2 operator / is not constexpr.");
+            static_assert(-a == float2(-1, -2), "float2 operator - is not constexpr.");
+            static_assert(a != b, "float2 operator != is not constexpr.");
+            static_assert(dot(a, b) == 11.0f, "float2 dot is not constexpr.");
+
+            // A compile-time table must match the same values computed at runtime.
+            static constexpr float2 table[] = { a + b, a * b, -a };
+
+            float2 runtimeA = a;
+            float2 runtimeB = b;
+
+            Assert::AreEqual(runtimeA + runtimeB, table[0]);
+            Assert::AreEqual(runtimeA * runtimeB, table[1]);
+            Assert::AreEqual(-runtimeA, table[2]);
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
@@ -963,6 +963,46 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction, common values and arithmetic (float3)
+        TEST_METHOD(Float3ConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            constexpr float3 a(1.0f, 2.0f, 3.0f);
+            constexpr float3 b(4.0f, 6.0f, 9.0f);
+
+            static_assert(a.x == 1.0f && a.y == 2.0f && a.z == 3.0f, "float3 constructor is not constexpr.");
+            static_assert(float3(float2(1, 2), 3) == a, "float3 constructor is not constexpr.");
+            static_assert(float3(5.0f) == float3(5, 5, 5), "float3 constructor is not constexpr.");
+
+            static_assert(float3::zero() == float3(0, 0, 0), "float3::zero is not constexpr.");
+            static_assert(float3::one() == float3(1, 1, 1), "float3::one is not constexpr.");
+            static_assert(float3::unit_x() == float3(1, 0, 0), "float3::unit_x is not constexpr.");
+            static_assert(float3::unit_y() == float3(0, 1, 0), "float3::unit_y is not constexpr.");
+            static_assert(float3::unit_z() == float3(0, 0, 1), "float3::unit_z is not constexpr.");
+
+            static_assert(a + b == float3(5, 8, 12), "float3 operator + is not constexpr.");
+            static_assert(b - a == float3(3, 4, 6), "float3 operator - is not constexpr.");
+            static_assert(a * b == float3(4, 12, 27), "float3 operator * is not constexpr.");
+            static_assert(a * 2.0f == float3(2, 4, 6), "float3 operator * is not constexpr.");
+            static_assert(2.0f * a == float3(2, 4, 6), "float3 operator * is not constexpr.");
+            static_assert(b / a == float3(4, 3, 3), "float3 operator / is not constexpr.");
+            static_assert(b / 2.0f == float3(2, 3, 4.5f), "float3 operator / is not constexpr.");
+            static_assert(-a == float3(-1, -2, -3), "float3 operator - is not constexpr.");
+            static_assert(a != b, "float3 operator != is not constexpr.");
+            static_assert(dot(a, b) == 43.0f, "float3 dot is not constexpr.");
+
+            // A compile-time table must match the same values computed at runtime.
+            static constexpr float3 table[] = { a + b, a * b, -a };
+
+            float3 runtimeA = a;
+            float3 runtimeB = b;
+
+            Assert::AreEqual(runtimeA + runtimeB, table[0]);
+            Assert::AreEqual(runtimeA * runtimeB, table[1]);
+            Assert::AreEqual(-runtimeA, table[2]);
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
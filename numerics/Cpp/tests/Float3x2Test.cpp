@@ -942,6 +942,35 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction, factories and arithmetic (float3x2)
+        TEST_METHOD(Float3x2ConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            constexpr float3x2 a(1, 2, 3, 4, 5, 6);
+
+            static_assert(a.m11 == 1 && a.m12 == 2 && a.m21 == 3 && a.m22 == 4 && a.m31 == 5 && a.m32 == 6, "float3x2 constructor is not constexpr.");
+            static_assert(float3x2::identity() == float3x2(1, 0, 0, 1, 0, 0), "float3x2::identity is not constexpr.");
+
+            static_assert(make_float3x2_translation(float2(5, 6)) == float3x2(1, 0, 0, 1, 5, 6), "make_float3x2_translation is not constexpr.");
+            static_assert(make_float3x2_translation(5, 6) == float3x2(1, 0, 0, 1, 5, 6), "make_float3x2_translation is not constexpr.");
+            static_assert(make_float3x2_scale(2, 3) == float3x2(2, 0, 0, 3, 0, 0), "make_float3x2_scale is not constexpr.");
+            static_assert(make_float3x2_scale(float2(2, 3)) == float3x2(2, 0, 0, 3, 0, 0), "make_float3x2_scale is not constexpr.");
+            static_assert(make_float3x2_scale(2) == float3x2(2, 0, 0, 2, 0, 0), "make_float3x2_scale is not constexpr.");
+
+            static_assert(a + a == a * 2.0f, "float3x2 operator + is not constexpr.");
+            static_assert(a - a == float3x2(0, 0, 0, 0, 0, 0), "float3x2 operator - is not constexpr.");
+            static_assert(-a == float3x2(-1, -2, -3, -4, -5, -6), "float3x2 operator - is not constexpr.");
+            static_assert(a * float3x2::identity() == a, "float3x2 operator * is not constexpr.");
+            static_assert(make_float3x2_scale(2) * make_float3x2_translation(5, 6) == float3x2(2, 0, 0, 2, 5, 6), "float3x2 operator * is not constexpr.");
+            static_assert(a != float3x2::identity(), "float3x2 operator != is not constexpr.");
+
+            // A compile-time table must match the same values computed at runtime.
+            static constexpr float3x2 table[] = { make_float3x2_scale(2, 3) * make_float3x2_translation(5, 6) };
+
+            Assert::AreEqual(make_float3x2_scale(float2(2, 3)) * make_float3x2_translation(float2(5, 6)), table[0]);
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
@@ -1147,6 +1147,33 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction and common values (float4)
+        TEST_METHOD(Float4ConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            // float4 arithmetic has a SIMD implementation, so only construction is constexpr.
+            constexpr float4 a(1.0f, 2.0f, 3.0f, 4.0f);
+
+            static_assert(a.x == 1.0f && a.y == 2.0f && a.z == 3.0f && a.w == 4.0f, "float4 constructor is not constexpr.");
+            static_assert(float4(float2(1, 2), 3, 4) == a, "float4 constructor is not constexpr.");
+            static_assert(float4(float3(1, 2, 3), 4) == a, "float4 constructor is not constexpr.");
+            static_assert(float4(5.0f) == float4(5, 5, 5, 5), "float4 constructor is not constexpr.");
+            static_assert(a != float4::zero(), "float4 operator != is not constexpr.");
+
+            static_assert(float4::zero() == float4(0, 0, 0, 0), "float4::zero is not constexpr.");
+            static_assert(float4::one() == float4(1, 1, 1, 1), "float4::one is not constexpr.");
+            static_assert(float4::unit_x() == float4(1, 0, 0, 0), "float4::unit_x is not constexpr.");
+            static_assert(float4::unit_y() == float4(0, 1, 0, 0), "float4::unit_y is not constexpr.");
+            static_assert(float4::unit_z() == float4(0, 0, 1, 0), "float4::unit_z is not constexpr.");
+            static_assert(float4::unit_w() == float4(0, 0, 0, 1), "float4::unit_w is not constexpr.");
+
+            // Runtime arithmetic works on values from a compile-time table.
+            static constexpr float4 table[] = { float4::unit_x(), float4::unit_y() };
+
+            Assert::AreEqual(float4(1, 1, 0, 0), table[0] + table[1]);
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
@@ -2245,6 +2245,32 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction and factories (float4x4)
+        TEST_METHOD(Float4x4ConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            // float4x4 arithmetic has a SIMD implementation, so only construction is constexpr.
+            constexpr float4x4 identity = float4x4::identity();
+
+            static_assert(identity.m11 == 1 && identity.m22 == 1 && identity.m33 == 1 && identity.m44 == 1, "float4x4::identity is not constexpr.");
+            static_assert(identity == float4x4(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1), "float4x4 constructor is not constexpr.");
+            static_assert(float4x4(float3x2::identity()) == identity, "float4x4 constructor is not constexpr.");
+            static_assert(float4x4(make_float3x2_translation(5, 6)) == make_float4x4_translation(5, 6, 0), "float4x4 constructor is not constexpr.");
+
+            static_assert(make_float4x4_translation(float3(5, 6, 7)) == float4x4(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1), "make_float4x4_translation is not constexpr.");
+            static_assert(make_float4x4_translation(5, 6, 7) == make_float4x4_translation(float3(5, 6, 7)), "make_float4x4_translation is not constexpr.");
+            static_assert(make_float4x4_scale(2, 3, 4) == float4x4(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 0, 0, 0, 1), "make_float4x4_scale is not constexpr.");
+            static_assert(make_float4x4_scale(float3(2, 3, 4)) == make_float4x4_scale(2, 3, 4), "make_float4x4_scale is not constexpr.");
+            static_assert(make_float4x4_scale(2) == make_float4x4_scale(2, 2, 2), "make_float4x4_scale is not constexpr.");
+            static_assert(make_float4x4_scale(2) != identity, "float4x4 operator != is not constexpr.");
+
+            // Runtime arithmetic works on values from a compile-time table.
+            static constexpr float4x4 table[] = { make_float4x4_scale(2), make_float4x4_translation(5, 6, 7) };
+
+            Assert::AreEqual(float4x4(2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 5, 6, 7, 1), table[0] * table[1]);
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
@@ -0,0 +1,345 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+namespace NumericsTests
+{
+    // Sizes chosen to cover empty arrays, partial SIMD blocks, and exact multiples of the block size.
+    static const size_t HalfTestSizes[] = { 0, 1, 3, 4, 5, 8, 17 };
+
+
+    static bool IsHalfNaN(uint16_t bits)
+    {
+        return (bits & 0x7C00) == 0x7C00 && (bits & 0x3FF) != 0;
+    }
+
+
+    // Every half value as a float, plus the midpoints between neighbouring halves and values
+    // just either side of those midpoints, so rounding is exercised in every exponent range.
+    static std::vector<float> MakeHalfRoundingTestValues()
+    {
+        std::vector<float> values;
+
+        for (uint32_t i = 0; i < 0x7C00; i++)
+        {
+            float value = half::from_bits(static_cast<uint16_t>(i));
+            float next = half::from_bits(static_cast<uint16_t>(i + 1));
+            float midpoint = (value + next) / 2;
+
+            float nearMidpoints[] = { value, midpoint, nextafterf(midpoint, 0), nextafterf(midpoint, next) };
+
+            for (float v : nearMidpoints)
+            {
+                values.push_back(v);
+                values.push_back(-v);
+            }
+        }
+
+        float specialValues[] = { 65520.0f, 1e10f, 1e-10f, 1e-30f, FLT_MAX, FLT_MIN, std::numeric_limits<float>::denorm_min() };
+
+        for (float v : specialValues)
+        {
+            values.push_back(v);
+            values.push_back(-v);
+        }
+
+        values.push_back(std::numeric_limits<float>::infinity());
+        values.push_back(-std::numeric_limits<float>::infinity());
+        values.push_back(std::numeric_limits<float>::quiet_NaN());
+
+        return values;
+    }
+
+
+    NUMERICS_TEST_CLASS(HalfTest)
+    {
+        NUMERICS_TEST_CLASS_INNER(HalfTest)
+
+        static void VerifyHalfBits(float value, uint16_t expected)
+        {
+            Assert::AreEqual(expected, half(value).bits, L"half did not convert to the expected bits.");
+        }
+
+    public:
+        // A test for half (float)
+        TEST_METHOD(HalfConstructorTest)
+        {
+            VerifyHalfBits(0.0f, 0x0000);
+            VerifyHalfBits(-0.0f, 0x8000);
+            VerifyHalfBits(1.0f, 0x3C00);
+            VerifyHalfBits(-2.0f, 0xC000);
+            VerifyHalfBits(0.5f, 0x3800);
+            VerifyHalfBits(65504.0f, 0x7BFF);
+
+            // Smallest normal and denormal halves.
+            VerifyHalfBits(6.103515625e-5f, 0x0400);
+            VerifyHalfBits(5.9604645e-8f, 0x0001);
+
+            // Round to nearest even.
+            VerifyHalfBits(1.0f / 3.0f, 0x3555);
+            VerifyHalfBits(1.0f + 1.0f / 2048.0f, 0x3C00);
+            VerifyHalfBits(1.0f + 3.0f / 2048.0f, 0x3C02);
+            VerifyHalfBits(2.9802322e-8f, 0x0000);
+            VerifyHalfBits(8.940697e-8f, 0x0002);
+
+            // Overflow.
+            VerifyHalfBits(65519.0f, 0x7BFF);
+            VerifyHalfBits(65520.0f, 0x7C00);
+            VerifyHalfBits(-1e10f, 0xFC00);
+            VerifyHalfBits(std::numeric_limits<float>::infinity(), 0x7C00);
+            VerifyHalfBits(-std::numeric_limits<float>::infinity(), 0xFC00);
+
+            // Underflow.
+            VerifyHalfBits(1e-10f, 0x0000);
+            VerifyHalfBits(-1e-10f, 0x8000);
+            VerifyHalfBits(std::numeric_limits<float>::denorm_min(), 0x0000);
+
+            Assert::IsTrue(IsHalfNaN(half(std::numeric_limits<float>::quiet_NaN()).bits));
+        }
+
+        // A test for half::operator float
+        TEST_METHOD(HalfRoundTripTest)
+        {
+            // Every half value must survive a round trip through float.
+            for (uint32_t i = 0; i <= 0xFFFF; i++)
+            {
+                half value = half::from_bits(static_cast<uint16_t>(i));
+                float f = value;
+
+                if (IsHalfNaN(value.bits))
+                {
+                    Assert::IsTrue(isnan(f), L"half NaN did not convert to float NaN.");
+                    Assert::IsTrue(IsHalfNaN(half(f).bits), L"float NaN did not convert to half NaN.");
+                }
+                else
+                {
+                    Assert::AreEqual(value.bits, half(f).bits, L"half did not round trip through float.");
+                }
+            }
+
+            Assert::AreEqual(1.0f, static_cast<float>(half::from_bits(0x3C00)));
+            Assert::AreEqual(-2.0f, static_cast<float>(half::from_bits(0xC000)));
+            Assert::AreEqual(65504.0f, static_cast<float>(half::from_bits(0x7BFF)));
+            Assert::AreEqual(5.9604645e-8f, static_cast<float>(half::from_bits(0x0001)));
+            Assert::IsTrue(isinf(static_cast<float>(half::from_bits(0x7C00))));
+        }
+
+        // A test for half operator == and !=
+        TEST_METHOD(HalfEqualityTest)
+        {
+            Assert::IsTrue(half(1.0f) == half(1.0f));
+            Assert::IsFalse(half(1.0f) == half(2.0f));
+            Assert::IsTrue(half(1.0f) != half(2.0f));
+
+            // Comparisons behave the same as for float.
+            Assert::IsTrue(half(0.0f) == half(-0.0f));
+
+            half nan(std::numeric_limits<float>::quiet_NaN());
+
+            Assert::IsFalse(nan == nan);
+            Assert::IsTrue(nan != nan);
+        }
+
+        // A test for half2 (float2) and half2::operator float2
+        TEST_METHOD(Half2ConversionTest)
+        {
+            half2 value(float2(1.5f, -0.25f));
+
+            Assert::AreEqual(uint16_t(0x3E00), value.x.bits);
+            Assert::AreEqual(uint16_t(0xB400), value.y.bits);
+
+            float2 f = value;
+            Assert::AreEqual(float2(1.5f, -0.25f), f);
+
+            Assert::IsTrue(half2(half(1.0f), half(2.0f)) == half2(float2(1, 2)));
+            Assert::IsTrue(half2(half(1.0f), half(2.0f)) != half2(float2(1, 3)));
+
+            // Values that are not exactly representable are rounded.
+            float2 rounded = half2(float2(1.0f / 3.0f, 100000.0f));
+            Assert::AreEqual(0.333251953125f, rounded.x);
+            Assert::IsTrue(isinf(rounded.y));
+        }
+
+        // A test for half4 (float4) and half4::operator float4
+        TEST_METHOD(Half4ConversionTest)
+        {
+            half4 value(float4(1.5f, -0.25f, 0.0f, 65504.0f));
+
+            Assert::AreEqual(uint16_t(0x3E00), value.x.bits);
+            Assert::AreEqual(uint16_t(0xB400), value.y.bits);
+            Assert::AreEqual(uint16_t(0x0000), value.z.bits);
+            Assert::AreEqual(uint16_t(0x7BFF), value.w.bits);
+
+            float4 f = value;
+            Assert::AreEqual(float4(1.5f, -0.25f, 0.0f, 65504.0f), f);
+
+            Assert::IsTrue(half4(half(1.0f), half(2.0f), half(3.0f), half(4.0f)) == half4(float4(1, 2, 3, 4)));
+            Assert::IsTrue(half4(half(1.0f), half(2.0f), half(3.0f), half(4.0f)) != half4(float4(1, 2, 3, 5)));
+        }
+
+        // A test for half, half2 and half4 layout, which must match the DXGI 16 bit float formats
+        TEST_METHOD(HalfSizeofTest)
+        {
+            Assert::AreEqual(size_t(2), sizeof(half));
+            Assert::AreEqual(size_t(4), sizeof(half2));
+            Assert::AreEqual(size_t(8), sizeof(half4));
+
+            half4 value(float4(1, 2, 3, 4));
+            uint16_t const* bits = reinterpret_cast<uint16_t const*>(&value);
+
+            Assert::AreEqual(half(1.0f).bits, bits[0]);
+            Assert::AreEqual(half(2.0f).bits, bits[1]);
+            Assert::AreEqual(half(3.0f).bits, bits[2]);
+            Assert::AreEqual(half(4.0f).bits, bits[3]);
+        }
+
+        // A test for convert_to_half (float const*, size_t, half*)
+        TEST_METHOD(HalfBulkConvertToHalfTest)
+        {
+            // The bulk conversion must exactly match converting values one at a time,
+            // whether or not it is using F16C instructions.
+            auto values = MakeHalfRoundingTestValues();
+
+            std::vector<half> bulk(values.size());
+            convert_to_half(values.data(), values.size(), bulk.data());
+
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                uint16_t expected = half(values[i]).bits;
+
+                if (IsHalfNaN(expected))
+                {
+                    Assert::IsTrue(IsHalfNaN(bulk[i].bits), L"convert_to_half did not produce NaN.");
+                }
+                else
+                {
+                    Assert::AreEqual(expected, bulk[i].bits, L"convert_to_half did not match half (float).");
+                }
+            }
+        }
+
+        // A test for convert_to_float (half const*, size_t, float*)
+        TEST_METHOD(HalfBulkConvertToFloatTest)
+        {
+            std::vector<half> values;
+
+            for (uint32_t i = 0; i <= 0xFFFF; i++)
+            {
+                values.push_back(half::from_bits(static_cast<uint16_t>(i)));
+            }
+
+            std::vector<float> bulk(values.size());
+            convert_to_float(values.data(), values.size(), bulk.data());
+
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                float expected = values[i];
+
+                if (isnan(expected))
+                {
+                    Assert::IsTrue(isnan(bulk[i]), L"convert_to_float did not produce NaN.");
+                }
+                else
+                {
+                    Assert::AreEqual(expected, bulk[i], L"convert_to_float did not match half::operator float.");
+                    Assert::AreEqual(signbit(expected), signbit(bulk[i]), L"convert_to_float did not preserve the sign.");
+                }
+            }
+        }
+
+        // A test for convert_to_half and convert_to_float with float2 and float4 arrays of various sizes
+        TEST_METHOD(HalfBulkVectorTest)
+        {
+            for (size_t size : HalfTestSizes)
+            {
+                std::vector<float4> values(size);
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    values[i] = float4(i * 0.5f, -(i * 1.25f), i * 100.0f, 1.0f / (i + 1));
+                }
+
+                // One extra element to detect writes past the end of the output.
+                const uint16_t sentinelBits = 0x1234;
+                const half sentinel = half::from_bits(sentinelBits);
+
+                std::vector<half4> halves(size + 1, half4(sentinel, sentinel, sentinel, sentinel));
+                convert_to_half(values.data(), size, halves.data());
+
+                std::vector<float4> roundTrip(size + 1, float4(42));
+                convert_to_float(halves.data(), size, roundTrip.data());
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    Assert::IsTrue(halves[i] == half4(values[i]), L"convert_to_half did not match half4 (float4).");
+                    Assert::AreEqual(static_cast<float4>(half4(values[i])), roundTrip[i], L"convert_to_float did not match half4::operator float4.");
+                }
+
+                Assert::AreEqual(sentinelBits, halves[size].w.bits, L"convert_to_half wrote past the end of the output.");
+                Assert::AreEqual(float4(42), roundTrip[size], L"convert_to_float wrote past the end of the output.");
+
+                // The same data viewed as float2 pairs.
+                std::vector<float2> values2(size * 2);
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    values2[i * 2] = float2(values[i].x, values[i].y);
+                    values2[i * 2 + 1] = float2(values[i].z, values[i].w);
+                }
+
+                std::vector<half2> halves2(size * 2);
+                convert_to_half(values2.data(), size * 2, halves2.data());
+
+                std::vector<float2> roundTrip2(size * 2);
+                convert_to_float(halves2.data(), size * 2, roundTrip2.data());
+
+                for (size_t i = 0; i < size * 2; i++)
+                {
+                    Assert::IsTrue(halves2[i] == half2(values2[i]), L"convert_to_half did not match half2 (float2).");
+                    Assert::AreEqual(static_cast<float2>(half2(values2[i])), roundTrip2[i], L"convert_to_float did not match half2::operator float2.");
+                }
+            }
+        }
+
+        // A test for convert_to_half and convert_to_float with unaligned source and destination pointers
+        TEST_METHOD(HalfBulkUnalignedTest)
+        {
+            std::vector<float> values(21);
+
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                values[i] = sinf(i * 0.7f) * 1000.0f;
+            }
+
+            for (size_t offset = 0; offset < 4; offset++)
+            {
+                size_t count = values.size() - offset;
+
+                std::vector<half> halves(values.size());
+                convert_to_half(values.data() + offset, count, halves.data() + offset);
+
+                std::vector<float> roundTrip(values.size());
+                convert_to_float(halves.data() + offset, count, roundTrip.data() + offset);
+
+                for (size_t i = offset; i < values.size(); i++)
+                {
+                    Assert::AreEqual(half(values[i]).bits, halves[i].bits);
+                    Assert::AreEqual(static_cast<float>(half(values[i])), roundTrip[i]);
+                }
+            }
+        }
+    };
+}
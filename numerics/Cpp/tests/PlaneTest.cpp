@@ -347,6 +347,19 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction (plane)
+        TEST_METHOD(PlaneConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            constexpr plane a(1, 2, 3, 4);
+
+            static_assert(a.normal == float3(1, 2, 3) && a.d == 4, "plane constructor is not constexpr.");
+            static_assert(plane(float3(1, 2, 3), 4) == a, "plane constructor is not constexpr.");
+            static_assert(plane(float4(1, 2, 3, 4)) == a, "plane constructor is not constexpr.");
+            static_assert(plane(1, 2, 3, 5) != a, "plane operator != is not constexpr.");
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
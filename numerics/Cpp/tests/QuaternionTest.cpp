@@ -906,6 +906,20 @@ namespace NumericsTests
         }
 
 
+        // A test for constexpr construction (quaternion)
+        TEST_METHOD(QuaternionConstexprTest)
+        {
+#ifdef WINDOWS_NUMERICS_HAS_CONSTEXPR
+            // quaternion arithmetic has a SIMD implementation, so only construction is constexpr.
+            constexpr quaternion a(1, 2, 3, 4);
+
+            static_assert(a.x == 1 && a.y == 2 && a.z == 3 && a.w == 4, "quaternion constructor is not constexpr.");
+            static_assert(quaternion(float3(1, 2, 3), 4) == a, "quaternion constructor is not constexpr.");
+            static_assert(quaternion::identity() == quaternion(0, 0, 0, 1), "quaternion::identity is not constexpr.");
+            static_assert(quaternion::identity() != a, "quaternion operator != is not constexpr.");
+#endif
+        }
+
 #ifndef DISABLE_NUMERICS_INTEROP_TESTS
 
         // A test to validate interop between WindowsNumerics.h (Windows::Foundation::Numerics) and the WinRT struct types
@@ -0,0 +1,340 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+namespace NumericsTests
+{
+    // Sizes chosen to cover empty arrays, partial SIMD blocks, and exact multiples of the block size.
+    static const size_t SoATestSizes[] = { 0, 1, 3, 4, 5, 8, 17 };
+
+
+    // Deterministic test data, with a mixture of signs and magnitudes in every component.
+    template<typename T>
+    static std::vector<T> MakeSoATestValues(size_t count, float seed)
+    {
+        std::vector<T> values(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            float* components = reinterpret_cast<float*>(&values[i]);
+
+            for (size_t c = 0; c < sizeof(T) / sizeof(float); c++)
+            {
+                components[c] = sinf(seed + i * 0.7f + c * 1.3f) * (1.0f + c * 0.25f);
+            }
+        }
+
+        return values;
+    }
+
+
+    template<typename T>
+    static bool IsAligned(T const* pointer)
+    {
+        return (reinterpret_cast<uintptr_t>(pointer) & 15) == 0;
+    }
+
+
+    NUMERICS_TEST_CLASS(SoATest)
+    {
+        NUMERICS_TEST_CLASS_INNER(SoATest)
+
+        // Checks that an SoA array holds the same values as a list of AoS vectors.
+        template<typename T>
+        static bool SoAEqual(soa_array<T> const& actual, std::vector<T> const& expected)
+        {
+            if (actual.size() != expected.size())
+                return false;
+
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                if (!Equal(actual.get(i), expected[i]))
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Runs a binary SoA operation and compares it against the equivalent AoS operation.
+        template<typename T, typename TSoAOperation, typename TAoSOperation>
+        static void VerifyBinaryOperation(TSoAOperation const& soaOperation, TAoSOperation const& aosOperation)
+        {
+            for (size_t size : SoATestSizes)
+            {
+                auto a = MakeSoATestValues<T>(size, 1.0f);
+                auto b = MakeSoATestValues<T>(size, 2.0f);
+
+                std::vector<T> expected(size);
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    expected[i] = aosOperation(a[i], b[i]);
+                }
+
+                soa_array<T> soaA(a.data(), size);
+                soa_array<T> soaB(b.data(), size);
+                soa_array<T> result;
+
+                soaOperation(soaA, soaB, &result);
+                Assert::IsTrue(SoAEqual(result, expected), L"SoA operation did not match AoS.");
+
+                // Results are allowed to alias the inputs.
+                soaOperation(soaA, soaB, &soaA);
+                Assert::IsTrue(SoAEqual(soaA, expected), L"SoA operation did not match AoS when aliased.");
+            }
+        }
+
+        template<typename T>
+        static void VerifyElementwiseOperations()
+        {
+            VerifyBinaryOperation<T>([](soa_array<T> const& a, soa_array<T> const& b, soa_array<T>* r) { add(a, b, r); },
+                                     [](T const& a, T const& b) { return a + b; });
+
+            VerifyBinaryOperation<T>([](soa_array<T> const& a, soa_array<T> const& b, soa_array<T>* r) { subtract(a, b, r); },
+                                     [](T const& a, T const& b) { return a - b; });
+
+            VerifyBinaryOperation<T>([](soa_array<T> const& a, soa_array<T> const& b, soa_array<T>* r) { multiply(a, b, r); },
+                                     [](T const& a, T const& b) { return a * b; });
+
+            VerifyBinaryOperation<T>([](soa_array<T> const& a, soa_array<T> const&, soa_array<T>* r) { scale(a, 2.5f, r); },
+                                     [](T const& a, T const&) { return a * 2.5f; });
+
+            VerifyBinaryOperation<T>([](soa_array<T> const& a, soa_array<T> const& b, soa_array<T>* r) { lerp(a, b, 0.25f, r); },
+                                     [](T const& a, T const& b) { return lerp(a, b, 0.25f); });
+
+            VerifyBinaryOperation<T>([](soa_array<T> const& a, soa_array<T> const&, soa_array<T>* r) { normalize(a, r); },
+                                     [](T const& a, T const&) { return normalize(a); });
+        }
+
+        template<typename T>
+        static void VerifyReductions()
+        {
+            for (size_t size : SoATestSizes)
+            {
+                auto a = MakeSoATestValues<T>(size, 3.0f);
+                auto b = MakeSoATestValues<T>(size, 4.0f);
+
+                soa_array<T> soaA(a.data(), size);
+                soa_array<T> soaB(b.data(), size);
+
+                // One extra float to detect writes past the end of the output.
+                const float sentinel = 12345.0f;
+
+                std::vector<float> dots(size + 1, sentinel);
+                std::vector<float> lengths(size + 1, sentinel);
+                std::vector<float> lengthsSquared(size + 1, sentinel);
+
+                dot(soaA, soaB, dots.data());
+                length(soaA, lengths.data());
+                length_squared(soaA, lengthsSquared.data());
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    Assert::IsTrue(Equal(dot(a[i], b[i]), dots[i]), L"SoA dot did not match AoS.");
+                    Assert::IsTrue(Equal(length(a[i]), lengths[i]), L"SoA length did not match AoS.");
+                    Assert::IsTrue(Equal(length_squared(a[i]), lengthsSquared[i]), L"SoA length_squared did not match AoS.");
+                }
+
+                Assert::AreEqual(sentinel, dots[size], L"SoA dot wrote past the end of the output.");
+                Assert::AreEqual(sentinel, lengths[size], L"SoA length wrote past the end of the output.");
+                Assert::AreEqual(sentinel, lengthsSquared[size], L"SoA length_squared wrote past the end of the output.");
+            }
+        }
+
+        template<typename T, typename TMatrix>
+        static void VerifyTransform(TMatrix const& matrix)
+        {
+            for (size_t size : SoATestSizes)
+            {
+                auto a = MakeSoATestValues<T>(size, 5.0f);
+
+                std::vector<T> expected(size);
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    expected[i] = transform(a[i], matrix);
+                }
+
+                soa_array<T> soaA(a.data(), size);
+                soa_array<T> result;
+
+                transform(soaA, matrix, &result);
+                Assert::IsTrue(SoAEqual(result, expected), L"SoA transform did not match AoS.");
+
+                transform(soaA, matrix, &soaA);
+                Assert::IsTrue(SoAEqual(soaA, expected), L"SoA transform did not match AoS when aliased.");
+            }
+        }
+
+        template<typename T>
+        static void VerifyContainer()
+        {
+            for (size_t size : SoATestSizes)
+            {
+                auto values = MakeSoATestValues<T>(size, 6.0f);
+
+                // Round trip through SoA form.
+                soa_array<T> soa(values.data(), size);
+
+                Assert::AreEqual(size, soa.size());
+                Assert::AreEqual(size == 0, soa.empty());
+                Assert::IsTrue(soa.capacity() % 4 == 0);
+
+                std::vector<T> roundTrip(size);
+                soa.copy_to(roundTrip.data());
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    Assert::AreEqual(values[i], roundTrip[i]);
+                    Assert::AreEqual(values[i], soa.get(i));
+                }
+
+                // Component streams are separate, aligned, and hold the individual components.
+                for (size_t c = 0; c < soa_array<T>::component_count; c++)
+                {
+                    if (size)
+                    {
+                        Assert::IsTrue(IsAligned(soa.component(c)));
+                    }
+
+                    for (size_t i = 0; i < size; i++)
+                    {
+                        Assert::AreEqual(reinterpret_cast<float const*>(&values[i])[c], soa.component(c)[i]);
+                    }
+                }
+
+                // Copy and move.
+                soa_array<T> copy(soa);
+                Assert::IsTrue(SoAEqual(copy, values));
+
+                soa_array<T> moved(std::move(copy));
+                Assert::IsTrue(SoAEqual(moved, values));
+                Assert::AreEqual(size_t(0), copy.size());
+
+                soa_array<T> assigned;
+                assigned = moved;
+                Assert::IsTrue(SoAEqual(assigned, values));
+            }
+        }
+
+        template<typename T>
+        static void VerifyResize()
+        {
+            auto values = MakeSoATestValues<T>(6, 7.0f);
+
+            soa_array<T> soa(values.data(), values.size());
+
+            // Fill the padding lanes with junk, by normalizing zero padding to NaN.
+            normalize(soa, &soa);
+
+            soa.resize(3);
+            Assert::AreEqual(size_t(3), soa.size());
+
+            // Growing must zero the new elements, even those that were previously padding.
+            soa.resize(11);
+            Assert::AreEqual(size_t(11), soa.size());
+
+            for (size_t i = 3; i < 11; i++)
+            {
+                Assert::AreEqual(T(0), soa.get(i));
+            }
+
+            soa.clear();
+            Assert::IsTrue(soa.empty());
+
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                soa.push_back(values[i]);
+            }
+
+            Assert::IsTrue(SoAEqual(soa, values));
+
+            soa.set(2, T(42));
+            Assert::AreEqual(T(42), soa.get(2));
+
+            soa.reserve(100);
+            Assert::IsTrue(soa.capacity() >= 100);
+            Assert::AreEqual(values.size(), soa.size());
+            Assert::AreEqual(values[0], soa.get(0));
+        }
+
+    public:
+        TEST_METHOD(Float2SoAContainerTest)
+        {
+            VerifyContainer<float2>();
+            VerifyResize<float2>();
+        }
+
+        TEST_METHOD(Float3SoAContainerTest)
+        {
+            VerifyContainer<float3>();
+            VerifyResize<float3>();
+        }
+
+        TEST_METHOD(Float4SoAContainerTest)
+        {
+            VerifyContainer<float4>();
+            VerifyResize<float4>();
+        }
+
+        TEST_METHOD(Float2SoAElementwiseTest)
+        {
+            VerifyElementwiseOperations<float2>();
+            VerifyReductions<float2>();
+        }
+
+        TEST_METHOD(Float3SoAElementwiseTest)
+        {
+            VerifyElementwiseOperations<float3>();
+            VerifyReductions<float3>();
+        }
+
+        TEST_METHOD(Float4SoAElementwiseTest)
+        {
+            VerifyElementwiseOperations<float4>();
+            VerifyReductions<float4>();
+        }
+
+        TEST_METHOD(Float2SoATransformTest)
+        {
+            VerifyTransform<float2>(make_float3x2_rotation(ToRadians(30.0f), float2(3, 4)) * make_float3x2_translation(5, -6));
+            VerifyTransform<float2>(make_float4x4_from_yaw_pitch_roll(0.1f, 0.2f, 0.3f) * make_float4x4_translation(1, 2, 3));
+        }
+
+        TEST_METHOD(Float3SoATransformTest)
+        {
+            VerifyTransform<float3>(make_float4x4_from_yaw_pitch_roll(0.1f, 0.2f, 0.3f) * make_float4x4_translation(1, 2, 3));
+        }
+
+        TEST_METHOD(Float4SoATransformTest)
+        {
+            VerifyTransform<float4>(make_float4x4_perspective_field_of_view(ToRadians(60.0f), 1.5f, 1.0f, 100.0f));
+        }
+
+        TEST_METHOD(SoASizeMismatchTest)
+        {
+            float2_soa a(3);
+            float2_soa b(4);
+            float2_soa result;
+
+            Assert::ExpectException<std::invalid_argument>([&] { add(a, b, &result); });
+            Assert::ExpectException<std::invalid_argument>([&] { lerp(a, b, 0.5f, &result); });
+
+            float dots[4];
+            Assert::ExpectException<std::invalid_argument>([&] { dot(a, b, dots); });
+        }
+    };
+}
@@ -13,12 +13,16 @@
 #pragma once
 
 #include "../WindowsNumerics.h"
+#include "../WindowsNumericsSoA.h"
+#include "../WindowsNumericsHalf.h"
 
 #pragma warning(disable: 4505)  // "unreferenced local function"
 
 #include <SDKDDKVer.h>
 #include <CppUnitTest.h>
 
+#include <vector>
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 #define NUMERICS_TEST_CLASS(ClassName) TEST_CLASS(ClassName)
@@ -16,6 +16,7 @@
 #include <wrl\async.h>
 #include <Windows.System.Threading.h>
 #include <functional>
+#include "AsyncScheduler.h"
 #include "ErrorHandling.h"
 
 
@@ -39,6 +40,12 @@ struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncOperation<TResu
     typedef ABI::Windows::Foundation::IAsyncOperationCompletedHandler<TResult> Type;
 };
 
+template<typename TResult, typename TProgress>
+struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncOperationWithProgress<TResult, TProgress>>
+{
+    typedef ABI::Windows::Foundation::IAsyncOperationWithProgressCompletedHandler<TResult, TProgress> Type;
+};
+
 template<>
 struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncAction>
 {
@@ -46,9 +53,24 @@ struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncAction>
 };
 
 
-// Common implementation code shared between AsyncOperation and AsyncAction.
+// Traits helper for deducing the type of the progress handler delegate.
+// Async interfaces that do not report progress use WRL's Nil placeholder.
+template<typename T>
+struct AsyncProgressHandlerType
+{
+    typedef Microsoft::WRL::Details::Nil Type;
+};
+
+template<typename TResult, typename TProgress>
+struct AsyncProgressHandlerType<ABI::Windows::Foundation::IAsyncOperationWithProgress<TResult, TProgress>>
+{
+    typedef ABI::Windows::Foundation::IAsyncOperationProgressHandler<TResult, TProgress> Type;
+};
+
+
+// Common implementation code shared between AsyncOperation, AsyncOperationWithProgress and AsyncAction.
 template<typename T>
-class AsyncCommon : public Microsoft::WRL::RuntimeClass<Microsoft::WRL::AsyncBase<typename AsyncCompletedHandlerType<T>::Type>, T>
+class AsyncCommon : public Microsoft::WRL::RuntimeClass<Microsoft::WRL::AsyncBase<typename AsyncCompletedHandlerType<T>::Type, typename AsyncProgressHandlerType<T>::Type>, T>
 {
 protected:
     AsyncCommon()
@@ -61,9 +83,21 @@ protected:
     template<typename TFunction>
     void RunOnThreadPool(TFunction&& workerFunction)
     {
-        auto threadPoolDelegate = MakeThreadPoolDelegate(std::move(workerFunction));
+        SetScheduler(nullptr, AsyncWorkOptions());
 
-        StartThreadPoolDelegate(threadPoolDelegate);
+        StartWorkItem(MakeWorkItem(std::move(workerFunction), false));
+    }
+
+
+    // Runs an async operation using the specified scheduler, or the threadpool if that is null.
+    // Unlike RunOnThreadPool, the worker function is skipped if the operation is cancelled
+    // before the scheduler gets around to it.
+    template<typename TFunction>
+    void RunOnScheduler(std::shared_ptr<IAsyncScheduler> const& scheduler, AsyncWorkOptions const& options, TFunction&& workerFunction)
+    {
+        SetScheduler(scheduler, options);
+
+        StartWorkItem(MakeWorkItem(std::move(workerFunction), true));
     }
 
 
@@ -72,10 +106,12 @@ protected:
     template<typename TPrevious, typename TFunction>
     void RunAsContinuation(Microsoft::WRL::ComPtr<TPrevious> const& previousOperation, TFunction&& workerFunction)
     {
-        // We aren't ready to run this yet, but go ahead and create a callback which will 
+        // We aren't ready to run this yet, but go ahead and create a work item which will 
         // later be executed on the threadpool. This captures and hangs onto necessary 
         // state such as workerFunction and a keepalive reference to 'this'.
-        auto threadPoolDelegate = MakeThreadPoolDelegate(std::move(workerFunction));
+        SetScheduler(nullptr, AsyncWorkOptions());
+
+        auto workItem = MakeWorkItem(std::move(workerFunction), false);
 
         // Create a continuation callback to tell us when previousOperation has finished.
         typedef AddFtmBase<AsyncCompletedHandlerType<TPrevious>::Type>::Type CallbackType;
@@ -96,7 +132,7 @@ protected:
                 // If previousOperation succeeded, start our continuation on the threadpool.
                 hr = ExceptionBoundary([&]
                 {
-                    StartThreadPoolDelegate(threadPoolDelegate);
+                    StartWorkItem(workItem);
                 });
             }
             else
@@ -132,20 +168,41 @@ protected:
     }
 
 
+    // Worker functions can check this to stop early once the operation has been cancelled.
+    AsyncCancellationToken const& GetCancellationToken() const
+    {
+        return m_cancellationToken;
+    }
+
+
 private:
-    // Creates a callback delegate which will later execute the specified worker function.
-    template<typename TFunction>
-    Microsoft::WRL::ComPtr<ABI::Windows::System::Threading::IWorkItemHandler> MakeThreadPoolDelegate(TFunction&& workerFunction)
+    std::shared_ptr<IAsyncScheduler> m_scheduler;
+    AsyncWorkOptions m_options;
+    AsyncCancellationToken m_cancellationToken;
+
+
+    void SetScheduler(std::shared_ptr<IAsyncScheduler> const& scheduler, AsyncWorkOptions const& options)
     {
-        using namespace ABI::Windows::Foundation;
-        using namespace ABI::Windows::System::Threading;
+        m_scheduler = scheduler ? scheduler : ThreadPoolAsyncScheduler::GetDefault();
+        m_options = options;
+    }
 
+
+    // Creates a work item which will later execute the specified worker function.
+    template<typename TFunction>
+    std::function<void()> MakeWorkItem(TFunction&& workerFunction, bool skipIfCancelled)
+    {
         ComPtr<AsyncCommon> keepThisAliveUntilTaskCompletion(this);
 
-        typedef AddFtmBase<IWorkItemHandler>::Type CallbackType;
-        
-        auto threadPoolDelegate = Callback<CallbackType>([=](IAsyncAction*)
+        return [=]
         {
+            // Work that was cancelled while still queued need not start at all.
+            if (skipIfCancelled && !ContinueAsyncOperation())
+            {
+                keepThisAliveUntilTaskCompletion->FireCompletion();
+                return;
+            }
+
             // Run the worker function.
             HRESULT hr = ExceptionBoundary([&]
             {
@@ -164,27 +221,14 @@ private:
 
             // Notify listeners that the task is complete.
             keepThisAliveUntilTaskCompletion->FireCompletion();
-
-            return S_OK;
-        });
-
-        CheckMakeResult(threadPoolDelegate);
-
-        return threadPoolDelegate;
+        };
     }
 
 
-    // Starts a task running on the system threadpool.
-    void StartThreadPoolDelegate(Microsoft::WRL::ComPtr<ABI::Windows::System::Threading::IWorkItemHandler> const& threadPoolDelegate)
+    // Hands a work item to the scheduler.
+    void StartWorkItem(std::function<void()> workItem)
     {
-        using namespace ABI::Windows::Foundation;
-        using namespace ABI::Windows::System::Threading;
-
-        ComPtr<IThreadPoolStatics> threadPool;
-        ThrowIfFailed(GetActivationFactory(Wrappers::HStringReference(RuntimeClass_Windows_System_Threading_ThreadPool).Get(), &threadPool));
-
-        ComPtr<IAsyncAction> threadPoolTask;
-        ThrowIfFailed(threadPool->RunAsync(threadPoolDelegate.Get(), &threadPoolTask));
+        m_scheduler->Schedule(m_options, std::move(workItem));
     }
 
 
@@ -196,9 +240,10 @@ protected:
     }
 
 
-    // Cancel notification (unused).
+    // Cancel notification. Lets worker functions that are already running know they can stop.
     virtual void OnCancel()
     {
+        m_cancellationToken.Cancel();
     }
 
 
@@ -232,6 +277,10 @@ class AsyncOperation : public AsyncCommon<ABI::Windows::Foundation::IAsyncOperat
 
 
 public:
+    // Worker functions that take a cancellation token can use it to stop early.
+    typedef std::function<Microsoft::WRL::ComPtr<T>(AsyncCancellationToken const&)> CancellableWorkerFunction;
+
+
     // Runs an async operation on the threadpool.
     AsyncOperation(std::function<Microsoft::WRL::ComPtr<T>()>&& workerFunction)
     {
@@ -242,6 +291,19 @@ public:
     }
 
 
+    // Runs an async operation with the specified priority and queue, on
+    // the specified scheduler, or the threadpool if that is null.
+    AsyncOperation(AsyncWorkOptions const& options, CancellableWorkerFunction&& workerFunction, std::shared_ptr<IAsyncScheduler> const& scheduler = nullptr)
+    {
+        auto cancellationToken = GetCancellationToken();
+
+        RunOnScheduler(scheduler, options, [=]
+        {
+            m_result = workerFunction(cancellationToken);
+        });
+    }
+
+
     // Runs one async operation as a continuation of another. The specified
     // worker function will execute after the previous operation has completed.
     template<typename TPrevious>
@@ -277,6 +339,97 @@ protected:
 };
 
 
+// Implements the WinRT IAsyncOperationWithProgress interface.
+template<typename T, typename TProgress>
+class AsyncOperationWithProgress : public AsyncCommon<ABI::Windows::Foundation::IAsyncOperationWithProgress<T*, TProgress>>
+{
+    InspectableClass(IAsyncOperationWithProgress<T*, TProgress>::z_get_rc_name_impl(), BaseTrust);
+
+    // T_abi is often the same as T*, but if T is a runtime class, T_abi will be the corresponding interface.
+    typedef typename ABI::Windows::Foundation::Internal::GetAbiType<typename AsyncCommon::IAsyncOperationWithProgress::TResult_complex>::type T_abi;
+
+    // Stores the async operation result, once available.
+    Microsoft::WRL::ComPtr<T> m_result;
+
+
+public:
+    // The worker function is passed the async operation, so it can report
+    // progress and check whether it has been cancelled.
+    typedef std::function<Microsoft::WRL::ComPtr<T>(AsyncOperationWithProgress*)> WorkerFunction;
+
+
+    // Runs an async operation on the threadpool.
+    AsyncOperationWithProgress(WorkerFunction&& workerFunction)
+    {
+        RunOnThreadPool([=]
+        {
+            m_result = workerFunction(this);
+        });
+    }
+
+
+    // Runs an async operation with the specified priority and queue, on
+    // the specified scheduler, or the threadpool if that is null.
+    AsyncOperationWithProgress(AsyncWorkOptions const& options, WorkerFunction&& workerFunction, std::shared_ptr<IAsyncScheduler> const& scheduler = nullptr)
+    {
+        RunOnScheduler(scheduler, options, [=]
+        {
+            m_result = workerFunction(this);
+        });
+    }
+
+
+    // Raises the progress event. Worker functions should call this from one thread at a time.
+    void ReportProgress(TProgress progress)
+    {
+        (void)FireProgress(progress);
+    }
+
+
+    // Long running worker functions should check this periodically, and return early once it is set.
+    bool IsCancelled()
+    {
+        return !ContinueAsyncOperation();
+    }
+
+
+    // Sets the progress callback.
+    virtual HRESULT STDMETHODCALLTYPE put_Progress(ABI::Windows::Foundation::IAsyncOperationProgressHandler<T*, TProgress>* handler)
+    {
+        return PutOnProgress(handler);
+    }
+
+
+    // Gets the progress callback.
+    virtual HRESULT STDMETHODCALLTYPE get_Progress(ABI::Windows::Foundation::IAsyncOperationProgressHandler<T*, TProgress>** handler)
+    {
+        return GetOnProgress(handler);
+    }
+
+
+    // Gets the result of the async operation.
+    virtual HRESULT STDMETHODCALLTYPE GetResults(T_abi* results)
+    {
+        HRESULT hr = CheckValidStateForResultsCall();
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return m_result.CopyTo(results);
+    }
+
+
+protected:
+    // Close notification.
+    virtual void OnClose()
+    {
+        m_result = nullptr;
+    }
+};
+
+
 // Implements the WinRT IAsyncAction interface.
 class AsyncAction : public AsyncCommon<ABI::Windows::Foundation::IAsyncAction>
 {
@@ -284,6 +437,10 @@ class AsyncAction : public AsyncCommon<ABI::Windows::Foundation::IAsyncAction>
 
 
 public:
+    // Worker functions that take a cancellation token can use it to stop early.
+    typedef std::function<void(AsyncCancellationToken const&)> CancellableWorkerFunction;
+
+
     // Runs an async action on the threadpool.
     AsyncAction(std::function<void()>&& workerFunction)
     {
@@ -291,6 +448,19 @@ public:
     }
 
 
+    // Runs an async action with the specified priority and queue, on
+    // the specified scheduler, or the threadpool if that is null.
+    AsyncAction(AsyncWorkOptions const& options, CancellableWorkerFunction&& workerFunction, std::shared_ptr<IAsyncScheduler> const& scheduler = nullptr)
+    {
+        auto cancellationToken = GetCancellationToken();
+
+        RunOnScheduler(scheduler, options, [=]
+        {
+            workerFunction(cancellationToken);
+        });
+    }
+
+
     // Gets the result of the async action.
     virtual HRESULT STDMETHODCALLTYPE GetResults()
     {
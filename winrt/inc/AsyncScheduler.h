@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <wrl.h>
+#include <Windows.System.Threading.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "ErrorHandling.h"
+
+
+// How urgently a piece of async work should run, relative to other work.
+enum class AsyncWorkPriority
+{
+    Background,     // Eg. prefetching, or saving that nobody is waiting for.
+    Normal,
+    Interactive,    // The user is waiting on the result.
+};
+
+
+// What a piece of async work mostly spends its time doing. Schedulers may
+// use this to keep work that blocks on I/O apart from CPU bound work; the
+// threadpool scheduler only uses it to pick work item options.
+enum class AsyncWorkQueue
+{
+    Cpu,
+    Io,
+};
+
+
+struct AsyncWorkOptions
+{
+    AsyncWorkOptions(AsyncWorkPriority priority = AsyncWorkPriority::Normal, AsyncWorkQueue queue = AsyncWorkQueue::Cpu)
+        : Priority(priority)
+        , Queue(queue)
+    { }
+
+    AsyncWorkPriority Priority;
+    AsyncWorkQueue Queue;
+};
+
+
+// Decides where and when the worker functions of AsyncOperation and friends run.
+class IAsyncScheduler
+{
+public:
+    virtual ~IAsyncScheduler() { }
+
+    // Queues work to run later. Must not run it before returning.
+    virtual void Schedule(AsyncWorkOptions const& options, std::function<void()>&& work) = 0;
+};
+
+
+// Runs work on the system threadpool. Priorities map onto threadpool work
+// item priorities, and I/O work is marked as time sliced so that the
+// threadpool does not treat a blocked read as a busy CPU. Both kinds of work
+// share the threadpool's one queue, with no extra limit on concurrency.
+class ThreadPoolAsyncScheduler : public IAsyncScheduler
+{
+    static std::shared_ptr<IAsyncScheduler> s_default;
+
+public:
+    // This holds no state, so every async operation can share the same one.
+    static std::shared_ptr<IAsyncScheduler> const& GetDefault()
+    {
+        return s_default;
+    }
+
+    virtual void Schedule(AsyncWorkOptions const& options, std::function<void()>&& work) override
+    {
+        using namespace ABI::Windows::Foundation;
+        using namespace ABI::Windows::System::Threading;
+        using namespace Microsoft::WRL;
+
+        ComPtr<IThreadPoolStatics> threadPool;
+        ThrowIfFailed(GetActivationFactory(Wrappers::HStringReference(RuntimeClass_Windows_System_Threading_ThreadPool).Get(), &threadPool));
+
+        auto workItem = std::move(work);
+
+        typedef Implements<RuntimeClassFlags<ClassicCom>, IWorkItemHandler, FtmBase> CallbackType;
+
+        auto threadPoolDelegate = Callback<CallbackType>([=](IAsyncAction*)
+        {
+            return ExceptionBoundary([&]
+            {
+                workItem();
+            });
+        });
+
+        CheckMakeResult(threadPoolDelegate);
+
+        ComPtr<IAsyncAction> threadPoolTask;
+        ThrowIfFailed(threadPool->RunWithPriorityAndOptionsAsync(
+            threadPoolDelegate.Get(),
+            GetWorkItemPriority(options.Priority),
+            options.Queue == AsyncWorkQueue::Io ? WorkItemOptions_TimeSliced : WorkItemOptions_None,
+            &threadPoolTask));
+    }
+
+private:
+    static ABI::Windows::System::Threading::WorkItemPriority GetWorkItemPriority(AsyncWorkPriority priority)
+    {
+        using namespace ABI::Windows::System::Threading;
+
+        switch (priority)
+        {
+        case AsyncWorkPriority::Background:  return WorkItemPriority_Low;
+        case AsyncWorkPriority::Interactive: return WorkItemPriority_High;
+        default:                             return WorkItemPriority_Normal;
+        }
+    }
+};
+
+__declspec(selectany) std::shared_ptr<IAsyncScheduler> ThreadPoolAsyncScheduler::s_default = std::make_shared<ThreadPoolAsyncScheduler>();
+
+
+// Lets a worker function find out that its async operation has been
+// cancelled, so it can stop early. Copies share the same state.
+class AsyncCancellationToken
+{
+    std::shared_ptr<std::atomic<bool>> m_isCancelled;
+
+public:
+    AsyncCancellationToken()
+        : m_isCancelled(std::make_shared<std::atomic<bool>>(false))
+    { }
+
+    bool IsCancellationRequested() const
+    {
+        return *m_isCancelled;
+    }
+
+    // Long running worker functions can call this between steps. The async
+    // operation has already been marked as cancelled, so the error is not
+    // reported to anyone.
+    void ThrowIfCancellationRequested() const
+    {
+        if (IsCancellationRequested())
+            ThrowHR(HRESULT_FROM_WIN32(ERROR_CANCELLED));
+    }
+
+    void Cancel()
+    {
+        *m_isCancelled = true;
+    }
+};
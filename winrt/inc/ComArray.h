@@ -51,9 +51,32 @@
 // For testing purposes, ComArray is templated on a base class.  This
 // CoTaskMemFree/CoTaskMemAlloc to be replaced with test doubles.
 //
-struct EmptyComArrayBase {};
+// The default base calls AllocationHook, if it is set, before each
+// allocation.  This lets the tests count the arrays that the library itself
+// allocates.
+//
+struct DefaultComArrayBase
+{
+    typedef void (*AllocationHookFn)();
+    static AllocationHookFn AllocationHook;
+
+    static void* CoTaskMemAlloc(size_t bytes)
+    {
+        if (AllocationHook)
+            AllocationHook();
+
+        return ::CoTaskMemAlloc(bytes);
+    }
+
+    static void CoTaskMemFree(void* memory)
+    {
+        ::CoTaskMemFree(memory);
+    }
+};
+
+__declspec(selectany) DefaultComArrayBase::AllocationHookFn DefaultComArrayBase::AllocationHook = nullptr;
 
-template<typename T, typename Base=EmptyComArrayBase>
+template<typename T, typename Base=DefaultComArrayBase>
 class ComArray : public Base
 {
     T* m_data;
@@ -162,7 +185,7 @@ private:
 // Creates a new array where the values are generated by passing each element
 // from the source range through func.
 //
-template<typename T, typename ITERATOR, typename FN, typename Base=EmptyComArrayBase>
+template<typename T, typename ITERATOR, typename FN, typename Base=DefaultComArrayBase>
 inline ComArray<T, Base> TransformToComArray(ITERATOR first, ITERATOR last, FN func)
 {
     auto size = std::distance(first, last);
@@ -0,0 +1,198 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "BatchBitmapLoader.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    BatchBitmapLoader::Scheduler BatchBitmapLoader::GetThreadPoolScheduler()
+    {
+        auto threadPool = ThreadPoolAsyncScheduler::GetDefault();
+
+        return [=](std::function<void()>&& work)
+        {
+            threadPool->Schedule(AsyncWorkOptions(AsyncWorkPriority::Normal, AsyncWorkQueue::Cpu), std::move(work));
+        };
+    }
+
+
+    uint32_t BatchBitmapLoader::GetDefaultDecodeConcurrency()
+    {
+        SYSTEM_INFO systemInfo;
+        GetNativeSystemInfo(&systemInfo);
+
+        return std::max<uint32_t>(systemInfo.dwNumberOfProcessors, 1);
+    }
+
+
+    BatchBitmapLoader::BatchBitmapLoader(uint32_t itemCount, uint32_t maxConcurrentDecodes, Scheduler scheduler)
+        : m_itemCount(itemCount)
+        , m_maxConcurrentDecodes(std::max<uint32_t>(maxConcurrentDecodes, 1))
+        , m_maxDecodeLookahead(m_maxConcurrentDecodes * 2)
+        , m_nextDecodeIndex(0)
+        , m_scheduler(std::move(scheduler))
+        , m_state(std::make_shared<SharedState>())
+    {
+        DecodeSlot emptySlot = { false, S_OK, nullptr };
+
+        m_state->Slots.resize(itemCount, emptySlot);
+        m_state->DecodesInFlight = 0;
+    }
+
+
+    bool BatchBitmapLoader::Run(DecodeFunction const& decode, UploadFunction const& upload, CancelFunction const& isCancelled)
+    {
+        m_state->Decode = decode;
+
+        HRESULT failure = S_OK;
+        bool wasCancelled = false;
+
+        for (uint32_t uploadIndex = 0; uploadIndex < m_itemCount; uploadIndex++)
+        {
+            if (isCancelled())
+            {
+                wasCancelled = true;
+                break;
+            }
+
+            // Wait for the next image in upload order to finish decoding, starting
+            // more decodes whenever there is room for them.
+            ComPtr<IWICFormatConverter> decoded;
+
+            failure = ExceptionBoundary([&]
+            {
+                auto& slot = m_state->Slots[uploadIndex];
+
+                for (;;)
+                {
+                    StartDecodes(uploadIndex);
+
+                    std::unique_lock<std::mutex> lock(m_state->Mutex);
+
+                    m_state->Changed.wait(lock, [&]
+                    {
+                        return slot.IsReady ||
+                              (m_state->DecodesInFlight < m_maxConcurrentDecodes && CanStartDecode(uploadIndex));
+                    });
+
+                    if (slot.IsReady)
+                        break;
+                }
+
+                ThrowIfFailed(slot.Result);
+
+                // Hand over the decoded image, so the slot no longer keeps it alive.
+                decoded.Swap(slot.Decoded);
+            });
+
+            if (FAILED(failure))
+                break;
+
+            failure = ExceptionBoundary([&]
+            {
+                upload(uploadIndex, decoded.Get());
+            });
+
+            if (FAILED(failure))
+                break;
+        }
+
+        // Decodes that are already running may use state owned by the caller,
+        // so we must not return until they have finished.
+        WaitForOutstandingDecodes();
+
+        m_state->Decode = nullptr;
+
+        ThrowIfFailed(failure);
+
+        return !wasCancelled;
+    }
+
+
+    bool BatchBitmapLoader::CanStartDecode(uint32_t uploadIndex) const
+    {
+        return m_nextDecodeIndex < m_itemCount &&
+               m_nextDecodeIndex < uploadIndex + m_maxDecodeLookahead;
+    }
+
+
+    void BatchBitmapLoader::StartDecodes(uint32_t uploadIndex)
+    {
+        while (CanStartDecode(uploadIndex))
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_state->Mutex);
+
+                if (m_state->DecodesInFlight >= m_maxConcurrentDecodes)
+                    return;
+
+                m_state->DecodesInFlight++;
+            }
+
+            auto index = m_nextDecodeIndex++;
+            auto state = m_state;
+
+            // The scheduler is not called with the lock held, as it is allowed
+            // to run the work item synchronously.
+            auto hr = ExceptionBoundary([&]
+            {
+                m_scheduler([=]
+                {
+                    ComPtr<IWICFormatConverter> decoded;
+
+                    HRESULT decodeResult = ExceptionBoundary([&]
+                    {
+                        decoded = state->Decode(index);
+                    });
+
+                    std::lock_guard<std::mutex> lock(state->Mutex);
+
+                    auto& slot = state->Slots[index];
+
+                    slot.IsReady = true;
+                    slot.Result = decodeResult;
+                    slot.Decoded = decoded;
+
+                    state->DecodesInFlight--;
+                    state->Changed.notify_all();
+                });
+            });
+
+            if (FAILED(hr))
+            {
+                // The work item never ran, so record its failure in place of a result.
+                std::lock_guard<std::mutex> lock(m_state->Mutex);
+
+                auto& slot = m_state->Slots[index];
+
+                slot.IsReady = true;
+                slot.Result = hr;
+
+                m_state->DecodesInFlight--;
+
+                return;
+            }
+        }
+    }
+
+
+    void BatchBitmapLoader::WaitForOutstandingDecodes()
+    {
+        std::unique_lock<std::mutex> lock(m_state->Mutex);
+
+        m_state->Changed.wait(lock, [&]
+        {
+            return m_state->DecodesInFlight == 0;
+        });
+    }
+}}}}
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    //
+    // Drives the two stages of loading a batch of bitmaps.
+    //
+    // Decoding is CPU bound and independent for each image, so runs on the
+    // threadpool, with at most maxConcurrentDecodes images in flight at a time.
+    // Uploading goes through the device's shared resource creation context, so
+    // instead of having every worker contend for it, all uploads happen one at a
+    // time, in order, on the thread that called Run.
+    //
+    // Decoding is allowed to run a limited distance ahead of uploading, which
+    // bounds how many decoded images are held in memory at once.
+    //
+    class BatchBitmapLoader
+    {
+    public:
+        typedef std::function<void(std::function<void()>&&)> Scheduler;
+        typedef std::function<ComPtr<IWICFormatConverter>(uint32_t index)> DecodeFunction;
+        typedef std::function<void(uint32_t index, IWICFormatConverter* decoded)> UploadFunction;
+        typedef std::function<bool()> CancelFunction;
+
+        // Runs work items on the system threadpool.
+        static Scheduler GetThreadPoolScheduler();
+
+        // Picks a decode concurrency based on the number of processors.
+        static uint32_t GetDefaultDecodeConcurrency();
+
+        BatchBitmapLoader(uint32_t itemCount, uint32_t maxConcurrentDecodes, Scheduler scheduler);
+
+        // Decodes and uploads every item. Returns false if isCancelled reported
+        // true before everything was uploaded. If any decode or upload fails,
+        // outstanding decodes are allowed to finish and then the error is thrown.
+        bool Run(DecodeFunction const& decode, UploadFunction const& upload, CancelFunction const& isCancelled);
+
+    private:
+        struct DecodeSlot
+        {
+            bool IsReady;
+            HRESULT Result;
+            ComPtr<IWICFormatConverter> Decoded;
+        };
+
+        struct SharedState
+        {
+            std::mutex Mutex;
+            std::condition_variable Changed;
+            std::vector<DecodeSlot> Slots;
+            uint32_t DecodesInFlight;
+            DecodeFunction Decode;
+        };
+
+        bool CanStartDecode(uint32_t uploadIndex) const;
+        void StartDecodes(uint32_t uploadIndex);
+        void WaitForOutstandingDecodes();
+
+        uint32_t m_itemCount;
+        uint32_t m_maxConcurrentDecodes;
+        uint32_t m_maxDecodeLookahead;
+        uint32_t m_nextDecodeIndex;
+        Scheduler m_scheduler;
+
+        // Shared with the decode work items, which can outlive a Run call that throws.
+        std::shared_ptr<SharedState> m_state;
+    };
+}}}}
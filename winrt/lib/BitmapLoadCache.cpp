@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "BitmapLoadCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    static uint64_t GetPixelBytes(ICanvasBitmap* bitmap)
+    {
+        BitmapSize size;
+        ThrowIfFailed(bitmap->get_SizeInPixels(&size));
+
+        return static_cast<uint64_t>(size.Width) * size.Height * 4;
+    }
+
+
+    bool BitmapLoadCache::Key::operator<(Key const& other) const
+    {
+        return KeyComparison()
+            (Device, other.Device)
+            (Alpha, other.Alpha)
+            (Dpi, other.Dpi)
+            (Source, other.Source)
+            .IsLess();
+    }
+
+
+    BitmapLoadCache::BitmapLoadCache()
+        : m_retainedBytesBudget(0)
+    {
+        CanvasBitmapCacheStatistics emptyStatistics = {};
+        m_statistics = emptyStatistics;
+    }
+
+
+    ComPtr<ICanvasBitmap> BitmapLoadCache::GetOrLoad(
+        ICanvasDevice* device,
+        HSTRING source,
+        CanvasAlphaMode alpha,
+        float dpi,
+        LoadFunction const& load)
+    {
+        ComPtr<IUnknown> deviceIdentity;
+        ThrowIfFailed(device->QueryInterface(IID_PPV_ARGS(&deviceIdentity)));
+
+        // Live cache entries keep their device alive, so the identity pointer
+        // cannot be reused by a different device while it is in the map.
+        Key key = { deviceIdentity.Get(), WindowsGetStringRawBuffer(source, nullptr), alpha, dpi };
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        auto it = m_entries.find(key);
+
+        if (it != m_entries.end())
+        {
+            auto& entry = it->second;
+
+            if (entry.Pending)
+            {
+                // Someone else is already loading this, so wait for their result.
+                auto pending = entry.Pending;
+
+                m_statistics.CoalescedLoads++;
+
+                m_loadCompleted.wait(lock, [&] { return pending->IsComplete; });
+
+                ThrowIfFailed(pending->Result);
+
+                return pending->Bitmap;
+            }
+
+            auto bitmap = TryGetCachedBitmap(entry);
+
+            if (bitmap)
+            {
+                m_statistics.Hits++;
+                Retain(key, entry, bitmap);
+                return bitmap;
+            }
+        }
+
+        // Not in the cache, so we must load it ourselves.
+        m_statistics.Misses++;
+
+        auto pending = std::make_shared<PendingLoad>();
+        pending->IsComplete = false;
+        pending->Result = S_OK;
+
+        m_entries[key].Pending = pending;
+
+        lock.unlock();
+
+        ComPtr<ICanvasBitmap> bitmap;
+
+        HRESULT hr = ExceptionBoundary([&]
+        {
+            bitmap = load();
+
+            // Retaining needs the size, so look it up before taking the lock.
+            (void)GetPixelBytes(bitmap.Get());
+        });
+
+        lock.lock();
+
+        pending->IsComplete = true;
+        pending->Result = hr;
+        pending->Bitmap = bitmap;
+
+        auto& entry = m_entries[key];
+        entry.Pending.reset();
+
+        if (SUCCEEDED(hr))
+        {
+            hr = AsWeak(bitmap.Get(), &entry.Bitmap);
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = ExceptionBoundary([&]
+            {
+                Retain(key, entry, bitmap);
+                PruneDeadEntries();
+            });
+        }
+        else
+        {
+            // Failures are not cached, so the next request will try again.
+            Unretain(entry);
+            m_entries.erase(key);
+        }
+
+        m_loadCompleted.notify_all();
+
+        lock.unlock();
+
+        ThrowIfFailed(hr);
+
+        return bitmap;
+    }
+
+
+    uint64_t BitmapLoadCache::GetRetainedBytesBudget()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_retainedBytesBudget;
+    }
+
+
+    void BitmapLoadCache::SetRetainedBytesBudget(uint64_t budget)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_retainedBytesBudget = budget;
+
+        TrimRetained();
+    }
+
+
+    void BitmapLoadCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto& entry : m_entries)
+        {
+            entry.second.IsRetained = false;
+        }
+
+        m_retained.clear();
+        m_statistics.RetainedBytes = 0;
+        m_statistics.RetainedBitmaps = 0;
+
+        PruneDeadEntries();
+    }
+
+
+    CanvasBitmapCacheStatistics BitmapLoadCache::GetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_statistics;
+    }
+
+
+    ComPtr<ICanvasBitmap> BitmapLoadCache::TryGetCachedBitmap(Entry& entry)
+    {
+        ComPtr<ICanvasBitmap> bitmap;
+
+        if (FAILED(entry.Bitmap.As(&bitmap)) || !bitmap)
+            return nullptr;
+
+        // A bitmap that the app has closed can no longer be shared.
+        BitmapSize size;
+
+        if (FAILED(bitmap->get_SizeInPixels(&size)))
+        {
+            Unretain(entry);
+            return nullptr;
+        }
+
+        return bitmap;
+    }
+
+
+    void BitmapLoadCache::Retain(Key const& key, Entry& entry, ComPtr<ICanvasBitmap> const& bitmap)
+    {
+        if (m_retainedBytesBudget == 0)
+            return;
+
+        if (entry.IsRetained)
+        {
+            // Move to the front of the most recently used list.
+            m_retained.splice(m_retained.begin(), m_retained, entry.RetainedPosition);
+            return;
+        }
+
+        auto bytes = GetPixelBytes(bitmap.Get());
+
+        if (bytes > m_retainedBytesBudget)
+            return;
+
+        RetainedBitmap retained = { key, bitmap, bytes };
+        m_retained.push_front(retained);
+
+        entry.IsRetained = true;
+        entry.RetainedPosition = m_retained.begin();
+
+        m_statistics.RetainedBytes += bytes;
+        m_statistics.RetainedBitmaps++;
+
+        TrimRetained();
+    }
+
+
+    void BitmapLoadCache::Unretain(Entry& entry)
+    {
+        if (!entry.IsRetained)
+            return;
+
+        m_statistics.RetainedBytes -= entry.RetainedPosition->Bytes;
+        m_statistics.RetainedBitmaps--;
+
+        m_retained.erase(entry.RetainedPosition);
+        entry.IsRetained = false;
+    }
+
+
+    void BitmapLoadCache::TrimRetained()
+    {
+        while (m_statistics.RetainedBytes > m_retainedBytesBudget)
+        {
+            auto it = m_entries.find(m_retained.back().CacheKey);
+            assert(it != m_entries.end());
+
+            Unretain(it->second);
+        }
+    }
+
+
+    void BitmapLoadCache::PruneDeadEntries()
+    {
+        m_pruner.Prune(
+            m_entries,
+            [](Entry& entry)
+            {
+                if (entry.Pending || entry.IsRetained)
+                    return false;
+
+                ComPtr<ICanvasBitmap> bitmap;
+                return FAILED(entry.Bitmap.As(&bitmap)) || !bitmap;
+            });
+    }
+}}}}
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+
+#include "WeakValueCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+    using namespace ::Microsoft::WRL::Wrappers;
+
+    //
+    // Shares bitmaps loaded from the same source, so that loading an image
+    // which is already in memory does not decode and upload it again.  This
+    // is the implementation behind the CanvasBitmapCache runtime class.
+    //
+    // Entries are keyed by device, source, alpha mode and DPI, so each device
+    // effectively has its own cache. While a load is in progress, other
+    // requests for the same key wait for it rather than starting their own.
+    //
+    // Bitmaps are held by weak reference, so by default they stay cached only
+    // as long as the app keeps them alive. Setting a retained bytes budget
+    // additionally keeps the most recently used bitmaps alive, up to that many
+    // bytes of pixel data.
+    //
+    class BitmapLoadCache
+    {
+    public:
+        typedef std::function<ComPtr<ICanvasBitmap>()> LoadFunction;
+
+        BitmapLoadCache();
+
+        ComPtr<ICanvasBitmap> GetOrLoad(
+            ICanvasDevice* device,
+            HSTRING source,
+            CanvasAlphaMode alpha,
+            float dpi,
+            LoadFunction const& load);
+
+        uint64_t GetRetainedBytesBudget();
+        void SetRetainedBytesBudget(uint64_t budget);
+
+        // Releases all retained bitmaps. Loads that are in progress are unaffected.
+        void Clear();
+
+        CanvasBitmapCacheStatistics GetStatistics();
+
+    private:
+        struct Key
+        {
+            IUnknown* Device;
+            std::wstring Source;
+            CanvasAlphaMode Alpha;
+            float Dpi;
+
+            bool operator<(Key const& other) const;
+        };
+
+        struct PendingLoad
+        {
+            bool IsComplete;
+            HRESULT Result;
+            ComPtr<ICanvasBitmap> Bitmap;
+        };
+
+        struct RetainedBitmap
+        {
+            Key CacheKey;
+            ComPtr<ICanvasBitmap> Bitmap;
+            uint64_t Bytes;
+        };
+
+        typedef std::list<RetainedBitmap> RetainedList;
+
+        struct Entry
+        {
+            Entry()
+                : IsRetained(false)
+            { }
+
+            WeakRef Bitmap;
+            std::shared_ptr<PendingLoad> Pending;
+            bool IsRetained;
+            RetainedList::iterator RetainedPosition;
+        };
+
+        typedef std::map<Key, Entry> EntryMap;
+
+        ComPtr<ICanvasBitmap> TryGetCachedBitmap(Entry& entry);
+        void Retain(Key const& key, Entry& entry, ComPtr<ICanvasBitmap> const& bitmap);
+        void Unretain(Entry& entry);
+        void TrimRetained();
+        void PruneDeadEntries();
+
+        std::mutex m_mutex;
+        std::condition_variable m_loadCompleted;
+
+        EntryMap m_entries;
+        AmortizedPruner m_pruner;
+
+        // Most recently used first.
+        RetainedList m_retained;
+        uint64_t m_retainedBytesBudget;
+
+        CanvasBitmapCacheStatistics m_statistics;
+    };
+}}}}
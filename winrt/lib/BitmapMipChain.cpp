@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "BitmapMipChain.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    std::vector<D2D1_SIZE_U> BitmapMipChain::GetLevelSizes(D2D1_SIZE_U baseSize)
+    {
+        std::vector<D2D1_SIZE_U> sizes;
+
+        if (baseSize.width == 0 || baseSize.height == 0)
+            return sizes;
+
+        auto size = baseSize;
+
+        while (size.width > 1 || size.height > 1)
+        {
+            size.width = std::max(size.width / 2, 1u);
+            size.height = std::max(size.height / 2, 1u);
+
+            sizes.push_back(size);
+        }
+
+        return sizes;
+    }
+
+
+    uint64_t BitmapMipChain::GetMemoryOverhead(D2D1_SIZE_U baseSize, uint32_t bytesPerPixel)
+    {
+        uint64_t total = 0;
+
+        for (auto& size : GetLevelSizes(baseSize))
+        {
+            total += static_cast<uint64_t>(size.width) * size.height * bytesPerPixel;
+        }
+
+        return total;
+    }
+
+
+    bool BitmapMipChain::IsFormatSupported(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+
+    bool BitmapMipChain::IsSrgbFormat(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+
+    static float GetAxisScale(float m1, float m2)
+    {
+        return sqrtf(m1 * m1 + m2 * m2);
+    }
+
+
+    float BitmapMipChain::GetDrawScale(
+        D2D1_MATRIX_3X2_F const& transform,
+        float targetDpi,
+        D2D1_RECT_F const& destRect,
+        D2D1_RECT_F const& sourceRect,
+        float bitmapDpi)
+    {
+        float sourceWidth = fabs(sourceRect.right - sourceRect.left) * bitmapDpi / DEFAULT_DPI;
+        float sourceHeight = fabs(sourceRect.bottom - sourceRect.top) * bitmapDpi / DEFAULT_DPI;
+
+        if (sourceWidth <= 0 || sourceHeight <= 0)
+            return 1;
+
+        float targetScale = targetDpi / DEFAULT_DPI;
+
+        float destWidth = fabs(destRect.right - destRect.left) * GetAxisScale(transform._11, transform._12) * targetScale;
+        float destHeight = fabs(destRect.bottom - destRect.top) * GetAxisScale(transform._21, transform._22) * targetScale;
+
+        return std::max(destWidth / sourceWidth, destHeight / sourceHeight);
+    }
+
+
+    uint32_t BitmapMipChain::SelectLevel(float drawScale, uint32_t levelCount)
+    {
+        uint32_t level = 0;
+
+        // Each level halves the size, so keep going while the next one
+        // would still cover every target pixel.
+        while (level < levelCount && drawScale <= 0.5f)
+        {
+            drawScale *= 2;
+            level++;
+        }
+
+        return level;
+    }
+
+
+    static float SrgbToLinear(BYTE value)
+    {
+        float c = value / 255.0f;
+
+        return (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+
+    static BYTE LinearToSrgb(float value)
+    {
+        float c = (value <= 0.0031308f) ? value * 12.92f : 1.055f * powf(value, 1 / 2.4f) - 0.055f;
+
+        return static_cast<BYTE>(std::min(std::max(c, 0.0f), 1.0f) * 255 + 0.5f);
+    }
+
+
+    void BitmapMipChain::Downsample(
+        BYTE const* source,
+        D2D1_SIZE_U sourceSize,
+        uint32_t sourceStride,
+        BYTE* dest,
+        D2D1_SIZE_U destSize,
+        uint32_t destStride,
+        bool isSrgb)
+    {
+        const uint32_t bytesPerPixel = 4;
+        const uint32_t alphaChannel = 3;
+
+        // Every source byte is decoded, so look the conversions up rather than
+        // calling powf for each one.
+        float toLinear[256];
+
+        if (isSrgb)
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                toLinear[i] = SrgbToLinear(static_cast<BYTE>(i));
+            }
+        }
+
+        for (uint32_t y = 0; y < destSize.height; y++)
+        {
+            // Images with an odd size, or a size of one, reuse their last row or column.
+            auto row0 = source + std::min(y * 2, sourceSize.height - 1) * sourceStride;
+            auto row1 = source + std::min(y * 2 + 1, sourceSize.height - 1) * sourceStride;
+
+            auto destRow = dest + y * destStride;
+
+            for (uint32_t x = 0; x < destSize.width; x++)
+            {
+                auto x0 = std::min(x * 2, sourceSize.width - 1) * bytesPerPixel;
+                auto x1 = std::min(x * 2 + 1, sourceSize.width - 1) * bytesPerPixel;
+
+                for (uint32_t channel = 0; channel < bytesPerPixel; channel++)
+                {
+                    BYTE a = row0[x0 + channel];
+                    BYTE b = row0[x1 + channel];
+                    BYTE c = row1[x0 + channel];
+                    BYTE d = row1[x1 + channel];
+
+                    BYTE result;
+
+                    if (isSrgb && channel != alphaChannel)
+                    {
+                        result = LinearToSrgb((toLinear[a] + toLinear[b] + toLinear[c] + toLinear[d]) / 4);
+                    }
+                    else
+                    {
+                        result = static_cast<BYTE>((a + b + c + d + 2) / 4);
+                    }
+
+                    destRow[x * bytesPerPixel + channel] = result;
+                }
+            }
+        }
+    }
+}}}}
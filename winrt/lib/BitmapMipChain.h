@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // The CPU side of bitmap mip chains: how big each level is, how much
+    // memory they take, which level to draw at a given scale, and the box
+    // filter used to make each level from the one before it.
+    //
+    // Level 0 is the original bitmap. Each level after that is half the
+    // size of the previous one (rounding down, but never below one pixel)
+    // until the chain reaches 1x1.
+    //
+    class BitmapMipChain
+    {
+    public:
+        // Sizes of the levels after level 0.
+        static std::vector<D2D1_SIZE_U> GetLevelSizes(D2D1_SIZE_U baseSize);
+
+        // Bytes used by the levels after level 0.
+        static uint64_t GetMemoryOverhead(D2D1_SIZE_U baseSize, uint32_t bytesPerPixel);
+
+        // Only formats with four 8 bit channels can be filtered.
+        static bool IsFormatSupported(DXGI_FORMAT format);
+
+        //
+        // How many target pixels each source pixel covers when sourceRect
+        // (in bitmap DIPs) is drawn into destRect (in target DIPs) under the
+        // given transform. Uses the larger of the horizontal and vertical
+        // scales, so that picking a level based on this never blurs the
+        // image more than necessary.
+        //
+        static float GetDrawScale(
+            D2D1_MATRIX_3X2_F const& transform,
+            float targetDpi,
+            D2D1_RECT_F const& destRect,
+            D2D1_RECT_F const& sourceRect,
+            float bitmapDpi);
+
+        // Picks the smallest level that still has at least one pixel per
+        // target pixel. Returns 0 when drawing at or above full size.
+        static uint32_t SelectLevel(float drawScale, uint32_t levelCount);
+
+        // True for the _SRGB formats, whose color channels are gamma encoded.
+        static bool IsSrgbFormat(DXGI_FORMAT format);
+
+        //
+        // Averages each 2x2 block of source pixels into one destination pixel.
+        //
+        // When isSrgb is set, the first three channels are converted to linear
+        // light before averaging and back afterwards. Alpha, and every channel
+        // of the other formats, is averaged as stored. D2D treats the non-sRGB
+        // formats as already being in the space it blends in, so those are
+        // filtered the same way D2D itself would filter them.
+        //
+        static void Downsample(
+            BYTE const* source,
+            D2D1_SIZE_U sourceSize,
+            uint32_t sourceStride,
+            BYTE* dest,
+            D2D1_SIZE_U destSize,
+            uint32_t destStride,
+            bool isSrgb);
+    };
+}}}}
@@ -0,0 +1,304 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "BlockCompression.h"
+#include "TextureUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    static const uint32_t PixelsPerBlock = BlockCompressedBlockSize * BlockCompressedBlockSize;
+
+    // The pixels of one block in row major order, as B, G, R, A.
+    typedef BYTE BlockPixels[PixelsPerBlock][4];
+
+
+    bool BlockCompression::IsFormatSupported(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC2_UNORM:
+        case DXGI_FORMAT_BC3_UNORM:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+
+    static void WriteLittleEndian(BYTE* dest, uint64_t value, uint32_t byteCount)
+    {
+        for (uint32_t i = 0; i < byteCount; i++)
+        {
+            dest[i] = static_cast<BYTE>(value >> (i * 8));
+        }
+    }
+
+
+    static uint16_t PackColor565(uint32_t const (&rgb)[3])
+    {
+        uint32_t r = (rgb[0] * 31 + 127) / 255;
+        uint32_t g = (rgb[1] * 63 + 127) / 255;
+        uint32_t b = (rgb[2] * 31 + 127) / 255;
+
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+
+    static void UnpackColor565(uint16_t color, uint32_t (&rgb)[3])
+    {
+        uint32_t r = (color >> 11) & 31;
+        uint32_t g = (color >> 5) & 63;
+        uint32_t b = color & 31;
+
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+
+    static uint32_t GetDistanceSquared(BYTE const (&pixel)[4], uint32_t const (&rgb)[3])
+    {
+        int dr = static_cast<int>(pixel[2]) - static_cast<int>(rgb[0]);
+        int dg = static_cast<int>(pixel[1]) - static_cast<int>(rgb[1]);
+        int db = static_cast<int>(pixel[0]) - static_cast<int>(rgb[2]);
+
+        return static_cast<uint32_t>(dr * dr + dg * dg + db * db);
+    }
+
+
+    //
+    // Writes the 8 byte color half of a block. When allowTransparency is set
+    // (BC1 only), pixels that are less than half opaque are encoded with
+    // BC1's three color mode, in which index 3 is transparent black.
+    //
+    static void EncodeColorBlock(BlockPixels const& pixels, bool allowTransparency, BYTE* dest)
+    {
+        uint32_t minColor[3] = { 255, 255, 255 };
+        uint32_t maxColor[3] = { 0, 0, 0 };
+
+        bool isTransparent[PixelsPerBlock];
+        bool anyTransparent = false;
+        bool anyOpaque = false;
+
+        for (uint32_t i = 0; i < PixelsPerBlock; i++)
+        {
+            isTransparent[i] = allowTransparency && pixels[i][3] < 128;
+
+            if (isTransparent[i])
+            {
+                anyTransparent = true;
+                continue;
+            }
+
+            anyOpaque = true;
+
+            uint32_t rgb[3] = { pixels[i][2], pixels[i][1], pixels[i][0] };
+
+            for (uint32_t channel = 0; channel < 3; channel++)
+            {
+                minColor[channel] = std::min(minColor[channel], rgb[channel]);
+                maxColor[channel] = std::max(maxColor[channel], rgb[channel]);
+            }
+        }
+
+        uint16_t color0 = anyOpaque ? PackColor565(maxColor) : 0;
+        uint16_t color1 = anyOpaque ? PackColor565(minColor) : 0;
+
+        // The order of the endpoints selects the mode: color0 > color1 for
+        // four colors, and color0 <= color1 for three colors plus transparent.
+        if (anyTransparent ? (color0 > color1) : (color0 < color1))
+            std::swap(color0, color1);
+
+        uint32_t palette[4][3];
+        UnpackColor565(color0, palette[0]);
+        UnpackColor565(color1, palette[1]);
+
+        uint32_t paletteSize;
+
+        if (anyTransparent)
+        {
+            for (uint32_t channel = 0; channel < 3; channel++)
+            {
+                palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2;
+            }
+
+            paletteSize = 3;
+        }
+        else
+        {
+            for (uint32_t channel = 0; channel < 3; channel++)
+            {
+                palette[2][channel] = (palette[0][channel] * 2 + palette[1][channel]) / 3;
+                palette[3][channel] = (palette[0][channel] + palette[1][channel] * 2) / 3;
+            }
+
+            paletteSize = 4;
+        }
+
+        uint32_t indices = 0;
+
+        for (uint32_t i = 0; i < PixelsPerBlock; i++)
+        {
+            uint32_t bestIndex = 3;
+
+            if (!isTransparent[i])
+            {
+                uint32_t bestDistance = UINT_MAX;
+
+                for (uint32_t index = 0; index < paletteSize; index++)
+                {
+                    auto distance = GetDistanceSquared(pixels[i], palette[index]);
+
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = index;
+                    }
+                }
+            }
+
+            indices |= bestIndex << (i * 2);
+        }
+
+        WriteLittleEndian(dest, color0, 2);
+        WriteLittleEndian(dest + 2, color1, 2);
+        WriteLittleEndian(dest + 4, indices, 4);
+    }
+
+
+    // BC2 stores alpha as 4 bits per pixel.
+    static void EncodeExplicitAlphaBlock(BlockPixels const& pixels, BYTE* dest)
+    {
+        uint64_t alphas = 0;
+
+        for (uint32_t i = 0; i < PixelsPerBlock; i++)
+        {
+            uint64_t alpha = (pixels[i][3] * 15u + 127) / 255;
+
+            alphas |= alpha << (i * 4);
+        }
+
+        WriteLittleEndian(dest, alphas, 8);
+    }
+
+
+    // BC3 stores two alpha endpoints, and a 3 bit index per pixel into the
+    // eight values interpolated between them.
+    static void EncodeInterpolatedAlphaBlock(BlockPixels const& pixels, BYTE* dest)
+    {
+        uint32_t alpha0 = 0;
+        uint32_t alpha1 = 255;
+
+        for (uint32_t i = 0; i < PixelsPerBlock; i++)
+        {
+            alpha0 = std::max<uint32_t>(alpha0, pixels[i][3]);
+            alpha1 = std::min<uint32_t>(alpha1, pixels[i][3]);
+        }
+
+        uint64_t indices = 0;
+
+        // When the endpoints are the same every index is 0, which decodes as alpha0.
+        if (alpha0 > alpha1)
+        {
+            uint32_t palette[8] = { alpha0, alpha1 };
+
+            for (uint32_t index = 2; index < 8; index++)
+            {
+                palette[index] = ((8 - index) * alpha0 + (index - 1) * alpha1 + 3) / 7;
+            }
+
+            for (uint32_t i = 0; i < PixelsPerBlock; i++)
+            {
+                uint64_t bestIndex = 0;
+                uint32_t bestDistance = UINT_MAX;
+
+                for (uint32_t index = 0; index < 8; index++)
+                {
+                    auto distance = static_cast<uint32_t>(abs(static_cast<int>(pixels[i][3]) - static_cast<int>(palette[index])));
+
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = index;
+                    }
+                }
+
+                indices |= bestIndex << (i * 3);
+            }
+        }
+
+        dest[0] = static_cast<BYTE>(alpha0);
+        dest[1] = static_cast<BYTE>(alpha1);
+        WriteLittleEndian(dest + 2, indices, 6);
+    }
+
+
+    std::vector<BYTE> BlockCompression::Encode(
+        DXGI_FORMAT format,
+        BYTE const* pixels,
+        D2D1_SIZE_U size,
+        uint32_t stride)
+    {
+        if (!IsFormatSupported(format))
+            ThrowHR(E_INVALIDARG);
+
+        if (size.width % BlockCompressedBlockSize != 0 || size.height % BlockCompressedBlockSize != 0)
+            ThrowHR(E_INVALIDARG);
+
+        const uint32_t bytesPerPixel = 4;
+        const uint32_t bytesPerBlock = GetBytesPerBlock(format);
+        const uint32_t blocksWide = size.width / BlockCompressedBlockSize;
+        const uint32_t blocksHigh = size.height / BlockCompressedBlockSize;
+
+        std::vector<BYTE> blocks(static_cast<size_t>(blocksWide) * blocksHigh * bytesPerBlock);
+
+        BlockPixels blockPixels;
+
+        for (uint32_t blockY = 0; blockY < blocksHigh; blockY++)
+        {
+            for (uint32_t blockX = 0; blockX < blocksWide; blockX++)
+            {
+                for (uint32_t y = 0; y < BlockCompressedBlockSize; y++)
+                {
+                    auto sourceRow = pixels + (blockY * BlockCompressedBlockSize + y) * stride + blockX * BlockCompressedBlockSize * bytesPerPixel;
+
+                    memcpy(blockPixels[y * BlockCompressedBlockSize], sourceRow, BlockCompressedBlockSize * bytesPerPixel);
+                }
+
+                auto dest = &blocks[(static_cast<size_t>(blockY) * blocksWide + blockX) * bytesPerBlock];
+
+                switch (format)
+                {
+                case DXGI_FORMAT_BC1_UNORM:
+                    EncodeColorBlock(blockPixels, true, dest);
+                    break;
+
+                case DXGI_FORMAT_BC2_UNORM:
+                    EncodeExplicitAlphaBlock(blockPixels, dest);
+                    EncodeColorBlock(blockPixels, false, dest + 8);
+                    break;
+
+                case DXGI_FORMAT_BC3_UNORM:
+                    EncodeInterpolatedAlphaBlock(blockPixels, dest);
+                    EncodeColorBlock(blockPixels, false, dest + 8);
+                    break;
+                }
+            }
+        }
+
+        return blocks;
+    }
+}}}}
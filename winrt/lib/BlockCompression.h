@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // A simple CPU encoder for the block compressed formats that D2D can
+    // draw: BC1, BC2 and BC3.
+    //
+    // Each 4x4 block picks its two color endpoints from the bounding box of
+    // its colors, and every pixel takes whichever palette entry is nearest.
+    // This is fast rather than optimal; content that needs the best quality
+    // should be compressed offline and loaded from a DDS file instead.
+    //
+    class BlockCompression
+    {
+    public:
+        // The block compressed formats that D2D can draw, which are also
+        // the ones this can encode.
+        static bool IsFormatSupported(DXGI_FORMAT format);
+
+        //
+        // Encodes premultiplied 32bpp BGRA pixels. The width and height
+        // must be multiples of 4, since that is all D2D accepts for block
+        // compressed bitmaps. The result is laid out as rows of blocks, with
+        // no padding between them.
+        //
+        static std::vector<BYTE> Encode(
+            DXGI_FORMAT format,
+            BYTE const* pixels,
+            D2D1_SIZE_U size,
+            uint32_t stride);
+    };
+}}}}
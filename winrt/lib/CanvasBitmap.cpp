@@ -12,16 +12,22 @@
 
 #include "pch.h"
 
+#include "BatchBitmapLoader.h"
+#include "BlockCompression.h"
 #include "CanvasBitmap.h"
 #include "CanvasDevice.h"
 #include "CanvasDrawingSession.h"
 #include "CanvasRenderTarget.h"
+#include "DrawingStatistics.h"
+#include "Tracing.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ABI::Windows::Storage::Streams;
     using namespace ABI::Windows::Storage;
+    using namespace ABI::Windows::Foundation::Collections;
     using namespace ::Microsoft::WRL::Wrappers;
+    using namespace ::collections;
 
     //
     // CanvasBitmapManager
@@ -29,6 +35,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     CanvasBitmapManager::CanvasBitmapManager(std::shared_ptr<ICanvasBitmapResourceCreationAdapter> adapter)
         : m_adapter(adapter)
+        , m_pixelBufferPool(std::make_shared<PixelBufferPool>())
     {
     }
 
@@ -39,31 +46,159 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         CanvasAlphaMode alpha,
         float dpi)
     {
-        ComPtr<ICanvasDeviceInternal> canvasDeviceInternal;
-        ThrowIfFailed(canvasDevice->QueryInterface(canvasDeviceInternal.GetAddressOf()));
+        TRACE_SPAN(BitmapLoad);
 
-        auto d2dBitmap = canvasDeviceInternal->CreateBitmapFromWicResource(m_adapter->CreateWICFormatConverter(fileName).Get(), alpha, dpi);
+        BlockCompressedImage image;
+        if (m_adapter->TryReadBlockCompressedImage(fileName, &image))
+            return CreateNew(canvasDevice, image, alpha, dpi);
 
-        auto bitmap = Make<CanvasBitmap>(
-            shared_from_this(),
-            d2dBitmap.Get(),
-            canvasDevice);
-        CheckMakeResult(bitmap);
-        
-        return bitmap;
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileName).Get(), alpha, dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        IStream* fileStream,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        TRACE_SPAN(BitmapLoad);
+
+        BlockCompressedImage image;
+        if (m_adapter->TryReadBlockCompressedImage(fileStream, &image))
+            return CreateNew(canvasDevice, image, alpha, dpi);
+
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileStream).Get(), alpha, dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        HSTRING fileName,
+        DirectXPixelFormat compressedFormat,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        TRACE_SPAN(BitmapLoad);
+
+        BlockCompressedImage image;
+        if (m_adapter->TryReadBlockCompressedImage(fileName, &image) && image.Format == static_cast<DXGI_FORMAT>(compressedFormat))
+            return CreateNew(canvasDevice, image, alpha, dpi);
+
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileName).Get(), compressedFormat, alpha, dpi);
     }
 
 
     ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
         ICanvasDevice* canvasDevice,
         IStream* fileStream,
+        DirectXPixelFormat compressedFormat,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        TRACE_SPAN(BitmapLoad);
+
+        // Unlike the file name overload, this does not look for a DDS file
+        // first: if the blocks turned out to be in the wrong format, the
+        // stream would have to be read a second time.
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileStream).Get(), compressedFormat, alpha, dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        IWICFormatConverter* wicFormatConverter,
+        DirectXPixelFormat compressedFormat,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        TRACE_SPAN(BitmapDecode);
+
+        auto format = static_cast<DXGI_FORMAT>(compressedFormat);
+
+        if (!BlockCompression::IsFormatSupported(format))
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedFormatRestriction).Get());
+
+        BitmapSize size;
+        ThrowIfFailed(wicFormatConverter->GetSize(&size.Width, &size.Height));
+
+        if (size.Width % BlockCompressedBlockSize != 0 || size.Height % BlockCompressedBlockSize != 0)
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedSizeRestriction).Get());
+
+        const uint32_t stride = size.Width * 4;
+
+        std::vector<BYTE> pixels(static_cast<size_t>(stride) * size.Height);
+        ThrowIfFailed(wicFormatConverter->CopyPixels(nullptr, stride, static_cast<UINT>(pixels.size()), pixels.data()));
+
+        BlockCompressedImage image;
+        image.Format = format;
+        image.Size = D2D1::SizeU(size.Width, size.Height);
+        image.Blocks = BlockCompression::Encode(format, pixels.data(), image.Size, stride);
+
+        return CreateNew(canvasDevice, image, alpha, dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        BlockCompressedImage& image,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        assert(image.Blocks.size() <= UINT_MAX);
+
+        return CreateNew(
+            canvasDevice,
+            static_cast<uint32_t>(image.Blocks.size()),
+            image.Blocks.empty() ? nullptr : image.Blocks.data(),
+            static_cast<int32_t>(image.Size.width),
+            static_cast<int32_t>(image.Size.height),
+            static_cast<DirectXPixelFormat>(image.Format),
+            alpha,
+            dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        HSTRING fileName,
+        BitmapSize maxSize,
+        CanvasImageInterpolation interpolation,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        TRACE_SPAN(BitmapLoad);
+
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileName, maxSize, interpolation).Get(), alpha, dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        IStream* fileStream,
+        BitmapSize maxSize,
+        CanvasImageInterpolation interpolation,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        TRACE_SPAN(BitmapLoad);
+
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileStream, maxSize, interpolation).Get(), alpha, dpi);
+    }
+
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        IWICFormatConverter* wicFormatConverter,
         CanvasAlphaMode alpha,
         float dpi)
     {
+        TRACE_SPAN(BitmapDecode);
+
         ComPtr<ICanvasDeviceInternal> canvasDeviceInternal;
         ThrowIfFailed(canvasDevice->QueryInterface(canvasDeviceInternal.GetAddressOf()));
 
-        auto d2dBitmap = canvasDeviceInternal->CreateBitmapFromWicResource(m_adapter->CreateWICFormatConverter(fileStream).Get(), alpha, dpi);
+        auto d2dBitmap = canvasDeviceInternal->CreateBitmapFromWicResource(wicFormatConverter, alpha, dpi);
 
         auto bitmap = Make<CanvasBitmap>(
             shared_from_this(),
@@ -93,11 +228,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         bitmapProperties.dpiX = dpi;
         bitmapProperties.dpiY = dpi;
 
+        // D2D only accepts block compressed bitmaps made of whole blocks, but
+        // fails with nothing more helpful than E_INVALIDARG.
+        if (IsBlockCompressedFormat(bitmapProperties.pixelFormat.format))
+        {
+            if (widthInPixels % BlockCompressedBlockSize != 0 || heightInPixels % BlockCompressedBlockSize != 0)
+                ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedSizeRestriction).Get());
+        }
+
         // D2D does not fail attempts to create zero-sized bitmaps. Neither does this.
         uint32_t pitch = 0;
         if (heightInPixels > 0)
         {
-            pitch = byteCount / static_cast<uint32_t>(heightInPixels);
+            // For block compressed formats, each row is a row of blocks.
+            pitch = byteCount / GetRowCount(bitmapProperties.pixelFormat.format, static_cast<uint32_t>(heightInPixels));
         }
         else
         {
@@ -171,6 +315,30 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return m_adapter.get();
     }
 
+
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateCached(
+        BitmapLoadCache& cache,
+        ICanvasDevice* canvasDevice,
+        HSTRING fileName,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        auto bitmap = cache.GetOrLoad(canvasDevice, fileName, alpha, dpi,
+            [&]
+            {
+                return As<ICanvasBitmap>(Create(canvasDevice, fileName, alpha, dpi));
+            });
+
+        // The cache only ever holds bitmaps created by this manager.
+        return static_cast<CanvasBitmap*>(bitmap.Get());
+    }
+
+
+    std::shared_ptr<PixelBufferPool> const& CanvasBitmapManager::GetPixelBufferPool()
+    {
+        return m_pixelBufferPool;
+    }
+
     class DefaultCanvasBitmapAdapter : public ICanvasBitmapAdapter
     {
         ComPtr<IRandomAccessStreamReferenceStatics> m_randomAccessStreamReferenceStatics;
@@ -559,6 +727,278 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    IFACEMETHODIMP CanvasBitmapFactory::LoadAsyncFromHstringWithMaxSize(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        BitmapSize maxSize,
+        CanvasImageInterpolation interpolation,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return LoadAsyncFromHstringWithMaxSizeAlphaAndDpi(
+            resourceCreator,
+            fileName,
+            maxSize,
+            interpolation,
+            CanvasAlphaMode::Premultiplied,
+            DEFAULT_DPI,
+            canvasBitmapAsyncOperation);
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadAsyncFromHstringWithMaxSizeAlphaAndDpi(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        BitmapSize maxSize,
+        CanvasImageInterpolation interpolation,
+        CanvasAlphaMode alpha,
+        float dpi,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(fileName);
+                CheckAndClearOutPointer(canvasBitmapAsyncOperation);
+
+                if (maxSize.Width == 0 || maxSize.Height == 0)
+                    ThrowHR(E_INVALIDARG);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                WinString fileName(fileName);
+
+                // Scaled loads are not shared through the bitmap cache, which
+                // only holds bitmaps at their full size.
+                auto asyncOperation = Make<AsyncOperation<CanvasBitmap>>(
+                    [=]
+                    {
+                        return GetManager()->CreateBitmap(canvasDevice.Get(), static_cast<HSTRING>(fileName), maxSize, interpolation, alpha, dpi);
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapAsyncOperation));
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadAsyncFromStreamWithMaxSize(
+        ICanvasResourceCreator* resourceCreator,
+        IRandomAccessStream* stream,
+        BitmapSize maxSize,
+        CanvasImageInterpolation interpolation,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return LoadAsyncFromStreamWithMaxSizeAlphaAndDpi(
+            resourceCreator,
+            stream,
+            maxSize,
+            interpolation,
+            CanvasAlphaMode::Premultiplied,
+            DEFAULT_DPI,
+            canvasBitmapAsyncOperation);
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadAsyncFromStreamWithMaxSizeAlphaAndDpi(
+        ICanvasResourceCreator* resourceCreator,
+        IRandomAccessStream* rawStream,
+        BitmapSize maxSize,
+        CanvasImageInterpolation interpolation,
+        CanvasAlphaMode alpha,
+        float dpi,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(rawStream);
+                CheckAndClearOutPointer(canvasBitmapAsyncOperation);
+
+                if (maxSize.Width == 0 || maxSize.Height == 0)
+                    ThrowHR(E_INVALIDARG);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                ComPtr<IRandomAccessStream> stream = rawStream;
+
+                auto asyncOperation = Make<AsyncOperation<CanvasBitmap>>(
+                [=]
+                {
+                    ComPtr<IStream> nativeStream;
+                    ThrowIfFailed(CreateStreamOverRandomAccessStream(stream.Get(), IID_PPV_ARGS(&nativeStream)));
+
+                    return GetManager()->CreateBitmap(canvasDevice.Get(), nativeStream.Get(), maxSize, interpolation, alpha, dpi);
+                });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapAsyncOperation));
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadAsyncFromHstringWithCompressedFormat(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        DirectXPixelFormat compressedFormat,
+        CanvasAlphaMode alpha,
+        float dpi,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(fileName);
+                CheckAndClearOutPointer(canvasBitmapAsyncOperation);
+
+                if (!BlockCompression::IsFormatSupported(static_cast<DXGI_FORMAT>(compressedFormat)))
+                    ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedFormatRestriction).Get());
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                WinString fileName(fileName);
+
+                // Compressed loads are not shared through the bitmap cache,
+                // which only holds bitmaps in the format they were decoded to.
+                auto asyncOperation = Make<AsyncOperation<CanvasBitmap>>(
+                    [=]
+                    {
+                        return GetManager()->CreateBitmap(canvasDevice.Get(), static_cast<HSTRING>(fileName), compressedFormat, alpha, dpi);
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapAsyncOperation));
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadAsyncFromStreamWithCompressedFormat(
+        ICanvasResourceCreator* resourceCreator,
+        IRandomAccessStream* rawStream,
+        DirectXPixelFormat compressedFormat,
+        CanvasAlphaMode alpha,
+        float dpi,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(rawStream);
+                CheckAndClearOutPointer(canvasBitmapAsyncOperation);
+
+                if (!BlockCompression::IsFormatSupported(static_cast<DXGI_FORMAT>(compressedFormat)))
+                    ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedFormatRestriction).Get());
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                ComPtr<IRandomAccessStream> stream = rawStream;
+
+                auto asyncOperation = Make<AsyncOperation<CanvasBitmap>>(
+                [=]
+                {
+                    ComPtr<IStream> nativeStream;
+                    ThrowIfFailed(CreateStreamOverRandomAccessStream(stream.Get(), IID_PPV_ARGS(&nativeStream)));
+
+                    return GetManager()->CreateBitmap(canvasDevice.Get(), nativeStream.Get(), compressedFormat, alpha, dpi);
+                });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapAsyncOperation));
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadManyAsync(
+        ICanvasResourceCreator* resourceCreator,
+        uint32_t fileNameCount,
+        HSTRING* fileNames,
+        IAsyncOperationWithProgress<IVectorView<CanvasBitmap*>*, uint32_t>** canvasBitmapsAsyncOperation)
+    {
+        return LoadManyAsyncWithAlphaAndDpi(
+            resourceCreator,
+            fileNameCount,
+            fileNames,
+            CanvasAlphaMode::Premultiplied,
+            DEFAULT_DPI,
+            canvasBitmapsAsyncOperation);
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadManyAsyncWithAlphaAndDpi(
+        ICanvasResourceCreator* resourceCreator,
+        uint32_t fileNameCount,
+        HSTRING* fileNames,
+        CanvasAlphaMode alpha,
+        float dpi,
+        IAsyncOperationWithProgress<IVectorView<CanvasBitmap*>*, uint32_t>** canvasBitmapsAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                if (fileNameCount > 0)
+                    CheckInPointer(fileNames);
+                CheckAndClearOutPointer(canvasBitmapsAsyncOperation);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                std::vector<WinString> fileNameStrings;
+
+                for (uint32_t i = 0; i < fileNameCount; i++)
+                {
+                    CheckInPointer(fileNames[i]);
+                    fileNameStrings.push_back(WinString(fileNames[i]));
+                }
+
+                typedef AsyncOperationWithProgress<IVectorView<CanvasBitmap*>, uint32_t> LoadManyOperation;
+
+                auto asyncOperation = Make<LoadManyOperation>(
+                    [=](LoadManyOperation* operation) -> ComPtr<IVectorView<CanvasBitmap*>>
+                    {
+                        auto adapter = GetManager()->GetBitmapAdapter();
+
+                        auto bitmaps = Make<Vector<CanvasBitmap*>>();
+                        CheckMakeResult(bitmaps);
+
+                        BatchBitmapLoader loader(
+                            fileNameCount,
+                            BatchBitmapLoader::GetDefaultDecodeConcurrency(),
+                            BatchBitmapLoader::GetThreadPoolScheduler());
+
+                        // Decodes run on the threadpool, while the bitmaps are created
+                        // on this thread, in the same order as the file names.
+                        bool finished = loader.Run(
+                            [&](uint32_t index)
+                            {
+                                return adapter->CreateDecodedWICFormatConverter(fileNameStrings[index]);
+                            },
+                            [&](uint32_t index, IWICFormatConverter* decoded)
+                            {
+                                auto bitmap = GetManager()->CreateBitmap(canvasDevice.Get(), decoded, alpha, dpi);
+                                bitmaps->InternalVector().push_back(As<ICanvasBitmap>(bitmap));
+
+                                operation->ReportProgress(index + 1);
+                            },
+                            [&]
+                            {
+                                return operation->IsCancelled();
+                            });
+
+                        // A cancelled operation has no results.
+                        if (!finished)
+                            return nullptr;
+
+                        ComPtr<IVectorView<CanvasBitmap*>> view;
+                        ThrowIfFailed(bitmaps->GetView(&view));
+                        return view;
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapsAsyncOperation));
+            });
+    }
+
     //
     // ICanvasFactoryNative
     //
@@ -614,6 +1054,22 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         }
     }
 
+    static void VerifyBlockAlignedSubrectangle(D2D1_RECT_U subRectangle, DXGI_FORMAT format)
+    {
+        if (!IsBlockCompressedFormat(format))
+            return;
+
+        // Block compressed bitmaps are always a whole number of blocks, so
+        // aligned edges never cut a block in half.
+        if (subRectangle.left % BlockCompressedBlockSize != 0 ||
+            subRectangle.top % BlockCompressedBlockSize != 0 ||
+            subRectangle.right % BlockCompressedBlockSize != 0 ||
+            subRectangle.bottom % BlockCompressedBlockSize != 0)
+        {
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedSubrectangleRestriction).Get());
+        }
+    }
+
     void GetPixelBytesImpl(
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
@@ -625,26 +1081,27 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         VerifyWellFormedSubrectangle(subRectangle, d2dBitmap->GetPixelSize());
 
+        const DXGI_FORMAT format = d2dBitmap->GetPixelFormat().format;
+        VerifyBlockAlignedSubrectangle(subRectangle, format);
+
         ScopedBitmapLock bitmapLock(d2dBitmap.Get(), D3D11_MAP_READ, &subRectangle);
 
-        const unsigned int bytesPerPixel = GetBytesPerPixel(d2dBitmap->GetPixelFormat().format);
-        const unsigned int bytesPerRow = (subRectangle.right - subRectangle.left) * bytesPerPixel;
-        const unsigned int destSizeInBytes =
-            bytesPerRow * (subRectangle.bottom - subRectangle.top);
+        // For block compressed formats, these are rows of blocks.
+        const unsigned int bytesPerRow = GetBytesPerRow(format, subRectangle.right - subRectangle.left);
+        const unsigned int rowCount = GetRowCount(format, subRectangle.bottom - subRectangle.top);
+        const unsigned int destSizeInBytes = bytesPerRow * rowCount;
 
         ComArray<BYTE> array(destSizeInBytes);
 
         byte* destRowStart = array.GetData();
         byte* sourceRowStart = static_cast<byte*>(bitmapLock.GetLockedData());
-        for (unsigned int y = subRectangle.top; y < subRectangle.bottom; y++)
+        for (unsigned int row = 0; row < rowCount; row++)
         {
-            const unsigned int byteCount = (subRectangle.right - subRectangle.left) * bytesPerPixel;
-
             assert(destRowStart - array.GetData() < UINT_MAX);
             const unsigned int positionInBuffer = static_cast<unsigned int>(destRowStart - array.GetData());
             const unsigned int bytesLeftInBuffer = destSizeInBytes - positionInBuffer;
 
-            memcpy_s(destRowStart, bytesLeftInBuffer, sourceRowStart, byteCount);
+            memcpy_s(destRowStart, bytesLeftInBuffer, sourceRowStart, bytesPerRow);
 
             destRowStart += bytesPerRow;
             sourceRowStart += bitmapLock.GetStride();
@@ -695,33 +1152,71 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         array.Detach(valueCount, valueElements);
     }
 
+    //
+    // Copies the bitmap's pixels into a buffer from the pool, so that the
+    // staging texture can be released straight away rather than being kept
+    // mapped until the encoder has finished with it.
+    //
+    // This runs on the caller's thread, so it never waits for earlier saves
+    // to finish; the pool allocates a new buffer if all of its are in use.
+    //
+    static std::shared_ptr<PixelBuffer> CopyBitmapToPixelBuffer(
+        ComPtr<ID2D1Bitmap1> const& d2dBitmap,
+        PixelBufferPool* pixelBufferPool)
+    {
+        if (IsBlockCompressedFormat(d2dBitmap->GetPixelFormat().format))
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::BlockCompressedSaveRestriction).Get());
+
+        const D2D1_SIZE_U size = d2dBitmap->GetPixelSize();
+
+        // TODO: #2767 Support saving formats other than 32bppBGRA.
+        const unsigned int bytesPerRow = size.width * 4;
+
+        auto pixels = pixelBufferPool->Acquire(size.width, size.height, bytesPerRow);
+
+        ScopedBitmapLock bitmapLock(d2dBitmap.Get(), D3D11_MAP_READ);
+
+        auto source = static_cast<byte*>(bitmapLock.GetLockedData());
+        auto destination = pixels->GetData();
+
+        for (unsigned int y = 0; y < size.height; y++)
+        {
+            memcpy(destination, source, bytesPerRow);
+            source += bitmapLock.GetStride();
+            destination += bytesPerRow;
+        }
+
+        return pixels;
+    }
+
     void SaveBitmapToFileImpl(
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
+        PixelBufferPool* pixelBufferPool,
         HSTRING rawfileName,
         CanvasBitmapFileFormat fileFormat,
         float quality,
         IAsyncAction **resultAsyncAction)
     {
         WinString fileName(rawfileName);
-        const D2D1_SIZE_U size = d2dBitmap->GetPixelSize();
         float dpiX, dpiY;
         d2dBitmap->GetDpi(&dpiX, &dpiY);
 
-        auto bitmapLock = std::make_shared<ScopedBitmapLock>(d2dBitmap.Get(), D3D11_MAP_READ);
+        auto pixels = CopyBitmapToPixelBuffer(d2dBitmap, pixelBufferPool);
 
+        // Encoding is CPU bound, and the app is waiting for the save to
+        // complete, so it runs at normal priority on the CPU queue.
         auto asyncAction = Make<AsyncAction>(
-            [=]
+            AsyncWorkOptions(AsyncWorkPriority::Normal, AsyncWorkQueue::Cpu),
+            [=](AsyncCancellationToken const&)
             {
-                adapter->SaveLockedMemoryToFile(
+                adapter->SavePixelBufferToFile(
                     fileName,
                     fileFormat,
                     quality,
-                    size.width,
-                    size.height,
                     dpiX,
                     dpiY,
-                    bitmapLock.get());
+                    pixels.get());
             });
 
         CheckMakeResult(asyncAction);
@@ -731,6 +1226,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     void SaveBitmapToStreamImpl(
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
+        PixelBufferPool* pixelBufferPool,
         IRandomAccessStream* stream,
         CanvasBitmapFileFormat fileFormat,
         float quality,
@@ -741,24 +1237,26 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ThrowHR(E_INVALIDARG, HStringReference(Strings::AutoFileFormatNotAllowed).Get());
         }
 
-        const D2D1_SIZE_U size = d2dBitmap->GetPixelSize();
         float dpiX, dpiY;
         d2dBitmap->GetDpi(&dpiX, &dpiY);
 
-        auto bitmapLock = std::make_shared<ScopedBitmapLock>(d2dBitmap.Get(), D3D11_MAP_READ);
+        auto pixels = CopyBitmapToPixelBuffer(d2dBitmap, pixelBufferPool);
+
+        ComPtr<IRandomAccessStream> streamReference = stream;
 
+        // Encoding is CPU bound, and the app is waiting for the save to
+        // complete, so it runs at normal priority on the CPU queue.
         auto asyncAction = Make<AsyncAction>(
-            [=]
+            AsyncWorkOptions(AsyncWorkPriority::Normal, AsyncWorkQueue::Cpu),
+            [=](AsyncCancellationToken const&)
             {
-                adapter->SaveLockedMemoryToStream(
-                    stream,
+                adapter->SavePixelBufferToStream(
+                    streamReference.Get(),
                     fileFormat,
                     quality,
-                    size.width,
-                    size.height,
                     dpiX,
                     dpiY,
-                    bitmapLock.get());
+                    pixels.get());
             });
 
         CheckMakeResult(asyncAction);
@@ -775,12 +1273,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         VerifyWellFormedSubrectangle(subRectangle, d2dBitmap->GetPixelSize());
 
+        const DXGI_FORMAT format = d2dBitmap->GetPixelFormat().format;
+        VerifyBlockAlignedSubrectangle(subRectangle, format);
+
         const unsigned int subRectangleWidth = subRectangle.right - subRectangle.left;
         const unsigned int subRectangleHeight = subRectangle.bottom - subRectangle.top;
 
-        const unsigned int bytesPerPixel = GetBytesPerPixel(d2dBitmap->GetPixelFormat().format);
-        const unsigned int bytesPerRow = bytesPerPixel * subRectangleWidth;
-        uint32_t expectedArraySize = subRectangleWidth * subRectangleHeight * bytesPerPixel;
+        // For block compressed formats, these are rows of blocks.
+        const unsigned int bytesPerRow = GetBytesPerRow(format, subRectangleWidth);
+        const unsigned int rowCount = GetRowCount(format, subRectangleHeight);
+        uint32_t expectedArraySize = bytesPerRow * rowCount;
         if (valueCount != expectedArraySize)
         {
             WinStringBuilder message;
@@ -793,17 +1295,21 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         byte* destRowStart = static_cast<byte*>(bitmapLock.GetLockedData());
         byte* sourceRowStart = valueElements;
 
-        for (unsigned int y = subRectangle.top; y < subRectangle.bottom; y++)
+        for (unsigned int row = 0; row < rowCount; row++)
         {
-            const unsigned int byteCount = (subRectangle.right - subRectangle.left) * bytesPerPixel;
             const unsigned int positionInBuffer = static_cast<unsigned int>(sourceRowStart - valueElements);
             const unsigned int bytesLeftInBuffer = valueCount - positionInBuffer;
 
-            memcpy_s(destRowStart, bytesLeftInBuffer, sourceRowStart, byteCount);
+            memcpy_s(destRowStart, bytesLeftInBuffer, sourceRowStart, bytesPerRow);
 
             destRowStart += bitmapLock.GetStride();
             sourceRowStart += bytesPerRow;
         }
+
+        if (auto statistics = DrawingStatistics::GetCurrent())
+            statistics->AddPixelBytesUploaded(valueCount);
+
+        TRACE_COUNTER(BitmapUpload, valueCount);
     }
 
     void SetPixelColorsImpl(
@@ -853,9 +1359,81 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             }
             destRowStart += bitmapLock.GetStride();
         }
+
+        if (auto statistics = DrawingStatistics::GetCurrent())
+            statistics->AddPixelBytesUploaded(static_cast<uint64_t>(valueCount) * 4);
+
+        TRACE_COUNTER(BitmapUpload, static_cast<uint64_t>(valueCount) * 4);
     }
 
 
+    std::vector<ComPtr<ID2D1Bitmap1>> CreateMipLevelsImpl(
+        ComPtr<ID2D1Bitmap1> const& d2dBitmap,
+        ICanvasDevice* device)
+    {
+        CheckInPointer(device);
+
+        auto pixelFormat = d2dBitmap->GetPixelFormat();
+
+        if (!BitmapMipChain::IsFormatSupported(pixelFormat.format))
+            ThrowHR(E_INVALIDARG, HStringReference(Strings::MipLevelsFormatRestriction).Get());
+
+        auto baseSize = d2dBitmap->GetPixelSize();
+        bool isSrgb = BitmapMipChain::IsSrgbFormat(pixelFormat.format);
+
+        float dpiX, dpiY;
+        d2dBitmap->GetDpi(&dpiX, &dpiY);
+
+        // Take a CPU copy of the full size image. Each level is then
+        // filtered from the one before it, so this is only read once.
+        auto previousSize = baseSize;
+        uint32_t previousStride = baseSize.width * 4;
+        std::vector<BYTE> previousPixels(previousStride * baseSize.height);
+
+        if (!previousPixels.empty())
+        {
+            ScopedBitmapLock bitmapLock(d2dBitmap.Get(), D3D11_MAP_READ);
+
+            auto source = static_cast<BYTE const*>(bitmapLock.GetLockedData());
+
+            for (uint32_t y = 0; y < baseSize.height; y++)
+            {
+                memcpy(&previousPixels[y * previousStride], source + y * bitmapLock.GetStride(), previousStride);
+            }
+        }
+
+        auto deviceContext = As<ICanvasDeviceInternal>(device)->CreateDeviceContext();
+
+        std::vector<ComPtr<ID2D1Bitmap1>> levels;
+
+        for (auto& levelSize : BitmapMipChain::GetLevelSizes(baseSize))
+        {
+            uint32_t stride = levelSize.width * 4;
+            std::vector<BYTE> pixels(stride * levelSize.height);
+
+            BitmapMipChain::Downsample(previousPixels.data(), previousSize, previousStride, pixels.data(), levelSize, stride, isSrgb);
+
+            // Scaling the DPI along with the pixel size keeps every level
+            // the same size in DIPs.
+            auto bitmapProperties = D2D1::BitmapProperties1(
+                D2D1_BITMAP_OPTIONS_NONE,
+                pixelFormat,
+                dpiX * levelSize.width / baseSize.width,
+                dpiY * levelSize.height / baseSize.height);
+
+            ComPtr<ID2D1Bitmap1> level;
+            ThrowIfFailed(deviceContext->CreateBitmap(levelSize, pixels.data(), stride, &bitmapProperties, &level));
+
+            levels.push_back(level);
+
+            previousPixels.swap(pixels);
+            previousSize = levelSize;
+            previousStride = stride;
+        }
+
+        return levels;
+    }
+
     HRESULT CopyPixelsFromBitmapImpl(
         ICanvasBitmap* to,
         ICanvasBitmap* from,
@@ -900,6 +1478,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     useDestPt? &destPoint : nullptr,
                     fromD2dBitmap.Get(),
                     useSourceRect? &sourceRect : nullptr));
+
+                // Mip levels would no longer match the copied pixels.
+                toBitmapInternal->SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
             });
 
     }
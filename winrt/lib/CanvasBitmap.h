@@ -12,7 +12,10 @@
 
 #pragma once
 
+#include "BitmapMipChain.h"
+#include "BitmapLoadCache.h"
 #include "CanvasImage.h"
+#include "PixelBufferPool.h"
 #include "PolymorphicBitmapmanager.h"
 #include "TextureUtilities.h"
 
@@ -29,31 +32,50 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     class CanvasBitmapManager;
 
+    // Blocks read straight out of a DDS file, so they can be uploaded
+    // without being decompressed first.
+    struct BlockCompressedImage
+    {
+        DXGI_FORMAT Format;
+        D2D1_SIZE_U Size;
+        std::vector<BYTE> Blocks;
+    };
+
     class ICanvasBitmapResourceCreationAdapter
     {
     public:
+        // If the file is a DDS file holding blocks in a format that D2D can
+        // draw, reads them as they are and returns true. Otherwise returns
+        // false and leaves the file to be loaded by CreateWICFormatConverter.
+        virtual bool TryReadBlockCompressedImage(HSTRING fileName, BlockCompressedImage* image) = 0;
+        virtual bool TryReadBlockCompressedImage(IStream* fileStream, BlockCompressedImage* image) = 0;
+
         virtual ComPtr<IWICFormatConverter> CreateWICFormatConverter(HSTRING fileName) = 0;
         virtual ComPtr<IWICFormatConverter> CreateWICFormatConverter(IStream* fileStream) = 0;
 
-        virtual void SaveLockedMemoryToFile(
+        // These scale the image down, if necessary, so it fits within maxSize.
+        virtual ComPtr<IWICFormatConverter> CreateWICFormatConverter(HSTRING fileName, BitmapSize maxSize, CanvasImageInterpolation interpolation) = 0;
+        virtual ComPtr<IWICFormatConverter> CreateWICFormatConverter(IStream* fileStream, BitmapSize maxSize, CanvasImageInterpolation interpolation) = 0;
+
+        // Unlike CreateWICFormatConverter, which decodes lazily when the pixels are
+        // first read, this decodes the whole image before returning.
+        virtual ComPtr<IWICFormatConverter> CreateDecodedWICFormatConverter(HSTRING fileName) = 0;
+
+        virtual void SavePixelBufferToFile(
             HSTRING fileName,
             CanvasBitmapFileFormat fileFormat,
             float quality,
-            unsigned int width,
-            unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapLock* bitmapLock) = 0;
+            PixelBuffer* pixels) = 0;
 
-        virtual void SaveLockedMemoryToStream(
+        virtual void SavePixelBufferToStream(
             IRandomAccessStream* stream,
             CanvasBitmapFileFormat fileFormat,
             float quality,
-            unsigned int width,
-            unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapLock* bitmapLock) = 0;
+            PixelBuffer* pixels) = 0;
     };
     
 
@@ -62,6 +84,18 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     {
     public:
         virtual ComPtr<ID2D1Bitmap1> const& GetD2DBitmap() = 0;
+
+        // Picks which mip level to draw, based on how much smaller than its
+        // full size the bitmap will appear on the target. Returns the bitmap
+        // itself if it has no mip levels, without querying deviceContext.
+        virtual ComPtr<ID2D1Bitmap1> GetD2DBitmapForDrawing(
+            ID2D1DeviceContext* deviceContext,
+            D2D1_RECT_F const& destRect,
+            D2D1_RECT_F const* sourceRect) = 0;
+
+        // Replaces the levels after level 0. Each must have the same size in
+        // DIPs as the bitmap itself, so the same source rectangle works for all.
+        virtual void SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>> levels) = 0;
     };
 
     class ICanvasBitmapAdapter
@@ -201,6 +235,68 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float dpi,
             ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
 
+        IFACEMETHOD(LoadAsyncFromHstringWithMaxSize)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            BitmapSize maxSize,
+            CanvasImageInterpolation interpolation,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromHstringWithMaxSizeAlphaAndDpi)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            BitmapSize maxSize,
+            CanvasImageInterpolation interpolation,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromStreamWithMaxSize)(
+            ICanvasResourceCreator* resourceCreator,
+            IRandomAccessStream* stream,
+            BitmapSize maxSize,
+            CanvasImageInterpolation interpolation,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromStreamWithMaxSizeAlphaAndDpi)(
+            ICanvasResourceCreator* resourceCreator,
+            IRandomAccessStream* stream,
+            BitmapSize maxSize,
+            CanvasImageInterpolation interpolation,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromHstringWithCompressedFormat)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            DirectXPixelFormat compressedFormat,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromStreamWithCompressedFormat)(
+            ICanvasResourceCreator* resourceCreator,
+            IRandomAccessStream* stream,
+            DirectXPixelFormat compressedFormat,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadManyAsync)(
+            ICanvasResourceCreator* resourceCreator,
+            uint32_t fileNameCount,
+            HSTRING* fileNames,
+            ABI::Windows::Foundation::IAsyncOperationWithProgress<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>*, uint32_t>** canvasBitmapsAsyncOperation) override;
+
+        IFACEMETHOD(LoadManyAsyncWithAlphaAndDpi)(
+            ICanvasResourceCreator* resourceCreator,
+            uint32_t fileNameCount,
+            HSTRING* fileNames,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperationWithProgress<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>*, uint32_t>** canvasBitmapsAsyncOperation) override;
+
         //
         // ICanvasDeviceResourceFactoryNative
         //
@@ -226,6 +322,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     void SaveBitmapToFileImpl(
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
+        PixelBufferPool* pixelBufferPool,
         HSTRING rawfileName,
         CanvasBitmapFileFormat fileFormat,
         float quality,
@@ -234,6 +331,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     void SaveBitmapToStreamImpl(
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
+        PixelBufferPool* pixelBufferPool,
         IRandomAccessStream* stream,
         CanvasBitmapFileFormat fileFormat,
         float quality,
@@ -251,6 +349,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         uint32_t valueCount,
         Color *valueElements);
 
+    // Builds mip levels for a bitmap by repeatedly box filtering a CPU copy of it.
+    std::vector<ComPtr<ID2D1Bitmap1>> CreateMipLevelsImpl(
+        ComPtr<ID2D1Bitmap1> const& d2dBitmap,
+        ICanvasDevice* device);
+
     HRESULT CopyPixelsFromBitmapImpl(
         ICanvasBitmap* to,
         ICanvasBitmap* from,
@@ -286,6 +389,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     {
         float m_dpi;
 
+        std::mutex m_mipLevelsMutex;
+        std::vector<ComPtr<ID2D1Bitmap1>> m_mipLevels;
+
     protected:
         ComPtr<ICanvasDevice> m_device;
 
@@ -301,6 +407,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     public:
         IFACEMETHODIMP Close() override
         {
+            SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
             m_device.Reset();
             return ResourceWrapper::Close();
         }
@@ -450,6 +557,45 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             return GetResource();
         }
 
+        virtual ComPtr<ID2D1Bitmap1> GetD2DBitmapForDrawing(
+            ID2D1DeviceContext* deviceContext,
+            D2D1_RECT_F const& destRect,
+            D2D1_RECT_F const* sourceRect) override
+        {
+            auto& d2dBitmap = GetResource();
+
+            std::lock_guard<std::mutex> lock(m_mipLevelsMutex);
+
+            if (m_mipLevels.empty())
+                return d2dBitmap;
+
+            D2D1_RECT_F wholeBitmap;
+
+            if (!sourceRect)
+            {
+                auto size = d2dBitmap->GetSize();
+                wholeBitmap = D2D1::RectF(0, 0, size.width, size.height);
+                sourceRect = &wholeBitmap;
+            }
+
+            D2D1_MATRIX_3X2_F transform;
+            deviceContext->GetTransform(&transform);
+
+            float targetDpiX, targetDpiY;
+            deviceContext->GetDpi(&targetDpiX, &targetDpiY);
+
+            auto drawScale = BitmapMipChain::GetDrawScale(transform, targetDpiX, destRect, *sourceRect, m_dpi);
+            auto level = BitmapMipChain::SelectLevel(drawScale, static_cast<uint32_t>(m_mipLevels.size()));
+
+            return (level == 0) ? d2dBitmap : m_mipLevels[level - 1];
+        }
+
+        virtual void SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>> levels) override
+        {
+            std::lock_guard<std::mutex> lock(m_mipLevelsMutex);
+            m_mipLevels.swap(levels);
+        }
+
         // IDirect3DDxgiInterfaceAccess
         IFACEMETHODIMP GetInterface(REFIID iid, void** p)
         {
@@ -503,6 +649,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     SaveBitmapToFileImpl(
                         d2dBitmap.Get(), 
                         Manager()->GetAdapter(),
+                        Manager()->GetPixelBufferPool().get(),
                         rawfileName, 
                         fileFormat,
                         quality,
@@ -539,6 +686,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     SaveBitmapToStreamImpl(
                         d2dBitmap.Get(), 
                         Manager()->GetAdapter(),
+                        Manager()->GetPixelBufferPool().get(),
                         stream,
                         fileFormat,
                         quality,
@@ -636,6 +784,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                         GetResourceBitmapExtents(d2dBitmap),
                         valueCount, 
                         valueElements);
+
+                    // Mip levels would no longer match the new pixels.
+                    SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
                 });
         }
 
@@ -657,6 +808,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                         ToD2DRectU(left, top, width, height),
                         valueCount, 
                         valueElements);
+
+                    // Mip levels would no longer match the new pixels.
+                    SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
                 });
         }
 
@@ -674,6 +828,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                         GetResourceBitmapExtents(d2dBitmap),
                         valueCount, 
                         valueElements);
+
+                    // Mip levels would no longer match the new pixels.
+                    SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
                 });
         }
 
@@ -695,6 +852,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                         ToD2DRectU(left, top, width, height),
                         valueCount, 
                         valueElements);
+
+                    // Mip levels would no longer match the new pixels.
+                    SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
                 });
         }
 
@@ -753,6 +913,52 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 &sourceRectHeight);
         }
 
+        IFACEMETHODIMP GenerateMipLevels() override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    auto& d2dBitmap = GetResource();
+
+                    SetMipLevels(CreateMipLevelsImpl(d2dBitmap, m_device.Get()));
+                });
+        }
+
+        IFACEMETHODIMP get_MipLevelCount(int32_t* value) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    CheckInPointer(value);
+                    GetResource();
+
+                    std::lock_guard<std::mutex> lock(m_mipLevelsMutex);
+                    *value = static_cast<int32_t>(m_mipLevels.size() + 1);
+                });
+        }
+
+        IFACEMETHODIMP get_MipLevelsSizeInBytes(uint64_t* value) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    CheckInPointer(value);
+                    GetResource();
+
+                    std::lock_guard<std::mutex> lock(m_mipLevelsMutex);
+
+                    uint64_t total = 0;
+
+                    for (auto& level : m_mipLevels)
+                    {
+                        auto size = level->GetPixelSize();
+                        total += static_cast<uint64_t>(size.width) * size.height * GetBytesPerPixel(level->GetPixelFormat().format);
+                    }
+
+                    *value = total;
+                });
+        }
+
     private:
 
         D2D1_RECT_U GetResourceBitmapExtents(ComPtr<ID2D1Bitmap1> const d2dBitmap)
@@ -782,6 +988,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     class CanvasBitmapManager : public ResourceManager<CanvasBitmapTraits>
     {
         std::shared_ptr<ICanvasBitmapResourceCreationAdapter> m_adapter;
+        std::shared_ptr<PixelBufferPool> m_pixelBufferPool;
 
     public:
         CanvasBitmapManager(std::shared_ptr<ICanvasBitmapResourceCreationAdapter> adapter);
@@ -798,6 +1005,56 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasAlphaMode alpha,
             float dpi);
 
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            HSTRING fileName,
+            BitmapSize maxSize,
+            CanvasImageInterpolation interpolation,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            IStream* fileStream,
+            BitmapSize maxSize,
+            CanvasImageInterpolation interpolation,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            IWICFormatConverter* wicFormatConverter,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        // These compress the decoded image into the given block compressed format.
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            HSTRING fileName,
+            DirectXPixelFormat compressedFormat,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            IStream* fileStream,
+            DirectXPixelFormat compressedFormat,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            IWICFormatConverter* wicFormatConverter,
+            DirectXPixelFormat compressedFormat,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            BlockCompressedImage& image,
+            CanvasAlphaMode alpha,
+            float dpi);
+
         ComPtr<CanvasBitmap> CreateNew(
             ICanvasDevice* device,
             uint32_t byteCount,
@@ -822,5 +1079,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ID2D1Bitmap1* bitmap);
 
         ICanvasBitmapResourceCreationAdapter* GetAdapter();
+
+        // Like Create, but shares bitmaps that cache already holds for the same file.
+        ComPtr<CanvasBitmap> CreateCached(
+            BitmapLoadCache& cache,
+            ICanvasDevice* canvasDevice,
+            HSTRING fileName,
+            CanvasAlphaMode alpha,
+            float dpi);
+
+        // Buffers that bitmaps are copied into while they are being saved.
+        std::shared_ptr<PixelBufferPool> const& GetPixelBufferPool();
     };
 }}}}
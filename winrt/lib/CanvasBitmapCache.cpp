@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "CanvasBitmap.h"
+#include "CanvasBitmapCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL::Wrappers;
+
+    //
+    // CanvasBitmapCacheFactory
+    //
+
+    _Use_decl_annotations_
+    IFACEMETHODIMP CanvasBitmapCacheFactory::ActivateInstance(IInspectable** object)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(object);
+
+                auto cache = Make<CanvasBitmapCache>(GetManager());
+                CheckMakeResult(cache);
+
+                ThrowIfFailed(cache.CopyTo(object));
+            });
+    }
+
+
+    //
+    // CanvasBitmapCache
+    //
+
+    CanvasBitmapCache::CanvasBitmapCache(std::shared_ptr<PolymorphicBitmapManager> manager)
+        : m_manager(manager)
+    {
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::LoadAsyncFromHstring(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return LoadAsyncFromHstringWithAlphaAndDpi(
+            resourceCreator,
+            fileName,
+            CanvasAlphaMode::Premultiplied,
+            DEFAULT_DPI,
+            canvasBitmapAsyncOperation);
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::LoadAsyncFromHstringWithAlpha(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        CanvasAlphaMode alpha,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return LoadAsyncFromHstringWithAlphaAndDpi(
+            resourceCreator,
+            fileName,
+            alpha,
+            DEFAULT_DPI,
+            canvasBitmapAsyncOperation);
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::LoadAsyncFromHstringWithAlphaAndDpi(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        CanvasAlphaMode alpha,
+        float dpi,
+        ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(fileName);
+                CheckAndClearOutPointer(canvasBitmapAsyncOperation);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                WinString fileName(fileName);
+
+                // The operation keeps the cache alive until the load completes.
+                ComPtr<CanvasBitmapCache> self(this);
+
+                auto asyncOperation = Make<AsyncOperation<CanvasBitmap>>(
+                    [=]
+                    {
+                        return self->Load(canvasDevice.Get(), fileName, alpha, dpi);
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapAsyncOperation));
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::get_RetainedBytesBudget(uint64_t* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                *value = m_cache.GetRetainedBytesBudget();
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::put_RetainedBytesBudget(uint64_t value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_cache.SetRetainedBytesBudget(value);
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::get_Statistics(CanvasBitmapCacheStatistics* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                *value = m_cache.GetStatistics();
+            });
+    }
+
+    IFACEMETHODIMP CanvasBitmapCache::Clear()
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_cache.Clear();
+            });
+    }
+
+    ComPtr<CanvasBitmap> CanvasBitmapCache::Load(
+        ICanvasDevice* device,
+        HSTRING fileName,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        return m_manager->CreateCachedBitmap(m_cache, device, fileName, alpha, dpi);
+    }
+
+    ActivatableClassWithFactory(CanvasBitmapCache, CanvasBitmapCacheFactory);
+}}}}
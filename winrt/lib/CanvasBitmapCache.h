@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "BitmapLoadCache.h"
+#include "PolymorphicBitmapManager.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    class CanvasBitmapCacheFactory
+        : public ActivationFactory<>
+        , public PerApplicationPolymorphicBitmapManager
+    {
+        InspectableClassStatic(RuntimeClass_Microsoft_Graphics_Canvas_CanvasBitmapCache, BaseTrust);
+
+    public:
+        IFACEMETHOD(ActivateInstance)(_COM_Outptr_ IInspectable** object) override;
+    };
+
+
+    //
+    // Apps opt in to sharing loaded bitmaps by loading them through one of
+    // these.  Each instance has its own BitmapLoadCache, so bitmaps are only
+    // shared between loads made through the same CanvasBitmapCache.
+    //
+    class CanvasBitmapCache : public RuntimeClass<ICanvasBitmapCache>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasBitmapCache, BaseTrust);
+
+        std::shared_ptr<PolymorphicBitmapManager> m_manager;
+        BitmapLoadCache m_cache;
+
+    public:
+        CanvasBitmapCache(std::shared_ptr<PolymorphicBitmapManager> manager);
+
+        IFACEMETHOD(LoadAsyncFromHstring)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromHstringWithAlpha)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            CanvasAlphaMode alpha,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromHstringWithAlphaAndDpi)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
+
+        IFACEMETHOD(get_RetainedBytesBudget)(uint64_t* value) override;
+        IFACEMETHOD(put_RetainedBytesBudget)(uint64_t value) override;
+
+        IFACEMETHOD(get_Statistics)(CanvasBitmapCacheStatistics* value) override;
+
+        IFACEMETHOD(Clear)() override;
+
+        // The synchronous part of LoadAsync, which runs on the async operation's thread.
+        ComPtr<CanvasBitmap> Load(
+            ICanvasDevice* device,
+            HSTRING fileName,
+            CanvasAlphaMode alpha,
+            float dpi);
+    };
+}}}}
@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "CanvasCachedGeometry.h"
+#include "CanvasDevice.h"
+#include "CanvasStrokeStyle.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // CanvasCachedGeometryFactory
+    //
+
+    IFACEMETHODIMP CanvasCachedGeometryFactory::CreateFill(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        ICanvasCachedGeometry** cachedGeometry)
+    {
+        return CreateFillWithFlatteningTolerance(
+            resourceCreator,
+            geometry,
+            D2D1_DEFAULT_FLATTENING_TOLERANCE,
+            cachedGeometry);
+    }
+
+
+    IFACEMETHODIMP CanvasCachedGeometryFactory::CreateFillWithFlatteningTolerance(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        float flatteningTolerance,
+        ICanvasCachedGeometry** cachedGeometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(cachedGeometry);
+
+                auto newCachedGeometry = CanvasCachedGeometry::CreateFill(
+                    resourceCreator,
+                    geometry,
+                    flatteningTolerance);
+
+                ThrowIfFailed(newCachedGeometry.CopyTo(cachedGeometry));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasCachedGeometryFactory::CreateStroke(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        float strokeWidth,
+        ICanvasCachedGeometry** cachedGeometry)
+    {
+        return CreateStrokeWithStrokeStyleAndFlatteningTolerance(
+            resourceCreator,
+            geometry,
+            strokeWidth,
+            nullptr,
+            D2D1_DEFAULT_FLATTENING_TOLERANCE,
+            cachedGeometry);
+    }
+
+
+    IFACEMETHODIMP CanvasCachedGeometryFactory::CreateStrokeWithStrokeStyle(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle,
+        ICanvasCachedGeometry** cachedGeometry)
+    {
+        return CreateStrokeWithStrokeStyleAndFlatteningTolerance(
+            resourceCreator,
+            geometry,
+            strokeWidth,
+            strokeStyle,
+            D2D1_DEFAULT_FLATTENING_TOLERANCE,
+            cachedGeometry);
+    }
+
+
+    IFACEMETHODIMP CanvasCachedGeometryFactory::CreateStrokeWithStrokeStyleAndFlatteningTolerance(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle,
+        float flatteningTolerance,
+        ICanvasCachedGeometry** cachedGeometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(cachedGeometry);
+
+                auto newCachedGeometry = CanvasCachedGeometry::CreateStroke(
+                    resourceCreator,
+                    geometry,
+                    strokeWidth,
+                    strokeStyle,
+                    flatteningTolerance);
+
+                ThrowIfFailed(newCachedGeometry.CopyTo(cachedGeometry));
+            });
+    }
+
+
+    //
+    // CanvasCachedGeometry
+    //
+
+    CanvasCachedGeometry::CanvasCachedGeometry(
+        ICanvasDevice* device,
+        ID2D1GeometryRealization* geometryRealization)
+        : m_device(device)
+        , m_geometryRealization(geometryRealization)
+    {
+    }
+
+
+    static void ThrowIfInvalidFlatteningTolerance(float flatteningTolerance)
+    {
+        if (!(flatteningTolerance > 0) || !isfinite(flatteningTolerance))
+            ThrowHR(E_INVALIDARG);
+    }
+
+
+    // Geometry realizations can only be created by a device context. The
+    // geometry and stroke style must be realized for that context's factory.
+    static ComPtr<ID2D1DeviceContext1> CreateDeviceContext(
+        ICanvasDevice* device,
+        ComPtr<ID2D1Factory>* d2dFactory)
+    {
+        auto deviceContext = As<ICanvasDeviceInternal>(device)->CreateDeviceContext();
+
+        deviceContext->GetFactory(d2dFactory->ReleaseAndGetAddressOf());
+
+        return deviceContext;
+    }
+
+
+    ComPtr<CanvasCachedGeometry> CanvasCachedGeometry::CreateFill(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        float flatteningTolerance)
+    {
+        CheckInPointer(resourceCreator);
+        CheckInPointer(geometry);
+        ThrowIfInvalidFlatteningTolerance(flatteningTolerance);
+
+        ComPtr<ICanvasDevice> device;
+        ThrowIfFailed(resourceCreator->get_Device(&device));
+
+        ComPtr<ID2D1Factory> d2dFactory;
+        auto deviceContext = CreateDeviceContext(device.Get(), &d2dFactory);
+
+        auto d2dGeometry = As<ICanvasGeometryInternal>(geometry)->GetRealizedD2DGeometry(d2dFactory.Get());
+
+        ComPtr<ID2D1GeometryRealization> geometryRealization;
+        ThrowIfFailed(deviceContext->CreateFilledGeometryRealization(
+            d2dGeometry.Get(),
+            flatteningTolerance,
+            &geometryRealization));
+
+        auto cachedGeometry = Make<CanvasCachedGeometry>(device.Get(), geometryRealization.Get());
+        CheckMakeResult(cachedGeometry);
+
+        return cachedGeometry;
+    }
+
+
+    ComPtr<CanvasCachedGeometry> CanvasCachedGeometry::CreateStroke(
+        ICanvasResourceCreator* resourceCreator,
+        ICanvasGeometry* geometry,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle,
+        float flatteningTolerance)
+    {
+        CheckInPointer(resourceCreator);
+        CheckInPointer(geometry);
+        ThrowIfInvalidFlatteningTolerance(flatteningTolerance);
+
+        ComPtr<ICanvasDevice> device;
+        ThrowIfFailed(resourceCreator->get_Device(&device));
+
+        ComPtr<ID2D1Factory> d2dFactory;
+        auto deviceContext = CreateDeviceContext(device.Get(), &d2dFactory);
+
+        auto d2dGeometry = As<ICanvasGeometryInternal>(geometry)->GetRealizedD2DGeometry(d2dFactory.Get());
+
+        ComPtr<ID2D1StrokeStyle1> d2dStrokeStyle;
+        if (strokeStyle)
+            d2dStrokeStyle = As<ICanvasStrokeStyleInternal>(strokeStyle)->GetRealizedD2DStrokeStyle(d2dFactory.Get());
+
+        ComPtr<ID2D1GeometryRealization> geometryRealization;
+        ThrowIfFailed(deviceContext->CreateStrokedGeometryRealization(
+            d2dGeometry.Get(),
+            flatteningTolerance,
+            strokeWidth,
+            d2dStrokeStyle.Get(),
+            &geometryRealization));
+
+        auto cachedGeometry = Make<CanvasCachedGeometry>(device.Get(), geometryRealization.Get());
+        CheckMakeResult(cachedGeometry);
+
+        return cachedGeometry;
+    }
+
+
+    IFACEMETHODIMP CanvasCachedGeometry::get_Device(ICanvasDevice** value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(value);
+
+                auto& device = m_device.EnsureNotClosed();
+                ThrowIfFailed(device.CopyTo(value));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasCachedGeometry::Close()
+    {
+        m_geometryRealization.Close();
+        m_device.Close();
+        return S_OK;
+    }
+
+
+    ComPtr<ID2D1GeometryRealization> const& CanvasCachedGeometry::GetGeometryRealization()
+    {
+        return m_geometryRealization.EnsureNotClosed();
+    }
+
+
+    ActivatableStaticOnlyFactory(CanvasCachedGeometryFactory);
+}}}}
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "CanvasGeometry.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    [uuid(7C41E9B2-86D5-4A30-B2F7-5E1D93C08A64)]
+    class ICanvasCachedGeometryInternal : public IUnknown
+    {
+    public:
+        virtual ComPtr<ID2D1GeometryRealization> const& GetGeometryRealization() = 0;
+    };
+
+
+    class CanvasCachedGeometryFactory : public ActivationFactory<ICanvasCachedGeometryStatics>
+    {
+        InspectableClassStatic(RuntimeClass_Microsoft_Graphics_Canvas_CanvasCachedGeometry, BaseTrust);
+
+    public:
+        //
+        // ICanvasCachedGeometryStatics
+        //
+
+        IFACEMETHOD(CreateFill)(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            ICanvasCachedGeometry** cachedGeometry) override;
+
+        IFACEMETHOD(CreateFillWithFlatteningTolerance)(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            float flatteningTolerance,
+            ICanvasCachedGeometry** cachedGeometry) override;
+
+        IFACEMETHOD(CreateStroke)(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            float strokeWidth,
+            ICanvasCachedGeometry** cachedGeometry) override;
+
+        IFACEMETHOD(CreateStrokeWithStrokeStyle)(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle,
+            ICanvasCachedGeometry** cachedGeometry) override;
+
+        IFACEMETHOD(CreateStrokeWithStrokeStyleAndFlatteningTolerance)(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle,
+            float flatteningTolerance,
+            ICanvasCachedGeometry** cachedGeometry) override;
+    };
+
+
+    //
+    // Wraps an ID2D1GeometryRealization. The geometry is tessellated when the
+    // cached geometry is created, and drawing it only replays the triangles.
+    //
+    class CanvasCachedGeometry : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasCachedGeometry,
+        ABI::Windows::Foundation::IClosable,
+        CloakedIid<ICanvasCachedGeometryInternal>>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasCachedGeometry, BaseTrust);
+
+        ClosablePtr<ICanvasDevice> m_device;
+        ClosablePtr<ID2D1GeometryRealization> m_geometryRealization;
+
+    public:
+        CanvasCachedGeometry(
+            ICanvasDevice* device,
+            ID2D1GeometryRealization* geometryRealization);
+
+        static ComPtr<CanvasCachedGeometry> CreateFill(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            float flatteningTolerance);
+
+        static ComPtr<CanvasCachedGeometry> CreateStroke(
+            ICanvasResourceCreator* resourceCreator,
+            ICanvasGeometry* geometry,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle,
+            float flatteningTolerance);
+
+        //
+        // ICanvasCachedGeometry
+        //
+
+        IFACEMETHOD(get_Device)(ICanvasDevice** value) override;
+
+        //
+        // IClosable
+        //
+
+        IFACEMETHOD(Close)() override;
+
+        //
+        // ICanvasCachedGeometryInternal
+        //
+
+        virtual ComPtr<ID2D1GeometryRealization> const& GetGeometryRealization() override;
+    };
+}}}}
@@ -14,8 +14,10 @@
 
 #include "CanvasControl.h"
 #include "CanvasDevice.h"
+#include "CanvasDrawingStatistics.h"
 #include "CanvasImageSource.h"
 #include "RecreatableDeviceManager.impl.h"
+#include "Tracing.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -57,6 +59,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    void CanvasDrawEventArgs::SetDrawingSession(ICanvasDrawingSession* drawingSession)
+    {
+        m_drawingSession = drawingSession;
+    }
+
 
     class CanvasControlAdapter : public ICanvasControlAdapter
     {
@@ -409,6 +416,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         , m_imageSourceHeight(0)
         , m_isLoaded(false)
         , m_dpi(m_adapter->GetLogicalDpi())
+        , m_isDrawingStatisticsEnabled(false)
         , m_guardedState(std::make_unique<GuardedState>())
     {
         CreateBaseClass();
@@ -619,6 +627,38 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    IFACEMETHODIMP CanvasControl::put_IsDrawingStatisticsEnabled(boolean value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_isDrawingStatisticsEnabled = !!value;
+
+                if (!m_isDrawingStatisticsEnabled)
+                    m_lastFrameStatistics.Reset();
+            });
+    }
+
+    IFACEMETHODIMP CanvasControl::get_IsDrawingStatisticsEnabled(boolean* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                *value = m_isDrawingStatisticsEnabled;
+            });
+    }
+
+    IFACEMETHODIMP CanvasControl::get_DrawingStatistics(ICanvasDrawingStatistics** value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(value);
+                ThrowIfFailed(m_lastFrameStatistics.CopyTo(value));
+            });
+    }
+
     HRESULT CanvasControl::OnCompositionRendering(IInspectable*, IInspectable*)
     {
         return ExceptionBoundary(
@@ -631,7 +671,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     [=](ICanvasDevice* device, RunWithDeviceFlags flags)
                     {
                         if ((flags & RunWithDeviceFlags::NewlyCreatedDevice) == RunWithDeviceFlags::NewlyCreatedDevice)
+                        {
                             m_canvasImageSource.Reset();
+                            m_recycledDrawingSession.Reset();
+                        }
 
                         auto clearColor = m_guardedState->PreDrawAndGetClearColor(this);
                         auto backgroundMode = clearColor.A == 255 ? CanvasBackground::Opaque : CanvasBackground::Transparent;
@@ -716,18 +759,113 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         if (!m_canvasImageSource)
             return;
 
+        // Anything the handlers draw, including into other drawing sessions
+        // they create, counts towards this frame.
+        std::shared_ptr<DrawingStatistics> statistics;
+        if (m_isDrawingStatisticsEnabled)
+            statistics = std::make_shared<DrawingStatistics>();
+
+        {
+            DrawingStatisticsScope statisticsScope(statistics.get());
+
+            auto drawingSession = CreateDrawingSession(clearColor);
+            auto drawEventArgs = CreateDrawEventArgs(drawingSession.Get());
+
+            if (resourcesHaveBeenCreated)
+            {
+                TRACE_SPAN(DrawHandlers);
+                ThrowIfFailed(m_drawEventList.InvokeAll(this, drawEventArgs.Get()));
+            }
+
+            ThrowIfFailed(As<IClosable>(drawingSession)->Close());
+
+            RecycleDrawObjects(drawingSession, drawEventArgs);
+        }
+
+        if (statistics)
+        {
+            auto frameStatistics = Make<CanvasDrawingStatistics>(*statistics);
+            CheckMakeResult(frameStatistics);
+            m_lastFrameStatistics = frameStatistics;
+        }
+    }
+
+    ComPtr<ICanvasDrawingSession> CanvasControl::CreateDrawingSession(Color const& clearColor)
+    {
+        // The recycled objects are taken out of their members for the
+        // duration of the frame, so that if drawing fails they are simply
+        // dropped rather than reused in an unknown state.
         ComPtr<ICanvasDrawingSession> drawingSession;
-        ThrowIfFailed(m_canvasImageSource->CreateDrawingSession(clearColor, &drawingSession));
+        std::swap(drawingSession, m_recycledDrawingSession);
+
+        if (drawingSession && m_canvasImageSource->TryReopenDrawingSession(drawingSession.Get(), clearColor))
+            return drawingSession;
 
-        ComPtr<CanvasDrawEventArgs> drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession.Get());
-        CheckMakeResult(drawEventArgs);
+        ComPtr<ICanvasDrawingSession> newDrawingSession;
+        ThrowIfFailed(m_canvasImageSource->CreateDrawingSession(clearColor, &newDrawingSession));
+        return newDrawingSession;
+    }
+
+    ComPtr<CanvasDrawEventArgs> CanvasControl::CreateDrawEventArgs(ICanvasDrawingSession* drawingSession)
+    {
+        ComPtr<CanvasDrawEventArgs> drawEventArgs;
+        std::swap(drawEventArgs, m_recycledDrawEventArgs);
+
+        if (drawEventArgs)
+        {
+            drawEventArgs->SetDrawingSession(drawingSession);
+        }
+        else
+        {
+            drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession);
+            CheckMakeResult(drawEventArgs);
+        }
+
+        return drawEventArgs;
+    }
+
+    template<typename T>
+    static bool IsOnlyReference(ComPtr<T> const& ptr)
+    {
+        // Exploit side effect of AddRef+Release to read the current refcount.
+        ptr.Get()->AddRef();
+        if (ptr.Get()->Release() != 1)
+            return false;
+
+        //
+        // Nobody else has a strong reference, but someone may have a weak
+        // one.  Resolving that must not hand them the next frame's object.
+        //
+        // Once asked for, an object's weak reference lives as long as the
+        // object does, and the object holds a reference to it.  So, with the
+        // one we take here, a count of two means nobody else has one.
+        //
+        WeakRef weakRef;
+        if (FAILED(AsWeak(ptr.Get(), &weakRef)))
+            return true;    // nobody can have a weak reference to this
+
+        weakRef.Get()->AddRef();
+        return weakRef.Get()->Release() == 2;
+    }
+
+    void CanvasControl::RecycleDrawObjects(
+        ComPtr<ICanvasDrawingSession> const& drawingSession,
+        ComPtr<CanvasDrawEventArgs> const& drawEventArgs)
+    {
+        //
+        // Draw handlers may hold on to the event args or drawing session,
+        // strongly or weakly, past the end of the Draw event.  These must
+        // carry on reporting that the drawing session is closed, so they are
+        // only reused if nothing else has a reference to them.
+        //
+        if (!IsOnlyReference(drawEventArgs))
+            return;
 
-        if (resourcesHaveBeenCreated)
-            ThrowIfFailed(m_drawEventList.InvokeAll(this, drawEventArgs.Get()));
+        drawEventArgs->SetDrawingSession(nullptr);
+        m_recycledDrawEventArgs = drawEventArgs;
 
-        ComPtr<IClosable> drawingSessionClosable;
-        ThrowIfFailed(drawingSession.As(&drawingSessionClosable));
-        ThrowIfFailed(drawingSessionClosable->Close());
+        if (IsOnlyReference(drawingSession))
+            m_recycledDrawingSession = drawingSession;
     }
 
     bool CanvasControl::IsWindowVisible()
@@ -49,6 +49,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
          CanvasDrawEventArgs(ICanvasDrawingSession* drawingSession);
 
          IFACEMETHODIMP get_DrawingSession(ICanvasDrawingSession** value);
+
+         // Lets CanvasControl reuse the same event args for each frame.
+         void SetDrawingSession(ICanvasDrawingSession* drawingSession);
     };
 
     typedef ITypedEventHandler<CanvasControl*, CanvasCreateResourcesEventArgs*> CreateResourcesEventHandler;
@@ -144,6 +147,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         bool m_isLoaded;
         float m_dpi;
 
+        bool m_isDrawingStatisticsEnabled;
+        ComPtr<ICanvasDrawingStatistics> m_lastFrameStatistics;
+
+        // Kept from the previous frame, provided nothing else held on to them,
+        // so that each frame doesn't need to allocate new ones.
+        ComPtr<ICanvasDrawingSession> m_recycledDrawingSession;
+        ComPtr<CanvasDrawEventArgs> m_recycledDrawEventArgs;
+
         class GuardedState;
         std::unique_ptr<GuardedState> m_guardedState;
         
@@ -180,6 +191,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         IFACEMETHODIMP Invalidate() override;
 
+        IFACEMETHODIMP put_IsDrawingStatisticsEnabled(boolean value) override;
+
+        IFACEMETHODIMP get_IsDrawingStatisticsEnabled(boolean* value) override;
+
+        IFACEMETHODIMP get_DrawingStatistics(ICanvasDrawingStatistics** value) override;
+
         //
         // ICanvasResourceCreator
         //
@@ -267,6 +284,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         HRESULT OnCompositionRendering(IInspectable* sender, IInspectable* args);        
         void EnsureSizeDependentResources(ICanvasDevice* device, CanvasBackground backgroundMode);
         void CallDrawHandlers(Color const& clearColor, bool resourcesHaveBeenCreated);
+        ComPtr<ICanvasDrawingSession> CreateDrawingSession(Color const& clearColor);
+        ComPtr<CanvasDrawEventArgs> CreateDrawEventArgs(ICanvasDrawingSession* drawingSession);
+        void RecycleDrawObjects(ComPtr<ICanvasDrawingSession> const& drawingSession, ComPtr<CanvasDrawEventArgs> const& drawEventArgs);
     };
 
 }}}}
@@ -13,6 +13,8 @@
 #include "pch.h"
 #include "CanvasDevice.h"
 #include "CanvasImage.h"
+#include "CanvasRenderTarget.h"
+#include "Tracing.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -146,6 +148,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ThrowIfInvalid(debugLevel);
         CheckInPointer(d2dFactory);
 
+        TRACE_SPAN(DeviceCreation);
+
         CanvasHardwareAcceleration hardwareAcceleration;
 
         auto dxgiDevice = MakeDXGIDevice(
@@ -188,6 +192,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         CheckInPointer(direct3DDevice);
         CheckInPointer(d2dFactory);
 
+        TRACE_SPAN(DeviceCreation);
+
         ComPtr<IDirect3DDxgiInterfaceAccess> dxgiInterfaceAccess;
         ThrowIfFailed(direct3DDevice->QueryInterface(IID_PPV_ARGS(&dxgiInterfaceAccess)));
 
@@ -428,7 +434,17 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     IFACEMETHODIMP CanvasDevice::Close()
     {
-        HRESULT hr = ResourceWrapper::Close();
+        // Pooled render targets hold on to the D2D device, so would keep its
+        // memory alive until this object was released.
+        HRESULT hr = ExceptionBoundary(
+            [&]
+            {
+                PerApplicationPolymorphicBitmapManager::GetOrCreateManager()->GetRenderTargetPool().Trim(this);
+            });
+        if (FAILED(hr))
+            return hr;
+
+        hr = ResourceWrapper::Close();
         if (FAILED(hr))
             return hr;
         
@@ -556,6 +572,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto& dxgiDevice = m_dxgiDevice.EnsureNotClosed();
 
+                // Pooled render targets would otherwise keep their memory
+                // alive through the trim.
+                PerApplicationPolymorphicBitmapManager::GetOrCreateManager()->GetRenderTargetPool().Trim(this);
+
                 dxgiDevice->Trim();
             });
     }
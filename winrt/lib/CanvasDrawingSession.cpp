@@ -15,29 +15,19 @@
 #include "CanvasDrawingSession.h"
 #include "CanvasStrokeStyle.h"
 #include "CanvasTextFormat.h"
+#include "CanvasTextLayout.h"
+#include "CanvasGeometry.h"
+#include "CanvasCachedGeometry.h"
 #include "CanvasImage.h"
 #include "CanvasDevice.h"
 #include "CanvasBitmap.h"
+#include "CanvasVirtualBitmap.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ABI::Windows::Foundation;
     using namespace ABI::Windows::UI;
 
-    ComPtr<ID2D1StrokeStyle1> ToD2DStrokeStyle(ICanvasStrokeStyle* strokeStyle, ID2D1DeviceContext* deviceContext)
-    {
-        if (!strokeStyle) return nullptr;
-
-        ComPtr<ID2D1Factory> d2dFactory;
-        deviceContext->GetFactory(&d2dFactory);
-
-        ComPtr<ICanvasStrokeStyleInternal> internal;
-        ThrowIfFailed(strokeStyle->QueryInterface(internal.GetAddressOf()));
-
-        return internal->GetRealizedD2DStrokeStyle(d2dFactory.Get());
-    }
-    
-
     //
     // This drawing session adapter is used when wrapping an existing
     // ID2D1DeviceContext.  In this wrapper, interop, case we don't want
@@ -105,8 +95,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         : ResourceWrapper(manager, deviceContext)
         , m_owner(owner)
         , m_adapter(adapter)
+        , m_statisticsStartTime(0)
+        , m_hasStroked(false)
     {
         CheckInPointer(adapter.get());
+
+        BeginStatistics();
     }
 
 
@@ -117,6 +111,41 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    void CanvasDrawingSession::Reopen(
+        ICanvasDevice* owner,
+        ID2D1DeviceContext1* deviceContext,
+        std::shared_ptr<ICanvasDrawingSessionAdapter> adapter)
+    {
+        CheckInPointer(adapter.get());
+
+        ResourceWrapper::Reopen(deviceContext);
+
+        // The cached color brush can only be kept if it was created on the
+        // same device.
+        if (owner != m_owner.Get())
+            m_solidColorBrush.Reset();
+
+        m_owner = owner;
+        m_adapter = adapter;
+        m_lastBrush.Reset();
+        m_lastStrokeStyle.Reset();
+        m_hasStroked = false;
+
+        BeginStatistics();
+    }
+
+
+    void CanvasDrawingSession::BeginStatistics()
+    {
+        if (auto statistics = DrawingStatistics::GetCurrent())
+        {
+            m_statistics = statistics->shared_from_this();
+            m_statistics->AddDrawingSession();
+            m_statisticsStartTime = DrawingStatistics::GetTimestamp();
+        }
+    }
+
+
     IFACEMETHODIMP CanvasDrawingSession::Close()
     {
         // Base class Close() called outside of ExceptionBoundary since this
@@ -125,6 +154,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         if (FAILED(hr))
             return hr;
 
+        m_d2dFactory.Reset();
+        m_lastBrush.Reset();
+        m_lastStrokeStyle.Reset();
+
         return ExceptionBoundary(
             [&]
             {
@@ -135,7 +168,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto adapter = m_adapter;
                     m_adapter.reset();
 
+                    auto statistics = m_statistics;
+                    m_statistics.reset();
+
                     adapter->EndDraw();
+
+                    if (statistics)
+                        statistics->AddDrawTime(DrawingStatistics::GetTimestamp() - m_statisticsStartTime);
                 }        
             });
     }
@@ -151,6 +190,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 auto d2dColor = ToD2DColor(color);
                 deviceContext->Clear(&d2dColor);
+
+                CountDraw(DrawingPrimitive::Clear);
             });
     }
 
@@ -297,6 +338,31 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return DrawBitmapWithDestRectAndSourceRectImpl(bitmap, destinationRect, &sourceRect, opacity, interpolation, &perspective);
     }
 
+    IFACEMETHODIMP CanvasDrawingSession::DrawVirtualBitmapWithDestRect(
+        ICanvasVirtualBitmap* virtualBitmap,
+        Rect destinationRect)
+    {
+        return DrawVirtualBitmapImpl(virtualBitmap, destinationRect, nullptr, 1.0f, CanvasImageInterpolation::Linear);
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawVirtualBitmapWithDestRectAndSourceRect(
+        ICanvasVirtualBitmap* virtualBitmap,
+        Rect destinationRect,
+        Rect sourceRect)
+    {
+        return DrawVirtualBitmapImpl(virtualBitmap, destinationRect, &sourceRect, 1.0f, CanvasImageInterpolation::Linear);
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawVirtualBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation(
+        ICanvasVirtualBitmap* virtualBitmap,
+        Rect destinationRect,
+        Rect sourceRect,
+        float opacity,
+        CanvasImageInterpolation interpolation)
+    {
+        return DrawVirtualBitmapImpl(virtualBitmap, destinationRect, &sourceRect, opacity, interpolation);
+    }
+
     HRESULT CanvasDrawingSession::DrawImageImpl(
         ICanvasImage* image,
         Vector2 offset,
@@ -317,12 +383,18 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             D2D1_RECT_F d2dSourceRect;
             if (sourceRect) d2dSourceRect = ToD2DRect(*sourceRect);
 
+            // Effects realized while getting the image count against this
+            // session's statistics.
+            DrawingStatisticsScope statisticsScope(m_statistics.get());
+
             deviceContext->DrawImage(
                 internal->GetD2DImage(deviceContext.Get()).Get(),
                 &d2dOffset,
                 sourceRect ? &d2dSourceRect : nullptr,
                 static_cast<D2D1_INTERPOLATION_MODE>(interpolation),
                 static_cast<D2D1_COMPOSITE_MODE>(composite));
+
+            CountDraw(DrawingPrimitive::Image);
         });
 
     }
@@ -348,13 +420,97 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             D2D1_RECT_F d2dSourceRect;
             if (sourceRect) d2dSourceRect = ToD2DRect(*sourceRect);
 
+            // A perspective transform draws different parts of the bitmap at
+            // different scales, so no single mip level would suit it.
+            auto d2dBitmap = perspective ? internal->GetD2DBitmap()
+                                         : internal->GetD2DBitmapForDrawing(deviceContext.Get(), d2dDestRect, sourceRect ? &d2dSourceRect : nullptr);
+
             deviceContext->DrawBitmap(
-                internal->GetD2DBitmap().Get(),
+                d2dBitmap.Get(),
                 &d2dDestRect,
                 opacity,
                 static_cast<D2D1_INTERPOLATION_MODE>(interpolation),
                 sourceRect ? &d2dSourceRect : nullptr,
                 ReinterpretAs<D2D1_MATRIX_4X4_F*>(perspective));
+
+            CountDraw(DrawingPrimitive::Image);
+        });
+    }
+
+    // Returns false if the target has no fixed extent, for instance when
+    // drawing to a command list.
+    static bool TryGetTargetBounds(ID2D1DeviceContext* deviceContext, D2D1_RECT_F* bounds)
+    {
+        ComPtr<ID2D1Image> target;
+        deviceContext->GetTarget(&target);
+
+        ComPtr<ID2D1Bitmap> targetBitmap;
+        if (!target || FAILED(target.As(&targetBitmap)))
+            return false;
+
+        auto size = targetBitmap->GetSize();
+        *bounds = D2D1::RectF(0, 0, size.width, size.height);
+        return true;
+    }
+
+    HRESULT CanvasDrawingSession::DrawVirtualBitmapImpl(
+        ICanvasVirtualBitmap* virtualBitmap,
+        Rect destinationRect,
+        Rect* sourceRect,
+        float opacity,
+        CanvasImageInterpolation interpolation)
+    {
+        return ExceptionBoundary(
+            [&]
+        {
+            auto& deviceContext = GetResource();
+            CheckInPointer(virtualBitmap);
+
+            ComPtr<ICanvasVirtualBitmapInternal> internal;
+            ThrowIfFailed(virtualBitmap->QueryInterface(IID_PPV_ARGS(&internal)));
+
+            D2D1_RECT_F d2dDestRect = ToD2DRect(destinationRect);
+            D2D1_RECT_F d2dSourceRect;
+
+            if (sourceRect)
+            {
+                d2dSourceRect = ToD2DRect(*sourceRect);
+            }
+            else
+            {
+                auto size = internal->GetSizeInPixels();
+                d2dSourceRect = D2D1::RectF(0, 0, static_cast<float>(size.Width), static_cast<float>(size.Height));
+            }
+
+            // Only the tiles that end up on the render target are decoded.
+            D2D1_MATRIX_3X2_F transform;
+            deviceContext->GetTransform(&transform);
+
+            D2D1_RECT_F targetBounds;
+            bool hasTargetBounds = TryGetTargetBounds(deviceContext.Get(), &targetBounds);
+
+            D2D1_RECT_F visibleSourceRect;
+            if (!VirtualBitmapTiles::GetVisibleSourceRect(d2dDestRect, d2dSourceRect, transform, hasTargetBounds ? &targetBounds : nullptr, &visibleSourceRect))
+                return;
+
+            for (auto& tile : internal->GetTilesToDraw(visibleSourceRect))
+            {
+                D2D1_RECT_F tileDestRect;
+                D2D1_RECT_F tileSourceRect;
+
+                if (!VirtualBitmapTiles::GetTileDrawRects(tile, d2dDestRect, d2dSourceRect, &tileDestRect, &tileSourceRect))
+                    continue;
+
+                Rect tileSource = FromD2DRect(tileSourceRect);
+
+                ThrowIfFailed(DrawBitmapWithDestRectAndSourceRectImpl(
+                    tile.Bitmap.Get(),
+                    FromD2DRect(tileDestRect),
+                    &tileSource,
+                    opacity,
+                    interpolation,
+                    nullptr));
+            }
         });
     }
 
@@ -572,12 +728,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         auto& deviceContext = GetResource();
         CheckInPointer(brush);
 
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle);
+
         deviceContext->DrawLine(
             ToD2DPoint(point0),
             ToD2DPoint(point1),
             brush,
             strokeWidth,
-            ToD2DStrokeStyle(strokeStyle, deviceContext.Get()).Get());
+            d2dStrokeStyle.Get());
+
+        CountStroke(DrawingPrimitive::Line, brush, d2dStrokeStyle.Get());
     }
 
 
@@ -778,11 +938,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dRect = ToD2DRect(rect);
 
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle);
+
         deviceContext->DrawRectangle(
             &d2dRect,
             brush,
             strokeWidth,
-            ToD2DStrokeStyle(strokeStyle, deviceContext.Get()).Get());
+            d2dStrokeStyle.Get());
+
+        CountStroke(DrawingPrimitive::Rectangle, brush, d2dStrokeStyle.Get());
     }
 
 
@@ -856,6 +1020,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         deviceContext->FillRectangle(
             &d2dRect,
             brush);
+
+        CountDraw(DrawingPrimitive::Rectangle, brush);
     }
 
 
@@ -1106,11 +1272,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dRoundedRect = ToD2DRoundedRect(rect, radiusX, radiusY);
 
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle);
+
         deviceContext->DrawRoundedRectangle(
             &d2dRoundedRect,
             brush,
             strokeWidth,
-            ToD2DStrokeStyle(strokeStyle, deviceContext.Get()).Get());
+            d2dStrokeStyle.Get());
+
+        CountStroke(DrawingPrimitive::RoundedRectangle, brush, d2dStrokeStyle.Get());
     }
 
 
@@ -1202,6 +1372,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         deviceContext->FillRoundedRectangle(
             &d2dRoundedRect,
             brush);
+
+        CountDraw(DrawingPrimitive::RoundedRectangle, brush);
     }
 
 
@@ -1440,11 +1612,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         auto d2dEllipse = ToD2DEllipse(centerPoint, radiusX, radiusY);
 
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle);
+
         deviceContext->DrawEllipse(
             &d2dEllipse,
             brush,
             strokeWidth,
-            ToD2DStrokeStyle(strokeStyle, deviceContext.Get()).Get());
+            d2dStrokeStyle.Get());
+
+        CountStroke(DrawingPrimitive::Ellipse, brush, d2dStrokeStyle.Get());
     }
 
 
@@ -1532,6 +1708,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         deviceContext->FillEllipse(
             &d2dEllipse,
             brush);
+
+        CountDraw(DrawingPrimitive::Ellipse, brush);
     }
 
 
@@ -1962,6 +2140,547 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    //
+    // DrawTextLayout
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawTextLayoutWithBrush(
+        ICanvasTextLayout* textLayout,
+        Vector2 point,
+        ICanvasBrush* brush)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawTextLayoutImpl(
+                    textLayout,
+                    point,
+                    ToD2DBrush(brush).Get());
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawTextLayoutWithColor(
+        ICanvasTextLayout* textLayout,
+        Vector2 point,
+        Color color)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawTextLayoutImpl(
+                    textLayout,
+                    point,
+                    GetColorBrush(color));
+            });
+    }
+
+
+    void CanvasDrawingSession::DrawTextLayoutImpl(
+        ICanvasTextLayout* textLayout,
+        Vector2 const& point,
+        ID2D1Brush* brush)
+    {
+        auto& deviceContext = GetResource();
+        CheckInPointer(textLayout);
+        CheckInPointer(brush);
+
+        ComPtr<ICanvasTextLayoutInternal> textLayoutInternal;
+        ThrowIfFailed(textLayout->QueryInterface(textLayoutInternal.GetAddressOf()));
+
+        for (auto& run : textLayoutInternal->GetShapedText().Runs)
+        {
+            auto glyphRun = run.GetGlyphRun();
+
+            auto baselineOrigin = D2D1::Point2F(
+                point.X + run.BaselineOrigin.x,
+                point.Y + run.BaselineOrigin.y);
+
+            deviceContext->DrawGlyphRun(
+                baselineOrigin,
+                &glyphRun,
+                brush,
+                DWRITE_MEASURING_MODE_NATURAL);
+        }
+
+        CountDraw(DrawingPrimitive::Text, brush);
+    }
+
+
+    //
+    // FillGeometry
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::FillGeometryWithBrush(
+        ICanvasGeometry* geometry,
+        ICanvasBrush* brush)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                FillGeometryImpl(
+                    geometry,
+                    ToD2DBrush(brush).Get());
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::FillGeometryWithColor(
+        ICanvasGeometry* geometry,
+        Color color)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                FillGeometryImpl(
+                    geometry,
+                    GetColorBrush(color));
+            });
+    }
+
+
+    void CanvasDrawingSession::FillGeometryImpl(
+        ICanvasGeometry* geometry,
+        ID2D1Brush* brush)
+    {
+        auto& deviceContext = GetResource();
+        CheckInPointer(geometry);
+        CheckInPointer(brush);
+
+        deviceContext->FillGeometry(
+            ToD2DGeometry(geometry).Get(),
+            brush);
+
+        CountDraw(DrawingPrimitive::Geometry, brush);
+    }
+
+
+    //
+    // DrawGeometry
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawGeometryWithBrush(
+        ICanvasGeometry* geometry,
+        ICanvasBrush* brush)
+    {
+        return DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle(
+            geometry,
+            brush,
+            1.0f,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawGeometryWithColor(
+        ICanvasGeometry* geometry,
+        Color color)
+    {
+        return DrawGeometryWithColorAndStrokeWidthAndStrokeStyle(
+            geometry,
+            color,
+            1.0f,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawGeometryWithBrushAndStrokeWidth(
+        ICanvasGeometry* geometry,
+        ICanvasBrush* brush,
+        float strokeWidth)
+    {
+        return DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle(
+            geometry,
+            brush,
+            strokeWidth,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawGeometryWithColorAndStrokeWidth(
+        ICanvasGeometry* geometry,
+        Color color,
+        float strokeWidth)
+    {
+        return DrawGeometryWithColorAndStrokeWidthAndStrokeStyle(
+            geometry,
+            color,
+            strokeWidth,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle(
+        ICanvasGeometry* geometry,
+        ICanvasBrush* brush,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawGeometryImpl(
+                    geometry,
+                    ToD2DBrush(brush).Get(),
+                    strokeWidth,
+                    strokeStyle);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawGeometryWithColorAndStrokeWidthAndStrokeStyle(
+        ICanvasGeometry* geometry,
+        Color color,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawGeometryImpl(
+                    geometry,
+                    GetColorBrush(color),
+                    strokeWidth,
+                    strokeStyle);
+            });
+    }
+
+
+    void CanvasDrawingSession::DrawGeometryImpl(
+        ICanvasGeometry* geometry,
+        ID2D1Brush* brush,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        auto& deviceContext = GetResource();
+        CheckInPointer(geometry);
+        CheckInPointer(brush);
+
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle);
+
+        deviceContext->DrawGeometry(
+            ToD2DGeometry(geometry).Get(),
+            brush,
+            strokeWidth,
+            d2dStrokeStyle.Get());
+
+        CountStroke(DrawingPrimitive::Geometry, brush, d2dStrokeStyle.Get());
+    }
+
+
+    //
+    // DrawCachedGeometry
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawCachedGeometryWithBrush(
+        ICanvasCachedGeometry* cachedGeometry,
+        Vector2 offset,
+        ICanvasBrush* brush)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawCachedGeometryImpl(
+                    cachedGeometry,
+                    offset,
+                    ToD2DBrush(brush).Get());
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawCachedGeometryWithColor(
+        ICanvasCachedGeometry* cachedGeometry,
+        Vector2 offset,
+        Color color)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawCachedGeometryImpl(
+                    cachedGeometry,
+                    offset,
+                    GetColorBrush(color));
+            });
+    }
+
+
+    void CanvasDrawingSession::DrawCachedGeometryImpl(
+        ICanvasCachedGeometry* cachedGeometry,
+        Vector2 const& offset,
+        ID2D1Brush* brush)
+    {
+        auto& deviceContext = GetResource();
+        CheckInPointer(cachedGeometry);
+        CheckInPointer(brush);
+
+        ComPtr<ICanvasCachedGeometryInternal> cachedGeometryInternal;
+        ThrowIfFailed(cachedGeometry->QueryInterface(cachedGeometryInternal.GetAddressOf()));
+
+        auto& geometryRealization = cachedGeometryInternal->GetGeometryRealization();
+
+        CountDraw(DrawingPrimitive::Geometry, brush);
+
+        if (offset.X == 0 && offset.Y == 0)
+        {
+            deviceContext->DrawGeometryRealization(geometryRealization.Get(), brush);
+            return;
+        }
+
+        // Geometry realizations have no offset parameter, so the offset is
+        // applied by temporarily adding it to the transform.
+        D2D1::Matrix3x2F previousTransform;
+        deviceContext->GetTransform(&previousTransform);
+
+        auto restoreTransform = MakeScopeWarden(
+            [&]
+            {
+                deviceContext->SetTransform(previousTransform);
+            });
+
+        deviceContext->SetTransform(D2D1::Matrix3x2F::Translation(offset.X, offset.Y) * previousTransform);
+
+        deviceContext->DrawGeometryRealization(geometryRealization.Get(), brush);
+    }
+
+
+    //
+    // DrawPolyline
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawPolylineWithBrush(
+        uint32_t pointCount,
+        Vector2* points,
+        ICanvasBrush* brush)
+    {
+        return DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(
+            pointCount,
+            points,
+            brush,
+            1.0f,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawPolylineWithColor(
+        uint32_t pointCount,
+        Vector2* points,
+        Color color)
+    {
+        return DrawPolylineWithColorAndStrokeWidthAndStrokeStyle(
+            pointCount,
+            points,
+            color,
+            1.0f,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawPolylineWithBrushAndStrokeWidth(
+        uint32_t pointCount,
+        Vector2* points,
+        ICanvasBrush* brush,
+        float strokeWidth)
+    {
+        return DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(
+            pointCount,
+            points,
+            brush,
+            strokeWidth,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawPolylineWithColorAndStrokeWidth(
+        uint32_t pointCount,
+        Vector2* points,
+        Color color,
+        float strokeWidth)
+    {
+        return DrawPolylineWithColorAndStrokeWidthAndStrokeStyle(
+            pointCount,
+            points,
+            color,
+            strokeWidth,
+            nullptr);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(
+        uint32_t pointCount,
+        Vector2* points,
+        ICanvasBrush* brush,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawPolylineImpl(
+                    pointCount,
+                    points,
+                    ToD2DBrush(brush).Get(),
+                    strokeWidth,
+                    strokeStyle);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingSession::DrawPolylineWithColorAndStrokeWidthAndStrokeStyle(
+        uint32_t pointCount,
+        Vector2* points,
+        Color color,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                DrawPolylineImpl(
+                    pointCount,
+                    points,
+                    GetColorBrush(color),
+                    strokeWidth,
+                    strokeStyle);
+            });
+    }
+
+
+    //
+    // Polylines are only culled and simplified when drawing to a bitmap,
+    // where the transform and the size of the target are final. Command
+    // lists may be played back at any scale, so they get every point.
+    //
+    static bool TryGetPolylineTargetSpace(
+        ID2D1DeviceContext1* deviceContext,
+        float strokeWidth,
+        ID2D1StrokeStyle1* strokeStyle,
+        D2D1_MATRIX_3X2_F* transform,
+        D2D1_RECT_F* visibleRect,
+        float* tolerance)
+    {
+        if (!TryGetTargetBounds(deviceContext, visibleRect))
+            return false;
+
+        deviceContext->GetTransform(transform);
+
+        float dpiX, dpiY;
+        deviceContext->GetDpi(&dpiX, &dpiY);
+
+        // The tolerance is in pixels, the target bounds in DIPs.
+        auto dipsPerPixel = DEFAULT_DPI / std::max(dpiX, dpiY);
+
+        *tolerance = PolylineSimplifier::DefaultTolerance * dipsPerPixel;
+
+        // Segments just outside the target can still reach into it: by half
+        // the stroke width, a little more at square caps, and up to half the
+        // miter limit times the width at mitered joins.
+        auto lineJoin = strokeStyle ? strokeStyle->GetLineJoin() : D2D1_LINE_JOIN_MITER;
+        auto miterLimit = strokeStyle ? strokeStyle->GetMiterLimit() : 10.0f;
+
+        auto reach = 0.75f;
+        if (lineJoin == D2D1_LINE_JOIN_MITER || lineJoin == D2D1_LINE_JOIN_MITER_OR_BEVEL)
+            reach = std::max(reach, miterLimit / 2);
+
+        // Fixed and hairline strokes are not scaled by the transform, so
+        // the scale used here is never below one.
+        auto scale = sqrtf(std::max(1.0f, std::max(
+            transform->_11 * transform->_11 + transform->_12 * transform->_12,
+            transform->_21 * transform->_21 + transform->_22 * transform->_22)));
+
+        auto margin = fabsf(strokeWidth) * scale * reach + dipsPerPixel;
+
+        visibleRect->left -= margin;
+        visibleRect->top -= margin;
+        visibleRect->right += margin;
+        visibleRect->bottom += margin;
+
+        return true;
+    }
+
+
+    static void AddOpenFigure(ID2D1GeometrySink* sink, D2D1_POINT_2F const* points, uint32_t pointCount)
+    {
+        sink->BeginFigure(points[0], D2D1_FIGURE_BEGIN_HOLLOW);
+        sink->AddLines(points + 1, pointCount - 1);
+        sink->EndFigure(D2D1_FIGURE_END_OPEN);
+    }
+
+
+    void CanvasDrawingSession::DrawPolylineImpl(
+        uint32_t pointCount,
+        Vector2* points,
+        ID2D1Brush* brush,
+        float strokeWidth,
+        ICanvasStrokeStyle* strokeStyle)
+    {
+        auto& deviceContext = GetResource();
+        if (pointCount > 0)
+            CheckInPointer(points);
+        CheckInPointer(brush);
+
+        if (pointCount < 2)
+            return;
+
+        auto d2dPoints = ReinterpretAs<D2D1_POINT_2F*>(points);
+        auto d2dStrokeStyle = ToD2DStrokeStyle(strokeStyle);
+
+        // Dashes start again at every figure, so a dashed line is drawn
+        // whole to keep its pattern where it would be.
+        bool isDashed = d2dStrokeStyle && d2dStrokeStyle->GetDashStyle() != D2D1_DASH_STYLE_SOLID;
+
+        D2D1_MATRIX_3X2_F transform;
+        D2D1_RECT_F visibleRect;
+        float tolerance;
+
+        bool simplify = !isDashed && TryGetPolylineTargetSpace(
+            deviceContext.Get(),
+            strokeWidth,
+            d2dStrokeStyle.Get(),
+            &transform,
+            &visibleRect,
+            &tolerance);
+
+        if (simplify)
+        {
+            m_polylineSimplifier.Simplify(d2dPoints, pointCount, transform, visibleRect, tolerance);
+
+            // Nothing can be seen.
+            if (m_polylineSimplifier.GetRunLengths().empty())
+                return;
+        }
+
+        ComPtr<ID2D1PathGeometry> pathGeometry;
+        ThrowIfFailed(GetD2DFactory()->CreatePathGeometry(&pathGeometry));
+
+        ComPtr<ID2D1GeometrySink> sink;
+        ThrowIfFailed(pathGeometry->Open(&sink));
+
+        if (simplify)
+        {
+            auto runPoints = m_polylineSimplifier.GetPoints().data();
+
+            for (auto runLength : m_polylineSimplifier.GetRunLengths())
+            {
+                AddOpenFigure(sink.Get(), runPoints, runLength);
+                runPoints += runLength;
+            }
+        }
+        else
+        {
+            AddOpenFigure(sink.Get(), d2dPoints, pointCount);
+        }
+
+        ThrowIfFailed(sink->Close());
+
+        deviceContext->DrawGeometry(
+            pathGeometry.Get(),
+            brush,
+            strokeWidth,
+            d2dStrokeStyle.Get());
+
+        CountStroke(DrawingPrimitive::Polyline, brush, d2dStrokeStyle.Get());
+    }
+
+
     void CanvasDrawingSession::DrawTextAtRectImpl(
         HSTRING text,
         Rect const& rect,
@@ -1988,10 +2707,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         deviceContext->DrawText(
             textBuffer,
             textLength,
-            formatInternal->GetRealizedTextFormat().Get(),
+            formatInternal->GetInternedTextFormat().Get(),
             &d2dRect,
             brush,
             static_cast<D2D1_DRAW_TEXT_OPTIONS>(formatInternal->GetDrawTextOptions()));
+
+        CountDraw(DrawingPrimitive::Text, brush);
     }
 
 
@@ -2058,6 +2779,68 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    ComPtr<ID2D1StrokeStyle1> CanvasDrawingSession::ToD2DStrokeStyle(ICanvasStrokeStyle* strokeStyle)
+    {
+        if (!strokeStyle)
+            return nullptr;
+
+        ComPtr<ICanvasStrokeStyleInternal> internal;
+        ThrowIfFailed(strokeStyle->QueryInterface(internal.GetAddressOf()));
+
+        return internal->GetRealizedD2DStrokeStyle(GetD2DFactory());
+    }
+
+
+    ComPtr<ID2D1Geometry> CanvasDrawingSession::ToD2DGeometry(ICanvasGeometry* geometry)
+    {
+        ComPtr<ICanvasGeometryInternal> internal;
+        ThrowIfFailed(geometry->QueryInterface(internal.GetAddressOf()));
+
+        return internal->GetRealizedD2DGeometry(GetD2DFactory());
+    }
+
+
+    ID2D1Factory* CanvasDrawingSession::GetD2DFactory()
+    {
+        // A drawing session never changes device context, so its factory
+        // only needs to be looked up once.
+        if (!m_d2dFactory)
+            GetResource()->GetFactory(&m_d2dFactory);
+
+        return m_d2dFactory.Get();
+    }
+
+
+    void CanvasDrawingSession::RecordDraw(DrawingPrimitive primitive, ID2D1Brush* brush)
+    {
+        m_statistics->AddPrimitive(primitive);
+
+        // Color overloads all share m_solidColorBrush, so changing color does
+        // not count as a brush change. The docs for BrushChangeCount say so.
+        if (brush)
+        {
+            if (m_lastBrush && brush != m_lastBrush.Get())
+                m_statistics->AddBrushChange();
+
+            m_lastBrush = brush;
+        }
+    }
+
+
+    void CanvasDrawingSession::RecordStroke(DrawingPrimitive primitive, ID2D1Brush* brush, ID2D1StrokeStyle* strokeStyle)
+    {
+        RecordDraw(primitive, brush);
+
+        // Null is a valid stroke style, so track whether there has been a
+        // previous stroke separately.
+        if (m_hasStroked && strokeStyle != m_lastStrokeStyle.Get())
+            m_statistics->AddStrokeStyleChange();
+
+        m_lastStrokeStyle = strokeStyle;
+        m_hasStroked = true;
+    }
+
+
     ComPtr<ID2D1Brush> CanvasDrawingSession::ToD2DBrush(ICanvasBrush* brush)
     {
         if (!brush)
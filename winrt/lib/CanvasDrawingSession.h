@@ -14,6 +14,8 @@
 
 #include "ClosablePtr.h"
 #include "ErrorHandling.h"
+#include "DrawingStatistics.h"
+#include "PolylineSimplifier.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -32,6 +34,21 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     class CanvasDrawingSessionManager;
     class CanvasDrawingSession;
 
+    [uuid(3600ECC8-3BB8-40E4-A1C7-AC8B080A5632)]
+    class ICanvasDrawingSessionInternal : public IUnknown
+    {
+    public:
+        //
+        // Starts a closed drawing session drawing again, this time onto
+        // deviceContext, so that callers that draw every frame can keep one
+        // drawing session rather than allocating a new one each time.
+        //
+        virtual void Reopen(
+            ICanvasDevice* owner,
+            ID2D1DeviceContext1* deviceContext,
+            std::shared_ptr<ICanvasDrawingSessionAdapter> drawingSessionAdapter) = 0;
+    };
+
     struct CanvasDrawingSessionTraits
     {
         typedef ID2D1DeviceContext1 resource_t;
@@ -43,13 +60,27 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     class CanvasDrawingSession : RESOURCE_WRAPPER_RUNTIME_CLASS(
         CanvasDrawingSessionTraits,
         ICanvasResourceCreatorWithDpi,
-        ICanvasResourceCreator)
+        ICanvasResourceCreator,
+        CloakedIid<ICanvasDrawingSessionInternal>)
     {
         InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasDrawingSession, BaseTrust);
 
         std::shared_ptr<ICanvasDrawingSessionAdapter> m_adapter;
         ComPtr<ID2D1SolidColorBrush> m_solidColorBrush;
         ComPtr<ICanvasTextFormat> m_defaultTextFormat;
+        ComPtr<ID2D1Factory> m_d2dFactory;
+        PolylineSimplifier m_polylineSimplifier;
+
+        // Only set when the session was created while statistics were being
+        // collected. The last brush and stroke style are kept to spot
+        // changes. They are held by reference so that a new object can never
+        // turn up at the address of one that has been freed; D2D objects have
+        // no weak references, and these are released when the session closes.
+        std::shared_ptr<DrawingStatistics> m_statistics;
+        int64_t m_statisticsStartTime;
+        ComPtr<ID2D1Brush> m_lastBrush;
+        ComPtr<ID2D1StrokeStyle> m_lastStrokeStyle;
+        bool m_hasStroked;
 
         //
         // Contract:
@@ -73,6 +104,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         virtual ~CanvasDrawingSession();
 
+        // ICanvasDrawingSessionInternal
+
+        virtual void Reopen(
+            ICanvasDevice* owner,
+            ID2D1DeviceContext1* deviceContext,
+            std::shared_ptr<ICanvasDrawingSessionAdapter> drawingSessionAdapter) override;
+
         // IClosable
 
         IFACEMETHOD(Close)() override;
@@ -167,6 +205,22 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasImageInterpolation interpolation,
             ABI::Microsoft::Graphics::Canvas::Numerics::Matrix4x4 perspective) override;
 
+        IFACEMETHOD(DrawVirtualBitmapWithDestRect)(
+            ICanvasVirtualBitmap* virtualBitmap,
+            Rect destinationRect) override;
+
+        IFACEMETHOD(DrawVirtualBitmapWithDestRectAndSourceRect)(
+            ICanvasVirtualBitmap* virtualBitmap,
+            Rect destinationRect,
+            Rect sourceRect) override;
+
+        IFACEMETHOD(DrawVirtualBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation)(
+            ICanvasVirtualBitmap* virtualBitmap,
+            Rect destinationRect,
+            Rect sourceRect,
+            float opacity,
+            CanvasImageInterpolation interpolation) override;
+
         //
         // DrawLine
         //
@@ -840,6 +894,120 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ABI::Windows::UI::Color color,
             ICanvasTextFormat* format) override;
 
+        //
+        // DrawTextLayout
+        //
+
+        IFACEMETHOD(DrawTextLayoutWithBrush)(
+            ICanvasTextLayout* textLayout,
+            Vector2 point,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(DrawTextLayoutWithColor)(
+            ICanvasTextLayout* textLayout,
+            Vector2 point,
+            ABI::Windows::UI::Color color) override;
+
+        //
+        // FillGeometry
+        //
+
+        IFACEMETHOD(FillGeometryWithBrush)(
+            ICanvasGeometry* geometry,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(FillGeometryWithColor)(
+            ICanvasGeometry* geometry,
+            ABI::Windows::UI::Color color) override;
+
+        //
+        // DrawGeometry
+        //
+
+        IFACEMETHOD(DrawGeometryWithBrush)(
+            ICanvasGeometry* geometry,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(DrawGeometryWithColor)(
+            ICanvasGeometry* geometry,
+            ABI::Windows::UI::Color color) override;
+
+        IFACEMETHOD(DrawGeometryWithBrushAndStrokeWidth)(
+            ICanvasGeometry* geometry,
+            ICanvasBrush* brush,
+            float strokeWidth) override;
+
+        IFACEMETHOD(DrawGeometryWithColorAndStrokeWidth)(
+            ICanvasGeometry* geometry,
+            ABI::Windows::UI::Color color,
+            float strokeWidth) override;
+
+        IFACEMETHOD(DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle)(
+            ICanvasGeometry* geometry,
+            ICanvasBrush* brush,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle) override;
+
+        IFACEMETHOD(DrawGeometryWithColorAndStrokeWidthAndStrokeStyle)(
+            ICanvasGeometry* geometry,
+            ABI::Windows::UI::Color color,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle) override;
+
+        //
+        // DrawCachedGeometry
+        //
+
+        IFACEMETHOD(DrawCachedGeometryWithBrush)(
+            ICanvasCachedGeometry* cachedGeometry,
+            Vector2 offset,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(DrawCachedGeometryWithColor)(
+            ICanvasCachedGeometry* cachedGeometry,
+            Vector2 offset,
+            ABI::Windows::UI::Color color) override;
+
+        //
+        // DrawPolyline
+        //
+
+        IFACEMETHOD(DrawPolylineWithBrush)(
+            uint32_t pointCount,
+            Vector2* points,
+            ICanvasBrush* brush) override;
+
+        IFACEMETHOD(DrawPolylineWithColor)(
+            uint32_t pointCount,
+            Vector2* points,
+            ABI::Windows::UI::Color color) override;
+
+        IFACEMETHOD(DrawPolylineWithBrushAndStrokeWidth)(
+            uint32_t pointCount,
+            Vector2* points,
+            ICanvasBrush* brush,
+            float strokeWidth) override;
+
+        IFACEMETHOD(DrawPolylineWithColorAndStrokeWidth)(
+            uint32_t pointCount,
+            Vector2* points,
+            ABI::Windows::UI::Color color,
+            float strokeWidth) override;
+
+        IFACEMETHOD(DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle)(
+            uint32_t pointCount,
+            Vector2* points,
+            ICanvasBrush* brush,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle) override;
+
+        IFACEMETHOD(DrawPolylineWithColorAndStrokeWidthAndStrokeStyle)(
+            uint32_t pointCount,
+            Vector2* points,
+            ABI::Windows::UI::Color color,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle) override;
+
         //
         // State properties
         //
@@ -932,10 +1100,56 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ID2D1Brush* brush,
             ICanvasTextFormat* format);
 
+        void DrawTextLayoutImpl(
+            ICanvasTextLayout* textLayout,
+            Vector2 const& point,
+            ID2D1Brush* brush);
+
+        void FillGeometryImpl(
+            ICanvasGeometry* geometry,
+            ID2D1Brush* brush);
+
+        void DrawGeometryImpl(
+            ICanvasGeometry* geometry,
+            ID2D1Brush* brush,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle);
+
+        void DrawCachedGeometryImpl(
+            ICanvasCachedGeometry* cachedGeometry,
+            Vector2 const& offset,
+            ID2D1Brush* brush);
+
+        void DrawPolylineImpl(
+            uint32_t pointCount,
+            Vector2* points,
+            ID2D1Brush* brush,
+            float strokeWidth,
+            ICanvasStrokeStyle* strokeStyle);
+
         ICanvasTextFormat* GetDefaultTextFormat();
 
         ID2D1SolidColorBrush* GetColorBrush(ABI::Windows::UI::Color const& color);
         ComPtr<ID2D1Brush> ToD2DBrush(ICanvasBrush* brush);
+        ComPtr<ID2D1StrokeStyle1> ToD2DStrokeStyle(ICanvasStrokeStyle* strokeStyle);
+        ComPtr<ID2D1Geometry> ToD2DGeometry(ICanvasGeometry* geometry);
+        ID2D1Factory* GetD2DFactory();
+
+        void CountDraw(DrawingPrimitive primitive, ID2D1Brush* brush = nullptr)
+        {
+            if (m_statistics)
+                RecordDraw(primitive, brush);
+        }
+
+        void CountStroke(DrawingPrimitive primitive, ID2D1Brush* brush, ID2D1StrokeStyle* strokeStyle)
+        {
+            if (m_statistics)
+                RecordStroke(primitive, brush, strokeStyle);
+        }
+
+        void BeginStatistics();
+        void RecordDraw(DrawingPrimitive primitive, ID2D1Brush* brush);
+        void RecordStroke(DrawingPrimitive primitive, ID2D1Brush* brush, ID2D1StrokeStyle* strokeStyle);
 
         HRESULT DrawImageImpl(
             ICanvasImage* image,
@@ -951,6 +1165,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float opacity,
             CanvasImageInterpolation interpolation,
             ABI::Microsoft::Graphics::Canvas::Numerics::Matrix4x4* perspective);
+
+        HRESULT DrawVirtualBitmapImpl(
+            ICanvasVirtualBitmap* virtualBitmap,
+            Rect destinationRect,
+            Rect* sourceRect,
+            float opacity,
+            CanvasImageInterpolation interpolation);
     };
 
 
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include "pch.h"
+
+#include "CanvasDrawingStatistics.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    CanvasDrawingStatistics::CanvasDrawingStatistics(DrawingStatistics const& statistics)
+        : m_statistics(statistics)
+    {
+    }
+
+
+    template<typename T, typename U>
+    static HRESULT GetCount(U count, T* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                *value = static_cast<T>(count);
+            });
+    }
+
+
+    HRESULT CanvasDrawingStatistics::GetPrimitiveCount(DrawingPrimitive primitive, int32_t* value)
+    {
+        return GetCount(m_statistics.GetPrimitiveCount(primitive), value);
+    }
+
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_DrawingSessionCount(int32_t* value)
+    {
+        return GetCount(m_statistics.GetDrawingSessionCount(), value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_ClearCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Clear, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_LineCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Line, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_RectangleCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Rectangle, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_RoundedRectangleCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::RoundedRectangle, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_EllipseCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Ellipse, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_GeometryCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Geometry, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_PolylineCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Polyline, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_TextCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Text, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_ImageCount(int32_t* value)
+    {
+        return GetPrimitiveCount(DrawingPrimitive::Image, value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_BrushChangeCount(int32_t* value)
+    {
+        return GetCount(m_statistics.GetBrushChangeCount(), value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_StrokeStyleChangeCount(int32_t* value)
+    {
+        return GetCount(m_statistics.GetStrokeStyleChangeCount(), value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_EffectNodesRealizedCount(int32_t* value)
+    {
+        return GetCount(m_statistics.GetEffectNodesRealizedCount(), value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_PixelBytesUploaded(uint64_t* value)
+    {
+        return GetCount(m_statistics.GetPixelBytesUploaded(), value);
+    }
+
+    IFACEMETHODIMP CanvasDrawingStatistics::get_DrawTime(ABI::Windows::Foundation::TimeSpan* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                value->Duration = m_statistics.GetDrawTime();
+            });
+    }
+}}}}
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include "DrawingStatistics.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    //
+    // An immutable snapshot of DrawingStatistics, handed out once a frame is
+    // complete.
+    //
+    class CanvasDrawingStatistics : public RuntimeClass<ICanvasDrawingStatistics>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasDrawingStatistics, BaseTrust);
+
+        DrawingStatistics m_statistics;
+
+    public:
+        CanvasDrawingStatistics(DrawingStatistics const& statistics);
+
+        IFACEMETHOD(get_DrawingSessionCount)(int32_t* value) override;
+
+        IFACEMETHOD(get_ClearCount)(int32_t* value) override;
+        IFACEMETHOD(get_LineCount)(int32_t* value) override;
+        IFACEMETHOD(get_RectangleCount)(int32_t* value) override;
+        IFACEMETHOD(get_RoundedRectangleCount)(int32_t* value) override;
+        IFACEMETHOD(get_EllipseCount)(int32_t* value) override;
+        IFACEMETHOD(get_GeometryCount)(int32_t* value) override;
+        IFACEMETHOD(get_PolylineCount)(int32_t* value) override;
+        IFACEMETHOD(get_TextCount)(int32_t* value) override;
+        IFACEMETHOD(get_ImageCount)(int32_t* value) override;
+
+        IFACEMETHOD(get_BrushChangeCount)(int32_t* value) override;
+        IFACEMETHOD(get_StrokeStyleChangeCount)(int32_t* value) override;
+        IFACEMETHOD(get_EffectNodesRealizedCount)(int32_t* value) override;
+        IFACEMETHOD(get_PixelBytesUploaded)(uint64_t* value) override;
+
+        IFACEMETHOD(get_DrawTime)(ABI::Windows::Foundation::TimeSpan* value) override;
+
+    private:
+        HRESULT GetPrimitiveCount(DrawingPrimitive primitive, int32_t* value);
+    };
+}}}}
@@ -0,0 +1,414 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "CanvasGeometry.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    ComPtr<ID2D1PathGeometry> CreateD2DPathGeometry(ID2D1Factory* d2dFactory, PathData const& pathData)
+    {
+        ComPtr<ID2D1PathGeometry> pathGeometry;
+        ThrowIfFailed(d2dFactory->CreatePathGeometry(&pathGeometry));
+
+        ComPtr<ID2D1GeometrySink> sink;
+        ThrowIfFailed(pathGeometry->Open(&sink));
+
+        pathData.StreamTo(sink.Get());
+
+        ThrowIfFailed(sink->Close());
+
+        return pathGeometry;
+    }
+
+
+    //
+    // GeometryOperations
+    //
+
+    GeometryOperations::GeometryOperations()
+    {
+        ThrowIfFailed(D2D1CreateFactory(
+            D2D1_FACTORY_TYPE_MULTI_THREADED,
+            __uuidof(ID2D1Factory),
+            nullptr,
+            &m_d2dFactory));
+    }
+
+
+    PathData GeometryOperations::Combine(
+        PathData const& pathData,
+        PathData const& otherPathData,
+        D2D1_MATRIX_3X2_F const& otherTransform,
+        D2D1_COMBINE_MODE combineMode)
+    {
+        auto geometry = CreateD2DPathGeometry(m_d2dFactory.Get(), pathData);
+        auto otherGeometry = CreateD2DPathGeometry(m_d2dFactory.Get(), otherPathData);
+
+        auto sink = Make<PathDataSink>();
+        CheckMakeResult(sink);
+
+        ThrowIfFailed(geometry->CombineWithGeometry(
+            otherGeometry.Get(),
+            combineMode,
+            &otherTransform,
+            D2D1_DEFAULT_FLATTENING_TOLERANCE,
+            sink.Get()));
+
+        ThrowIfFailed(sink->Close());
+
+        return sink->GetPathData();
+    }
+
+
+    std::shared_ptr<GeometryOperations> PerApplicationGeometryOperations::CreateManager()
+    {
+        return std::make_shared<GeometryOperations>();
+    }
+
+
+    //
+    // CanvasPathBuilderFactory
+    //
+
+    IFACEMETHODIMP CanvasPathBuilderFactory::ActivateInstance(IInspectable** object)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(object);
+
+                auto pathBuilder = Make<CanvasPathBuilder>();
+                CheckMakeResult(pathBuilder);
+
+                ThrowIfFailed(pathBuilder.CopyTo(object));
+            });
+    }
+
+
+    //
+    // CanvasPathBuilder
+    //
+
+    CanvasPathBuilder::CanvasPathBuilder()
+        : m_closed(false)
+    {
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::BeginFigure(Numerics::Vector2 startPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                m_pathBuilder.BeginFigure(ToD2DPoint(startPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::AddLine(Numerics::Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                m_pathBuilder.AddLine(ToD2DPoint(endPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::AddQuadraticBezier(
+        Numerics::Vector2 controlPoint,
+        Numerics::Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                m_pathBuilder.AddQuadraticBezier(ToD2DPoint(controlPoint), ToD2DPoint(endPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::AddCubicBezier(
+        Numerics::Vector2 controlPoint1,
+        Numerics::Vector2 controlPoint2,
+        Numerics::Vector2 endPoint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                m_pathBuilder.AddCubicBezier(ToD2DPoint(controlPoint1), ToD2DPoint(controlPoint2), ToD2DPoint(endPoint));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::EndFigure(CanvasFigureLoop figureLoop)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                m_pathBuilder.EndFigure(figureLoop == CanvasFigureLoop::Closed);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::SetFilledRegionDetermination(CanvasFilledRegionDetermination filledRegionDetermination)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                m_pathBuilder.SetFillMode(static_cast<D2D1_FILL_MODE>(filledRegionDetermination));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasPathBuilder::Close()
+    {
+        m_closed = true;
+        m_pathBuilder = PathBuilder();
+        return S_OK;
+    }
+
+
+    PathData CanvasPathBuilder::ClosePath()
+    {
+        ThrowIfClosed();
+
+        auto pathData = m_pathBuilder.TakePathData();
+        m_closed = true;
+
+        return pathData;
+    }
+
+
+    void CanvasPathBuilder::ThrowIfClosed()
+    {
+        if (m_closed)
+            ThrowHR(RO_E_CLOSED);
+    }
+
+
+    //
+    // CanvasGeometryFactory
+    //
+
+    static void MakeGeometry(PathData const& pathData, ICanvasGeometry** geometry)
+    {
+        auto newGeometry = Make<CanvasGeometry>(pathData);
+        CheckMakeResult(newGeometry);
+
+        ThrowIfFailed(newGeometry.CopyTo(geometry));
+    }
+
+
+    IFACEMETHODIMP CanvasGeometryFactory::CreateRectangle(
+        ABI::Windows::Foundation::Rect rect,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(geometry);
+                MakeGeometry(PathData::CreateRectangle(ToD2DRect(rect)), geometry);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometryFactory::CreateRoundedRectangle(
+        ABI::Windows::Foundation::Rect rect,
+        float radiusX,
+        float radiusY,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(geometry);
+                MakeGeometry(PathData::CreateRoundedRectangle(ToD2DRect(rect), radiusX, radiusY), geometry);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometryFactory::CreateEllipse(
+        Numerics::Vector2 centerPoint,
+        float radiusX,
+        float radiusY,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(geometry);
+                MakeGeometry(PathData::CreateEllipse(ToD2DPoint(centerPoint), radiusX, radiusY), geometry);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometryFactory::CreatePolygon(
+        uint32_t pointCount,
+        Numerics::Vector2* points,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                if (pointCount > 0)
+                    CheckInPointer(points);
+                CheckAndClearOutPointer(geometry);
+
+                MakeGeometry(PathData::CreatePolygon(ReinterpretAs<D2D1_POINT_2F*>(points), pointCount), geometry);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometryFactory::CreatePath(
+        ICanvasPathBuilder* pathBuilder,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(pathBuilder);
+                CheckAndClearOutPointer(geometry);
+
+                auto pathData = As<ICanvasPathBuilderInternal>(pathBuilder)->ClosePath();
+
+                MakeGeometry(pathData, geometry);
+            });
+    }
+
+
+    //
+    // CanvasGeometry
+    //
+
+    CanvasGeometry::CanvasGeometry(PathData const& pathData)
+        : m_closed(false)
+        , m_pathData(pathData)
+        , m_realizedFactory(nullptr)
+    {
+    }
+
+
+    IFACEMETHODIMP CanvasGeometry::CombineWith(
+        ICanvasGeometry* otherGeometry,
+        Numerics::Matrix3x2 otherGeometryTransform,
+        CanvasGeometryCombine combine,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                CheckInPointer(otherGeometry);
+                CheckAndClearOutPointer(geometry);
+
+                auto& otherPathData = As<ICanvasGeometryInternal>(otherGeometry)->GetPathData();
+
+                auto operations = PerApplicationGeometryOperations::GetOrCreateManager();
+
+                auto combined = operations->Combine(
+                    m_pathData,
+                    otherPathData,
+                    *(ReinterpretAs<D2D1_MATRIX_3X2_F*>(&otherGeometryTransform)),
+                    static_cast<D2D1_COMBINE_MODE>(combine));
+
+                MakeGeometry(combined, geometry);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometry::Transform(
+        Numerics::Matrix3x2 transform,
+        ICanvasGeometry** geometry)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                CheckAndClearOutPointer(geometry);
+
+                MakeGeometry(m_pathData.Transform(*(ReinterpretAs<D2D1_MATRIX_3X2_F*>(&transform))), geometry);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometry::ComputeBounds(
+        ABI::Windows::Foundation::Rect* bounds)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                CheckInPointer(bounds);
+
+                if (m_pathData.IsEmpty())
+                    *bounds = ABI::Windows::Foundation::Rect{ 0, 0, 0, 0 };
+                else
+                    *bounds = FromD2DRect(m_pathData.ComputeBounds());
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasGeometry::Close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_closed = true;
+        m_pathData = PathData();
+        m_realizedFactory = nullptr;
+        m_realizedGeometry.Reset();
+
+        return S_OK;
+    }
+
+
+    PathData const& CanvasGeometry::GetPathData()
+    {
+        ThrowIfClosed();
+
+        return m_pathData;
+    }
+
+
+    ComPtr<ID2D1Geometry> CanvasGeometry::GetRealizedD2DGeometry(ID2D1Factory* d2dFactory)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        ThrowIfClosed();
+
+        if (d2dFactory != m_realizedFactory || !m_realizedGeometry)
+        {
+            m_realizedGeometry = CreateD2DPathGeometry(d2dFactory, m_pathData);
+            m_realizedFactory = d2dFactory;
+        }
+
+        return m_realizedGeometry;
+    }
+
+
+    void CanvasGeometry::ThrowIfClosed()
+    {
+        if (m_closed)
+            ThrowHR(RO_E_CLOSED);
+    }
+
+
+    ActivatableClassWithFactory(CanvasPathBuilder, CanvasPathBuilderFactory);
+    ActivatableStaticOnlyFactory(CanvasGeometryFactory);
+}}}}
@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "PathData.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    [uuid(3E7A5C91-2D48-4B06-9F1C-8A64E2D05B73)]
+    class ICanvasPathBuilderInternal : public IUnknown
+    {
+    public:
+        // Hands over the figures and closes the path builder.
+        virtual PathData ClosePath() = 0;
+    };
+
+    [uuid(B5D2096E-47A1-4C3F-8E60-1F9B3C7A2D48)]
+    class ICanvasGeometryInternal : public IUnknown
+    {
+    public:
+        virtual PathData const& GetPathData() = 0;
+
+        // This realizes the geometry if necessary.
+        virtual ComPtr<ID2D1Geometry> GetRealizedD2DGeometry(ID2D1Factory* d2dFactory) = 0;
+    };
+
+
+    ComPtr<ID2D1PathGeometry> CreateD2DPathGeometry(ID2D1Factory* d2dFactory, PathData const& pathData);
+
+
+    //
+    // Geometry operations that D2D implements, such as combining, need a D2D
+    // factory even though geometries do not belong to a device. This holds
+    // one for the whole application.
+    //
+    class GeometryOperations
+    {
+        ComPtr<ID2D1Factory> m_d2dFactory;
+
+    public:
+        GeometryOperations();
+
+        PathData Combine(
+            PathData const& pathData,
+            PathData const& otherPathData,
+            D2D1_MATRIX_3X2_F const& otherTransform,
+            D2D1_COMBINE_MODE combineMode);
+    };
+
+
+    class PerApplicationGeometryOperations : public PerApplicationManager<PerApplicationGeometryOperations, GeometryOperations>
+    {
+    public:
+        // Called by PerApplicationManager
+        static std::shared_ptr<GeometryOperations> CreateManager();
+    };
+
+
+    class CanvasPathBuilderFactory : public ActivationFactory<>
+    {
+        InspectableClassStatic(RuntimeClass_Microsoft_Graphics_Canvas_CanvasPathBuilder, BaseTrust);
+
+    public:
+        //
+        // ActivationFactory
+        //
+
+        IFACEMETHOD(ActivateInstance)(IInspectable** object) override;
+    };
+
+
+    class CanvasPathBuilder : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasPathBuilder,
+        ABI::Windows::Foundation::IClosable,
+        CloakedIid<ICanvasPathBuilderInternal>>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasPathBuilder, BaseTrust);
+
+        bool m_closed;
+        PathBuilder m_pathBuilder;
+
+    public:
+        CanvasPathBuilder();
+
+        //
+        // ICanvasPathBuilder
+        //
+
+        IFACEMETHOD(BeginFigure)(Numerics::Vector2 startPoint) override;
+
+        IFACEMETHOD(AddLine)(Numerics::Vector2 endPoint) override;
+
+        IFACEMETHOD(AddQuadraticBezier)(
+            Numerics::Vector2 controlPoint,
+            Numerics::Vector2 endPoint) override;
+
+        IFACEMETHOD(AddCubicBezier)(
+            Numerics::Vector2 controlPoint1,
+            Numerics::Vector2 controlPoint2,
+            Numerics::Vector2 endPoint) override;
+
+        IFACEMETHOD(EndFigure)(CanvasFigureLoop figureLoop) override;
+
+        IFACEMETHOD(SetFilledRegionDetermination)(CanvasFilledRegionDetermination filledRegionDetermination) override;
+
+        //
+        // IClosable
+        //
+
+        IFACEMETHOD(Close)() override;
+
+        //
+        // ICanvasPathBuilderInternal
+        //
+
+        virtual PathData ClosePath() override;
+
+    private:
+        void ThrowIfClosed();
+    };
+
+
+    class CanvasGeometryFactory : public ActivationFactory<ICanvasGeometryStatics>
+    {
+        InspectableClassStatic(RuntimeClass_Microsoft_Graphics_Canvas_CanvasGeometry, BaseTrust);
+
+    public:
+        //
+        // ICanvasGeometryStatics
+        //
+
+        IFACEMETHOD(CreateRectangle)(
+            ABI::Windows::Foundation::Rect rect,
+            ICanvasGeometry** geometry) override;
+
+        IFACEMETHOD(CreateRoundedRectangle)(
+            ABI::Windows::Foundation::Rect rect,
+            float radiusX,
+            float radiusY,
+            ICanvasGeometry** geometry) override;
+
+        IFACEMETHOD(CreateEllipse)(
+            Numerics::Vector2 centerPoint,
+            float radiusX,
+            float radiusY,
+            ICanvasGeometry** geometry) override;
+
+        IFACEMETHOD(CreatePolygon)(
+            uint32_t pointCount,
+            Numerics::Vector2* points,
+            ICanvasGeometry** geometry) override;
+
+        IFACEMETHOD(CreatePath)(
+            ICanvasPathBuilder* pathBuilder,
+            ICanvasGeometry** geometry) override;
+    };
+
+
+    //
+    // The figures are kept on the CPU as PathData, so geometries can be
+    // created, combined and transformed without a device. They are only
+    // turned into a D2D geometry when drawn, once for each D2D factory they
+    // are drawn with, in the same way as CanvasStrokeStyle.
+    //
+    class CanvasGeometry : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasGeometry,
+        ABI::Windows::Foundation::IClosable,
+        CloakedIid<ICanvasGeometryInternal>>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasGeometry, BaseTrust);
+
+        bool m_closed;
+        PathData m_pathData;
+
+        // The factory exactly as it was passed to GetRealizedD2DGeometry.
+        // Kept alive by the realized geometry.
+        std::mutex m_mutex;
+        ID2D1Factory* m_realizedFactory;
+        ComPtr<ID2D1Geometry> m_realizedGeometry;
+
+    public:
+        CanvasGeometry(PathData const& pathData);
+
+        //
+        // ICanvasGeometry
+        //
+
+        IFACEMETHOD(CombineWith)(
+            ICanvasGeometry* otherGeometry,
+            Numerics::Matrix3x2 otherGeometryTransform,
+            CanvasGeometryCombine combine,
+            ICanvasGeometry** geometry) override;
+
+        IFACEMETHOD(Transform)(
+            Numerics::Matrix3x2 transform,
+            ICanvasGeometry** geometry) override;
+
+        IFACEMETHOD(ComputeBounds)(
+            ABI::Windows::Foundation::Rect* bounds) override;
+
+        //
+        // IClosable
+        //
+
+        IFACEMETHOD(Close)() override;
+
+        //
+        // ICanvasGeometryInternal
+        //
+
+        virtual PathData const& GetPathData() override;
+
+        virtual ComPtr<ID2D1Geometry> GetRealizedD2DGeometry(ID2D1Factory* d2dFactory) override;
+
+    private:
+        void ThrowIfClosed();
+    };
+}}}}
@@ -46,6 +46,40 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             std::move(adapter));
     }
 
+    bool CanvasImageSourceDrawingSessionFactory::TryReopen(
+        ICanvasDrawingSession* closedDrawingSession,
+        ICanvasDevice* owner,
+        ISurfaceImageSourceNativeWithD2D* sisNative,
+        Color const& clearColor,
+        RECT const& updateRectangle,
+        float dpi) const
+    {
+        CheckInPointer(closedDrawingSession);
+        CheckInPointer(sisNative);
+
+        // Only our own drawing sessions can be reopened.  This is checked
+        // before BeginDraw, so that refusing leaves the image source as it was.
+        auto drawingSessionInternal = MaybeAs<ICanvasDrawingSessionInternal>(closedDrawingSession);
+
+        if (!drawingSessionInternal)
+            return false;
+
+        ComPtr<ID2D1DeviceContext1> deviceContext;
+        auto adapter = CanvasImageSourceDrawingSessionAdapter::Create(
+            sisNative,
+            ToD2DColor(clearColor),
+            updateRectangle,
+            dpi,
+            &deviceContext);
+
+        drawingSessionInternal->Reopen(
+            owner,
+            deviceContext.Get(),
+            std::move(adapter));
+
+        return true;
+    }
+
     //
     // CanvasImageSourceFactory implementation
     //
@@ -229,6 +263,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
     
 
+    static RECT DipsRectToPixels(Rect const& rect, float dpi)
+    {
+        RECT rectInPixels =
+        {
+            DipsToPixels(rect.X, dpi),
+            DipsToPixels(rect.Y, dpi),
+            DipsToPixels(rect.X + rect.Width, dpi),
+            DipsToPixels(rect.Y + rect.Height, dpi),
+        };
+
+        return rectInPixels;
+    }
+
+
     _Use_decl_annotations_
     IFACEMETHODIMP CanvasImageSource::CreateDrawingSession(
         Color clearColor,
@@ -255,19 +303,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ComPtr<ISurfaceImageSourceNativeWithD2D> sisNative;
                 ThrowIfFailed(GetComposableBase().As(&sisNative));
 
-                RECT rectInPixels =
-                {
-                    DipsToPixels(updateRectangle.X, m_dpi),
-                    DipsToPixels(updateRectangle.Y, m_dpi),
-                    DipsToPixels(updateRectangle.X + updateRectangle.Width, m_dpi),
-                    DipsToPixels(updateRectangle.Y + updateRectangle.Height, m_dpi),
-                };
-
                 auto ds = m_drawingSessionFactory->Create(
                     m_device.Get(),
                     sisNative.Get(),
                     clearColor,
-                    rectInPixels,
+                    DipsRectToPixels(updateRectangle, m_dpi),
                     m_dpi);
             
                 ThrowIfFailed(ds.CopyTo(drawingSession));
@@ -275,6 +315,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    bool CanvasImageSource::TryReopenDrawingSession(
+        ICanvasDrawingSession* closedDrawingSession,
+        Color const& clearColor)
+    {
+        ComPtr<ISurfaceImageSourceNativeWithD2D> sisNative;
+        ThrowIfFailed(GetComposableBase().As(&sisNative));
+
+        Rect updateRectangle{ 0, 0, m_width, m_height };
+
+        return m_drawingSessionFactory->TryReopen(
+            closedDrawingSession,
+            m_device.Get(),
+            sisNative.Get(),
+            clearColor,
+            DipsRectToPixels(updateRectangle, m_dpi),
+            m_dpi);
+    }
+
+
     _Use_decl_annotations_
     IFACEMETHODIMP CanvasImageSource::get_Device(
         ICanvasDevice** value) 
@@ -27,6 +27,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             Color const& clearColor,
             RECT const& updateRectangle,
             float dpi) const = 0;
+
+        //
+        // Like Create, but starts drawing with a closed drawing session that
+        // Create returned earlier rather than allocating a new one.  Returns
+        // false if the drawing session can't be reused, in which case the
+        // caller should use Create instead.
+        //
+        virtual bool TryReopen(
+            ICanvasDrawingSession* closedDrawingSession,
+            ICanvasDevice* owner,
+            ISurfaceImageSourceNativeWithD2D* sisNative,
+            Color const& clearColor,
+            RECT const& updateRectangle,
+            float dpi) const = 0;
     };
 
 
@@ -120,6 +134,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         IFACEMETHOD(get_Background)(
             _Out_ CanvasBackground* value) override;
 
+        //
+        // Used by CanvasControl to draw each frame with the drawing session it
+        // closed at the end of the previous frame.  Returns false if that
+        // isn't possible, in which case CreateDrawingSession should be used.
+        //
+        bool TryReopenDrawingSession(
+            ICanvasDrawingSession* closedDrawingSession,
+            Color const& clearColor);
+
     private:
         void CreateBaseClass(
             ISurfaceImageSourceFactory* surfaceImageSourceFactory,
@@ -148,5 +171,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             Color const& clearColor,
             RECT const& updateRectangle,
             float dpi) const override;
+
+        virtual bool TryReopen(
+            ICanvasDrawingSession* closedDrawingSession,
+            ICanvasDevice* owner,
+            ISurfaceImageSourceNativeWithD2D* sisNative,
+            Color const& clearColor,
+            RECT const& updateRectangle,
+            float dpi) const override;
     };
 }}}}
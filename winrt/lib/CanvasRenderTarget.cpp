@@ -47,6 +47,53 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    ComPtr<CanvasRenderTarget> CanvasRenderTargetManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        ID2D1Bitmap1* d2dBitmap,
+        CanvasRenderTargetPoolKey const& poolKey)
+    {
+        auto renderTarget = Make<CanvasRenderTarget>(
+            shared_from_this(),
+            d2dBitmap,
+            canvasDevice,
+            &poolKey);
+        CheckMakeResult(renderTarget);
+
+        return renderTarget;
+    }
+
+
+    ComPtr<CanvasRenderTarget> CanvasRenderTargetManager::CreatePooled(
+        ICanvasDevice* canvasDevice,
+        float width,
+        float height,
+        DirectXPixelFormat format,
+        CanvasAlphaMode alpha,
+        float dpi)
+    {
+        CanvasRenderTargetPoolKey poolKey = 
+        {
+            static_cast<uint32_t>(std::max(0, DipsToPixels(width, dpi))),
+            static_cast<uint32_t>(std::max(0, DipsToPixels(height, dpi))),
+            format,
+            alpha,
+            dpi
+        };
+
+        auto d2dBitmap = m_pool.TryAcquire(canvasDevice, poolKey);
+
+        if (!d2dBitmap)
+        {
+            ComPtr<ICanvasDeviceInternal> canvasDeviceInternal;
+            ThrowIfFailed(canvasDevice->QueryInterface(canvasDeviceInternal.GetAddressOf()));
+
+            d2dBitmap = canvasDeviceInternal->CreateRenderTargetBitmap(width, height, format, alpha, dpi);
+        }
+
+        return Create(canvasDevice, d2dBitmap.Get(), poolKey);
+    }
+
+
     ComPtr<CanvasRenderTarget> CanvasRenderTargetManager::CreateWrapper(
         ICanvasDevice* device,
         ID2D1Bitmap1* d2dBitmap)
@@ -65,6 +112,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return m_adapter.get();
     }
 
+    CanvasRenderTargetPool& CanvasRenderTargetManager::GetPool()
+    {
+        return m_pool;
+    }
+
 
     //
     // CanvasRenderTargetFactory
@@ -243,6 +295,131 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    IFACEMETHODIMP CanvasRenderTargetFactory::CreatePooled(
+        ICanvasResourceCreatorWithDpi* resourceCreator,
+        float width,
+        float height,
+        ICanvasRenderTarget** renderTarget)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckAndClearOutPointer(renderTarget);
+
+                float dpi;
+                ThrowIfFailed(resourceCreator->get_Dpi(&dpi));
+
+                ThrowIfFailed(CreatePooledWithFormatAndAlphaAndDpi(
+                    As<ICanvasResourceCreator>(resourceCreator).Get(),
+                    width,
+                    height,
+                    DirectXPixelFormat::B8G8R8A8UIntNormalized,
+                    CanvasAlphaMode::Premultiplied,
+                    dpi,
+                    renderTarget));
+            });
+    }
+
+    IFACEMETHODIMP CanvasRenderTargetFactory::CreatePooledWithFormatAndAlphaAndDpi(
+        ICanvasResourceCreator* resourceCreator,
+        float width,
+        float height,
+        DirectXPixelFormat format,
+        CanvasAlphaMode alpha,
+        float dpi,
+        ICanvasRenderTarget** renderTarget)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckAndClearOutPointer(renderTarget);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                auto newRenderTarget = GetManager()->CreatePooledRenderTarget(
+                    canvasDevice.Get(),
+                    width,
+                    height,
+                    format,
+                    alpha,
+                    dpi);
+
+                ThrowIfFailed(newRenderTarget.CopyTo(renderTarget));
+            });
+    }
+
+    IFACEMETHODIMP CanvasRenderTargetFactory::EndPoolFrame(
+        ICanvasResourceCreator* resourceCreator)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                GetManager()->GetRenderTargetPool().EndFrame(canvasDevice.Get());
+            });
+    }
+
+    IFACEMETHODIMP CanvasRenderTargetFactory::TrimPool(
+        ICanvasResourceCreator* resourceCreator)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                GetManager()->GetRenderTargetPool().Trim(canvasDevice.Get());
+            });
+    }
+
+    IFACEMETHODIMP CanvasRenderTargetFactory::GetPooledBytes(
+        ICanvasResourceCreator* resourceCreator,
+        UINT64* bytes)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(bytes);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                *bytes = GetManager()->GetRenderTargetPool().GetPooledBytes(canvasDevice.Get());
+            });
+    }
+
+    IFACEMETHODIMP CanvasRenderTargetFactory::get_PoolIdleFrameLimit(
+        UINT32* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+
+                *value = GetManager()->GetRenderTargetPool().GetIdleFrameLimit();
+            });
+    }
+
+    IFACEMETHODIMP CanvasRenderTargetFactory::put_PoolIdleFrameLimit(
+        UINT32 value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetManager()->GetRenderTargetPool().SetIdleFrameLimit(value);
+            });
+    }
+
 
     static ComPtr<ICanvasDrawingSession> CreateDrawingSessionOverD2DBitmap(
         ICanvasDevice* owner,
@@ -282,11 +459,45 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     CanvasRenderTarget::CanvasRenderTarget(
         std::shared_ptr<CanvasRenderTargetManager> manager,
         ID2D1Bitmap1* d2dBitmap,
-        ICanvasDevice* canvasDevice)
+        ICanvasDevice* canvasDevice,
+        CanvasRenderTargetPoolKey const* poolKey)
         : CanvasBitmapImpl(manager, d2dBitmap, canvasDevice)
     {
         assert(IsRenderTargetBitmap(d2dBitmap) 
             && "CanvasRenderTarget should never be constructed with a non-target bitmap.  This should have been validated before construction.");
+
+        if (poolKey)
+            m_poolKey = std::make_unique<CanvasRenderTargetPoolKey>(*poolKey);
+    }
+
+
+    CanvasRenderTarget::~CanvasRenderTarget()
+    {
+        // Pooled render targets that are released without being closed still
+        // hand their bitmap back.  ResourceWrapper's destructor would only
+        // call its own Close.
+        Close();
+    }
+
+
+    IFACEMETHODIMP CanvasRenderTarget::Close()
+    {
+        if (!m_poolKey)
+            return CanvasBitmapImpl::Close();
+
+        return ExceptionBoundary(
+            [&]
+            {
+                auto poolKey = std::move(m_poolKey);
+                ComPtr<ID2D1Bitmap1> d2dBitmap = GetResource();
+                auto device = m_device;
+
+                // The bitmap must stop being tracked against this wrapper
+                // before someone else can take it from the pool.
+                ThrowIfFailed(CanvasBitmapImpl::Close());
+
+                Manager()->GetPool().Return(device.Get(), *poolKey, d2dBitmap.Get());
+            });
     }
 
 
@@ -300,6 +511,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 
                 auto& resource = GetD2DBitmap();
 
+                // Mip levels would no longer match what is about to be drawn.
+                SetMipLevels(std::vector<ComPtr<ID2D1Bitmap1>>());
+
                 auto newDrawingSession = CreateDrawingSessionOverD2DBitmap(
                     m_device.Get(),
                     resource.Get());
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "CanvasBitmap.h"
+#include "CanvasRenderTargetPool.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -84,6 +85,37 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasAlphaMode alpha,
             float dpi,
             ICanvasRenderTarget** canvasRenderTarget) override;
+
+        IFACEMETHOD(CreatePooled)(
+            ICanvasResourceCreatorWithDpi* resourceCreator,
+            float width,
+            float height,
+            ICanvasRenderTarget** renderTarget) override;
+
+        IFACEMETHOD(CreatePooledWithFormatAndAlphaAndDpi)(
+            ICanvasResourceCreator* resourceCreator,
+            float width,
+            float height,
+            DirectXPixelFormat format,
+            CanvasAlphaMode alpha,
+            float dpi,
+            ICanvasRenderTarget** renderTarget) override;
+
+        IFACEMETHOD(EndPoolFrame)(
+            ICanvasResourceCreator* resourceCreator) override;
+
+        IFACEMETHOD(TrimPool)(
+            ICanvasResourceCreator* resourceCreator) override;
+
+        IFACEMETHOD(GetPooledBytes)(
+            ICanvasResourceCreator* resourceCreator,
+            UINT64* bytes) override;
+
+        IFACEMETHOD(get_PoolIdleFrameLimit)(
+            UINT32* value) override;
+
+        IFACEMETHOD(put_PoolIdleFrameLimit)(
+            UINT32 value) override;
     };
 
 
@@ -104,20 +136,29 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     {
         InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasRenderTarget, BaseTrust);
 
+        // Set when the bitmap came from, and should go back to, the pool.
+        std::unique_ptr<CanvasRenderTargetPoolKey> m_poolKey;
+
     public:
         CanvasRenderTarget(
             std::shared_ptr<CanvasRenderTargetManager> manager,
             ID2D1Bitmap1* bitmap,
-            ICanvasDevice* device);
+            ICanvasDevice* device,
+            CanvasRenderTargetPoolKey const* poolKey = nullptr);
+
+        virtual ~CanvasRenderTarget();
 
         IFACEMETHOD(CreateDrawingSession)(
             _COM_Outptr_ ICanvasDrawingSession** drawingSession) override;
+
+        IFACEMETHOD(Close)() override;
     };
 
 
     class CanvasRenderTargetManager : public ResourceManager<CanvasRenderTargetTraits>
     {
         std::shared_ptr<ICanvasBitmapResourceCreationAdapter> m_adapter;
+        CanvasRenderTargetPool m_pool;
 
     public:
         CanvasRenderTargetManager(std::shared_ptr<ICanvasBitmapResourceCreationAdapter> adapter);
@@ -130,10 +171,26 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasAlphaMode alpha,
             float dpi);
 
+        ComPtr<CanvasRenderTarget> CreateNew(
+            ICanvasDevice* canvasDevice,
+            ID2D1Bitmap1* bitmap,
+            CanvasRenderTargetPoolKey const& poolKey);
+
+        // Reuses a bitmap from the pool if there is one of the right size.
+        ComPtr<CanvasRenderTarget> CreatePooled(
+            ICanvasDevice* canvasDevice,
+            float width,
+            float height,
+            DirectXPixelFormat format,
+            CanvasAlphaMode alpha,
+            float dpi);
+
         ComPtr<CanvasRenderTarget> CreateWrapper(
             ICanvasDevice* device,
             ID2D1Bitmap1* bitmap);
 
         ICanvasBitmapResourceCreationAdapter* GetAdapter();
+
+        CanvasRenderTargetPool& GetPool();
     };
 }}}}
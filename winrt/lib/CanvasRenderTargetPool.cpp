@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "CanvasRenderTargetPool.h"
+#include "TextureUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    bool CanvasRenderTargetPoolKey::operator<(CanvasRenderTargetPoolKey const& other) const
+    {
+        if (PixelWidth != other.PixelWidth)
+            return PixelWidth < other.PixelWidth;
+
+        if (PixelHeight != other.PixelHeight)
+            return PixelHeight < other.PixelHeight;
+
+        if (Format != other.Format)
+            return Format < other.Format;
+
+        if (Alpha != other.Alpha)
+            return Alpha < other.Alpha;
+
+        return Dpi < other.Dpi;
+    }
+
+
+    CanvasRenderTargetPool::CanvasRenderTargetPool()
+        : m_idleFrameLimit(DefaultIdleFrameLimit)
+    {
+    }
+
+
+    ComPtr<ID2D1Bitmap1> CanvasRenderTargetPool::TryAcquire(ICanvasDevice* device, CanvasRenderTargetPoolKey const& key)
+    {
+        auto deviceIdentity = GetIdentity(device);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        PruneDeadDevices();
+
+        auto devicePool = TryGetDevicePool(deviceIdentity.Get());
+
+        if (!devicePool)
+            return nullptr;
+
+        auto bucket = devicePool->Buckets.find(key);
+
+        if (bucket == devicePool->Buckets.end() || bucket->second.empty())
+            return nullptr;
+
+        // Take the most recently returned bitmap, leaving the older ones to age out.
+        auto bitmap = bucket->second.back().Bitmap;
+        bucket->second.pop_back();
+
+        devicePool->PooledBytes -= GetBytes(key);
+
+        return bitmap;
+    }
+
+
+    void CanvasRenderTargetPool::Return(ICanvasDevice* device, CanvasRenderTargetPoolKey const& key, ID2D1Bitmap1* bitmap)
+    {
+        auto deviceIdentity = GetIdentity(device);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        PruneDeadDevices();
+
+        auto devicePool = TryGetDevicePool(deviceIdentity.Get());
+
+        if (!devicePool)
+        {
+            devicePool = &m_devicePools[deviceIdentity.Get()];
+            ThrowIfFailed(AsWeak(device, &devicePool->Device));
+        }
+
+        IdleBitmap idleBitmap = { bitmap, devicePool->CurrentFrame };
+        devicePool->Buckets[key].push_back(idleBitmap);
+
+        devicePool->PooledBytes += GetBytes(key);
+    }
+
+
+    void CanvasRenderTargetPool::EndFrame(ICanvasDevice* device)
+    {
+        auto deviceIdentity = GetIdentity(device);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        PruneDeadDevices();
+
+        auto devicePool = TryGetDevicePool(deviceIdentity.Get());
+
+        if (!devicePool)
+            return;
+
+        devicePool->CurrentFrame++;
+
+        for (auto bucket = devicePool->Buckets.begin(); bucket != devicePool->Buckets.end();)
+        {
+            auto& idleBitmaps = bucket->second;
+
+            // Bitmaps are pushed in the order they were returned, so the ones
+            // that have been idle longest are at the front.
+            auto firstRecent = std::find_if(idleBitmaps.begin(), idleBitmaps.end(),
+                [&](IdleBitmap const& idleBitmap)
+                {
+                    return devicePool->CurrentFrame - idleBitmap.ReturnedFrame <= m_idleFrameLimit;
+                });
+
+            auto releasedCount = static_cast<uint64_t>(firstRecent - idleBitmaps.begin());
+
+            devicePool->PooledBytes -= releasedCount * GetBytes(bucket->first);
+            idleBitmaps.erase(idleBitmaps.begin(), firstRecent);
+
+            if (idleBitmaps.empty())
+                bucket = devicePool->Buckets.erase(bucket);
+            else
+                ++bucket;
+        }
+    }
+
+
+    void CanvasRenderTargetPool::Trim(ICanvasDevice* device)
+    {
+        auto deviceIdentity = GetIdentity(device);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_devicePools.erase(deviceIdentity.Get());
+    }
+
+
+    uint64_t CanvasRenderTargetPool::GetPooledBytes(ICanvasDevice* device)
+    {
+        auto deviceIdentity = GetIdentity(device);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto devicePool = TryGetDevicePool(deviceIdentity.Get());
+
+        return devicePool ? devicePool->PooledBytes : 0;
+    }
+
+
+    uint32_t CanvasRenderTargetPool::GetIdleFrameLimit()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_idleFrameLimit;
+    }
+
+
+    void CanvasRenderTargetPool::SetIdleFrameLimit(uint32_t frameCount)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_idleFrameLimit = frameCount;
+    }
+
+
+    uint64_t CanvasRenderTargetPool::GetBytes(CanvasRenderTargetPoolKey const& key)
+    {
+        auto format = static_cast<DXGI_FORMAT>(key.Format);
+
+        return static_cast<uint64_t>(GetBytesPerRow(format, key.PixelWidth)) * GetRowCount(format, key.PixelHeight);
+    }
+
+
+    ComPtr<IUnknown> CanvasRenderTargetPool::GetIdentity(ICanvasDevice* device)
+    {
+        CheckInPointer(device);
+
+        ComPtr<IUnknown> deviceIdentity;
+        ThrowIfFailed(device->QueryInterface(IID_PPV_ARGS(&deviceIdentity)));
+
+        return deviceIdentity;
+    }
+
+
+    //
+    // Looks up the pool for a device, discarding it if the device it was
+    // created for has since gone away and its address been reused.
+    //
+    CanvasRenderTargetPool::DevicePool* CanvasRenderTargetPool::TryGetDevicePool(IUnknown* deviceIdentity)
+    {
+        auto it = m_devicePools.find(deviceIdentity);
+
+        if (it == m_devicePools.end())
+            return nullptr;
+
+        ComPtr<ICanvasDevice> device;
+
+        if (SUCCEEDED(it->second.Device.As(&device)) && device && GetIdentity(device.Get()).Get() == deviceIdentity)
+            return &it->second;
+
+        m_devicePools.erase(it);
+        return nullptr;
+    }
+
+
+    //
+    // Releases the idle bitmaps of devices that have gone away. Nothing else
+    // would, since Trim and EndFrame need the device. Called on every use of
+    // the pool; there are rarely more than a couple of devices, so this is cheap.
+    //
+    void CanvasRenderTargetPool::PruneDeadDevices()
+    {
+        for (auto it = m_devicePools.begin(); it != m_devicePools.end();)
+        {
+            ComPtr<ICanvasDevice> device;
+
+            if (SUCCEEDED(it->second.Device.As(&device)) && device)
+                ++it;
+            else
+                it = m_devicePools.erase(it);
+        }
+    }
+}}}}
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+    using namespace ABI::Microsoft::Graphics::Canvas::DirectX;
+
+    // Render targets can only be reused for requests with all of these the same.
+    struct CanvasRenderTargetPoolKey
+    {
+        uint32_t PixelWidth;
+        uint32_t PixelHeight;
+        DirectXPixelFormat Format;
+        CanvasAlphaMode Alpha;
+        float Dpi;
+
+        bool operator<(CanvasRenderTargetPoolKey const& other) const;
+    };
+
+    //
+    // Holds on to the D2D bitmaps of render targets that have been closed, so
+    // that code which creates and discards many same-sized render targets
+    // every frame does not have to allocate new ones each time.
+    //
+    // Each device has its own set of buckets, and its own frame counter which
+    // is advanced by EndFrame. Bitmaps that nobody has asked for in
+    // IdleFrameLimit frames are released, as are all of a device's bitmaps
+    // when it is trimmed.
+    //
+    // Idle bitmaps hold strong references to the D2D device they were made
+    // on, so keep its video memory alive for as long as they are pooled. The
+    // CanvasDevice itself is only held by weak reference, and the pools of
+    // devices that have gone away are released the next time the pool is
+    // used for any device. Closing a CanvasDevice trims its pool straight away.
+    //
+    class CanvasRenderTargetPool
+    {
+    public:
+        static const uint32_t DefaultIdleFrameLimit = 3;
+
+        CanvasRenderTargetPool();
+
+        // Returns null if there is no idle bitmap for this key.
+        ComPtr<ID2D1Bitmap1> TryAcquire(ICanvasDevice* device, CanvasRenderTargetPoolKey const& key);
+
+        // The caller must have finished with the bitmap: its contents will be
+        // overwritten by whoever acquires it next.
+        void Return(ICanvasDevice* device, CanvasRenderTargetPoolKey const& key, ID2D1Bitmap1* bitmap);
+
+        void EndFrame(ICanvasDevice* device);
+
+        // Releases all of the device's idle bitmaps.
+        void Trim(ICanvasDevice* device);
+
+        uint64_t GetPooledBytes(ICanvasDevice* device);
+
+        uint32_t GetIdleFrameLimit();
+        void SetIdleFrameLimit(uint32_t frameCount);
+
+        static uint64_t GetBytes(CanvasRenderTargetPoolKey const& key);
+
+    private:
+        struct IdleBitmap
+        {
+            ComPtr<ID2D1Bitmap1> Bitmap;
+            uint64_t ReturnedFrame;
+        };
+
+        typedef std::map<CanvasRenderTargetPoolKey, std::vector<IdleBitmap>> BucketMap;
+
+        struct DevicePool
+        {
+            DevicePool()
+                : CurrentFrame(0)
+                , PooledBytes(0)
+            { }
+
+            WeakRef Device;
+            uint64_t CurrentFrame;
+            uint64_t PooledBytes;
+            BucketMap Buckets;
+        };
+
+        typedef std::map<IUnknown*, DevicePool> DevicePoolMap;
+
+        static ComPtr<IUnknown> GetIdentity(ICanvasDevice* device);
+
+        DevicePool* TryGetDevicePool(IUnknown* deviceIdentity);
+        void PruneDeadDevices();
+
+        std::mutex m_mutex;
+        DevicePoolMap m_devicePools;
+        uint32_t m_idleFrameLimit;
+    };
+}}}}
@@ -40,7 +40,6 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         , m_dashStyle(static_cast<CanvasDashStyle>(d2dStrokeStyle->GetDashStyle()))
         , m_dashOffset(d2dStrokeStyle->GetDashOffset())
         , m_transformBehavior(static_cast<CanvasStrokeTransformBehavior>(d2dStrokeStyle->GetStrokeTransformType()))
-        , m_d2dStrokeStyle(d2dStrokeStyle)
     {
         //
         // Canvas stroke styles created from native stroke styles are made 
@@ -62,6 +61,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 d2dStrokeStyle->GetDashes(&(m_customDashElements[0]), customDashElementCount);
             }
         }
+
+        //
+        // The native stroke style becomes the realization for its own
+        // factory. It isn't added to the cache, since whoever created it may
+        // still be holding on to it.
+        //
+        ComPtr<ID2D1Factory> d2dFactory;
+        d2dStrokeStyle->GetFactory(&d2dFactory);
+
+        ComPtr<IUnknown> factoryIdentity;
+        ThrowIfFailed(d2dFactory.As(&factoryIdentity));
+
+        Realization realization;
+        realization.Factory = d2dFactory.Get();
+        realization.Shared = std::make_shared<SharedStrokeStyle>(
+            StrokeStyleKey(factoryIdentity.Get(), GetStrokeStyleProperties(), m_customDashElements));
+        realization.Shared->StrokeStyle = d2dStrokeStyle;
+
+        m_realizations.push_back(realization);
     }
 
     IFACEMETHODIMP CanvasStrokeStyle::get_StartCap(_Out_ CanvasCapStyle* value)
@@ -83,7 +101,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_startCap != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_startCap = value;
                 }
             });
@@ -108,7 +126,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_endCap != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_endCap = value;
                 }
             });
@@ -133,7 +151,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_dashCap != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_dashCap = value;
                 }
             });
@@ -158,7 +176,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_lineJoin != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_lineJoin = value;
                 }
             });
@@ -183,7 +201,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_miterLimit != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_miterLimit = value;
                 }
             });
@@ -208,7 +226,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_dashStyle != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_dashStyle = value;
                 }
             });
@@ -233,7 +251,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 ThrowIfClosed();
                 if (m_dashOffset != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_dashOffset = value;
                 }
             });
@@ -272,7 +290,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                         m_customDashElements.end(),
                         stdext::checked_array_iterator<float*>(valueElements, valueCount)))
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_customDashElements.assign(valueElements, valueElements + valueCount);
                 }
             });
@@ -298,7 +316,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 if (m_transformBehavior != value)
                 {
-                    m_d2dStrokeStyle.Reset();
+                    InvalidateRealizations();
                     m_transformBehavior = value;
                 }
             });
@@ -309,7 +327,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     //
     IFACEMETHODIMP CanvasStrokeStyle::Close()
     {
-        m_d2dStrokeStyle.Reset();
+        InvalidateRealizations();
         m_closed = true;
 
         return S_OK;
@@ -322,59 +340,56 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     ComPtr<ID2D1StrokeStyle1> CanvasStrokeStyle::GetRealizedD2DStrokeStyle(ID2D1Factory* d2dFactory)
     {
-        //
-        // If there is already a realization, ensure its factory matches the target factory.
-        // If not, invalidate and re-realize.
-        //
-        // May be possible to forego re-realizing in some more cases. See item #1589.
-        //
-        if (m_d2dStrokeStyle)
+        for (auto it = m_realizations.begin(); it != m_realizations.end(); ++it)
         {
-            ComPtr<ID2D1Factory> realizationFactory;
-            m_d2dStrokeStyle->GetFactory(&realizationFactory);
-
-            if (!IsSameInstance(realizationFactory.Get(), d2dFactory))
+            if (it->Factory == d2dFactory)
             {
-                m_d2dStrokeStyle.Reset();
+                std::rotate(m_realizations.begin(), it, it + 1);
+                return m_realizations.front().Shared->StrokeStyle;
             }
         }
 
-        if (!m_d2dStrokeStyle)
-        {
+        //
+        // Not used with this factory since the properties last changed. The
+        // cache may already have a realization for these properties, made for
+        // another CanvasStrokeStyle or before this one was changed back.
+        //
+        if (!m_cache)
+            m_cache = PerApplicationStrokeStyleCache::GetOrCreateManager();
 
-            D2D1_STROKE_STYLE_PROPERTIES1 strokeStyleProperties = D2D1::StrokeStyleProperties1(
-                static_cast<D2D1_CAP_STYLE>(m_startCap),
-                static_cast<D2D1_CAP_STYLE>(m_endCap),
-                static_cast<D2D1_CAP_STYLE>(m_dashCap),
-                static_cast<D2D1_LINE_JOIN>(m_lineJoin),
-                m_miterLimit,
-                static_cast<D2D1_DASH_STYLE>(m_dashStyle),
-                m_dashOffset,
-                static_cast<D2D1_STROKE_TRANSFORM_TYPE>(m_transformBehavior));
-
-            float* dashArray = NULL;
-            if (m_customDashElements.size() > 0)
-            {
-                dashArray = &(m_customDashElements[0]);
-                strokeStyleProperties.dashStyle = D2D1_DASH_STYLE_CUSTOM;
-            }
+        Realization realization;
+        realization.Factory = d2dFactory;
+        realization.Shared = m_cache->GetOrCreate(d2dFactory, GetStrokeStyleProperties(), m_customDashElements);
 
-            // Potential thread safety problem here. Need to ensure resource creation, including
-            // device-independent resource creation, is per-thread. See #802.
+        m_realizations.insert(m_realizations.begin(), realization);
 
-            assert(m_customDashElements.size() <= UINT_MAX);
+        if (m_realizations.size() > MaxRealizations)
+            m_realizations.pop_back();
 
-            ComPtr<ID2D1Factory2> d2dFactory2;
-            ThrowIfFailed(d2dFactory->QueryInterface(IID_PPV_ARGS(d2dFactory2.GetAddressOf())));
+        return realization.Shared->StrokeStyle;
+    }
 
-            ThrowIfFailed(d2dFactory2->CreateStrokeStyle(
-                strokeStyleProperties,
-                dashArray,
-                static_cast<UINT32>(m_customDashElements.size()),
-                &m_d2dStrokeStyle));
-        }
+    D2D1_STROKE_STYLE_PROPERTIES1 CanvasStrokeStyle::GetStrokeStyleProperties() const
+    {
+        D2D1_STROKE_STYLE_PROPERTIES1 strokeStyleProperties = D2D1::StrokeStyleProperties1(
+            static_cast<D2D1_CAP_STYLE>(m_startCap),
+            static_cast<D2D1_CAP_STYLE>(m_endCap),
+            static_cast<D2D1_CAP_STYLE>(m_dashCap),
+            static_cast<D2D1_LINE_JOIN>(m_lineJoin),
+            m_miterLimit,
+            static_cast<D2D1_DASH_STYLE>(m_dashStyle),
+            m_dashOffset,
+            static_cast<D2D1_STROKE_TRANSFORM_TYPE>(m_transformBehavior));
+
+        if (!m_customDashElements.empty())
+            strokeStyleProperties.dashStyle = D2D1_DASH_STYLE_CUSTOM;
+
+        return strokeStyleProperties;
+    }
 
-        return m_d2dStrokeStyle;
+    void CanvasStrokeStyle::InvalidateRealizations()
+    {
+        m_realizations.clear();
     }
 
     void CanvasStrokeStyle::ThrowIfClosed()
@@ -14,6 +14,8 @@
 
 #include <Canvas.abi.h>
 
+#include "StrokeStyleCache.h"
+
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ::Microsoft::WRL;
@@ -74,7 +76,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         // The contained D2D resource could be NULL at any given time.
         //
         bool m_closed;
-        ComPtr<ID2D1StrokeStyle1> m_d2dStrokeStyle;
+
+        struct Realization
+        {
+            // The factory exactly as it was passed to GetRealizedD2DStrokeStyle,
+            // so that the common case needs no QueryInterface to match it.
+            // Kept alive by the realized stroke style.
+            ID2D1Factory* Factory;
+            std::shared_ptr<SharedStrokeStyle> Shared;
+        };
+
+        //
+        // Realizations of the current properties, one for each factory this
+        // stroke style has recently been used with, most recent first.
+        // Setting a property to a new value clears these.
+        //
+        static const size_t MaxRealizations = 4;
+        std::vector<Realization> m_realizations;
+
+        std::shared_ptr<StrokeStyleCache> m_cache;
 
     public:
         CanvasStrokeStyle();
@@ -129,5 +149,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     private:
         void ThrowIfClosed();
+
+        void InvalidateRealizations();
+
+        D2D1_STROKE_STYLE_PROPERTIES1 GetStrokeStyleProperties() const;
     };
 }}}}
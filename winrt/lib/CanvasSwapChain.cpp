@@ -15,6 +15,7 @@
 #include "CanvasSwapChain.h"
 #include "CanvasDevice.h"
 #include "CanvasDrawingSession.h"
+#include "CanvasDrawingStatistics.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -154,6 +155,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         float dpi)
         : ResourceWrapper(swapChainManager, dxgiSwapChain)
         , m_dpi(dpi)
+        , m_isDrawingStatisticsEnabled(false)
     {
         ThrowIfFailed(resourceCreator->get_Device(&m_device));
     }
@@ -372,6 +374,50 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
                 DXGI_PRESENT_PARAMETERS presentParameters = { 0 };
                 ThrowIfFailed(resource->Present1(syncInterval, 0, &presentParameters));
+
+                // Whatever is drawn from now on belongs to the next frame.
+                if (m_frameStatistics)
+                {
+                    auto frameStatistics = Make<CanvasDrawingStatistics>(*m_frameStatistics);
+                    CheckMakeResult(frameStatistics);
+                    m_lastFrameStatistics = frameStatistics;
+                    m_frameStatistics.reset();
+                }
+            });
+    }
+
+    IFACEMETHODIMP CanvasSwapChain::put_IsDrawingStatisticsEnabled(boolean value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_isDrawingStatisticsEnabled = !!value;
+
+                if (!m_isDrawingStatisticsEnabled)
+                {
+                    m_frameStatistics.reset();
+                    m_lastFrameStatistics.Reset();
+                }
+            });
+    }
+
+    IFACEMETHODIMP CanvasSwapChain::get_IsDrawingStatisticsEnabled(boolean* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                *value = m_isDrawingStatisticsEnabled;
+            });
+    }
+
+    IFACEMETHODIMP CanvasSwapChain::get_DrawingStatistics(ICanvasDrawingStatistics** value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(value);
+                ThrowIfFailed(m_lastFrameStatistics.CopyTo(value));
             });
     }
 
@@ -428,6 +474,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             return hr;
 
         m_device.Close();
+        m_frameStatistics.reset();
+        m_lastFrameStatistics.Reset();
         return S_OK;
     }
 
@@ -543,6 +591,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     m_dpi,
                     &deviceContext);
                 
+                if (m_isDrawingStatisticsEnabled && !m_frameStatistics)
+                    m_frameStatistics = std::make_shared<DrawingStatistics>();
+
+                DrawingStatisticsScope statisticsScope(m_frameStatistics.get());
+
                 auto drawingSessionManager = CanvasDrawingSessionFactory::GetOrCreateManager();
                 auto newDrawingSession = drawingSessionManager->Create(deviceContext.Get(), adapter);
 
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include "DrawingStatistics.h"
+
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ABI::Microsoft::Graphics::Canvas::Numerics;
@@ -91,6 +93,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ClosablePtr<ICanvasDevice> m_device;
         float m_dpi;
 
+        bool m_isDrawingStatisticsEnabled;
+        std::shared_ptr<DrawingStatistics> m_frameStatistics;
+        ComPtr<ICanvasDrawingStatistics> m_lastFrameStatistics;
+
     public:
         CanvasSwapChain(
             ICanvasResourceCreator* resourceCreator,
@@ -123,6 +129,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         IFACEMETHODIMP ConvertPixelsToDips(int pixels, float* dips) override;
         IFACEMETHODIMP ConvertDipsToPixels(float dips, int* pixels) override;
 
+        IFACEMETHOD(put_IsDrawingStatisticsEnabled)(boolean value) override;
+        IFACEMETHOD(get_IsDrawingStatisticsEnabled)(boolean* value) override;
+        IFACEMETHOD(get_DrawingStatistics)(ICanvasDrawingStatistics** value) override;
+
         IFACEMETHOD(Present)() override;
         IFACEMETHOD(PresentWithSyncInterval)(int32_t syncInterval) override;
 
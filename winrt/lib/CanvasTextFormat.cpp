@@ -13,6 +13,7 @@
 #include "pch.h"
 
 #include "CanvasTextFormat.h"
+#include "TextFormatInternTable.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -558,11 +559,91 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         if (m_format)
             return m_format;
 
-        ComPtr<IDWriteFactory2> factory;
-        ThrowIfFailed(DWriteCreateFactory(
-            DWRITE_FACTORY_TYPE_SHARED,
-            __uuidof(&factory),
-            static_cast<IUnknown**>(&factory)));
+        m_format = CreateRealizedTextFormat(GetInternTable()->GetFactory().Get());
+
+        // From now on m_format is the authoritative copy of the properties,
+        // and may be modified by whoever we hand it out to.
+        m_internedFormat.reset();
+
+        return m_format;
+    }
+
+
+    CanvasDrawTextOptions CanvasTextFormat::GetDrawTextOptions()
+    {
+        return m_drawTextOptions;
+    }
+
+
+    ComPtr<IDWriteTextFormat> CanvasTextFormat::GetInternedTextFormat()
+    {
+        if (m_format)
+            return m_format;
+
+        if (!m_internedFormat)
+        {
+            m_internedFormat = GetInternTable()->GetOrCreate(
+                GetTextFormatKey(),
+                [&](IDWriteFactory* factory) { return CreateRealizedTextFormat(factory); });
+        }
+
+        return m_internedFormat->Format;
+    }
+
+
+    std::shared_ptr<DigitGlyphTable> CanvasTextFormat::GetDigitGlyphTable()
+    {
+        // A realized format belongs to this instance and may be modified at
+        // any time, so there is nothing it is safe to cache against.
+        if (m_format)
+            return nullptr;
+
+        GetInternedTextFormat();
+
+        return m_internTable->GetDigitGlyphTable(m_internedFormat.get());
+    }
+
+
+    std::shared_ptr<TextFormatInternTable> const& CanvasTextFormat::GetInternTable()
+    {
+        if (!m_internTable)
+            m_internTable = PerApplicationTextFormatInternTable::GetOrCreateManager();
+
+        return m_internTable;
+    }
+
+
+    TextFormatKey CanvasTextFormat::GetTextFormatKey()
+    {
+        TextFormatKey key;
+
+        key.FontCollection         = m_fontCollection.Get();
+        key.FontFamilyName         = static_cast<const wchar_t*>(m_fontFamilyName);
+        key.FontSize               = m_fontSize;
+        key.FontStretch            = ToFontStretch(m_fontStretch);
+        key.FontStyle              = ToFontStyle(m_fontStyle);
+        key.FontWeight             = ToFontWeight(m_fontWeight);
+        key.LocaleName             = static_cast<const wchar_t*>(m_localeName);
+        key.FlowDirection          = ToFlowDirection(m_flowDirection);
+        key.IncrementalTabStop     = m_incrementalTabStop;
+        key.LineSpacingMethod      = ToLineSpacingMethod(m_lineSpacingMethod);
+        key.LineSpacing            = m_lineSpacing;
+        key.LineSpacingBaseline    = m_lineSpacingBaseline;
+        key.ParagraphAlignment     = ToParagraphAlignment(m_verticalAlignment);
+        key.ReadingDirection       = ToReadingDirection(m_readingDirection);
+        key.TextAlignment          = ToTextAlignment(m_paragraphAlignment);
+        key.TrimmingGranularity    = ToTrimmingGranularity(m_trimmingGranularity);
+        key.TrimmingDelimiter      = ToTrimmingDelimiter(m_trimmingDelimiter);
+        key.TrimmingDelimiterCount = static_cast<uint32_t>(m_trimmingDelimiterCount);
+        key.WordWrapping           = ToWordWrapping(m_wordWrapping);
+
+        return key;
+    }
+
+
+    ComPtr<IDWriteTextFormat> CanvasTextFormat::CreateRealizedTextFormat(IDWriteFactory* factory)
+    {
+        ComPtr<IDWriteTextFormat> format;
 
         ThrowIfFailed(factory->CreateTextFormat(
             static_cast<const wchar_t*>(m_fontFamilyName),
@@ -572,24 +653,18 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ToFontStretch(m_fontStretch),
             m_fontSize,
             static_cast<const wchar_t*>(m_localeName),
-            &m_format));
-
-        RealizeFlowDirection();
-        RealizeIncrementalTabStop();
-        RealizeLineSpacing();
-        RealizeParagraphAlignment();
-        RealizeReadingDirection();
-        RealizeTextAlignment();
-        RealizeTrimming();
-        RealizeWordWrapping();
-
-        return m_format;
-    }
+            &format));
 
+        RealizeFlowDirection(format.Get());
+        RealizeIncrementalTabStop(format.Get());
+        RealizeLineSpacing(format.Get());
+        RealizeParagraphAlignment(format.Get());
+        RealizeReadingDirection(format.Get());
+        RealizeTextAlignment(format.Get());
+        RealizeTrimming(format.Get());
+        RealizeWordWrapping(format.Get());
 
-    CanvasDrawTextOptions CanvasTextFormat::GetDrawTextOptions()
-    {
-        return m_drawTextOptions;
+        return format;
     }
 
 
@@ -716,7 +791,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     
     template<typename T, typename TT, typename FNV>
-    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)())
+    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*))
     {
         return ExceptionBoundary(
             [&]
@@ -743,14 +818,17 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 // Set the shadow value
                 SetFrom(dest, value);
 
+                // The interned format no longer matches our properties
+                m_internedFormat.reset();
+
                 // Realize the value on the dwrite object, if we can
                 if (m_format && realizer)
-                    (this->*realizer)();
+                    (this->*realizer)(m_format.Get());
             });
     }
 
     template<typename T, typename TT>
-    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)())
+    HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*))
     {
         return PropertyPut(value, dest, [](T){}, realizer);
     }
@@ -778,9 +856,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeFlowDirection()
+    void CanvasTextFormat::RealizeFlowDirection(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetFlowDirection(ToFlowDirection(m_flowDirection)));        
+        ThrowIfFailed(format->SetFlowDirection(ToFlowDirection(m_flowDirection)));        
     }
 
     //
@@ -913,12 +991,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeIncrementalTabStop()
+    void CanvasTextFormat::RealizeIncrementalTabStop(IDWriteTextFormat* format)
     {
         // Negative value indicates that it hasn't been set yet, so we want to
         // use dwrite's default.
         if (m_incrementalTabStop >= 0.0f)
-            ThrowIfFailed(m_format->SetIncrementalTabStop(m_incrementalTabStop));
+            ThrowIfFailed(format->SetIncrementalTabStop(m_incrementalTabStop));
     }
 
     //
@@ -988,9 +1066,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeLineSpacing()
+    void CanvasTextFormat::RealizeLineSpacing(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetLineSpacing(
+        ThrowIfFailed(format->SetLineSpacing(
             ToLineSpacingMethod(m_lineSpacingMethod),
             m_lineSpacing,
             m_lineSpacingBaseline));
@@ -1044,9 +1122,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeParagraphAlignment()
+    void CanvasTextFormat::RealizeParagraphAlignment(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetParagraphAlignment(ToParagraphAlignment(m_verticalAlignment)));
+        ThrowIfFailed(format->SetParagraphAlignment(ToParagraphAlignment(m_verticalAlignment)));
     }
 
     //
@@ -1072,9 +1150,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeReadingDirection()
+    void CanvasTextFormat::RealizeReadingDirection(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetReadingDirection(ToReadingDirection(m_readingDirection)));
+        ThrowIfFailed(format->SetReadingDirection(ToReadingDirection(m_readingDirection)));
     }
 
     //
@@ -1100,9 +1178,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             &CanvasTextFormat::RealizeTextAlignment);
     }
 
-    void CanvasTextFormat::RealizeTextAlignment()
+    void CanvasTextFormat::RealizeTextAlignment(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetTextAlignment(ToTextAlignment(m_paragraphAlignment)));        
+        ThrowIfFailed(format->SetTextAlignment(ToTextAlignment(m_paragraphAlignment)));        
     }
 
     //
@@ -1172,14 +1250,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeTrimming()
+    void CanvasTextFormat::RealizeTrimming(IDWriteTextFormat* format)
     {
         DWRITE_TRIMMING trimmingOptions{};
         trimmingOptions.granularity = ToTrimmingGranularity(m_trimmingGranularity);
         trimmingOptions.delimiter = ToTrimmingDelimiter(m_trimmingDelimiter);
         trimmingOptions.delimiterCount = m_trimmingDelimiterCount;
             
-        ThrowIfFailed(m_format->SetTrimming(
+        ThrowIfFailed(format->SetTrimming(
             &trimmingOptions,
             nullptr));        
     }
@@ -1208,9 +1286,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    void CanvasTextFormat::RealizeWordWrapping()
+    void CanvasTextFormat::RealizeWordWrapping(IDWriteTextFormat* format)
     {
-        ThrowIfFailed(m_format->SetWordWrapping(ToWordWrapping(m_wordWrapping)));        
+        ThrowIfFailed(format->SetWordWrapping(ToWordWrapping(m_wordWrapping)));        
     }
 
     //
@@ -20,6 +20,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ::Microsoft::WRL;
 
+    class DigitGlyphTable;
+    struct InternedTextFormat;
+    struct TextFormatKey;
+    class TextFormatInternTable;
+
     class CanvasTextFormatFactory : public ActivationFactory<
         CloakedIid<ICanvasFactoryNative>>
     {
@@ -48,6 +53,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     public:
         virtual ComPtr<IDWriteTextFormat> GetRealizedTextFormat() = 0;
         virtual CanvasDrawTextOptions GetDrawTextOptions() = 0;
+
+        // The returned format may be shared with other CanvasTextFormats, so
+        // it must not be modified.
+        virtual ComPtr<IDWriteTextFormat> GetInternedTextFormat() = 0;
+
+        // Returns null if text in this format must always go through the
+        // shaper.
+        virtual std::shared_ptr<DigitGlyphTable> GetDigitGlyphTable() = 0;
     };
 
 
@@ -57,6 +70,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     // keeps track of shadow copies of properties and recreates ("realizes") an
     // IDWriteTextFormat as necessary.
     //
+    // Drawing text does not need a format of its own, so long as nothing
+    // modifies it.  Unless this CanvasTextFormat has already been realized,
+    // drawing uses an IDWriteTextFormat interned by the TextFormatInternTable
+    // and shared with every other CanvasTextFormat that has the same
+    // properties.  Changing a property drops the interned format, and the
+    // next draw picks up the one that matches the new properties.
+    //
     class CanvasTextFormat : public RuntimeClass<
         RuntimeClassFlags<WinRtClassicComMix>,
         ICanvasTextFormat,
@@ -109,6 +129,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         //
         ComPtr<IDWriteTextFormat> m_format;
 
+        //
+        // The interned format used for drawing when m_format has not been
+        // created.
+        //
+        std::shared_ptr<TextFormatInternTable> m_internTable;
+        std::shared_ptr<InternedTextFormat> m_internedFormat;
+
     public:
         CanvasTextFormat();
         CanvasTextFormat(IDWriteTextFormat* format);
@@ -154,6 +181,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         virtual ComPtr<IDWriteTextFormat> GetRealizedTextFormat() override;
         virtual CanvasDrawTextOptions GetDrawTextOptions() override;
+        virtual ComPtr<IDWriteTextFormat> GetInternedTextFormat() override;
+        virtual std::shared_ptr<DigitGlyphTable> GetDigitGlyphTable() override;
 
         //
         // ICanvasResourceWrapperNative
@@ -169,22 +198,26 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         HRESULT __declspec(nothrow) PropertyGet(T* value, ST const& shadowValue, FN realizedGetter);
 
         template<typename T, typename TT, typename FNV>
-        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)() = nullptr);
+        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, FNV&& validator, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*) = nullptr);
         
         template<typename T, typename TT>
-        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)() = nullptr);
+        HRESULT __declspec(nothrow) PropertyPut(T value, TT* dest, void(CanvasTextFormat::*realizer)(IDWriteTextFormat*) = nullptr);
 
         void SetShadowPropertiesFromDWrite();
 
+        std::shared_ptr<TextFormatInternTable> const& GetInternTable();
+        TextFormatKey GetTextFormatKey();
+        ComPtr<IDWriteTextFormat> CreateRealizedTextFormat(IDWriteFactory* factory);
+
         void Unrealize();
-        void RealizeFlowDirection();
-        void RealizeIncrementalTabStop();
-        void RealizeLineSpacing();
-        void RealizeParagraphAlignment();
-        void RealizeReadingDirection();
-        void RealizeTextAlignment();
-        void RealizeTrimming();
-        void RealizeWordWrapping();
+        void RealizeFlowDirection(IDWriteTextFormat* format);
+        void RealizeIncrementalTabStop(IDWriteTextFormat* format);
+        void RealizeLineSpacing(IDWriteTextFormat* format);
+        void RealizeParagraphAlignment(IDWriteTextFormat* format);
+        void RealizeReadingDirection(IDWriteTextFormat* format);
+        void RealizeTextAlignment(IDWriteTextFormat* format);
+        void RealizeTrimming(IDWriteTextFormat* format);
+        void RealizeWordWrapping(IDWriteTextFormat* format);
     };
 
 
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "CanvasTextLayout.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // CanvasTextLayoutFactory
+    //
+
+    IFACEMETHODIMP CanvasTextLayoutFactory::Create(
+        HSTRING text,
+        ICanvasTextFormat* textFormat,
+        float requestedWidth,
+        float requestedHeight,
+        ICanvasTextLayout** textLayout)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(textFormat);
+                CheckAndClearOutPointer(textLayout);
+
+                if (requestedWidth < 0 || isnan(requestedWidth) ||
+                    requestedHeight < 0 || isnan(requestedHeight))
+                {
+                    ThrowHR(E_INVALIDARG);
+                }
+
+                ComPtr<ICanvasTextFormatInternal> formatInternal;
+                ThrowIfFailed(textFormat->QueryInterface(formatInternal.GetAddressOf()));
+
+                auto newTextLayout = CanvasTextLayout::Create(
+                    GetManager()->GetFactory().Get(),
+                    formatInternal.Get(),
+                    text,
+                    requestedWidth,
+                    requestedHeight);
+
+                ThrowIfFailed(newTextLayout.CopyTo(textLayout));
+            });
+    }
+
+
+    //
+    // CanvasTextLayout
+    //
+
+    CanvasTextLayout::CanvasTextLayout(WinString const& text, ShapedText shapedText)
+        : m_closed(false)
+        , m_text(text)
+        , m_shapedText(std::move(shapedText))
+    {
+    }
+
+
+    ComPtr<CanvasTextLayout> CanvasTextLayout::Create(
+        IDWriteFactory* factory,
+        ICanvasTextFormatInternal* textFormat,
+        HSTRING text,
+        float requestedWidth,
+        float requestedHeight)
+    {
+        uint32_t textLength;
+        auto textBuffer = WindowsGetStringRawBuffer(text, &textLength);
+
+        ShapedText shapedText;
+
+        auto digitGlyphs = textFormat->GetDigitGlyphTable();
+
+        if (!digitGlyphs || !digitGlyphs->TryCompose(textBuffer, textLength, requestedWidth, &shapedText))
+        {
+            shapedText = ShapeText(
+                factory,
+                textFormat->GetInternedTextFormat().Get(),
+                textBuffer,
+                textLength,
+                requestedWidth,
+                requestedHeight);
+        }
+
+        auto textLayout = Make<CanvasTextLayout>(WinString(text), std::move(shapedText));
+        CheckMakeResult(textLayout);
+
+        return textLayout;
+    }
+
+
+    void CanvasTextLayout::ThrowIfClosed()
+    {
+        if (m_closed)
+            ThrowHR(RO_E_CLOSED);
+    }
+
+
+    IFACEMETHODIMP CanvasTextLayout::get_Text(HSTRING* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                ThrowIfClosed();
+
+                m_text.CopyTo(value);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasTextLayout::get_LayoutBounds(ABI::Windows::Foundation::Rect* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                ThrowIfClosed();
+
+                *value = FromD2DRect(m_shapedText.LayoutBounds);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasTextLayout::Close()
+    {
+        m_closed = true;
+        m_shapedText = ShapedText();
+        return S_OK;
+    }
+
+
+    ShapedText const& CanvasTextLayout::GetShapedText()
+    {
+        ThrowIfClosed();
+
+        return m_shapedText;
+    }
+
+
+    ActivatableStaticOnlyFactory(CanvasTextLayoutFactory);
+}}}}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "CanvasTextFormat.h"
+#include "ShapedText.h"
+#include "TextFormatInternTable.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    [uuid(5D0E8B2A-41C7-4F6B-A3E9-8C27D61F0B95)]
+    class ICanvasTextLayoutInternal : public IUnknown
+    {
+    public:
+        virtual ShapedText const& GetShapedText() = 0;
+    };
+
+
+    class CanvasTextLayoutFactory
+        : public ActivationFactory<ICanvasTextLayoutStatics>
+        , public PerApplicationTextFormatInternTable
+    {
+        InspectableClassStatic(RuntimeClass_Microsoft_Graphics_Canvas_CanvasTextLayout, BaseTrust);
+
+    public:
+        //
+        // ICanvasTextLayoutStatics
+        //
+
+        IFACEMETHOD(Create)(
+            HSTRING text,
+            ICanvasTextFormat* textFormat,
+            float requestedWidth,
+            float requestedHeight,
+            ICanvasTextLayout** textLayout) override;
+    };
+
+
+    //
+    // Holds the glyph runs for a piece of text, captured once when the layout
+    // is created and replayed with DrawGlyphRun every time it is drawn.
+    //
+    // Strings made only of digits and number punctuation are composed from
+    // the text format's DigitGlyphTable when it has one, which avoids
+    // creating a DWrite text layout at all.
+    //
+    class CanvasTextLayout : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasTextLayout,
+        ABI::Windows::Foundation::IClosable,
+        CloakedIid<ICanvasTextLayoutInternal>>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasTextLayout, BaseTrust);
+
+        bool m_closed;
+        WinString m_text;
+        ShapedText m_shapedText;
+
+    public:
+        CanvasTextLayout(WinString const& text, ShapedText shapedText);
+
+        static ComPtr<CanvasTextLayout> Create(
+            IDWriteFactory* factory,
+            ICanvasTextFormatInternal* textFormat,
+            HSTRING text,
+            float requestedWidth,
+            float requestedHeight);
+
+        //
+        // ICanvasTextLayout
+        //
+
+        IFACEMETHOD(get_Text)(HSTRING* value) override;
+
+        IFACEMETHOD(get_LayoutBounds)(ABI::Windows::Foundation::Rect* value) override;
+
+        //
+        // IClosable
+        //
+
+        IFACEMETHOD(Close)() override;
+
+        //
+        // ICanvasTextLayoutInternal
+        //
+
+        virtual ShapedText const& GetShapedText() override;
+
+    private:
+        void ThrowIfClosed();
+    };
+}}}}
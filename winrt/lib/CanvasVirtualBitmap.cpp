@@ -0,0 +1,268 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "CanvasBitmap.h"
+#include "CanvasVirtualBitmap.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // CanvasVirtualBitmapFactory
+    //
+
+    IFACEMETHODIMP CanvasVirtualBitmapFactory::LoadAsyncFromHstring(
+        ICanvasResourceCreator* resourceCreator,
+        HSTRING fileName,
+        IAsyncOperation<CanvasVirtualBitmap*>** canvasVirtualBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(fileName);
+                CheckAndClearOutPointer(canvasVirtualBitmapAsyncOperation);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                WinString fileNameString(fileName);
+
+                auto asyncOperation = Make<AsyncOperation<CanvasVirtualBitmap>>(
+                    [=]
+                    {
+                        auto manager = GetManager();
+
+                        // The converter decodes lazily, so nothing is read
+                        // here other than the image header.
+                        auto converter = manager->GetBitmapAdapter()->CreateWICFormatConverter(fileNameString);
+
+                        return CanvasVirtualBitmap::CreateFromWicSource(canvasDevice.Get(), converter.Get(), manager);
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasVirtualBitmapAsyncOperation));
+            });
+    }
+
+    IFACEMETHODIMP CanvasVirtualBitmapFactory::LoadAsyncFromStream(
+        ICanvasResourceCreator* resourceCreator,
+        IRandomAccessStream* rawStream,
+        IAsyncOperation<CanvasVirtualBitmap*>** canvasVirtualBitmapAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(rawStream);
+                CheckAndClearOutPointer(canvasVirtualBitmapAsyncOperation);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                ComPtr<IRandomAccessStream> stream = rawStream;
+
+                auto asyncOperation = Make<AsyncOperation<CanvasVirtualBitmap>>(
+                    [=]
+                    {
+                        ComPtr<IStream> nativeStream;
+                        ThrowIfFailed(CreateStreamOverRandomAccessStream(stream.Get(), IID_PPV_ARGS(&nativeStream)));
+
+                        auto manager = GetManager();
+                        auto converter = manager->GetBitmapAdapter()->CreateWICFormatConverter(nativeStream.Get());
+
+                        return CanvasVirtualBitmap::CreateFromWicSource(canvasDevice.Get(), converter.Get(), manager);
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasVirtualBitmapAsyncOperation));
+            });
+    }
+
+
+    //
+    // CanvasVirtualBitmap
+    //
+
+    CanvasVirtualBitmap::CanvasVirtualBitmap(
+        ICanvasDevice* device,
+        BitmapSize sizeInPixels,
+        LoadTileFunction loadTile,
+        uint32_t tileSize)
+        : m_device(device)
+        , m_loadTile(std::move(loadTile))
+        , m_tiles(sizeInPixels, tileSize)
+    {
+    }
+
+
+    ComPtr<CanvasVirtualBitmap> CanvasVirtualBitmap::CreateFromWicSource(
+        ICanvasDevice* device,
+        IWICBitmapSource* rawSource,
+        std::shared_ptr<PolymorphicBitmapManager> bitmapManager)
+    {
+        BitmapSize size;
+        ThrowIfFailed(rawSource->GetSize(&size.Width, &size.Height));
+
+        ComPtr<IWICBitmapSource> source = rawSource;
+
+        auto loadTile = [=](ICanvasDevice* tileDevice, D2D1_RECT_U const& bounds) -> ComPtr<ICanvasBitmap>
+        {
+            auto width = bounds.right - bounds.left;
+            auto height = bounds.bottom - bounds.top;
+            auto stride = width * 4;
+
+            WICRect rect = { static_cast<INT>(bounds.left), static_cast<INT>(bounds.top), static_cast<INT>(width), static_cast<INT>(height) };
+
+            std::vector<BYTE> pixels(stride * height);
+            ThrowIfFailed(source->CopyPixels(&rect, stride, static_cast<UINT>(pixels.size()), pixels.data()));
+
+            return bitmapManager->CreateBitmap(
+                tileDevice,
+                static_cast<uint32_t>(pixels.size()),
+                pixels.data(),
+                static_cast<int32_t>(width),
+                static_cast<int32_t>(height),
+                DirectXPixelFormat::B8G8R8A8UIntNormalized,
+                CanvasAlphaMode::Premultiplied,
+                DEFAULT_DPI);
+        };
+
+        auto virtualBitmap = Make<CanvasVirtualBitmap>(device, size, loadTile);
+        CheckMakeResult(virtualBitmap);
+
+        return virtualBitmap;
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::get_Device(ICanvasDevice** value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(value);
+
+                auto& device = m_device.EnsureNotClosed();
+                ThrowIfFailed(device.CopyTo(value));
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::get_SizeInPixels(BitmapSize* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+
+                *value = GetSizeInPixels();
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::get_Size(ABI::Windows::Foundation::Size* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+
+                // Tiles are always created at default DPI, so DIPs and pixels are the same.
+                auto size = GetSizeInPixels();
+
+                value->Width = static_cast<float>(size.Width);
+                value->Height = static_cast<float>(size.Height);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::get_Bounds(ABI::Windows::Foundation::Rect* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+
+                auto size = GetSizeInPixels();
+
+                value->X = 0;
+                value->Y = 0;
+                value->Width = static_cast<float>(size.Width);
+                value->Height = static_cast<float>(size.Height);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::get_MemoryBudgetInBytes(UINT64* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                m_device.EnsureNotClosed();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                *value = m_tiles.GetMemoryBudget();
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::put_MemoryBudgetInBytes(UINT64 value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                m_device.EnsureNotClosed();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tiles.SetMemoryBudget(value);
+            });
+    }
+
+
+    IFACEMETHODIMP CanvasVirtualBitmap::Close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_tiles.Clear();
+        m_loadTile = nullptr;
+        m_device.Close();
+
+        return S_OK;
+    }
+
+
+    BitmapSize CanvasVirtualBitmap::GetSizeInPixels()
+    {
+        m_device.EnsureNotClosed();
+
+        return m_tiles.GetImageSize();
+    }
+
+
+    std::vector<VirtualBitmapTile> CanvasVirtualBitmap::GetTilesToDraw(D2D1_RECT_F const& region)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto& device = m_device.EnsureNotClosed();
+
+        return m_tiles.GetTiles(region,
+            [&](D2D1_RECT_U const& bounds)
+            {
+                return m_loadTile(device.Get(), bounds);
+            });
+    }
+
+
+    ActivatableStaticOnlyFactory(CanvasVirtualBitmapFactory);
+}}}}
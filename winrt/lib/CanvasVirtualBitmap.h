@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "PolymorphicBitmapManager.h"
+#include "VirtualBitmapTiles.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+    using namespace ABI::Windows::Foundation;
+    using namespace ABI::Windows::Storage::Streams;
+
+    [uuid(269153A6-AB4F-47D3-95C1-4217614A0447)]
+    class ICanvasVirtualBitmapInternal : public IUnknown
+    {
+    public:
+        virtual BitmapSize GetSizeInPixels() = 0;
+
+        // Returns the tiles needed to draw region, which is in pixels,
+        // decoding and uploading any that are not already resident.
+        virtual std::vector<VirtualBitmapTile> GetTilesToDraw(D2D1_RECT_F const& region) = 0;
+    };
+
+
+    class CanvasVirtualBitmapFactory
+        : public ActivationFactory<ICanvasVirtualBitmapStatics>
+        , public PerApplicationPolymorphicBitmapManager
+    {
+        InspectableClassStatic(RuntimeClass_Microsoft_Graphics_Canvas_CanvasVirtualBitmap, BaseTrust);
+
+    public:
+        //
+        // ICanvasVirtualBitmapStatics
+        //
+
+        IFACEMETHOD(LoadAsyncFromHstring)(
+            ICanvasResourceCreator* resourceCreator,
+            HSTRING fileName,
+            IAsyncOperation<CanvasVirtualBitmap*>** canvasVirtualBitmapAsyncOperation) override;
+
+        IFACEMETHOD(LoadAsyncFromStream)(
+            ICanvasResourceCreator* resourceCreator,
+            IRandomAccessStream* stream,
+            IAsyncOperation<CanvasVirtualBitmap*>** canvasVirtualBitmapAsyncOperation) override;
+    };
+
+
+    //
+    // A bitmap that can be larger than the device's maximum bitmap size.
+    //
+    // The image is split into tiles by VirtualBitmapTiles. Tiles are decoded
+    // and uploaded the first time they are drawn, and released again once
+    // they have not been drawn for a while and the memory budget is used up.
+    //
+    class CanvasVirtualBitmap : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasVirtualBitmap,
+        ABI::Windows::Foundation::IClosable,
+        CloakedIid<ICanvasVirtualBitmapInternal>>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasVirtualBitmap, BaseTrust);
+
+    public:
+        typedef std::function<ComPtr<ICanvasBitmap>(ICanvasDevice* device, D2D1_RECT_U const& bounds)> LoadTileFunction;
+
+    private:
+        ClosablePtr<ICanvasDevice> m_device;
+        LoadTileFunction m_loadTile;
+
+        std::mutex m_mutex;
+        VirtualBitmapTiles m_tiles;
+
+    public:
+        CanvasVirtualBitmap(
+            ICanvasDevice* device,
+            BitmapSize sizeInPixels,
+            LoadTileFunction loadTile,
+            uint32_t tileSize = VirtualBitmapTiles::DefaultTileSize);
+
+        // Creates a virtual bitmap whose tiles are read from the given source
+        // and turned into bitmaps by bitmapManager.
+        static ComPtr<CanvasVirtualBitmap> CreateFromWicSource(
+            ICanvasDevice* device,
+            IWICBitmapSource* source,
+            std::shared_ptr<PolymorphicBitmapManager> bitmapManager);
+
+        //
+        // ICanvasVirtualBitmap
+        //
+
+        IFACEMETHOD(get_Device)(ICanvasDevice** value) override;
+
+        IFACEMETHOD(get_SizeInPixels)(BitmapSize* value) override;
+
+        IFACEMETHOD(get_Size)(ABI::Windows::Foundation::Size* value) override;
+
+        IFACEMETHOD(get_Bounds)(ABI::Windows::Foundation::Rect* value) override;
+
+        IFACEMETHOD(get_MemoryBudgetInBytes)(UINT64* value) override;
+
+        IFACEMETHOD(put_MemoryBudgetInBytes)(UINT64 value) override;
+
+        //
+        // IClosable
+        //
+
+        IFACEMETHOD(Close)() override;
+
+        //
+        // ICanvasVirtualBitmapInternal
+        //
+
+        virtual BitmapSize GetSizeInPixels() override;
+
+        virtual std::vector<VirtualBitmapTile> GetTilesToDraw(D2D1_RECT_F const& region) override;
+    };
+}}}}
@@ -94,6 +94,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         static_assert(offsetof(D2D1_MATRIX_4X4_F, _44) == offsetof(Numerics::Matrix4x4, M44), "Matrix4x4 layout must match D2D1_MATRIX_4X4_F");
     };
 
+    template<> struct ValidateReinterpretAs<D2D1_POINT_2F*, Numerics::Vector2*> : std::true_type
+    {
+        static_assert(offsetof(D2D1_POINT_2F, x) == offsetof(Numerics::Vector2, X), "Vector2 layout must match D2D1_POINT_2F");
+        static_assert(offsetof(D2D1_POINT_2F, y) == offsetof(Numerics::Vector2, Y), "Vector2 layout must match D2D1_POINT_2F");
+    };
+
     template<> struct ValidateReinterpretAs<Numerics::Vector4*, D2D1_COLOR_F*> : std::true_type
     {
         static_assert(offsetof(D2D1_COLOR_F, r) == offsetof(Numerics::Vector4, X), "Vector4 layout must match D2D1_COLOR_F");
@@ -413,6 +419,39 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         }
     }
 
+    inline WICBitmapInterpolationMode ToWICInterpolationMode(CanvasImageInterpolation interpolation)
+    {
+        // WIC has fewer modes than D2D. Fant is its best quality option for downscaling.
+        switch (interpolation)
+        {
+            case CanvasImageInterpolation::NearestNeighbor: return WICBitmapInterpolationModeNearestNeighbor;
+            case CanvasImageInterpolation::Linear: return WICBitmapInterpolationModeLinear;
+            case CanvasImageInterpolation::Cubic: return WICBitmapInterpolationModeCubic;
+            case CanvasImageInterpolation::MultiSampleLinear:
+            case CanvasImageInterpolation::Anisotropic:
+            case CanvasImageInterpolation::HighQualityCubic: return WICBitmapInterpolationModeFant;
+            default: ThrowHR(E_INVALIDARG);
+        }
+    }
+
+    // Scales size down, preserving its aspect ratio, until it fits within maxSize.
+    inline BitmapSize GetSizeToFit(BitmapSize const& size, BitmapSize const& maxSize)
+    {
+        if (maxSize.Width == 0 || maxSize.Height == 0)
+            ThrowHR(E_INVALIDARG);
+
+        if (size.Width <= maxSize.Width && size.Height <= maxSize.Height)
+            return size;
+
+        double scale = std::min(static_cast<double>(maxSize.Width) / size.Width,
+                                static_cast<double>(maxSize.Height) / size.Height);
+
+        BitmapSize result;
+        result.Width = std::min(maxSize.Width, std::max(1u, static_cast<uint32_t>(size.Width * scale + 0.5)));
+        result.Height = std::min(maxSize.Height, std::max(1u, static_cast<uint32_t>(size.Height * scale + 0.5)));
+        return result;
+    }
+
     inline float PixelsToDips(int pixels, float dpi)
     {
         return pixels * DEFAULT_DPI / dpi;
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "DrawingStatistics.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    static __declspec(thread) DrawingStatistics* t_currentStatistics;
+
+
+    DrawingStatistics::DrawingStatistics()
+        : m_drawingSessionCount(0)
+        , m_brushChangeCount(0)
+        , m_strokeStyleChangeCount(0)
+        , m_effectNodesRealizedCount(0)
+        , m_pixelBytesUploaded(0)
+        , m_drawTime(0)
+    {
+        for (auto& count : m_primitiveCounts)
+            count = 0;
+    }
+
+
+    int64_t DrawingStatistics::GetTimestamp()
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        // Split the conversion so that large counter values do not overflow.
+        auto const unitsPerSecond = 10000000LL;
+        auto seconds = counter.QuadPart / frequency.QuadPart;
+        auto remainder = counter.QuadPart % frequency.QuadPart;
+
+        return seconds * unitsPerSecond + remainder * unitsPerSecond / frequency.QuadPart;
+    }
+
+
+    DrawingStatistics* DrawingStatistics::GetCurrent()
+    {
+        return t_currentStatistics;
+    }
+
+
+    DrawingStatistics* DrawingStatistics::SetCurrent(DrawingStatistics* statistics)
+    {
+        auto previous = t_currentStatistics;
+        t_currentStatistics = statistics;
+        return previous;
+    }
+}}}}
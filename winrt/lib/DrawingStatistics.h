@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    enum class DrawingPrimitive
+    {
+        Clear,
+        Line,
+        Rectangle,
+        RoundedRectangle,
+        Ellipse,
+        Geometry,
+        Polyline,
+        Text,
+        Image,
+
+        Count
+    };
+
+    //
+    // Counts what drawing sessions ask Direct2D to do, so the cost of a frame
+    // can be seen without a GPU profiler.
+    //
+    // Drawing sessions created while statistics are current on their thread
+    // (see DrawingStatisticsScope) add to them until they are closed. Work
+    // that does not go through a drawing session, such as setting bitmap
+    // pixels or realizing effects, is counted against whatever statistics
+    // are current when it happens.
+    //
+    // Not thread safe: the statistics for a frame are expected to be updated
+    // from one thread at a time, as the drawing sessions that update them are.
+    //
+    class DrawingStatistics : public std::enable_shared_from_this<DrawingStatistics>
+    {
+        uint32_t m_drawingSessionCount;
+        uint32_t m_primitiveCounts[static_cast<int>(DrawingPrimitive::Count)];
+        uint32_t m_brushChangeCount;
+        uint32_t m_strokeStyleChangeCount;
+        uint32_t m_effectNodesRealizedCount;
+        uint64_t m_pixelBytesUploaded;
+        int64_t m_drawTime;
+
+    public:
+        DrawingStatistics();
+
+        void AddDrawingSession() { m_drawingSessionCount++; }
+        void AddPrimitive(DrawingPrimitive primitive) { m_primitiveCounts[static_cast<int>(primitive)]++; }
+        void AddBrushChange() { m_brushChangeCount++; }
+        void AddStrokeStyleChange() { m_strokeStyleChangeCount++; }
+        void AddEffectNodeRealized() { m_effectNodesRealizedCount++; }
+        void AddPixelBytesUploaded(uint64_t byteCount) { m_pixelBytesUploaded += byteCount; }
+        void AddDrawTime(int64_t duration) { m_drawTime += duration; }
+
+        uint32_t GetDrawingSessionCount() const { return m_drawingSessionCount; }
+        uint32_t GetPrimitiveCount(DrawingPrimitive primitive) const { return m_primitiveCounts[static_cast<int>(primitive)]; }
+        uint32_t GetBrushChangeCount() const { return m_brushChangeCount; }
+        uint32_t GetStrokeStyleChangeCount() const { return m_strokeStyleChangeCount; }
+        uint32_t GetEffectNodesRealizedCount() const { return m_effectNodesRealizedCount; }
+        uint64_t GetPixelBytesUploaded() const { return m_pixelBytesUploaded; }
+
+        // In 100ns units, to match Windows.Foundation.TimeSpan.
+        int64_t GetDrawTime() const { return m_drawTime; }
+
+        // The current time in 100ns units, for measuring draw time.
+        static int64_t GetTimestamp();
+
+        // The statistics that work on this thread is counted against, or
+        // null if none are being collected.
+        static DrawingStatistics* GetCurrent();
+
+    private:
+        friend class DrawingStatisticsScope;
+
+        static DrawingStatistics* SetCurrent(DrawingStatistics* statistics);
+    };
+
+
+    //
+    // Makes statistics current on this thread until the scope ends. Passing
+    // null does nothing, so that code which may or may not be collecting
+    // statistics does not hide the statistics of an enclosing scope.
+    //
+    class DrawingStatisticsScope
+    {
+        DrawingStatistics* m_statistics;
+        DrawingStatistics* m_previous;
+
+    public:
+        explicit DrawingStatisticsScope(DrawingStatistics* statistics)
+            : m_statistics(statistics)
+            , m_previous(nullptr)
+        {
+            if (m_statistics)
+                m_previous = DrawingStatistics::SetCurrent(m_statistics);
+        }
+
+        ~DrawingStatisticsScope()
+        {
+            if (m_statistics)
+                DrawingStatistics::SetCurrent(m_previous);
+        }
+
+    private:
+        DrawingStatisticsScope(DrawingStatisticsScope const&);
+        DrawingStatisticsScope& operator=(DrawingStatisticsScope const&);
+    };
+}}}}
@@ -0,0 +1,660 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PathData.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    // Distance of the control points along the tangents for a cubic bezier
+    // approximating a quarter ellipse: 4/3 * (sqrt(2) - 1).
+    static const float QuarterEllipseKappa = 0.5522847498f;
+
+    // Bounds the work done flattening a curve that is huge compared to the
+    // tolerance.
+    static const uint32_t MaxSubdivisionsPerCurve = 1000;
+
+
+    static D2D1_POINT_2F MakePoint(float x, float y)
+    {
+        return D2D1_POINT_2F{ x, y };
+    }
+
+
+    static PathSegment MakeLine(D2D1_POINT_2F const& endPoint)
+    {
+        PathSegment segment{};
+        segment.Type = PathSegmentType::Line;
+        segment.Points[0] = endPoint;
+        return segment;
+    }
+
+
+    static PathSegment MakeQuadraticBezier(D2D1_POINT_2F const& controlPoint, D2D1_POINT_2F const& endPoint)
+    {
+        PathSegment segment{};
+        segment.Type = PathSegmentType::QuadraticBezier;
+        segment.Points[0] = controlPoint;
+        segment.Points[1] = endPoint;
+        return segment;
+    }
+
+
+    static PathSegment MakeCubicBezier(D2D1_POINT_2F const& controlPoint1, D2D1_POINT_2F const& controlPoint2, D2D1_POINT_2F const& endPoint)
+    {
+        PathSegment segment{};
+        segment.Type = PathSegmentType::CubicBezier;
+        segment.Points[0] = controlPoint1;
+        segment.Points[1] = controlPoint2;
+        segment.Points[2] = endPoint;
+        return segment;
+    }
+
+
+    D2D1_POINT_2F const& PathSegment::GetEndPoint() const
+    {
+        switch (Type)
+        {
+        case PathSegmentType::Line:            return Points[0];
+        case PathSegmentType::QuadraticBezier: return Points[1];
+        default:                               return Points[2];
+        }
+    }
+
+
+    static uint32_t GetPointCount(PathSegmentType type)
+    {
+        switch (type)
+        {
+        case PathSegmentType::Line:            return 1;
+        case PathSegmentType::QuadraticBezier: return 2;
+        default:                               return 3;
+        }
+    }
+
+
+    //
+    // PathData
+    //
+
+    PathData::PathData()
+        : FillMode(D2D1_FILL_MODE_ALTERNATE)
+    {
+    }
+
+
+    bool PathData::IsEmpty() const
+    {
+        return Figures.empty();
+    }
+
+
+    PathData PathData::CreateRectangle(D2D1_RECT_F const& rect)
+    {
+        PathFigure figure;
+        figure.StartPoint = MakePoint(rect.left, rect.top);
+        figure.Segments.push_back(MakeLine(MakePoint(rect.right, rect.top)));
+        figure.Segments.push_back(MakeLine(MakePoint(rect.right, rect.bottom)));
+        figure.Segments.push_back(MakeLine(MakePoint(rect.left, rect.bottom)));
+        figure.IsClosed = true;
+
+        PathData pathData;
+        pathData.Figures.push_back(std::move(figure));
+        return pathData;
+    }
+
+
+    PathData PathData::CreateRoundedRectangle(D2D1_RECT_F const& rect, float radiusX, float radiusY)
+    {
+        float halfWidth = fabsf(rect.right - rect.left) / 2;
+        float halfHeight = fabsf(rect.bottom - rect.top) / 2;
+
+        // Like D2D, radii that are too large for the rectangle are clamped.
+        float rx = std::min(std::max(radiusX, 0.0f), halfWidth);
+        float ry = std::min(std::max(radiusY, 0.0f), halfHeight);
+
+        if (rx == 0 || ry == 0)
+            return CreateRectangle(rect);
+
+        float kx = rx * QuarterEllipseKappa;
+        float ky = ry * QuarterEllipseKappa;
+
+        float left = rect.left;
+        float top = rect.top;
+        float right = rect.right;
+        float bottom = rect.bottom;
+
+        PathFigure figure;
+        figure.StartPoint = MakePoint(left + rx, top);
+
+        figure.Segments.push_back(MakeLine(MakePoint(right - rx, top)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(right - rx + kx, top), MakePoint(right, top + ry - ky), MakePoint(right, top + ry)));
+        figure.Segments.push_back(MakeLine(MakePoint(right, bottom - ry)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(right, bottom - ry + ky), MakePoint(right - rx + kx, bottom), MakePoint(right - rx, bottom)));
+        figure.Segments.push_back(MakeLine(MakePoint(left + rx, bottom)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(left + rx - kx, bottom), MakePoint(left, bottom - ry + ky), MakePoint(left, bottom - ry)));
+        figure.Segments.push_back(MakeLine(MakePoint(left, top + ry)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(left, top + ry - ky), MakePoint(left + rx - kx, top), MakePoint(left + rx, top)));
+
+        figure.IsClosed = true;
+
+        PathData pathData;
+        pathData.Figures.push_back(std::move(figure));
+        return pathData;
+    }
+
+
+    PathData PathData::CreateEllipse(D2D1_POINT_2F const& center, float radiusX, float radiusY)
+    {
+        float cx = center.x;
+        float cy = center.y;
+        float rx = radiusX;
+        float ry = radiusY;
+        float kx = rx * QuarterEllipseKappa;
+        float ky = ry * QuarterEllipseKappa;
+
+        PathFigure figure;
+        figure.StartPoint = MakePoint(cx + rx, cy);
+
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(cx + rx, cy + ky), MakePoint(cx + kx, cy + ry), MakePoint(cx, cy + ry)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(cx - kx, cy + ry), MakePoint(cx - rx, cy + ky), MakePoint(cx - rx, cy)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(cx - rx, cy - ky), MakePoint(cx - kx, cy - ry), MakePoint(cx, cy - ry)));
+        figure.Segments.push_back(MakeCubicBezier(MakePoint(cx + kx, cy - ry), MakePoint(cx + rx, cy - ky), MakePoint(cx + rx, cy)));
+
+        figure.IsClosed = true;
+
+        PathData pathData;
+        pathData.Figures.push_back(std::move(figure));
+        return pathData;
+    }
+
+
+    PathData PathData::CreatePolygon(D2D1_POINT_2F const* points, uint32_t pointCount)
+    {
+        PathData pathData;
+
+        if (pointCount == 0)
+            return pathData;
+
+        PathFigure figure;
+        figure.StartPoint = points[0];
+
+        for (uint32_t i = 1; i < pointCount; i++)
+            figure.Segments.push_back(MakeLine(points[i]));
+
+        figure.IsClosed = true;
+
+        pathData.Figures.push_back(std::move(figure));
+        return pathData;
+    }
+
+
+    static D2D1_POINT_2F TransformPoint(D2D1_MATRIX_3X2_F const& m, D2D1_POINT_2F const& p)
+    {
+        return MakePoint(
+            p.x * m._11 + p.y * m._21 + m._31,
+            p.x * m._12 + p.y * m._22 + m._32);
+    }
+
+
+    PathData PathData::Transform(D2D1_MATRIX_3X2_F const& transform) const
+    {
+        PathData result(*this);
+
+        for (auto& figure : result.Figures)
+        {
+            figure.StartPoint = TransformPoint(transform, figure.StartPoint);
+
+            for (auto& segment : figure.Segments)
+            {
+                for (uint32_t i = 0; i < GetPointCount(segment.Type); i++)
+                {
+                    segment.Points[i] = TransformPoint(transform, segment.Points[i]);
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    static void IncludePoint(D2D1_RECT_F* bounds, D2D1_POINT_2F const& p)
+    {
+        bounds->left = std::min(bounds->left, p.x);
+        bounds->top = std::min(bounds->top, p.y);
+        bounds->right = std::max(bounds->right, p.x);
+        bounds->bottom = std::max(bounds->bottom, p.y);
+    }
+
+
+    static D2D1_POINT_2F EvaluateQuadratic(D2D1_POINT_2F const& p0, D2D1_POINT_2F const& p1, D2D1_POINT_2F const& p2, float t)
+    {
+        float u = 1 - t;
+
+        return MakePoint(
+            u * u * p0.x + 2 * u * t * p1.x + t * t * p2.x,
+            u * u * p0.y + 2 * u * t * p1.y + t * t * p2.y);
+    }
+
+
+    static D2D1_POINT_2F EvaluateCubic(D2D1_POINT_2F const& p0, D2D1_POINT_2F const& p1, D2D1_POINT_2F const& p2, D2D1_POINT_2F const& p3, float t)
+    {
+        float u = 1 - t;
+        float uu = u * u;
+        float tt = t * t;
+
+        return MakePoint(
+            uu * u * p0.x + 3 * uu * t * p1.x + 3 * u * tt * p2.x + tt * t * p3.x,
+            uu * u * p0.y + 3 * uu * t * p1.y + 3 * u * tt * p2.y + tt * t * p3.y);
+    }
+
+
+    // Finds the roots in (0, 1) of a*t^2 + b*t + c, returning how many were found.
+    static int SolveQuadraticInUnitInterval(float a, float b, float c, float roots[2])
+    {
+        int count = 0;
+
+        auto add = [&](float t)
+        {
+            if (t > 0 && t < 1)
+                roots[count++] = t;
+        };
+
+        if (fabsf(a) < 1e-12f)
+        {
+            if (fabsf(b) >= 1e-12f)
+                add(-c / b);
+        }
+        else
+        {
+            float discriminant = b * b - 4 * a * c;
+
+            if (discriminant >= 0)
+            {
+                float root = sqrtf(discriminant);
+                add((-b + root) / (2 * a));
+                add((-b - root) / (2 * a));
+            }
+        }
+
+        return count;
+    }
+
+
+    static void IncludeQuadraticExtrema(D2D1_RECT_F* bounds, D2D1_POINT_2F const& p0, D2D1_POINT_2F const& p1, D2D1_POINT_2F const& p2)
+    {
+        // The derivative is linear, so each axis has at most one extremum.
+        float denominatorX = p0.x - 2 * p1.x + p2.x;
+        float denominatorY = p0.y - 2 * p1.y + p2.y;
+
+        float roots[2];
+        int count = 0;
+
+        if (denominatorX != 0)
+            count += SolveQuadraticInUnitInterval(0, denominatorX, p1.x - p0.x, roots + count);
+
+        if (denominatorY != 0)
+            count += SolveQuadraticInUnitInterval(0, denominatorY, p1.y - p0.y, roots + count);
+
+        for (int i = 0; i < count; i++)
+            IncludePoint(bounds, EvaluateQuadratic(p0, p1, p2, roots[i]));
+    }
+
+
+    static void IncludeCubicExtrema(D2D1_RECT_F* bounds, D2D1_POINT_2F const& p0, D2D1_POINT_2F const& p1, D2D1_POINT_2F const& p2, D2D1_POINT_2F const& p3)
+    {
+        float roots[2];
+
+        // The derivative divided by three is a*t^2 + b*t + c.
+        int count = SolveQuadraticInUnitInterval(
+            -p0.x + 3 * p1.x - 3 * p2.x + p3.x,
+            2 * (p0.x - 2 * p1.x + p2.x),
+            p1.x - p0.x,
+            roots);
+
+        for (int i = 0; i < count; i++)
+            IncludePoint(bounds, EvaluateCubic(p0, p1, p2, p3, roots[i]));
+
+        count = SolveQuadraticInUnitInterval(
+            -p0.y + 3 * p1.y - 3 * p2.y + p3.y,
+            2 * (p0.y - 2 * p1.y + p2.y),
+            p1.y - p0.y,
+            roots);
+
+        for (int i = 0; i < count; i++)
+            IncludePoint(bounds, EvaluateCubic(p0, p1, p2, p3, roots[i]));
+    }
+
+
+    D2D1_RECT_F PathData::ComputeBounds() const
+    {
+        D2D1_RECT_F bounds{ FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        for (auto& figure : Figures)
+        {
+            auto currentPoint = figure.StartPoint;
+            IncludePoint(&bounds, currentPoint);
+
+            for (auto& segment : figure.Segments)
+            {
+                auto& p = segment.Points;
+
+                switch (segment.Type)
+                {
+                case PathSegmentType::QuadraticBezier:
+                    IncludeQuadraticExtrema(&bounds, currentPoint, p[0], p[1]);
+                    break;
+
+                case PathSegmentType::CubicBezier:
+                    IncludeCubicExtrema(&bounds, currentPoint, p[0], p[1], p[2]);
+                    break;
+
+                default:
+                    break;
+                }
+
+                currentPoint = segment.GetEndPoint();
+                IncludePoint(&bounds, currentPoint);
+            }
+        }
+
+        return bounds;
+    }
+
+
+    static float Length(float x, float y)
+    {
+        return sqrtf(x * x + y * y);
+    }
+
+
+    //
+    // The distance between a polynomial curve and the chords of a uniform
+    // subdivision into n pieces is bounded by its second derivative. For a
+    // quadratic that gives |p0 - 2p1 + p2| / (4n^2), and for a cubic
+    // 3 * max(|p0 - 2p1 + p2|, |p1 - 2p2 + p3|) / (4n^2).
+    //
+    static uint32_t GetSubdivisionCount(float secondDifference, float tolerance)
+    {
+        float n = ceilf(sqrtf(secondDifference / (4 * tolerance)));
+
+        if (!(n >= 1))
+            return 1;
+
+        return static_cast<uint32_t>(std::min(n, static_cast<float>(MaxSubdivisionsPerCurve)));
+    }
+
+
+    std::vector<Polyline> PathData::Flatten(float tolerance) const
+    {
+        assert(tolerance > 0);
+
+        std::vector<Polyline> polylines;
+        polylines.reserve(Figures.size());
+
+        for (auto& figure : Figures)
+        {
+            Polyline polyline;
+            polyline.push_back(figure.StartPoint);
+
+            for (auto& segment : figure.Segments)
+            {
+                auto p0 = polyline.back();
+                auto& p = segment.Points;
+
+                switch (segment.Type)
+                {
+                case PathSegmentType::Line:
+                    polyline.push_back(p[0]);
+                    break;
+
+                case PathSegmentType::QuadraticBezier:
+                    {
+                        auto n = GetSubdivisionCount(
+                            Length(p0.x - 2 * p[0].x + p[1].x, p0.y - 2 * p[0].y + p[1].y),
+                            tolerance);
+
+                        for (uint32_t i = 1; i < n; i++)
+                            polyline.push_back(EvaluateQuadratic(p0, p[0], p[1], static_cast<float>(i) / n));
+
+                        polyline.push_back(p[1]);
+                    }
+                    break;
+
+                case PathSegmentType::CubicBezier:
+                    {
+                        auto d1 = Length(p0.x - 2 * p[0].x + p[1].x, p0.y - 2 * p[0].y + p[1].y);
+                        auto d2 = Length(p[0].x - 2 * p[1].x + p[2].x, p[0].y - 2 * p[1].y + p[2].y);
+
+                        auto n = GetSubdivisionCount(3 * std::max(d1, d2), tolerance);
+
+                        for (uint32_t i = 1; i < n; i++)
+                            polyline.push_back(EvaluateCubic(p0, p[0], p[1], p[2], static_cast<float>(i) / n));
+
+                        polyline.push_back(p[2]);
+                    }
+                    break;
+                }
+            }
+
+            if (figure.IsClosed)
+                polyline.push_back(figure.StartPoint);
+
+            polylines.push_back(std::move(polyline));
+        }
+
+        return polylines;
+    }
+
+
+    void PathData::StreamTo(ID2D1GeometrySink* sink) const
+    {
+        sink->SetFillMode(FillMode);
+
+        for (auto& figure : Figures)
+        {
+            sink->BeginFigure(figure.StartPoint, D2D1_FIGURE_BEGIN_FILLED);
+
+            for (auto& segment : figure.Segments)
+            {
+                auto& p = segment.Points;
+
+                switch (segment.Type)
+                {
+                case PathSegmentType::Line:
+                    sink->AddLine(p[0]);
+                    break;
+
+                case PathSegmentType::QuadraticBezier:
+                    sink->AddQuadraticBezier(D2D1_QUADRATIC_BEZIER_SEGMENT{ p[0], p[1] });
+                    break;
+
+                case PathSegmentType::CubicBezier:
+                    sink->AddBezier(D2D1_BEZIER_SEGMENT{ p[0], p[1], p[2] });
+                    break;
+                }
+            }
+
+            sink->EndFigure(figure.IsClosed ? D2D1_FIGURE_END_CLOSED : D2D1_FIGURE_END_OPEN);
+        }
+    }
+
+
+    //
+    // PathBuilder
+    //
+
+    PathBuilder::PathBuilder()
+        : m_isInFigure(false)
+    {
+    }
+
+
+    void PathBuilder::BeginFigure(D2D1_POINT_2F const& startPoint)
+    {
+        if (m_isInFigure)
+            ThrowHR(E_ILLEGAL_METHOD_CALL, HStringReference(Strings::CanvasPathBuilderFigureAlreadyBegun).Get());
+
+        PathFigure figure;
+        figure.StartPoint = startPoint;
+        figure.IsClosed = false;
+
+        m_pathData.Figures.push_back(std::move(figure));
+        m_isInFigure = true;
+    }
+
+
+    void PathBuilder::AddLine(D2D1_POINT_2F const& endPoint)
+    {
+        AddSegment(MakeLine(endPoint));
+    }
+
+
+    void PathBuilder::AddQuadraticBezier(D2D1_POINT_2F const& controlPoint, D2D1_POINT_2F const& endPoint)
+    {
+        AddSegment(MakeQuadraticBezier(controlPoint, endPoint));
+    }
+
+
+    void PathBuilder::AddCubicBezier(D2D1_POINT_2F const& controlPoint1, D2D1_POINT_2F const& controlPoint2, D2D1_POINT_2F const& endPoint)
+    {
+        AddSegment(MakeCubicBezier(controlPoint1, controlPoint2, endPoint));
+    }
+
+
+    void PathBuilder::EndFigure(bool isClosed)
+    {
+        ThrowIfNotInFigure();
+
+        m_pathData.Figures.back().IsClosed = isClosed;
+        m_isInFigure = false;
+    }
+
+
+    void PathBuilder::SetFillMode(D2D1_FILL_MODE fillMode)
+    {
+        m_pathData.FillMode = fillMode;
+    }
+
+
+    bool PathBuilder::IsInFigure() const
+    {
+        return m_isInFigure;
+    }
+
+
+    PathData PathBuilder::TakePathData()
+    {
+        if (m_isInFigure)
+            ThrowHR(E_ILLEGAL_METHOD_CALL, HStringReference(Strings::CanvasPathBuilderFigureNotEnded).Get());
+
+        PathData pathData;
+        pathData.FillMode = m_pathData.FillMode;
+        pathData.Figures.swap(m_pathData.Figures);
+
+        m_pathData.FillMode = D2D1_FILL_MODE_ALTERNATE;
+
+        return pathData;
+    }
+
+
+    void PathBuilder::ThrowIfNotInFigure() const
+    {
+        if (!m_isInFigure)
+            ThrowHR(E_ILLEGAL_METHOD_CALL, HStringReference(Strings::CanvasPathBuilderNoFigure).Get());
+    }
+
+
+    void PathBuilder::AddSegment(PathSegment const& segment)
+    {
+        ThrowIfNotInFigure();
+
+        m_pathData.Figures.back().Segments.push_back(segment);
+    }
+
+
+    //
+    // PathDataSink
+    //
+
+    PathDataSink::PathDataSink()
+        : m_isInFigure(false)
+    {
+    }
+
+
+    PathData& PathDataSink::GetPathData()
+    {
+        return m_pathData;
+    }
+
+
+    IFACEMETHODIMP_(void) PathDataSink::SetFillMode(D2D1_FILL_MODE fillMode)
+    {
+        m_pathData.FillMode = fillMode;
+    }
+
+
+    IFACEMETHODIMP_(void) PathDataSink::SetSegmentFlags(D2D1_PATH_SEGMENT)
+    {
+    }
+
+
+    IFACEMETHODIMP_(void) PathDataSink::BeginFigure(D2D1_POINT_2F startPoint, D2D1_FIGURE_BEGIN)
+    {
+        assert(!m_isInFigure);
+
+        PathFigure figure;
+        figure.StartPoint = startPoint;
+        figure.IsClosed = false;
+
+        m_pathData.Figures.push_back(std::move(figure));
+        m_isInFigure = true;
+    }
+
+
+    IFACEMETHODIMP_(void) PathDataSink::AddLines(D2D1_POINT_2F const* points, UINT32 pointsCount)
+    {
+        assert(m_isInFigure);
+
+        auto& segments = m_pathData.Figures.back().Segments;
+
+        for (UINT32 i = 0; i < pointsCount; i++)
+            segments.push_back(MakeLine(points[i]));
+    }
+
+
+    IFACEMETHODIMP_(void) PathDataSink::AddBeziers(D2D1_BEZIER_SEGMENT const* beziers, UINT32 beziersCount)
+    {
+        assert(m_isInFigure);
+
+        auto& segments = m_pathData.Figures.back().Segments;
+
+        for (UINT32 i = 0; i < beziersCount; i++)
+            segments.push_back(MakeCubicBezier(beziers[i].point1, beziers[i].point2, beziers[i].point3));
+    }
+
+
+    IFACEMETHODIMP_(void) PathDataSink::EndFigure(D2D1_FIGURE_END figureEnd)
+    {
+        assert(m_isInFigure);
+
+        m_pathData.Figures.back().IsClosed = (figureEnd == D2D1_FIGURE_END_CLOSED);
+        m_isInFigure = false;
+    }
+
+
+    IFACEMETHODIMP PathDataSink::Close()
+    {
+        return S_OK;
+    }
+}}}}
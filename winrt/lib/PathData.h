@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    enum class PathSegmentType
+    {
+        Line,
+        QuadraticBezier,
+        CubicBezier
+    };
+
+    struct PathSegment
+    {
+        PathSegmentType Type;
+
+        // Any control points, followed by the end point. Lines use one
+        // point, quadratic beziers two and cubic beziers all three.
+        D2D1_POINT_2F Points[3];
+
+        D2D1_POINT_2F const& GetEndPoint() const;
+    };
+
+    struct PathFigure
+    {
+        D2D1_POINT_2F StartPoint;
+        std::vector<PathSegment> Segments;
+        bool IsClosed;
+    };
+
+    typedef std::vector<D2D1_POINT_2F> Polyline;
+
+    //
+    // The outline of a CanvasGeometry, held on the CPU so that geometries
+    // can be built, transformed and measured without a device. It is only
+    // turned into a D2D path geometry when it is drawn.
+    //
+    class PathData
+    {
+    public:
+        PathData();
+
+        D2D1_FILL_MODE FillMode;
+        std::vector<PathFigure> Figures;
+
+        static PathData CreateRectangle(D2D1_RECT_F const& rect);
+        static PathData CreateRoundedRectangle(D2D1_RECT_F const& rect, float radiusX, float radiusY);
+        static PathData CreateEllipse(D2D1_POINT_2F const& center, float radiusX, float radiusY);
+        static PathData CreatePolygon(D2D1_POINT_2F const* points, uint32_t pointCount);
+
+        // Affine transforms map beziers onto beziers, so this is exact.
+        PathData Transform(D2D1_MATRIX_3X2_F const& transform) const;
+
+        // The tight bounds of the outline, including the curves' extrema
+        // rather than their control points. Empty paths have left > right.
+        D2D1_RECT_F ComputeBounds() const;
+
+        //
+        // Approximates each figure with line segments that are no further
+        // than tolerance from the true curve. Closed figures end with a copy
+        // of their start point.
+        //
+        std::vector<Polyline> Flatten(float tolerance) const;
+
+        void StreamTo(ID2D1GeometrySink* sink) const;
+
+        bool IsEmpty() const;
+    };
+
+
+    //
+    // Collects figures one segment at a time, checking that segments are only
+    // added to a figure that has been begun. Used by CanvasPathBuilder.
+    //
+    class PathBuilder
+    {
+    public:
+        PathBuilder();
+
+        void BeginFigure(D2D1_POINT_2F const& startPoint);
+        void AddLine(D2D1_POINT_2F const& endPoint);
+        void AddQuadraticBezier(D2D1_POINT_2F const& controlPoint, D2D1_POINT_2F const& endPoint);
+        void AddCubicBezier(D2D1_POINT_2F const& controlPoint1, D2D1_POINT_2F const& controlPoint2, D2D1_POINT_2F const& endPoint);
+        void EndFigure(bool isClosed);
+
+        void SetFillMode(D2D1_FILL_MODE fillMode);
+
+        bool IsInFigure() const;
+
+        // Hands over the figures collected so far, leaving the builder empty.
+        PathData TakePathData();
+
+    private:
+        void ThrowIfNotInFigure() const;
+        void AddSegment(PathSegment const& segment);
+
+        PathData m_pathData;
+        bool m_isInFigure;
+    };
+
+
+    //
+    // Captures the output of D2D geometry operations, such as
+    // CombineWithGeometry, back into a PathData.
+    //
+    class PathDataSink : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        ID2D1SimplifiedGeometrySink>
+    {
+        PathData m_pathData;
+        bool m_isInFigure;
+
+    public:
+        PathDataSink();
+
+        PathData& GetPathData();
+
+        IFACEMETHOD_(void, SetFillMode)(D2D1_FILL_MODE fillMode) override;
+        IFACEMETHOD_(void, SetSegmentFlags)(D2D1_PATH_SEGMENT vertexFlags) override;
+        IFACEMETHOD_(void, BeginFigure)(D2D1_POINT_2F startPoint, D2D1_FIGURE_BEGIN figureBegin) override;
+        IFACEMETHOD_(void, AddLines)(D2D1_POINT_2F const* points, UINT32 pointsCount) override;
+        IFACEMETHOD_(void, AddBeziers)(D2D1_BEZIER_SEGMENT const* beziers, UINT32 beziersCount) override;
+        IFACEMETHOD_(void, EndFigure)(D2D1_FIGURE_END figureEnd) override;
+        IFACEMETHOD(Close)() override;
+    };
+}}}}
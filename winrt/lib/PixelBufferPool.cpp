@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PixelBufferPool.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // PixelBuffer
+    //
+
+    PixelBuffer::PixelBuffer(
+        std::shared_ptr<PixelBufferPool> pool,
+        std::vector<BYTE>&& data,
+        uint32_t width,
+        uint32_t height,
+        uint32_t stride)
+        : m_pool(pool)
+        , m_data(std::move(data))
+        , m_width(width)
+        , m_height(height)
+        , m_stride(stride)
+    {
+    }
+
+
+    PixelBuffer::~PixelBuffer()
+    {
+        m_pool->Release(std::move(m_data));
+    }
+
+
+    BYTE* PixelBuffer::GetData()
+    {
+        return m_data.data();
+    }
+
+
+    uint32_t PixelBuffer::GetSize() const
+    {
+        return static_cast<uint32_t>(m_data.size());
+    }
+
+
+    uint32_t PixelBuffer::GetWidth() const
+    {
+        return m_width;
+    }
+
+
+    uint32_t PixelBuffer::GetHeight() const
+    {
+        return m_height;
+    }
+
+
+    uint32_t PixelBuffer::GetStride() const
+    {
+        return m_stride;
+    }
+
+
+    //
+    // PixelBufferPool
+    //
+
+    PixelBufferPool::PixelBufferPool(uint32_t maxPooled)
+        : m_maxPooled(maxPooled)
+        , m_outstanding(0)
+    {
+        if (maxPooled == 0)
+            ThrowHR(E_INVALIDARG);
+    }
+
+
+    std::shared_ptr<PixelBuffer> PixelBufferPool::Acquire(uint32_t width, uint32_t height, uint32_t stride)
+    {
+        size_t size = static_cast<size_t>(stride) * height;
+
+        std::vector<BYTE> data;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Prefer a pooled buffer that is already big enough, so that
+            // saving the same size of bitmap over and over never reallocates.
+            auto it = std::find_if(m_pooled.begin(), m_pooled.end(),
+                [=](std::vector<BYTE> const& candidate) { return candidate.capacity() >= size; });
+
+            if (it == m_pooled.end() && !m_pooled.empty())
+                it = m_pooled.end() - 1;
+
+            if (it != m_pooled.end())
+            {
+                data = std::move(*it);
+                m_pooled.erase(it);
+            }
+
+            m_outstanding++;
+        }
+
+        try
+        {
+            data.resize(size);
+
+            return std::make_shared<PixelBuffer>(shared_from_this(), std::move(data), width, height, stride);
+        }
+        catch (...)
+        {
+            Release(std::move(data));
+            throw;
+        }
+    }
+
+
+    uint32_t PixelBufferPool::GetOutstandingCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_outstanding;
+    }
+
+
+    uint32_t PixelBufferPool::GetPooledCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<uint32_t>(m_pooled.size());
+    }
+
+
+    void PixelBufferPool::Release(std::vector<BYTE>&& data)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        assert(m_outstanding > 0);
+        m_outstanding--;
+
+        if (data.capacity() > 0 && m_pooled.size() < m_maxPooled)
+            m_pooled.push_back(std::move(data));
+    }
+}}}}
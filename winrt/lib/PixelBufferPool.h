@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    class PixelBufferPool;
+
+    //
+    // A CPU copy of a bitmap's pixels, waiting to be encoded. The memory goes
+    // back to the pool it came from when this is destroyed.
+    //
+    class PixelBuffer
+    {
+        std::shared_ptr<PixelBufferPool> m_pool;
+        std::vector<BYTE> m_data;
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_stride;
+
+    public:
+        PixelBuffer(
+            std::shared_ptr<PixelBufferPool> pool,
+            std::vector<BYTE>&& data,
+            uint32_t width,
+            uint32_t height,
+            uint32_t stride);
+
+        ~PixelBuffer();
+
+        PixelBuffer(PixelBuffer const&) = delete;
+        PixelBuffer& operator=(PixelBuffer const&) = delete;
+
+        BYTE* GetData();
+        uint32_t GetSize() const;
+
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+        uint32_t GetStride() const;
+    };
+
+    //
+    // Hands out the buffers that bitmaps are copied into while they are being
+    // saved, reusing the memory from earlier saves.
+    //
+    // Acquire is called on the thread that starts the save, which may be the
+    // UI thread, so it never waits. If every pooled buffer is in use it
+    // allocates a new one. Only maxPooled buffers are kept once they are
+    // released, so a burst of saves does not keep its memory around forever.
+    //
+    class PixelBufferPool : public std::enable_shared_from_this<PixelBufferPool>
+    {
+    public:
+        static const uint32_t DefaultMaxPooled = 4;
+
+        PixelBufferPool(uint32_t maxPooled = DefaultMaxPooled);
+
+        std::shared_ptr<PixelBuffer> Acquire(uint32_t width, uint32_t height, uint32_t stride);
+
+        uint32_t GetOutstandingCount();
+        uint32_t GetPooledCount();
+
+    private:
+        friend class PixelBuffer;
+
+        void Release(std::vector<BYTE>&& data);
+
+        std::mutex m_mutex;
+
+        uint32_t m_maxPooled;
+        uint32_t m_outstanding;
+
+        std::vector<std::vector<BYTE>> m_pooled;
+    };
+}}}}
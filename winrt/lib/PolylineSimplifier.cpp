@@ -0,0 +1,266 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "PolylineSimplifier.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    const float PolylineSimplifier::DefaultTolerance = 0.25f;
+
+    static const uint8_t Inside = 0;
+    static const uint8_t Left = 1;
+    static const uint8_t Right = 2;
+    static const uint8_t Above = 4;
+    static const uint8_t Below = 8;
+    static const uint8_t NotFinite = 16;
+
+    static uint8_t GetOutcode(D2D1_POINT_2F const& p, D2D1_RECT_F const& rect)
+    {
+        if (!isfinite(p.x) || !isfinite(p.y))
+            return Left | Right | Above | Below | NotFinite;
+
+        uint8_t outcode = Inside;
+
+        if (p.x < rect.left)
+            outcode |= Left;
+        else if (p.x > rect.right)
+            outcode |= Right;
+
+        if (p.y < rect.top)
+            outcode |= Above;
+        else if (p.y > rect.bottom)
+            outcode |= Below;
+
+        return outcode;
+    }
+
+    // A segment whose ends are both off the same edge of the rectangle
+    // cannot cross it. Other segments may, so they are kept.
+    static bool MayBeVisible(uint8_t outcode0, uint8_t outcode1)
+    {
+        if ((outcode0 | outcode1) & NotFinite)
+            return false;
+
+        return (outcode0 & outcode1) == 0;
+    }
+
+    static float DistanceSquaredToSegment(D2D1_POINT_2F const& p, D2D1_POINT_2F const& a, D2D1_POINT_2F const& b)
+    {
+        auto dx = b.x - a.x;
+        auto dy = b.y - a.y;
+        auto px = p.x - a.x;
+        auto py = p.y - a.y;
+
+        auto lengthSquared = dx * dx + dy * dy;
+
+        if (lengthSquared > 0)
+        {
+            auto t = (px * dx + py * dy) / lengthSquared;
+
+            if (t >= 1)
+            {
+                px = p.x - b.x;
+                py = p.y - b.y;
+            }
+            else if (t > 0)
+            {
+                px -= t * dx;
+                py -= t * dy;
+            }
+        }
+
+        return px * px + py * py;
+    }
+
+
+    void PolylineSimplifier::Simplify(
+        D2D1_POINT_2F const* points,
+        uint32_t pointCount,
+        D2D1_MATRIX_3X2_F const& transform,
+        D2D1_RECT_F const& visibleRect,
+        float tolerance)
+    {
+        assert(tolerance > 0);
+
+        m_points.clear();
+        m_runLengths.clear();
+
+        if (pointCount < 2)
+            return;
+
+        auto& matrix = *reinterpret_cast<D2D1::Matrix3x2F const*>(&transform);
+
+        m_targetPoints.resize(pointCount);
+
+        for (uint32_t i = 0; i < pointCount; i++)
+            m_targetPoints[i] = matrix.TransformPoint(points[i]);
+
+        // Split the line into runs of segments that may be visible.
+        bool inRun = false;
+        uint32_t runStart = 0;
+        auto previousOutcode = GetOutcode(m_targetPoints[0], visibleRect);
+
+        for (uint32_t i = 1; i < pointCount; i++)
+        {
+            auto outcode = GetOutcode(m_targetPoints[i], visibleRect);
+
+            if (MayBeVisible(previousOutcode, outcode))
+            {
+                if (!inRun)
+                {
+                    runStart = i - 1;
+                    inRun = true;
+                }
+            }
+            else if (inRun)
+            {
+                AddRun(points, runStart, i - 1, tolerance);
+                inRun = false;
+            }
+
+            previousOutcode = outcode;
+        }
+
+        if (inRun)
+            AddRun(points, runStart, pointCount - 1, tolerance);
+    }
+
+
+    void PolylineSimplifier::AddRun(D2D1_POINT_2F const* points, uint32_t first, uint32_t last, float tolerance)
+    {
+        // Each of the two passes may move the line by up to half the
+        // tolerance.
+        DecimateColumns(first, last, tolerance / 2);
+        KeepFurthestPoints(tolerance / 2);
+
+        uint32_t runLength = 0;
+
+        for (size_t i = 0; i < m_indices.size(); i++)
+        {
+            if (!m_keep[i])
+                continue;
+
+            m_points.push_back(points[m_indices[i]]);
+            runLength++;
+        }
+
+        m_runLengths.push_back(runLength);
+    }
+
+
+    //
+    // Consecutive points that fall in the same narrow column can be
+    // replaced by the first, the lowest, the highest and the last of them,
+    // since every other point lies within one column width of the line
+    // between those. This is what makes dense data, such as a chart with
+    // many samples per pixel, cheap: the run shrinks to a few points per
+    // column whatever the sample count.
+    //
+    void PolylineSimplifier::DecimateColumns(uint32_t first, uint32_t last, float columnWidth)
+    {
+        m_indices.clear();
+
+        auto groupStart = first;
+
+        while (groupStart <= last)
+        {
+            auto column = floorf(m_targetPoints[groupStart].x / columnWidth);
+
+            auto groupEnd = groupStart;
+            auto lowest = groupStart;
+            auto highest = groupStart;
+
+            while (groupEnd < last && floorf(m_targetPoints[groupEnd + 1].x / columnWidth) == column)
+            {
+                groupEnd++;
+
+                if (m_targetPoints[groupEnd].y < m_targetPoints[lowest].y)
+                    lowest = groupEnd;
+
+                if (m_targetPoints[groupEnd].y > m_targetPoints[highest].y)
+                    highest = groupEnd;
+            }
+
+            m_indices.push_back(groupStart);
+
+            auto firstExtreme = std::min(lowest, highest);
+            auto secondExtreme = std::max(lowest, highest);
+
+            if (firstExtreme != groupStart && firstExtreme != groupEnd)
+                m_indices.push_back(firstExtreme);
+
+            if (secondExtreme != firstExtreme && secondExtreme != groupStart && secondExtreme != groupEnd)
+                m_indices.push_back(secondExtreme);
+
+            if (groupEnd != groupStart)
+                m_indices.push_back(groupEnd);
+
+            groupStart = groupEnd + 1;
+        }
+    }
+
+
+    //
+    // Douglas-Peucker: keep the point furthest from the line between the
+    // ends of a span if it is further than the tolerance, and repeat on
+    // both halves. An explicit stack keeps long runs from exhausting the
+    // call stack.
+    //
+    void PolylineSimplifier::KeepFurthestPoints(float tolerance)
+    {
+        auto count = static_cast<uint32_t>(m_indices.size());
+
+        m_keep.assign(count, 0);
+        m_keep[0] = 1;
+        m_keep[count - 1] = 1;
+
+        auto toleranceSquared = tolerance * tolerance;
+
+        m_stack.clear();
+        m_stack.push_back(std::make_pair(0U, count - 1));
+
+        while (!m_stack.empty())
+        {
+            auto span = m_stack.back();
+            m_stack.pop_back();
+
+            if (span.second <= span.first + 1)
+                continue;
+
+            auto& a = m_targetPoints[m_indices[span.first]];
+            auto& b = m_targetPoints[m_indices[span.second]];
+
+            float furthestDistanceSquared = 0;
+            uint32_t furthest = span.first;
+
+            for (auto i = span.first + 1; i < span.second; i++)
+            {
+                auto distanceSquared = DistanceSquaredToSegment(m_targetPoints[m_indices[i]], a, b);
+
+                if (distanceSquared > furthestDistanceSquared)
+                {
+                    furthestDistanceSquared = distanceSquared;
+                    furthest = i;
+                }
+            }
+
+            if (furthestDistanceSquared > toleranceSquared)
+            {
+                m_keep[furthest] = 1;
+                m_stack.push_back(std::make_pair(span.first, furthest));
+                m_stack.push_back(std::make_pair(furthest, span.second));
+            }
+        }
+    }
+}}}}
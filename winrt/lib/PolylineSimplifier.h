@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Reduces a polyline to the parts that can be seen on a render target,
+    // and to the points that make a visible difference there, so that very
+    // long lines such as charts do not send millions of off-screen or
+    // sub-pixel segments to D2D.
+    //
+    // Points are compared after the transform, in the same units as the
+    // visible rectangle. The result is a subset of the input points, so it
+    // is drawn with the original transform. Segments that cannot touch the
+    // visible rectangle split the polyline into separate runs.
+    //
+    // The buffers are kept between calls so that drawing a polyline every
+    // frame does not allocate once they have grown.
+    //
+    class PolylineSimplifier
+    {
+        std::vector<D2D1_POINT_2F> m_targetPoints;
+        std::vector<uint32_t> m_indices;
+        std::vector<uint8_t> m_keep;
+        std::vector<std::pair<uint32_t, uint32_t>> m_stack;
+
+        std::vector<D2D1_POINT_2F> m_points;
+        std::vector<uint32_t> m_runLengths;
+
+    public:
+        // How far, in pixels, the simplified line may stray from the
+        // original. Small enough to make no visible difference with
+        // antialiasing.
+        static const float DefaultTolerance;
+
+        void Simplify(
+            D2D1_POINT_2F const* points,
+            uint32_t pointCount,
+            D2D1_MATRIX_3X2_F const& transform,
+            D2D1_RECT_F const& visibleRect,
+            float tolerance);
+
+        // The points of every run, one run after another.
+        std::vector<D2D1_POINT_2F> const& GetPoints() const { return m_points; }
+        std::vector<uint32_t> const& GetRunLengths() const { return m_runLengths; }
+
+    private:
+        void AddRun(D2D1_POINT_2F const* points, uint32_t first, uint32_t last, float tolerance);
+        void DecimateColumns(uint32_t first, uint32_t last, float columnWidth);
+        void KeepFurthestPoints(float tolerance);
+    };
+}}}}
@@ -12,6 +12,7 @@
 
 #include "pch.h"
 
+#include "BlockCompression.h"
 #include "CanvasBitmap.h"
 #include "CanvasDevice.h"
 #include "CanvasRenderTarget.h"
@@ -77,16 +78,75 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ThrowHR(E_INVALIDARG, message.Get());
     }
 
-    void SaveLockedMemoryToNativeStream(
+    ComPtr<IWICBitmapSource> TryDecodeAtReducedSize(
+        IWICImagingFactory* wicFactory,
+        IWICBitmapFrameDecode* frame,
+        BitmapSize imageSize,
+        BitmapSize targetSize)
+    {
+        ComPtr<IWICBitmapSourceTransform> transform;
+        if (FAILED(frame->QueryInterface(IID_PPV_ARGS(&transform))))
+            return nullptr;
+
+        BitmapSize decodeSize = targetSize;
+        if (FAILED(transform->GetClosestSize(&decodeSize.Width, &decodeSize.Height)))
+            return nullptr;
+
+        bool isSmaller = decodeSize.Width < imageSize.Width || decodeSize.Height < imageSize.Height;
+        bool isBigEnough = decodeSize.Width >= targetSize.Width && decodeSize.Height >= targetSize.Height;
+
+        if (!isSmaller || !isBigEnough)
+            return nullptr;
+
+        // Decoders only scale natively in their own formats (24bppBGR for
+        // JPEG), so decode in whatever the transform picks.  The caller's
+        // format converter turns this into the format we upload.
+        WICPixelFormatGUID pixelFormat;
+        ThrowIfFailed(frame->GetPixelFormat(&pixelFormat));
+
+        if (FAILED(transform->GetClosestPixelFormat(&pixelFormat)))
+            return nullptr;
+
+        // The WIC bitmap works out the stride for us, and refuses formats it
+        // cannot hold, in which case we fall back to the full size decode.
+        ComPtr<IWICBitmap> bitmap;
+        if (FAILED(wicFactory->CreateBitmap(decodeSize.Width, decodeSize.Height, pixelFormat, WICBitmapCacheOnDemand, &bitmap)))
+            return nullptr;
+
+        ComPtr<IWICBitmapLock> bitmapLock;
+        ThrowIfFailed(bitmap->Lock(nullptr, WICBitmapLockWrite, &bitmapLock));
+
+        UINT stride;
+        UINT bufferSize;
+        BYTE* buffer;
+        ThrowIfFailed(bitmapLock->GetStride(&stride));
+        ThrowIfFailed(bitmapLock->GetDataPointer(&bufferSize, &buffer));
+
+        ThrowIfFailed(transform->CopyPixels(
+            nullptr,
+            decodeSize.Width,
+            decodeSize.Height,
+            &pixelFormat,
+            WICBitmapTransformRotate0,
+            stride,
+            bufferSize,
+            buffer));
+
+        return bitmap;
+    }
+
+    // Pixels are handed to the encoder this many bytes at a time, so that it
+    // can start writing out the image without a second full size copy.
+    static const unsigned int EncodeStripeSizeInBytes = 256 * 1024;
+
+    void SavePixelBufferToNativeStream(
         IWICImagingFactory2* wicFactory,
         IWICStream* nativeStream,
         GUID encoderGuid,
         float quality,
-        unsigned int width,
-        unsigned int height,
         float dpiX,
         float dpiY,
-        ScopedBitmapLock* bitmapLock)
+        PixelBuffer* pixels)
     {
         ComPtr<IWICBitmapEncoder> encoder;
         ThrowIfFailed(wicFactory->CreateEncoder(encoderGuid, NULL, &encoder));
@@ -118,26 +178,51 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         ThrowIfFailed(frameEncode->Initialize(frameProperties.Get()));
 
+        const unsigned int width = pixels->GetWidth();
+        const unsigned int height = pixels->GetHeight();
+        const unsigned int stride = pixels->GetStride();
+
         ThrowIfFailed(frameEncode->SetSize(width, height));
 
         // TODO: #2767 Support saving formats other than 32bppBGRA.
-        ComPtr<IWICBitmap> memoryBitmap;
-        ThrowIfFailed(wicFactory->CreateBitmapFromMemory(
-            width,
-            height,
-            GUID_WICPixelFormat32bppBGRA,
-            bitmapLock->GetStride(),
-            bitmapLock->GetLockedBufferSize(),
-            static_cast<BYTE*>(bitmapLock->GetLockedData()),
-            &memoryBitmap));
-
-        WICPixelFormatGUID pixelFormat;
-        ThrowIfFailed(memoryBitmap->GetPixelFormat(&pixelFormat));
+        WICPixelFormatGUID pixelFormat = GUID_WICPixelFormat32bppBGRA;
         ThrowIfFailed(frameEncode->SetPixelFormat(&pixelFormat));
 
+        // Encoders that cannot store BGRA (eg. JPEG) change pixelFormat to the
+        // closest format they do support. WritePixels does not convert, so in
+        // that case each stripe goes through WriteSource instead.
+        const bool needsConversion = !IsEqualGUID(pixelFormat, GUID_WICPixelFormat32bppBGRA);
+
         ThrowIfFailed(frameEncode->SetResolution(dpiX, dpiY));
 
-        ThrowIfFailed(frameEncode->WriteSource(memoryBitmap.Get(), NULL));
+        const unsigned int rowsPerStripe = std::max(1u, EncodeStripeSizeInBytes / stride);
+
+        for (unsigned int y = 0; y < height; y += rowsPerStripe)
+        {
+            const unsigned int rowCount = std::min(rowsPerStripe, height - y);
+            const unsigned int stripeSize = rowCount * stride;
+            BYTE* stripe = pixels->GetData() + y * stride;
+
+            if (needsConversion)
+            {
+                ComPtr<IWICBitmap> stripeBitmap;
+                ThrowIfFailed(wicFactory->CreateBitmapFromMemory(
+                    width,
+                    rowCount,
+                    GUID_WICPixelFormat32bppBGRA,
+                    stride,
+                    stripeSize,
+                    stripe,
+                    &stripeBitmap));
+
+                ThrowIfFailed(frameEncode->WriteSource(stripeBitmap.Get(), NULL));
+            }
+            else
+            {
+                ThrowIfFailed(frameEncode->WritePixels(rowCount, stride, stripeSize, stripe));
+            }
+        }
+
         ThrowIfFailed(frameEncode->Commit());
         ThrowIfFailed(encoder->Commit());
     }
@@ -157,15 +242,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 IID_PPV_ARGS(&m_wicFactory)));
         }
 
-        void SaveLockedMemoryToStream(
+        void SavePixelBufferToStream(
             IRandomAccessStream* randomAccessStream,
             CanvasBitmapFileFormat fileFormat,
             float quality,
-            unsigned int width,
-            unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapLock* bitmapLock)
+            PixelBuffer* pixels)
         {
             ComPtr<IWICStream> wicStream;
             ThrowIfFailed(m_wicFactory->CreateStream(&wicStream));
@@ -175,27 +258,23 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             ThrowIfFailed(wicStream->InitializeFromIStream(iStream.Get()));
 
-            SaveLockedMemoryToNativeStream(
+            SavePixelBufferToNativeStream(
                 m_wicFactory.Get(), 
                 wicStream.Get(), 
                 GetGUIDForFileFormat(fileFormat),
                 quality, 
-                width, 
-                height, 
                 dpiX,
                 dpiY, 
-                bitmapLock);
+                pixels);
         }
 
-        void SaveLockedMemoryToFile(
+        void SavePixelBufferToFile(
             HSTRING fileName,
             CanvasBitmapFileFormat fileFormat,
             float quality,
-            unsigned int width,
-            unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapLock* bitmapLock)
+            PixelBuffer* pixels)
         {
             WinString fileNameString(fileName);
 
@@ -214,22 +293,143 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             ThrowIfFailed(wicStream->InitializeFromFilename(static_cast<const wchar_t*>(fileNameString), GENERIC_WRITE));
 
-            SaveLockedMemoryToNativeStream(
+            SavePixelBufferToNativeStream(
                 m_wicFactory.Get(),
                 wicStream.Get(), 
                 encoderGuid, 
                 quality, 
-                width, 
-                height, 
                 dpiX, 
                 dpiY, 
-                bitmapLock);
+                pixels);
+        }
+
+        bool TryReadBlockCompressedImage(HSTRING fileName, BlockCompressedImage* image)
+        {
+            WinString fileNameString(fileName);
+            std::wstring name(static_cast<const wchar_t*>(fileNameString));
+
+            // Only files named like DDS files are opened here, so that
+            // everything else is not decoded twice.
+            size_t separatorIndex = name.find_last_of('.');
+            if (separatorIndex == std::wstring::npos || _wcsicmp(name.c_str() + separatorIndex + 1, L"dds") != 0)
+                return false;
+
+            return TryReadBlockCompressedImage(CreateDecoder(fileName).Get(), image);
+        }
+
+        bool TryReadBlockCompressedImage(IStream* fileStream, BlockCompressedImage* image)
+        {
+            LARGE_INTEGER zero = {};
+            ULARGE_INTEGER startPosition;
+            ThrowIfFailed(fileStream->Seek(zero, STREAM_SEEK_CUR, &startPosition));
+
+            // Streams have no name to go by, so peek at the magic number instead.
+            char magic[4] = {};
+            ULONG bytesRead = 0;
+            ThrowIfFailed(fileStream->Read(magic, sizeof(magic), &bytesRead));
+
+            LARGE_INTEGER start;
+            start.QuadPart = static_cast<LONGLONG>(startPosition.QuadPart);
+            ThrowIfFailed(fileStream->Seek(start, STREAM_SEEK_SET, nullptr));
+
+            if (bytesRead != sizeof(magic) || memcmp(magic, "DDS ", sizeof(magic)) != 0)
+                return false;
+
+            if (TryReadBlockCompressedImage(CreateDecoder(fileStream).Get(), image))
+                return true;
+
+            // Rewind again so that the format converter can decode it instead.
+            ThrowIfFailed(fileStream->Seek(start, STREAM_SEEK_SET, nullptr));
+            return false;
         }
 
         ComPtr<IWICFormatConverter> CreateWICFormatConverter(HSTRING fileName)
         {
-            ComPtr<IWICFormatConverter> wicFormatConverter;
+            return CreateFormatConverter(GetFirstFrame(CreateDecoder(fileName)).Get());
+        }
+
+        ComPtr<IWICFormatConverter> CreateWICFormatConverter(IStream* fileStream)
+        {
+            return CreateFormatConverter(GetFirstFrame(CreateDecoder(fileStream)).Get());
+        }
+
+        ComPtr<IWICFormatConverter> CreateWICFormatConverter(HSTRING fileName, BitmapSize maxSize, CanvasImageInterpolation interpolation)
+        {
+            auto frame = GetFirstFrame(CreateDecoder(fileName));
+
+            return CreateFormatConverter(ScaleToFit(frame.Get(), maxSize, interpolation).Get());
+        }
+
+        ComPtr<IWICFormatConverter> CreateWICFormatConverter(IStream* fileStream, BitmapSize maxSize, CanvasImageInterpolation interpolation)
+        {
+            auto frame = GetFirstFrame(CreateDecoder(fileStream));
+
+            return CreateFormatConverter(ScaleToFit(frame.Get(), maxSize, interpolation).Get());
+        }
+
+        ComPtr<IWICFormatConverter> CreateDecodedWICFormatConverter(HSTRING fileName)
+        {
+            auto lazyFormatConverter = CreateWICFormatConverter(fileName);
+
+            // Copying into a WIC bitmap pulls every pixel through the decoder now,
+            // rather than when the bitmap is later uploaded to the GPU.
+            ComPtr<IWICBitmap> wicBitmap;
+            ThrowIfFailed(m_wicFactory->CreateBitmapFromSource(
+                lazyFormatConverter.Get(),
+                WICBitmapCacheOnLoad,
+                &wicBitmap));
+
+            // The pixels are already PBGRA, so this converter is a passthrough.
+            return CreateFormatConverter(wicBitmap.Get());
+        }
+
+    private:
+        static bool TryReadBlockCompressedImage(IWICBitmapDecoder* decoder, BlockCompressedImage* image)
+        {
+            ComPtr<IWICDdsDecoder> ddsDecoder;
+            if (FAILED(decoder->QueryInterface(IID_PPV_ARGS(&ddsDecoder))))
+                return false;
+
+            WICDdsParameters parameters;
+            ThrowIfFailed(ddsDecoder->GetParameters(&parameters));
+
+            if (parameters.Dimension != WICDdsTexture2D || !BlockCompression::IsFormatSupported(parameters.DxgiFormat))
+                return false;
+
+            // The top level of the first texture is all that a CanvasBitmap holds.
+            ComPtr<IWICBitmapFrameDecode> frame;
+            ThrowIfFailed(ddsDecoder->GetFrame(0, 0, 0, &frame));
+
+            BitmapSize size;
+            ThrowIfFailed(frame->GetSize(&size.Width, &size.Height));
 
+            // D2D rejects block compressed bitmaps of any other size, but WIC
+            // can still decompress these.
+            if (size.Width % BlockCompressedBlockSize != 0 || size.Height % BlockCompressedBlockSize != 0)
+                return false;
+
+            auto ddsFrame = As<IWICDdsFrameDecode>(frame);
+
+            WICDdsFormatInfo formatInfo;
+            ThrowIfFailed(ddsFrame->GetFormatInfo(&formatInfo));
+
+            UINT widthInBlocks;
+            UINT heightInBlocks;
+            ThrowIfFailed(ddsFrame->GetSizeInBlocks(&widthInBlocks, &heightInBlocks));
+
+            UINT stride = widthInBlocks * formatInfo.BytesPerBlock;
+
+            image->Blocks.resize(stride * heightInBlocks);
+            ThrowIfFailed(ddsFrame->CopyBlocks(nullptr, stride, static_cast<UINT>(image->Blocks.size()), image->Blocks.data()));
+
+            image->Format = parameters.DxgiFormat;
+            image->Size = D2D1::SizeU(size.Width, size.Height);
+
+            return true;
+        }
+
+        ComPtr<IWICBitmapDecoder> CreateDecoder(HSTRING fileName)
+        {
             WinString fileNameString(fileName);
 
             ComPtr<IWICBitmapDecoder> wicBitmapDecoder;
@@ -240,13 +440,36 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 WICDecodeMetadataCacheOnLoad, 
                 &wicBitmapDecoder));
 
+            return wicBitmapDecoder;
+        }
+
+        ComPtr<IWICBitmapDecoder> CreateDecoder(IStream* fileStream)
+        {
+            ComPtr<IWICBitmapDecoder> wicBitmapDecoder;
+            ThrowIfFailed(m_wicFactory->CreateDecoderFromStream(
+                fileStream,
+                nullptr,
+                WICDecodeMetadataCacheOnLoad,
+                &wicBitmapDecoder));
+
+            return wicBitmapDecoder;
+        }
+
+        static ComPtr<IWICBitmapFrameDecode> GetFirstFrame(ComPtr<IWICBitmapDecoder> const& wicBitmapDecoder)
+        {
             ComPtr<IWICBitmapFrameDecode> wicBitmapFrameSource;
             ThrowIfFailed(wicBitmapDecoder->GetFrame(0, &wicBitmapFrameSource));
 
+            return wicBitmapFrameSource;
+        }
+
+        ComPtr<IWICFormatConverter> CreateFormatConverter(IWICBitmapSource* source)
+        {
+            ComPtr<IWICFormatConverter> wicFormatConverter;
             ThrowIfFailed(m_wicFactory->CreateFormatConverter(&wicFormatConverter));
 
             ThrowIfFailed(wicFormatConverter->Initialize(
-                wicBitmapFrameSource.Get(), 
+                source, 
                 GUID_WICPixelFormat32bppPBGRA, 
                 WICBitmapDitherTypeNone, 
                 NULL, 
@@ -256,31 +479,43 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             return wicFormatConverter;
         }
 
-        ComPtr<IWICFormatConverter> CreateWICFormatConverter(IStream* fileStream)
+        //
+        // Returns a source that produces the frame scaled down to fit within
+        // maxSize. Only the reduced image is ever held in memory: decoders that
+        // can scale natively (such as JPEG) skip most of the work of decoding
+        // full size, and the rest are resampled line by line as they are read.
+        //
+        ComPtr<IWICBitmapSource> ScaleToFit(IWICBitmapFrameDecode* frame, BitmapSize maxSize, CanvasImageInterpolation interpolation)
         {
-            ComPtr<IWICFormatConverter> wicFormatConverter;
+            BitmapSize imageSize;
+            ThrowIfFailed(frame->GetSize(&imageSize.Width, &imageSize.Height));
 
-            ComPtr<IWICBitmapDecoder> wicBitmapDecoder;
-            ThrowIfFailed(m_wicFactory->CreateDecoderFromStream(
-                fileStream,
-                nullptr,
-                WICDecodeMetadataCacheOnLoad,
-                &wicBitmapDecoder));
+            auto targetSize = GetSizeToFit(imageSize, maxSize);
 
-            ComPtr<IWICBitmapFrameDecode> wicBitmapFrameSource;
-            ThrowIfFailed(wicBitmapDecoder->GetFrame(0, &wicBitmapFrameSource));
+            if (targetSize.Width == imageSize.Width && targetSize.Height == imageSize.Height)
+                return frame;
 
-            ThrowIfFailed(m_wicFactory->CreateFormatConverter(&wicFormatConverter));
+            ComPtr<IWICBitmapSource> source = TryDecodeAtReducedSize(m_wicFactory.Get(), frame, imageSize, targetSize);
 
-            ThrowIfFailed(wicFormatConverter->Initialize(
-                wicBitmapFrameSource.Get(),
-                GUID_WICPixelFormat32bppPBGRA,
-                WICBitmapDitherTypeNone,
-                NULL,
-                0,
-                WICBitmapPaletteTypeMedianCut));
+            if (!source)
+                source = frame;
 
-            return wicFormatConverter;
+            BitmapSize sourceSize;
+            ThrowIfFailed(source->GetSize(&sourceSize.Width, &sourceSize.Height));
+
+            if (sourceSize.Width == targetSize.Width && sourceSize.Height == targetSize.Height)
+                return source;
+
+            ComPtr<IWICBitmapScaler> scaler;
+            ThrowIfFailed(m_wicFactory->CreateBitmapScaler(&scaler));
+
+            ThrowIfFailed(scaler->Initialize(
+                source.Get(),
+                targetSize.Width,
+                targetSize.Height,
+                ToWICInterpolationMode(interpolation)));
+
+            return scaler;
         }
     };
 
@@ -291,6 +526,26 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     {
     }
 
+    ComPtr<CanvasBitmap> PolymorphicBitmapManager::CreateCachedBitmap(BitmapLoadCache& cache, ICanvasDevice* device, HSTRING fileName, CanvasAlphaMode alpha, float dpi)
+    {
+        return m_bitmapManager->CreateCached(cache, device, fileName, alpha, dpi);
+    }
+
+    ComPtr<CanvasRenderTarget> PolymorphicBitmapManager::CreatePooledRenderTarget(ICanvasDevice* device, float width, float height, DirectXPixelFormat format, CanvasAlphaMode alpha, float dpi)
+    {
+        return m_renderTargetManager->CreatePooled(device, width, height, format, alpha, dpi);
+    }
+
+    CanvasRenderTargetPool& PolymorphicBitmapManager::GetRenderTargetPool()
+    {
+        return m_renderTargetManager->GetPool();
+    }
+
+    ICanvasBitmapResourceCreationAdapter* PolymorphicBitmapManager::GetBitmapAdapter()
+    {
+        return m_bitmapManager->GetAdapter();
+    }
+
     static ComPtr<ID2D1Bitmap1> CreateD2DBitmap(
         ICanvasDevice* canvasDevice, 
         IDirect3DSurface* surface,
@@ -21,8 +21,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     using namespace ABI::Microsoft::Graphics::Canvas::DirectX;
     using namespace ABI::Windows::UI;
 
+    class BitmapLoadCache;
     class CanvasBitmapManager;
     class CanvasRenderTargetManager;
+    class CanvasRenderTargetPool;
     class ICanvasBitmapResourceCreationAdapter;
 
     inline bool IsRenderTargetBitmap(ID2D1Bitmap1* d2dBitmap)
@@ -31,6 +33,18 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return (options & D2D1_BITMAP_OPTIONS_TARGET) != 0;
     }
 
+    //
+    // Uses the decoder's own scaling, if it has any, to decode frame at the
+    // smallest supported size that is still at least targetSize. The result is
+    // in the closest pixel format the decoder supports, which may not be the
+    // frame's own. Returns null if this is not possible.
+    //
+    ComPtr<IWICBitmapSource> TryDecodeAtReducedSize(
+        IWICImagingFactory* wicFactory,
+        IWICBitmapFrameDecode* frame,
+        BitmapSize imageSize,
+        BitmapSize targetSize);
+
     //
     // Keeps track of Win2D objects that wrap ID2D1Bitmaps.  Depending on their
     // properties, ID2D1Bitmaps can be wrapped by either CanvasBitmap or
@@ -66,6 +80,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ComPtr<ICanvasBitmap> CreateBitmapFromSurface(ICanvasDevice* device, IDirect3DSurface* surface, CanvasAlphaMode alpha, float dpi);
         ComPtr<CanvasRenderTarget> CreateRenderTargetFromSurface(ICanvasDevice* device, IDirect3DSurface* surface, CanvasAlphaMode alpha, float dpi);
 
+        ComPtr<CanvasBitmap> CreateCachedBitmap(BitmapLoadCache& cache, ICanvasDevice* device, HSTRING fileName, CanvasAlphaMode alpha, float dpi);
+
+        ComPtr<CanvasRenderTarget> CreatePooledRenderTarget(ICanvasDevice* device, float width, float height, DirectXPixelFormat format, CanvasAlphaMode alpha, float dpi);
+        CanvasRenderTargetPool& GetRenderTargetPool();
+
+        ICanvasBitmapResourceCreationAdapter* GetBitmapAdapter();
+
         //
         // Returns a wrapper around the given d2dBitmap.  Depending on the
         // bitmap properties a CanvasBitmap or CanvasRenderTarget instance will
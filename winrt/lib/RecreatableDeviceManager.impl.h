@@ -14,6 +14,7 @@
 
 #include "RecreatableDeviceManager.h"
 #include "CanvasCreateResourcesEventArgs.h"
+#include "Tracing.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
@@ -359,8 +360,11 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CancelAnyPendingOperation();
 
             auto d3dDevice = GetDXGIInterface<ID3D11Device>(m_device.Get());
-            if (d3dDevice->GetDeviceRemovedReason() != S_OK)
+            HRESULT deviceRemovedReason = d3dDevice->GetDeviceRemovedReason();
+            if (deviceRemovedReason != S_OK)
             {
+                TRACE_COUNTER(DeviceLost, deviceRemovedReason);
+
                 // We need to create a new device
                 m_device.Reset();
                 
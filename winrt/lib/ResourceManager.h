@@ -106,7 +106,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             m_tracker.Remove(resource);
         }
 
-        // ResourceWrapper needs to be able to call remove
+        //
+        // Indicates that a closed wrapper is now wrapping 'resource'.  This is
+        // called by ResourceWrapper::Reopen().
+        //
+        void Add(resource_t* resource, wrapper_t* wrapper)
+        {
+            m_tracker.Add(resource, wrapper);
+        }
+
+        // ResourceWrapper needs to be able to call remove and add
         friend class ResourceWrapper<TRAITS>;
     };
 
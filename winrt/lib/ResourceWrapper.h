@@ -84,6 +84,27 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 });
         }
 
+    protected:
+        //
+        // Lets a closed wrapper be reused for a new resource, rather than
+        // allocating a new wrapper.  The wrapper is tracked by its manager
+        // just as if ResourceManager::Create had made it.
+        //
+        void Reopen(resource_t* resource)
+        {
+            CheckInPointer(resource);
+
+            if (m_resource)
+            {
+                assert(false && L"Only closed wrappers can be reopened");
+                ThrowHR(E_UNEXPECTED);
+            }
+
+            m_manager->Add(resource, static_cast<wrapper_t*>(this));
+            m_resource = resource;
+        }
+
+    public:
         //
         // ICanvasResourceWrapperNative
         //
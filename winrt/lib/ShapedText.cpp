@@ -0,0 +1,323 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "ShapedText.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    DWRITE_GLYPH_RUN ShapedGlyphRun::GetGlyphRun() const
+    {
+        DWRITE_GLYPH_RUN glyphRun{};
+
+        glyphRun.fontFace = FontFace.Get();
+        glyphRun.fontEmSize = FontEmSize;
+        glyphRun.glyphCount = static_cast<uint32_t>(GlyphIndices.size());
+        glyphRun.glyphIndices = GlyphIndices.empty() ? nullptr : &GlyphIndices.front();
+        glyphRun.glyphAdvances = GlyphAdvances.empty() ? nullptr : &GlyphAdvances.front();
+        glyphRun.glyphOffsets = GlyphOffsets.empty() ? nullptr : &GlyphOffsets.front();
+        glyphRun.isSideways = IsSideways;
+        glyphRun.bidiLevel = BidiLevel;
+
+        return glyphRun;
+    }
+
+
+    //
+    // IDWriteTextRenderer that records the glyph runs of a text layout
+    // rather than drawing them.
+    //
+    class GlyphRunCapture : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        ChainInterfaces<IDWriteTextRenderer, IDWritePixelSnapping>>
+    {
+        std::vector<ShapedGlyphRun>* m_runs;
+
+    public:
+        GlyphRunCapture(std::vector<ShapedGlyphRun>* runs)
+            : m_runs(runs)
+        {
+        }
+
+        // The glyphs will be drawn later with an unknown transform, so
+        // there is nothing meaningful to snap to.
+        IFACEMETHODIMP IsPixelSnappingDisabled(void*, BOOL* isDisabled) override
+        {
+            *isDisabled = TRUE;
+            return S_OK;
+        }
+
+        IFACEMETHODIMP GetCurrentTransform(void*, DWRITE_MATRIX* transform) override
+        {
+            *transform = DWRITE_MATRIX{ 1, 0, 0, 1, 0, 0 };
+            return S_OK;
+        }
+
+        IFACEMETHODIMP GetPixelsPerDip(void*, float* pixelsPerDip) override
+        {
+            *pixelsPerDip = 1;
+            return S_OK;
+        }
+
+        IFACEMETHODIMP DrawGlyphRun(
+            void*,
+            float baselineOriginX,
+            float baselineOriginY,
+            DWRITE_MEASURING_MODE,
+            DWRITE_GLYPH_RUN const* glyphRun,
+            DWRITE_GLYPH_RUN_DESCRIPTION const*,
+            IUnknown*) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    auto count = glyphRun->glyphCount;
+
+                    ShapedGlyphRun run;
+
+                    run.BaselineOrigin = D2D1::Point2F(baselineOriginX, baselineOriginY);
+                    run.FontFace = glyphRun->fontFace;
+                    run.FontEmSize = glyphRun->fontEmSize;
+                    run.IsSideways = glyphRun->isSideways;
+                    run.BidiLevel = glyphRun->bidiLevel;
+
+                    run.GlyphIndices.assign(glyphRun->glyphIndices, glyphRun->glyphIndices + count);
+
+                    if (glyphRun->glyphAdvances)
+                        run.GlyphAdvances.assign(glyphRun->glyphAdvances, glyphRun->glyphAdvances + count);
+
+                    if (glyphRun->glyphOffsets)
+                        run.GlyphOffsets.assign(glyphRun->glyphOffsets, glyphRun->glyphOffsets + count);
+
+                    m_runs->push_back(std::move(run));
+                });
+        }
+
+        // CanvasTextFormat has no way to ask for underlines, strikethroughs
+        // or inline objects, so there is nothing to capture for these.
+
+        IFACEMETHODIMP DrawUnderline(void*, float, float, DWRITE_UNDERLINE const*, IUnknown*) override
+        {
+            return S_OK;
+        }
+
+        IFACEMETHODIMP DrawStrikethrough(void*, float, float, DWRITE_STRIKETHROUGH const*, IUnknown*) override
+        {
+            return S_OK;
+        }
+
+        IFACEMETHODIMP DrawInlineObject(void*, float, float, IDWriteInlineObject*, BOOL, BOOL, IUnknown*) override
+        {
+            return S_OK;
+        }
+    };
+
+
+    ShapedText ShapeText(
+        IDWriteFactory* factory,
+        IDWriteTextFormat* format,
+        wchar_t const* text,
+        uint32_t textLength,
+        float requestedWidth,
+        float requestedHeight)
+    {
+        ComPtr<IDWriteTextLayout> layout;
+        ThrowIfFailed(factory->CreateTextLayout(text, textLength, format, requestedWidth, requestedHeight, &layout));
+
+        ShapedText result;
+
+        auto capture = Make<GlyphRunCapture>(&result.Runs);
+        CheckMakeResult(capture);
+
+        ThrowIfFailed(layout->Draw(nullptr, capture.Get(), 0, 0));
+
+        DWRITE_TEXT_METRICS metrics;
+        ThrowIfFailed(layout->GetMetrics(&metrics));
+
+        result.LayoutBounds = D2D1::RectF(
+            metrics.left,
+            metrics.top,
+            metrics.left + metrics.width,
+            metrics.top + metrics.height);
+
+        return result;
+    }
+
+
+    //
+    // DigitGlyphTable
+    //
+
+    wchar_t const* const DigitGlyphTable::Characters = L"0123456789+-.,:%";
+
+
+    static bool TryGetDigitGlyphIndex(wchar_t c, size_t* index)
+    {
+        if (c == 0)
+            return false;
+
+        auto found = wcschr(DigitGlyphTable::Characters, c);
+
+        if (!found)
+            return false;
+
+        *index = static_cast<size_t>(found - DigitGlyphTable::Characters);
+        return true;
+    }
+
+
+    bool DigitGlyphTable::IsDigitString(wchar_t const* text, uint32_t textLength)
+    {
+        if (textLength == 0)
+            return false;
+
+        size_t index;
+
+        return std::all_of(text, text + textLength, [&](wchar_t c) { return TryGetDigitGlyphIndex(c, &index); });
+    }
+
+
+    std::shared_ptr<DigitGlyphTable> DigitGlyphTable::TryCreate(IDWriteFactory* factory, IDWriteTextFormat* format)
+    {
+        // Composed strings always start at the top left and run left to right.
+        if (format->GetReadingDirection() != DWRITE_READING_DIRECTION_LEFT_TO_RIGHT ||
+            format->GetFlowDirection() != DWRITE_FLOW_DIRECTION_TOP_TO_BOTTOM ||
+            format->GetTextAlignment() != DWRITE_TEXT_ALIGNMENT_LEADING ||
+            format->GetParagraphAlignment() != DWRITE_PARAGRAPH_ALIGNMENT_NEAR)
+        {
+            return nullptr;
+        }
+
+        DWRITE_TRIMMING trimming{};
+        ComPtr<IDWriteInlineObject> trimmingSign;
+        ThrowIfFailed(format->GetTrimming(&trimming, &trimmingSign));
+
+        if (trimming.granularity != DWRITE_TRIMMING_GRANULARITY_NONE)
+            return nullptr;
+
+        //
+        // Let DWrite lay out all of the characters once.  This tells us which
+        // font it picks, where the baseline goes and how tall a line is, and
+        // lets us check that the shaper does nothing to these characters that
+        // we would not reproduce by simply looking up their glyphs.
+        //
+        auto characterCount = static_cast<uint32_t>(wcslen(Characters));
+        auto maxSize = std::numeric_limits<float>::max();
+
+        auto probe = ShapeText(factory, format, Characters, characterCount, maxSize, maxSize);
+
+        if (probe.Runs.size() != 1)
+            return nullptr;
+
+        auto& probeRun = probe.Runs.front();
+
+        if (probeRun.GlyphIndices.size() != characterCount ||
+            probeRun.GlyphAdvances.size() != characterCount ||
+            probeRun.IsSideways ||
+            probeRun.BidiLevel != 0)
+        {
+            return nullptr;
+        }
+
+        for (auto& offset : probeRun.GlyphOffsets)
+        {
+            if (offset.advanceOffset != 0 || offset.ascenderOffset != 0)
+                return nullptr;
+        }
+
+        std::vector<uint32_t> codePoints(Characters, Characters + characterCount);
+        std::vector<uint16_t> glyphIndices(characterCount);
+        ThrowIfFailed(probeRun.FontFace->GetGlyphIndices(&codePoints.front(), characterCount, &glyphIndices.front()));
+
+        std::vector<DWRITE_GLYPH_METRICS> glyphMetrics(characterCount);
+        ThrowIfFailed(probeRun.FontFace->GetDesignGlyphMetrics(&glyphIndices.front(), characterCount, &glyphMetrics.front(), FALSE));
+
+        DWRITE_FONT_METRICS fontMetrics;
+        probeRun.FontFace->GetMetrics(&fontMetrics);
+
+        float designUnitsToDips = probeRun.FontEmSize / fontMetrics.designUnitsPerEm;
+
+        auto table = std::make_shared<DigitGlyphTable>();
+
+        table->m_fontFace = probeRun.FontFace;
+        table->m_fontEmSize = probeRun.FontEmSize;
+        table->m_baseline = probeRun.BaselineOrigin.y;
+        table->m_lineHeight = probe.LayoutBounds.bottom - probe.LayoutBounds.top;
+        table->m_canWrap = (format->GetWordWrapping() != DWRITE_WORD_WRAPPING_NO_WRAP);
+
+        for (uint32_t i = 0; i < characterCount; i++)
+        {
+            DigitGlyph glyph = { glyphIndices[i], glyphMetrics[i].advanceWidth * designUnitsToDips };
+
+            // A missing glyph, substitution or kerning means the shaper is
+            // doing real work for this font.
+            if (glyph.Index == 0 ||
+                glyph.Index != probeRun.GlyphIndices[i] ||
+                fabs(glyph.Advance - probeRun.GlyphAdvances[i]) > 0.001f)
+            {
+                return nullptr;
+            }
+
+            table->m_glyphs.push_back(glyph);
+        }
+
+        return table;
+    }
+
+
+    bool DigitGlyphTable::TryCompose(
+        wchar_t const* text,
+        uint32_t textLength,
+        float requestedWidth,
+        ShapedText* result) const
+    {
+        if (textLength == 0)
+            return false;
+
+        ShapedGlyphRun run;
+
+        run.BaselineOrigin = D2D1::Point2F(0, m_baseline);
+        run.FontFace = m_fontFace;
+        run.FontEmSize = m_fontEmSize;
+
+        run.GlyphIndices.reserve(textLength);
+        run.GlyphAdvances.reserve(textLength);
+
+        float width = 0;
+
+        for (uint32_t i = 0; i < textLength; i++)
+        {
+            size_t index;
+
+            if (!TryGetDigitGlyphIndex(text[i], &index))
+                return false;
+
+            auto& glyph = m_glyphs[index];
+
+            run.GlyphIndices.push_back(glyph.Index);
+            run.GlyphAdvances.push_back(glyph.Advance);
+
+            width += glyph.Advance;
+        }
+
+        // Anything that DWrite would have had to break across lines goes
+        // through the shaper after all.
+        if (m_canWrap && width > requestedWidth)
+            return false;
+
+        result->Runs.clear();
+        result->Runs.push_back(std::move(run));
+        result->LayoutBounds = D2D1::RectF(0, 0, width, m_lineHeight);
+
+        return true;
+    }
+}}}}
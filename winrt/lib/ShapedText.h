@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    //
+    // A glyph run that owns copies of the arrays a DWRITE_GLYPH_RUN points
+    // at, so that it can be drawn again long after the text layout that
+    // produced it has gone.
+    //
+    struct ShapedGlyphRun
+    {
+        ShapedGlyphRun()
+            : BaselineOrigin(D2D1::Point2F())
+            , FontEmSize(0)
+            , IsSideways(FALSE)
+            , BidiLevel(0)
+        { }
+
+        // Relative to the top left of the layout box.
+        D2D1_POINT_2F BaselineOrigin;
+
+        ComPtr<IDWriteFontFace> FontFace;
+        float FontEmSize;
+        BOOL IsSideways;
+        uint32_t BidiLevel;
+
+        std::vector<uint16_t> GlyphIndices;
+        std::vector<float> GlyphAdvances;
+        std::vector<DWRITE_GLYPH_OFFSET> GlyphOffsets;
+
+        // The result points into this object, so must not outlive it.
+        DWRITE_GLYPH_RUN GetGlyphRun() const;
+    };
+
+    struct ShapedText
+    {
+        std::vector<ShapedGlyphRun> Runs;
+        D2D1_RECT_F LayoutBounds;
+    };
+
+    //
+    // Lays out text with DWrite, exactly as ID2D1RenderTarget::DrawText
+    // would, and captures the glyph runs it produces.
+    //
+    ShapedText ShapeText(
+        IDWriteFactory* factory,
+        IDWriteTextFormat* format,
+        wchar_t const* text,
+        uint32_t textLength,
+        float requestedWidth,
+        float requestedHeight);
+
+    //
+    // Glyphs and advances for the characters that make up numbers, looked up
+    // once per text format so that strings made only of those characters can
+    // be composed without running them through the shaper.
+    //
+    // This is only valid when the shaper would have left each character as a
+    // single unkerned glyph, laid out left to right from the top left corner,
+    // so TryCreate checks the format and the font and returns null if they
+    // could do anything else.
+    //
+    class DigitGlyphTable
+    {
+    public:
+        // The characters that the table has glyphs for.
+        static wchar_t const* const Characters;
+
+        static bool IsDigitString(wchar_t const* text, uint32_t textLength);
+
+        static std::shared_ptr<DigitGlyphTable> TryCreate(IDWriteFactory* factory, IDWriteTextFormat* format);
+
+        // Returns false if text is not a digit string, or would need to be
+        // wrapped to fit in requestedWidth.
+        bool TryCompose(
+            wchar_t const* text,
+            uint32_t textLength,
+            float requestedWidth,
+            ShapedText* result) const;
+
+    private:
+        struct DigitGlyph
+        {
+            uint16_t Index;
+            float Advance;
+        };
+
+        ComPtr<IDWriteFontFace> m_fontFace;
+        float m_fontEmSize;
+        float m_baseline;
+        float m_lineHeight;
+        bool m_canWrap;
+        std::vector<DigitGlyph> m_glyphs;  // in the same order as Characters
+    };
+}}}}
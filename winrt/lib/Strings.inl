@@ -30,7 +30,15 @@ STRING(AutoFileFormatNotAllowed, L"The option CanvasFileFormat.Auto is not allow
 STRING(CanvasDeviceGetDeviceWhenNotCreated, L"The CanvasControl does not currently have a CanvasDevice associated with it. "
     L"Ensure that resources are created from a CreateResources or Draw event handler.");
 STRING(PixelColorsFormatRestriction, L"This method only supports resources with pixel format DirectXPixelFormat::B8G8R8A8UIntNormalized.")
+STRING(BlockCompressedSizeRestriction, L"The width and height of block compressed bitmaps must be multiples of 4.")
+STRING(BlockCompressedSubrectangleRestriction, L"When accessing the pixels of block compressed bitmaps, the subrectangle must be aligned to the 4x4 pixel blocks.")
+STRING(BlockCompressedSaveRestriction, L"Block compressed bitmaps cannot be saved.")
+STRING(BlockCompressedFormatRestriction, L"The compressed format must be DirectXPixelFormat::BC1UIntNormalized, BC2UIntNormalized or BC3UIntNormalized.")
+STRING(MipLevelsFormatRestriction, L"Mip levels can only be generated for bitmaps whose pixel format has four 8 bit channels, such as DirectXPixelFormat::B8G8R8A8UIntNormalized.")
 STRING(MultipleAsyncCreateResourcesNotSupported, L"Only one asynchronous CreateResources action can be tracked at a time.")
 STRING(ResourceTrackerWrongDevice, L"Existing resource wrapper is associated with a different device.")
 STRING(ResourceTrackerWrongDpi, L"Existing resource wrapper has a different DPI.")
-STRING(CommandListCannotBeDrawnToAfterItHasBeenUsed, L"CanvasCommandList.CreateDrawingSession cannot be called after the CanvasCommandList has been used as an image.")
\ No newline at end of file
+STRING(CommandListCannotBeDrawnToAfterItHasBeenUsed, L"CanvasCommandList.CreateDrawingSession cannot be called after the CanvasCommandList has been used as an image.")
+STRING(CanvasPathBuilderFigureAlreadyBegun, L"CanvasPathBuilder.BeginFigure cannot be called until EndFigure has been called for the previous figure.")
+STRING(CanvasPathBuilderNoFigure, L"Segments can only be added to a CanvasPathBuilder after BeginFigure has been called.")
+STRING(CanvasPathBuilderFigureNotEnded, L"A CanvasPathBuilder cannot be used to create a geometry until EndFigure has been called.")
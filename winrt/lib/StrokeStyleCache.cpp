@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "StrokeStyleCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    static size_t HashDashes(std::vector<float> const& dashes)
+    {
+        std::hash<float> hashFloat;
+        size_t hash = dashes.size();
+
+        for (auto dash : dashes)
+            hash = hash * 31 + hashFloat(dash);
+
+        return hash;
+    }
+
+
+    StrokeStyleKey::StrokeStyleKey(
+        IUnknown* factory,
+        D2D1_STROKE_STYLE_PROPERTIES1 const& properties,
+        std::vector<float> const& dashes)
+        : Factory(factory)
+        , Properties(properties)
+        , DashesHash(HashDashes(dashes))
+        , Dashes(dashes)
+    {
+    }
+
+
+    bool StrokeStyleKey::operator<(StrokeStyleKey const& other) const
+    {
+        return KeyComparison()
+            (Factory, other.Factory)
+            (Properties.startCap, other.Properties.startCap)
+            (Properties.endCap, other.Properties.endCap)
+            (Properties.dashCap, other.Properties.dashCap)
+            (Properties.lineJoin, other.Properties.lineJoin)
+            (Properties.miterLimit, other.Properties.miterLimit)
+            (Properties.dashStyle, other.Properties.dashStyle)
+            (Properties.dashOffset, other.Properties.dashOffset)
+            (Properties.transformType, other.Properties.transformType)
+            // The hash lets keys with different dashes be told apart without
+            // walking both arrays.
+            (DashesHash, other.DashesHash)
+            (Dashes, other.Dashes)
+            .IsLess();
+    }
+
+
+    std::shared_ptr<SharedStrokeStyle> StrokeStyleCache::GetOrCreate(
+        ID2D1Factory* d2dFactory,
+        D2D1_STROKE_STYLE_PROPERTIES1 const& properties,
+        std::vector<float> const& dashes)
+    {
+        ComPtr<IUnknown> factoryIdentity;
+        ThrowIfFailed(d2dFactory->QueryInterface(IID_PPV_ARGS(&factoryIdentity)));
+
+        StrokeStyleKey key(factoryIdentity.Get(), properties, dashes);
+
+        return m_strokeStyles.GetOrCreate(
+            key,
+            [&]
+            {
+                auto strokeStyle = std::make_shared<SharedStrokeStyle>(key);
+
+                ComPtr<ID2D1Factory2> d2dFactory2;
+                ThrowIfFailed(d2dFactory->QueryInterface(IID_PPV_ARGS(d2dFactory2.GetAddressOf())));
+
+                assert(dashes.size() <= UINT_MAX);
+
+                ThrowIfFailed(d2dFactory2->CreateStrokeStyle(
+                    properties,
+                    dashes.empty() ? nullptr : dashes.data(),
+                    static_cast<UINT32>(dashes.size()),
+                    &strokeStyle->StrokeStyle));
+
+                return strokeStyle;
+            });
+    }
+}}}}
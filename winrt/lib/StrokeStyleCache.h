@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "WeakValueCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    struct StrokeStyleKey
+    {
+        StrokeStyleKey(
+            IUnknown* factory,
+            D2D1_STROKE_STYLE_PROPERTIES1 const& properties,
+            std::vector<float> const& dashes);
+
+        IUnknown* Factory;
+        D2D1_STROKE_STYLE_PROPERTIES1 Properties;
+        size_t DashesHash;
+        std::vector<float> Dashes;
+
+        bool operator<(StrokeStyleKey const& other) const;
+    };
+
+    // A realized D2D stroke style, shared by every CanvasStrokeStyle with the
+    // same properties that is used with the same factory.
+    struct SharedStrokeStyle
+    {
+        SharedStrokeStyle(StrokeStyleKey const& key)
+            : Key(key)
+        { }
+
+        StrokeStyleKey Key;
+        ComPtr<ID2D1StrokeStyle1> StrokeStyle;
+    };
+
+    //
+    // Hands out realized stroke styles, so that switching between a handful
+    // of stroke styles, or using the same one with several devices, does not
+    // create a new D2D stroke style each time.
+    //
+    // A realization's D2D stroke style references its factory, which keeps
+    // the factory pointer in its key valid.
+    //
+    class StrokeStyleCache
+    {
+    public:
+        std::shared_ptr<SharedStrokeStyle> GetOrCreate(
+            ID2D1Factory* d2dFactory,
+            D2D1_STROKE_STYLE_PROPERTIES1 const& properties,
+            std::vector<float> const& dashes);
+
+    private:
+        WeakValueCache<StrokeStyleKey, SharedStrokeStyle> m_strokeStyles;
+    };
+
+
+    typedef PerApplicationCache<StrokeStyleCache> PerApplicationStrokeStyleCache;
+}}}}
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "TextFormatInternTable.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    bool TextFormatKey::operator<(TextFormatKey const& other) const
+    {
+        return KeyComparison()
+            (FontCollection, other.FontCollection)
+            (FontFamilyName, other.FontFamilyName)
+            (FontSize, other.FontSize)
+            (FontStretch, other.FontStretch)
+            (FontStyle, other.FontStyle)
+            (FontWeight, other.FontWeight)
+            (LocaleName, other.LocaleName)
+            (FlowDirection, other.FlowDirection)
+            (IncrementalTabStop, other.IncrementalTabStop)
+            (LineSpacingMethod, other.LineSpacingMethod)
+            (LineSpacing, other.LineSpacing)
+            (LineSpacingBaseline, other.LineSpacingBaseline)
+            (ParagraphAlignment, other.ParagraphAlignment)
+            (ReadingDirection, other.ReadingDirection)
+            (TextAlignment, other.TextAlignment)
+            (TrimmingGranularity, other.TrimmingGranularity)
+            (TrimmingDelimiter, other.TrimmingDelimiter)
+            (TrimmingDelimiterCount, other.TrimmingDelimiterCount)
+            (WordWrapping, other.WordWrapping)
+            .IsLess();
+    }
+
+
+    TextFormatInternTable::TextFormatInternTable()
+    {
+        ThrowIfFailed(DWriteCreateFactory(
+            DWRITE_FACTORY_TYPE_SHARED,
+            __uuidof(IDWriteFactory),
+            static_cast<IUnknown**>(&m_factory)));
+    }
+
+
+    ComPtr<IDWriteFactory> const& TextFormatInternTable::GetFactory()
+    {
+        return m_factory;
+    }
+
+
+    std::shared_ptr<DigitGlyphTable> TextFormatInternTable::GetDigitGlyphTable(InternedTextFormat* interned)
+    {
+        std::lock_guard<std::mutex> lock(m_digitGlyphsMutex);
+
+        if (!interned->HasCheckedDigitGlyphs)
+        {
+            interned->DigitGlyphs = DigitGlyphTable::TryCreate(m_factory.Get(), interned->Format.Get());
+            interned->HasCheckedDigitGlyphs = true;
+        }
+
+        return interned->DigitGlyphs;
+    }
+}}}}
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "ShapedText.h"
+#include "WeakValueCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    // Every property that goes into a realized IDWriteTextFormat.
+    struct TextFormatKey
+    {
+        IDWriteFontCollection* FontCollection;
+        std::wstring FontFamilyName;
+        float FontSize;
+        DWRITE_FONT_STRETCH FontStretch;
+        DWRITE_FONT_STYLE FontStyle;
+        DWRITE_FONT_WEIGHT FontWeight;
+        std::wstring LocaleName;
+        DWRITE_FLOW_DIRECTION FlowDirection;
+        float IncrementalTabStop;
+        DWRITE_LINE_SPACING_METHOD LineSpacingMethod;
+        float LineSpacing;
+        float LineSpacingBaseline;
+        DWRITE_PARAGRAPH_ALIGNMENT ParagraphAlignment;
+        DWRITE_READING_DIRECTION ReadingDirection;
+        DWRITE_TEXT_ALIGNMENT TextAlignment;
+        DWRITE_TRIMMING_GRANULARITY TrimmingGranularity;
+        uint32_t TrimmingDelimiter;
+        uint32_t TrimmingDelimiterCount;
+        DWRITE_WORD_WRAPPING WordWrapping;
+
+        bool operator<(TextFormatKey const& other) const;
+    };
+
+    // A realized text format, shared by every CanvasTextFormat whose
+    // properties match its key.  It must not be modified.
+    struct InternedTextFormat
+    {
+        InternedTextFormat()
+            : HasCheckedDigitGlyphs(false)
+        { }
+
+        ComPtr<IDWriteTextFormat> Format;
+
+        // Filled in on first use by TextFormatInternTable::GetDigitGlyphTable.
+        // Null if this format cannot use the digit fast path.
+        bool HasCheckedDigitGlyphs;
+        std::shared_ptr<DigitGlyphTable> DigitGlyphs;
+    };
+
+    //
+    // Hands out IDWriteTextFormats, so that many CanvasTextFormats with the
+    // same properties only cost one DWrite object between them.  Also caches
+    // the shared DWrite factory that the formats are created from.
+    //
+    // An interned format references its font collection, which keeps the
+    // collection pointer in its key valid.
+    //
+    class TextFormatInternTable
+    {
+    public:
+        TextFormatInternTable();
+
+        ComPtr<IDWriteFactory> const& GetFactory();
+
+        std::shared_ptr<DigitGlyphTable> GetDigitGlyphTable(InternedTextFormat* interned);
+
+        //
+        // createFormat is called, with the table locked, if there is no live
+        // interned format for this key.
+        //
+        template<typename FN>
+        std::shared_ptr<InternedTextFormat> GetOrCreate(TextFormatKey const& key, FN&& createFormat)
+        {
+            return m_formats.GetOrCreate(
+                key,
+                [&]
+                {
+                    auto interned = std::make_shared<InternedTextFormat>();
+                    interned->Format = createFormat(m_factory.Get());
+                    return interned;
+                });
+        }
+
+    private:
+        ComPtr<IDWriteFactory> m_factory;
+
+        WeakValueCache<TextFormatKey, InternedTextFormat> m_formats;
+
+        // Guards the digit glyph fields of the interned formats.
+        std::mutex m_digitGlyphsMutex;
+    };
+
+
+    typedef PerApplicationCache<TextFormatInternTable> PerApplicationTextFormatInternTable;
+}}}}
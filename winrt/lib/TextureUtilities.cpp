@@ -19,6 +19,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     ScopedBitmapLock::ScopedBitmapLock(ID2D1Bitmap1* d2dBitmap, D3D11_MAP mapType, D2D1_RECT_U const* optionalSubRectangle)
         : m_mapType(mapType)
         , m_useSubrectangle(false)
+#ifndef WIN2D_DISABLE_TRACING
+        , m_traceSpan(TraceEvent::BitmapLock)
+#endif
     {
         ComPtr<IDXGISurface> dxgiSurface;
         ThrowIfFailed(d2dBitmap->GetSurface(&dxgiSurface));
@@ -103,7 +106,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             0, // Flags
             &m_mappedSubresource));
 
-        m_lockedBufferSize = m_mappedSubresource.RowPitch * stagingDescription.Height;
+        m_lockedBufferSize = m_mappedSubresource.RowPitch * GetRowCount(stagingDescription.Format, stagingDescription.Height);
     }
 
     ScopedBitmapLock::~ScopedBitmapLock()
@@ -231,12 +234,55 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         case DXGI_FORMAT_A8P8: return 2;
         case DXGI_FORMAT_B4G4R4A4_UNORM: return 2;
         default:
-            // Some formats such as DXGI_FORMAT_UNKNOWN, and some block-compressed formats
+            // Some formats such as DXGI_FORMAT_UNKNOWN, and the block-compressed formats
             // do not have valid sizes here.
             ThrowHR(E_INVALIDARG);
         }
     }
 
+    bool IsBlockCompressedFormat(DXGI_FORMAT format)
+    {
+        return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM) ||
+               (format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+    }
+
+    unsigned int GetBytesPerBlock(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_TYPELESS: return 8;
+        case DXGI_FORMAT_BC1_UNORM: return 8;
+        case DXGI_FORMAT_BC1_UNORM_SRGB: return 8;
+        case DXGI_FORMAT_BC4_TYPELESS: return 8;
+        case DXGI_FORMAT_BC4_UNORM: return 8;
+        case DXGI_FORMAT_BC4_SNORM: return 8;
+        default:
+            if (IsBlockCompressedFormat(format))
+                return 16;
+
+            ThrowHR(E_INVALIDARG);
+        }
+    }
+
+    unsigned int GetBytesPerRow(DXGI_FORMAT format, unsigned int widthInPixels)
+    {
+        if (IsBlockCompressedFormat(format))
+        {
+            unsigned int widthInBlocks = (widthInPixels + BlockCompressedBlockSize - 1) / BlockCompressedBlockSize;
+            return widthInBlocks * GetBytesPerBlock(format);
+        }
+
+        return widthInPixels * GetBytesPerPixel(format);
+    }
+
+    unsigned int GetRowCount(DXGI_FORMAT format, unsigned int heightInPixels)
+    {
+        if (IsBlockCompressedFormat(format))
+            return (heightInPixels + BlockCompressedBlockSize - 1) / BlockCompressedBlockSize;
+
+        return heightInPixels;
+    }
+
     ComPtr<ID3D11Texture2D> GetTexture2DForDXGISurface(
         ComPtr<IDXGISurface2> const& dxgiSurface,
         uint32_t* subresourceIndexOut)
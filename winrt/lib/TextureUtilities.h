@@ -12,10 +12,17 @@
 
 #pragma once
 
+#include "Tracing.h"
+
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     class ScopedBitmapLock
     {
+#ifndef WIN2D_DISABLE_TRACING
+        // First, so the span covers both the map and the copy back on unlock.
+        TraceSpan m_traceSpan;
+#endif
+
         D3D11_MAPPED_SUBRESOURCE m_mappedSubresource;
         unsigned int m_subresourceIndex;
         unsigned int m_lockedBufferSize;
@@ -40,6 +47,23 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     unsigned int GetBytesPerPixel(DXGI_FORMAT format);
 
+    //
+    // Block compressed formats store each 4x4 group of pixels as a single
+    // block, so they have no size per pixel. Their rows are rows of blocks.
+    //
+    const unsigned int BlockCompressedBlockSize = 4;
+
+    bool IsBlockCompressedFormat(DXGI_FORMAT format);
+
+    unsigned int GetBytesPerBlock(DXGI_FORMAT format);
+
+    // The number of bytes needed for one row of the given width: a row of
+    // pixels, or a row of blocks for block compressed formats.
+    unsigned int GetBytesPerRow(DXGI_FORMAT format, unsigned int widthInPixels);
+
+    // The number of rows, as measured by GetBytesPerRow, in the given height.
+    unsigned int GetRowCount(DXGI_FORMAT format, unsigned int heightInPixels);
+
     ComPtr<ID3D11Texture2D> GetTexture2DForDXGISurface(
         ComPtr<IDXGISurface2> const& dxgiSurface,
         uint32_t* subresourceIndexOut = nullptr);
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "Tracing.h"
+
+#include <atomic>
+#include <evntprov.h>
+#include <winmeta.h>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+#ifndef WIN2D_DISABLE_TRACING
+
+    // {51A80436-6F9F-46B7-BA9C-499A44E18485}
+    static GUID const Win2DProviderId =
+        { 0x51a80436, 0x6f9f, 0x46b7, { 0xba, 0x9c, 0x49, 0x9a, 0x44, 0xe1, 0x84, 0x85 } };
+
+    //
+    // Writes trace events to ETW using the manifest-free provider API. Spans
+    // become start/stop events and counters become info events carrying a
+    // single 64 bit value, all with the TraceEvent (plus one) as their id.
+    //
+    class EtwTraceSink : public ITraceSink
+    {
+        REGHANDLE m_handle;
+
+    public:
+        EtwTraceSink()
+            : m_handle(0)
+        {
+            // Tracing is best effort: if registration fails events are
+            // silently dropped.
+            if (EventRegister(&Win2DProviderId, nullptr, nullptr, &m_handle) != ERROR_SUCCESS)
+                m_handle = 0;
+        }
+
+        virtual ~EtwTraceSink()
+        {
+            if (m_handle)
+                EventUnregister(m_handle);
+        }
+
+        virtual void BeginSpan(TraceEvent event) override
+        {
+            Write(event, WINEVENT_OPCODE_START, nullptr);
+        }
+
+        virtual void EndSpan(TraceEvent event) override
+        {
+            Write(event, WINEVENT_OPCODE_STOP, nullptr);
+        }
+
+        virtual void Counter(TraceEvent event, int64_t value) override
+        {
+            Write(event, WINEVENT_OPCODE_INFO, &value);
+        }
+
+    private:
+        void Write(TraceEvent event, UCHAR opcode, int64_t const* value)
+        {
+            if (!m_handle || !EventProviderEnabled(m_handle, WINEVENT_LEVEL_INFO, 0))
+                return;
+
+            EVENT_DESCRIPTOR descriptor;
+            EventDescCreate(
+                &descriptor,
+                static_cast<USHORT>(static_cast<int>(event) + 1),
+                0,
+                WINEVENT_CHANNEL_NONE,
+                WINEVENT_LEVEL_INFO,
+                WINEVENT_TASK_NONE,
+                opcode,
+                0);
+
+            if (!EventEnabled(m_handle, &descriptor))
+                return;
+
+            if (value)
+            {
+                EVENT_DATA_DESCRIPTOR data;
+                EventDataDescCreate(&data, value, sizeof(*value));
+                EventWrite(m_handle, &descriptor, 1, &data);
+            }
+            else
+            {
+                EventWrite(m_handle, &descriptor, 0, nullptr);
+            }
+        }
+    };
+
+    // Defined in this order so the ETW sink is constructed before anything
+    // can point at it.
+    static EtwTraceSink s_etwSink;
+    static std::atomic<ITraceSink*> s_sink(&s_etwSink);
+
+#else
+
+    static std::atomic<ITraceSink*> s_sink(nullptr);
+
+#endif
+
+    ITraceSink* Tracing::GetSink()
+    {
+        return s_sink.load();
+    }
+
+    ITraceSink* Tracing::SetSink(ITraceSink* sink)
+    {
+        return s_sink.exchange(sink);
+    }
+}}}}
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // The points in the library that are traced. These double as the ETW
+    // event ids (offset by one, since zero is not a valid id), so new events
+    // must be added at the end.
+    //
+    enum class TraceEvent
+    {
+        DeviceCreation,         // span
+        DeviceLost,             // counter: the device removed reason
+        BitmapLoad,             // span
+        BitmapDecode,           // span
+        BitmapUpload,           // counter: bytes copied into a bitmap
+        BitmapLock,             // span, while the bitmap is mapped
+        EffectRealization,      // span
+        DrawHandlers,           // span
+
+        Count
+    };
+
+    //
+    // Receives trace events. Spans on one thread nest, so each EndSpan
+    // matches the most recent unmatched BeginSpan for the same thread.
+    //
+    // Sinks are called from whichever thread does the traced work, so they
+    // must be thread safe.
+    //
+    class ITraceSink
+    {
+    public:
+        virtual ~ITraceSink() = default;
+
+        virtual void BeginSpan(TraceEvent event) = 0;
+        virtual void EndSpan(TraceEvent event) = 0;
+        virtual void Counter(TraceEvent event, int64_t value) = 0;
+    };
+
+    class Tracing
+    {
+    public:
+        // The sink that trace events currently go to. By default this writes
+        // ETW events, which cost almost nothing while no one is listening.
+        static ITraceSink* GetSink();
+
+        // Replaces the sink, returning the previous one so that it can be
+        // restored. The caller keeps ownership, and the sink must stay alive
+        // until it has been replaced and any in-flight spans have ended.
+        static ITraceSink* SetSink(ITraceSink* sink);
+
+        static void Counter(TraceEvent event, int64_t value)
+        {
+            if (auto sink = GetSink())
+                sink->Counter(event, value);
+        }
+    };
+
+    //
+    // Traces the lifetime of a scope. The span ends on the sink it began on,
+    // even if the sink is replaced in between.
+    //
+    class TraceSpan
+    {
+        ITraceSink* m_sink;
+        TraceEvent m_event;
+
+    public:
+        explicit TraceSpan(TraceEvent event)
+            : m_sink(Tracing::GetSink())
+            , m_event(event)
+        {
+            if (m_sink)
+                m_sink->BeginSpan(m_event);
+        }
+
+        ~TraceSpan()
+        {
+            if (m_sink)
+                m_sink->EndSpan(m_event);
+        }
+
+    private:
+        TraceSpan(TraceSpan const&);
+        TraceSpan& operator=(TraceSpan const&);
+    };
+}}}}
+
+//
+// Defining WIN2D_DISABLE_TRACING compiles out every trace point. The sink
+// interface remains, so code that installs a sink still builds.
+//
+#ifdef WIN2D_DISABLE_TRACING
+
+#define TRACE_SPAN(EVENT)
+#define TRACE_COUNTER(EVENT, VALUE)
+
+#else
+
+#define TRACE_SPAN_NAME2(LINE) traceSpan##LINE
+#define TRACE_SPAN_NAME(LINE) TRACE_SPAN_NAME2(LINE)
+
+#define TRACE_SPAN(EVENT) \
+    ::ABI::Microsoft::Graphics::Canvas::TraceSpan TRACE_SPAN_NAME(__LINE__)(::ABI::Microsoft::Graphics::Canvas::TraceEvent::EVENT)
+
+#define TRACE_COUNTER(EVENT, VALUE) \
+    ::ABI::Microsoft::Graphics::Canvas::Tracing::Counter(::ABI::Microsoft::Graphics::Canvas::TraceEvent::EVENT, static_cast<int64_t>(VALUE))
+
+#endif
@@ -0,0 +1,338 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "VirtualBitmapTiles.h"
+
+#include <cmath>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    static bool IsEmpty(D2D1_RECT_F const& rect)
+    {
+        return !(rect.right > rect.left && rect.bottom > rect.top);
+    }
+
+    static D2D1_RECT_F Intersect(D2D1_RECT_F const& a, D2D1_RECT_F const& b)
+    {
+        return D2D1::RectF(
+            std::max(a.left, b.left),
+            std::max(a.top, b.top),
+            std::min(a.right, b.right),
+            std::min(a.bottom, b.bottom));
+    }
+
+    static D2D1_POINT_2F TransformPoint(D2D1_MATRIX_3X2_F const& m, float x, float y)
+    {
+        return D2D1::Point2F(
+            x * m._11 + y * m._21 + m._31,
+            x * m._12 + y * m._22 + m._32);
+    }
+
+    static bool TryInvert(D2D1_MATRIX_3X2_F const& m, D2D1_MATRIX_3X2_F* result)
+    {
+        float determinant = m._11 * m._22 - m._12 * m._21;
+
+        if (determinant == 0)
+            return false;
+
+        result->_11 = m._22 / determinant;
+        result->_12 = -m._12 / determinant;
+        result->_21 = -m._21 / determinant;
+        result->_22 = m._11 / determinant;
+        result->_31 = (m._21 * m._32 - m._22 * m._31) / determinant;
+        result->_32 = (m._12 * m._31 - m._11 * m._32) / determinant;
+
+        return true;
+    }
+
+    static D2D1_RECT_F TransformBounds(D2D1_MATRIX_3X2_F const& m, D2D1_RECT_F const& rect)
+    {
+        D2D1_POINT_2F corners[] =
+        {
+            TransformPoint(m, rect.left,  rect.top),
+            TransformPoint(m, rect.right, rect.top),
+            TransformPoint(m, rect.left,  rect.bottom),
+            TransformPoint(m, rect.right, rect.bottom),
+        };
+
+        D2D1_RECT_F bounds = D2D1::RectF(corners[0].x, corners[0].y, corners[0].x, corners[0].y);
+
+        for (auto& corner : corners)
+        {
+            bounds.left = std::min(bounds.left, corner.x);
+            bounds.top = std::min(bounds.top, corner.y);
+            bounds.right = std::max(bounds.right, corner.x);
+            bounds.bottom = std::max(bounds.bottom, corner.y);
+        }
+
+        return bounds;
+    }
+
+
+    VirtualBitmapTiles::VirtualBitmapTiles(BitmapSize imageSize, uint32_t tileSize)
+        : m_imageSize(imageSize)
+        , m_tileSize(tileSize)
+        , m_memoryBudget(DefaultMemoryBudget)
+        , m_residentBytes(0)
+        , m_generation(0)
+    {
+        if (tileSize == 0)
+            ThrowHR(E_INVALIDARG);
+
+        m_columnCount = (imageSize.Width + tileSize - 1) / tileSize;
+        m_rowCount = (imageSize.Height + tileSize - 1) / tileSize;
+
+        m_slots.resize(static_cast<size_t>(m_columnCount) * m_rowCount);
+    }
+
+
+    BitmapSize VirtualBitmapTiles::GetImageSize() const
+    {
+        return m_imageSize;
+    }
+
+
+    uint32_t VirtualBitmapTiles::GetColumnCount() const
+    {
+        return m_columnCount;
+    }
+
+
+    uint32_t VirtualBitmapTiles::GetRowCount() const
+    {
+        return m_rowCount;
+    }
+
+
+    uint64_t VirtualBitmapTiles::GetMemoryBudget() const
+    {
+        return m_memoryBudget;
+    }
+
+
+    void VirtualBitmapTiles::SetMemoryBudget(uint64_t bytes)
+    {
+        m_memoryBudget = bytes;
+
+        Trim(0);
+    }
+
+
+    uint32_t VirtualBitmapTiles::GetResidentTileCount() const
+    {
+        return static_cast<uint32_t>(m_lru.size());
+    }
+
+
+    uint64_t VirtualBitmapTiles::GetResidentBytes() const
+    {
+        return m_residentBytes;
+    }
+
+
+    std::vector<VirtualBitmapTile> VirtualBitmapTiles::GetTiles(D2D1_RECT_F const& region, LoadFunction const& load)
+    {
+        std::vector<VirtualBitmapTile> tiles;
+
+        auto imageBounds = D2D1::RectF(0, 0, static_cast<float>(m_imageSize.Width), static_cast<float>(m_imageSize.Height));
+        auto clippedRegion = Intersect(region, imageBounds);
+
+        if (IsEmpty(clippedRegion))
+            return tiles;
+
+        auto firstColumn = static_cast<uint32_t>(clippedRegion.left) / m_tileSize;
+        auto firstRow = static_cast<uint32_t>(clippedRegion.top) / m_tileSize;
+        auto lastColumn = std::min(static_cast<uint32_t>(std::ceil(clippedRegion.right) - 1) / m_tileSize, m_columnCount - 1);
+        auto lastRow = std::min(static_cast<uint32_t>(std::ceil(clippedRegion.bottom) - 1) / m_tileSize, m_rowCount - 1);
+
+        m_generation++;
+
+        for (uint32_t row = firstRow; row <= lastRow; row++)
+        {
+            for (uint32_t column = firstColumn; column <= lastColumn; column++)
+            {
+                auto index = row * m_columnCount + column;
+                auto& slot = m_slots[index];
+                auto bounds = GetTileBounds(column, row);
+
+                if (slot.Bitmap)
+                {
+                    m_lru.splice(m_lru.begin(), m_lru, slot.LruPosition);
+                }
+                else
+                {
+                    auto bitmapBounds = D2D1::RectU(
+                        bounds.left > 0 ? bounds.left - 1 : 0,
+                        bounds.top > 0 ? bounds.top - 1 : 0,
+                        std::min(bounds.right + 1, m_imageSize.Width),
+                        std::min(bounds.bottom + 1, m_imageSize.Height));
+
+                    auto bitmap = load(bitmapBounds);
+
+                    if (!bitmap)
+                        ThrowHR(E_UNEXPECTED);
+
+                    m_lru.push_front(index);
+
+                    slot.Bitmap = bitmap;
+                    slot.BitmapBounds = bitmapBounds;
+                    slot.Bytes = static_cast<uint64_t>(bitmapBounds.right - bitmapBounds.left) * (bitmapBounds.bottom - bitmapBounds.top) * 4;
+                    slot.LruPosition = m_lru.begin();
+
+                    m_residentBytes += slot.Bytes;
+                }
+
+                slot.LastUsed = m_generation;
+
+                VirtualBitmapTile tile = { bounds, slot.BitmapBounds, slot.Bitmap };
+                tiles.push_back(tile);
+            }
+        }
+
+        Trim(m_generation);
+
+        return tiles;
+    }
+
+
+    void VirtualBitmapTiles::Clear()
+    {
+        while (!m_lru.empty())
+        {
+            Evict(m_lru.back());
+        }
+    }
+
+
+    bool VirtualBitmapTiles::GetVisibleSourceRect(
+        D2D1_RECT_F const& destRect,
+        D2D1_RECT_F const& sourceRect,
+        D2D1_MATRIX_3X2_F const& transform,
+        D2D1_RECT_F const* targetBounds,
+        D2D1_RECT_F* visibleSourceRect)
+    {
+        if (IsEmpty(destRect) || IsEmpty(sourceRect))
+            return false;
+
+        auto visibleDestRect = destRect;
+
+        if (targetBounds)
+        {
+            // Map the render target back into the coordinate space that destRect is in.
+            D2D1_MATRIX_3X2_F inverse;
+            if (!TryInvert(transform, &inverse))
+                return false;
+
+            visibleDestRect = Intersect(visibleDestRect, TransformBounds(inverse, *targetBounds));
+
+            if (IsEmpty(visibleDestRect))
+                return false;
+        }
+
+        float scaleX = (sourceRect.right - sourceRect.left) / (destRect.right - destRect.left);
+        float scaleY = (sourceRect.bottom - sourceRect.top) / (destRect.bottom - destRect.top);
+
+        auto visible = D2D1::RectF(
+            sourceRect.left + (visibleDestRect.left - destRect.left) * scaleX,
+            sourceRect.top + (visibleDestRect.top - destRect.top) * scaleY,
+            sourceRect.left + (visibleDestRect.right - destRect.left) * scaleX,
+            sourceRect.top + (visibleDestRect.bottom - destRect.top) * scaleY);
+
+        // Filtering reads a little past the edge of what is visible.
+        visible.left -= 1;
+        visible.top -= 1;
+        visible.right += 1;
+        visible.bottom += 1;
+
+        *visibleSourceRect = Intersect(visible, sourceRect);
+
+        return true;
+    }
+
+
+    bool VirtualBitmapTiles::GetTileDrawRects(
+        VirtualBitmapTile const& tile,
+        D2D1_RECT_F const& destRect,
+        D2D1_RECT_F const& sourceRect,
+        D2D1_RECT_F* tileDestRect,
+        D2D1_RECT_F* tileSourceRect)
+    {
+        auto tileBounds = D2D1::RectF(
+            static_cast<float>(tile.Bounds.left),
+            static_cast<float>(tile.Bounds.top),
+            static_cast<float>(tile.Bounds.right),
+            static_cast<float>(tile.Bounds.bottom));
+
+        auto part = Intersect(tileBounds, sourceRect);
+
+        if (IsEmpty(part) || IsEmpty(sourceRect))
+            return false;
+
+        float scaleX = (destRect.right - destRect.left) / (sourceRect.right - sourceRect.left);
+        float scaleY = (destRect.bottom - destRect.top) / (sourceRect.bottom - sourceRect.top);
+
+        *tileDestRect = D2D1::RectF(
+            destRect.left + (part.left - sourceRect.left) * scaleX,
+            destRect.top + (part.top - sourceRect.top) * scaleY,
+            destRect.left + (part.right - sourceRect.left) * scaleX,
+            destRect.top + (part.bottom - sourceRect.top) * scaleY);
+
+        auto bitmapLeft = static_cast<float>(tile.BitmapBounds.left);
+        auto bitmapTop = static_cast<float>(tile.BitmapBounds.top);
+
+        *tileSourceRect = D2D1::RectF(
+            part.left - bitmapLeft,
+            part.top - bitmapTop,
+            part.right - bitmapLeft,
+            part.bottom - bitmapTop);
+
+        return true;
+    }
+
+
+    D2D1_RECT_U VirtualBitmapTiles::GetTileBounds(uint32_t column, uint32_t row) const
+    {
+        return D2D1::RectU(
+            column * m_tileSize,
+            row * m_tileSize,
+            std::min((column + 1) * m_tileSize, m_imageSize.Width),
+            std::min((row + 1) * m_tileSize, m_imageSize.Height));
+    }
+
+
+    void VirtualBitmapTiles::Trim(uint64_t protectedGeneration)
+    {
+        while (m_residentBytes > m_memoryBudget && !m_lru.empty())
+        {
+            auto index = m_lru.back();
+
+            // Everything further up the list was used at least as recently.
+            if (protectedGeneration != 0 && m_slots[index].LastUsed == protectedGeneration)
+                return;
+
+            Evict(index);
+        }
+    }
+
+
+    void VirtualBitmapTiles::Evict(uint32_t index)
+    {
+        auto& slot = m_slots[index];
+
+        m_residentBytes -= slot.Bytes;
+        m_lru.erase(slot.LruPosition);
+
+        slot.Bitmap.Reset();
+        slot.Bytes = 0;
+    }
+}}}}
@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <list>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+
+    struct VirtualBitmapTile
+    {
+        // The part of the image that this tile draws.
+        D2D1_RECT_U Bounds;
+
+        // The part of the image held in Bitmap. This extends one pixel past
+        // Bounds on each side (where the image allows) so that filtering at
+        // the edge of a tile samples the same pixels as it would if the image
+        // was not split up.
+        D2D1_RECT_U BitmapBounds;
+
+        ComPtr<ICanvasBitmap> Bitmap;
+    };
+
+    //
+    // Splits an image into a grid of tiles, each small enough to fit in a
+    // single bitmap, and decides which of them need to be resident in order
+    // to draw a given region.
+    //
+    // Tiles are loaded on demand. Once the loaded tiles exceed the memory
+    // budget, the least recently drawn are released. Tiles needed by the
+    // current draw are never released, so the budget may be exceeded while
+    // a very large region is visible.
+    //
+    // This does not talk to the GPU itself; loading is done by the supplied
+    // LoadFunction.
+    //
+    class VirtualBitmapTiles
+    {
+    public:
+        typedef std::function<ComPtr<ICanvasBitmap>(D2D1_RECT_U const& bitmapBounds)> LoadFunction;
+
+        static const uint32_t DefaultTileSize = 512;
+        static const uint64_t DefaultMemoryBudget = 64 * 1024 * 1024;
+
+        VirtualBitmapTiles(BitmapSize imageSize, uint32_t tileSize = DefaultTileSize);
+
+        BitmapSize GetImageSize() const;
+        uint32_t GetColumnCount() const;
+        uint32_t GetRowCount() const;
+
+        uint64_t GetMemoryBudget() const;
+        void SetMemoryBudget(uint64_t bytes);
+
+        uint32_t GetResidentTileCount() const;
+        uint64_t GetResidentBytes() const;
+
+        // Returns every tile that intersects region, which is in image
+        // pixels, loading any that are not already resident.
+        std::vector<VirtualBitmapTile> GetTiles(D2D1_RECT_F const& region, LoadFunction const& load);
+
+        // Releases all resident tiles.
+        void Clear();
+
+        //
+        // Works out which part of sourceRect can be seen when it is drawn into
+        // destRect using the given transform. targetBounds may be null if the
+        // extent of the render target is unknown. Returns false if nothing
+        // is visible.
+        //
+        static bool GetVisibleSourceRect(
+            D2D1_RECT_F const& destRect,
+            D2D1_RECT_F const& sourceRect,
+            D2D1_MATRIX_3X2_F const& transform,
+            D2D1_RECT_F const* targetBounds,
+            D2D1_RECT_F* visibleSourceRect);
+
+        //
+        // Works out where to draw a tile, as part of drawing sourceRect into
+        // destRect. The returned tileSourceRect is relative to the tile's
+        // bitmap. Returns false if the tile is not part of sourceRect.
+        //
+        static bool GetTileDrawRects(
+            VirtualBitmapTile const& tile,
+            D2D1_RECT_F const& destRect,
+            D2D1_RECT_F const& sourceRect,
+            D2D1_RECT_F* tileDestRect,
+            D2D1_RECT_F* tileSourceRect);
+
+    private:
+        struct Slot
+        {
+            Slot()
+                : Bytes(0)
+                , LastUsed(0)
+            { }
+
+            ComPtr<ICanvasBitmap> Bitmap;
+            D2D1_RECT_U BitmapBounds;
+            uint64_t Bytes;
+            uint64_t LastUsed;
+            std::list<uint32_t>::iterator LruPosition;
+        };
+
+        D2D1_RECT_U GetTileBounds(uint32_t column, uint32_t row) const;
+
+        // Releases least recently used tiles until within budget, except for
+        // those last used in protectedGeneration.
+        void Trim(uint64_t protectedGeneration);
+        void Evict(uint32_t index);
+
+        BitmapSize m_imageSize;
+        uint32_t m_tileSize;
+        uint32_t m_columnCount;
+        uint32_t m_rowCount;
+
+        std::vector<Slot> m_slots;
+
+        // Indices into m_slots of resident tiles, most recently used first.
+        std::list<uint32_t> m_lru;
+
+        uint64_t m_memoryBudget;
+        uint64_t m_residentBytes;
+        uint64_t m_generation;
+    };
+}}}}
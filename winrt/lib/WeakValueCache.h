@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Orders cache keys field by field, for use in their operator<:
+    //
+    //    return KeyComparison()
+    //        (Device, other.Device)
+    //        (Dpi, other.Dpi)
+    //        .IsLess();
+    //
+    // The first field that differs decides the order.
+    //
+    class KeyComparison
+    {
+        int m_order;
+
+    public:
+        KeyComparison()
+            : m_order(0)
+        { }
+
+        template<typename T>
+        KeyComparison& operator()(T const& value, T const& otherValue)
+        {
+            if (m_order == 0)
+            {
+                if (value < otherValue)
+                    m_order = -1;
+                else if (otherValue < value)
+                    m_order = 1;
+            }
+
+            return *this;
+        }
+
+        bool IsLess() const
+        {
+            return m_order < 0;
+        }
+    };
+
+
+    //
+    // Caches whose values can die while they are in the map use this to sweep
+    // out the dead entries.  It only sweeps once the map has doubled in size
+    // since the last sweep, so the cost is amortized across inserts.
+    //
+    class AmortizedPruner
+    {
+        static const size_t MinimumThreshold = 16;
+
+        size_t m_threshold;
+
+    public:
+        AmortizedPruner()
+            : m_threshold(MinimumThreshold)
+        { }
+
+        template<typename MAP, typename IS_DEAD_FN>
+        void Prune(MAP& map, IS_DEAD_FN&& isDead)
+        {
+            if (map.size() < m_threshold)
+                return;
+
+            for (auto it = map.begin(); it != map.end();)
+            {
+                if (isDead(it->second))
+                    it = map.erase(it);
+                else
+                    ++it;
+            }
+
+            m_threshold = map.size() * 2;
+
+            if (m_threshold < MinimumThreshold)
+                m_threshold = MinimumThreshold;
+        }
+    };
+
+
+    //
+    // Hands out shared VALUEs by KEY, so that callers asking for the same
+    // thing share one instance between them.
+    //
+    // The callers own the values; the cache only holds weak pointers, so a
+    // value is destroyed once the last caller lets go of it.  A key that
+    // holds a raw pointer relies on the value keeping that object alive, so
+    // that the pointer cannot be reused by a different object while the
+    // value is in the cache.
+    //
+    template<typename KEY, typename VALUE>
+    class WeakValueCache
+    {
+        typedef std::map<KEY, std::weak_ptr<VALUE>> EntryMap;
+
+        std::mutex m_mutex;
+        EntryMap m_entries;
+        AmortizedPruner m_pruner;
+
+    public:
+        //
+        // createValue is called, with the cache locked, if there is no live
+        // value for key.  It returns a std::shared_ptr<VALUE>.
+        //
+        template<typename FN>
+        std::shared_ptr<VALUE> GetOrCreate(KEY const& key, FN&& createValue)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto existing = TryGetExisting(key);
+
+            if (existing)
+                return existing;
+
+            auto value = createValue();
+
+            Insert(key, value);
+
+            return value;
+        }
+
+        //
+        // Like GetOrCreate, except that a caller which is swapping previous
+        // (cached under previousKey) for the value for key can have it
+        // recycled rather than creating another value.
+        //
+        // createValue is passed previous if nobody else is using it, or null
+        // otherwise.  If it returns previous, its old entry is removed.
+        //
+        template<typename FN>
+        std::shared_ptr<VALUE> GetOrRecycle(
+            KEY const& key,
+            std::shared_ptr<VALUE> const& previous,
+            KEY const& previousKey,
+            FN&& createValue)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto existing = TryGetExisting(key);
+
+            if (existing)
+                return existing;
+
+            // Values can only be got hold of through the cache, which we have
+            // locked, so a use count of one means the caller's is the only
+            // reference.
+            bool canRecycle = previous && previous.use_count() == 1;
+
+            auto value = createValue(canRecycle ? previous : nullptr);
+
+            if (canRecycle && value == previous)
+                m_entries.erase(previousKey);
+
+            Insert(key, value);
+
+            return value;
+        }
+
+    private:
+        std::shared_ptr<VALUE> TryGetExisting(KEY const& key)
+        {
+            auto it = m_entries.find(key);
+
+            if (it == m_entries.end())
+                return nullptr;
+
+            return it->second.lock();
+        }
+
+        void Insert(KEY const& key, std::shared_ptr<VALUE> const& value)
+        {
+            m_entries[key] = value;
+
+            m_pruner.Prune(m_entries, [](std::weak_ptr<VALUE> const& entry) { return entry.expired(); });
+        }
+    };
+
+
+    //
+    // Shares one CACHE between everything in the application, in the same
+    // way as the resource managers.
+    //
+    template<typename CACHE>
+    class PerApplicationCache : public PerApplicationManager<PerApplicationCache<CACHE>, CACHE>
+    {
+    public:
+        // Called by PerApplicationManager
+        static std::shared_ptr<CACHE> CreateManager()
+        {
+            return std::make_shared<CACHE>();
+        }
+    };
+}}}}
@@ -12,6 +12,9 @@
 
 #include "pch.h"
 #include "CanvasEffect.h"
+#include "DpiCompensatorCache.h"
+#include "..\DrawingStatistics.h"
+#include "..\Tracing.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace Effects 
 {
@@ -86,6 +89,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
     ICanvasImageInternal::RealizedEffectNode CanvasEffect::GetRealizedEffectNode(ID2D1DeviceContext* deviceContext, float targetDpi)
     {
+        TRACE_SPAN(EffectRealization);
+
         ThrowIfClosed();
 
         // Check if device is the same as previous device
@@ -129,6 +134,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         if (wasRecreated || m_properties->IsChanged())
         {
             SetD2DProperties();
+
+            if (auto statistics = DrawingStatistics::GetCurrent())
+                statistics->AddEffectNodeRealized();
         }
 
         // Update ID2D1Image with the latest inputs, and recurse through 
@@ -208,28 +216,6 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         ThrowIfFailed(m_inputs->SetAt(index, input));
     }
 
-    static ComPtr<ID2D1Effect> InsertDpiCompensationEffect(ID2D1DeviceContext* deviceContext, ID2D1Image* inputImage, float inputDpi, ID2D1Effect* reuseExistingCompensator)
-    {
-        ComPtr<ID2D1Effect> dpiCompensator = reuseExistingCompensator;
-
-        // Create the D2D1DpiCompensation effect, if we don't have one already.
-        if (!dpiCompensator)
-        {
-            ThrowIfFailed(deviceContext->CreateEffect(CLSID_D2D1DpiCompensation, &dpiCompensator));
-
-            ThrowIfFailed(dpiCompensator->SetValue(D2D1_DPICOMPENSATION_PROP_BORDER_MODE, D2D1_BORDER_MODE_HARD));
-            ThrowIfFailed(dpiCompensator->SetValue(D2D1_DPICOMPENSATION_PROP_INTERPOLATION_MODE, D2D1_DPICOMPENSATION_INTERPOLATION_MODE_LINEAR));
-        }
-
-        // Set our input image as source for the DPI compensation.
-        dpiCompensator->SetInput(0, inputImage);
-        
-        // Set the DPI.
-        ThrowIfFailed(dpiCompensator->SetValue(D2D1_DPICOMPENSATION_PROP_INPUT_DPI, D2D1_VECTOR_2F{ inputDpi, inputDpi }));
-
-        return dpiCompensator;
-    }
-
     void CanvasEffect::SetD2DInputs(ID2D1DeviceContext* deviceContext, float targetDpi, bool wasRecreated)
     {
         auto& inputs = m_inputs->InternalVector();
@@ -285,12 +271,23 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             {
                 if (needsDpiCompensation)
                 {
-                    m_dpiCompensators[i] = InsertDpiCompensationEffect(deviceContext, realizedInput.Image.Get(), realizedInput.Dpi, m_dpiCompensators[i].Get());
-                    realizedInput.Image = As<ID2D1Image>(m_dpiCompensators[i]);
+                    // Compensators are shared, so that an image feeding many
+                    // effects is only compensated once.
+                    if (!m_dpiCompensatorCache)
+                        m_dpiCompensatorCache = PerApplicationDpiCompensatorCache::GetOrCreateManager();
+
+                    m_dpiCompensators[i] = m_dpiCompensatorCache->GetOrCreate(
+                        m_previousDeviceIdentity.Get(),
+                        deviceContext,
+                        realizedInput.Image.Get(),
+                        realizedInput.Dpi,
+                        m_dpiCompensators[i]);
+
+                    realizedInput.Image = As<ID2D1Image>(m_dpiCompensators[i]->Effect);
                 }
                 else
                 {
-                    m_dpiCompensators[i].Reset();
+                    m_dpiCompensators[i].reset();
                 }
 
                 m_resource->SetInput(i, realizedInput.Image.Get());
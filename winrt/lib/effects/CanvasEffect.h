@@ -23,6 +23,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
     using namespace ABI::Microsoft::Graphics::Canvas;
     using namespace ::collections;
 
+    class DpiCompensatorCache;
+    struct SharedDpiCompensator;
+
     class CanvasEffect 
         : public Implements<
             RuntimeClassFlags<WinRtClassicComMix>,
@@ -50,7 +53,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         std::vector<uint64_t> m_previousInputRealizationIds;
         uint64_t m_realizationId;
         
-        std::vector<ComPtr<ID2D1Effect>> m_dpiCompensators;
+        std::vector<std::shared_ptr<SharedDpiCompensator>> m_dpiCompensators;
+        std::shared_ptr<DpiCompensatorCache> m_dpiCompensatorCache;
 
         bool m_insideGetImage;
 
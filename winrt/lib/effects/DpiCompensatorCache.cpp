@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "DpiCompensatorCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace Effects
+{
+    bool DpiCompensatorKey::operator<(DpiCompensatorKey const& other) const
+    {
+        return KeyComparison()
+            (Device, other.Device)
+            (InputImage, other.InputImage)
+            (InputDpi, other.InputDpi)
+            .IsLess();
+    }
+
+
+    static void SetCompensatorInput(ID2D1Effect* dpiCompensator, ID2D1Image* inputImage, float inputDpi)
+    {
+        dpiCompensator->SetInput(0, inputImage);
+
+        ThrowIfFailed(dpiCompensator->SetValue(D2D1_DPICOMPENSATION_PROP_INPUT_DPI, D2D1_VECTOR_2F{ inputDpi, inputDpi }));
+    }
+
+
+    std::shared_ptr<SharedDpiCompensator> DpiCompensatorCache::GetOrCreate(
+        IUnknown* deviceIdentity,
+        ID2D1DeviceContext* deviceContext,
+        ID2D1Image* inputImage,
+        float inputDpi,
+        std::shared_ptr<SharedDpiCompensator> const& previous)
+    {
+        DpiCompensatorKey key = { deviceIdentity, inputImage, inputDpi };
+
+        // Recycling previous changes its key, so take a copy of the old one.
+        auto previousKey = previous ? previous->Key : key;
+
+        return m_compensators.GetOrRecycle(
+            key,
+            previous,
+            previousKey,
+            [&](std::shared_ptr<SharedDpiCompensator> const& recyclable)
+            {
+                std::shared_ptr<SharedDpiCompensator> compensator;
+
+                if (recyclable && recyclable->Key.Device == deviceIdentity)
+                {
+                    compensator = recyclable;
+                }
+                else
+                {
+                    compensator = std::make_shared<SharedDpiCompensator>();
+
+                    ThrowIfFailed(deviceContext->CreateEffect(CLSID_D2D1DpiCompensation, &compensator->Effect));
+
+                    ThrowIfFailed(compensator->Effect->SetValue(D2D1_DPICOMPENSATION_PROP_BORDER_MODE, D2D1_BORDER_MODE_HARD));
+                    ThrowIfFailed(compensator->Effect->SetValue(D2D1_DPICOMPENSATION_PROP_INTERPOLATION_MODE, D2D1_DPICOMPENSATION_INTERPOLATION_MODE_LINEAR));
+                }
+
+                SetCompensatorInput(compensator->Effect.Get(), inputImage, inputDpi);
+                compensator->Key = key;
+
+                return compensator;
+            });
+    }
+}}}}}
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "..\WeakValueCache.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace Effects
+{
+    using namespace ::Microsoft::WRL;
+
+    struct DpiCompensatorKey
+    {
+        IUnknown* Device;
+        ID2D1Image* InputImage;
+        float InputDpi;
+
+        bool operator<(DpiCompensatorKey const& other) const;
+    };
+
+    // A D2D1DpiCompensation effect, shared by every CanvasEffect that feeds
+    // the same image at the same DPI into one of its inputs.
+    struct SharedDpiCompensator
+    {
+        DpiCompensatorKey Key;
+        ComPtr<ID2D1Effect> Effect;
+    };
+
+    //
+    // Hands out DPI compensation effects, so that a bitmap used by many
+    // effects is only compensated once per device.
+    //
+    // A compensator's D2D effect references its input image, which keeps the
+    // image pointer in its key valid.
+    //
+    class DpiCompensatorCache
+    {
+    public:
+        //
+        // If nobody else is using the caller's previous compensator and no
+        // compensator exists for the new key, the previous one is pointed at
+        // the new image rather than creating a new D2D effect.
+        //
+        std::shared_ptr<SharedDpiCompensator> GetOrCreate(
+            IUnknown* deviceIdentity,
+            ID2D1DeviceContext* deviceContext,
+            ID2D1Image* inputImage,
+            float inputDpi,
+            std::shared_ptr<SharedDpiCompensator> const& previous);
+
+    private:
+        WeakValueCache<DpiCompensatorKey, SharedDpiCompensator> m_compensators;
+    };
+
+
+    typedef PerApplicationCache<DpiCompensatorCache> PerApplicationDpiCompensatorCache;
+}}}}}
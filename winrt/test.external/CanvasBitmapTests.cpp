@@ -1010,6 +1010,79 @@ public:
         VerifyBitmapSetData<Color>(canvasBitmap, width, imageData, 1);
     }
 
+    static Platform::Array<Color>^ MakeSolidColors(int count, Color color)
+    {
+        auto colors = ref new Platform::Array<Color>(count);
+
+        for (int i = 0; i < count; i++)
+        {
+            colors[i] = color;
+        }
+
+        return colors;
+    }
+
+    TEST_METHOD(CanvasBitmap_SetPixelBytes_DiscardsMipLevels)
+    {
+        const int size = 4;
+
+        auto bitmap = CanvasBitmap::CreateFromColors(m_sharedDevice, MakeSolidColors(size * size, Colors::Red), size, size, CanvasAlphaMode::Premultiplied);
+
+        bitmap->GenerateMipLevels();
+        Assert::AreEqual(3, bitmap->MipLevelCount);
+
+        // Overwrite every pixel with opaque blue.
+        auto blueBytes = ref new Platform::Array<byte>(size * size * 4);
+
+        for (int i = 0; i < size * size; i++)
+        {
+            blueBytes[i * 4 + 0] = 255;
+            blueBytes[i * 4 + 1] = 0;
+            blueBytes[i * 4 + 2] = 0;
+            blueBytes[i * 4 + 3] = 255;
+        }
+
+        bitmap->SetPixelBytes(blueBytes);
+        Assert::AreEqual(1, bitmap->MipLevelCount);
+
+        // Drawing at half size would pick level 1 if it were still there, and
+        // that still holds the old red pixels.
+        auto target = ref new CanvasRenderTarget(m_sharedDevice, size / 2, size / 2, DEFAULT_DPI);
+
+        auto drawingSession = target->CreateDrawingSession();
+        drawingSession->Clear(Colors::Transparent);
+        drawingSession->DrawImage(bitmap, Rect(0, 0, size / 2, size / 2), Rect(0, 0, size, size));
+        delete drawingSession;
+
+        auto drawnColors = target->GetPixelColors();
+
+        for (unsigned int i = 0; i < drawnColors->Length; i++)
+        {
+            Assert::AreEqual(Colors::Blue, drawnColors[i]);
+        }
+    }
+
+    TEST_METHOD(CanvasBitmap_SetPixelColorsAndCopyPixelsFromBitmap_DiscardMipLevels)
+    {
+        const int size = 4;
+
+        auto bitmap = CanvasBitmap::CreateFromColors(m_sharedDevice, MakeSolidColors(size * size, Colors::Red), size, size, CanvasAlphaMode::Premultiplied);
+
+        bitmap->GenerateMipLevels();
+        bitmap->SetPixelColors(MakeSolidColors(size * size, Colors::Blue));
+        Assert::AreEqual(1, bitmap->MipLevelCount);
+
+        bitmap->GenerateMipLevels();
+        bitmap->SetPixelColors(MakeSolidColors(1, Colors::Green), 0, 0, 1, 1);
+        Assert::AreEqual(1, bitmap->MipLevelCount);
+
+        auto otherBitmap = CanvasBitmap::CreateFromColors(m_sharedDevice, MakeSolidColors(size * size, Colors::Green), size, size, CanvasAlphaMode::Premultiplied);
+
+        bitmap->GenerateMipLevels();
+        bitmap->CopyPixelsFromBitmap(otherBitmap);
+        Assert::AreEqual(1, bitmap->MipLevelCount);
+    }
+
     TEST_METHOD(CanvasBitmap_GetAndSetPixelBytesAndColors_InvalidArguments)
     {
         auto canvasBitmap = ref new CanvasRenderTarget(m_sharedDevice, 1, 1, DEFAULT_DPI);
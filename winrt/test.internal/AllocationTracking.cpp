@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include <new>
+#include <new.h>
+
+static __declspec(thread) size_t s_countingDepth;
+static __declspec(thread) size_t s_allocationCount;
+static __declspec(thread) size_t s_coTaskMemAllocationCount;
+
+static void CountComArrayAllocation()
+{
+    if (s_countingDepth)
+        ++s_coTaskMemAllocationCount;
+}
+
+void BeginCountingAllocations()
+{
+    DefaultComArrayBase::AllocationHook = CountComArrayAllocation;
+
+    ++s_countingDepth;
+}
+
+void EndCountingAllocations()
+{
+    assert(s_countingDepth > 0);
+    --s_countingDepth;
+}
+
+size_t GetAllocationCount()
+{
+    return s_allocationCount;
+}
+
+size_t GetCoTaskMemAllocationCount()
+{
+    return s_coTaskMemAllocationCount;
+}
+
+//
+// Replacements for the global operator new and delete.
+//
+// These are linked into the whole of winrt.test.internal, not just the
+// allocation tests, because C++ only allows the global operators to be
+// replaced for an entire module.  That is acceptable because they behave
+// exactly as the CRT's versions do: the CRT's operator new also allocates
+// with malloc, calls the new handler and then throws std::bad_alloc on
+// failure, and its operator delete frees with free.  The debug CRT's leak
+// tracking and heap checks therefore still see every allocation.  The only
+// difference is a thread-local increment while an AllocationCounter is
+// alive, so tests that don't use one see no change.
+//
+// These eight forms are every replaceable global allocation function that
+// the VS2013 compiler supports.  Placement new and delete can't be replaced,
+// and VS2013 doesn't implement the C++14 sized deallocation functions, so
+// there is no other overload that could pair one allocator with another's
+// deallocator.
+//
+
+void* operator new(size_t size)
+{
+    if (s_countingDepth)
+        ++s_allocationCount;
+
+    void* memory;
+
+    while ((memory = malloc(size ? size : 1)) == nullptr)
+    {
+        // Like the CRT's version, give the new handler a chance to free up
+        // some memory before failing.
+        if (_callnewh(size) == 0)
+            throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, std::nothrow_t const&) throw()
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (std::bad_alloc const&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, std::nothrow_t const& nothrow) throw()
+{
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* memory) throw()
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) throw()
+{
+    free(memory);
+}
+
+void operator delete(void* memory, std::nothrow_t const&) throw()
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, std::nothrow_t const&) throw()
+{
+    free(memory);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+//
+// The test binaries replace the global operator new (see
+// AllocationTracking.cpp) so that tests can check how many allocations a call
+// makes.  winrt.lib is statically linked, so this sees the library's
+// allocations as well as the test's own.
+//
+// Allocations are only counted while an AllocationCounter is alive, and only
+// those made on the thread it was created on.
+//
+size_t GetAllocationCount();
+
+//
+// CoTaskMemAlloc can't be replaced in the same way, so this counts the COM
+// arrays allocated by ComArray's default base, through its AllocationHook.
+// That covers the arrays the library returns, such as pixel reads.
+//
+size_t GetCoTaskMemAllocationCount();
+
+void BeginCountingAllocations();
+void EndCountingAllocations();
+
+//
+// Counts the allocations made between construction and the Get*Count() call.
+//
+class AllocationCounter
+{
+    size_t m_initialAllocationCount;
+    size_t m_initialCoTaskMemAllocationCount;
+
+    AllocationCounter(AllocationCounter const&);
+    AllocationCounter& operator=(AllocationCounter const&);
+
+public:
+    AllocationCounter()
+    {
+        BeginCountingAllocations();
+
+        m_initialAllocationCount = ::GetAllocationCount();
+        m_initialCoTaskMemAllocationCount = ::GetCoTaskMemAllocationCount();
+    }
+
+    ~AllocationCounter()
+    {
+        EndCountingAllocations();
+    }
+
+    size_t GetAllocationCount() const
+    {
+        return ::GetAllocationCount() - m_initialAllocationCount;
+    }
+
+    size_t GetCoTaskMemAllocationCount() const
+    {
+        return ::GetCoTaskMemAllocationCount() - m_initialCoTaskMemAllocationCount;
+    }
+};
+
+//
+// Calls fn once so that whatever it caches is in place, then checks that
+// calling it again allocates nothing.  This is intended for the paths that
+// apps hit every frame.
+//
+template<typename FN>
+void AssertSteadyStateDoesNotAllocate(FN&& fn)
+{
+    fn();
+
+    AllocationCounter counter;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        fn();
+    }
+
+    Assert::AreEqual<size_t>(0, counter.GetAllocationCount(), L"operator new called in steady state");
+    Assert::AreEqual<size_t>(0, counter.GetCoTaskMemAllocationCount(), L"CoTaskMemAlloc called in steady state");
+}
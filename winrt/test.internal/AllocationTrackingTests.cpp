@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "effects\generated\GaussianBlurEffect.h"
+#include "StubDrawingSessionFixture.h"
+#include "TestBitmapResourceCreationAdapter.h"
+
+TEST_CLASS(AllocationTrackingTests)
+{
+    TEST_METHOD(AllocationCounter_CountsOperatorNew)
+    {
+        AllocationCounter counter;
+
+        // Debug builds of std::vector allocate an extra iterator-debugging
+        // proxy, so this only uses raw allocations.
+        auto value = std::make_unique<int>(1);
+        auto values = std::make_unique<int[]>(10);
+
+        Assert::AreEqual<size_t>(2, counter.GetAllocationCount());
+        Assert::AreEqual<size_t>(0, counter.GetCoTaskMemAllocationCount());
+    }
+
+    TEST_METHOD(AllocationTracking_DoesNotCountOutsideAnAllocationCounter)
+    {
+        auto countBefore = GetAllocationCount();
+
+        auto value = std::make_unique<int>(1);
+
+        Assert::AreEqual(countBefore, GetAllocationCount());
+    }
+
+    TEST_METHOD(AllocationCounter_CountsComArrays)
+    {
+        AllocationCounter counter;
+
+        ComArray<float> array(16);
+        ComArray<float> movedArray(std::move(array));
+
+        Assert::AreEqual<size_t>(0, counter.GetAllocationCount());
+        Assert::AreEqual<size_t>(1, counter.GetCoTaskMemAllocationCount());
+    }
+
+    TEST_METHOD(AllocationCounter_CountsComArraysReturnedByTheLibrary)
+    {
+        auto strokeStyle = Make<CanvasStrokeStyle>();
+
+        float dashes[] = { 1, 2, 3, 4 };
+        ThrowIfFailed(strokeStyle->put_CustomDashStyle(_countof(dashes), dashes));
+
+        UINT32 valueCount;
+        float* valueElements;
+
+        {
+            AllocationCounter counter;
+
+            ThrowIfFailed(strokeStyle->get_CustomDashStyle(&valueCount, &valueElements));
+
+            Assert::AreEqual<size_t>(1, counter.GetCoTaskMemAllocationCount());
+        }
+
+        Assert::AreEqual<UINT32>(_countof(dashes), valueCount);
+        CoTaskMemFree(valueElements);
+    }
+
+    TEST_METHOD(ExceptionBoundary_DoesNotAllocateWhenNothingThrows)
+    {
+        AllocationCounter counter;
+
+        Assert::AreEqual(S_OK, ExceptionBoundary([] {}));
+
+        Assert::AreEqual<size_t>(0, counter.GetAllocationCount());
+    }
+};
+
+//
+// The calls apps make every frame should not allocate once whatever they
+// cache (color brushes, realized effects, wrappers) is in place.
+//
+TEST_CLASS(SteadyStateAllocationTests)
+{
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPrimitives_DoNotAllocate)
+    {
+        StubDrawingSessionFixture f;
+
+        Color color{ 255, 128, 64, 32 };
+        Vector2 point0{ 1, 2 };
+        Vector2 point1{ 30, 40 };
+        Rect rect{ 1, 2, 30, 40 };
+
+        AssertSteadyStateDoesNotAllocate(
+            [&]
+            {
+                ThrowIfFailed(f.DS->Clear(color));
+                ThrowIfFailed(f.DS->DrawLineWithColor(point0, point1, color));
+                ThrowIfFailed(f.DS->DrawLineWithBrush(point0, point1, f.Brush.Get()));
+                ThrowIfFailed(f.DS->FillRectangleWithColor(rect, color));
+                ThrowIfFailed(f.DS->FillEllipseWithBrush(point1, 5, 6, f.Brush.Get()));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Transform_DoesNotAllocate)
+    {
+        StubDrawingSessionFixture f;
+
+        AssertSteadyStateDoesNotAllocate(
+            [&]
+            {
+                Numerics::Matrix3x2 transform;
+                ThrowIfFailed(f.DS->get_Transform(&transform));
+                ThrowIfFailed(f.DS->put_Transform(transform));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawBitmap_DoesNotAllocate)
+    {
+        StubDrawingSessionFixture f;
+
+        auto bitmap = CreateStubCanvasBitmap();
+
+        AssertSteadyStateDoesNotAllocate(
+            [&]
+            {
+                ThrowIfFailed(f.DS->DrawImage(bitmap.Get(), Vector2{ 10, 20 }));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawUnchangedEffect_DoesNotAllocate)
+    {
+        StubDrawingSessionFixture f;
+
+        auto effect = Make<GaussianBlurEffect>();
+        ThrowIfFailed(effect->put_Source(As<IEffectInput>(CreateStubCanvasBitmap()).Get()));
+
+        AssertSteadyStateDoesNotAllocate(
+            [&]
+            {
+                ThrowIfFailed(f.DS->DrawImage(effect.Get(), Vector2{ 10, 20 }));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasEffect_GetProperty_DoesNotAllocate)
+    {
+        auto effect = Make<GaussianBlurEffect>();
+
+        AssertSteadyStateDoesNotAllocate(
+            [&]
+            {
+                float blurAmount;
+                ThrowIfFailed(effect->get_BlurAmount(&blurAmount));
+            });
+    }
+
+    TEST_METHOD_EX(ResourceTracker_GetOrCreateExistingWrapper_DoesNotAllocate)
+    {
+        auto manager = std::make_shared<CanvasBitmapManager>(std::make_shared<TestBitmapResourceCreationAdapter>());
+        auto d2dBitmap = Make<StubD2DBitmap>();
+        auto wrapper = manager->GetOrCreate(nullptr, d2dBitmap.Get());
+
+        AssertSteadyStateDoesNotAllocate(
+            [&]
+            {
+                auto existingWrapper = manager->GetOrCreate(nullptr, d2dBitmap.Get());
+                Assert::AreEqual(wrapper.Get(), existingWrapper.Get());
+            });
+    }
+};
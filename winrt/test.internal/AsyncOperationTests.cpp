@@ -12,6 +12,8 @@
 
 #include "pch.h"
 
+#include "ManualAsyncScheduler.h"
+
 using namespace Microsoft::WRL::Wrappers;
 
 
@@ -37,6 +39,10 @@ namespace ABI {
         namespace Foundation {
             template<> struct __declspec(uuid("853707c5-fd26-499d-aefe-a7d986137939")) IAsyncOperation                <MockAsyncResult*> : IAsyncOperation_impl                <MockAsyncResult*> { static const wchar_t* z_get_rc_name_impl() { return L""; } };
             template<> struct __declspec(uuid("40bd86ee-66d9-4623-b144-0df7c81aa9f4")) IAsyncOperationCompletedHandler<MockAsyncResult*> : IAsyncOperationCompletedHandler_impl<MockAsyncResult*> { static const wchar_t* z_get_rc_name_impl() { return L""; } };
+
+            template<> struct __declspec(uuid("e48e35ae-e5b1-4d97-b987-136d1cbd446d")) IAsyncOperationWithProgress                <MockAsyncResult*, UINT32> : IAsyncOperationWithProgress_impl                <MockAsyncResult*, UINT32> { static const wchar_t* z_get_rc_name_impl() { return L""; } };
+            template<> struct __declspec(uuid("e2c9d62e-1582-4efb-8e38-4c78ca25d4b8")) IAsyncOperationWithProgressCompletedHandler<MockAsyncResult*, UINT32> : IAsyncOperationWithProgressCompletedHandler_impl<MockAsyncResult*, UINT32> { static const wchar_t* z_get_rc_name_impl() { return L""; } };
+            template<> struct __declspec(uuid("e7faa381-bbd7-4115-90fb-117cc2cb1da2")) IAsyncOperationProgressHandler             <MockAsyncResult*, UINT32> : IAsyncOperationProgressHandler_impl             <MockAsyncResult*, UINT32> { static const wchar_t* z_get_rc_name_impl() { return L""; } };
         }
     }
 }
@@ -563,6 +569,312 @@ TEST_CLASS(AsyncOperationTests)
     }
 
 
+    typedef AsyncOperationWithProgress<MockAsyncResult, UINT32> MockAsyncWithProgress;
+
+
+    TEST_METHOD(AsyncWithProgressReportsProgressTest)
+    {
+        MockAsyncResult expectedResult;
+        Event asyncCanFinishNow(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+        Event asyncFinished(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+
+        auto async = Make<MockAsyncWithProgress>([&](MockAsyncWithProgress* operation)
+        {
+            // Block until the calling code has subscribed to the progress callback.
+            Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(asyncCanFinishNow.Get(), waitTimeout, false));
+
+            for (UINT32 i = 1; i <= 3; i++)
+            {
+                operation->ReportProgress(i);
+            }
+
+            return &expectedResult;
+        });
+
+        // Subscribe to the progress and completion callbacks.
+        std::vector<UINT32> reportedProgress;
+
+        auto progressCallback = Callback<IAsyncOperationProgressHandler<MockAsyncResult*, UINT32>>([&](IAsyncOperationWithProgress<MockAsyncResult*, UINT32> *asyncInfo, UINT32 progress)
+        {
+            Assert::IsTrue(IsSameInstance(async.Get(), asyncInfo));
+
+            reportedProgress.push_back(progress);
+            return S_OK;
+        });
+
+        ThrowIfFailed(async->put_Progress(progressCallback.Get()));
+
+        auto completedCallback = Callback<IAsyncOperationWithProgressCompletedHandler<MockAsyncResult*, UINT32>>([&](IAsyncOperationWithProgress<MockAsyncResult*, UINT32> *asyncInfo, AsyncStatus status)
+        {
+            Assert::AreEqual(AsyncStatus::Completed, status);
+            Assert::IsTrue(IsSameInstance(async.Get(), asyncInfo));
+
+            SetEvent(asyncFinished.Get());
+            return S_OK;
+        });
+
+        ThrowIfFailed(async->put_Completed(completedCallback.Get()));
+
+        // Tell the async operation to complete, then wait until it has.
+        SetEvent(asyncCanFinishNow.Get());
+
+        Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(asyncFinished.Get(), waitTimeout, false));
+
+        // Progress should have been reported in order, before completion.
+        Assert::AreEqual<size_t>(3, reportedProgress.size());
+
+        for (UINT32 i = 0; i < 3; i++)
+        {
+            Assert::AreEqual(i + 1, reportedProgress[i]);
+        }
+
+        ComPtr<MockAsyncResult> result;
+        ThrowIfFailed(async->GetResults(&result));
+        Assert::AreEqual<void*>(&expectedResult, result.Get());
+
+        result = nullptr;
+        AssertExpectedRefCount(async, 1);
+    }
+
+
+    TEST_METHOD(AsyncWithProgressCanceledTest)
+    {
+        Event asyncCanFinishNow(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+        Event asyncFinished(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+
+        bool workerSawCancel = false;
+
+        auto async = Make<MockAsyncWithProgress>([&](MockAsyncWithProgress* operation) -> ComPtr<MockAsyncResult>
+        {
+            Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(asyncCanFinishNow.Get(), waitTimeout, false));
+
+            // Worker functions poll for cancellation, so they can stop early.
+            workerSawCancel = operation->IsCancelled();
+
+            return nullptr;
+        });
+
+        auto completedCallback = Callback<IAsyncOperationWithProgressCompletedHandler<MockAsyncResult*, UINT32>>([&](IAsyncOperationWithProgress<MockAsyncResult*, UINT32> *asyncInfo, AsyncStatus status)
+        {
+            Assert::AreEqual(AsyncStatus::Canceled, status);
+
+            SetEvent(asyncFinished.Get());
+            return S_OK;
+        });
+
+        ThrowIfFailed(async->put_Completed(completedCallback.Get()));
+
+        async->Cancel();
+
+        // Tell the async worker thread to complete, then wait until it has.
+        SetEvent(asyncCanFinishNow.Get());
+
+        Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(asyncFinished.Get(), waitTimeout, false));
+
+        Assert::IsTrue(workerSawCancel);
+
+        ComPtr<MockAsyncResult> result;
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, async->GetResults(&result));
+
+        AssertExpectedRefCount(async, 1);
+    }
+
+
+    static ComPtr<AsyncAction> MakeAction(std::shared_ptr<ManualAsyncScheduler> const& scheduler, AsyncWorkOptions const& options, std::function<void()> work)
+    {
+        auto action = Make<AsyncAction>(options, [=](AsyncCancellationToken const&)
+        {
+            work();
+        }, scheduler);
+
+        CheckMakeResult(action);
+        return action;
+    }
+
+
+    TEST_METHOD(AsyncScheduler_RunsHigherPriorityWorkFirst)
+    {
+        auto scheduler = std::make_shared<ManualAsyncScheduler>();
+        std::vector<int> order;
+
+        auto a = MakeAction(scheduler, AsyncWorkOptions(AsyncWorkPriority::Background), [&] { order.push_back(1); });
+        auto b = MakeAction(scheduler, AsyncWorkOptions(AsyncWorkPriority::Normal),     [&] { order.push_back(2); });
+        auto c = MakeAction(scheduler, AsyncWorkOptions(AsyncWorkPriority::Interactive), [&] { order.push_back(3); });
+        auto d = MakeAction(scheduler, AsyncWorkOptions(AsyncWorkPriority::Normal),     [&] { order.push_back(4); });
+
+        // Nothing runs until the scheduler says so.
+        Assert::AreEqual<size_t>(4, scheduler->GetPendingCount());
+        Assert::IsTrue(order.empty());
+
+        scheduler->RunAll();
+
+        // Interactive first, background last, and first-come first-served in between.
+        int expected[] = { 3, 2, 4, 1 };
+        Assert::AreEqual<size_t>(_countof(expected), order.size());
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            Assert::AreEqual(expected[i], order[i]);
+        }
+
+        for (auto& action : { a, b, c, d })
+        {
+            AsyncStatus status;
+            ThrowIfFailed(action->get_Status(&status));
+            Assert::AreEqual(AsyncStatus::Completed, status);
+        }
+    }
+
+
+    TEST_METHOD(AsyncScheduler_IoAndCpuQueuesAreSeparate)
+    {
+        auto scheduler = std::make_shared<ManualAsyncScheduler>();
+        bool ioRan = false;
+        bool cpuRan = false;
+
+        auto io = MakeAction(scheduler, AsyncWorkOptions(AsyncWorkPriority::Interactive, AsyncWorkQueue::Io), [&] { ioRan = true; });
+        auto cpu = MakeAction(scheduler, AsyncWorkOptions(AsyncWorkPriority::Background, AsyncWorkQueue::Cpu), [&] { cpuRan = true; });
+
+        Assert::AreEqual<size_t>(1, scheduler->GetPendingCount(AsyncWorkQueue::Io));
+        Assert::AreEqual<size_t>(1, scheduler->GetPendingCount(AsyncWorkQueue::Cpu));
+
+        // Higher priority I/O work does not hold up the CPU queue.
+        Assert::IsTrue(scheduler->RunNext(AsyncWorkQueue::Cpu));
+        Assert::IsTrue(cpuRan);
+        Assert::IsFalse(ioRan);
+
+        Assert::IsFalse(scheduler->RunNext(AsyncWorkQueue::Cpu));
+
+        Assert::IsTrue(scheduler->RunNext(AsyncWorkQueue::Io));
+        Assert::IsTrue(ioRan);
+    }
+
+
+    TEST_METHOD(ThreadPoolAsyncScheduler_GetDefault_ReturnsSameInstance)
+    {
+        auto scheduler = ThreadPoolAsyncScheduler::GetDefault();
+
+        Assert::IsNotNull(scheduler.get());
+        Assert::IsTrue(scheduler == ThreadPoolAsyncScheduler::GetDefault());
+    }
+
+
+    TEST_METHOD(AsyncScheduler_CancelWhileQueued_WorkerNeverRuns)
+    {
+        auto scheduler = std::make_shared<ManualAsyncScheduler>();
+        bool workerRan = false;
+        bool hasCallbackFired = false;
+
+        auto action = MakeAction(scheduler, AsyncWorkOptions(), [&] { workerRan = true; });
+
+        auto completedCallback = Callback<IAsyncActionCompletedHandler>([&](IAsyncAction*, AsyncStatus status)
+        {
+            Assert::AreEqual(AsyncStatus::Canceled, status);
+            hasCallbackFired = true;
+            return S_OK;
+        });
+
+        ThrowIfFailed(action->put_Completed(completedCallback.Get()));
+
+        ThrowIfFailed(action->Cancel());
+
+        // Completion is reported once the scheduler gets to the cancelled work item.
+        Assert::IsFalse(hasCallbackFired);
+
+        scheduler->RunAll();
+
+        Assert::IsFalse(workerRan);
+        Assert::IsTrue(hasCallbackFired);
+
+        AssertExpectedRefCount(action, 1);
+    }
+
+
+    TEST_METHOD(AsyncScheduler_CancelWhileRunning_TokenSeesItImmediately)
+    {
+        auto scheduler = std::make_shared<ManualAsyncScheduler>();
+        ComPtr<AsyncAction> action;
+        int stepsAfterCancel = -1;
+
+        action = Make<AsyncAction>(AsyncWorkOptions(), [&](AsyncCancellationToken const& token)
+        {
+            for (int step = 0; step < 10; step++)
+            {
+                if (step == 3)
+                {
+                    ThrowIfFailed(action->Cancel());
+                    stepsAfterCancel = 0;
+                }
+
+                if (token.IsCancellationRequested())
+                    return;
+
+                if (stepsAfterCancel >= 0)
+                    stepsAfterCancel++;
+            }
+        }, scheduler);
+
+        scheduler->RunAll();
+
+        // The worker noticed on the very next check.
+        Assert::AreEqual(0, stepsAfterCancel);
+
+        AsyncStatus status;
+        ThrowIfFailed(action->get_Status(&status));
+        Assert::AreEqual(AsyncStatus::Canceled, status);
+
+        action.Reset();
+    }
+
+
+    TEST_METHOD(AsyncScheduler_ThrowIfCancellationRequested_IsNotReportedAsAnError)
+    {
+        auto scheduler = std::make_shared<ManualAsyncScheduler>();
+        ComPtr<AsyncOperation<MockAsyncResult>> async;
+
+        async = Make<AsyncOperation<MockAsyncResult>>(AsyncWorkOptions(), [&](AsyncCancellationToken const& token) -> ComPtr<MockAsyncResult>
+        {
+            ThrowIfFailed(async->Cancel());
+            token.ThrowIfCancellationRequested();
+
+            Assert::Fail(L"Should have thrown");
+            return nullptr;
+        }, scheduler);
+
+        scheduler->RunAll();
+
+        AsyncStatus status;
+        ThrowIfFailed(async->get_Status(&status));
+        Assert::AreEqual(AsyncStatus::Canceled, status);
+
+        async.Reset();
+    }
+
+
+    TEST_METHOD(AsyncScheduler_OperationReturnsResult)
+    {
+        auto scheduler = std::make_shared<ManualAsyncScheduler>();
+        MockAsyncResult expectedResult;
+
+        auto async = Make<AsyncOperation<MockAsyncResult>>(AsyncWorkOptions(AsyncWorkPriority::Interactive), [&](AsyncCancellationToken const& token)
+        {
+            Assert::IsFalse(token.IsCancellationRequested());
+            return &expectedResult;
+        }, scheduler);
+
+        ComPtr<MockAsyncResult> result;
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, async->GetResults(&result));
+
+        scheduler->RunAll();
+
+        ThrowIfFailed(async->GetResults(&result));
+        Assert::AreEqual<void*>(&expectedResult, result.Get());
+
+        result = nullptr;
+        AssertExpectedRefCount(async, 1);
+    }
+
+
     template<typename T>
     static void AssertExpectedRefCount(ComPtr<T> const& ptr, unsigned long expected)
     {
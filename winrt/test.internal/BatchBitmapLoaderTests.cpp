@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include <atomic>
+#include <thread>
+
+TEST_CLASS(BatchBitmapLoaderTests)
+{
+    static const uint32_t itemCount = 20;
+
+    // Runs each work item straight away, on the calling thread.
+    static BatchBitmapLoader::Scheduler InlineScheduler()
+    {
+        return [](std::function<void()>&& work)
+        {
+            work();
+        };
+    }
+
+    // Runs each work item on a new thread, which the test must join.
+    class ThreadScheduler
+    {
+        std::mutex m_mutex;
+        std::vector<std::thread> m_threads;
+
+    public:
+        BatchBitmapLoader::Scheduler Get()
+        {
+            return [this](std::function<void()>&& work)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_threads.emplace_back(std::move(work));
+            };
+        }
+
+        void Join()
+        {
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+    };
+
+    static bool NeverCancelled()
+    {
+        return false;
+    }
+
+    TEST_METHOD(BatchBitmapLoader_UploadsEveryItemInOrder)
+    {
+        ThreadScheduler scheduler;
+        BatchBitmapLoader loader(itemCount, 4, scheduler.Get());
+
+        std::vector<ComPtr<IWICFormatConverter>> decoded(itemCount);
+        std::vector<uint32_t> uploadOrder;
+
+        bool finished = loader.Run(
+            [&](uint32_t index)
+            {
+                // Later items finish decoding first.
+                Sleep((itemCount - index) % 3);
+
+                decoded[index] = Make<MockWICFormatConverter>();
+                return decoded[index];
+            },
+            [&](uint32_t index, IWICFormatConverter* converter)
+            {
+                Assert::IsTrue(decoded[index].Get() == converter);
+                uploadOrder.push_back(index);
+            },
+            NeverCancelled);
+
+        scheduler.Join();
+
+        Assert::IsTrue(finished);
+        Assert::AreEqual<size_t>(itemCount, uploadOrder.size());
+
+        for (uint32_t i = 0; i < itemCount; i++)
+        {
+            Assert::AreEqual(i, uploadOrder[i]);
+        }
+    }
+
+    TEST_METHOD(BatchBitmapLoader_LimitsConcurrentDecodes)
+    {
+        const uint32_t maxConcurrentDecodes = 3;
+
+        ThreadScheduler scheduler;
+        BatchBitmapLoader loader(itemCount, maxConcurrentDecodes, scheduler.Get());
+
+        std::atomic<uint32_t> decodesInFlight(0);
+        std::atomic<uint32_t> maxDecodesInFlight(0);
+
+        loader.Run(
+            [&](uint32_t)
+            {
+                auto inFlight = ++decodesInFlight;
+
+                auto previousMax = maxDecodesInFlight.load();
+                while (inFlight > previousMax && !maxDecodesInFlight.compare_exchange_weak(previousMax, inFlight))
+                {
+                }
+
+                Sleep(1);
+
+                --decodesInFlight;
+
+                return Make<MockWICFormatConverter>();
+            },
+            [&](uint32_t, IWICFormatConverter*) {},
+            NeverCancelled);
+
+        scheduler.Join();
+
+        Assert::IsTrue(maxDecodesInFlight.load() <= maxConcurrentDecodes);
+    }
+
+    TEST_METHOD(BatchBitmapLoader_DecodesRunALimitedDistanceAheadOfUploads)
+    {
+        const uint32_t maxConcurrentDecodes = 2;
+
+        BatchBitmapLoader loader(itemCount, maxConcurrentDecodes, InlineScheduler());
+
+        uint32_t decodeCount = 0;
+
+        loader.Run(
+            [&](uint32_t index)
+            {
+                Assert::AreEqual(decodeCount, index);
+                decodeCount++;
+                return Make<MockWICFormatConverter>();
+            },
+            [&](uint32_t index, IWICFormatConverter*)
+            {
+                Assert::IsTrue(decodeCount > index);
+                Assert::IsTrue(decodeCount <= index + maxConcurrentDecodes * 2);
+            },
+            NeverCancelled);
+
+        Assert::AreEqual(itemCount, decodeCount);
+    }
+
+    TEST_METHOD(BatchBitmapLoader_WhenCancelled_StopsAndReturnsFalse)
+    {
+        ThreadScheduler scheduler;
+        BatchBitmapLoader loader(itemCount, 2, scheduler.Get());
+
+        uint32_t uploadCount = 0;
+
+        bool finished = loader.Run(
+            [&](uint32_t)
+            {
+                return Make<MockWICFormatConverter>();
+            },
+            [&](uint32_t, IWICFormatConverter*)
+            {
+                uploadCount++;
+            },
+            [&]
+            {
+                return uploadCount == 3;
+            });
+
+        scheduler.Join();
+
+        Assert::IsFalse(finished);
+        Assert::AreEqual(3u, uploadCount);
+    }
+
+    TEST_METHOD(BatchBitmapLoader_WhenDecodeFails_ErrorIsThrownAfterEarlierItemsAreUploaded)
+    {
+        ThreadScheduler scheduler;
+        BatchBitmapLoader loader(itemCount, 4, scheduler.Get());
+
+        uint32_t uploadCount = 0;
+
+        ExpectHResultException(WINCODEC_ERR_COMPONENTNOTFOUND,
+            [&]
+            {
+                loader.Run(
+                    [&](uint32_t index) -> ComPtr<IWICFormatConverter>
+                    {
+                        if (index == 5)
+                            ThrowHR(WINCODEC_ERR_COMPONENTNOTFOUND);
+
+                        return Make<MockWICFormatConverter>();
+                    },
+                    [&](uint32_t, IWICFormatConverter*)
+                    {
+                        uploadCount++;
+                    },
+                    NeverCancelled);
+            });
+
+        scheduler.Join();
+
+        Assert::AreEqual(5u, uploadCount);
+    }
+
+    TEST_METHOD(BatchBitmapLoader_WhenUploadFails_ErrorIsThrown)
+    {
+        BatchBitmapLoader loader(itemCount, 4, InlineScheduler());
+
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                loader.Run(
+                    [&](uint32_t)
+                    {
+                        return Make<MockWICFormatConverter>();
+                    },
+                    [&](uint32_t, IWICFormatConverter*)
+                    {
+                        ThrowHR(E_OUTOFMEMORY);
+                    },
+                    NeverCancelled);
+            });
+    }
+
+    TEST_METHOD(BatchBitmapLoader_WhenNoItems_FinishesWithoutDecoding)
+    {
+        BatchBitmapLoader loader(0, 4, InlineScheduler());
+
+        bool finished = loader.Run(
+            [&](uint32_t) -> ComPtr<IWICFormatConverter>
+            {
+                Assert::Fail();
+                return nullptr;
+            },
+            [&](uint32_t, IWICFormatConverter*)
+            {
+                Assert::Fail();
+            },
+            NeverCancelled);
+
+        Assert::IsTrue(finished);
+    }
+};
@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(BitmapMipChainTests)
+{
+    static void AssertSize(uint32_t expectedWidth, uint32_t expectedHeight, D2D1_SIZE_U const& size)
+    {
+        Assert::AreEqual(expectedWidth, size.width);
+        Assert::AreEqual(expectedHeight, size.height);
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetLevelSizes_HalvesDownToOnePixel)
+    {
+        auto sizes = BitmapMipChain::GetLevelSizes(D2D1::SizeU(8, 4));
+
+        Assert::AreEqual<size_t>(3, sizes.size());
+        AssertSize(4, 2, sizes[0]);
+        AssertSize(2, 1, sizes[1]);
+        AssertSize(1, 1, sizes[2]);
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetLevelSizes_OddSizesRoundDown)
+    {
+        auto sizes = BitmapMipChain::GetLevelSizes(D2D1::SizeU(5, 3));
+
+        Assert::AreEqual<size_t>(2, sizes.size());
+        AssertSize(2, 1, sizes[0]);
+        AssertSize(1, 1, sizes[1]);
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetLevelSizes_TinyOrEmptyBitmapsHaveNoLevels)
+    {
+        Assert::IsTrue(BitmapMipChain::GetLevelSizes(D2D1::SizeU(1, 1)).empty());
+        Assert::IsTrue(BitmapMipChain::GetLevelSizes(D2D1::SizeU(0, 0)).empty());
+        Assert::IsTrue(BitmapMipChain::GetLevelSizes(D2D1::SizeU(0, 16)).empty());
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetMemoryOverhead)
+    {
+        // 4x2 + 2x1 + 1x1 pixels.
+        Assert::AreEqual(11ull * 4, BitmapMipChain::GetMemoryOverhead(D2D1::SizeU(8, 4), 4));
+
+        // A square power of two chain adds about a third to the original.
+        auto overhead = BitmapMipChain::GetMemoryOverhead(D2D1::SizeU(1024, 1024), 4);
+        auto original = 1024ull * 1024 * 4;
+
+        Assert::IsTrue(overhead < original / 3 + 4);
+        Assert::IsTrue(overhead > original / 3 - 4);
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_IsFormatSupported)
+    {
+        Assert::IsTrue(BitmapMipChain::IsFormatSupported(DXGI_FORMAT_B8G8R8A8_UNORM));
+        Assert::IsTrue(BitmapMipChain::IsFormatSupported(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB));
+
+        Assert::IsFalse(BitmapMipChain::IsFormatSupported(DXGI_FORMAT_A8_UNORM));
+        Assert::IsFalse(BitmapMipChain::IsFormatSupported(DXGI_FORMAT_R16G16B16A16_FLOAT));
+        Assert::IsFalse(BitmapMipChain::IsFormatSupported(DXGI_FORMAT_BC1_UNORM));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_IsSrgbFormat)
+    {
+        Assert::IsTrue(BitmapMipChain::IsSrgbFormat(DXGI_FORMAT_B8G8R8A8_UNORM_SRGB));
+        Assert::IsTrue(BitmapMipChain::IsSrgbFormat(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB));
+
+        Assert::IsFalse(BitmapMipChain::IsSrgbFormat(DXGI_FORMAT_B8G8R8A8_UNORM));
+        Assert::IsFalse(BitmapMipChain::IsSrgbFormat(DXGI_FORMAT_R8G8B8A8_UNORM));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_SelectLevel)
+    {
+        Assert::AreEqual(0u, BitmapMipChain::SelectLevel(4.0f, 5));
+        Assert::AreEqual(0u, BitmapMipChain::SelectLevel(1.0f, 5));
+        Assert::AreEqual(0u, BitmapMipChain::SelectLevel(0.6f, 5));
+        Assert::AreEqual(1u, BitmapMipChain::SelectLevel(0.5f, 5));
+        Assert::AreEqual(1u, BitmapMipChain::SelectLevel(0.3f, 5));
+        Assert::AreEqual(2u, BitmapMipChain::SelectLevel(0.25f, 5));
+        Assert::AreEqual(3u, BitmapMipChain::SelectLevel(0.07f, 5));
+
+        // Never picks a level that does not exist.
+        Assert::AreEqual(2u, BitmapMipChain::SelectLevel(0.01f, 2));
+        Assert::AreEqual(0u, BitmapMipChain::SelectLevel(0.01f, 0));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetDrawScale_UsesDestAndSourceSizes)
+    {
+        auto identity = D2D1::Matrix3x2F::Identity();
+
+        Assert::AreEqual(0.25f, BitmapMipChain::GetDrawScale(identity, DEFAULT_DPI, D2D1::RectF(0, 0, 100, 50), D2D1::RectF(0, 0, 400, 200), DEFAULT_DPI));
+        Assert::AreEqual(2.0f, BitmapMipChain::GetDrawScale(identity, DEFAULT_DPI, D2D1::RectF(10, 10, 210, 110), D2D1::RectF(0, 0, 100, 50), DEFAULT_DPI));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetDrawScale_UsesTheLargerAxis)
+    {
+        auto identity = D2D1::Matrix3x2F::Identity();
+
+        // Squashed horizontally but full size vertically.
+        Assert::AreEqual(1.0f, BitmapMipChain::GetDrawScale(identity, DEFAULT_DPI, D2D1::RectF(0, 0, 10, 200), D2D1::RectF(0, 0, 400, 200), DEFAULT_DPI));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetDrawScale_IncludesTransformAndDpi)
+    {
+        auto dest = D2D1::RectF(0, 0, 100, 100);
+        auto source = D2D1::RectF(0, 0, 100, 100);
+
+        Assert::AreEqual(0.5f, BitmapMipChain::GetDrawScale(D2D1::Matrix3x2F::Scale(0.5f, 0.5f), DEFAULT_DPI, dest, source, DEFAULT_DPI));
+        Assert::AreEqual(0.5f, BitmapMipChain::GetDrawScale(D2D1::Matrix3x2F::Scale(-0.5f, 0.5f), DEFAULT_DPI, dest, source, DEFAULT_DPI));
+
+        // Rotation does not change the scale.
+        auto rotated = BitmapMipChain::GetDrawScale(D2D1::Matrix3x2F::Rotation(30) * D2D1::Matrix3x2F::Scale(0.5f, 0.5f), DEFAULT_DPI, dest, source, DEFAULT_DPI);
+        Assert::AreEqual(0.5f, rotated, 0.0001f);
+
+        // A high DPI target has more pixels to cover; a high DPI bitmap has more pixels to fit in.
+        Assert::AreEqual(2.0f, BitmapMipChain::GetDrawScale(D2D1::Matrix3x2F::Identity(), DEFAULT_DPI * 2, dest, source, DEFAULT_DPI));
+        Assert::AreEqual(0.5f, BitmapMipChain::GetDrawScale(D2D1::Matrix3x2F::Identity(), DEFAULT_DPI, dest, source, DEFAULT_DPI * 2));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_GetDrawScale_EmptySourceIsFullSize)
+    {
+        Assert::AreEqual(1.0f, BitmapMipChain::GetDrawScale(D2D1::Matrix3x2F::Identity(), DEFAULT_DPI, D2D1::RectF(0, 0, 10, 10), D2D1::RectF(0, 0, 0, 0), DEFAULT_DPI));
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_Downsample_AveragesEachBlock)
+    {
+        // 4x2 source, with some padding at the end of each row.
+        const uint32_t sourceStride = 20;
+
+        BYTE source[sourceStride * 2] =
+        {
+            0, 0, 0, 0,         4, 8, 12, 16,       100, 100, 100, 100, 200, 200, 200, 200,     99, 99, 99, 99,
+            8, 16, 24, 32,      4, 8, 12, 16,       100, 100, 100, 100, 200, 200, 200, 200,     99, 99, 99, 99,
+        };
+
+        BYTE dest[2 * 4] = {};
+
+        BitmapMipChain::Downsample(source, D2D1::SizeU(4, 2), sourceStride, dest, D2D1::SizeU(2, 1), 8, false);
+
+        BYTE expected[] = { 4, 8, 12, 16, 150, 150, 150, 150 };
+
+        for (size_t i = 0; i < _countof(expected); i++)
+        {
+            Assert::AreEqual<int>(expected[i], dest[i]);
+        }
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_Downsample_SrgbAveragesColorInLinearLight)
+    {
+        // A 2x2 checkerboard of black and white, with alpha varying too.
+        BYTE source[] =
+        {
+            0, 0, 0, 0,             255, 255, 255, 255,
+            255, 255, 255, 255,     0, 0, 0, 0,
+        };
+
+        BYTE dest[4] = {};
+
+        BitmapMipChain::Downsample(source, D2D1::SizeU(2, 2), 8, dest, D2D1::SizeU(1, 1), 4, true);
+
+        // Half way between black and white in linear light is 188 once
+        // encoded as sRGB, rather than the 128 a gamma space average gives.
+        // Alpha is not gamma encoded, so is still averaged as stored.
+        BYTE expected[] = { 188, 188, 188, 128 };
+
+        for (size_t i = 0; i < _countof(expected); i++)
+        {
+            Assert::AreEqual<int>(expected[i], dest[i]);
+        }
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_Downsample_SrgbLeavesSolidColorsUnchanged)
+    {
+        BYTE source[] = { 10, 100, 200, 255 };
+        BYTE dest[4] = {};
+
+        BitmapMipChain::Downsample(source, D2D1::SizeU(1, 1), 4, dest, D2D1::SizeU(1, 1), 4, true);
+
+        for (size_t i = 0; i < _countof(source); i++)
+        {
+            Assert::AreEqual<int>(source[i], dest[i]);
+        }
+    }
+
+    TEST_METHOD_EX(BitmapMipChain_Downsample_OddSizesReuseTheLastRowAndColumn)
+    {
+        // A 1x1 image stays the same, rather than reading past the end.
+        BYTE source[] = { 10, 20, 30, 40 };
+        BYTE dest[4] = {};
+
+        BitmapMipChain::Downsample(source, D2D1::SizeU(1, 1), 4, dest, D2D1::SizeU(1, 1), 4, false);
+
+        for (size_t i = 0; i < _countof(source); i++)
+        {
+            Assert::AreEqual<int>(source[i], dest[i]);
+        }
+    }
+};
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(BlockCompressionTests)
+{
+    // A 4x4 block of BGRA pixels, all set to the same color.
+    static std::vector<BYTE> MakeSolidBlock(BYTE b, BYTE g, BYTE r, BYTE a)
+    {
+        std::vector<BYTE> pixels;
+
+        for (int i = 0; i < 16; i++)
+        {
+            pixels.push_back(b);
+            pixels.push_back(g);
+            pixels.push_back(r);
+            pixels.push_back(a);
+        }
+
+        return pixels;
+    }
+
+    static void SetPixel(std::vector<BYTE>& pixels, int index, BYTE b, BYTE g, BYTE r, BYTE a)
+    {
+        pixels[index * 4 + 0] = b;
+        pixels[index * 4 + 1] = g;
+        pixels[index * 4 + 2] = r;
+        pixels[index * 4 + 3] = a;
+    }
+
+    static std::vector<BYTE> EncodeBlock(DXGI_FORMAT format, std::vector<BYTE> const& pixels)
+    {
+        return BlockCompression::Encode(format, pixels.data(), D2D1::SizeU(4, 4), 16);
+    }
+
+    static void AssertBytes(std::vector<BYTE> const& expected, BYTE const* actual)
+    {
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            Assert::AreEqual<int>(expected[i], actual[i]);
+        }
+    }
+
+    TEST_METHOD_EX(BlockCompression_RowHelpers_MeasureBlockCompressedFormatsInBlocks)
+    {
+        Assert::IsTrue(IsBlockCompressedFormat(DXGI_FORMAT_BC1_UNORM));
+        Assert::IsTrue(IsBlockCompressedFormat(DXGI_FORMAT_BC7_UNORM));
+        Assert::IsFalse(IsBlockCompressedFormat(DXGI_FORMAT_B8G8R8A8_UNORM));
+
+        Assert::AreEqual(8u, GetBytesPerBlock(DXGI_FORMAT_BC1_UNORM));
+        Assert::AreEqual(16u, GetBytesPerBlock(DXGI_FORMAT_BC2_UNORM));
+        Assert::AreEqual(16u, GetBytesPerBlock(DXGI_FORMAT_BC3_UNORM));
+
+        Assert::AreEqual(16u, GetBytesPerRow(DXGI_FORMAT_BC1_UNORM, 8));
+        Assert::AreEqual(48u, GetBytesPerRow(DXGI_FORMAT_BC3_UNORM, 12));
+        Assert::AreEqual(3u, GetRowCount(DXGI_FORMAT_BC3_UNORM, 12));
+
+        Assert::AreEqual(32u, GetBytesPerRow(DXGI_FORMAT_B8G8R8A8_UNORM, 8));
+        Assert::AreEqual(12u, GetRowCount(DXGI_FORMAT_B8G8R8A8_UNORM, 12));
+    }
+
+    TEST_METHOD_EX(BlockCompression_Encode_RejectsUnsupportedFormatsAndPartialBlocks)
+    {
+        auto pixels = MakeSolidBlock(0, 0, 0, 255);
+
+        ExpectHResultException(E_INVALIDARG, [&] { EncodeBlock(DXGI_FORMAT_B8G8R8A8_UNORM, pixels); });
+        ExpectHResultException(E_INVALIDARG, [&] { EncodeBlock(DXGI_FORMAT_BC7_UNORM, pixels); });
+        ExpectHResultException(E_INVALIDARG, [&] { BlockCompression::Encode(DXGI_FORMAT_BC1_UNORM, pixels.data(), D2D1::SizeU(2, 4), 16); });
+    }
+
+    TEST_METHOD_EX(BlockCompression_Encode_ProducesOneBlockPerFourByFourPixels)
+    {
+        std::vector<BYTE> pixels(8 * 12 * 4);
+
+        Assert::AreEqual<size_t>(2 * 3 * 8, BlockCompression::Encode(DXGI_FORMAT_BC1_UNORM, pixels.data(), D2D1::SizeU(8, 12), 32).size());
+        Assert::AreEqual<size_t>(2 * 3 * 16, BlockCompression::Encode(DXGI_FORMAT_BC3_UNORM, pixels.data(), D2D1::SizeU(8, 12), 32).size());
+    }
+
+    TEST_METHOD_EX(BlockCompression_EncodeBC1_SolidColor)
+    {
+        auto blocks = EncodeBlock(DXGI_FORMAT_BC1_UNORM, MakeSolidBlock(0, 0, 255, 255));
+
+        // Red is 0xF800 in 5:6:5, and every pixel uses endpoint 0.
+        AssertBytes({ 0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0 }, blocks.data());
+    }
+
+    TEST_METHOD_EX(BlockCompression_EncodeBC1_TwoColorsUseTheEndpoints)
+    {
+        auto pixels = MakeSolidBlock(255, 255, 255, 255);
+        SetPixel(pixels, 1, 0, 0, 0, 255);
+        SetPixel(pixels, 15, 0, 0, 0, 255);
+
+        auto blocks = EncodeBlock(DXGI_FORMAT_BC1_UNORM, pixels);
+
+        // White is endpoint 0 and black endpoint 1, picked by pixels 1 and 15.
+        AssertBytes({ 0xFF, 0xFF, 0x00, 0x00, 0x04, 0x00, 0x00, 0x40 }, blocks.data());
+    }
+
+    TEST_METHOD_EX(BlockCompression_EncodeBC1_TransparentPixelsUseThreeColorMode)
+    {
+        auto pixels = MakeSolidBlock(0, 0, 255, 255);
+        SetPixel(pixels, 0, 0, 0, 0, 0);
+
+        auto blocks = EncodeBlock(DXGI_FORMAT_BC1_UNORM, pixels);
+
+        // Three color mode needs color0 <= color1, and index 3 is transparent.
+        AssertBytes({ 0x00, 0xF8, 0x00, 0xF8, 0x03, 0x00, 0x00, 0x00 }, blocks.data());
+    }
+
+    TEST_METHOD_EX(BlockCompression_EncodeBC2_StoresFourBitAlpha)
+    {
+        auto pixels = MakeSolidBlock(0, 0, 0, 255);
+        SetPixel(pixels, 0, 0, 0, 0, 0);
+        SetPixel(pixels, 1, 0, 0, 0, 0x88);
+
+        auto blocks = EncodeBlock(DXGI_FORMAT_BC2_UNORM, pixels);
+
+        AssertBytes({ 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }, blocks.data());
+        AssertBytes({ 0, 0, 0, 0, 0, 0, 0, 0 }, blocks.data() + 8);
+    }
+
+    TEST_METHOD_EX(BlockCompression_EncodeBC3_InterpolatesAlphaBetweenEndpoints)
+    {
+        auto pixels = MakeSolidBlock(0, 0, 0, 255);
+        SetPixel(pixels, 0, 0, 0, 0, 0);
+
+        auto blocks = EncodeBlock(DXGI_FORMAT_BC3_UNORM, pixels);
+
+        // Alpha endpoints are 255 and 0. Pixel 0 uses index 1, the rest index 0.
+        AssertBytes({ 0xFF, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, blocks.data());
+        AssertBytes({ 0, 0, 0, 0, 0, 0, 0, 0 }, blocks.data() + 8);
+    }
+
+    TEST_METHOD_EX(BlockCompression_EncodeBC3_SolidAlphaUsesASingleEndpoint)
+    {
+        auto blocks = EncodeBlock(DXGI_FORMAT_BC3_UNORM, MakeSolidBlock(0, 0, 0, 0x80));
+
+        AssertBytes({ 0x80, 0x80, 0, 0, 0, 0, 0, 0 }, blocks.data());
+    }
+};
@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "TestBitmapResourceCreationAdapter.h"
+
+#include <thread>
+
+using namespace Microsoft::WRL::Wrappers;
+
+TEST_CLASS(CanvasBitmapCacheTests)
+{
+    // Each test image is 16x32 pixels, at 4 bytes per pixel.
+    static const uint64_t bytesPerBitmap = 16 * 32 * 4;
+
+    struct Fixture
+    {
+        std::shared_ptr<TestBitmapResourceCreationAdapter> Adapter;
+        std::shared_ptr<PolymorphicBitmapManager> Manager;
+        ComPtr<CanvasBitmapCache> Cache;
+        ComPtr<StubCanvasDevice> Device;
+
+        WinString FileName;
+        WinString OtherFileName;
+
+        int LoadCount;
+
+        Fixture()
+            : Adapter(std::make_shared<TestBitmapResourceCreationAdapter>(Make<MockWICFormatConverter>()))
+            , Device(MakeDevice())
+            , FileName(L"cat.jpg")
+            , OtherFileName(L"dog.jpg")
+            , LoadCount(0)
+        {
+            Manager = std::make_shared<PolymorphicBitmapManager>(Adapter);
+            Cache = Make<CanvasBitmapCache>(Manager);
+
+            Adapter->MockCreateWICFormatConverter = [&] { LoadCount++; };
+        }
+
+        static ComPtr<StubCanvasDevice> MakeDevice()
+        {
+            auto device = Make<StubCanvasDevice>();
+
+            device->MockCreateBitmapFromWicResource =
+                [](IWICFormatConverter*, CanvasAlphaMode, float dpi) -> ComPtr<ID2D1Bitmap1>
+                {
+                    auto bitmap = Make<StubD2DBitmap>(D2D1_BITMAP_OPTIONS_NONE, dpi);
+
+                    bitmap->GetPixelSizeMethod.AllowAnyCall(
+                        [] { return D2D1_SIZE_U{ 16, 32 }; });
+
+                    return bitmap;
+                };
+
+            return device;
+        }
+
+        ComPtr<CanvasBitmap> Load(HSTRING fileName, CanvasAlphaMode alpha = CanvasAlphaMode::Premultiplied, float dpi = DEFAULT_DPI)
+        {
+            return Cache->Load(Device.Get(), fileName, alpha, dpi);
+        }
+
+        CanvasBitmapCacheStatistics GetStatistics()
+        {
+            CanvasBitmapCacheStatistics statistics;
+            ThrowIfFailed(Cache->get_Statistics(&statistics));
+            return statistics;
+        }
+
+        void SetRetainedBytesBudget(uint64_t budget)
+        {
+            ThrowIfFailed(Cache->put_RetainedBytesBudget(budget));
+        }
+    };
+
+    TEST_METHOD_EX(CanvasBitmapCache_WhileBitmapIsAlive_SameFileReturnsSameBitmap)
+    {
+        Fixture f;
+
+        auto bitmap1 = f.Load(f.FileName);
+        auto bitmap2 = f.Load(f.FileName);
+
+        Assert::IsTrue(IsSameInstance(bitmap1.Get(), bitmap2.Get()));
+        Assert::AreEqual(1, f.LoadCount);
+
+        auto statistics = f.GetStatistics();
+        Assert::AreEqual(1ull, statistics.Hits);
+        Assert::AreEqual(1ull, statistics.Misses);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_DifferentFileAlphaDpiOrDevice_LoadSeparately)
+    {
+        Fixture f;
+
+        auto bitmap = f.Load(f.FileName);
+
+        auto otherFile = f.Load(f.OtherFileName);
+        auto otherAlpha = f.Load(f.FileName, CanvasAlphaMode::Ignore);
+        auto otherDpi = f.Load(f.FileName, CanvasAlphaMode::Premultiplied, 192);
+
+        f.Device = Fixture::MakeDevice();
+        auto otherDevice = f.Load(f.FileName);
+
+        Assert::AreEqual(5, f.LoadCount);
+        Assert::IsFalse(IsSameInstance(bitmap.Get(), otherFile.Get()));
+        Assert::IsFalse(IsSameInstance(bitmap.Get(), otherAlpha.Get()));
+        Assert::IsFalse(IsSameInstance(bitmap.Get(), otherDpi.Get()));
+        Assert::IsFalse(IsSameInstance(bitmap.Get(), otherDevice.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_WhenBitmapIsReleased_FileIsLoadedAgain)
+    {
+        Fixture f;
+
+        f.Load(f.FileName);
+        f.Load(f.FileName);
+
+        Assert::AreEqual(2, f.LoadCount);
+        Assert::AreEqual(0ull, f.GetStatistics().Hits);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_WhenBitmapIsClosed_FileIsLoadedAgain)
+    {
+        Fixture f;
+
+        auto bitmap1 = f.Load(f.FileName);
+        Assert::AreEqual(S_OK, bitmap1->Close());
+
+        auto bitmap2 = f.Load(f.FileName);
+
+        Assert::IsFalse(IsSameInstance(bitmap1.Get(), bitmap2.Get()));
+        Assert::AreEqual(2, f.LoadCount);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_RetainedBudget_KeepsMostRecentlyUsedBitmapsAlive)
+    {
+        Fixture f;
+
+        f.SetRetainedBytesBudget(bytesPerBitmap * 2);
+
+        f.Load(f.FileName);
+        f.Load(f.OtherFileName);
+
+        // Both fit in the budget, so are still cached even though we released them.
+        f.Load(f.FileName);
+        Assert::AreEqual(2, f.LoadCount);
+
+        auto statistics = f.GetStatistics();
+        Assert::AreEqual(bytesPerBitmap * 2, statistics.RetainedBytes);
+        Assert::AreEqual(2u, statistics.RetainedBitmaps);
+
+        // A third file evicts the least recently used, which is now OtherFileName.
+        WinString thirdFileName(L"bird.jpg");
+        f.Load(thirdFileName);
+        Assert::AreEqual(3, f.LoadCount);
+
+        f.Load(f.FileName);
+        Assert::AreEqual(3, f.LoadCount);
+
+        f.Load(f.OtherFileName);
+        Assert::AreEqual(4, f.LoadCount);
+
+        Assert::AreEqual(bytesPerBitmap * 2, f.GetStatistics().RetainedBytes);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_Clear_ReleasesRetainedBitmaps)
+    {
+        Fixture f;
+
+        f.SetRetainedBytesBudget(bytesPerBitmap * 4);
+
+        f.Load(f.FileName);
+        Assert::AreEqual(S_OK, f.Cache->Clear());
+
+        Assert::AreEqual(0ull, f.GetStatistics().RetainedBytes);
+
+        f.Load(f.FileName);
+        Assert::AreEqual(2, f.LoadCount);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_ConcurrentLoadsOfSameFile_AreCoalesced)
+    {
+        Fixture f;
+
+        Event firstLoadCanFinish(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+
+        f.Adapter->MockCreateWICFormatConverter = [&]
+        {
+            f.LoadCount++;
+            Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(firstLoadCanFinish.Get(), 5000, false));
+        };
+
+        ComPtr<CanvasBitmap> bitmap1;
+        ComPtr<CanvasBitmap> bitmap2;
+
+        std::thread thread1([&] { bitmap1 = f.Load(f.FileName); });
+
+        // Wait for the first load to start before making the second request.
+        while (f.GetStatistics().Misses == 0)
+        {
+            Sleep(1);
+        }
+
+        std::thread thread2([&] { bitmap2 = f.Load(f.FileName); });
+
+        // Once the second request is waiting on the first, let the first finish.
+        while (f.GetStatistics().CoalescedLoads == 0)
+        {
+            Sleep(1);
+        }
+
+        SetEvent(firstLoadCanFinish.Get());
+
+        thread1.join();
+        thread2.join();
+
+        Assert::AreEqual(1, f.LoadCount);
+        Assert::IsTrue(IsSameInstance(bitmap1.Get(), bitmap2.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_WhenLoadFails_ErrorIsNotCached)
+    {
+        Fixture f;
+
+        f.Adapter->MockCreateWICFormatConverter = [&]
+        {
+            f.LoadCount++;
+
+            if (f.LoadCount == 1)
+                ThrowHR(WINCODEC_ERR_COMPONENTNOTFOUND);
+        };
+
+        ExpectHResultException(WINCODEC_ERR_COMPONENTNOTFOUND, [&] { f.Load(f.FileName); });
+
+        auto bitmap = f.Load(f.FileName);
+
+        Assert::IsNotNull(bitmap.Get());
+        Assert::AreEqual(2, f.LoadCount);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_DifferentCaches_DoNotShareBitmaps)
+    {
+        Fixture f;
+
+        auto otherCache = Make<CanvasBitmapCache>(f.Manager);
+
+        auto bitmap1 = f.Load(f.FileName);
+        auto bitmap2 = otherCache->Load(f.Device.Get(), f.FileName, CanvasAlphaMode::Premultiplied, DEFAULT_DPI);
+
+        Assert::IsFalse(IsSameInstance(bitmap1.Get(), bitmap2.Get()));
+        Assert::AreEqual(2, f.LoadCount);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_RetainedBytesBudget_DefaultsToZeroAndCanBeSet)
+    {
+        Fixture f;
+
+        uint64_t budget = 1;
+        Assert::AreEqual(S_OK, f.Cache->get_RetainedBytesBudget(&budget));
+        Assert::AreEqual(0ull, budget);
+
+        f.SetRetainedBytesBudget(bytesPerBitmap);
+
+        Assert::AreEqual(S_OK, f.Cache->get_RetainedBytesBudget(&budget));
+        Assert::AreEqual(bytesPerBitmap, budget);
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_NullArgs)
+    {
+        Fixture f;
+
+        Assert::AreEqual(E_INVALIDARG, f.Cache->get_RetainedBytesBudget(nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.Cache->get_Statistics(nullptr));
+
+        ComPtr<ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>> operation;
+        Assert::AreEqual(E_INVALIDARG, f.Cache->LoadAsyncFromHstring(nullptr, f.FileName, &operation));
+        Assert::AreEqual(E_INVALIDARG, f.Cache->LoadAsyncFromHstring(f.Device.Get(), nullptr, &operation));
+        Assert::AreEqual(E_INVALIDARG, f.Cache->LoadAsyncFromHstring(f.Device.Get(), f.FileName, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasBitmapCache_CreateDoesNotUseTheCache)
+    {
+        Fixture f;
+
+        auto bitmap1 = f.Manager->CreateBitmap(f.Device.Get(), f.FileName, CanvasAlphaMode::Premultiplied, DEFAULT_DPI);
+        auto bitmap2 = f.Load(f.FileName);
+
+        Assert::IsFalse(IsSameInstance(bitmap1.Get(), bitmap2.Get()));
+        Assert::AreEqual(2, f.LoadCount);
+    }
+};
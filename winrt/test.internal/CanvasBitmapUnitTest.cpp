@@ -110,6 +110,123 @@ TEST_CLASS(CanvasBitmapUnitTest)
         Assert::AreEqual(RO_E_CLOSED, canvasBitmap->CopyPixelsFromBitmap(otherBitmap.Get()));
         Assert::AreEqual(RO_E_CLOSED, canvasBitmap->CopyPixelsFromBitmapWithDestPoint(otherBitmap.Get(), 0, 0));
         Assert::AreEqual(RO_E_CLOSED, canvasBitmap->CopyPixelsFromBitmapWithDestPointAndSourceRect(otherBitmap.Get(), 0, 0, 0, 0, 0, 0));
+
+        int32_t mipLevelCount;
+        uint64_t mipLevelsSize;
+        Assert::AreEqual(RO_E_CLOSED, canvasBitmap->GenerateMipLevels());
+        Assert::AreEqual(RO_E_CLOSED, canvasBitmap->get_MipLevelCount(&mipLevelCount));
+        Assert::AreEqual(RO_E_CLOSED, canvasBitmap->get_MipLevelsSizeInBytes(&mipLevelsSize));
+    }
+
+    static ComPtr<StubD2DBitmap> MakeMipLevel(uint32_t width, uint32_t height, DXGI_FORMAT format)
+    {
+        auto level = Make<StubD2DBitmap>();
+
+        level->GetPixelSizeMethod.AllowAnyCall([=] { return D2D1::SizeU(width, height); });
+        level->GetPixelFormatMethod.AllowAnyCall([=] { return D2D1::PixelFormat(format, D2D1_ALPHA_MODE_PREMULTIPLIED); });
+
+        return level;
+    }
+
+    TEST_METHOD_EX(CanvasBitmap_MipLevels_ReportsCountAndSize)
+    {
+        Fixture f;
+        auto bitmap = f.m_bitmapManager->Create(f.m_canvasDevice.Get(), f.m_testFileName, CanvasAlphaMode::Premultiplied, DEFAULT_DPI);
+
+        int32_t count;
+        uint64_t size;
+
+        // The bitmap itself counts as the first level.
+        ThrowIfFailed(bitmap->get_MipLevelCount(&count));
+        ThrowIfFailed(bitmap->get_MipLevelsSizeInBytes(&size));
+        Assert::AreEqual(1, count);
+        Assert::AreEqual(0ull, size);
+
+        std::vector<ComPtr<ID2D1Bitmap1>> levels;
+        levels.push_back(MakeMipLevel(4, 2, DXGI_FORMAT_B8G8R8A8_UNORM));
+        levels.push_back(MakeMipLevel(2, 1, DXGI_FORMAT_B8G8R8A8_UNORM));
+        levels.push_back(MakeMipLevel(1, 1, DXGI_FORMAT_B8G8R8A8_UNORM));
+
+        As<ICanvasBitmapInternal>(bitmap)->SetMipLevels(levels);
+
+        ThrowIfFailed(bitmap->get_MipLevelCount(&count));
+        ThrowIfFailed(bitmap->get_MipLevelsSizeInBytes(&size));
+        Assert::AreEqual(4, count);
+        Assert::AreEqual(BitmapMipChain::GetMemoryOverhead(D2D1::SizeU(8, 4), 4), size);
+
+        Assert::AreEqual(E_INVALIDARG, bitmap->get_MipLevelCount(nullptr));
+        Assert::AreEqual(E_INVALIDARG, bitmap->get_MipLevelsSizeInBytes(nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasBitmap_CreateFromBytes_BlockCompressedPitchIsOneRowOfBlocks)
+    {
+        Fixture f;
+
+        auto deviceContext = Make<MockD2DDeviceContext>();
+        deviceContext->CreateBitmapMethod.SetExpectedCalls(1,
+            [&](D2D1_SIZE_U size, void const*, UINT32 pitch, D2D1_BITMAP_PROPERTIES1 const* bitmapProperties, ID2D1Bitmap1** bitmap)
+            {
+                Assert::AreEqual(8u, size.width);
+                Assert::AreEqual(12u, size.height);
+                Assert::AreEqual(DXGI_FORMAT_BC3_UNORM, bitmapProperties->pixelFormat.format);
+
+                // Two 16 byte blocks across.
+                Assert::AreEqual(32u, pitch);
+
+                return Make<StubD2DBitmap>().CopyTo(bitmap);
+            });
+
+        f.m_canvasDevice->CreateDeviceContextMethod.SetExpectedCalls(1, [=] { return deviceContext; });
+
+        std::vector<BYTE> blocks(2 * 3 * 16);
+
+        f.m_bitmapManager->Create(
+            f.m_canvasDevice.Get(),
+            static_cast<uint32_t>(blocks.size()),
+            blocks.data(),
+            8,
+            12,
+            DirectXPixelFormat::BC3UIntNormalized,
+            CanvasAlphaMode::Premultiplied,
+            DEFAULT_DPI);
+    }
+
+    TEST_METHOD_EX(CanvasBitmap_CreateFromBytes_BlockCompressedSizeMustBeWholeBlocks)
+    {
+        Fixture f;
+
+        std::vector<BYTE> blocks(2 * 2 * 8);
+
+        ExpectHResultException(E_INVALIDARG,
+            [&]
+            {
+                f.m_bitmapManager->Create(
+                    f.m_canvasDevice.Get(),
+                    static_cast<uint32_t>(blocks.size()),
+                    blocks.data(),
+                    6,
+                    8,
+                    DirectXPixelFormat::BC1UIntNormalized,
+                    CanvasAlphaMode::Premultiplied,
+                    DEFAULT_DPI);
+            });
+    }
+
+    TEST_METHOD_EX(CanvasBitmap_PixelBytes_BlockCompressedSubrectangleMustBeBlockAligned)
+    {
+        Fixture f;
+
+        auto d2dBitmap = MakeMipLevel(8, 8, DXGI_FORMAT_BC1_UNORM);
+        auto bitmap = f.m_bitmapManager->GetOrCreate(f.m_canvasDevice.Get(), d2dBitmap.Get());
+
+        uint32_t count;
+        BYTE* bytes;
+        Assert::AreEqual(E_INVALIDARG, bitmap->GetPixelBytesWithSubrectangle(2, 0, 4, 4, &count, &bytes));
+        Assert::AreEqual(E_INVALIDARG, bitmap->GetPixelBytesWithSubrectangle(0, 0, 4, 6, &count, &bytes));
+
+        std::vector<BYTE> block(8);
+        Assert::AreEqual(E_INVALIDARG, bitmap->SetPixelBytesWithSubrectangle(static_cast<uint32_t>(block.size()), block.data(), 0, 4, 4, 2));
+        Assert::AreEqual(E_INVALIDARG, bitmap->SetPixelBytesWithSubrectangle(static_cast<uint32_t>(block.size()), block.data(), 4, 0, 3, 4));
     }
 
     TEST_METHOD_EX(CanvasBitmap_GetDevice)
@@ -122,6 +239,33 @@ TEST_CLASS(CanvasBitmapUnitTest)
         Assert::AreEqual<ICanvasDevice*>(f.m_canvasDevice.Get(), actualDevice.Get());
     }
 
+    TEST_METHOD_EX(CanvasBitmap_CreateWithMaxSize_PassesSizeAndInterpolationToAdapter)
+    {
+        Fixture f;
+
+        IWICFormatConverter* actualConverter = nullptr;
+        CanvasAlphaMode actualAlpha = CanvasAlphaMode::Premultiplied;
+
+        f.m_canvasDevice->MockCreateBitmapFromWicResource =
+            [&](IWICFormatConverter* converter, CanvasAlphaMode alpha, float dpi) -> ComPtr<ID2D1Bitmap1>
+            {
+                actualConverter = converter;
+                actualAlpha = alpha;
+                return Make<StubD2DBitmap>(D2D1_BITMAP_OPTIONS_NONE, dpi);
+            };
+
+        BitmapSize maxSize = { 320, 240 };
+
+        auto bitmap = f.m_bitmapManager->Create(f.m_canvasDevice.Get(), f.m_testFileName, maxSize, CanvasImageInterpolation::HighQualityCubic, CanvasAlphaMode::Ignore, DEFAULT_DPI);
+
+        Assert::IsNotNull(bitmap.Get());
+        Assert::AreEqual(maxSize.Width, f.m_adapter->LastMaxSize.Width);
+        Assert::AreEqual(maxSize.Height, f.m_adapter->LastMaxSize.Height);
+        Assert::AreEqual<int>(static_cast<int>(CanvasImageInterpolation::HighQualityCubic), static_cast<int>(f.m_adapter->LastInterpolation));
+        Assert::IsTrue(actualConverter == f.m_converter.Get());
+        Assert::AreEqual<int>(static_cast<int>(CanvasAlphaMode::Ignore), static_cast<int>(actualAlpha));
+    }
+
     TEST_METHOD_EX(CanvasBitmap_GetAlphaMode)
     {
         Fixture f;
@@ -398,6 +542,21 @@ TEST_CLASS(CanvasBitmapUnitTest)
             sourceRect[3]));
     }
 
+    TEST_METHOD_EX(CanvasBitmap_CopyPixelsFromBitmap_DiscardsMipLevels)
+    {
+        CopyFromBitmapFixture f;
+
+        std::vector<ComPtr<ID2D1Bitmap1>> levels;
+        levels.push_back(MakeMipLevel(1, 1, DXGI_FORMAT_B8G8R8A8_UNORM));
+        As<ICanvasBitmapInternal>(f.DestBitmap)->SetMipLevels(levels);
+
+        ThrowIfFailed(f.DestBitmap->CopyPixelsFromBitmap(f.SourceBitmap.Get()));
+
+        int32_t count;
+        ThrowIfFailed(f.DestBitmap->get_MipLevelCount(&count));
+        Assert::AreEqual(1, count);
+    }
+
     TEST_METHOD_EX(CanvasBitmap_CopyPixelsFromBitmap_InvalidCoordinates)
     {
         Fixture f;
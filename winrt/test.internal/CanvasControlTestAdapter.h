@@ -105,6 +105,10 @@ public:
     // means).
     std::function<ComPtr<MockCanvasDrawingSession>()> OnCanvasImageSourceDrawingSessionFactory_Create;
 
+    // Likewise, this is called when the control asks to reuse the drawing
+    // session from the previous frame.  By default the request is refused.
+    std::function<bool(ICanvasDrawingSession*)> OnCanvasImageSourceDrawingSessionFactory_TryReopen;
+
     virtual ComPtr<CanvasImageSource> CreateCanvasImageSource(
         ICanvasDevice* device, 
         float width, 
@@ -142,6 +146,15 @@ public:
                 return Make<MockCanvasDrawingSession>();
             });
 
+        dsFactory->TryReopenMethod.AllowAnyCall(
+            [&](ICanvasDrawingSession* closedDrawingSession, ICanvasDevice*, ISurfaceImageSourceNativeWithD2D*, Color const&, RECT const&, float)
+            {
+                if (OnCanvasImageSourceDrawingSessionFactory_TryReopen)
+                    return OnCanvasImageSourceDrawingSessionFactory_TryReopen(closedDrawingSession);
+
+                return false;
+            });
+
         ComPtr<ICanvasResourceCreator> resourceCreator;
         ThrowIfFailed(device->QueryInterface(resourceCreator.GetAddressOf()));
 
@@ -14,6 +14,7 @@
 
 #include "CanvasControlTestAdapter.h"
 #include "MockAsyncAction.h"
+#include "RecordingTraceSink.h"
 
 struct BasicControlFixture
 {
@@ -1404,3 +1405,370 @@ TEST_CLASS(CanvasControl_ClearColor)
         f.RaiseAnyNumberOfCompositionRenderingEvents();
     }
 };
+
+TEST_CLASS(CanvasControl_DrawingStatistics)
+{
+    struct Fixture
+    {
+        ComPtr<MockD2DDeviceContext> DeviceContext;
+        std::shared_ptr<CanvasControlTestAdapter> Adapter;
+        ComPtr<CanvasControl> Control;
+        ComPtr<StubUserControl> UserControl;
+        int ClearsPerFrame;
+
+        Fixture()
+            : ClearsPerFrame(1)
+        {
+            DeviceContext = Make<MockD2DDeviceContext>();
+            DeviceContext->ClearMethod.AllowAnyCall();
+            DeviceContext->SetTransformMethod.AllowAnyCall();
+            DeviceContext->SetDpiMethod.AllowAnyCall();
+
+            Adapter = std::make_shared<CanvasControlTestAdapter_InjectDeviceContext>(DeviceContext.Get());
+            Adapter->CreateCanvasImageSourceMethod.AllowAnyCall();
+
+            Control = Make<CanvasControl>(Adapter);
+            UserControl = dynamic_cast<StubUserControl*>(As<IUserControl>(Control).Get());
+
+            auto onDraw = Callback<DrawEventHandler>(
+                [this](ICanvasControl*, ICanvasDrawEventArgs* args)
+                {
+                    ComPtr<ICanvasDrawingSession> drawingSession;
+                    ThrowIfFailed(args->get_DrawingSession(&drawingSession));
+
+                    for (int i = 0; i < ClearsPerFrame; i++)
+                        ThrowIfFailed(drawingSession->Clear(Color{}));
+
+                    return S_OK;
+                });
+
+            EventRegistrationToken ignoredToken;
+            ThrowIfFailed(Control->add_Draw(onDraw.Get(), &ignoredToken));
+
+            ThrowIfFailed(UserControl->LoadedEventSource->InvokeAll(nullptr, nullptr));
+        }
+
+        void DrawFrame()
+        {
+            ThrowIfFailed(Control->Invalidate());
+            Adapter->RaiseCompositionRenderingEvent();
+        }
+
+        int GetClearCount()
+        {
+            ComPtr<ICanvasDrawingStatistics> statistics;
+            ThrowIfFailed(Control->get_DrawingStatistics(&statistics));
+            Assert::IsNotNull(statistics.Get());
+
+            int32_t clearCount;
+            ThrowIfFailed(statistics->get_ClearCount(&clearCount));
+            return clearCount;
+        }
+    };
+
+    TEST_METHOD_EX(CanvasControl_DrawingStatistics_AreDisabledByDefault)
+    {
+        Fixture f;
+        f.DrawFrame();
+
+        boolean isEnabled = true;
+        ThrowIfFailed(f.Control->get_IsDrawingStatisticsEnabled(&isEnabled));
+        Assert::IsFalse(!!isEnabled);
+
+        ComPtr<ICanvasDrawingStatistics> statistics;
+        ThrowIfFailed(f.Control->get_DrawingStatistics(&statistics));
+        Assert::IsNull(statistics.Get());
+
+        Assert::AreEqual(E_INVALIDARG, f.Control->get_IsDrawingStatisticsEnabled(nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.Control->get_DrawingStatistics(nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasControl_DrawingStatistics_DescribeTheMostRecentFrame)
+    {
+        Fixture f;
+        ThrowIfFailed(f.Control->put_IsDrawingStatisticsEnabled(true));
+
+        f.ClearsPerFrame = 2;
+        f.DrawFrame();
+        Assert::AreEqual(2, f.GetClearCount());
+
+        f.ClearsPerFrame = 3;
+        f.DrawFrame();
+        Assert::AreEqual(3, f.GetClearCount());
+    }
+
+    TEST_METHOD_EX(CanvasControl_DrawingStatistics_AreDiscardedWhenDisabled)
+    {
+        Fixture f;
+        ThrowIfFailed(f.Control->put_IsDrawingStatisticsEnabled(true));
+        f.DrawFrame();
+
+        ThrowIfFailed(f.Control->put_IsDrawingStatisticsEnabled(false));
+        f.DrawFrame();
+
+        ComPtr<ICanvasDrawingStatistics> statistics;
+        ThrowIfFailed(f.Control->get_DrawingStatistics(&statistics));
+        Assert::IsNull(statistics.Get());
+    }
+};
+
+TEST_CLASS(CanvasControl_FrameObjectReuse)
+{
+    //
+    // Uses CanvasControlTestAdapter_InjectDeviceContext, so the drawing
+    // sessions are created and reopened by the real
+    // CanvasImageSourceDrawingSessionFactory.
+    //
+    struct Fixture
+    {
+        ComPtr<MockD2DDeviceContext> DeviceContext;
+        std::shared_ptr<CanvasControlTestAdapter> Adapter;
+        ComPtr<CanvasControl> Control;
+        ComPtr<StubUserControl> UserControl;
+        std::function<void(ICanvasDrawEventArgs*, ICanvasDrawingSession*)> OnDraw;
+
+        Fixture()
+        {
+            DeviceContext = Make<MockD2DDeviceContext>();
+            DeviceContext->ClearMethod.AllowAnyCall();
+            DeviceContext->SetTransformMethod.AllowAnyCall();
+            DeviceContext->SetDpiMethod.AllowAnyCall();
+
+            Adapter = std::make_shared<CanvasControlTestAdapter_InjectDeviceContext>(DeviceContext.Get());
+            Adapter->CreateCanvasImageSourceMethod.AllowAnyCall();
+
+            Control = Make<CanvasControl>(Adapter);
+            UserControl = dynamic_cast<StubUserControl*>(As<IUserControl>(Control).Get());
+
+            auto onDraw = Callback<DrawEventHandler>(
+                [this](ICanvasControl*, ICanvasDrawEventArgs* args)
+                {
+                    ComPtr<ICanvasDrawingSession> drawingSession;
+                    ThrowIfFailed(args->get_DrawingSession(&drawingSession));
+
+                    if (OnDraw)
+                        OnDraw(args, drawingSession.Get());
+
+                    return S_OK;
+                });
+
+            EventRegistrationToken ignoredToken;
+            ThrowIfFailed(Control->add_Draw(onDraw.Get(), &ignoredToken));
+
+            ThrowIfFailed(UserControl->LoadedEventSource->InvokeAll(nullptr, nullptr));
+        }
+
+        void DrawFrame()
+        {
+            ThrowIfFailed(Control->Invalidate());
+            Adapter->RaiseCompositionRenderingEvent();
+        }
+    };
+
+    TEST_METHOD_EX(CanvasControl_DrawEventArgsAndDrawingSession_AreReusedAcrossFrames)
+    {
+        Fixture f;
+
+        int brushCount = 0;
+
+        f.DeviceContext->CreateSolidColorBrushMethod.AllowAnyCall(
+            [&](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** value)
+            {
+                brushCount++;
+
+                auto brush = Make<MockD2DSolidColorBrush>();
+                brush->MockSetColor = [](D2D1_COLOR_F const*) {};
+                return brush.CopyTo(value);
+            });
+
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+
+        //
+        // Holding any kind of reference to the args would stop them being
+        // reused, so only their address is kept.
+        //
+        ICanvasDrawEventArgs* previousArgs = nullptr;
+        int drawCount = 0;
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs* args, ICanvasDrawingSession* drawingSession)
+            {
+                if (previousArgs)
+                    Assert::IsTrue(previousArgs == args);
+
+                previousArgs = args;
+
+                ThrowIfFailed(drawingSession->FillRectangleWithColor(Rect{ 0, 0, 1, 1 }, Color{}));
+                drawCount++;
+            };
+
+        f.DrawFrame();
+        f.DrawFrame();
+        f.DrawFrame();
+
+        Assert::AreEqual(3, drawCount);
+
+        // A drawing session creates its color brush once and then keeps it,
+        // so a single brush means that one drawing session drew every frame.
+        Assert::AreEqual(1, brushCount);
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenDrawEventArgsAreHeldPastTheDrawEvent_TheyAreNotReused)
+    {
+        Fixture f;
+
+        ComPtr<ICanvasDrawEventArgs> heldArgs;
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs* args, ICanvasDrawingSession*)
+            {
+                heldArgs = args;
+            };
+
+        f.DrawFrame();
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs* args, ICanvasDrawingSession*)
+            {
+                Assert::IsFalse(IsSameInstance(heldArgs.Get(), args));
+            };
+
+        f.DrawFrame();
+
+        // The held args still refer to the first frame's drawing session,
+        // which stays closed.
+        ComPtr<ICanvasDrawingSession> drawingSession;
+        ThrowIfFailed(heldArgs->get_DrawingSession(&drawingSession));
+        Assert::AreEqual(RO_E_CLOSED, drawingSession->Clear(Color{}));
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenDrawingSessionIsHeldPastTheDrawEvent_ItIsNotReused)
+    {
+        Fixture f;
+
+        ComPtr<ICanvasDrawingSession> heldDrawingSession;
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs*, ICanvasDrawingSession* drawingSession)
+            {
+                heldDrawingSession = drawingSession;
+            };
+
+        f.DrawFrame();
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs*, ICanvasDrawingSession* drawingSession)
+            {
+                Assert::IsFalse(IsSameInstance(heldDrawingSession.Get(), drawingSession));
+                ThrowIfFailed(drawingSession->Clear(Color{}));
+            };
+
+        f.DrawFrame();
+
+        Assert::AreEqual(RO_E_CLOSED, heldDrawingSession->Clear(Color{}));
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenDrawEventArgsAreHeldWeaklyPastTheDrawEvent_TheyAreNotReused)
+    {
+        Fixture f;
+
+        WeakRef weakArgs;
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs* args, ICanvasDrawingSession*)
+            {
+                ThrowIfFailed(AsWeak(args, &weakArgs));
+            };
+
+        f.DrawFrame();
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs*, ICanvasDrawingSession*)
+            {
+                // Nothing kept the first frame's args alive, so they are gone
+                // rather than standing in for this frame's.
+                ComPtr<ICanvasDrawEventArgs> previousArgs;
+                ThrowIfFailed(weakArgs.As(&previousArgs));
+                Assert::IsNull(previousArgs.Get());
+            };
+
+        f.DrawFrame();
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenDrawingSessionIsHeldWeaklyPastTheDrawEvent_ItIsNotReused)
+    {
+        Fixture f;
+
+        WeakRef weakDrawingSession;
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs*, ICanvasDrawingSession* drawingSession)
+            {
+                ThrowIfFailed(AsWeak(drawingSession, &weakDrawingSession));
+            };
+
+        f.DrawFrame();
+
+        f.OnDraw =
+            [&](ICanvasDrawEventArgs*, ICanvasDrawingSession* drawingSession)
+            {
+                ComPtr<ICanvasDrawingSession> previousDrawingSession;
+                ThrowIfFailed(weakDrawingSession.As(&previousDrawingSession));
+                Assert::IsNull(previousDrawingSession.Get());
+
+                ThrowIfFailed(drawingSession->Clear(Color{}));
+            };
+
+        f.DrawFrame();
+    }
+};
+
+#ifndef WIN2D_DISABLE_TRACING
+
+TEST_CLASS(CanvasControl_Tracing)
+{
+    TEST_METHOD_EX(CanvasControl_DrawHandlers_AreTraced)
+    {
+        auto deviceContext = Make<MockD2DDeviceContext>();
+        deviceContext->ClearMethod.AllowAnyCall();
+        deviceContext->SetTransformMethod.AllowAnyCall();
+        deviceContext->SetDpiMethod.AllowAnyCall();
+
+        auto adapter = std::make_shared<CanvasControlTestAdapter_InjectDeviceContext>(deviceContext.Get());
+        adapter->CreateCanvasImageSourceMethod.AllowAnyCall();
+
+        auto control = Make<CanvasControl>(adapter);
+        auto userControl = dynamic_cast<StubUserControl*>(As<IUserControl>(control).Get());
+
+        RecordingTraceSink sink;
+        int drawCount = 0;
+
+        auto onDraw = Callback<DrawEventHandler>(
+            [&](ICanvasControl*, ICanvasDrawEventArgs*)
+            {
+                // The handler runs inside the span.
+                auto records = sink.GetRecords(TraceEvent::DrawHandlers);
+                Assert::AreEqual<size_t>(drawCount * 2 + 1, records.size());
+                Assert::IsTrue(records.back().Kind == RecordingTraceSink::RecordKind::Begin);
+
+                drawCount++;
+                return S_OK;
+            });
+
+        EventRegistrationToken ignoredToken;
+        ThrowIfFailed(control->add_Draw(onDraw.Get(), &ignoredToken));
+
+        ThrowIfFailed(userControl->LoadedEventSource->InvokeAll(nullptr, nullptr));
+
+        for (int i = 0; i < 2; i++)
+        {
+            ThrowIfFailed(control->Invalidate());
+            adapter->RaiseCompositionRenderingEvent();
+        }
+
+        Assert::AreEqual(2, drawCount);
+        sink.AssertSpans(TraceEvent::DrawHandlers, 2);
+    }
+};
+
+#endif
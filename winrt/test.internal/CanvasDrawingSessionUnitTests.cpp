@@ -260,6 +260,31 @@ public:
         ThrowIfFailed(f.DS->Clear(expectedColor));
     }
 
+    //
+    // Reopen
+    //
+
+    TEST_METHOD_EX(CanvasDrawingSession_Reopen_DrawsOntoTheNewDeviceContext)
+    {
+        auto manager = std::make_shared<CanvasDrawingSessionManager>();
+        auto firstDeviceContext = Make<StubD2DDeviceContextWithGetFactory>();
+        auto secondDeviceContext = Make<StubD2DDeviceContextWithGetFactory>();
+
+        auto drawingSession = manager->Create(firstDeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+        ThrowIfFailed(drawingSession->Close());
+        Assert::AreEqual(RO_E_CLOSED, drawingSession->Clear(Color{}));
+
+        drawingSession->Reopen(nullptr, secondDeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+
+        firstDeviceContext->ClearMethod.SetExpectedCalls(0);
+        secondDeviceContext->ClearMethod.SetExpectedCalls(1);
+        ThrowIfFailed(drawingSession->Clear(Color{}));
+
+        // The reopened drawing session is tracked against its new device context
+        auto wrapper = manager->GetOrCreate(secondDeviceContext.Get());
+        Assert::AreEqual(drawingSession.Get(), wrapper.Get());
+    }
+
 
     //
     // DrawImage
@@ -463,6 +488,224 @@ public:
         }
     }
 
+    class MipLevelsFixture : public BitmapFixture
+    {
+    public:
+        // Stand-ins for the 1/2 and 1/4 size levels.
+        ComPtr<StubD2DBitmap> Level1;
+        ComPtr<StubD2DBitmap> Level2;
+        D2D1_MATRIX_3X2_F Transform;
+
+        MipLevelsFixture()
+            : Level1(Make<StubD2DBitmap>())
+            , Level2(Make<StubD2DBitmap>())
+            , Transform(D2D1::Matrix3x2F::Identity())
+        {
+            std::vector<ComPtr<ID2D1Bitmap1>> levels;
+            levels.push_back(Level1);
+            levels.push_back(Level2);
+
+            As<ICanvasBitmapInternal>(Bitmap)->SetMipLevels(levels);
+
+            DeviceContext->GetTransformMethod.AllowAnyCall(
+                [=](D2D1_MATRIX_3X2_F* transform)
+                {
+                    *transform = Transform;
+                });
+
+            DeviceContext->GetDpiMethod.AllowAnyCall(
+                [](float* dpiX, float* dpiY)
+                {
+                    *dpiX = DEFAULT_DPI;
+                    *dpiY = DEFAULT_DPI;
+                });
+        }
+
+        ID2D1Bitmap* DrawAndGetBitmap(Rect const& destRect, Rect const& sourceRect)
+        {
+            ID2D1Bitmap* drawnBitmap = nullptr;
+
+            DeviceContext->DrawBitmapMethod.SetExpectedCalls(1,
+                [&](ID2D1Bitmap* bitmap, D2D1_RECT_F const*, FLOAT, D2D1_INTERPOLATION_MODE, D2D1_RECT_F const* drawnSourceRect, D2D1_MATRIX_4X4_F const*)
+                {
+                    drawnBitmap = bitmap;
+
+                    // Levels are the same size in DIPs, so the source rect is passed through unchanged.
+                    Assert::AreEqual(ToD2DRect(sourceRect), *drawnSourceRect);
+                });
+
+            ThrowIfFailed(DS->DrawBitmapWithDestRectAndSourceRect(Bitmap.Get(), destRect, sourceRect));
+
+            return drawnBitmap;
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_MipLevels_FullSizeUsesOriginal)
+    {
+        MipLevelsFixture f;
+
+        auto drawn = f.DrawAndGetBitmap(Rect{ 0, 0, 400, 400 }, Rect{ 0, 0, 400, 400 });
+
+        Assert::IsTrue(IsSameInstance(f.Bitmap->GetD2DBitmap().Get(), drawn));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_MipLevels_PicksLevelFromDestSize)
+    {
+        MipLevelsFixture f;
+
+        Assert::IsTrue(IsSameInstance(f.Level1.Get(), f.DrawAndGetBitmap(Rect{ 0, 0, 200, 200 }, Rect{ 0, 0, 400, 400 })));
+        Assert::IsTrue(IsSameInstance(f.Level2.Get(), f.DrawAndGetBitmap(Rect{ 0, 0, 100, 100 }, Rect{ 0, 0, 400, 400 })));
+
+        // Smaller than the smallest level still uses that level.
+        Assert::IsTrue(IsSameInstance(f.Level2.Get(), f.DrawAndGetBitmap(Rect{ 0, 0, 10, 10 }, Rect{ 0, 0, 400, 400 })));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_MipLevels_PicksLevelFromTransform)
+    {
+        MipLevelsFixture f;
+
+        f.Transform = D2D1::Matrix3x2F::Scale(0.25f, 0.25f);
+        Assert::IsTrue(IsSameInstance(f.Level2.Get(), f.DrawAndGetBitmap(Rect{ 0, 0, 400, 400 }, Rect{ 0, 0, 400, 400 })));
+
+        // Scaled down by the dest rect, but back up by the transform.
+        f.Transform = D2D1::Matrix3x2F::Scale(4, 4);
+        Assert::IsTrue(IsSameInstance(f.Bitmap->GetD2DBitmap().Get(), f.DrawAndGetBitmap(Rect{ 0, 0, 100, 100 }, Rect{ 0, 0, 400, 400 })));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_MipLevels_PerspectiveUsesOriginal)
+    {
+        MipLevelsFixture f;
+
+        f.DeviceContext->GetTransformMethod.SetExpectedCalls(0);
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1,
+            [&](ID2D1Bitmap* bitmap, D2D1_RECT_F const*, FLOAT, D2D1_INTERPOLATION_MODE, D2D1_RECT_F const*, D2D1_MATRIX_4X4_F const*)
+            {
+                Assert::IsTrue(IsSameInstance(f.Bitmap->GetD2DBitmap().Get(), bitmap));
+            });
+
+        ThrowIfFailed(f.DS->DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolationAndPerspective(
+            f.Bitmap.Get(), Rect{ 0, 0, 10, 10 }, Rect{ 0, 0, 400, 400 }, 1, CanvasImageInterpolation::Linear, Numerics::Matrix4x4{}));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_WithoutMipLevels_DoesNotQueryTransform)
+    {
+        BitmapFixture f;
+
+        f.DeviceContext->GetTransformMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawBitmapWithDestRectAndSourceRect(f.Bitmap.Get(), Rect{ 0, 0, 10, 10 }, Rect{ 0, 0, 400, 400 }));
+    }
+
+    class VirtualBitmapFixture : public CanvasDrawingSessionFixture
+    {
+    public:
+        // 300x100 pixels, in three 100x100 tiles.
+        ComPtr<CanvasVirtualBitmap> VirtualBitmap;
+        int LoadCount;
+
+        VirtualBitmapFixture()
+            : LoadCount(0)
+        {
+            VirtualBitmap = Make<CanvasVirtualBitmap>(
+                Make<StubCanvasDevice>().Get(),
+                BitmapSize{ 300, 100 },
+                [=](ICanvasDevice*, D2D1_RECT_U const&) -> ComPtr<ICanvasBitmap>
+                {
+                    LoadCount++;
+                    return CreateStubCanvasBitmap();
+                },
+                100);
+
+            DeviceContext->GetTransformMethod.AllowAnyCall(
+                [](D2D1_MATRIX_3X2_F* transform)
+                {
+                    *transform = D2D1::Matrix3x2F::Identity();
+                });
+        }
+
+        void SetTargetSize(float width, float height)
+        {
+            auto target = Make<StubD2DBitmap>();
+            target->GetSizeMethod.AllowAnyCall([=] { return D2D1_SIZE_F{ width, height }; });
+
+            DeviceContext->GetTargetMethod.AllowAnyCall(
+                [=](ID2D1Image** value)
+                {
+                    ThrowIfFailed(target.CopyTo(value));
+                });
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_VirtualBitmap_NullVirtualBitmap)
+    {
+        VirtualBitmapFixture f;
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawVirtualBitmapWithDestRect(nullptr, Rect{}));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawVirtualBitmapWithDestRectAndSourceRect(nullptr, Rect{}, Rect{}));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawVirtualBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation(nullptr, Rect{}, Rect{}, 0, CanvasImageInterpolation::NearestNeighbor));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_VirtualBitmap_DrawsEachTile)
+    {
+        VirtualBitmapFixture f;
+        f.SetTargetSize(1000, 1000);
+
+        std::vector<D2D1_RECT_F> destRects;
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(3,
+            [&](ID2D1Bitmap* bitmap, D2D1_RECT_F const* destRect, FLOAT opacity, D2D1_INTERPOLATION_MODE interpolation, D2D1_RECT_F const* sourceRect, D2D1_MATRIX_4X4_F const* perspective)
+            {
+                Assert::IsNotNull(bitmap);
+                Assert::IsNotNull(sourceRect);
+                Assert::IsNull(perspective);
+                Assert::AreEqual(0.5f, opacity);
+                Assert::AreEqual(D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR, interpolation);
+
+                destRects.push_back(*destRect);
+            });
+
+        ThrowIfFailed(f.DS->DrawVirtualBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation(
+            f.VirtualBitmap.Get(), Rect{ 0, 0, 600, 200 }, Rect{ 0, 0, 300, 100 }, 0.5f, CanvasImageInterpolation::NearestNeighbor));
+
+        Assert::AreEqual(3, f.LoadCount);
+        Assert::AreEqual(D2D1::RectF(0, 0, 200, 200), destRects[0]);
+        Assert::AreEqual(D2D1::RectF(200, 0, 400, 200), destRects[1]);
+        Assert::AreEqual(D2D1::RectF(400, 0, 600, 200), destRects[2]);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_VirtualBitmap_OnlyVisibleTilesAreLoaded)
+    {
+        VirtualBitmapFixture f;
+        f.SetTargetSize(50, 50);
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawVirtualBitmapWithDestRect(f.VirtualBitmap.Get(), Rect{ 0, 0, 300, 100 }));
+
+        Assert::AreEqual(1, f.LoadCount);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_VirtualBitmap_WhenOffTarget_DrawsNothing)
+    {
+        VirtualBitmapFixture f;
+        f.SetTargetSize(50, 50);
+
+        ThrowIfFailed(f.DS->DrawVirtualBitmapWithDestRect(f.VirtualBitmap.Get(), Rect{ 100, 100, 300, 100 }));
+
+        Assert::AreEqual(0, f.LoadCount);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawImage_VirtualBitmap_WhenClosed_Fails)
+    {
+        VirtualBitmapFixture f;
+
+        ThrowIfFailed(f.VirtualBitmap->Close());
+
+        Assert::AreEqual(RO_E_CLOSED, f.DS->DrawVirtualBitmapWithDestRect(f.VirtualBitmap.Get(), Rect{ 0, 0, 300, 100 }));
+    }
+
     TEST_METHOD_EX(CanvasDrawingSession_DrawImage_GaussianBlurEffect)
     {
         BitmapFixture f;
@@ -708,6 +951,26 @@ public:
         });
     }
 
+    TEST_METHOD_EX(CanvasDrawingSession_StrokedDraws_LookUpTheFactoryOnce)
+    {
+        CanvasDrawingSessionFixture f;
+
+        auto canvasStrokeStyle0 = Make<CanvasStrokeStyle>();
+        auto canvasStrokeStyle1 = Make<CanvasStrokeStyle>();
+        ThrowIfFailed(canvasStrokeStyle1->put_LineJoin(CanvasLineJoin::Round));
+
+        f.DeviceContext->DrawLineMethod.AllowAnyCall();
+
+        for (int i = 0; i < 3; ++i)
+        {
+            ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{}, Vector2{}, f.Brush.Get(), 1, canvasStrokeStyle0.Get()));
+            ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{}, Vector2{}, f.Brush.Get(), 1, canvasStrokeStyle1.Get()));
+        }
+
+        Assert::AreEqual(1, f.DeviceContext->m_numCallsToGetFactory);
+        Assert::AreEqual(2, f.DeviceContext->m_factory->m_numCallsToCreateStrokeStyle);
+    }
+
 
     //
     // DrawRectangle
@@ -2178,123 +2441,985 @@ TEST_CLASS(CanvasDrawingSession_DrawTextTests)
 };
 
 
-TEST_CLASS(CanvasDrawingSession_CloseTests)
+TEST_CLASS(CanvasDrawingSession_DrawTextLayoutTests)
 {
-    TEST_METHOD_EX(CanvasDrawingSession_Close_ReleasesDeviceContextAndOtherMethodsFail)
+    class Fixture : public CanvasDrawingSessionFixture
     {
-        //
-        // Set up a device context that tracks when it was deleted (via the
-        // token)
-        //
-        class D2DDeviceContextWithToken : public MockD2DDeviceContext
+    public:
+        ComPtr<ICanvasTextLayout> TextLayout;
+
+        Fixture()
         {
-            std::shared_ptr<bool> m_token;
+            auto factory = Make<CanvasTextLayoutFactory>();
+            ThrowIfFailed(factory->Create(WinString(L"12345"), Make<CanvasTextFormat>().Get(), 1000, 1000, &TextLayout));
+        }
 
-        public:
-            D2DDeviceContextWithToken(std::shared_ptr<bool> token)
-                : m_token(token)
-            {}
-        };
+        ShapedText const& GetShapedText()
+        {
+            return As<ICanvasTextLayoutInternal>(TextLayout)->GetShapedText();
+        }
+    };
 
-        std::shared_ptr<bool> strongToken = std::make_shared<bool>(true);
-        std::weak_ptr<bool> weakToken(strongToken);
+    void TestDrawTextLayout(bool isColorOverload)
+    {
+        Fixture f;
+        BrushValidator brushValidator(f, isColorOverload);
 
-        auto deviceContext = Make<D2DDeviceContextWithToken>(strongToken);
-        strongToken.reset();
+        auto& shapedText = f.GetShapedText();
+        Assert::AreEqual<size_t>(1, shapedText.Runs.size());
 
-        Assert::IsFalse(weakToken.expired());
+        auto& run = shapedText.Runs[0];
 
-        //
-        // Create a drawing session using this device context, verifying that
-        // this has taken ownership of the token.
-        //
-        auto manager = std::make_shared<CanvasDrawingSessionManager>();
-        auto canvasDrawingSession = manager->Create(
-            deviceContext.Get(),
-            std::make_shared<StubCanvasDrawingSessionAdapter>());
+        f.DeviceContext->DrawGlyphRunMethod.SetExpectedCalls(isColorOverload ? 2 : 1,
+            [&](D2D1_POINT_2F baselineOrigin, DWRITE_GLYPH_RUN const* glyphRun, ID2D1Brush* brush, DWRITE_MEASURING_MODE measuringMode)
+            {
+                Assert::AreEqual(D2D1::Point2F(23 + run.BaselineOrigin.x, 42 + run.BaselineOrigin.y), baselineOrigin);
+                Assert::AreEqual(5U, glyphRun->glyphCount);
+                Assert::IsTrue(run.GlyphIndices.data() == glyphRun->glyphIndices);
+                Assert::AreEqual(DWRITE_MEASURING_MODE_NATURAL, measuringMode);
 
-        deviceContext.Reset();
-        Assert::IsFalse(weakToken.expired());
+                brushValidator.Check(brush);
+            });
 
-        //
-        // Closing the drawing session will destroy the device context
-        //
-        ThrowIfFailed(canvasDrawingSession->Close());
-        Assert::IsTrue(weakToken.expired());
+        if (isColorOverload)
+        {
+            ThrowIfFailed(f.DS->DrawTextLayoutWithColor(f.TextLayout.Get(), Vector2{ 23, 42 }, ArbitraryMarkerColor1));
+            ThrowIfFailed(f.DS->DrawTextLayoutWithColor(f.TextLayout.Get(), Vector2{ 23, 42 }, ArbitraryMarkerColor2));
+        }
+        else
+        {
+            ThrowIfFailed(f.DS->DrawTextLayoutWithBrush(f.TextLayout.Get(), Vector2{ 23, 42 }, f.Brush.Get()));
+        }
+    }
 
-        //
-        // Closing a second time is a no-op and will succeed.
-        //
-        ThrowIfFailed(canvasDrawingSession->Close());
+    TEST_METHOD_EX(CanvasDrawingSession_DrawTextLayoutWithBrush)
+    {
+        TestDrawTextLayout(false);
+    }
 
-        ComPtr<ICanvasDevice> deviceVerify;
+    TEST_METHOD_EX(CanvasDrawingSession_DrawTextLayoutWithColor)
+    {
+        TestDrawTextLayout(true);
+    }
 
-        //
-        // Calling any other method will return RO_E_CLOSED
-        //
-        using namespace ABI::Windows::UI;
-        using namespace ABI::Windows::Foundation;
+    TEST_METHOD_EX(CanvasDrawingSession_DrawTextLayout_InvalidArgs)
+    {
+        Fixture f;
 
-#define EXPECT_OBJECT_CLOSED(CODE) Assert::AreEqual(RO_E_CLOSED, CODE)
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawTextLayoutWithBrush(nullptr, Vector2{}, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawTextLayoutWithBrush(f.TextLayout.Get(), Vector2{}, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawTextLayoutWithColor(nullptr, Vector2{}, Color{}));
+    }
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->Clear(Color{}));
+    TEST_METHOD_EX(CanvasDrawingSession_DrawTextLayout_ClosedLayout)
+    {
+        Fixture f;
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImage(nullptr, Vector2{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoords(nullptr, 0, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtOrigin(nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageWithSourceRect(nullptr, Vector2{}, Rect{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageWithSourceRectAndInterpolation(nullptr, Vector2{}, Rect{}, CanvasImageInterpolation::NearestNeighbor));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageWithSourceRectAndInterpolationAndComposite(nullptr, Vector2{}, Rect{}, CanvasImageInterpolation::NearestNeighbor, CanvasComposite::SourceOver));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoordsWithSourceRect(nullptr, 0, 0, Rect{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoordsWithSourceRectAndInterpolation(nullptr, 0, 0, Rect{}, CanvasImageInterpolation::NearestNeighbor));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoordsWithSourceRectAndInterpolationAndComposite(nullptr, 0, 0, Rect{}, CanvasImageInterpolation::NearestNeighbor, CanvasComposite::SourceOver));
+        ThrowIfFailed(As<ABI::Windows::Foundation::IClosable>(f.TextLayout)->Close());
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRect(nullptr, Rect{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRect(nullptr, Rect{}, Rect{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRectAndOpacity(nullptr, Rect{}, Rect{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation(nullptr, Rect{}, Rect{}, 0, CanvasImageInterpolation::NearestNeighbor));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolationAndPerspective(nullptr, Rect{}, Rect{}, 0, CanvasImageInterpolation::NearestNeighbor, Numerics::Matrix4x4{}));
+        Assert::AreEqual(RO_E_CLOSED, f.DS->DrawTextLayoutWithBrush(f.TextLayout.Get(), Vector2{}, f.Brush.Get()));
+    }
+};
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithBrush(Vector2{}, Vector2{}, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithBrush(0, 0, 0, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithColor(Vector2{}, Vector2{}, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithColor(0, 0, 0, 0, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithBrushAndStrokeWidth(Vector2{}, Vector2{}, nullptr, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithBrushAndStrokeWidth(0, 0, 0, 0, nullptr, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithColorAndStrokeWidth(Vector2{}, Vector2{}, Color{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithColorAndStrokeWidth(0, 0, 0, 0, Color{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{}, Vector2{}, nullptr, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithBrushAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, nullptr, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithColorAndStrokeWidthAndStrokeStyle(Vector2{}, Vector2{}, Color{}, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithColorAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, Color{}, 0, nullptr));
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithBrush(Rect{}, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithBrush(0, 0, 0, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithColor(Rect{}, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithColor(0, 0, 0, 0, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithBrushAndStrokeWidth(Rect{}, nullptr, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithBrushAndStrokeWidth(0, 0, 0, 0, nullptr, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithColorAndStrokeWidth(Rect{}, Color{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithColorAndStrokeWidth(0, 0, 0, 0, Color{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithBrushAndStrokeWidthAndStrokeStyle(Rect{}, nullptr, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithBrushAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, nullptr, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithColorAndStrokeWidthAndStrokeStyle(Rect{}, Color{}, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithColorAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, Color{}, 0, nullptr));
+TEST_CLASS(CanvasDrawingSession_GeometryTests)
+{
+    class Fixture : public CanvasDrawingSessionFixture
+    {
+    public:
+        ComPtr<ICanvasGeometry> Geometry;
+        ComPtr<ICanvasCachedGeometry> CachedGeometry;
+        ComPtr<MockD2DGeometryRealization> GeometryRealization;
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleWithBrush(Rect{}, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleAtCoordsWithBrush(0, 0, 0, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleWithColor(Rect{}, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleAtCoordsWithColor(0, 0, 0, 0, Color{}));
+        Fixture()
+            : GeometryRealization(Make<MockD2DGeometryRealization>())
+        {
+            auto geometryFactory = Make<CanvasGeometryFactory>();
+            ThrowIfFailed(geometryFactory->CreateEllipse(Vector2{ 10, 20 }, 5, 5, &Geometry));
 
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithBrush(Rect{}, 0, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithBrush(0, 0, 0, 0, 0, 0, nullptr));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithColor(Rect{}, 0, 0, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithColor(0, 0, 0, 0, 0, 0, Color{}));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithBrushAndStrokeWidth(Rect{}, 0, 0, nullptr, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithBrushAndStrokeWidth(0, 0, 0, 0, 0, 0, nullptr, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithColorAndStrokeWidth(Rect{}, 0, 0, Color{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithColorAndStrokeWidth(0, 0, 0, 0, 0, 0, Color{}, 0));
-        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithBrushAndStrokeWidthAndStrokeStyle(Rect{}, 0, 0, nullptr, 0, nullptr));
+            CachedGeometry = Make<CanvasCachedGeometry>(Make<StubCanvasDevice>().Get(), GeometryRealization.Get());
+        }
+
+        ComPtr<ID2D1Geometry> GetExpectedD2DGeometry()
+        {
+            return As<ICanvasGeometryInternal>(Geometry)->GetRealizedD2DGeometry(DeviceContext->m_factory.Get());
+        }
+    };
+
+    void TestFillGeometry(bool isColorOverload)
+    {
+        Fixture f;
+        BrushValidator brushValidator(f, isColorOverload);
+
+        f.DeviceContext->FillGeometryMethod.SetExpectedCalls(isColorOverload ? 2 : 1,
+            [&](ID2D1Geometry* geometry, ID2D1Brush* brush, ID2D1Brush* opacityBrush)
+            {
+                Assert::AreEqual(f.GetExpectedD2DGeometry().Get(), geometry);
+                Assert::IsNull(opacityBrush);
+                brushValidator.Check(brush);
+            });
+
+        if (isColorOverload)
+        {
+            ThrowIfFailed(f.DS->FillGeometryWithColor(f.Geometry.Get(), ArbitraryMarkerColor1));
+            ThrowIfFailed(f.DS->FillGeometryWithColor(f.Geometry.Get(), ArbitraryMarkerColor2));
+        }
+        else
+        {
+            ThrowIfFailed(f.DS->FillGeometryWithBrush(f.Geometry.Get(), f.Brush.Get()));
+        }
+
+        // The geometry was only realized once for the device context's factory.
+        Assert::AreEqual(1, f.DeviceContext->m_factory->m_numCallsToCreatePathGeometry);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillGeometryWithBrush)
+    {
+        TestFillGeometry(false);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_FillGeometryWithColor)
+    {
+        TestFillGeometry(true);
+    }
+
+    template<typename TDraw>
+    void TestDrawGeometry(bool isColorOverload, float expectedStrokeWidth, bool expectStrokeStyle, TDraw const& callDrawFunction)
+    {
+        Fixture f;
+        BrushValidator brushValidator(f, isColorOverload);
+
+        auto canvasStrokeStyle = Make<CanvasStrokeStyle>();
+        canvasStrokeStyle->put_LineJoin(CanvasLineJoin::Round);
+
+        f.DeviceContext->DrawGeometryMethod.SetExpectedCalls(isColorOverload ? 2 : 1,
+            [&](ID2D1Geometry* geometry, ID2D1Brush* brush, float strokeWidth, ID2D1StrokeStyle* strokeStyle)
+            {
+                Assert::AreEqual(f.GetExpectedD2DGeometry().Get(), geometry);
+                Assert::AreEqual(expectedStrokeWidth, strokeWidth);
+                brushValidator.Check(brush);
+
+                if (expectStrokeStyle)
+                {
+                    Assert::IsNotNull(strokeStyle);
+                    Assert::AreEqual(D2D1_LINE_JOIN_ROUND, static_cast<ID2D1StrokeStyle1*>(strokeStyle)->GetLineJoin());
+                }
+                else
+                {
+                    Assert::IsNull(strokeStyle);
+                }
+            });
+
+        callDrawFunction(f, canvasStrokeStyle.Get());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawGeometryWithBrush)
+    {
+        TestDrawGeometry(false, 1.0f, false,
+            [](Fixture const& f, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawGeometryWithBrush(f.Geometry.Get(), f.Brush.Get()));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawGeometryWithColor)
+    {
+        TestDrawGeometry(true, 1.0f, false,
+            [](Fixture const& f, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawGeometryWithColor(f.Geometry.Get(), ArbitraryMarkerColor1));
+                ThrowIfFailed(f.DS->DrawGeometryWithColor(f.Geometry.Get(), ArbitraryMarkerColor2));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawGeometryWithBrushAndStrokeWidth)
+    {
+        TestDrawGeometry(false, 123.0f, false,
+            [](Fixture const& f, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawGeometryWithBrushAndStrokeWidth(f.Geometry.Get(), f.Brush.Get(), 123.0f));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawGeometryWithColorAndStrokeWidth)
+    {
+        TestDrawGeometry(true, 123.0f, false,
+            [](Fixture const& f, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawGeometryWithColorAndStrokeWidth(f.Geometry.Get(), ArbitraryMarkerColor1, 123.0f));
+                ThrowIfFailed(f.DS->DrawGeometryWithColorAndStrokeWidth(f.Geometry.Get(), ArbitraryMarkerColor2, 123.0f));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle)
+    {
+        TestDrawGeometry(false, 123.0f, true,
+            [](Fixture const& f, CanvasStrokeStyle* strokeStyle)
+            {
+                ThrowIfFailed(f.DS->DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle(f.Geometry.Get(), f.Brush.Get(), 123.0f, strokeStyle));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawGeometryWithColorAndStrokeWidthAndStrokeStyle)
+    {
+        TestDrawGeometry(true, 123.0f, true,
+            [](Fixture const& f, CanvasStrokeStyle* strokeStyle)
+            {
+                ThrowIfFailed(f.DS->DrawGeometryWithColorAndStrokeWidthAndStrokeStyle(f.Geometry.Get(), ArbitraryMarkerColor1, 123.0f, strokeStyle));
+                ThrowIfFailed(f.DS->DrawGeometryWithColorAndStrokeWidthAndStrokeStyle(f.Geometry.Get(), ArbitraryMarkerColor2, 123.0f, strokeStyle));
+            });
+    }
+
+    void TestDrawCachedGeometry(bool isColorOverload)
+    {
+        Fixture f;
+        BrushValidator brushValidator(f, isColorOverload);
+
+        f.DeviceContext->DrawGeometryRealizationMethod.SetExpectedCalls(isColorOverload ? 2 : 1,
+            [&](ID2D1GeometryRealization* geometryRealization, ID2D1Brush* brush)
+            {
+                Assert::AreEqual<ID2D1GeometryRealization*>(f.GeometryRealization.Get(), geometryRealization);
+                brushValidator.Check(brush);
+            });
+
+        if (isColorOverload)
+        {
+            ThrowIfFailed(f.DS->DrawCachedGeometryWithColor(f.CachedGeometry.Get(), Vector2{}, ArbitraryMarkerColor1));
+            ThrowIfFailed(f.DS->DrawCachedGeometryWithColor(f.CachedGeometry.Get(), Vector2{}, ArbitraryMarkerColor2));
+        }
+        else
+        {
+            ThrowIfFailed(f.DS->DrawCachedGeometryWithBrush(f.CachedGeometry.Get(), Vector2{}, f.Brush.Get()));
+        }
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawCachedGeometryWithBrush)
+    {
+        TestDrawCachedGeometry(false);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawCachedGeometryWithColor)
+    {
+        TestDrawCachedGeometry(true);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawCachedGeometry_WithOffset_TranslatesAndRestoresTheTransform)
+    {
+        Fixture f;
+
+        auto previousTransform = D2D1::Matrix3x2F::Scale(2, 2);
+        auto expectedTransform = D2D1::Matrix3x2F::Translation(23, 42) * previousTransform;
+        bool drawn = false;
+
+        f.DeviceContext->GetTransformMethod.SetExpectedCalls(1,
+            [&](D2D1_MATRIX_3X2_F* transform)
+            {
+                *transform = previousTransform;
+            });
+
+        int setTransformCount = 0;
+        f.DeviceContext->SetTransformMethod.SetExpectedCalls(2,
+            [&](D2D1_MATRIX_3X2_F const* transform)
+            {
+                if (setTransformCount++ == 0)
+                {
+                    Assert::IsFalse(drawn);
+                    Assert::AreEqual<D2D1_MATRIX_3X2_F>(expectedTransform, *transform);
+                }
+                else
+                {
+                    Assert::IsTrue(drawn);
+                    Assert::AreEqual<D2D1_MATRIX_3X2_F>(previousTransform, *transform);
+                }
+            });
+
+        f.DeviceContext->DrawGeometryRealizationMethod.SetExpectedCalls(1,
+            [&](ID2D1GeometryRealization*, ID2D1Brush*)
+            {
+                drawn = true;
+            });
+
+        ThrowIfFailed(f.DS->DrawCachedGeometryWithBrush(f.CachedGeometry.Get(), Vector2{ 23, 42 }, f.Brush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawCachedGeometry_WithZeroOffset_LeavesTheTransformAlone)
+    {
+        Fixture f;
+
+        f.DeviceContext->DrawGeometryRealizationMethod.SetExpectedCalls(1);
+
+        ThrowIfFailed(f.DS->DrawCachedGeometryWithBrush(f.CachedGeometry.Get(), Vector2{}, f.Brush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Geometry_InvalidArgs)
+    {
+        Fixture f;
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillGeometryWithBrush(nullptr, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillGeometryWithBrush(f.Geometry.Get(), nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->FillGeometryWithColor(nullptr, Color{}));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawGeometryWithBrush(nullptr, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawGeometryWithBrush(f.Geometry.Get(), nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawGeometryWithColor(nullptr, Color{}));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawCachedGeometryWithBrush(nullptr, Vector2{}, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawCachedGeometryWithBrush(f.CachedGeometry.Get(), Vector2{}, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawCachedGeometryWithColor(nullptr, Vector2{}, Color{}));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Geometry_ClosedGeometry)
+    {
+        Fixture f;
+
+        ThrowIfFailed(As<ABI::Windows::Foundation::IClosable>(f.Geometry)->Close());
+        ThrowIfFailed(As<ABI::Windows::Foundation::IClosable>(f.CachedGeometry)->Close());
+
+        Assert::AreEqual(RO_E_CLOSED, f.DS->FillGeometryWithBrush(f.Geometry.Get(), f.Brush.Get()));
+        Assert::AreEqual(RO_E_CLOSED, f.DS->DrawGeometryWithBrush(f.Geometry.Get(), f.Brush.Get()));
+        Assert::AreEqual(RO_E_CLOSED, f.DS->DrawCachedGeometryWithBrush(f.CachedGeometry.Get(), Vector2{}, f.Brush.Get()));
+    }
+};
+
+
+TEST_CLASS(CanvasDrawingSession_DrawPolylineTests)
+{
+    class Fixture : public CanvasDrawingSessionFixture
+    {
+    public:
+        // The figures of the last polyline drawn, as lists of points.
+        std::vector<std::vector<D2D1_POINT_2F>> Figures;
+
+        Fixture()
+        {
+            DeviceContext->GetTransformMethod.AllowAnyCall(
+                [](D2D1_MATRIX_3X2_F* transform)
+                {
+                    *transform = D2D1::Matrix3x2F::Identity();
+                });
+
+            DeviceContext->GetDpiMethod.AllowAnyCall(
+                [](float* dpiX, float* dpiY)
+                {
+                    *dpiX = DEFAULT_DPI;
+                    *dpiY = DEFAULT_DPI;
+                });
+
+            SetTargetSize(100, 100);
+        }
+
+        void SetTargetSize(float width, float height)
+        {
+            auto target = Make<StubD2DBitmap>();
+            target->GetSizeMethod.AllowAnyCall([=] { return D2D1_SIZE_F{ width, height }; });
+
+            DeviceContext->GetTargetMethod.AllowAnyCall(
+                [=](ID2D1Image** value)
+                {
+                    ThrowIfFailed(target.CopyTo(value));
+                });
+        }
+
+        void SetCommandListTarget()
+        {
+            auto target = Make<MockD2DCommandList>();
+
+            DeviceContext->GetTargetMethod.AllowAnyCall(
+                [=](ID2D1Image** value)
+                {
+                    ThrowIfFailed(target.CopyTo(value));
+                });
+        }
+
+        void ExpectDrawGeometry(int expectedCalls = 1)
+        {
+            DeviceContext->DrawGeometryMethod.SetExpectedCalls(expectedCalls,
+                [=](ID2D1Geometry* geometry, ID2D1Brush*, float, ID2D1StrokeStyle*)
+                {
+                    Figures = GetFigures(geometry);
+                });
+        }
+
+        static std::vector<std::vector<D2D1_POINT_2F>> GetFigures(ID2D1Geometry* geometry)
+        {
+            auto sink = Make<PathDataSink>();
+            ThrowIfFailed(geometry->Simplify(
+                D2D1_GEOMETRY_SIMPLIFICATION_OPTION_LINES,
+                nullptr,
+                D2D1_DEFAULT_FLATTENING_TOLERANCE,
+                sink.Get()));
+            ThrowIfFailed(sink->Close());
+
+            std::vector<std::vector<D2D1_POINT_2F>> figures;
+
+            for (auto& figure : sink->GetPathData().Figures)
+            {
+                Assert::IsFalse(figure.IsClosed);
+
+                std::vector<D2D1_POINT_2F> points;
+                points.push_back(figure.StartPoint);
+
+                for (auto& segment : figure.Segments)
+                    points.push_back(segment.GetEndPoint());
+
+                figures.push_back(points);
+            }
+
+            return figures;
+        }
+    };
+
+    static std::vector<Vector2> MakeZigzag(int pointCount, float y, float amplitude)
+    {
+        std::vector<Vector2> points;
+
+        for (int i = 0; i < pointCount; i++)
+            points.push_back(Vector2{ 10 + 80.0f * i / pointCount, y + ((i & 1) ? amplitude : -amplitude) });
+
+        return points;
+    }
+
+    template<typename TDraw>
+    void TestDrawPolyline(bool isColorOverload, float expectedStrokeWidth, bool expectStrokeStyle, TDraw const& callDrawFunction)
+    {
+        Fixture f;
+        BrushValidator brushValidator(f, isColorOverload);
+
+        auto canvasStrokeStyle = Make<CanvasStrokeStyle>();
+        canvasStrokeStyle->put_LineJoin(CanvasLineJoin::Round);
+
+        Vector2 points[] = { { 10, 10 }, { 20, 30 }, { 40, 10 } };
+
+        f.DeviceContext->DrawGeometryMethod.SetExpectedCalls(isColorOverload ? 2 : 1,
+            [&](ID2D1Geometry* geometry, ID2D1Brush* brush, float strokeWidth, ID2D1StrokeStyle* strokeStyle)
+            {
+                auto figures = Fixture::GetFigures(geometry);
+
+                Assert::AreEqual<size_t>(1, figures.size());
+                Assert::AreEqual<size_t>(_countof(points), figures[0].size());
+
+                for (size_t i = 0; i < _countof(points); i++)
+                    Assert::AreEqual(ToD2DPoint(points[i]), figures[0][i]);
+
+                Assert::AreEqual(expectedStrokeWidth, strokeWidth);
+                brushValidator.Check(brush);
+
+                if (expectStrokeStyle)
+                {
+                    Assert::IsNotNull(strokeStyle);
+                    Assert::AreEqual(D2D1_LINE_JOIN_ROUND, static_cast<ID2D1StrokeStyle1*>(strokeStyle)->GetLineJoin());
+                }
+                else
+                {
+                    Assert::IsNull(strokeStyle);
+                }
+            });
+
+        callDrawFunction(f, _countof(points), points, canvasStrokeStyle.Get());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolylineWithBrush)
+    {
+        TestDrawPolyline(false, 1.0f, false,
+            [](Fixture const& f, uint32_t pointCount, Vector2* points, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawPolylineWithBrush(pointCount, points, f.Brush.Get()));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolylineWithColor)
+    {
+        TestDrawPolyline(true, 1.0f, false,
+            [](Fixture const& f, uint32_t pointCount, Vector2* points, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawPolylineWithColor(pointCount, points, ArbitraryMarkerColor1));
+                ThrowIfFailed(f.DS->DrawPolylineWithColor(pointCount, points, ArbitraryMarkerColor2));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolylineWithBrushAndStrokeWidth)
+    {
+        TestDrawPolyline(false, 5.0f, false,
+            [](Fixture const& f, uint32_t pointCount, Vector2* points, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawPolylineWithBrushAndStrokeWidth(pointCount, points, f.Brush.Get(), 5.0f));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolylineWithColorAndStrokeWidth)
+    {
+        TestDrawPolyline(true, 5.0f, false,
+            [](Fixture const& f, uint32_t pointCount, Vector2* points, CanvasStrokeStyle*)
+            {
+                ThrowIfFailed(f.DS->DrawPolylineWithColorAndStrokeWidth(pointCount, points, ArbitraryMarkerColor1, 5.0f));
+                ThrowIfFailed(f.DS->DrawPolylineWithColorAndStrokeWidth(pointCount, points, ArbitraryMarkerColor2, 5.0f));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle)
+    {
+        TestDrawPolyline(false, 5.0f, true,
+            [](Fixture const& f, uint32_t pointCount, Vector2* points, CanvasStrokeStyle* strokeStyle)
+            {
+                ThrowIfFailed(f.DS->DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(pointCount, points, f.Brush.Get(), 5.0f, strokeStyle));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolylineWithColorAndStrokeWidthAndStrokeStyle)
+    {
+        TestDrawPolyline(true, 5.0f, true,
+            [](Fixture const& f, uint32_t pointCount, Vector2* points, CanvasStrokeStyle* strokeStyle)
+            {
+                ThrowIfFailed(f.DS->DrawPolylineWithColorAndStrokeWidthAndStrokeStyle(pointCount, points, ArbitraryMarkerColor1, 5.0f, strokeStyle));
+                ThrowIfFailed(f.DS->DrawPolylineWithColorAndStrokeWidthAndStrokeStyle(pointCount, points, ArbitraryMarkerColor2, 5.0f, strokeStyle));
+            });
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_WithFewerThanTwoPoints_DrawsNothing)
+    {
+        Fixture f;
+        Vector2 point{ 10, 10 };
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(0, nullptr, f.Brush.Get()));
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(1, &point, f.Brush.Get()));
+
+        Assert::AreEqual(0, f.DeviceContext->m_factory->m_numCallsToCreatePathGeometry);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_OffTheTarget_DrawsNothing)
+    {
+        Fixture f;
+        Vector2 points[] = { { 150, 10 }, { 200, 50 }, { 150, 90 } };
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(_countof(points), points, f.Brush.Get()));
+
+        Assert::AreEqual(0, f.DeviceContext->m_factory->m_numCallsToCreatePathGeometry);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_JustOffTheTarget_IsDrawnWhenTheStrokeReachesIn)
+    {
+        Fixture f;
+        Vector2 points[] = { { -5, 10 }, { -5, 90 } };
+
+        auto canvasStrokeStyle = Make<CanvasStrokeStyle>();
+        canvasStrokeStyle->put_LineJoin(CanvasLineJoin::Round);
+
+        // A thin stroke cannot reach the target.
+        ThrowIfFailed(f.DS->DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(_countof(points), points, f.Brush.Get(), 1.0f, canvasStrokeStyle.Get()));
+
+        // A wide one can.
+        f.DeviceContext->DrawGeometryMethod.SetExpectedCalls(1);
+        ThrowIfFailed(f.DS->DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(_countof(points), points, f.Brush.Get(), 20.0f, canvasStrokeStyle.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_DenseLine_IsSimplified)
+    {
+        Fixture f;
+        auto points = MakeZigzag(10000, 50, 0.01f);
+
+        f.ExpectDrawGeometry();
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(static_cast<uint32_t>(points.size()), points.data(), f.Brush.Get()));
+
+        Assert::AreEqual<size_t>(1, f.Figures.size());
+        Assert::AreEqual<size_t>(2, f.Figures[0].size());
+        Assert::AreEqual(ToD2DPoint(points.front()), f.Figures[0].front());
+        Assert::AreEqual(ToD2DPoint(points.back()), f.Figures[0].back());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_SimplifiesInPixels)
+    {
+        Fixture f;
+        auto points = MakeZigzag(100, 50, 0.05f);
+
+        f.ExpectDrawGeometry(2);
+
+        // At 96 DPI the wiggles are smaller than the tolerance.
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(static_cast<uint32_t>(points.size()), points.data(), f.Brush.Get()));
+        Assert::AreEqual<size_t>(2, f.Figures[0].size());
+
+        // When the target is scaled up they are not.
+        f.DeviceContext->GetTransformMethod.AllowAnyCall(
+            [](D2D1_MATRIX_3X2_F* transform)
+            {
+                *transform = D2D1::Matrix3x2F::Scale(10, 10);
+            });
+
+        f.SetTargetSize(1000, 1000);
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(static_cast<uint32_t>(points.size()), points.data(), f.Brush.Get()));
+        Assert::AreEqual(points.size(), f.Figures[0].size());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_LeavingTheTarget_DrawsAFigureForEachVisiblePart)
+    {
+        Fixture f;
+        Vector2 points[] = { { 10, 10 }, { 50, 10 }, { 50, -100 }, { 50, -200 }, { 90, -100 }, { 90, 10 }, { 95, 10 } };
+
+        f.ExpectDrawGeometry();
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(_countof(points), points, f.Brush.Get()));
+
+        Assert::AreEqual<size_t>(2, f.Figures.size());
+        Assert::AreEqual(ToD2DPoint(points[0]), f.Figures[0].front());
+        Assert::AreEqual(ToD2DPoint(points[2]), f.Figures[0].back());
+        Assert::AreEqual(ToD2DPoint(points[4]), f.Figures[1].front());
+        Assert::AreEqual(ToD2DPoint(points[6]), f.Figures[1].back());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_ToACommandList_KeepsEveryPoint)
+    {
+        Fixture f;
+        f.SetCommandListTarget();
+
+        auto points = MakeZigzag(100, 50, 0.01f);
+        points.push_back(Vector2{ 500, 500 });
+
+        f.ExpectDrawGeometry();
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrush(static_cast<uint32_t>(points.size()), points.data(), f.Brush.Get()));
+
+        Assert::AreEqual<size_t>(1, f.Figures.size());
+        Assert::AreEqual(points.size(), f.Figures[0].size());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_Dashed_KeepsEveryPoint)
+    {
+        Fixture f;
+
+        auto points = MakeZigzag(100, 50, 0.01f);
+        points.push_back(Vector2{ 500, 500 });
+
+        auto canvasStrokeStyle = Make<CanvasStrokeStyle>();
+        canvasStrokeStyle->put_DashStyle(CanvasDashStyle::Dash);
+
+        f.ExpectDrawGeometry();
+
+        ThrowIfFailed(f.DS->DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(static_cast<uint32_t>(points.size()), points.data(), f.Brush.Get(), 1.0f, canvasStrokeStyle.Get()));
+
+        Assert::AreEqual<size_t>(1, f.Figures.size());
+        Assert::AreEqual(points.size(), f.Figures[0].size());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_DrawPolyline_InvalidArgs)
+    {
+        Fixture f;
+        Vector2 points[] = { { 10, 10 }, { 20, 20 } };
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawPolylineWithBrush(2, nullptr, f.Brush.Get()));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawPolylineWithBrush(_countof(points), points, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->DrawPolylineWithColor(2, nullptr, Color{}));
+    }
+};
+
+
+TEST_CLASS(CanvasDrawingSession_StatisticsTests)
+{
+    class Fixture
+    {
+    public:
+        ComPtr<StubD2DDeviceContextWithGetFactory> DeviceContext;
+        std::shared_ptr<DrawingStatistics> Statistics;
+        ComPtr<CanvasDrawingSession> DS;
+        ComPtr<StubCanvasBrush> Brush;
+
+        Fixture()
+            : DeviceContext(Make<StubD2DDeviceContextWithGetFactory>())
+            , Statistics(std::make_shared<DrawingStatistics>())
+            , Brush(Make<StubCanvasBrush>())
+        {
+            DrawingStatisticsScope statisticsScope(Statistics.get());
+
+            auto manager = std::make_shared<CanvasDrawingSessionManager>();
+            DS = manager->Create(DeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_OnlySessionsCreatedInScopeAreCounted)
+    {
+        CanvasDrawingSessionFixture f;
+        f.DeviceContext->DrawLineMethod.AllowAnyCall();
+
+        auto statistics = std::make_shared<DrawingStatistics>();
+        DrawingStatisticsScope statisticsScope(statistics.get());
+
+        ThrowIfFailed(f.DS->DrawLineWithBrush(Vector2{ 0, 0 }, Vector2{ 1, 1 }, f.Brush.Get()));
+
+        Assert::AreEqual(0U, statistics->GetDrawingSessionCount());
+        Assert::AreEqual(0U, statistics->GetPrimitiveCount(DrawingPrimitive::Line));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_CountsEachDrawCall)
+    {
+        Fixture f;
+
+        f.DeviceContext->ClearMethod.AllowAnyCall();
+        f.DeviceContext->DrawLineMethod.AllowAnyCall();
+        f.DeviceContext->DrawRectangleMethod.AllowAnyCall();
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+        f.DeviceContext->FillRoundedRectangleMethod.AllowAnyCall();
+        f.DeviceContext->FillEllipseMethod.AllowAnyCall();
+
+        Rect rect{ 0, 0, 10, 10 };
+
+        ThrowIfFailed(f.DS->Clear(Color{}));
+        ThrowIfFailed(f.DS->DrawLineWithBrush(Vector2{ 0, 0 }, Vector2{ 1, 1 }, f.Brush.Get()));
+        ThrowIfFailed(f.DS->DrawLineWithBrush(Vector2{ 1, 1 }, Vector2{ 2, 2 }, f.Brush.Get()));
+        ThrowIfFailed(f.DS->DrawRectangleWithBrush(rect, f.Brush.Get()));
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(rect, f.Brush.Get()));
+        ThrowIfFailed(f.DS->FillRoundedRectangleWithBrush(rect, 2, 2, f.Brush.Get()));
+        ThrowIfFailed(f.DS->FillEllipseWithBrush(Vector2{ 5, 5 }, 2, 2, f.Brush.Get()));
+
+        Assert::AreEqual(1U, f.Statistics->GetDrawingSessionCount());
+        Assert::AreEqual(1U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Clear));
+        Assert::AreEqual(2U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Line));
+        Assert::AreEqual(2U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Rectangle));
+        Assert::AreEqual(1U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::RoundedRectangle));
+        Assert::AreEqual(1U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Ellipse));
+        Assert::AreEqual(0U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Text));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_CountsBrushChanges)
+    {
+        Fixture f;
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+
+        auto otherBrush = Make<StubCanvasBrush>();
+        Rect rect{ 0, 0, 10, 10 };
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(rect, f.Brush.Get()));
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(rect, f.Brush.Get()));
+        Assert::AreEqual(0U, f.Statistics->GetBrushChangeCount());
+
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(rect, otherBrush.Get()));
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(rect, f.Brush.Get()));
+        Assert::AreEqual(2U, f.Statistics->GetBrushChangeCount());
+    }
+
+    static ULONG GetRefCount(IUnknown* object)
+    {
+        object->AddRef();
+        return object->Release();
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_KeepsLastBrushAliveUntilClosed)
+    {
+        Fixture f;
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+
+        ComPtr<ID2D1Brush> d2dBrush;
+
+        {
+            auto brush = Make<StubCanvasBrush>();
+            d2dBrush = brush->GetD2DBrush(nullptr);
+
+            ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 0, 0, 10, 10 }, brush.Get()));
+        }
+
+        // If the session let go of it, a new brush could be created at the
+        // same address and its first use would not count as a change.
+        Assert::AreEqual(2UL, GetRefCount(d2dBrush.Get()));
+
+        ThrowIfFailed(f.DS->Close());
+
+        Assert::AreEqual(1UL, GetRefCount(d2dBrush.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_ColorsReuseTheSameBrush)
+    {
+        Fixture f;
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+        f.DeviceContext->CreateSolidColorBrushMethod.SetExpectedCalls(1,
+            [](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** brush)
+            {
+                return Make<MockD2DSolidColorBrush>().CopyTo(brush);
+            });
+
+        Rect rect{ 0, 0, 10, 10 };
+
+        ThrowIfFailed(f.DS->FillRectangleWithColor(rect, ArbitraryMarkerColor1));
+        ThrowIfFailed(f.DS->FillRectangleWithColor(rect, ArbitraryMarkerColor2));
+
+        Assert::AreEqual(2U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Rectangle));
+        Assert::AreEqual(0U, f.Statistics->GetBrushChangeCount());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_CountsStrokeStyleChangesBetweenStrokes)
+    {
+        Fixture f;
+        f.DeviceContext->DrawLineMethod.AllowAnyCall();
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall();
+
+        auto roundStrokeStyle = Make<CanvasStrokeStyle>();
+        ThrowIfFailed(roundStrokeStyle->put_LineJoin(CanvasLineJoin::Round));
+
+        auto dashedStrokeStyle = Make<CanvasStrokeStyle>();
+        ThrowIfFailed(dashedStrokeStyle->put_DashStyle(CanvasDashStyle::Dash));
+
+        auto drawLine = [&](ICanvasStrokeStyle* strokeStyle)
+        {
+            ThrowIfFailed(f.DS->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{ 0, 0 }, Vector2{ 1, 1 }, f.Brush.Get(), 1.0f, strokeStyle));
+        };
+
+        drawLine(nullptr);
+        drawLine(nullptr);
+        drawLine(roundStrokeStyle.Get());
+        drawLine(roundStrokeStyle.Get());
+        drawLine(dashedStrokeStyle.Get());
+
+        // Fills have no stroke style, so do not affect the count.
+        ThrowIfFailed(f.DS->FillRectangleWithBrush(Rect{ 0, 0, 10, 10 }, f.Brush.Get()));
+
+        drawLine(nullptr);
+
+        Assert::AreEqual(3U, f.Statistics->GetStrokeStyleChangeCount());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_Statistics_ClosingStopsCountingAndAddsDrawTime)
+    {
+        Fixture f;
+        f.DeviceContext->DrawLineMethod.AllowAnyCall();
+
+        ThrowIfFailed(f.DS->DrawLineWithBrush(Vector2{ 0, 0 }, Vector2{ 1, 1 }, f.Brush.Get()));
+        ThrowIfFailed(f.DS->Close());
+
+        Assert::AreEqual(RO_E_CLOSED, f.DS->DrawLineWithBrush(Vector2{ 0, 0 }, Vector2{ 1, 1 }, f.Brush.Get()));
+
+        Assert::AreEqual(1U, f.Statistics->GetPrimitiveCount(DrawingPrimitive::Line));
+        Assert::IsTrue(f.Statistics->GetDrawTime() >= 0);
+
+        auto snapshot = Make<CanvasDrawingStatistics>(*f.Statistics);
+
+        int32_t count;
+        ThrowIfFailed(snapshot->get_DrawingSessionCount(&count));
+        Assert::AreEqual(1, count);
+        ThrowIfFailed(snapshot->get_LineCount(&count));
+        Assert::AreEqual(1, count);
+
+        TimeSpan drawTime;
+        ThrowIfFailed(snapshot->get_DrawTime(&drawTime));
+        Assert::AreEqual(f.Statistics->GetDrawTime(), drawTime.Duration);
+
+        Assert::AreEqual(E_INVALIDARG, snapshot->get_LineCount(nullptr));
+    }
+};
+
+
+TEST_CLASS(CanvasDrawingSession_CloseTests)
+{
+    TEST_METHOD_EX(CanvasDrawingSession_Close_ReleasesDeviceContextAndOtherMethodsFail)
+    {
+        //
+        // Set up a device context that tracks when it was deleted (via the
+        // token)
+        //
+        class D2DDeviceContextWithToken : public MockD2DDeviceContext
+        {
+            std::shared_ptr<bool> m_token;
+
+        public:
+            D2DDeviceContextWithToken(std::shared_ptr<bool> token)
+                : m_token(token)
+            {}
+        };
+
+        std::shared_ptr<bool> strongToken = std::make_shared<bool>(true);
+        std::weak_ptr<bool> weakToken(strongToken);
+
+        auto deviceContext = Make<D2DDeviceContextWithToken>(strongToken);
+        strongToken.reset();
+
+        Assert::IsFalse(weakToken.expired());
+
+        //
+        // Create a drawing session using this device context, verifying that
+        // this has taken ownership of the token.
+        //
+        auto manager = std::make_shared<CanvasDrawingSessionManager>();
+        auto canvasDrawingSession = manager->Create(
+            deviceContext.Get(),
+            std::make_shared<StubCanvasDrawingSessionAdapter>());
+
+        deviceContext.Reset();
+        Assert::IsFalse(weakToken.expired());
+
+        //
+        // Closing the drawing session will destroy the device context
+        //
+        ThrowIfFailed(canvasDrawingSession->Close());
+        Assert::IsTrue(weakToken.expired());
+
+        //
+        // Closing a second time is a no-op and will succeed.
+        //
+        ThrowIfFailed(canvasDrawingSession->Close());
+
+        ComPtr<ICanvasDevice> deviceVerify;
+
+        //
+        // Calling any other method will return RO_E_CLOSED
+        //
+        using namespace ABI::Windows::UI;
+        using namespace ABI::Windows::Foundation;
+
+#define EXPECT_OBJECT_CLOSED(CODE) Assert::AreEqual(RO_E_CLOSED, CODE)
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->Clear(Color{}));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImage(nullptr, Vector2{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoords(nullptr, 0, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtOrigin(nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageWithSourceRect(nullptr, Vector2{}, Rect{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageWithSourceRectAndInterpolation(nullptr, Vector2{}, Rect{}, CanvasImageInterpolation::NearestNeighbor));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageWithSourceRectAndInterpolationAndComposite(nullptr, Vector2{}, Rect{}, CanvasImageInterpolation::NearestNeighbor, CanvasComposite::SourceOver));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoordsWithSourceRect(nullptr, 0, 0, Rect{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoordsWithSourceRectAndInterpolation(nullptr, 0, 0, Rect{}, CanvasImageInterpolation::NearestNeighbor));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawImageAtCoordsWithSourceRectAndInterpolationAndComposite(nullptr, 0, 0, Rect{}, CanvasImageInterpolation::NearestNeighbor, CanvasComposite::SourceOver));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRect(nullptr, Rect{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRect(nullptr, Rect{}, Rect{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRectAndOpacity(nullptr, Rect{}, Rect{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation(nullptr, Rect{}, Rect{}, 0, CanvasImageInterpolation::NearestNeighbor));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolationAndPerspective(nullptr, Rect{}, Rect{}, 0, CanvasImageInterpolation::NearestNeighbor, Numerics::Matrix4x4{}));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithBrush(Vector2{}, Vector2{}, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithBrush(0, 0, 0, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithColor(Vector2{}, Vector2{}, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithColor(0, 0, 0, 0, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithBrushAndStrokeWidth(Vector2{}, Vector2{}, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithBrushAndStrokeWidth(0, 0, 0, 0, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithColorAndStrokeWidth(Vector2{}, Vector2{}, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithColorAndStrokeWidth(0, 0, 0, 0, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithBrushAndStrokeWidthAndStrokeStyle(Vector2{}, Vector2{}, nullptr, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithBrushAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, nullptr, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineWithColorAndStrokeWidthAndStrokeStyle(Vector2{}, Vector2{}, Color{}, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawLineAtCoordsWithColorAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, Color{}, 0, nullptr));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithBrush(Rect{}, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithBrush(0, 0, 0, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithColor(Rect{}, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithColor(0, 0, 0, 0, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithBrushAndStrokeWidth(Rect{}, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithBrushAndStrokeWidth(0, 0, 0, 0, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithColorAndStrokeWidth(Rect{}, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithColorAndStrokeWidth(0, 0, 0, 0, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithBrushAndStrokeWidthAndStrokeStyle(Rect{}, nullptr, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithBrushAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, nullptr, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleWithColorAndStrokeWidthAndStrokeStyle(Rect{}, Color{}, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRectangleAtCoordsWithColorAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, Color{}, 0, nullptr));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleWithBrush(Rect{}, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleAtCoordsWithBrush(0, 0, 0, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleWithColor(Rect{}, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillRectangleAtCoordsWithColor(0, 0, 0, 0, Color{}));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithBrush(Rect{}, 0, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithBrush(0, 0, 0, 0, 0, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithColor(Rect{}, 0, 0, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithColor(0, 0, 0, 0, 0, 0, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithBrushAndStrokeWidth(Rect{}, 0, 0, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithBrushAndStrokeWidth(0, 0, 0, 0, 0, 0, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithColorAndStrokeWidth(Rect{}, 0, 0, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithColorAndStrokeWidth(0, 0, 0, 0, 0, 0, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithBrushAndStrokeWidthAndStrokeStyle(Rect{}, 0, 0, nullptr, 0, nullptr));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithBrushAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, 0, 0, nullptr, 0, nullptr));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleWithColorAndStrokeWidthAndStrokeStyle(Rect{}, 0, 0, Color{}, 0, nullptr));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawRoundedRectangleAtCoordsWithColorAndStrokeWidthAndStrokeStyle(0, 0, 0, 0, 0, 0, Color{}, 0, nullptr));
@@ -2351,6 +3476,26 @@ TEST_CLASS(CanvasDrawingSession_CloseTests)
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawTextAtPointCoordsWithColorAndFormat(nullptr, 0, 0, Color{}, nullptr));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawTextAtRectCoordsWithColorAndFormat(nullptr, 0, 0, 0, 0, Color{}, nullptr));
 
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawTextLayoutWithBrush(nullptr, Vector2{}, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawTextLayoutWithColor(nullptr, Vector2{}, Color{}));
+
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillGeometryWithBrush(nullptr, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->FillGeometryWithColor(nullptr, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawGeometryWithBrush(nullptr, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawGeometryWithColor(nullptr, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawGeometryWithBrushAndStrokeWidth(nullptr, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawGeometryWithColorAndStrokeWidth(nullptr, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle(nullptr, nullptr, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawGeometryWithColorAndStrokeWidthAndStrokeStyle(nullptr, Color{}, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawCachedGeometryWithBrush(nullptr, Vector2{}, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawCachedGeometryWithColor(nullptr, Vector2{}, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawPolylineWithBrush(0, nullptr, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawPolylineWithColor(0, nullptr, Color{}));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawPolylineWithBrushAndStrokeWidth(0, nullptr, nullptr, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawPolylineWithColorAndStrokeWidth(0, nullptr, Color{}, 0));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle(0, nullptr, nullptr, 0, nullptr));
+        EXPECT_OBJECT_CLOSED(canvasDrawingSession->DrawPolylineWithColorAndStrokeWidthAndStrokeStyle(0, nullptr, Color{}, 0, nullptr));
+
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->get_Antialiasing(nullptr));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->put_Antialiasing(CanvasAntialiasing::Aliased));
         EXPECT_OBJECT_CLOSED(canvasDrawingSession->get_Blend(nullptr));
@@ -16,6 +16,7 @@
 #include <effects\CanvasEffect.h>
 
 #include "MockD2DCommandList.h"
+#include "RecordingTraceSink.h"
 #include "SwitchableTestBrushFixture.h"
 #include "TestEffect.h"
 
@@ -276,6 +277,78 @@ public:
         VerifyEffectRealizationInputs(drawingSessionManager, testEffect.Get());
     }
 
+    TEST_METHOD_EX(CanvasEffect_Realization_CountsAgainstDrawingStatistics)
+    {
+        Fixture f;
+
+        auto testEffect = Make<TestEffect>(m_blurGuid, 1, 1, false);
+        ThrowIfFailed(testEffect->put_Source(As<IEffectInput>(CreateStubCanvasBitmap()).Get()));
+
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+        f.m_deviceContext->CreateEffectMethod.SetExpectedCalls(1,
+            [&](IID const&, ID2D1Effect** effect)
+            {
+                f.m_mockEffect->MockSetInput = [](UINT32, ID2D1Image*) {};
+                f.m_mockEffect->MockSetInputCount = [] { return S_OK; };
+                f.m_mockEffect->MockSetValue = [](UINT32, D2D1_PROPERTY_TYPE, CONST BYTE*, UINT32) { return S_OK; };
+                return f.m_mockEffect.CopyTo(effect);
+            });
+
+        auto statistics = std::make_shared<DrawingStatistics>();
+        ComPtr<CanvasDrawingSession> drawingSession;
+        {
+            DrawingStatisticsScope statisticsScope(statistics.get());
+            drawingSession = f.m_drawingSessionManager->Create(f.m_deviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+        }
+
+        Vector2 position = { 0, 0 };
+
+        // Drawing realizes the effect the first time only.
+        ThrowIfFailed(drawingSession->DrawImage(testEffect.Get(), position));
+        ThrowIfFailed(drawingSession->DrawImage(testEffect.Get(), position));
+        Assert::AreEqual(1U, statistics->GetEffectNodesRealizedCount());
+
+        // Changing a property makes the next draw update the D2D effect.
+        ThrowIfFailed(testEffect->put_BlurAmount(5));
+        ThrowIfFailed(drawingSession->DrawImage(testEffect.Get(), position));
+        Assert::AreEqual(2U, statistics->GetEffectNodesRealizedCount());
+
+        Assert::AreEqual(3U, statistics->GetPrimitiveCount(DrawingPrimitive::Image));
+    }
+
+#ifndef WIN2D_DISABLE_TRACING
+
+    TEST_METHOD_EX(CanvasEffect_Realization_IsTraced)
+    {
+        Fixture f;
+
+        auto testEffect = Make<TestEffect>(m_blurGuid, 1, 1, false);
+        ThrowIfFailed(testEffect->put_Source(As<IEffectInput>(CreateStubCanvasBitmap()).Get()));
+
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+        f.m_deviceContext->CreateEffectMethod.SetExpectedCalls(1,
+            [&](IID const&, ID2D1Effect** effect)
+            {
+                f.m_mockEffect->MockSetInput = [](UINT32, ID2D1Image*) {};
+                f.m_mockEffect->MockSetInputCount = [] { return S_OK; };
+                f.m_mockEffect->MockSetValue = [](UINT32, D2D1_PROPERTY_TYPE, CONST BYTE*, UINT32) { return S_OK; };
+                return f.m_mockEffect.CopyTo(effect);
+            });
+
+        auto drawingSession = f.m_drawingSessionManager->Create(f.m_deviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+
+        RecordingTraceSink sink;
+
+        Vector2 position = { 0, 0 };
+        ThrowIfFailed(drawingSession->DrawImage(testEffect.Get(), position));
+        ThrowIfFailed(drawingSession->DrawImage(testEffect.Get(), position));
+
+        // Each draw asks for the realized effect, even when nothing changed.
+        sink.AssertSpans(TraceEvent::EffectRealization, 2);
+    }
+
+#endif
+
     class InvalidEffectInputType : public RuntimeClass<IEffectInput>
     {
         InspectableClass(L"InvalidEffectInputType", BaseTrust);
@@ -549,6 +622,90 @@ public:
         Assert::IsTrue(IsSameInstance(mockEffects[3].Get(), As<ICanvasImageInternal>(dpiCompensationEffect)->GetD2DImage(f.m_deviceContext.Get()).Get()));
     }
 
+    TEST_METHOD_EX(CanvasEffect_DpiCompensation_IsSharedByEffectsWithTheSameSource)
+    {
+        Fixture f;
+
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+
+        std::vector<ComPtr<MockD2DEffectThatCountsCalls>> mockEffects;
+
+        f.m_deviceContext->CreateEffectMethod.AllowAnyCall(
+            [&](IID const& effectId, ID2D1Effect** effect)
+            {
+                mockEffects.push_back(Make<MockD2DEffectThatCountsCalls>(effectId));
+                return mockEffects.back().CopyTo(effect);
+            });
+
+        const float highDpi = 144;
+        auto highDpiBitmap = CreateStubCanvasBitmap(highDpi);
+
+        const int effectCount = 5;
+        std::vector<ComPtr<TestEffect>> testEffects;
+
+        for (int i = 0; i < effectCount; i++)
+        {
+            testEffects.push_back(Make<TestEffect>(m_blurGuid, 0, 1, true));
+            ThrowIfFailed(testEffects.back()->put_Source(highDpiBitmap.Get()));
+            ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffects.back().Get()));
+        }
+
+        // One blur per effect, plus a single DPI compensation effect that they all share.
+        Assert::AreEqual<size_t>(effectCount + 1, mockEffects.size());
+        CheckEffectTypeAndInput(mockEffects[1].Get(), CLSID_D2D1DpiCompensation, highDpiBitmap.Get(), f.m_deviceContext.Get(), highDpi);
+
+        for (int i = 0; i < effectCount; i++)
+        {
+            auto blur = mockEffects[i == 0 ? 0 : i + 1];
+            CheckEffectTypeAndInput(blur.Get(), m_blurGuid, mockEffects[1].Get());
+        }
+
+        // Pointing one of the effects at a different bitmap must not change
+        // what the others see, so it gets a compensator of its own.
+        auto highDpiBitmap2 = CreateStubCanvasBitmap(highDpi);
+
+        ThrowIfFailed(testEffects[0]->put_Source(highDpiBitmap2.Get()));
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffects[0].Get()));
+
+        Assert::AreEqual<size_t>(effectCount + 2, mockEffects.size());
+        CheckEffectTypeAndInput(mockEffects[0].Get(), m_blurGuid, mockEffects.back().Get());
+        CheckEffectTypeAndInput(mockEffects.back().Get(), CLSID_D2D1DpiCompensation, highDpiBitmap2.Get(), f.m_deviceContext.Get(), highDpi);
+        CheckEffectTypeAndInput(mockEffects[1].Get(), CLSID_D2D1DpiCompensation, highDpiBitmap.Get(), f.m_deviceContext.Get(), highDpi);
+    }
+
+    TEST_METHOD_EX(CanvasEffect_DpiCompensation_IsNotSharedBetweenDevices)
+    {
+        Fixture f;
+
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+
+        int dpiCompensatorCount = 0;
+
+        f.m_deviceContext->CreateEffectMethod.AllowAnyCall(
+            [&](IID const& effectId, ID2D1Effect** effect)
+            {
+                if (IsEqualGUID(effectId, CLSID_D2D1DpiCompensation))
+                    dpiCompensatorCount++;
+
+                return Make<MockD2DEffectThatCountsCalls>(effectId).CopyTo(effect);
+            });
+
+        auto highDpiBitmap = CreateStubCanvasBitmap(144);
+
+        auto firstEffect = Make<TestEffect>(m_blurGuid, 0, 1, true);
+        ThrowIfFailed(firstEffect->put_Source(highDpiBitmap.Get()));
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(firstEffect.Get()));
+
+        // Switch the device context over to a different device.
+        f.m_deviceContext->GetDeviceMethod.AllowAnyCallAlwaysCopyValueToParam(Make<StubD2DDevice>());
+
+        auto secondEffect = Make<TestEffect>(m_blurGuid, 0, 1, true);
+        ThrowIfFailed(secondEffect->put_Source(highDpiBitmap.Get()));
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(secondEffect.Get()));
+
+        Assert::AreEqual(2, dpiCompensatorCount);
+    }
+
     struct CommandListFixture
     {
         ComPtr<StubCanvasDevice> CanvasDevice;
@@ -0,0 +1,393 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "StubD2DResources.h"
+
+static Numerics::Matrix3x2 const c_identity = { 1, 0, 0, 1, 0, 0 };
+
+static ComPtr<ICanvasGeometry> CreateRectangleGeometry(float x, float y, float w, float h)
+{
+    auto factory = Make<CanvasGeometryFactory>();
+
+    ComPtr<ICanvasGeometry> geometry;
+    ThrowIfFailed(factory->CreateRectangle(ABI::Windows::Foundation::Rect{ x, y, w, h }, &geometry));
+
+    return geometry;
+}
+
+static void AssertBoundsAreClose(ABI::Windows::Foundation::Rect const& expected, ICanvasGeometry* geometry)
+{
+    ABI::Windows::Foundation::Rect bounds;
+    ThrowIfFailed(geometry->ComputeBounds(&bounds));
+
+    Assert::AreEqual(expected.X, bounds.X, 0.01f);
+    Assert::AreEqual(expected.Y, bounds.Y, 0.01f);
+    Assert::AreEqual(expected.Width, bounds.Width, 0.01f);
+    Assert::AreEqual(expected.Height, bounds.Height, 0.01f);
+}
+
+TEST_CLASS(CanvasPathBuilderTests)
+{
+    TEST_METHOD_EX(CanvasPathBuilder_Implements_Expected_Interfaces)
+    {
+        auto pathBuilder = Make<CanvasPathBuilder>();
+
+        ASSERT_IMPLEMENTS_INTERFACE(pathBuilder, ICanvasPathBuilder);
+        ASSERT_IMPLEMENTS_INTERFACE(pathBuilder, ABI::Windows::Foundation::IClosable);
+        ASSERT_IMPLEMENTS_INTERFACE(pathBuilder, ICanvasPathBuilderInternal);
+    }
+
+    TEST_METHOD_EX(CanvasPathBuilder_SegmentsOutsideAFigure_FailWithIllegalMethodCall)
+    {
+        auto pathBuilder = Make<CanvasPathBuilder>();
+        Numerics::Vector2 point{ 1, 2 };
+
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, pathBuilder->AddLine(point));
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, pathBuilder->AddQuadraticBezier(point, point));
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, pathBuilder->AddCubicBezier(point, point, point));
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, pathBuilder->EndFigure(CanvasFigureLoop::Open));
+
+        Assert::AreEqual(S_OK, pathBuilder->BeginFigure(point));
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, pathBuilder->BeginFigure(point));
+    }
+
+    TEST_METHOD_EX(CanvasPathBuilder_Closed)
+    {
+        auto pathBuilder = Make<CanvasPathBuilder>();
+        Numerics::Vector2 point{ 1, 2 };
+
+        Assert::AreEqual(S_OK, pathBuilder->Close());
+
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->BeginFigure(point));
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->AddLine(point));
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->AddQuadraticBezier(point, point));
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->AddCubicBezier(point, point, point));
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->EndFigure(CanvasFigureLoop::Closed));
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->SetFilledRegionDetermination(CanvasFilledRegionDetermination::Winding));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_CreatePath_TakesTheFiguresAndClosesTheBuilder)
+    {
+        auto pathBuilder = Make<CanvasPathBuilder>();
+        ThrowIfFailed(pathBuilder->SetFilledRegionDetermination(CanvasFilledRegionDetermination::Winding));
+        ThrowIfFailed(pathBuilder->BeginFigure(Numerics::Vector2{ 0, 0 }));
+        ThrowIfFailed(pathBuilder->AddLine(Numerics::Vector2{ 10, 0 }));
+        ThrowIfFailed(pathBuilder->AddLine(Numerics::Vector2{ 10, 5 }));
+        ThrowIfFailed(pathBuilder->EndFigure(CanvasFigureLoop::Closed));
+
+        auto factory = Make<CanvasGeometryFactory>();
+
+        ComPtr<ICanvasGeometry> geometry;
+        ThrowIfFailed(factory->CreatePath(pathBuilder.Get(), &geometry));
+
+        auto& pathData = As<ICanvasGeometryInternal>(geometry)->GetPathData();
+        Assert::AreEqual(D2D1_FILL_MODE_WINDING, pathData.FillMode);
+        Assert::AreEqual<size_t>(1, pathData.Figures.size());
+        Assert::AreEqual<size_t>(2, pathData.Figures[0].Segments.size());
+        Assert::IsTrue(pathData.Figures[0].IsClosed);
+
+        Assert::AreEqual(RO_E_CLOSED, pathBuilder->AddLine(Numerics::Vector2{ 1, 1 }));
+
+        ComPtr<ICanvasGeometry> secondGeometry;
+        Assert::AreEqual(RO_E_CLOSED, factory->CreatePath(pathBuilder.Get(), &secondGeometry));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_CreatePath_WithAnOpenFigure_Fails)
+    {
+        auto pathBuilder = Make<CanvasPathBuilder>();
+        ThrowIfFailed(pathBuilder->BeginFigure(Numerics::Vector2{ 0, 0 }));
+
+        auto factory = Make<CanvasGeometryFactory>();
+
+        ComPtr<ICanvasGeometry> geometry;
+        Assert::AreEqual(E_ILLEGAL_METHOD_CALL, factory->CreatePath(pathBuilder.Get(), &geometry));
+    }
+};
+
+TEST_CLASS(CanvasGeometryTests)
+{
+    TEST_METHOD_EX(CanvasGeometry_Implements_Expected_Interfaces)
+    {
+        auto geometry = Make<CanvasGeometry>(PathData());
+
+        ASSERT_IMPLEMENTS_INTERFACE(geometry, ICanvasGeometry);
+        ASSERT_IMPLEMENTS_INTERFACE(geometry, ABI::Windows::Foundation::IClosable);
+        ASSERT_IMPLEMENTS_INTERFACE(geometry, ICanvasGeometryInternal);
+    }
+
+    TEST_METHOD_EX(CanvasGeometryFactory_InvalidArgs)
+    {
+        auto factory = Make<CanvasGeometryFactory>();
+        ComPtr<ICanvasGeometry> geometry;
+        Numerics::Vector2 point{ 0, 0 };
+        ABI::Windows::Foundation::Rect rect{ 0, 0, 1, 1 };
+
+        Assert::AreEqual(E_INVALIDARG, factory->CreateRectangle(rect, nullptr));
+        Assert::AreEqual(E_INVALIDARG, factory->CreateRoundedRectangle(rect, 1, 1, nullptr));
+        Assert::AreEqual(E_INVALIDARG, factory->CreateEllipse(point, 1, 1, nullptr));
+        Assert::AreEqual(E_INVALIDARG, factory->CreatePolygon(1, nullptr, &geometry));
+        Assert::AreEqual(E_INVALIDARG, factory->CreatePolygon(1, &point, nullptr));
+        Assert::AreEqual(E_INVALIDARG, factory->CreatePath(nullptr, &geometry));
+    }
+
+    TEST_METHOD_EX(CanvasGeometryFactory_CreatePolygon_WithNoPoints_IsEmpty)
+    {
+        auto factory = Make<CanvasGeometryFactory>();
+
+        ComPtr<ICanvasGeometry> geometry;
+        ThrowIfFailed(factory->CreatePolygon(0, nullptr, &geometry));
+
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 0, 0, 0, 0 }, geometry.Get());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_ComputeBounds)
+    {
+        auto factory = Make<CanvasGeometryFactory>();
+
+        ComPtr<ICanvasGeometry> ellipse;
+        ThrowIfFailed(factory->CreateEllipse(Numerics::Vector2{ 10, 20 }, 5, 3, &ellipse));
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 5, 17, 10, 6 }, ellipse.Get());
+
+        Numerics::Vector2 points[] = { { 1, 1 }, { 4, 2 }, { 2, 6 } };
+        ComPtr<ICanvasGeometry> polygon;
+        ThrowIfFailed(factory->CreatePolygon(_countof(points), points, &polygon));
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 1, 1, 3, 5 }, polygon.Get());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Transform_ReturnsANewGeometry)
+    {
+        auto geometry = CreateRectangleGeometry(0, 0, 10, 20);
+
+        Numerics::Matrix3x2 transform = { 2, 0, 0, 2, 5, 5 };
+
+        ComPtr<ICanvasGeometry> transformed;
+        ThrowIfFailed(geometry->Transform(transform, &transformed));
+
+        Assert::IsFalse(IsSameInstance(geometry.Get(), transformed.Get()));
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 5, 5, 20, 40 }, transformed.Get());
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 0, 0, 10, 20 }, geometry.Get());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_CombineWith)
+    {
+        auto geometry = CreateRectangleGeometry(0, 0, 10, 10);
+        auto other = CreateRectangleGeometry(0, 0, 10, 10);
+
+        Numerics::Matrix3x2 shift = { 1, 0, 0, 1, 5, 0 };
+
+        ComPtr<ICanvasGeometry> combined;
+
+        ThrowIfFailed(geometry->CombineWith(other.Get(), shift, CanvasGeometryCombine::Union, &combined));
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 0, 0, 15, 10 }, combined.Get());
+
+        ThrowIfFailed(geometry->CombineWith(other.Get(), shift, CanvasGeometryCombine::Intersect, &combined));
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 5, 0, 5, 10 }, combined.Get());
+
+        ThrowIfFailed(geometry->CombineWith(other.Get(), shift, CanvasGeometryCombine::Exclude, &combined));
+        AssertBoundsAreClose(ABI::Windows::Foundation::Rect{ 0, 0, 5, 10 }, combined.Get());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_CombineWith_InvalidArgs)
+    {
+        auto geometry = CreateRectangleGeometry(0, 0, 10, 10);
+
+        ComPtr<ICanvasGeometry> combined;
+        Assert::AreEqual(E_INVALIDARG, geometry->CombineWith(nullptr, c_identity, CanvasGeometryCombine::Union, &combined));
+        Assert::AreEqual(E_INVALIDARG, geometry->CombineWith(geometry.Get(), c_identity, CanvasGeometryCombine::Union, nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Closed)
+    {
+        auto geometry = CreateRectangleGeometry(0, 0, 10, 10);
+        auto other = CreateRectangleGeometry(0, 0, 10, 10);
+
+        Assert::AreEqual(S_OK, As<ABI::Windows::Foundation::IClosable>(geometry)->Close());
+
+        ComPtr<ICanvasGeometry> result;
+        ABI::Windows::Foundation::Rect bounds;
+
+        Assert::AreEqual(RO_E_CLOSED, geometry->CombineWith(other.Get(), c_identity, CanvasGeometryCombine::Union, &result));
+        Assert::AreEqual(RO_E_CLOSED, other->CombineWith(geometry.Get(), c_identity, CanvasGeometryCombine::Union, &result));
+        Assert::AreEqual(RO_E_CLOSED, geometry->Transform(c_identity, &result));
+        Assert::AreEqual(RO_E_CLOSED, geometry->ComputeBounds(&bounds));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_GetRealizedD2DGeometry_RealizesOncePerFactory)
+    {
+        auto geometry = CreateRectangleGeometry(0, 0, 10, 10);
+        auto geometryInternal = As<ICanvasGeometryInternal>(geometry);
+
+        auto factory1 = Make<StubD2DFactoryWithCreateStrokeStyle>();
+        auto factory2 = Make<StubD2DFactoryWithCreateStrokeStyle>();
+
+        auto realized1 = geometryInternal->GetRealizedD2DGeometry(factory1.Get());
+        auto realizedAgain = geometryInternal->GetRealizedD2DGeometry(factory1.Get());
+
+        Assert::AreEqual(1, factory1->m_numCallsToCreatePathGeometry);
+        Assert::IsTrue(IsSameInstance(realized1.Get(), realizedAgain.Get()));
+
+        auto realized2 = geometryInternal->GetRealizedD2DGeometry(factory2.Get());
+
+        Assert::AreEqual(1, factory2->m_numCallsToCreatePathGeometry);
+        Assert::IsFalse(IsSameInstance(realized1.Get(), realized2.Get()));
+
+        D2D1_RECT_F bounds;
+        ThrowIfFailed(realized2->GetBounds(nullptr, &bounds));
+        Assert::AreEqual(D2D1::RectF(0, 0, 10, 10), bounds);
+    }
+};
+
+TEST_CLASS(CanvasCachedGeometryTests)
+{
+    class Fixture
+    {
+    public:
+        ComPtr<StubCanvasDevice> Device;
+        ComPtr<StubD2DDeviceContextWithGetFactory> DeviceContext;
+        ComPtr<ICanvasGeometry> Geometry;
+        ComPtr<MockD2DGeometryRealization> GeometryRealization;
+        ComPtr<CanvasCachedGeometryFactory> Factory;
+
+        Fixture()
+            : Device(Make<StubCanvasDevice>())
+            , DeviceContext(Make<StubD2DDeviceContextWithGetFactory>())
+            , Geometry(CreateRectangleGeometry(0, 0, 10, 10))
+            , GeometryRealization(Make<MockD2DGeometryRealization>())
+            , Factory(Make<CanvasCachedGeometryFactory>())
+        {
+            Device->CreateDeviceContextMethod.AllowAnyCall(
+                [=]
+                {
+                    return ComPtr<ID2D1DeviceContext1>(DeviceContext);
+                });
+        }
+    };
+
+    TEST_METHOD_EX(CanvasCachedGeometry_Implements_Expected_Interfaces)
+    {
+        auto cachedGeometry = Make<CanvasCachedGeometry>(Make<StubCanvasDevice>().Get(), Make<MockD2DGeometryRealization>().Get());
+
+        ASSERT_IMPLEMENTS_INTERFACE(cachedGeometry, ICanvasCachedGeometry);
+        ASSERT_IMPLEMENTS_INTERFACE(cachedGeometry, ABI::Windows::Foundation::IClosable);
+        ASSERT_IMPLEMENTS_INTERFACE(cachedGeometry, ICanvasCachedGeometryInternal);
+    }
+
+    TEST_METHOD_EX(CanvasCachedGeometry_CreateFill_RealizesTheGeometryForTheDeviceContext)
+    {
+        Fixture f;
+
+        f.DeviceContext->CreateFilledGeometryRealizationMethod.SetExpectedCalls(1,
+            [&](ID2D1Geometry* geometry, float flatteningTolerance, ID2D1GeometryRealization** geometryRealization)
+            {
+                auto expectedGeometry = As<ICanvasGeometryInternal>(f.Geometry)->GetRealizedD2DGeometry(f.DeviceContext->m_factory.Get());
+                Assert::IsTrue(IsSameInstance(expectedGeometry.Get(), geometry));
+                Assert::AreEqual(0.5f, flatteningTolerance);
+                return f.GeometryRealization.CopyTo(geometryRealization);
+            });
+
+        ComPtr<ICanvasCachedGeometry> cachedGeometry;
+        ThrowIfFailed(f.Factory->CreateFillWithFlatteningTolerance(f.Device.Get(), f.Geometry.Get(), 0.5f, &cachedGeometry));
+
+        auto realization = As<ICanvasCachedGeometryInternal>(cachedGeometry)->GetGeometryRealization();
+        Assert::IsTrue(IsSameInstance(f.GeometryRealization.Get(), realization.Get()));
+
+        ComPtr<ICanvasDevice> device;
+        ThrowIfFailed(cachedGeometry->get_Device(&device));
+        Assert::IsTrue(IsSameInstance(f.Device.Get(), device.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasCachedGeometry_CreateFill_UsesTheDefaultFlatteningTolerance)
+    {
+        Fixture f;
+
+        f.DeviceContext->CreateFilledGeometryRealizationMethod.SetExpectedCalls(1,
+            [&](ID2D1Geometry*, float flatteningTolerance, ID2D1GeometryRealization** geometryRealization)
+            {
+                Assert::AreEqual(D2D1_DEFAULT_FLATTENING_TOLERANCE, flatteningTolerance);
+                return f.GeometryRealization.CopyTo(geometryRealization);
+            });
+
+        ComPtr<ICanvasCachedGeometry> cachedGeometry;
+        ThrowIfFailed(f.Factory->CreateFill(f.Device.Get(), f.Geometry.Get(), &cachedGeometry));
+    }
+
+    TEST_METHOD_EX(CanvasCachedGeometry_CreateStroke_PassesTheStrokeProperties)
+    {
+        Fixture f;
+
+        auto strokeStyle = Make<CanvasStrokeStyle>();
+
+        f.DeviceContext->CreateStrokedGeometryRealizationMethod.SetExpectedCalls(1,
+            [&](ID2D1Geometry* geometry, float flatteningTolerance, float strokeWidth, ID2D1StrokeStyle* d2dStrokeStyle, ID2D1GeometryRealization** geometryRealization)
+            {
+                Assert::IsNotNull(geometry);
+                Assert::AreEqual(0.5f, flatteningTolerance);
+                Assert::AreEqual(3.0f, strokeWidth);
+                Assert::IsNotNull(d2dStrokeStyle);
+                return f.GeometryRealization.CopyTo(geometryRealization);
+            });
+
+        ComPtr<ICanvasCachedGeometry> cachedGeometry;
+        ThrowIfFailed(f.Factory->CreateStrokeWithStrokeStyleAndFlatteningTolerance(
+            f.Device.Get(),
+            f.Geometry.Get(),
+            3.0f,
+            strokeStyle.Get(),
+            0.5f,
+            &cachedGeometry));
+
+        Assert::AreEqual(1, f.DeviceContext->m_factory->m_numCallsToCreateStrokeStyle);
+
+        f.DeviceContext->CreateStrokedGeometryRealizationMethod.SetExpectedCalls(1,
+            [&](ID2D1Geometry*, float flatteningTolerance, float strokeWidth, ID2D1StrokeStyle* d2dStrokeStyle, ID2D1GeometryRealization** geometryRealization)
+            {
+                Assert::AreEqual(D2D1_DEFAULT_FLATTENING_TOLERANCE, flatteningTolerance);
+                Assert::AreEqual(1.0f, strokeWidth);
+                Assert::IsNull(d2dStrokeStyle);
+                return f.GeometryRealization.CopyTo(geometryRealization);
+            });
+
+        ThrowIfFailed(f.Factory->CreateStroke(f.Device.Get(), f.Geometry.Get(), 1.0f, &cachedGeometry));
+    }
+
+    TEST_METHOD_EX(CanvasCachedGeometry_InvalidArgs)
+    {
+        Fixture f;
+        ComPtr<ICanvasCachedGeometry> cachedGeometry;
+
+        Assert::AreEqual(E_INVALIDARG, f.Factory->CreateFill(nullptr, f.Geometry.Get(), &cachedGeometry));
+        Assert::AreEqual(E_INVALIDARG, f.Factory->CreateFill(f.Device.Get(), nullptr, &cachedGeometry));
+        Assert::AreEqual(E_INVALIDARG, f.Factory->CreateFill(f.Device.Get(), f.Geometry.Get(), nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.Factory->CreateStroke(nullptr, f.Geometry.Get(), 1, &cachedGeometry));
+        Assert::AreEqual(E_INVALIDARG, f.Factory->CreateStroke(f.Device.Get(), nullptr, 1, &cachedGeometry));
+        Assert::AreEqual(E_INVALIDARG, f.Factory->CreateStroke(f.Device.Get(), f.Geometry.Get(), 1, nullptr));
+
+        for (float tolerance : { 0.0f, -1.0f, std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN() })
+        {
+            Assert::AreEqual(E_INVALIDARG, f.Factory->CreateFillWithFlatteningTolerance(f.Device.Get(), f.Geometry.Get(), tolerance, &cachedGeometry));
+            Assert::AreEqual(E_INVALIDARG, f.Factory->CreateStrokeWithStrokeStyleAndFlatteningTolerance(f.Device.Get(), f.Geometry.Get(), 1, nullptr, tolerance, &cachedGeometry));
+        }
+    }
+
+    TEST_METHOD_EX(CanvasCachedGeometry_Closed)
+    {
+        auto cachedGeometry = Make<CanvasCachedGeometry>(Make<StubCanvasDevice>().Get(), Make<MockD2DGeometryRealization>().Get());
+
+        Assert::AreEqual(S_OK, cachedGeometry->Close());
+
+        ComPtr<ICanvasDevice> device;
+        Assert::AreEqual(RO_E_CLOSED, cachedGeometry->get_Device(&device));
+
+        ExpectHResultException(RO_E_CLOSED, [&] { cachedGeometry->GetGeometryRealization(); });
+    }
+};
@@ -613,3 +613,66 @@ public:
             });
     }
 };
+
+TEST_CLASS(CanvasImageSourceDrawingSessionFactoryTests)
+{
+    static ComPtr<MockSurfaceImageSource> MakeSurfaceImageSource(ComPtr<MockD2DDeviceContext> const& deviceContext)
+    {
+        auto surfaceImageSource = Make<MockSurfaceImageSource>();
+
+        surfaceImageSource->BeginDrawMethod.AllowAnyCall(
+            [=](RECT const&, IID const& iid, void** updateObject, POINT*)
+            {
+                return deviceContext.CopyTo(iid, updateObject);
+            });
+
+        deviceContext->ClearMethod.AllowAnyCall();
+        deviceContext->SetTransformMethod.AllowAnyCall();
+        deviceContext->SetDpiMethod.AllowAnyCall();
+
+        return surfaceImageSource;
+    }
+
+    TEST_METHOD_EX(CanvasImageSourceDrawingSessionFactory_TryReopen_DrawsOntoTheNewSurface)
+    {
+        CanvasImageSourceDrawingSessionFactory factory;
+
+        auto firstDeviceContext = Make<MockD2DDeviceContext>();
+        auto firstSurfaceImageSource = MakeSurfaceImageSource(firstDeviceContext);
+        firstSurfaceImageSource->EndDrawMethod.SetExpectedCalls(1);
+
+        auto drawingSession = factory.Create(nullptr, firstSurfaceImageSource.Get(), Color{}, RECT{ 0, 0, 1, 1 }, DEFAULT_DPI);
+        ThrowIfFailed(As<IClosable>(drawingSession)->Close());
+
+        auto secondDeviceContext = Make<MockD2DDeviceContext>();
+        auto secondSurfaceImageSource = MakeSurfaceImageSource(secondDeviceContext);
+
+        Assert::IsTrue(factory.TryReopen(drawingSession.Get(), nullptr, secondSurfaceImageSource.Get(), Color{}, RECT{ 0, 0, 1, 1 }, DEFAULT_DPI));
+
+        Color expectedColor{ 1, 2, 3, 4 };
+
+        firstDeviceContext->ClearMethod.SetExpectedCalls(0);
+        secondDeviceContext->ClearMethod.SetExpectedCalls(1,
+            [&](D2D1_COLOR_F const* color)
+            {
+                Assert::AreEqual(ToD2DColor(expectedColor), *color);
+            });
+
+        ThrowIfFailed(drawingSession->Clear(expectedColor));
+
+        secondSurfaceImageSource->EndDrawMethod.SetExpectedCalls(1);
+        ThrowIfFailed(As<IClosable>(drawingSession)->Close());
+    }
+
+    TEST_METHOD_EX(CanvasImageSourceDrawingSessionFactory_TryReopen_WhenDrawingSessionIsNotOurs_ReturnsFalseWithoutBeginningDraw)
+    {
+        CanvasImageSourceDrawingSessionFactory factory;
+
+        auto surfaceImageSource = Make<MockSurfaceImageSource>();
+        surfaceImageSource->BeginDrawMethod.SetExpectedCalls(0);
+
+        auto otherDrawingSession = Make<MockCanvasDrawingSession>();
+
+        Assert::IsFalse(factory.TryReopen(otherDrawingSession.Get(), nullptr, surfaceImageSource.Get(), Color{}, RECT{ 0, 0, 1, 1 }, DEFAULT_DPI));
+    }
+};
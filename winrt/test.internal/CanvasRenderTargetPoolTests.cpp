@@ -0,0 +1,312 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "TestBitmapResourceCreationAdapter.h"
+
+TEST_CLASS(CanvasRenderTargetPoolTests)
+{
+    struct Fixture
+    {
+        std::shared_ptr<PolymorphicBitmapManager> m_manager;
+        ComPtr<StubCanvasDevice> m_canvasDevice;
+        int m_createdBitmapCount;
+
+        Fixture()
+            : m_manager(std::make_shared<PolymorphicBitmapManager>(std::make_shared<TestBitmapResourceCreationAdapter>()))
+            , m_canvasDevice(MakeDevice())
+            , m_createdBitmapCount(0)
+        {
+        }
+
+        ComPtr<StubCanvasDevice> MakeDevice()
+        {
+            auto canvasDevice = Make<StubCanvasDevice>();
+
+            canvasDevice->MockCreateRenderTargetBitmap =
+                [=](float, float, DirectXPixelFormat, CanvasAlphaMode, float dpi)
+                {
+                    m_createdBitmapCount++;
+                    return Make<StubD2DBitmap>(D2D1_BITMAP_OPTIONS_TARGET, dpi);
+                };
+
+            return canvasDevice;
+        }
+
+        ComPtr<CanvasRenderTarget> CreatePooled(
+            float width = 16,
+            float height = 16,
+            DirectXPixelFormat format = DirectXPixelFormat::B8G8R8A8UIntNormalized,
+            CanvasAlphaMode alpha = CanvasAlphaMode::Premultiplied,
+            float dpi = DEFAULT_DPI,
+            ICanvasDevice* device = nullptr)
+        {
+            return m_manager->CreatePooledRenderTarget(device ? device : m_canvasDevice.Get(), width, height, format, alpha, dpi);
+        }
+
+        CanvasRenderTargetPool& Pool()
+        {
+            return m_manager->GetRenderTargetPool();
+        }
+
+        uint64_t PooledBytes()
+        {
+            return Pool().GetPooledBytes(m_canvasDevice.Get());
+        }
+    };
+
+    static ComPtr<ID2D1Bitmap1> GetBitmap(ComPtr<CanvasRenderTarget> const& renderTarget)
+    {
+        return GetWrappedResource<ID2D1Bitmap1>(renderTarget);
+    }
+
+    static void Close(ComPtr<CanvasRenderTarget> const& renderTarget)
+    {
+        ThrowIfFailed(As<IClosable>(renderTarget)->Close());
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_ClosedRenderTarget_IsReusedForTheSameKey)
+    {
+        Fixture f;
+
+        auto first = f.CreatePooled();
+        auto firstBitmap = GetBitmap(first);
+        Close(first);
+
+        auto second = f.CreatePooled();
+
+        Assert::AreEqual(1, f.m_createdBitmapCount);
+        Assert::IsTrue(IsSameInstance(firstBitmap.Get(), GetBitmap(second).Get()));
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_RenderTargetsInUse_AreNotShared)
+    {
+        Fixture f;
+
+        auto first = f.CreatePooled();
+        auto second = f.CreatePooled();
+
+        Assert::AreEqual(2, f.m_createdBitmapCount);
+        Assert::IsFalse(IsSameInstance(GetBitmap(first).Get(), GetBitmap(second).Get()));
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_DifferentSizeFormatAlphaOrDpi_UseSeparateBuckets)
+    {
+        Fixture f;
+
+        Close(f.CreatePooled());
+
+        f.CreatePooled(32, 16);
+        f.CreatePooled(16, 32);
+        f.CreatePooled(16, 16, DirectXPixelFormat::R8G8B8A8UIntNormalized);
+        f.CreatePooled(16, 16, DirectXPixelFormat::B8G8R8A8UIntNormalized, CanvasAlphaMode::Ignore);
+        f.CreatePooled(16, 16, DirectXPixelFormat::B8G8R8A8UIntNormalized, CanvasAlphaMode::Premultiplied, 2 * DEFAULT_DPI);
+
+        Assert::AreEqual(6, f.m_createdBitmapCount);
+
+        f.CreatePooled();
+
+        Assert::AreEqual(6, f.m_createdBitmapCount);
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_SizesThatRoundToTheSamePixels_ShareABucket)
+    {
+        Fixture f;
+
+        Close(f.CreatePooled(16.2f, 16));
+        f.CreatePooled(15.8f, 16);
+
+        Assert::AreEqual(1, f.m_createdBitmapCount);
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_ReleasedWithoutClose_IsReturned)
+    {
+        Fixture f;
+
+        ComPtr<ID2D1Bitmap1> firstBitmap;
+
+        {
+            auto first = f.CreatePooled();
+            firstBitmap = GetBitmap(first);
+        }
+
+        auto second = f.CreatePooled();
+
+        Assert::AreEqual(1, f.m_createdBitmapCount);
+        Assert::IsTrue(IsSameInstance(firstBitmap.Get(), GetBitmap(second).Get()));
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_ClosingTwice_ReturnsOnce)
+    {
+        Fixture f;
+
+        auto renderTarget = f.CreatePooled();
+        Close(renderTarget);
+        Close(renderTarget);
+
+        f.CreatePooled();
+        f.CreatePooled();
+
+        Assert::AreEqual(2, f.m_createdBitmapCount);
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_ReusedRenderTarget_CanBeWrappedAgain)
+    {
+        Fixture f;
+
+        Close(f.CreatePooled());
+
+        auto renderTarget = f.CreatePooled();
+        auto wrapped = f.m_manager->GetOrCreateRenderTarget(f.m_canvasDevice.Get(), GetBitmap(renderTarget).Get());
+
+        Assert::IsTrue(IsSameInstance(renderTarget.Get(), wrapped.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_NonPooledRenderTargets_AreNotReturned)
+    {
+        Fixture f;
+
+        auto renderTarget = f.m_manager->CreateRenderTarget(
+            f.m_canvasDevice.Get(), 16.0f, 16.0f, DirectXPixelFormat::B8G8R8A8UIntNormalized, CanvasAlphaMode::Premultiplied, DEFAULT_DPI);
+
+        Close(renderTarget);
+
+        Assert::AreEqual<uint64_t>(0, f.PooledBytes());
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_PooledBytes_CountsIdleBitmapsInPixels)
+    {
+        Fixture f;
+
+        auto a = f.CreatePooled(10, 20);
+        auto b = f.CreatePooled(10, 20, DirectXPixelFormat::B8G8R8A8UIntNormalized, CanvasAlphaMode::Premultiplied, 2 * DEFAULT_DPI);
+
+        Assert::AreEqual<uint64_t>(0, f.PooledBytes());
+
+        Close(a);
+        Assert::AreEqual<uint64_t>(10 * 20 * 4, f.PooledBytes());
+
+        Close(b);
+        Assert::AreEqual<uint64_t>(10 * 20 * 4 + 20 * 40 * 4, f.PooledBytes());
+
+        f.CreatePooled(10, 20);
+        Assert::AreEqual<uint64_t>(20 * 40 * 4, f.PooledBytes());
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_IdleBitmaps_AreReleasedAfterIdleFrameLimit)
+    {
+        Fixture f;
+
+        Assert::AreEqual(CanvasRenderTargetPool::DefaultIdleFrameLimit, f.Pool().GetIdleFrameLimit());
+
+        f.Pool().SetIdleFrameLimit(2);
+
+        Close(f.CreatePooled());
+
+        f.Pool().EndFrame(f.m_canvasDevice.Get());
+        f.Pool().EndFrame(f.m_canvasDevice.Get());
+        Assert::IsTrue(f.PooledBytes() > 0);
+
+        f.Pool().EndFrame(f.m_canvasDevice.Get());
+        Assert::AreEqual<uint64_t>(0, f.PooledBytes());
+
+        f.CreatePooled();
+        Assert::AreEqual(2, f.m_createdBitmapCount);
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_ReuseResetsTheIdleCount)
+    {
+        Fixture f;
+
+        f.Pool().SetIdleFrameLimit(1);
+
+        Close(f.CreatePooled());
+        f.Pool().EndFrame(f.m_canvasDevice.Get());
+
+        Close(f.CreatePooled());
+        f.Pool().EndFrame(f.m_canvasDevice.Get());
+
+        Assert::IsTrue(f.PooledBytes() > 0);
+        Assert::AreEqual(1, f.m_createdBitmapCount);
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_Trim_ReleasesAllIdleBitmaps)
+    {
+        Fixture f;
+
+        Close(f.CreatePooled(16, 16));
+        Close(f.CreatePooled(32, 32));
+
+        f.Pool().Trim(f.m_canvasDevice.Get());
+
+        Assert::AreEqual<uint64_t>(0, f.PooledBytes());
+
+        f.CreatePooled(16, 16);
+        Assert::AreEqual(3, f.m_createdBitmapCount);
+    }
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_EachDeviceHasItsOwnPool)
+    {
+        Fixture f;
+        auto otherDevice = f.MakeDevice();
+
+        Close(f.CreatePooled());
+
+        f.CreatePooled(16, 16, DirectXPixelFormat::B8G8R8A8UIntNormalized, CanvasAlphaMode::Premultiplied, DEFAULT_DPI, otherDevice.Get());
+        Assert::AreEqual(2, f.m_createdBitmapCount);
+
+        f.Pool().Trim(otherDevice.Get());
+        f.Pool().EndFrame(otherDevice.Get());
+        Assert::IsTrue(f.PooledBytes() > 0);
+    }
+
+    class TrackedD2DBitmap : public StubD2DBitmap
+    {
+        bool* m_destroyed;
+
+    public:
+        TrackedD2DBitmap(bool* destroyed)
+            : StubD2DBitmap(D2D1_BITMAP_OPTIONS_TARGET)
+            , m_destroyed(destroyed)
+        {
+        }
+
+        ~TrackedD2DBitmap()
+        {
+            *m_destroyed = true;
+        }
+    };
+
+    TEST_METHOD_EX(CanvasRenderTargetPool_WhenDeviceIsReleased_ItsBitmapsAreReleasedOnNextUse)
+    {
+        Fixture f;
+
+        bool destroyed = false;
+
+        auto otherDevice = Make<StubCanvasDevice>();
+        otherDevice->MockCreateRenderTargetBitmap =
+            [&](float, float, DirectXPixelFormat, CanvasAlphaMode, float)
+            {
+                return Make<TrackedD2DBitmap>(&destroyed);
+            };
+
+        Close(f.CreatePooled(16, 16, DirectXPixelFormat::B8G8R8A8UIntNormalized, CanvasAlphaMode::Premultiplied, DEFAULT_DPI, otherDevice.Get()));
+
+        otherDevice.Reset();
+        Assert::IsFalse(destroyed);
+
+        // Any use of the pool, even for a different device, releases them.
+        f.CreatePooled();
+        Assert::IsTrue(destroyed);
+    }
+};
@@ -367,4 +367,83 @@ public:
             [&]{ canvasStrokeStyle->put_CustomDashStyle(0, NULL); });
     }
 
+    TEST_METHOD(CanvasStrokeStyle_StrokeStylesWithTheSameProperties_ShareARealization)
+    {
+        auto testFactory = Make<StubD2DFactoryWithCreateStrokeStyle>();
+
+        auto canvasStrokeStyle0 = Make<CanvasStrokeStyle>();
+        auto canvasStrokeStyle1 = Make<CanvasStrokeStyle>();
+
+        float customDashPattern[2] = { 1, 2 };
+        ThrowIfFailed(canvasStrokeStyle0->put_CustomDashStyle(2, customDashPattern));
+        ThrowIfFailed(canvasStrokeStyle1->put_CustomDashStyle(2, customDashPattern));
+
+        auto realizedD2DStrokeStyle0 = canvasStrokeStyle0->GetRealizedD2DStrokeStyle(testFactory.Get());
+        auto realizedD2DStrokeStyle1 = canvasStrokeStyle1->GetRealizedD2DStrokeStyle(testFactory.Get());
+
+        Assert::AreEqual(1, testFactory->m_numCallsToCreateStrokeStyle);
+        Assert::AreEqual(realizedD2DStrokeStyle0.Get(), realizedD2DStrokeStyle1.Get());
+
+        // Different dashes must not be confused with these ones
+        float otherDashPattern[2] = { 2, 1 };
+        ThrowIfFailed(canvasStrokeStyle1->put_CustomDashStyle(2, otherDashPattern));
+
+        realizedD2DStrokeStyle1 = canvasStrokeStyle1->GetRealizedD2DStrokeStyle(testFactory.Get());
+
+        Assert::AreEqual(2, testFactory->m_numCallsToCreateStrokeStyle);
+        Assert::AreNotEqual(realizedD2DStrokeStyle0.Get(), realizedD2DStrokeStyle1.Get());
+
+        // Switching back picks up the realization that is still in use
+        ThrowIfFailed(canvasStrokeStyle1->put_CustomDashStyle(2, customDashPattern));
+
+        realizedD2DStrokeStyle1 = canvasStrokeStyle1->GetRealizedD2DStrokeStyle(testFactory.Get());
+
+        Assert::AreEqual(2, testFactory->m_numCallsToCreateStrokeStyle);
+        Assert::AreEqual(realizedD2DStrokeStyle0.Get(), realizedD2DStrokeStyle1.Get());
+    }
+
+    TEST_METHOD(CanvasStrokeStyle_RealizationsAreNotSharedBetweenFactories)
+    {
+        auto testFactory0 = Make<StubD2DFactoryWithCreateStrokeStyle>();
+        auto testFactory1 = Make<StubD2DFactoryWithCreateStrokeStyle>();
+
+        auto canvasStrokeStyle0 = Make<CanvasStrokeStyle>();
+        auto canvasStrokeStyle1 = Make<CanvasStrokeStyle>();
+
+        auto realizedD2DStrokeStyle0 = canvasStrokeStyle0->GetRealizedD2DStrokeStyle(testFactory0.Get());
+        auto realizedD2DStrokeStyle1 = canvasStrokeStyle1->GetRealizedD2DStrokeStyle(testFactory1.Get());
+
+        Assert::AreEqual(1, testFactory0->m_numCallsToCreateStrokeStyle);
+        Assert::AreEqual(1, testFactory1->m_numCallsToCreateStrokeStyle);
+        Assert::AreNotEqual(realizedD2DStrokeStyle0.Get(), realizedD2DStrokeStyle1.Get());
+    }
+
+    TEST_METHOD(CanvasStrokeStyle_SwitchingBetweenFactories_DoesNotRealizeAgain)
+    {
+        auto testFactory0 = Make<StubD2DFactoryWithCreateStrokeStyle>();
+        auto testFactory1 = Make<StubD2DFactoryWithCreateStrokeStyle>();
+
+        auto canvasStrokeStyle = Make<CanvasStrokeStyle>();
+
+        auto realizedD2DStrokeStyle0 = canvasStrokeStyle->GetRealizedD2DStrokeStyle(testFactory0.Get());
+        auto realizedD2DStrokeStyle1 = canvasStrokeStyle->GetRealizedD2DStrokeStyle(testFactory1.Get());
+
+        for (int i = 0; i < 3; ++i)
+        {
+            Assert::AreEqual(realizedD2DStrokeStyle0.Get(), canvasStrokeStyle->GetRealizedD2DStrokeStyle(testFactory0.Get()).Get());
+            Assert::AreEqual(realizedD2DStrokeStyle1.Get(), canvasStrokeStyle->GetRealizedD2DStrokeStyle(testFactory1.Get()).Get());
+        }
+
+        Assert::AreEqual(1, testFactory0->m_numCallsToCreateStrokeStyle);
+        Assert::AreEqual(1, testFactory1->m_numCallsToCreateStrokeStyle);
+
+        // Changing a property invalidates the realizations for every factory
+        ThrowIfFailed(canvasStrokeStyle->put_LineJoin(CanvasLineJoin::Round));
+
+        canvasStrokeStyle->GetRealizedD2DStrokeStyle(testFactory0.Get());
+        canvasStrokeStyle->GetRealizedD2DStrokeStyle(testFactory1.Get());
+
+        Assert::AreEqual(2, testFactory0->m_numCallsToCreateStrokeStyle);
+        Assert::AreEqual(2, testFactory1->m_numCallsToCreateStrokeStyle);
+    }
 };
@@ -223,6 +223,28 @@ TEST_CLASS(CanvasSwapChainUnitTests)
         Assert::AreEqual(E_INVALIDARG, canvasSwapChain->get_BufferCount(nullptr));
         Assert::AreEqual(E_INVALIDARG, canvasSwapChain->get_AlphaMode(nullptr));
         Assert::AreEqual(E_INVALIDARG, canvasSwapChain->get_Device(nullptr));
+        Assert::AreEqual(E_INVALIDARG, canvasSwapChain->get_IsDrawingStatisticsEnabled(nullptr));
+        Assert::AreEqual(E_INVALIDARG, canvasSwapChain->get_DrawingStatistics(nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasSwapChain_DrawingStatistics)
+    {
+        StubDeviceFixture f;
+
+        auto canvasSwapChain = f.CreateTestSwapChain();
+
+        boolean isEnabled = true;
+        ThrowIfFailed(canvasSwapChain->get_IsDrawingStatisticsEnabled(&isEnabled));
+        Assert::IsFalse(!!isEnabled);
+
+        ThrowIfFailed(canvasSwapChain->put_IsDrawingStatisticsEnabled(true));
+        ThrowIfFailed(canvasSwapChain->get_IsDrawingStatisticsEnabled(&isEnabled));
+        Assert::IsTrue(!!isEnabled);
+
+        // Nothing has been presented yet.
+        ComPtr<ICanvasDrawingStatistics> statistics;
+        ThrowIfFailed(canvasSwapChain->get_DrawingStatistics(&statistics));
+        Assert::IsNull(statistics.Get());
     }
 
     void ResetForPropertyTest(ComPtr<MockDxgiSwapChain>& swapChain)
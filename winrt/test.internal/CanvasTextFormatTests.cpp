@@ -653,6 +653,60 @@ namespace canvas
                 Options,
                 static_cast<CanvasDrawTextOptions>(999));
         }
+
+        TEST_METHOD(CanvasTextFormat_InternedFormat_IsSharedByFormatsWithTheSameProperties)
+        {
+            auto ctf1 = Make<CanvasTextFormat>();
+            auto ctf2 = Make<CanvasTextFormat>();
+
+            ThrowIfFailed(ctf1->put_FontSize(33.0f));
+            ThrowIfFailed(ctf2->put_FontSize(33.0f));
+
+            auto dwf = ctf1->GetInternedTextFormat();
+
+            Assert::AreEqual(dwf.Get(), ctf2->GetInternedTextFormat().Get());
+            Assert::AreEqual(33.0f, dwf->GetFontSize());
+        }
+
+        TEST_METHOD(CanvasTextFormat_InternedFormat_IsReplacedWhenAPropertyChanges)
+        {
+            auto ctf1 = Make<CanvasTextFormat>();
+            auto ctf2 = Make<CanvasTextFormat>();
+
+            auto original = ctf1->GetInternedTextFormat();
+            Assert::AreEqual(original.Get(), ctf2->GetInternedTextFormat().Get());
+
+            ThrowIfFailed(ctf1->put_WordWrapping(CanvasWordWrapping::NoWrap));
+
+            auto changed = ctf1->GetInternedTextFormat();
+            Assert::AreNotEqual(original.Get(), changed.Get());
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_NO_WRAP, changed->GetWordWrapping());
+
+            // The other format, and the interned format it shares, are unaffected
+            Assert::AreEqual(original.Get(), ctf2->GetInternedTextFormat().Get());
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_WRAP, original->GetWordWrapping());
+
+            // Setting a property to its current value keeps the interned format
+            ThrowIfFailed(ctf1->put_WordWrapping(CanvasWordWrapping::NoWrap));
+            Assert::AreEqual(changed.Get(), ctf1->GetInternedTextFormat().Get());
+        }
+
+        TEST_METHOD(CanvasTextFormat_InternedFormat_IsNotUsedOnceRealized)
+        {
+            auto ctf1 = Make<CanvasTextFormat>();
+            auto ctf2 = Make<CanvasTextFormat>();
+
+            auto interned = ctf1->GetInternedTextFormat();
+            auto realized = ctf1->GetRealizedTextFormat();
+
+            // The realized format can be modified, so it is never shared
+            Assert::AreNotEqual(interned.Get(), realized.Get());
+            Assert::AreEqual(realized.Get(), ctf1->GetInternedTextFormat().Get());
+            Assert::AreEqual(interned.Get(), ctf2->GetInternedTextFormat().Get());
+
+            auto wrapped = Make<CanvasTextFormat>(realized.Get());
+            Assert::AreEqual(realized.Get(), wrapped->GetInternedTextFormat().Get());
+        }
     };
 
 #undef TEST_SIMPLE_PROPERTY
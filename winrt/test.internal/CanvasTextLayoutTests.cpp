@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(CanvasTextLayoutTests)
+{
+    static ComPtr<ICanvasTextLayout> CreateLayout(
+        wchar_t const* text,
+        ICanvasTextFormat* format,
+        float requestedWidth = 1000,
+        float requestedHeight = 1000)
+    {
+        auto factory = Make<CanvasTextLayoutFactory>();
+
+        ComPtr<ICanvasTextLayout> textLayout;
+        ThrowIfFailed(factory->Create(WinString(text), format, requestedWidth, requestedHeight, &textLayout));
+
+        return textLayout;
+    }
+
+    static ShapedText const& GetShapedText(ComPtr<ICanvasTextLayout> const& textLayout)
+    {
+        return As<ICanvasTextLayoutInternal>(textLayout)->GetShapedText();
+    }
+
+    static size_t GetGlyphCount(ShapedText const& shapedText)
+    {
+        size_t glyphCount = 0;
+
+        for (auto& run : shapedText.Runs)
+            glyphCount += run.GlyphIndices.size();
+
+        return glyphCount;
+    }
+
+    static std::shared_ptr<DigitGlyphTable> GetDigitGlyphTable(ComPtr<CanvasTextFormat> const& format)
+    {
+        return As<ICanvasTextFormatInternal>(format)->GetDigitGlyphTable();
+    }
+
+    TEST_METHOD_EX(CanvasTextLayout_Implements_Expected_Interfaces)
+    {
+        auto textLayout = CreateLayout(L"Hello", Make<CanvasTextFormat>().Get());
+
+        ASSERT_IMPLEMENTS_INTERFACE(textLayout, ICanvasTextLayout);
+        ASSERT_IMPLEMENTS_INTERFACE(textLayout, ABI::Windows::Foundation::IClosable);
+    }
+
+    TEST_METHOD_EX(CanvasTextLayout_Create_CapturesGlyphRunsForTheText)
+    {
+        auto textLayout = CreateLayout(L"Hello", Make<CanvasTextFormat>().Get());
+
+        auto& shapedText = GetShapedText(textLayout);
+
+        Assert::AreEqual<size_t>(5, GetGlyphCount(shapedText));
+
+        for (auto& run : shapedText.Runs)
+        {
+            Assert::IsNotNull(run.FontFace.Get());
+            Assert::AreEqual(run.GlyphIndices.size(), run.GlyphAdvances.size());
+            Assert::AreEqual(run.GlyphIndices.size(), run.GlyphOffsets.size());
+        }
+
+        WinString text;
+        ThrowIfFailed(textLayout->get_Text(text.GetAddressOf()));
+        Assert::AreEqual(L"Hello", static_cast<wchar_t const*>(text));
+
+        Rect bounds;
+        ThrowIfFailed(textLayout->get_LayoutBounds(&bounds));
+        Assert::IsTrue(bounds.Width > 0);
+        Assert::IsTrue(bounds.Height > 0);
+    }
+
+    TEST_METHOD_EX(CanvasTextLayout_Create_InvalidArgs)
+    {
+        auto factory = Make<CanvasTextLayoutFactory>();
+        auto format = Make<CanvasTextFormat>();
+
+        ComPtr<ICanvasTextLayout> textLayout;
+
+        Assert::AreEqual(E_INVALIDARG, factory->Create(WinString(L"x"), nullptr, 1, 1, &textLayout));
+        Assert::AreEqual(E_INVALIDARG, factory->Create(WinString(L"x"), format.Get(), 1, 1, nullptr));
+        Assert::AreEqual(E_INVALIDARG, factory->Create(WinString(L"x"), format.Get(), -1, 1, &textLayout));
+        Assert::AreEqual(E_INVALIDARG, factory->Create(WinString(L"x"), format.Get(), 1, -1, &textLayout));
+        Assert::AreEqual(E_INVALIDARG, factory->Create(WinString(L"x"), format.Get(), NAN, 1, &textLayout));
+        Assert::AreEqual(E_INVALIDARG, factory->Create(WinString(L"x"), format.Get(), 1, NAN, &textLayout));
+    }
+
+    TEST_METHOD_EX(CanvasTextLayout_Closed)
+    {
+        auto textLayout = CreateLayout(L"Hello", Make<CanvasTextFormat>().Get());
+
+        ThrowIfFailed(As<ABI::Windows::Foundation::IClosable>(textLayout)->Close());
+
+        WinString text;
+        Rect bounds;
+
+        Assert::AreEqual(RO_E_CLOSED, textLayout->get_Text(text.GetAddressOf()));
+        Assert::AreEqual(RO_E_CLOSED, textLayout->get_LayoutBounds(&bounds));
+
+        ExpectHResultException(RO_E_CLOSED, [&] { GetShapedText(textLayout); });
+    }
+
+    TEST_METHOD_EX(DigitGlyphTable_IsDigitString)
+    {
+        Assert::IsTrue(DigitGlyphTable::IsDigitString(L"123", 3));
+        Assert::IsTrue(DigitGlyphTable::IsDigitString(L"-1,234.5%", 9));
+        Assert::IsTrue(DigitGlyphTable::IsDigitString(L"12:30", 5));
+
+        Assert::IsFalse(DigitGlyphTable::IsDigitString(L"", 0));
+        Assert::IsFalse(DigitGlyphTable::IsDigitString(L"12a", 3));
+        Assert::IsFalse(DigitGlyphTable::IsDigitString(L"1 2", 3));
+    }
+
+    TEST_METHOD_EX(DigitGlyphTable_ComposedText_MatchesShapedText)
+    {
+        auto format = Make<CanvasTextFormat>();
+        auto digitGlyphs = GetDigitGlyphTable(format);
+
+        Assert::IsTrue(!!digitGlyphs);
+
+        wchar_t const* text = L"9876543210";
+        uint32_t textLength = static_cast<uint32_t>(wcslen(text));
+
+        ShapedText composed;
+        Assert::IsTrue(digitGlyphs->TryCompose(text, textLength, 1000, &composed));
+
+        ComPtr<IDWriteFactory> dwriteFactory;
+        ThrowIfFailed(DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory), static_cast<IUnknown**>(&dwriteFactory)));
+
+        auto shaped = ShapeText(
+            dwriteFactory.Get(),
+            format->GetInternedTextFormat().Get(),
+            text,
+            textLength,
+            1000,
+            1000);
+
+        Assert::AreEqual<size_t>(1, composed.Runs.size());
+        Assert::AreEqual<size_t>(1, shaped.Runs.size());
+
+        auto& composedRun = composed.Runs[0];
+        auto& shapedRun = shaped.Runs[0];
+
+        Assert::AreEqual(shapedRun.GlyphIndices.size(), composedRun.GlyphIndices.size());
+        Assert::AreEqual(shapedRun.FontEmSize, composedRun.FontEmSize);
+        Assert::AreEqual(shapedRun.BaselineOrigin, composedRun.BaselineOrigin);
+
+        for (size_t i = 0; i < shapedRun.GlyphIndices.size(); i++)
+        {
+            Assert::AreEqual<int>(shapedRun.GlyphIndices[i], composedRun.GlyphIndices[i]);
+            Assert::AreEqual(shapedRun.GlyphAdvances[i], composedRun.GlyphAdvances[i], 0.001f);
+        }
+    }
+
+    TEST_METHOD_EX(DigitGlyphTable_IsSharedByFormatsWithTheSameProperties)
+    {
+        auto format1 = Make<CanvasTextFormat>();
+        auto format2 = Make<CanvasTextFormat>();
+
+        Assert::IsTrue(GetDigitGlyphTable(format1) == GetDigitGlyphTable(format2));
+    }
+
+    TEST_METHOD_EX(DigitGlyphTable_IsNotCreatedForFormatsItCannotLayOut)
+    {
+        auto centered = Make<CanvasTextFormat>();
+        ThrowIfFailed(centered->put_ParagraphAlignment(ABI::Windows::UI::Text::ParagraphAlignment_Center));
+
+        Assert::IsFalse(!!GetDigitGlyphTable(centered));
+
+        // Realized formats may be changed through interop behind our back.
+        auto realized = Make<CanvasTextFormat>();
+        realized->GetRealizedTextFormat();
+
+        Assert::IsFalse(!!GetDigitGlyphTable(realized));
+    }
+
+    TEST_METHOD_EX(DigitGlyphTable_TryCompose_FailsWhenTheTextWouldWrap)
+    {
+        auto wrapping = Make<CanvasTextFormat>();
+        auto noWrap = Make<CanvasTextFormat>();
+        ThrowIfFailed(noWrap->put_WordWrapping(CanvasWordWrapping::NoWrap));
+
+        ShapedText shapedText;
+
+        Assert::IsFalse(GetDigitGlyphTable(wrapping)->TryCompose(L"123", 3, 1, &shapedText));
+        Assert::IsTrue(GetDigitGlyphTable(noWrap)->TryCompose(L"123", 3, 1, &shapedText));
+
+        Assert::IsFalse(GetDigitGlyphTable(noWrap)->TryCompose(L"12a", 3, 1000, &shapedText));
+    }
+
+    TEST_METHOD_EX(CanvasTextLayout_DigitStrings_UseTheDigitGlyphTable)
+    {
+        auto format = Make<CanvasTextFormat>();
+
+        auto textLayout = CreateLayout(L"-1,234.5%", format.Get());
+        auto& shapedText = GetShapedText(textLayout);
+
+        ShapedText composed;
+        Assert::IsTrue(GetDigitGlyphTable(format)->TryCompose(L"-1,234.5%", 9, 1000, &composed));
+
+        Assert::AreEqual<size_t>(1, shapedText.Runs.size());
+        Assert::IsTrue(composed.Runs[0].GlyphIndices == shapedText.Runs[0].GlyphIndices);
+    }
+};
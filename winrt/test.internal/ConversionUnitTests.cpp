@@ -206,4 +206,43 @@ TEST_CLASS(ConversionUnitTests)
         Assert::AreEqual(23.0f * 3 / 2, PixelsToDips(23, 64));
         Assert::AreEqual(1234.0f * 3 / 2, PixelsToDips(1234, 64));
     }
+
+    static void AssertSizeToFit(uint32_t expectedWidth, uint32_t expectedHeight, BitmapSize size, BitmapSize maxSize)
+    {
+        auto result = GetSizeToFit(size, maxSize);
+
+        Assert::AreEqual(expectedWidth, result.Width);
+        Assert::AreEqual(expectedHeight, result.Height);
+    }
+
+    TEST_METHOD(SizeToFit)
+    {
+        // Sizes that already fit are unchanged, and never scaled up.
+        AssertSizeToFit(100, 50, BitmapSize{ 100, 50 }, BitmapSize{ 100, 50 });
+        AssertSizeToFit(10, 5, BitmapSize{ 10, 5 }, BitmapSize{ 100, 100 });
+
+        // Aspect ratio is preserved, limited by whichever dimension is tighter.
+        AssertSizeToFit(100, 50, BitmapSize{ 400, 200 }, BitmapSize{ 100, 100 });
+        AssertSizeToFit(50, 100, BitmapSize{ 200, 400 }, BitmapSize{ 100, 100 });
+        AssertSizeToFit(64, 48, BitmapSize{ 4000, 3000 }, BitmapSize{ 64, 64 });
+        AssertSizeToFit(100, 67, BitmapSize{ 3000, 2000 }, BitmapSize{ 100, 200 });
+
+        // Very thin images keep at least one pixel.
+        AssertSizeToFit(100, 1, BitmapSize{ 10000, 1 }, BitmapSize{ 100, 100 });
+
+        ExpectHResultException(E_INVALIDARG, [] { GetSizeToFit(BitmapSize{ 10, 10 }, BitmapSize{ 0, 10 }); });
+        ExpectHResultException(E_INVALIDARG, [] { GetSizeToFit(BitmapSize{ 10, 10 }, BitmapSize{ 10, 0 }); });
+    }
+
+    TEST_METHOD(CanvasImageInterpolationToWICInterpolationMode)
+    {
+        Assert::AreEqual<int>(WICBitmapInterpolationModeNearestNeighbor, ToWICInterpolationMode(CanvasImageInterpolation::NearestNeighbor));
+        Assert::AreEqual<int>(WICBitmapInterpolationModeLinear, ToWICInterpolationMode(CanvasImageInterpolation::Linear));
+        Assert::AreEqual<int>(WICBitmapInterpolationModeCubic, ToWICInterpolationMode(CanvasImageInterpolation::Cubic));
+        Assert::AreEqual<int>(WICBitmapInterpolationModeFant, ToWICInterpolationMode(CanvasImageInterpolation::MultiSampleLinear));
+        Assert::AreEqual<int>(WICBitmapInterpolationModeFant, ToWICInterpolationMode(CanvasImageInterpolation::Anisotropic));
+        Assert::AreEqual<int>(WICBitmapInterpolationModeFant, ToWICInterpolationMode(CanvasImageInterpolation::HighQualityCubic));
+
+        ExpectHResultException(E_INVALIDARG, [] { ToWICInterpolationMode(static_cast<CanvasImageInterpolation>(99)); });
+    }
 };
@@ -160,6 +160,8 @@ namespace Microsoft
             TO_STRING(IDXGISurface);
             TO_STRING(IDXGISwapChain);
             TO_STRING(ICanvasSwapChain);
+            TO_STRING(ID2D1Geometry);
+            TO_STRING(ID2D1GeometryRealization);
 
 #undef TO_STRING
 
@@ -316,7 +318,7 @@ namespace Microsoft
                 ThrowIfFailed(StringCchPrintf(
                     buf,
                     _countof(buf),
-                    L"D2D1_RECT_U{l=%f,t=%f,r=%f,b=%f}",
+                    L"D2D1_RECT_U{l=%u,t=%u,r=%u,b=%u}",
                     value.left, value.top, value.right, value.bottom));
 
                 return buf;
@@ -404,6 +406,13 @@ namespace Microsoft
                 END_ENUM(D2D1_STROKE_TRANSFORM_TYPE_HAIRLINE);
             }
 
+            ENUM_TO_STRING(D2D1_FILL_MODE)
+            {
+                ENUM_VALUE(D2D1_FILL_MODE_ALTERNATE);
+                ENUM_VALUE(D2D1_FILL_MODE_WINDING);
+                END_ENUM(D2D1_FILL_MODE);
+            }
+
             template<>
             static inline std::wstring ToString<__int64>(__int64 const& value)
             {
@@ -566,6 +575,14 @@ namespace Microsoft
                 END_ENUM(DWRITE_WORD_WRAPPING);
             }
 
+            ENUM_TO_STRING(DWRITE_MEASURING_MODE)
+            {
+                ENUM_VALUE(DWRITE_MEASURING_MODE_NATURAL);
+                ENUM_VALUE(DWRITE_MEASURING_MODE_GDI_CLASSIC);
+                ENUM_VALUE(DWRITE_MEASURING_MODE_GDI_NATURAL);
+                END_ENUM(DWRITE_MEASURING_MODE);
+            }
+
             ENUM_TO_STRING(D2D1_ANTIALIAS_MODE)
             {
                 ENUM_VALUE(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
@@ -846,6 +863,11 @@ inline bool operator==(D2D1_POINT_2U const& a, D2D1_POINT_2U const& b)
     return a.x == b.x && a.y == b.y;
 }
 
+inline bool operator==(D2D1_RECT_U const& a, D2D1_RECT_U const& b)
+{
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
 #define ASSERT_IMPLEMENTS_INTERFACE(obj, INTERFACE)                     \
     {                                                                   \
         ComPtr<INTERFACE> iface;                                        \
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <deque>
+
+//
+// An IAsyncScheduler that holds on to work until the test asks for it to be
+// run, on the test's own thread. Higher priority work runs first, and work
+// of the same priority runs in the order it was scheduled.
+//
+class ManualAsyncScheduler : public IAsyncScheduler
+{
+    struct WorkItem
+    {
+        AsyncWorkOptions Options;
+        std::function<void()> Work;
+    };
+
+    std::mutex m_mutex;
+    std::deque<WorkItem> m_pending;
+
+public:
+    virtual void Schedule(AsyncWorkOptions const& options, std::function<void()>&& work) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        WorkItem item = { options, std::move(work) };
+        m_pending.push_back(std::move(item));
+    }
+
+    size_t GetPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    size_t GetPendingCount(AsyncWorkQueue queue)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::count_if(m_pending.begin(), m_pending.end(),
+            [=](WorkItem const& item) { return item.Options.Queue == queue; });
+    }
+
+    // Runs the most urgent pending work item. Returns false if there was nothing to run.
+    bool RunNext()
+    {
+        return RunNextMatching([](WorkItem const&) { return true; });
+    }
+
+    // Runs the most urgent pending work item from one queue, leaving the other alone.
+    bool RunNext(AsyncWorkQueue queue)
+    {
+        return RunNextMatching([=](WorkItem const& item) { return item.Options.Queue == queue; });
+    }
+
+    // Runs work until there is none left, including any scheduled along the way.
+    void RunAll()
+    {
+        while (RunNext())
+        {
+        }
+    }
+
+private:
+    template<typename TPredicate>
+    bool RunNextMatching(TPredicate&& matches)
+    {
+        std::function<void()> work;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto best = m_pending.end();
+
+            for (auto it = m_pending.begin(); it != m_pending.end(); ++it)
+            {
+                if (matches(*it) && (best == m_pending.end() || it->Options.Priority > best->Options.Priority))
+                    best = it;
+            }
+
+            if (best == m_pending.end())
+                return false;
+
+            work = std::move(best->Work);
+            m_pending.erase(best);
+        }
+
+        // Run without holding the lock, as the work may schedule more work.
+        work();
+
+        return true;
+    }
+};
@@ -60,6 +60,10 @@ namespace canvas
         DONT_EXPECT(DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation               , ICanvasBitmap*, Rect, Rect, float, CanvasImageInterpolation);
         DONT_EXPECT(DrawBitmapWithDestRectAndSourceRectAndOpacityAndInterpolationAndPerspective , ICanvasBitmap*, Rect, Rect, float, CanvasImageInterpolation, Matrix4x4);
 
+        DONT_EXPECT(DrawVirtualBitmapWithDestRect                                       , ICanvasVirtualBitmap*, Rect);
+        DONT_EXPECT(DrawVirtualBitmapWithDestRectAndSourceRect                          , ICanvasVirtualBitmap*, Rect, Rect);
+        DONT_EXPECT(DrawVirtualBitmapWithDestRectAndSourceRectAndOpacityAndInterpolation, ICanvasVirtualBitmap*, Rect, Rect, float, CanvasImageInterpolation);
+
         DONT_EXPECT(DrawLineWithBrush                                     , Vector2, Vector2, ICanvasBrush*);
         DONT_EXPECT(DrawLineAtCoordsWithBrush                             , float, float, float, float, ICanvasBrush*);
         DONT_EXPECT(DrawLineWithColor                                     , Vector2, Vector2, Color);
@@ -156,6 +160,28 @@ namespace canvas
         DONT_EXPECT(DrawTextAtPointCoordsWithColorAndFormat , HSTRING, float, float, Color, ICanvasTextFormat*);
         DONT_EXPECT(DrawTextAtRectCoordsWithColorAndFormat  , HSTRING, float, float, float, float, Color, ICanvasTextFormat*);
 
+        DONT_EXPECT(DrawTextLayoutWithBrush                 , ICanvasTextLayout*, Vector2, ICanvasBrush*);
+        DONT_EXPECT(DrawTextLayoutWithColor                 , ICanvasTextLayout*, Vector2, Color);
+
+        DONT_EXPECT(FillGeometryWithBrush                                , ICanvasGeometry*, ICanvasBrush*);
+        DONT_EXPECT(FillGeometryWithColor                                , ICanvasGeometry*, Color);
+        DONT_EXPECT(DrawGeometryWithBrush                                , ICanvasGeometry*, ICanvasBrush*);
+        DONT_EXPECT(DrawGeometryWithColor                                , ICanvasGeometry*, Color);
+        DONT_EXPECT(DrawGeometryWithBrushAndStrokeWidth                  , ICanvasGeometry*, ICanvasBrush*, float);
+        DONT_EXPECT(DrawGeometryWithColorAndStrokeWidth                  , ICanvasGeometry*, Color, float);
+        DONT_EXPECT(DrawGeometryWithBrushAndStrokeWidthAndStrokeStyle    , ICanvasGeometry*, ICanvasBrush*, float, ICanvasStrokeStyle*);
+        DONT_EXPECT(DrawGeometryWithColorAndStrokeWidthAndStrokeStyle    , ICanvasGeometry*, Color, float, ICanvasStrokeStyle*);
+
+        DONT_EXPECT(DrawCachedGeometryWithBrush             , ICanvasCachedGeometry*, Vector2, ICanvasBrush*);
+        DONT_EXPECT(DrawCachedGeometryWithColor             , ICanvasCachedGeometry*, Vector2, Color);
+
+        DONT_EXPECT(DrawPolylineWithBrush                             , uint32_t, Vector2*, ICanvasBrush*);
+        DONT_EXPECT(DrawPolylineWithColor                             , uint32_t, Vector2*, Color);
+        DONT_EXPECT(DrawPolylineWithBrushAndStrokeWidth               , uint32_t, Vector2*, ICanvasBrush*, float);
+        DONT_EXPECT(DrawPolylineWithColorAndStrokeWidth               , uint32_t, Vector2*, Color, float);
+        DONT_EXPECT(DrawPolylineWithBrushAndStrokeWidthAndStrokeStyle , uint32_t, Vector2*, ICanvasBrush*, float, ICanvasStrokeStyle*);
+        DONT_EXPECT(DrawPolylineWithColorAndStrokeWidthAndStrokeStyle , uint32_t, Vector2*, Color, float, ICanvasStrokeStyle*);
+
         DONT_EXPECT(get_Antialiasing     , CanvasAntialiasing*);
         DONT_EXPECT(put_Antialiasing     , CanvasAntialiasing);
         DONT_EXPECT(get_Blend            , CanvasBlend*);
@@ -28,5 +28,18 @@ namespace canvas
         {
             return CreateMethod.WasCalled(owner, sisNative, clearColor, updateRectangle, dpi);
         }
+
+        CALL_COUNTER_WITH_MOCK(TryReopenMethod, bool(ICanvasDrawingSession*, ICanvasDevice*, ISurfaceImageSourceNativeWithD2D*, Color const&, RECT const&, float));
+
+        virtual bool TryReopen(
+            ICanvasDrawingSession* closedDrawingSession,
+            ICanvasDevice* owner,
+            ISurfaceImageSourceNativeWithD2D* sisNative,
+            Color const& clearColor,
+            RECT const& updateRectangle,
+            float dpi) const override
+        {
+            return TryReopenMethod.WasCalled(closedDrawingSession, owner, sisNative, clearColor, updateRectangle, dpi);
+        }
     };
 }
@@ -116,6 +116,24 @@ namespace canvas
             return E_NOTIMPL;
         }
 
+        IFACEMETHOD(put_IsDrawingStatisticsEnabled)(boolean value) override
+        {
+            Assert::Fail(L"Unexpected call to put_IsDrawingStatisticsEnabled");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHOD(get_IsDrawingStatisticsEnabled)(boolean* value) override
+        {
+            Assert::Fail(L"Unexpected call to get_IsDrawingStatisticsEnabled");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHOD(get_DrawingStatistics)(ICanvasDrawingStatistics** value) override
+        {
+            Assert::Fail(L"Unexpected call to get_DrawingStatistics");
+            return E_NOTIMPL;
+        }
+
         IFACEMETHOD(Present)() override
         {
             Assert::Fail(L"Unexpected call to Present");
@@ -44,7 +44,13 @@ namespace canvas
         CALL_COUNTER_WITH_MOCK(FillRoundedRectangleMethod  , void(D2D1_ROUNDED_RECT const*,ID2D1Brush*));
         CALL_COUNTER_WITH_MOCK(DrawEllipseMethod           , void(D2D1_ELLIPSE const*,ID2D1Brush*,float,ID2D1StrokeStyle*));
         CALL_COUNTER_WITH_MOCK(FillEllipseMethod           , void(D2D1_ELLIPSE const*,ID2D1Brush*));
+        CALL_COUNTER_WITH_MOCK(DrawGeometryMethod          , void(ID2D1Geometry*,ID2D1Brush*,float,ID2D1StrokeStyle*));
+        CALL_COUNTER_WITH_MOCK(FillGeometryMethod          , void(ID2D1Geometry*,ID2D1Brush*,ID2D1Brush*));
+        CALL_COUNTER_WITH_MOCK(CreateFilledGeometryRealizationMethod , HRESULT(ID2D1Geometry*,float,ID2D1GeometryRealization**));
+        CALL_COUNTER_WITH_MOCK(CreateStrokedGeometryRealizationMethod, HRESULT(ID2D1Geometry*,float,float,ID2D1StrokeStyle*,ID2D1GeometryRealization**));
+        CALL_COUNTER_WITH_MOCK(DrawGeometryRealizationMethod , void(ID2D1GeometryRealization*,ID2D1Brush*));
         CALL_COUNTER_WITH_MOCK(DrawTextMethod              , void(wchar_t const*,uint32_t,IDWriteTextFormat*,D2D1_RECT_F const*,ID2D1Brush*,D2D1_DRAW_TEXT_OPTIONS,DWRITE_MEASURING_MODE));
+        CALL_COUNTER_WITH_MOCK(DrawGlyphRunMethod          , void(D2D1_POINT_2F,DWRITE_GLYPH_RUN const*,ID2D1Brush*,DWRITE_MEASURING_MODE));
         CALL_COUNTER_WITH_MOCK(DrawImageMethod             , void(ID2D1Image*, D2D1_POINT_2F const*, D2D1_RECT_F const*, D2D1_INTERPOLATION_MODE, D2D1_COMPOSITE_MODE));
         CALL_COUNTER_WITH_MOCK(DrawBitmapMethod            , void(ID2D1Bitmap*, D2D1_RECT_F const*, FLOAT, D2D1_INTERPOLATION_MODE, D2D1_RECT_F const*, D2D1_MATRIX_4X4_F const*));
         CALL_COUNTER_WITH_MOCK(GetDeviceMethod             , void(ID2D1Device**));
@@ -185,14 +191,14 @@ namespace canvas
             FillEllipseMethod.WasCalled(ellipse, brush);
         }
 
-        IFACEMETHODIMP_(void) DrawGeometry(ID2D1Geometry *,ID2D1Brush *,FLOAT,ID2D1StrokeStyle *) override
+        IFACEMETHODIMP_(void) DrawGeometry(ID2D1Geometry* geometry, ID2D1Brush* brush, float strokeWidth, ID2D1StrokeStyle* strokeStyle) override
         {
-            Assert::Fail(L"Unexpected call to DrawGeometry");
+            DrawGeometryMethod.WasCalled(geometry, brush, strokeWidth, strokeStyle);
         }
 
-        IFACEMETHODIMP_(void) FillGeometry(ID2D1Geometry *,ID2D1Brush *,ID2D1Brush *) override
+        IFACEMETHODIMP_(void) FillGeometry(ID2D1Geometry* geometry, ID2D1Brush* brush, ID2D1Brush* opacityBrush) override
         {
-            Assert::Fail(L"Unexpected call to FillGeometry");
+            FillGeometryMethod.WasCalled(geometry, brush, opacityBrush);
         }
 
         IFACEMETHODIMP_(void) FillMesh(ID2D1Mesh *,ID2D1Brush *) override
@@ -221,9 +227,9 @@ namespace canvas
             Assert::Fail(L"Unexpected call to DrawTextLayout");
         }
 
-        IFACEMETHODIMP_(void) DrawGlyphRun(D2D1_POINT_2F,const DWRITE_GLYPH_RUN *,ID2D1Brush *,DWRITE_MEASURING_MODE) override
+        IFACEMETHODIMP_(void) DrawGlyphRun(D2D1_POINT_2F baselineOrigin, const DWRITE_GLYPH_RUN* glyphRun, ID2D1Brush* brush, DWRITE_MEASURING_MODE measuringMode) override
         {
-            Assert::Fail(L"Unexpected call to DrawGlyphRun");
+            DrawGlyphRunMethod.WasCalled(baselineOrigin, glyphRun, brush, measuringMode);
         }
 
         IFACEMETHODIMP_(void) DrawImage(_In_ ID2D1Image *image, _In_opt_ CONST D2D1_POINT_2F *targetOffset, _In_opt_ CONST D2D1_RECT_F *imageRectangle,
@@ -566,21 +572,19 @@ namespace canvas
 
         // ID2D1DeviceContext1
 
-        IFACEMETHODIMP CreateFilledGeometryRealization(ID2D1Geometry *,FLOAT,ID2D1GeometryRealization **) override
+        IFACEMETHODIMP CreateFilledGeometryRealization(ID2D1Geometry* geometry, FLOAT flatteningTolerance, ID2D1GeometryRealization** geometryRealization) override
         {
-            Assert::Fail(L"Unexpected call to CreateFilledGeometryRealization");
-            return E_NOTIMPL;
+            return CreateFilledGeometryRealizationMethod.WasCalled(geometry, flatteningTolerance, geometryRealization);
         }
 
-        IFACEMETHODIMP CreateStrokedGeometryRealization(ID2D1Geometry *,FLOAT,FLOAT,ID2D1StrokeStyle *,ID2D1GeometryRealization **) override
+        IFACEMETHODIMP CreateStrokedGeometryRealization(ID2D1Geometry* geometry, FLOAT flatteningTolerance, FLOAT strokeWidth, ID2D1StrokeStyle* strokeStyle, ID2D1GeometryRealization** geometryRealization) override
         {
-            Assert::Fail(L"Unexpected call to CreateStrokedGeometryRealization");
-            return E_NOTIMPL;
+            return CreateStrokedGeometryRealizationMethod.WasCalled(geometry, flatteningTolerance, strokeWidth, strokeStyle, geometryRealization);
         }
 
-        IFACEMETHODIMP_(void) DrawGeometryRealization(ID2D1GeometryRealization *,ID2D1Brush *) override
+        IFACEMETHODIMP_(void) DrawGeometryRealization(ID2D1GeometryRealization* geometryRealization, ID2D1Brush* brush) override
         {
-            Assert::Fail(L"Unexpected call to DrawGeometryRealization");
+            DrawGeometryRealizationMethod.WasCalled(geometryRealization, brush);
         }
     };
 }
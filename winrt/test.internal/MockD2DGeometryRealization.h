@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace canvas
+{
+    class MockD2DGeometryRealization : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        ChainInterfaces<ID2D1GeometryRealization, ID2D1Resource>>
+    {
+    public:
+
+        //
+        // ID2D1Resource
+        //
+
+        IFACEMETHODIMP_(void) GetFactory(ID2D1Factory **factory) const override
+        {
+            Assert::Fail(L"Unexpected call to GetFactory");
+        }
+    };
+}
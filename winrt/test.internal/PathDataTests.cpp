@@ -0,0 +1,274 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(PathDataTests)
+{
+    static void AssertRectsAreClose(D2D1_RECT_F const& expected, D2D1_RECT_F const& actual, float tolerance = 0.001f)
+    {
+        Assert::AreEqual(expected.left, actual.left, tolerance);
+        Assert::AreEqual(expected.top, actual.top, tolerance);
+        Assert::AreEqual(expected.right, actual.right, tolerance);
+        Assert::AreEqual(expected.bottom, actual.bottom, tolerance);
+    }
+
+    static float Distance(D2D1_POINT_2F const& a, D2D1_POINT_2F const& b)
+    {
+        return sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+    }
+
+    TEST_METHOD_EX(PathData_CreateRectangle)
+    {
+        auto rect = D2D1::RectF(1, 2, 11, 22);
+        auto pathData = PathData::CreateRectangle(rect);
+
+        Assert::AreEqual<size_t>(1, pathData.Figures.size());
+
+        auto& figure = pathData.Figures[0];
+        Assert::IsTrue(figure.IsClosed);
+        Assert::AreEqual(D2D1::Point2F(1, 2), figure.StartPoint);
+        Assert::AreEqual<size_t>(3, figure.Segments.size());
+
+        for (auto& segment : figure.Segments)
+            Assert::IsTrue(segment.Type == PathSegmentType::Line);
+
+        AssertRectsAreClose(rect, pathData.ComputeBounds());
+    }
+
+    TEST_METHOD_EX(PathData_CreateRoundedRectangle_ClampsRadiiToTheRectangle)
+    {
+        auto rect = D2D1::RectF(0, 0, 10, 20);
+        auto pathData = PathData::CreateRoundedRectangle(rect, 100, 100);
+
+        Assert::AreEqual<size_t>(8, pathData.Figures[0].Segments.size());
+        AssertRectsAreClose(rect, pathData.ComputeBounds());
+    }
+
+    TEST_METHOD_EX(PathData_CreateRoundedRectangle_WithZeroRadius_IsARectangle)
+    {
+        auto pathData = PathData::CreateRoundedRectangle(D2D1::RectF(0, 0, 10, 20), 0, 5);
+
+        Assert::AreEqual<size_t>(3, pathData.Figures[0].Segments.size());
+    }
+
+    TEST_METHOD_EX(PathData_CreateEllipse)
+    {
+        auto pathData = PathData::CreateEllipse(D2D1::Point2F(10, 20), 5, 3);
+
+        auto& figure = pathData.Figures[0];
+        Assert::IsTrue(figure.IsClosed);
+        Assert::AreEqual<size_t>(4, figure.Segments.size());
+
+        for (auto& segment : figure.Segments)
+            Assert::IsTrue(segment.Type == PathSegmentType::CubicBezier);
+
+        AssertRectsAreClose(D2D1::RectF(5, 17, 15, 23), pathData.ComputeBounds());
+    }
+
+    TEST_METHOD_EX(PathData_CreatePolygon)
+    {
+        Assert::IsTrue(PathData::CreatePolygon(nullptr, 0).IsEmpty());
+
+        D2D1_POINT_2F points[] = { { 0, 0 }, { 10, 0 }, { 5, 8 } };
+        auto pathData = PathData::CreatePolygon(points, _countof(points));
+
+        auto& figure = pathData.Figures[0];
+        Assert::IsTrue(figure.IsClosed);
+        Assert::AreEqual(points[0], figure.StartPoint);
+        Assert::AreEqual<size_t>(2, figure.Segments.size());
+        Assert::AreEqual(points[2], figure.Segments[1].GetEndPoint());
+    }
+
+    TEST_METHOD_EX(PathData_ComputeBounds_IncludesCurveExtremaButNotControlPoints)
+    {
+        PathBuilder builder;
+        builder.BeginFigure(D2D1::Point2F(0, 0));
+        builder.AddCubicBezier(D2D1::Point2F(0, 10), D2D1::Point2F(10, 10), D2D1::Point2F(10, 0));
+        builder.AddQuadraticBezier(D2D1::Point2F(15, -10), D2D1::Point2F(20, 0));
+        builder.EndFigure(false);
+
+        auto pathData = builder.TakePathData();
+
+        // The cubic peaks at y = 7.5, the quadratic dips to y = -5.
+        AssertRectsAreClose(D2D1::RectF(0, -5, 20, 7.5f), pathData.ComputeBounds());
+    }
+
+    TEST_METHOD_EX(PathData_ComputeBounds_WhenEmpty_ReturnsAnEmptyRectangle)
+    {
+        auto bounds = PathData().ComputeBounds();
+
+        Assert::IsTrue(bounds.left > bounds.right);
+        Assert::IsTrue(bounds.top > bounds.bottom);
+    }
+
+    TEST_METHOD_EX(PathData_Transform_MapsEveryPoint)
+    {
+        auto pathData = PathData::CreateEllipse(D2D1::Point2F(0, 0), 1, 1);
+
+        auto transform = D2D1::Matrix3x2F::Scale(2, 3) * D2D1::Matrix3x2F::Translation(10, 20);
+        auto transformed = pathData.Transform(transform);
+
+        AssertRectsAreClose(D2D1::RectF(8, 17, 12, 23), transformed.ComputeBounds());
+
+        // The original is not changed.
+        AssertRectsAreClose(D2D1::RectF(-1, -1, 1, 1), pathData.ComputeBounds());
+    }
+
+    TEST_METHOD_EX(PathData_Flatten_LeavesLinesAloneAndClosesClosedFigures)
+    {
+        auto polylines = PathData::CreateRectangle(D2D1::RectF(0, 0, 10, 20)).Flatten(0.25f);
+
+        Assert::AreEqual<size_t>(1, polylines.size());
+
+        auto& polyline = polylines[0];
+        Assert::AreEqual<size_t>(5, polyline.size());
+        Assert::AreEqual(D2D1::Point2F(0, 0), polyline.front());
+        Assert::AreEqual(D2D1::Point2F(0, 0), polyline.back());
+    }
+
+    TEST_METHOD_EX(PathData_Flatten_QuadraticBezier_StaysWithinTolerance)
+    {
+        // x = 100t and y = 200t(1 - t), so the curve is y = 2x(1 - x/100).
+        PathBuilder builder;
+        builder.BeginFigure(D2D1::Point2F(0, 0));
+        builder.AddQuadraticBezier(D2D1::Point2F(50, 100), D2D1::Point2F(100, 0));
+        builder.EndFigure(false);
+
+        float const tolerance = 0.25f;
+        auto polyline = builder.TakePathData().Flatten(tolerance)[0];
+
+        Assert::IsTrue(polyline.size() > 2);
+        Assert::AreEqual(D2D1::Point2F(100, 0), polyline.back());
+
+        for (size_t i = 1; i < polyline.size(); i++)
+        {
+            auto midX = (polyline[i - 1].x + polyline[i].x) / 2;
+            auto midY = (polyline[i - 1].y + polyline[i].y) / 2;
+            auto curveY = 2 * midX * (1 - midX / 100);
+
+            Assert::IsTrue(fabsf(curveY - midY) <= tolerance);
+        }
+    }
+
+    TEST_METHOD_EX(PathData_Flatten_Ellipse_StaysWithinTolerance)
+    {
+        float const radius = 100;
+        auto center = D2D1::Point2F(50, 50);
+        auto pathData = PathData::CreateEllipse(center, radius, radius);
+
+        // The cubic approximation of a circle is itself off by up to 0.03%.
+        float const approximationError = radius * 0.0003f;
+
+        for (float tolerance : { 1.0f, 0.25f, 0.01f })
+        {
+            auto polyline = pathData.Flatten(tolerance)[0];
+
+            for (size_t i = 1; i < polyline.size(); i++)
+            {
+                auto mid = D2D1::Point2F(
+                    (polyline[i - 1].x + polyline[i].x) / 2,
+                    (polyline[i - 1].y + polyline[i].y) / 2);
+
+                Assert::IsTrue(radius - Distance(center, mid) <= tolerance + approximationError);
+            }
+        }
+    }
+
+    TEST_METHOD_EX(PathData_Flatten_FinerToleranceGivesMorePoints)
+    {
+        auto pathData = PathData::CreateEllipse(D2D1::Point2F(0, 0), 100, 100);
+
+        auto coarse = pathData.Flatten(1.0f)[0].size();
+        auto fine = pathData.Flatten(0.01f)[0].size();
+
+        Assert::IsTrue(coarse > 5);
+        Assert::IsTrue(fine > coarse);
+    }
+
+    TEST_METHOD_EX(PathData_StreamTo_RoundTripsThroughD2D)
+    {
+        ComPtr<ID2D1Factory> d2dFactory;
+        ThrowIfFailed(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, d2dFactory.GetAddressOf()));
+
+        PathBuilder builder;
+        builder.SetFillMode(D2D1_FILL_MODE_WINDING);
+        builder.BeginFigure(D2D1::Point2F(1, 2));
+        builder.AddLine(D2D1::Point2F(3, 4));
+        builder.AddCubicBezier(D2D1::Point2F(5, 6), D2D1::Point2F(7, 8), D2D1::Point2F(9, 10));
+        builder.EndFigure(true);
+        builder.BeginFigure(D2D1::Point2F(20, 20));
+        builder.AddLine(D2D1::Point2F(30, 20));
+        builder.EndFigure(false);
+
+        auto pathData = builder.TakePathData();
+        auto pathGeometry = CreateD2DPathGeometry(d2dFactory.Get(), pathData);
+
+        auto sink = Make<PathDataSink>();
+        ThrowIfFailed(pathGeometry->Simplify(
+            D2D1_GEOMETRY_SIMPLIFICATION_OPTION_CUBICS_AND_LINES,
+            nullptr,
+            D2D1_DEFAULT_FLATTENING_TOLERANCE,
+            sink.Get()));
+        ThrowIfFailed(sink->Close());
+
+        auto roundTripped = sink->GetPathData();
+
+        Assert::AreEqual(D2D1_FILL_MODE_WINDING, roundTripped.FillMode);
+        Assert::AreEqual<size_t>(2, roundTripped.Figures.size());
+
+        Assert::IsTrue(roundTripped.Figures[0].IsClosed);
+        Assert::AreEqual(D2D1::Point2F(1, 2), roundTripped.Figures[0].StartPoint);
+        Assert::AreEqual<size_t>(2, roundTripped.Figures[0].Segments.size());
+        Assert::IsTrue(roundTripped.Figures[0].Segments[1].Type == PathSegmentType::CubicBezier);
+        Assert::AreEqual(D2D1::Point2F(9, 10), roundTripped.Figures[0].Segments[1].GetEndPoint());
+
+        Assert::IsFalse(roundTripped.Figures[1].IsClosed);
+        Assert::AreEqual(D2D1::Point2F(30, 20), roundTripped.Figures[1].Segments[0].GetEndPoint());
+    }
+};
+
+
+TEST_CLASS(PathBuilderTests)
+{
+    TEST_METHOD_EX(PathBuilder_SegmentsOutsideAFigure_Throw)
+    {
+        PathBuilder builder;
+
+        ExpectHResultException(E_ILLEGAL_METHOD_CALL, [&] { builder.AddLine(D2D1::Point2F(1, 1)); });
+        ExpectHResultException(E_ILLEGAL_METHOD_CALL, [&] { builder.EndFigure(true); });
+
+        builder.BeginFigure(D2D1::Point2F(0, 0));
+
+        ExpectHResultException(E_ILLEGAL_METHOD_CALL, [&] { builder.BeginFigure(D2D1::Point2F(0, 0)); });
+        ExpectHResultException(E_ILLEGAL_METHOD_CALL, [&] { builder.TakePathData(); });
+    }
+
+    TEST_METHOD_EX(PathBuilder_TakePathData_LeavesTheBuilderEmpty)
+    {
+        PathBuilder builder;
+        builder.SetFillMode(D2D1_FILL_MODE_WINDING);
+        builder.BeginFigure(D2D1::Point2F(0, 0));
+        builder.AddLine(D2D1::Point2F(1, 1));
+        builder.EndFigure(true);
+
+        auto pathData = builder.TakePathData();
+
+        Assert::AreEqual<size_t>(1, pathData.Figures.size());
+        Assert::AreEqual(D2D1_FILL_MODE_WINDING, pathData.FillMode);
+
+        auto empty = builder.TakePathData();
+
+        Assert::IsTrue(empty.IsEmpty());
+        Assert::AreEqual(D2D1_FILL_MODE_ALTERNATE, empty.FillMode);
+    }
+};
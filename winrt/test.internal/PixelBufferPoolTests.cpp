@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(PixelBufferPoolTests)
+{
+    TEST_METHOD_EX(PixelBufferPool_ZeroMaxPooled_Throws)
+    {
+        ExpectHResultException(E_INVALIDARG, [] { PixelBufferPool pool(0); });
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_Acquire_ReturnsBufferOfRequestedSize)
+    {
+        auto pool = std::make_shared<PixelBufferPool>();
+
+        auto buffer = pool->Acquire(3, 5, 16);
+
+        Assert::AreEqual(3u, buffer->GetWidth());
+        Assert::AreEqual(5u, buffer->GetHeight());
+        Assert::AreEqual(16u, buffer->GetStride());
+        Assert::AreEqual(80u, buffer->GetSize());
+        Assert::IsNotNull(buffer->GetData());
+
+        Assert::AreEqual(1u, pool->GetOutstandingCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_ReleasedBuffersAreReused)
+    {
+        auto pool = std::make_shared<PixelBufferPool>();
+
+        BYTE* firstData;
+
+        {
+            auto buffer = pool->Acquire(4, 4, 16);
+            firstData = buffer->GetData();
+        }
+
+        Assert::AreEqual(0u, pool->GetOutstandingCount());
+        Assert::AreEqual(1u, pool->GetPooledCount());
+
+        // A smaller request fits in the memory that was released.
+        auto buffer = pool->Acquire(2, 2, 8);
+
+        Assert::IsTrue(firstData == buffer->GetData());
+        Assert::AreEqual(32u, buffer->GetSize());
+        Assert::AreEqual(0u, pool->GetPooledCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_Acquire_PrefersPooledBufferThatIsBigEnough)
+    {
+        auto pool = std::make_shared<PixelBufferPool>();
+
+        BYTE* bigData;
+
+        {
+            auto small = pool->Acquire(1, 1, 4);
+            auto big = pool->Acquire(100, 100, 400);
+            bigData = big->GetData();
+        }
+
+        Assert::AreEqual(2u, pool->GetPooledCount());
+
+        auto buffer = pool->Acquire(100, 100, 400);
+
+        Assert::IsTrue(bigData == buffer->GetData());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_WhenAllBuffersAreOutstanding_AcquireAllocatesWithoutWaiting)
+    {
+        auto pool = std::make_shared<PixelBufferPool>(2);
+
+        auto buffer1 = pool->Acquire(1, 1, 4);
+        auto buffer2 = pool->Acquire(1, 1, 4);
+        auto buffer3 = pool->Acquire(1, 1, 4);
+
+        Assert::AreEqual(3u, pool->GetOutstandingCount());
+        Assert::IsFalse(buffer1->GetData() == buffer3->GetData());
+        Assert::IsFalse(buffer2->GetData() == buffer3->GetData());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_BuffersBeyondMaxPooled_AreFreedOnRelease)
+    {
+        auto pool = std::make_shared<PixelBufferPool>(2);
+
+        {
+            auto buffer1 = pool->Acquire(1, 1, 4);
+            auto buffer2 = pool->Acquire(1, 1, 4);
+            auto buffer3 = pool->Acquire(1, 1, 4);
+        }
+
+        Assert::AreEqual(0u, pool->GetOutstandingCount());
+        Assert::AreEqual(2u, pool->GetPooledCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_BufferKeepsPoolAlive)
+    {
+        auto pool = std::make_shared<PixelBufferPool>();
+        std::weak_ptr<PixelBufferPool> weakPool = pool;
+
+        auto buffer = pool->Acquire(1, 1, 4);
+        pool.reset();
+
+        Assert::IsFalse(weakPool.expired());
+
+        buffer.reset();
+
+        Assert::IsTrue(weakPool.expired());
+    }
+};
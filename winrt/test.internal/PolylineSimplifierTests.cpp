@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(PolylineSimplifierTests)
+{
+    static D2D1_RECT_F const& VisibleRect()
+    {
+        static auto const rect = D2D1::RectF(0, 0, 100, 100);
+        return rect;
+    }
+
+    static float DistanceToSegment(D2D1_POINT_2F const& p, D2D1_POINT_2F const& a, D2D1_POINT_2F const& b)
+    {
+        auto dx = b.x - a.x;
+        auto dy = b.y - a.y;
+        auto lengthSquared = dx * dx + dy * dy;
+
+        auto t = lengthSquared > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0;
+        t = std::min(1.0f, std::max(0.0f, t));
+
+        auto x = a.x + t * dx - p.x;
+        auto y = a.y + t * dy - p.y;
+
+        return sqrtf(x * x + y * y);
+    }
+
+    static float DistanceToPolyline(D2D1_POINT_2F const& p, D2D1_POINT_2F const* points, uint32_t pointCount)
+    {
+        auto distance = std::numeric_limits<float>::max();
+
+        for (uint32_t i = 1; i < pointCount; i++)
+            distance = std::min(distance, DistanceToSegment(p, points[i - 1], points[i]));
+
+        return distance;
+    }
+
+    // A chart of random samples, many to each pixel.
+    static std::vector<D2D1_POINT_2F> MakeNoisyChart(uint32_t pointCount, float width)
+    {
+        std::vector<D2D1_POINT_2F> points(pointCount);
+
+        uint32_t seed = 12345;
+
+        for (uint32_t i = 0; i < pointCount; i++)
+        {
+            seed = seed * 1664525 + 1013904223;
+            auto noise = static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+
+            points[i] = D2D1::Point2F(width * i / pointCount, 10 + 80 * noise);
+        }
+
+        return points;
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_FewerThanTwoPoints_GiveNothing)
+    {
+        PolylineSimplifier simplifier;
+        D2D1_POINT_2F point{ 1, 1 };
+
+        simplifier.Simplify(&point, 1, D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        Assert::AreEqual<size_t>(0, simplifier.GetRunLengths().size());
+        Assert::AreEqual<size_t>(0, simplifier.GetPoints().size());
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_CollinearPoints_ReduceToTheEnds)
+    {
+        std::vector<D2D1_POINT_2F> points;
+        for (int i = 0; i <= 1000; i++)
+            points.push_back(D2D1::Point2F(i * 0.1f, i * 0.05f));
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points.data(), static_cast<uint32_t>(points.size()), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        Assert::AreEqual<size_t>(1, simplifier.GetRunLengths().size());
+        Assert::AreEqual(2U, simplifier.GetRunLengths()[0]);
+        Assert::AreEqual(points.front(), simplifier.GetPoints()[0]);
+        Assert::AreEqual(points.back(), simplifier.GetPoints()[1]);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_LineOffTheTarget_IsCulled)
+    {
+        D2D1_POINT_2F points[] = { { -10, 10 }, { -20, 50 }, { -5, 90 }, { -50, 200 } };
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points, _countof(points), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        Assert::AreEqual<size_t>(0, simplifier.GetRunLengths().size());
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_SegmentCrossingTheTarget_IsKept)
+    {
+        // Both ends are outside, but on different sides.
+        D2D1_POINT_2F points[] = { { -10, 50 }, { 110, 50 } };
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points, _countof(points), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        Assert::AreEqual<size_t>(1, simplifier.GetRunLengths().size());
+        Assert::AreEqual(2U, simplifier.GetRunLengths()[0]);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_LineLeavingAndReturning_IsSplitIntoRuns)
+    {
+        D2D1_POINT_2F points[] =
+        {
+            { 10, 10 }, { 50, 10 }, { 50, -100 },       // goes out through the top
+            { 50, -200 },                               // stays out
+            { 90, -100 }, { 90, 10 }, { 95, 10 }        // comes back
+        };
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points, _countof(points), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        auto& runLengths = simplifier.GetRunLengths();
+        auto& result = simplifier.GetPoints();
+
+        Assert::AreEqual<size_t>(2, runLengths.size());
+        Assert::AreEqual(3U, runLengths[0]);
+        Assert::AreEqual(3U, runLengths[1]);
+
+        Assert::AreEqual(points[0], result[0]);
+        Assert::AreEqual(points[2], result[2]);
+        Assert::AreEqual(points[4], result[3]);
+        Assert::AreEqual(points[6], result[5]);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_NonFinitePoints_SplitTheLine)
+    {
+        auto nan = std::numeric_limits<float>::quiet_NaN();
+
+        D2D1_POINT_2F points[] = { { 0, 0 }, { 10, 20 }, { nan, 0 }, { 20, 30 }, { 30, 0 } };
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points, _countof(points), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        auto& runLengths = simplifier.GetRunLengths();
+        auto& result = simplifier.GetPoints();
+
+        Assert::AreEqual<size_t>(2, runLengths.size());
+        Assert::AreEqual(points[0], result[0]);
+        Assert::AreEqual(points[1], result[1]);
+        Assert::AreEqual(points[3], result[2]);
+        Assert::AreEqual(points[4], result[3]);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_ComparesPointsAfterTheTransform)
+    {
+        std::vector<D2D1_POINT_2F> points;
+        for (int i = 0; i < 1000; i++)
+            points.push_back(D2D1::Point2F(static_cast<float>(i), 100 * sinf(i / 10.0f)));
+
+        PolylineSimplifier simplifier;
+
+        // At full size the wiggles are kept.
+        auto transform = D2D1::Matrix3x2F::Scale(0.1f, 0.1f) * D2D1::Matrix3x2F::Translation(0, 50);
+        simplifier.Simplify(points.data(), static_cast<uint32_t>(points.size()), transform, VisibleRect(), 0.25f);
+        Assert::IsTrue(simplifier.GetPoints().size() > 100);
+
+        // Shrunk to a fraction of a pixel they are not.
+        transform = D2D1::Matrix3x2F::Scale(0.0001f, 0.0001f) * D2D1::Matrix3x2F::Translation(50, 50);
+        simplifier.Simplify(points.data(), static_cast<uint32_t>(points.size()), transform, VisibleRect(), 0.25f);
+        Assert::AreEqual<size_t>(1, simplifier.GetRunLengths().size());
+        Assert::IsTrue(simplifier.GetPoints().size() <= 4);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_NoisyChart_StaysWithinTolerance)
+    {
+        float const tolerance = 0.25f;
+
+        // 200 samples to each pixel.
+        auto points = MakeNoisyChart(4000, 20);
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points.data(), static_cast<uint32_t>(points.size()), D2D1::Matrix3x2F::Identity(), VisibleRect(), tolerance);
+
+        Assert::AreEqual<size_t>(1, simplifier.GetRunLengths().size());
+
+        auto& result = simplifier.GetPoints();
+        auto resultCount = static_cast<uint32_t>(result.size());
+
+        // At most four points for each half-tolerance column.
+        Assert::IsTrue(resultCount <= (20 / (tolerance / 2) + 1) * 4);
+        Assert::AreEqual(points.front(), result.front());
+        Assert::AreEqual(points.back(), result.back());
+
+        for (auto& point : points)
+            Assert::IsTrue(DistanceToPolyline(point, result.data(), resultCount) <= tolerance + 0.001f);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_MillionPointChart_ShrinksToThePixelsItCovers)
+    {
+        float const tolerance = 0.25f;
+
+        auto points = MakeNoisyChart(1000000, 100);
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(points.data(), static_cast<uint32_t>(points.size()), D2D1::Matrix3x2F::Identity(), VisibleRect(), tolerance);
+
+        Assert::AreEqual<size_t>(1, simplifier.GetRunLengths().size());
+        Assert::IsTrue(simplifier.GetPoints().size() <= (100 / (tolerance / 2) + 1) * 4);
+    }
+
+    TEST_METHOD_EX(PolylineSimplifier_WhenReused_ReturnsOnlyTheLatestLine)
+    {
+        D2D1_POINT_2F first[] = { { 10, 10 }, { 20, 80 }, { 30, 10 } };
+        D2D1_POINT_2F second[] = { { 50, 50 }, { 60, 60 } };
+
+        PolylineSimplifier simplifier;
+        simplifier.Simplify(first, _countof(first), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+        simplifier.Simplify(second, _countof(second), D2D1::Matrix3x2F::Identity(), VisibleRect(), 0.25f);
+
+        Assert::AreEqual<size_t>(1, simplifier.GetRunLengths().size());
+        Assert::AreEqual<size_t>(2, simplifier.GetPoints().size());
+        Assert::AreEqual(second[0], simplifier.GetPoints()[0]);
+    }
+};
@@ -71,3 +71,188 @@ TEST_CLASS(PolymorphicBitmapManagerTests_FromD2DBitmap)
         AssertClassName(wrapped, RuntimeClass_Microsoft_Graphics_Canvas_CanvasRenderTarget);
     }
 };
+
+TEST_CLASS(PolymorphicBitmapManagerTests_DecodeAtReducedSize)
+{
+    //
+    // A frame whose decoder can scale natively, but only into 24bppBGR, as
+    // the JPEG decoder does.
+    //
+    class StubScalingFrame : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        IWICBitmapFrameDecode,
+        IWICBitmapSourceTransform>
+    {
+    public:
+        BitmapSize Size;
+        BitmapSize ClosestSize;
+        WICPixelFormatGUID LastCopyFormat;
+        UINT LastCopyStride;
+
+        StubScalingFrame(BitmapSize size, BitmapSize closestSize)
+            : Size(size)
+            , ClosestSize(closestSize)
+            , LastCopyFormat(GUID_NULL)
+            , LastCopyStride(0)
+        { }
+
+        //
+        // IWICBitmapFrameDecode
+        //
+
+        IFACEMETHODIMP GetMetadataQueryReader(IWICMetadataQueryReader**) override { return E_NOTIMPL; }
+        IFACEMETHODIMP GetColorContexts(UINT, IWICColorContext**, UINT*) override { return E_NOTIMPL; }
+        IFACEMETHODIMP GetThumbnail(IWICBitmapSource**) override { return E_NOTIMPL; }
+
+        //
+        // IWICBitmapSource
+        //
+
+        IFACEMETHODIMP GetSize(UINT* width, UINT* height) override
+        {
+            *width = Size.Width;
+            *height = Size.Height;
+            return S_OK;
+        }
+
+        IFACEMETHODIMP GetPixelFormat(WICPixelFormatGUID* pixelFormat) override
+        {
+            *pixelFormat = GUID_WICPixelFormat24bppBGR;
+            return S_OK;
+        }
+
+        IFACEMETHODIMP GetResolution(double*, double*) override { return E_NOTIMPL; }
+        IFACEMETHODIMP CopyPalette(IWICPalette*) override { return E_NOTIMPL; }
+        IFACEMETHODIMP CopyPixels(WICRect const*, UINT, UINT, BYTE*) override { return E_NOTIMPL; }
+
+        //
+        // IWICBitmapSourceTransform
+        //
+
+        IFACEMETHODIMP CopyPixels(
+            WICRect const* rect,
+            UINT width,
+            UINT height,
+            WICPixelFormatGUID* pixelFormat,
+            WICBitmapTransformOptions transform,
+            UINT stride,
+            UINT bufferSize,
+            BYTE* buffer) override
+        {
+            Assert::IsNull(rect);
+            Assert::AreEqual(ClosestSize.Width, width);
+            Assert::AreEqual(ClosestSize.Height, height);
+            Assert::AreEqual(static_cast<int>(WICBitmapTransformRotate0), static_cast<int>(transform));
+
+            LastCopyFormat = *pixelFormat;
+            LastCopyStride = stride;
+
+            if (*pixelFormat != GUID_WICPixelFormat24bppBGR)
+                return WINCODEC_ERR_UNSUPPORTEDPIXELFORMAT;
+
+            Assert::IsTrue(stride * height <= bufferSize);
+
+            for (UINT y = 0; y < height; ++y)
+            {
+                for (UINT x = 0; x < width; ++x)
+                {
+                    BYTE* pixel = buffer + y * stride + x * 3;
+                    pixel[0] = 10;
+                    pixel[1] = 20;
+                    pixel[2] = 30;
+                }
+            }
+
+            return S_OK;
+        }
+
+        IFACEMETHODIMP GetClosestSize(UINT* width, UINT* height) override
+        {
+            *width = ClosestSize.Width;
+            *height = ClosestSize.Height;
+            return S_OK;
+        }
+
+        IFACEMETHODIMP GetClosestPixelFormat(WICPixelFormatGUID* pixelFormat) override
+        {
+            *pixelFormat = GUID_WICPixelFormat24bppBGR;
+            return S_OK;
+        }
+
+        IFACEMETHODIMP DoesSupportTransform(WICBitmapTransformOptions transform, BOOL* isSupported) override
+        {
+            *isSupported = (transform == WICBitmapTransformRotate0);
+            return S_OK;
+        }
+    };
+
+    static ComPtr<IWICImagingFactory> CreateWICFactory()
+    {
+        ComPtr<IWICImagingFactory> wicFactory;
+        ThrowIfFailed(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&wicFactory)));
+        return wicFactory;
+    }
+
+    TEST_METHOD_EX(TryDecodeAtReducedSize_When24bppDecoderCanScale_DecodesIn24bpp)
+    {
+        auto wicFactory = CreateWICFactory();
+
+        BitmapSize imageSize{ 64, 32 };
+        BitmapSize targetSize{ 10, 5 };
+        auto frame = Make<StubScalingFrame>(imageSize, BitmapSize{ 16, 8 });
+
+        auto source = TryDecodeAtReducedSize(wicFactory.Get(), frame.Get(), imageSize, targetSize);
+
+        Assert::IsNotNull(source.Get());
+        Assert::IsTrue(GUID_WICPixelFormat24bppBGR == frame->LastCopyFormat);
+        Assert::IsTrue(frame->LastCopyStride >= 16u * 3);
+
+        UINT width, height;
+        ThrowIfFailed(source->GetSize(&width, &height));
+        Assert::AreEqual(16u, width);
+        Assert::AreEqual(8u, height);
+
+        WICPixelFormatGUID pixelFormat;
+        ThrowIfFailed(source->GetPixelFormat(&pixelFormat));
+        Assert::IsTrue(GUID_WICPixelFormat24bppBGR == pixelFormat);
+
+        // The loader puts a format converter behind the reduced source, as it
+        // does for any other frame.
+        ComPtr<IWICFormatConverter> converter;
+        ThrowIfFailed(wicFactory->CreateFormatConverter(&converter));
+        ThrowIfFailed(converter->Initialize(source.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, nullptr, 0, WICBitmapPaletteTypeMedianCut));
+
+        std::vector<BYTE> pixels(16 * 8 * 4);
+        ThrowIfFailed(converter->CopyPixels(nullptr, 16 * 4, static_cast<UINT>(pixels.size()), pixels.data()));
+
+        Assert::AreEqual<BYTE>(10, pixels[0]);
+        Assert::AreEqual<BYTE>(20, pixels[1]);
+        Assert::AreEqual<BYTE>(30, pixels[2]);
+        Assert::AreEqual<BYTE>(255, pixels[3]);
+    }
+
+    TEST_METHOD_EX(TryDecodeAtReducedSize_WhenDecoderCannotScaleDown_ReturnsNull)
+    {
+        auto wicFactory = CreateWICFactory();
+
+        BitmapSize imageSize{ 64, 32 };
+        auto frame = Make<StubScalingFrame>(imageSize, imageSize);
+
+        auto source = TryDecodeAtReducedSize(wicFactory.Get(), frame.Get(), imageSize, BitmapSize{ 10, 5 });
+
+        Assert::IsNull(source.Get());
+        Assert::IsTrue(GUID_NULL == frame->LastCopyFormat);
+    }
+
+    TEST_METHOD_EX(TryDecodeAtReducedSize_WhenClosestSizeIsTooSmall_ReturnsNull)
+    {
+        auto wicFactory = CreateWICFactory();
+
+        BitmapSize imageSize{ 64, 32 };
+        auto frame = Make<StubScalingFrame>(imageSize, BitmapSize{ 8, 4 });
+
+        auto source = TryDecodeAtReducedSize(wicFactory.Get(), frame.Get(), imageSize, BitmapSize{ 10, 5 });
+
+        Assert::IsNull(source.Get());
+    }
+};
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+// A trace sink that records every event it receives. It installs itself for
+// its lifetime, restoring the previous sink when it is destroyed.
+
+#pragma once
+
+namespace canvas
+{
+    class RecordingTraceSink : public ITraceSink
+    {
+    public:
+        enum class RecordKind
+        {
+            Begin,
+            End,
+            Counter
+        };
+
+        struct Record
+        {
+            RecordKind Kind;
+            TraceEvent Event;
+            int64_t Value;
+        };
+
+    private:
+        std::mutex m_mutex;
+        std::vector<Record> m_records;
+        ITraceSink* m_previousSink;
+
+    public:
+        RecordingTraceSink()
+            : m_previousSink(Tracing::SetSink(this))
+        {
+        }
+
+        virtual ~RecordingTraceSink()
+        {
+            Tracing::SetSink(m_previousSink);
+        }
+
+        virtual void BeginSpan(TraceEvent event) override
+        {
+            Add(RecordKind::Begin, event, 0);
+        }
+
+        virtual void EndSpan(TraceEvent event) override
+        {
+            Add(RecordKind::End, event, 0);
+        }
+
+        virtual void Counter(TraceEvent event, int64_t value) override
+        {
+            Add(RecordKind::Counter, event, value);
+        }
+
+        std::vector<Record> GetRecords()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_records;
+        }
+
+        // The records for one event only, so tests are not sensitive to
+        // whatever else happens to be traced along the way.
+        std::vector<Record> GetRecords(TraceEvent event)
+        {
+            std::vector<Record> result;
+
+            for (auto const& record : GetRecords())
+            {
+                if (record.Event == event)
+                    result.push_back(record);
+            }
+
+            return result;
+        }
+
+        void AssertSpans(TraceEvent event, int expectedCount)
+        {
+            auto records = GetRecords(event);
+
+            Assert::AreEqual<size_t>(expectedCount * 2, records.size());
+
+            for (size_t i = 0; i < records.size(); i++)
+            {
+                Assert::IsTrue(records[i].Kind == (i % 2 == 0 ? RecordKind::Begin : RecordKind::End));
+            }
+        }
+
+    private:
+        void Add(RecordKind kind, TraceEvent event, int64_t value)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_records.push_back(Record{ kind, event, value });
+        }
+
+        RecordingTraceSink(RecordingTraceSink const&);
+        RecordingTraceSink& operator=(RecordingTraceSink const&);
+    };
+}
@@ -43,6 +43,18 @@ STDMETHODIMP StubD2DFactoryWithCreateStrokeStyle::CreateStrokeStyle(
     return S_OK;
 }
 
+STDMETHODIMP StubD2DFactoryWithCreateStrokeStyle::CreatePathGeometry(
+    _Outptr_ ID2D1PathGeometry **pathGeometry
+    )
+{
+    m_numCallsToCreatePathGeometry++;
+
+    if (!m_realFactory)
+        ThrowIfFailed(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, m_realFactory.GetAddressOf()));
+
+    return m_realFactory->CreatePathGeometry(pathGeometry);
+}
+
 IFACEMETHODIMP StubD2DDeviceContextWithGetFactory::CreateBitmap(
     D2D1_SIZE_U size,
     const void *data,
@@ -14,12 +14,16 @@
 
 #include "../test.external/MockDxgiSurface.h" // TODO #997/#1429: move this file
 
-// This device derives from MockCanvasDevice, but it allows creation of stroke styles.
+// This device derives from MockCanvasDevice, but it allows creation of stroke
+// styles and path geometries.
 class StubD2DFactoryWithCreateStrokeStyle : public MockD2DFactory
 {
+    ComPtr<ID2D1Factory> m_realFactory;
+
 public:
     StubD2DFactoryWithCreateStrokeStyle()
         : m_numCallsToCreateStrokeStyle(0)
+        , m_numCallsToCreatePathGeometry(0)
         , m_startCap(D2D1_CAP_STYLE_FLAT)
         , m_endCap(D2D1_CAP_STYLE_FLAT)
         , m_dashCap(D2D1_CAP_STYLE_FLAT)
@@ -38,7 +42,14 @@ public:
         _Outptr_ ID2D1StrokeStyle1 **strokeStyle
         );
 
+    // Path geometries are created by a real D2D factory, so that tests can
+    // check what was streamed into them.
+    STDMETHOD(CreatePathGeometry)(
+        _Outptr_ ID2D1PathGeometry **pathGeometry
+        ) override;
+
     int m_numCallsToCreateStrokeStyle;
+    int m_numCallsToCreatePathGeometry;
     D2D1_CAP_STYLE m_startCap;
     D2D1_CAP_STYLE m_endCap;
     D2D1_CAP_STYLE m_dashCap;
@@ -55,8 +66,10 @@ class StubD2DDeviceContextWithGetFactory : public MockD2DDeviceContext
 public:
 
     ComPtr<StubD2DFactoryWithCreateStrokeStyle> m_factory;
+    mutable int m_numCallsToGetFactory;
 
     StubD2DDeviceContextWithGetFactory()
+        : m_numCallsToGetFactory(0)
     {
         m_factory = Make<StubD2DFactoryWithCreateStrokeStyle>();
 
@@ -65,6 +78,7 @@ public:
 
     IFACEMETHODIMP_(void) GetFactory(ID2D1Factory** factory) const override
     {
+        m_numCallsToGetFactory++;
         ThrowIfFailed(m_factory.CopyTo(factory));
     }
 
@@ -10,21 +10,43 @@
 // License for the specific language governing permissions and limitations
 // under the License.
 
-// This device derives from MockD2DStrokeStyle, but it allows for retrieval of the factory.
+// This device derives from MockD2DStrokeStyle, but it allows for retrieval of the factory,
+// and reports the properties the factory was last asked to create a stroke style with.
 
 #pragma once
 
 class StubD2DStrokeStyleWithGetFactory : public MockD2DStrokeStyle
 {
     ComPtr<StubD2DFactoryWithCreateStrokeStyle> m_factory;
+    D2D1_LINE_JOIN m_lineJoin;
+    float m_miterLimit;
+    D2D1_DASH_STYLE m_dashStyle;
 
 public:
     StubD2DStrokeStyleWithGetFactory(ComPtr<StubD2DFactoryWithCreateStrokeStyle> factory)
         : m_factory(factory)
+        , m_lineJoin(factory->m_lineJoin)
+        , m_miterLimit(factory->m_miterLimit)
+        , m_dashStyle(factory->m_dashStyle)
     {}
 
     IFACEMETHODIMP_(void) GetFactory(ID2D1Factory** factory) const override
     {
         ThrowIfFailed(m_factory.CopyTo(factory));
     }
+
+    IFACEMETHODIMP_(D2D1_LINE_JOIN) GetLineJoin() const override
+    {
+        return m_lineJoin;
+    }
+
+    IFACEMETHODIMP_(FLOAT) GetMiterLimit() const override
+    {
+        return m_miterLimit;
+    }
+
+    IFACEMETHODIMP_(D2D1_DASH_STYLE) GetDashStyle() const override
+    {
+        return m_dashStyle;
+    }
 };
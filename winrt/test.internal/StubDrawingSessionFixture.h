@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+//
+// A drawing session over a stub device context that accepts any number of
+// draw calls and does nothing with them.  Anything measured against it -
+// time or allocations - is down to Win2D itself rather than D2D.
+//
+class StubDrawingSessionFixture
+{
+public:
+    ComPtr<StubD2DDevice> Device;
+    ComPtr<StubD2DDeviceContextWithGetFactory> DeviceContext;
+    ComPtr<MockD2DSolidColorBrush> ColorBrush;
+    ComPtr<MockD2DEffect> Effect;
+    ComPtr<CanvasDrawingSession> DS;
+    ComPtr<StubCanvasBrush> Brush;
+
+    StubDrawingSessionFixture()
+        : Device(Make<StubD2DDevice>())
+        , DeviceContext(Make<StubD2DDeviceContextWithGetFactory>())
+        , ColorBrush(Make<MockD2DSolidColorBrush>())
+        , Effect(Make<MockD2DEffect>())
+        , Brush(Make<StubCanvasBrush>())
+    {
+        DeviceContext->GetDeviceMethod.AllowAnyCallAlwaysCopyValueToParam(Device);
+
+        auto colorBrush = ColorBrush;
+        DeviceContext->CreateSolidColorBrushMethod.AllowAnyCall(
+            [=](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** brush)
+            {
+                return colorBrush.CopyTo(brush);
+            });
+
+        auto effect = Effect;
+        DeviceContext->CreateEffectMethod.AllowAnyCall(
+            [=](IID const&, ID2D1Effect** value)
+            {
+                return effect.CopyTo(value);
+            });
+
+        DeviceContext->GetDpiMethod.AllowAnyCall(
+            [](float* dpiX, float* dpiY)
+            {
+                *dpiX = DEFAULT_DPI;
+                *dpiY = DEFAULT_DPI;
+            });
+
+        DeviceContext->GetTargetMethod.AllowAnyCall(
+            [](ID2D1Image** target)
+            {
+                *target = nullptr;
+            });
+
+        DeviceContext->GetTransformMethod.AllowAnyCall(
+            [](D2D1_MATRIX_3X2_F* transform)
+            {
+                *transform = D2D1::Matrix3x2F::Identity();
+            });
+
+        DeviceContext->ClearMethod.AllowAnyCall();
+        DeviceContext->SetTransformMethod.AllowAnyCall();
+        DeviceContext->DrawLineMethod.AllowAnyCall();
+        DeviceContext->FillRectangleMethod.AllowAnyCall();
+        DeviceContext->FillEllipseMethod.AllowAnyCall();
+        DeviceContext->DrawBitmapMethod.AllowAnyCall();
+        DeviceContext->DrawImageMethod.AllowAnyCall();
+        DeviceContext->DrawTextMethod.AllowAnyCall();
+        DeviceContext->DrawGlyphRunMethod.AllowAnyCall();
+
+        ColorBrush->MockSetColor = [](D2D1_COLOR_F const*) {};
+
+        Effect->MockSetInput = [](UINT32, ID2D1Image*) {};
+        Effect->MockSetInputCount = [] { return S_OK; };
+        Effect->MockSetValue = [](UINT32, D2D1_PROPERTY_TYPE, CONST BYTE*, UINT32) { return S_OK; };
+
+        auto manager = std::make_shared<CanvasDrawingSessionManager>();
+        DS = manager->Create(DeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+    }
+};
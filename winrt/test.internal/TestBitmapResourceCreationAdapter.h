@@ -17,13 +17,30 @@ class TestBitmapResourceCreationAdapter : public ICanvasBitmapResourceCreationAd
 public:
     std::function<void()> MockCreateWICFormatConverter;
 
+    BitmapSize LastMaxSize;
+    CanvasImageInterpolation LastInterpolation;
+
     TestBitmapResourceCreationAdapter()
+        : LastMaxSize()
+        , LastInterpolation(CanvasImageInterpolation::NearestNeighbor)
     {
     }
 
     TestBitmapResourceCreationAdapter(ComPtr<IWICFormatConverter> converter)
         : m_converter(converter)
+        , LastMaxSize()
+        , LastInterpolation(CanvasImageInterpolation::NearestNeighbor)
+    {
+    }
+
+    bool TryReadBlockCompressedImage(HSTRING fileName, BlockCompressedImage* image)
+    {
+        return false;
+    }
+
+    bool TryReadBlockCompressedImage(IStream* fileStream, BlockCompressedImage* image)
     {
+        return false;
     }
 
     ComPtr<IWICFormatConverter> CreateWICFormatConverter(HSTRING fileName)
@@ -39,29 +56,48 @@ public:
         return nullptr;
     }
 
-    virtual void SaveLockedMemoryToFile(
+    ComPtr<IWICFormatConverter> CreateWICFormatConverter(HSTRING fileName, BitmapSize maxSize, CanvasImageInterpolation interpolation)
+    {
+        LastMaxSize = maxSize;
+        LastInterpolation = interpolation;
+
+        if (MockCreateWICFormatConverter)
+            MockCreateWICFormatConverter();
+        return m_converter;
+    }
+
+    ComPtr<IWICFormatConverter> CreateWICFormatConverter(IStream* fileStream, BitmapSize maxSize, CanvasImageInterpolation interpolation)
+    {
+        Assert::Fail(); // Unexpected
+        return nullptr;
+    }
+
+    ComPtr<IWICFormatConverter> CreateDecodedWICFormatConverter(HSTRING fileName)
+    {
+        if (MockCreateWICFormatConverter)
+            MockCreateWICFormatConverter();
+        return m_converter;
+    }
+
+    virtual void SavePixelBufferToFile(
         HSTRING fileName,
         CanvasBitmapFileFormat fileFormat,
         float quality,
-        unsigned int width,
-        unsigned int height,
         float dpiX,
         float dpiY,
-        ScopedBitmapLock* bitmapLock)
+        PixelBuffer* pixels)
     {
         Assert::Fail(); // Unexpected
     }
 
 
-    virtual void SaveLockedMemoryToStream(
+    virtual void SavePixelBufferToStream(
         IRandomAccessStream* stream,
         CanvasBitmapFileFormat fileFormat,
         float quality,
-        unsigned int width,
-        unsigned int height,
         float dpiX,
         float dpiY,
-        ScopedBitmapLock* bitmapLock)
+        PixelBuffer* pixels)
     {
         Assert::Fail(); // Unexpected
     }
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "RecordingTraceSink.h"
+
+TEST_CLASS(TracingTests)
+{
+    typedef RecordingTraceSink::RecordKind RecordKind;
+
+    static void AssertRecord(
+        RecordingTraceSink::Record const& record,
+        RecordKind expectedKind,
+        TraceEvent expectedEvent,
+        int64_t expectedValue = 0)
+    {
+        Assert::IsTrue(expectedKind == record.Kind);
+        Assert::IsTrue(expectedEvent == record.Event);
+        Assert::AreEqual(expectedValue, record.Value);
+    }
+
+    TEST_METHOD_EX(Tracing_SetSink_ReturnsThePreviousSink)
+    {
+        auto originalSink = Tracing::GetSink();
+
+        {
+            RecordingTraceSink sink;
+            Assert::IsTrue(Tracing::GetSink() == &sink);
+
+            {
+                RecordingTraceSink innerSink;
+                Assert::IsTrue(Tracing::GetSink() == &innerSink);
+            }
+
+            Assert::IsTrue(Tracing::GetSink() == &sink);
+        }
+
+        Assert::IsTrue(Tracing::GetSink() == originalSink);
+    }
+
+    TEST_METHOD_EX(TraceSpan_NestedSpansEndInReverseOrder)
+    {
+        RecordingTraceSink sink;
+
+        {
+            TraceSpan outer(TraceEvent::DrawHandlers);
+            TraceSpan inner(TraceEvent::EffectRealization);
+        }
+
+        auto records = sink.GetRecords();
+        Assert::AreEqual<size_t>(4, records.size());
+        AssertRecord(records[0], RecordKind::Begin, TraceEvent::DrawHandlers);
+        AssertRecord(records[1], RecordKind::Begin, TraceEvent::EffectRealization);
+        AssertRecord(records[2], RecordKind::End, TraceEvent::EffectRealization);
+        AssertRecord(records[3], RecordKind::End, TraceEvent::DrawHandlers);
+    }
+
+    TEST_METHOD_EX(TraceSpan_EndsOnTheSinkItBeganOn)
+    {
+        RecordingTraceSink firstSink;
+        std::unique_ptr<RecordingTraceSink> secondSink;
+
+        {
+            TraceSpan span(TraceEvent::BitmapLoad);
+            secondSink.reset(new RecordingTraceSink());
+        }
+
+        firstSink.AssertSpans(TraceEvent::BitmapLoad, 1);
+        Assert::IsTrue(secondSink->GetRecords().empty());
+    }
+
+    TEST_METHOD_EX(Tracing_WithNoSink_EventsAreDropped)
+    {
+        auto previousSink = Tracing::SetSink(nullptr);
+        auto restoreSink = MakeScopeWarden([=] { Tracing::SetSink(previousSink); });
+
+        TraceSpan span(TraceEvent::DeviceCreation);
+        Tracing::Counter(TraceEvent::DeviceLost, 1);
+    }
+
+#ifndef WIN2D_DISABLE_TRACING
+
+    TEST_METHOD_EX(Tracing_Macros_RecordSpansAndCounters)
+    {
+        RecordingTraceSink sink;
+
+        {
+            TRACE_SPAN(BitmapDecode);
+            TRACE_SPAN(BitmapLock);
+            TRACE_COUNTER(BitmapUpload, 1024u);
+        }
+
+        auto records = sink.GetRecords();
+        Assert::AreEqual<size_t>(5, records.size());
+        AssertRecord(records[0], RecordKind::Begin, TraceEvent::BitmapDecode);
+        AssertRecord(records[1], RecordKind::Begin, TraceEvent::BitmapLock);
+        AssertRecord(records[2], RecordKind::Counter, TraceEvent::BitmapUpload, 1024);
+        AssertRecord(records[3], RecordKind::End, TraceEvent::BitmapLock);
+        AssertRecord(records[4], RecordKind::End, TraceEvent::BitmapDecode);
+    }
+
+#endif
+};
@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "TestBitmapResourceCreationAdapter.h"
+
+TEST_CLASS(VirtualBitmapTilesTests)
+{
+    static BitmapSize MakeSize(uint32_t width, uint32_t height)
+    {
+        BitmapSize size = { width, height };
+        return size;
+    }
+
+    struct Fixture
+    {
+        // A 250x150 image split into 100 pixel tiles is 3 columns by 2 rows,
+        // with partial tiles along the right and bottom edges.
+        VirtualBitmapTiles Tiles;
+        std::vector<D2D1_RECT_U> Loaded;
+
+        Fixture()
+            : Tiles(MakeSize(250, 150), 100)
+        {
+        }
+
+        std::vector<VirtualBitmapTile> GetTiles(float left, float top, float right, float bottom)
+        {
+            return Tiles.GetTiles(D2D1::RectF(left, top, right, bottom),
+                [&](D2D1_RECT_U const& bounds) -> ComPtr<ICanvasBitmap>
+                {
+                    Loaded.push_back(bounds);
+                    return CreateStubCanvasBitmap();
+                });
+        }
+
+        static uint64_t BytesFor(D2D1_RECT_U const& bounds)
+        {
+            return static_cast<uint64_t>(bounds.right - bounds.left) * (bounds.bottom - bounds.top) * 4;
+        }
+    };
+
+    TEST_METHOD_EX(VirtualBitmapTiles_Construction)
+    {
+        Fixture f;
+
+        Assert::AreEqual(3u, f.Tiles.GetColumnCount());
+        Assert::AreEqual(2u, f.Tiles.GetRowCount());
+        Assert::AreEqual(0u, f.Tiles.GetResidentTileCount());
+        Assert::AreEqual(0ull, f.Tiles.GetResidentBytes());
+        uint64_t expectedBudget = VirtualBitmapTiles::DefaultMemoryBudget;
+        Assert::AreEqual(expectedBudget, f.Tiles.GetMemoryBudget());
+
+        ExpectHResultException(E_INVALIDARG, [] { VirtualBitmapTiles tiles(MakeSize(10, 10), 0); });
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetTiles_LoadsOnlyIntersectingTilesWithGutter)
+    {
+        Fixture f;
+
+        auto tiles = f.GetTiles(150, 110, 190, 140);
+
+        Assert::AreEqual<size_t>(1, tiles.size());
+        Assert::AreEqual(D2D1::RectU(100, 100, 200, 150), tiles[0].Bounds);
+        Assert::AreEqual(D2D1::RectU(99, 99, 201, 150), tiles[0].BitmapBounds);
+        Assert::IsNotNull(tiles[0].Bitmap.Get());
+
+        Assert::AreEqual<size_t>(1, f.Loaded.size());
+        Assert::AreEqual(tiles[0].BitmapBounds, f.Loaded[0]);
+
+        Assert::AreEqual(1u, f.Tiles.GetResidentTileCount());
+        Assert::AreEqual(Fixture::BytesFor(tiles[0].BitmapBounds), f.Tiles.GetResidentBytes());
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetTiles_RegionOnTileEdgeDoesNotLoadNextTile)
+    {
+        Fixture f;
+
+        auto tiles = f.GetTiles(0, 0, 100, 100);
+
+        Assert::AreEqual<size_t>(1, tiles.size());
+        Assert::AreEqual(D2D1::RectU(0, 0, 100, 100), tiles[0].Bounds);
+        Assert::AreEqual(D2D1::RectU(0, 0, 101, 101), tiles[0].BitmapBounds);
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetTiles_RegionIsClippedToImage)
+    {
+        Fixture f;
+
+        auto tiles = f.GetTiles(-1000, -1000, 1000, 1000);
+
+        Assert::AreEqual<size_t>(6, tiles.size());
+        Assert::AreEqual(D2D1::RectU(200, 100, 250, 150), tiles.back().Bounds);
+
+        f.Loaded.clear();
+
+        Assert::AreEqual<size_t>(0, f.GetTiles(300, 0, 400, 100).size());
+        Assert::AreEqual<size_t>(0, f.GetTiles(10, 10, 10, 20).size());
+        Assert::AreEqual<size_t>(0, f.Loaded.size());
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetTiles_ResidentTilesAreNotReloaded)
+    {
+        Fixture f;
+
+        auto tiles1 = f.GetTiles(0, 0, 150, 50);
+        auto tiles2 = f.GetTiles(50, 0, 250, 50);
+
+        Assert::AreEqual<size_t>(2, tiles1.size());
+        Assert::AreEqual<size_t>(3, tiles2.size());
+
+        // Only the third column is new the second time around.
+        Assert::AreEqual<size_t>(3, f.Loaded.size());
+        Assert::IsTrue(IsSameInstance(tiles1[1].Bitmap.Get(), tiles2[1].Bitmap.Get()));
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetTiles_WhenLoadReturnsNull_Throws)
+    {
+        VirtualBitmapTiles tiles(MakeSize(10, 10), 5);
+
+        ExpectHResultException(E_UNEXPECTED,
+            [&]
+            {
+                tiles.GetTiles(D2D1::RectF(0, 0, 10, 10), [](D2D1_RECT_U const&) { return ComPtr<ICanvasBitmap>(); });
+            });
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_OverBudget_LeastRecentlyUsedTilesAreEvicted)
+    {
+        Fixture f;
+
+        // Room for two full tiles, but not for a third as well.
+        f.Tiles.SetMemoryBudget(90000);
+
+        f.GetTiles(0, 0, 50, 50);       // column 0
+        f.GetTiles(150, 0, 160, 50);    // column 1
+        f.GetTiles(10, 0, 20, 50);      // column 0 again, so column 1 is now the oldest
+        f.GetTiles(210, 0, 220, 50);    // column 2
+
+        Assert::AreEqual(2u, f.Tiles.GetResidentTileCount());
+        Assert::IsTrue(f.Tiles.GetResidentBytes() <= f.Tiles.GetMemoryBudget());
+
+        f.Loaded.clear();
+
+        f.GetTiles(0, 0, 10, 10);
+        f.GetTiles(240, 0, 250, 10);
+        Assert::AreEqual<size_t>(0, f.Loaded.size());
+
+        f.GetTiles(150, 0, 160, 10);
+        Assert::AreEqual<size_t>(1, f.Loaded.size());
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_OverBudget_TilesInCurrentDrawAreNotEvicted)
+    {
+        Fixture f;
+
+        f.Tiles.SetMemoryBudget(1);
+
+        auto tiles = f.GetTiles(0, 0, 250, 150);
+
+        Assert::AreEqual<size_t>(6, tiles.size());
+        Assert::AreEqual(6u, f.Tiles.GetResidentTileCount());
+
+        // The next draw uses one tile, so everything else can go.
+        f.GetTiles(0, 0, 10, 10);
+
+        Assert::AreEqual(1u, f.Tiles.GetResidentTileCount());
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_SetMemoryBudget_TrimsImmediately)
+    {
+        Fixture f;
+
+        f.GetTiles(0, 0, 250, 150);
+        Assert::AreEqual(6u, f.Tiles.GetResidentTileCount());
+
+        f.Tiles.SetMemoryBudget(0);
+
+        Assert::AreEqual(0u, f.Tiles.GetResidentTileCount());
+        Assert::AreEqual(0ull, f.Tiles.GetResidentBytes());
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_Clear_ReleasesAllTiles)
+    {
+        Fixture f;
+
+        f.GetTiles(0, 0, 250, 150);
+        f.Tiles.Clear();
+
+        Assert::AreEqual(0u, f.Tiles.GetResidentTileCount());
+        Assert::AreEqual(0ull, f.Tiles.GetResidentBytes());
+
+        f.Loaded.clear();
+        f.GetTiles(0, 0, 10, 10);
+        Assert::AreEqual<size_t>(1, f.Loaded.size());
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetVisibleSourceRect_WithNoTarget_ReturnsSourceRect)
+    {
+        auto sourceRect = D2D1::RectF(10, 20, 110, 220);
+        D2D1_RECT_F visible;
+
+        Assert::IsTrue(VirtualBitmapTiles::GetVisibleSourceRect(
+            D2D1::RectF(0, 0, 50, 100), sourceRect, D2D1::Matrix3x2F::Identity(), nullptr, &visible));
+
+        Assert::AreEqual(sourceRect, visible);
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetVisibleSourceRect_CullsToTarget)
+    {
+        // Source is drawn at half size, and the target only shows the top left 20x10 DIPs.
+        auto destRect = D2D1::RectF(0, 0, 100, 100);
+        auto sourceRect = D2D1::RectF(0, 0, 200, 200);
+        auto targetBounds = D2D1::RectF(0, 0, 20, 10);
+        D2D1_RECT_F visible;
+
+        Assert::IsTrue(VirtualBitmapTiles::GetVisibleSourceRect(
+            destRect, sourceRect, D2D1::Matrix3x2F::Identity(), &targetBounds, &visible));
+
+        Assert::AreEqual(D2D1::RectF(0, 0, 41, 21), visible);
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetVisibleSourceRect_AppliesTransform)
+    {
+        auto destRect = D2D1::RectF(0, 0, 100, 100);
+        auto sourceRect = D2D1::RectF(0, 0, 100, 100);
+        auto targetBounds = D2D1::RectF(0, 0, 100, 100);
+        D2D1_RECT_F visible;
+
+        // Scaled up by 2 and moved left by 100, so only x in [50, 100) and y in [0, 50) land on the target.
+        auto transform = D2D1::Matrix3x2F::Scale(2, 2) * D2D1::Matrix3x2F::Translation(-100, 0);
+
+        Assert::IsTrue(VirtualBitmapTiles::GetVisibleSourceRect(
+            destRect, sourceRect, transform, &targetBounds, &visible));
+
+        Assert::AreEqual(D2D1::RectF(49, 0, 100, 51), visible);
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetVisibleSourceRect_WhenNothingIsVisible_ReturnsFalse)
+    {
+        auto targetBounds = D2D1::RectF(0, 0, 100, 100);
+        D2D1_RECT_F visible;
+
+        Assert::IsFalse(VirtualBitmapTiles::GetVisibleSourceRect(
+            D2D1::RectF(200, 200, 300, 300), D2D1::RectF(0, 0, 10, 10), D2D1::Matrix3x2F::Identity(), &targetBounds, &visible));
+
+        Assert::IsFalse(VirtualBitmapTiles::GetVisibleSourceRect(
+            D2D1::RectF(0, 0, 10, 10), D2D1::RectF(0, 0, 10, 10), D2D1::Matrix3x2F::Scale(0, 1), &targetBounds, &visible));
+
+        Assert::IsFalse(VirtualBitmapTiles::GetVisibleSourceRect(
+            D2D1::RectF(0, 0, 0, 10), D2D1::RectF(0, 0, 10, 10), D2D1::Matrix3x2F::Identity(), nullptr, &visible));
+    }
+
+    TEST_METHOD_EX(VirtualBitmapTiles_GetTileDrawRects)
+    {
+        VirtualBitmapTile tile = { D2D1::RectU(100, 100, 200, 200), D2D1::RectU(99, 99, 201, 201) };
+
+        // The source covers the right half of the tile, and is drawn at twice its size.
+        auto sourceRect = D2D1::RectF(150, 0, 350, 200);
+        auto destRect = D2D1::RectF(0, 0, 400, 400);
+
+        D2D1_RECT_F tileDest;
+        D2D1_RECT_F tileSource;
+
+        Assert::IsTrue(VirtualBitmapTiles::GetTileDrawRects(tile, destRect, sourceRect, &tileDest, &tileSource));
+
+        Assert::AreEqual(D2D1::RectF(0, 200, 100, 400), tileDest);
+        Assert::AreEqual(D2D1::RectF(51, 1, 101, 101), tileSource);
+
+        Assert::IsFalse(VirtualBitmapTiles::GetTileDrawRects(tile, destRect, D2D1::RectF(0, 0, 50, 50), &tileDest, &tileSource));
+    }
+};
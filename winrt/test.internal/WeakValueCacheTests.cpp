@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "WeakValueCache.h"
+
+TEST_CLASS(WeakValueCacheTests)
+{
+    struct TestValue
+    {
+        int Key;
+    };
+
+    typedef WeakValueCache<int, TestValue> TestCache;
+
+    class CreateCounter
+    {
+        int m_count;
+
+    public:
+        CreateCounter()
+            : m_count(0)
+        { }
+
+        std::function<std::shared_ptr<TestValue>()> For(int key)
+        {
+            return [=]
+            {
+                ++m_count;
+
+                auto value = std::make_shared<TestValue>();
+                value->Key = key;
+                return value;
+            };
+        }
+
+        int GetCount() const
+        {
+            return m_count;
+        }
+    };
+
+    TEST_METHOD_EX(WeakValueCache_GetOrCreate_SharesLiveValues)
+    {
+        TestCache cache;
+        CreateCounter creates;
+
+        auto value1 = cache.GetOrCreate(1, creates.For(1));
+        auto value2 = cache.GetOrCreate(1, creates.For(1));
+        auto otherValue = cache.GetOrCreate(2, creates.For(2));
+
+        Assert::IsTrue(value1 == value2);
+        Assert::IsFalse(value1 == otherValue);
+        Assert::AreEqual(2, creates.GetCount());
+    }
+
+    TEST_METHOD_EX(WeakValueCache_GetOrCreate_DoesNotKeepValuesAlive)
+    {
+        TestCache cache;
+        CreateCounter creates;
+
+        std::weak_ptr<TestValue> weakValue = cache.GetOrCreate(1, creates.For(1));
+
+        Assert::IsTrue(weakValue.expired());
+
+        auto value = cache.GetOrCreate(1, creates.For(1));
+
+        Assert::IsNotNull(value.get());
+        Assert::AreEqual(2, creates.GetCount());
+    }
+
+    TEST_METHOD_EX(WeakValueCache_GetOrCreate_WhenCreateThrows_NothingIsCached)
+    {
+        TestCache cache;
+        CreateCounter creates;
+
+        ExpectHResultException(E_FAIL,
+            [&] { cache.GetOrCreate(1, []() -> std::shared_ptr<TestValue> { ThrowHR(E_FAIL); }); });
+
+        cache.GetOrCreate(1, creates.For(1));
+
+        Assert::AreEqual(1, creates.GetCount());
+    }
+
+    TEST_METHOD_EX(WeakValueCache_GetOrRecycle_WhenPreviousIsOnlyHeldByTheCaller_ItIsPassedToCreate)
+    {
+        TestCache cache;
+        CreateCounter creates;
+
+        auto previous = cache.GetOrCreate(1, creates.For(1));
+        auto previousPointer = previous.get();
+
+        previous = cache.GetOrRecycle(2, previous, 1,
+            [&](std::shared_ptr<TestValue> const& recyclable)
+            {
+                Assert::IsTrue(recyclable.get() == previousPointer);
+
+                recyclable->Key = 2;
+                return recyclable;
+            });
+
+        Assert::IsTrue(previous.get() == previousPointer);
+
+        // The recycled value is no longer found under its old key.
+        auto value = cache.GetOrCreate(1, creates.For(1));
+
+        Assert::IsFalse(value == previous);
+        Assert::AreEqual(2, creates.GetCount());
+    }
+
+    TEST_METHOD_EX(WeakValueCache_GetOrRecycle_WhenPreviousIsShared_NullIsPassedToCreate)
+    {
+        TestCache cache;
+        CreateCounter creates;
+
+        auto previous = cache.GetOrCreate(1, creates.For(1));
+        auto otherUser = cache.GetOrCreate(1, creates.For(1));
+
+        auto value = cache.GetOrRecycle(2, previous, 1,
+            [&](std::shared_ptr<TestValue> const& recyclable)
+            {
+                Assert::IsNull(recyclable.get());
+
+                return creates.For(2)();
+            });
+
+        Assert::IsFalse(value == previous);
+        Assert::IsTrue(cache.GetOrCreate(1, creates.For(1)) == otherUser);
+    }
+
+    TEST_METHOD_EX(WeakValueCache_GetOrRecycle_WhenValueExists_ReturnsItWithoutCallingCreate)
+    {
+        TestCache cache;
+        CreateCounter creates;
+
+        auto previous = cache.GetOrCreate(1, creates.For(1));
+        auto existing = cache.GetOrCreate(2, creates.For(2));
+
+        auto value = cache.GetOrRecycle(2, previous, 1,
+            [&](std::shared_ptr<TestValue> const&) -> std::shared_ptr<TestValue>
+            {
+                Assert::Fail(L"create should not be called");
+                return nullptr;
+            });
+
+        Assert::IsTrue(value == existing);
+    }
+};
+
+TEST_CLASS(AmortizedPrunerTests)
+{
+    static bool IsDead(bool isDead)
+    {
+        return isDead;
+    }
+
+    TEST_METHOD_EX(AmortizedPruner_OnlySweepsOnceTheMapHasDoubled)
+    {
+        AmortizedPruner pruner;
+        std::map<int, bool> map;
+
+        for (int i = 0; i < 15; ++i)
+        {
+            map[i] = true;
+            pruner.Prune(map, IsDead);
+        }
+
+        Assert::AreEqual<size_t>(15, map.size());
+
+        // Reaching the initial threshold sweeps out all the dead entries.
+        map[15] = false;
+        pruner.Prune(map, IsDead);
+
+        Assert::AreEqual<size_t>(1, map.size());
+
+        // The next sweep waits until the map holds the minimum again.
+        for (int i = 16; i < 30; ++i)
+        {
+            map[i] = true;
+            pruner.Prune(map, IsDead);
+        }
+
+        Assert::AreEqual<size_t>(15, map.size());
+
+        map[30] = true;
+        pruner.Prune(map, IsDead);
+
+        Assert::AreEqual<size_t>(1, map.size());
+    }
+};
+
+TEST_CLASS(KeyComparisonTests)
+{
+    TEST_METHOD_EX(KeyComparison_FirstDifferingFieldDecides)
+    {
+        Assert::IsTrue(KeyComparison()(1, 2)(9, 0).IsLess());
+        Assert::IsFalse(KeyComparison()(2, 1)(0, 9).IsLess());
+        Assert::IsTrue(KeyComparison()(1, 1)(0, 9).IsLess());
+        Assert::IsFalse(KeyComparison()(1, 1)(9, 9).IsLess());
+    }
+};
@@ -69,11 +69,17 @@
 #include <Microsoft.Graphics.Canvas.native.h>
 
 // winrt.lib
+#include <BatchBitmapLoader.h>
+#include <BlockCompression.h>
 #include <CanvasBitmap.h>
+#include <CanvasBitmapCache.h>
 #include <CanvasBrush.h>
+#include <CanvasCachedGeometry.h>
 #include <CanvasControl.h>
 #include <CanvasDevice.h>
 #include <CanvasDrawingSession.h>
+#include <CanvasDrawingStatistics.h>
+#include <CanvasGeometry.h>
 #include <CanvasImageBrush.h>
 #include <CanvasImageSource.h>
 #include <CanvasImageSourceDrawingSessionAdapter.h>
@@ -83,13 +89,17 @@
 #include <CanvasSolidColorBrush.h>
 #include <CanvasStrokeStyle.h>
 #include <CanvasTextFormat.h>
+#include <CanvasTextLayout.h>
+#include <CanvasVirtualBitmap.h>
 #include <Conversion.h>
 #include <DxgiUtilities.h>
+#include <PolylineSimplifier.h>
 #include <RecreatableDeviceManager.h>
 #include <ResourceManager.h>
 #include <ResourceTracker.h>
 #include <ResourceWrapper.h>
 #include <Strings.h>
+#include <Tracing.h>
 #include <effects\CanvasEffect.h>
 
 
@@ -102,6 +112,7 @@ using namespace canvas;
 using namespace ABI::Microsoft::Graphics::Canvas;
 using namespace ABI::Microsoft::Graphics::Canvas::Effects;
 
+#include "AllocationTracking.h"
 #include "Helpers.h"
 #include "MockCanvasDevice.h"
 #include "MockCanvasDrawingSession.h"
@@ -110,6 +121,7 @@ using namespace ABI::Microsoft::Graphics::Canvas::Effects;
 #include "MockD2DDevice.h"
 #include "MockD2DDeviceContext.h"
 #include "MockD2DFactory.h"
+#include "MockD2DGeometryRealization.h"
 #include "MockD2DSolidColorBrush.h"
 #include "MockD2DStrokeStyle.h"
 #include "MockD2DBitmapBrush.h"
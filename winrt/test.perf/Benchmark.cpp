@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+double GetElapsedNanoseconds(LARGE_INTEGER const& start, LARGE_INTEGER const& end)
+{
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    return static_cast<double>(end.QuadPart - start.QuadPart) * 1e9 / static_cast<double>(frequency.QuadPart);
+}
+
+
+void ReportBenchmarkResult(wchar_t const* name, BenchmarkResult const& result)
+{
+    wchar_t message[256];
+    swprintf_s(message, L"%-60s %10.1f ns/call %8.2f allocations/call", name, result.NanosecondsPerCall, result.AllocationsPerCall);
+
+    Logger::WriteMessage(message);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+//
+// Each benchmark first calls its operation a few times so that whatever it
+// caches (brushes, realized effects, wrappers) is in place, then times it in
+// batches. The median batch is reported, which keeps the odd context switch
+// out of the result.
+//
+const int BenchmarkWarmupCalls = 100;
+const int BenchmarkBatches = 21;
+const int BenchmarkCallsPerBatch = 1000;
+
+struct BenchmarkResult
+{
+    double NanosecondsPerCall;
+    double AllocationsPerCall;
+};
+
+double GetElapsedNanoseconds(LARGE_INTEGER const& start, LARGE_INTEGER const& end);
+
+void ReportBenchmarkResult(wchar_t const* name, BenchmarkResult const& result);
+
+template<typename FN>
+__declspec(noinline) BenchmarkResult RunBenchmark(wchar_t const* name, FN const& operation, int callsPerBatch = BenchmarkCallsPerBatch)
+{
+    for (int i = 0; i < BenchmarkWarmupCalls; i++)
+    {
+        operation();
+    }
+
+    std::array<double, BenchmarkBatches> times;
+    size_t allocationCount = 0;
+
+    for (auto& time : times)
+    {
+        AllocationCounter allocationCounter;
+
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+
+        for (int i = 0; i < callsPerBatch; i++)
+        {
+            operation();
+        }
+
+        LARGE_INTEGER end;
+        QueryPerformanceCounter(&end);
+
+        allocationCount += allocationCounter.GetAllocationCount();
+        time = GetElapsedNanoseconds(start, end);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    BenchmarkResult result;
+    result.NanosecondsPerCall = times[BenchmarkBatches / 2] / callsPerBatch;
+    result.AllocationsPerCall = static_cast<double>(allocationCount) / (static_cast<double>(BenchmarkBatches) * callsPerBatch);
+
+    ReportBenchmarkResult(name, result);
+
+    return result;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "TestBitmapResourceCreationAdapter.h"
+
+//
+// The pixel APIs map the bitmap's texture, which the stub D2D resources
+// cannot do, so these run against a real device using WARP. That keeps them
+// off the GPU, but the copy through the staging texture is included in the
+// timings, which is why the 1x1 subrectangle variants are measured too.
+//
+TEST_CLASS(BitmapBenchmarks)
+{
+    static const int BitmapSize = 64;
+
+    static ComPtr<CanvasBitmap> CreateWarpBitmap()
+    {
+        auto deviceManager = std::make_shared<CanvasDeviceManager>(std::make_shared<DefaultDeviceResourceCreationAdapter>());
+        auto device = deviceManager->CreateNew(CanvasDebugLevel::None, CanvasHardwareAcceleration::Off);
+
+        std::vector<uint8_t> bytes(BitmapSize * BitmapSize * 4);
+
+        auto bitmapManager = std::make_shared<CanvasBitmapManager>(std::make_shared<TestBitmapResourceCreationAdapter>());
+
+        return bitmapManager->CreateNew(
+            device.Get(),
+            static_cast<uint32_t>(bytes.size()),
+            bytes.data(),
+            BitmapSize,
+            BitmapSize,
+            DirectXPixelFormat::B8G8R8A8UIntNormalized,
+            CanvasAlphaMode::Premultiplied,
+            DEFAULT_DPI);
+    }
+
+    TEST_METHOD_EX(CanvasBitmap_PixelBytes)
+    {
+        auto bitmap = CreateWarpBitmap();
+
+        std::vector<uint8_t> bytes(BitmapSize * BitmapSize * 4);
+        uint8_t pixel[4] = {};
+
+        RunBenchmark(L"CanvasBitmap.GetPixelBytes (64x64)", [&]
+        {
+            ComArray<uint8_t> array;
+            ThrowIfFailed(bitmap->GetPixelBytes(array.GetAddressOfSize(), array.GetAddressOfData()));
+        }, 100);
+
+        RunBenchmark(L"CanvasBitmap.GetPixelBytes (1x1)", [&]
+        {
+            ComArray<uint8_t> array;
+            ThrowIfFailed(bitmap->GetPixelBytesWithSubrectangle(0, 0, 1, 1, array.GetAddressOfSize(), array.GetAddressOfData()));
+        }, 100);
+
+        RunBenchmark(L"CanvasBitmap.SetPixelBytes (64x64)", [&]
+        {
+            ThrowIfFailed(bitmap->SetPixelBytes(static_cast<uint32_t>(bytes.size()), bytes.data()));
+        }, 100);
+
+        RunBenchmark(L"CanvasBitmap.SetPixelBytes (1x1)", [&]
+        {
+            ThrowIfFailed(bitmap->SetPixelBytesWithSubrectangle(_countof(pixel), pixel, 0, 0, 1, 1));
+        }, 100);
+    }
+
+    TEST_METHOD_EX(CanvasBitmap_PixelColors)
+    {
+        auto bitmap = CreateWarpBitmap();
+
+        std::vector<Color> colors(BitmapSize * BitmapSize);
+
+        RunBenchmark(L"CanvasBitmap.GetPixelColors (64x64)", [&]
+        {
+            ComArray<Color> array;
+            ThrowIfFailed(bitmap->GetPixelColors(array.GetAddressOfSize(), array.GetAddressOfData()));
+        }, 100);
+
+        RunBenchmark(L"CanvasBitmap.SetPixelColors (64x64)", [&]
+        {
+            ThrowIfFailed(bitmap->SetPixelColors(static_cast<uint32_t>(colors.size()), colors.data()));
+        }, 100);
+    }
+};
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "StubDrawingSessionFixture.h"
+#include "TestBitmapResourceCreationAdapter.h"
+
+TEST_CLASS(DrawingSessionBenchmarks)
+{
+    TEST_METHOD_EX(DrawingSession_Primitives)
+    {
+        StubDrawingSessionFixture f;
+
+        Color color{ 255, 128, 64, 32 };
+        Vector2 point0{ 1, 2 };
+        Vector2 point1{ 30, 40 };
+        Rect rect{ 1, 2, 30, 40 };
+
+        RunBenchmark(L"DrawingSession.Clear", [&]
+        {
+            ThrowIfFailed(f.DS->Clear(color));
+        });
+
+        RunBenchmark(L"DrawingSession.DrawLine (brush)", [&]
+        {
+            ThrowIfFailed(f.DS->DrawLineWithBrush(point0, point1, f.Brush.Get()));
+        });
+
+        RunBenchmark(L"DrawingSession.DrawLine (color)", [&]
+        {
+            ThrowIfFailed(f.DS->DrawLineWithColor(point0, point1, color));
+        });
+
+        RunBenchmark(L"DrawingSession.FillRectangle (color)", [&]
+        {
+            ThrowIfFailed(f.DS->FillRectangleWithColor(rect, color));
+        });
+
+        RunBenchmark(L"DrawingSession.FillEllipse (brush)", [&]
+        {
+            ThrowIfFailed(f.DS->FillEllipseWithBrush(point1, 5, 6, f.Brush.Get()));
+        });
+    }
+
+    TEST_METHOD_EX(DrawingSession_State)
+    {
+        StubDrawingSessionFixture f;
+
+        RunBenchmark(L"DrawingSession.Transform (get and put)", [&]
+        {
+            Numerics::Matrix3x2 transform;
+            ThrowIfFailed(f.DS->get_Transform(&transform));
+            ThrowIfFailed(f.DS->put_Transform(transform));
+        });
+    }
+
+    TEST_METHOD_EX(DrawingSession_DrawImage)
+    {
+        StubDrawingSessionFixture f;
+
+        auto bitmap = CreateStubCanvasBitmap();
+        Vector2 offset{ 10, 20 };
+
+        RunBenchmark(L"DrawingSession.DrawImage (bitmap)", [&]
+        {
+            ThrowIfFailed(f.DS->DrawImage(bitmap.Get(), offset));
+        });
+    }
+
+    //
+    // The stub device context does no text layout of its own, so DrawText here
+    // measures only the Win2D side of the call. The layout D2D would do for it
+    // is the same as what CanvasTextLayout.Create does, so creating a layout
+    // each frame stands in for the full cost of DrawText, to compare against
+    // drawing a layout whose glyph runs were captured up front.
+    //
+    TEST_METHOD_EX(DrawingSession_DrawText_Versus_CachedGlyphRuns)
+    {
+        StubDrawingSessionFixture f;
+
+        auto format = Make<CanvasTextFormat>();
+        auto layoutFactory = Make<CanvasTextLayoutFactory>();
+
+        Color color{ 255, 0, 0, 0 };
+        Vector2 position{ 10, 20 };
+
+        WinString text(L"The quick brown fox");
+        WinString digits(L"12:34.5");
+
+        RunBenchmark(L"DrawingSession.DrawText (Win2D side only)", [&]
+        {
+            ThrowIfFailed(f.DS->DrawTextAtPointWithColorAndFormat(text, position, color, format.Get()));
+        });
+
+        RunBenchmark(L"CanvasTextLayout.Create + DrawTextLayout (per frame)", [&]
+        {
+            ComPtr<ICanvasTextLayout> layout;
+            ThrowIfFailed(layoutFactory->Create(text, format.Get(), 1000, 1000, &layout));
+            ThrowIfFailed(f.DS->DrawTextLayoutWithColor(layout.Get(), position, color));
+        }, 100);
+
+        RunBenchmark(L"CanvasTextLayout.Create + DrawTextLayout (digits)", [&]
+        {
+            ComPtr<ICanvasTextLayout> layout;
+            ThrowIfFailed(layoutFactory->Create(digits, format.Get(), 1000, 1000, &layout));
+            ThrowIfFailed(f.DS->DrawTextLayoutWithColor(layout.Get(), position, color));
+        });
+
+        ComPtr<ICanvasTextLayout> cachedLayout;
+        ThrowIfFailed(layoutFactory->Create(text, format.Get(), 1000, 1000, &cachedLayout));
+
+        RunBenchmark(L"DrawingSession.DrawTextLayout (cached glyph runs)", [&]
+        {
+            ThrowIfFailed(f.DS->DrawTextLayoutWithColor(cachedLayout.Get(), position, color));
+        });
+    }
+};
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "effects\generated\GaussianBlurEffect.h"
+
+#include "StubDrawingSessionFixture.h"
+#include "TestBitmapResourceCreationAdapter.h"
+
+TEST_CLASS(EffectBenchmarks)
+{
+    TEST_METHOD_EX(CanvasEffect_Properties)
+    {
+        auto effect = Make<GaussianBlurEffect>();
+        float blurAmount = 0;
+
+        RunBenchmark(L"CanvasEffect.put_BlurAmount", [&]
+        {
+            blurAmount += 1;
+            ThrowIfFailed(effect->put_BlurAmount(blurAmount));
+        });
+
+        RunBenchmark(L"CanvasEffect.get_BlurAmount", [&]
+        {
+            ThrowIfFailed(effect->get_BlurAmount(&blurAmount));
+        });
+    }
+
+    TEST_METHOD_EX(CanvasEffect_Draw)
+    {
+        StubDrawingSessionFixture f;
+
+        auto effect = Make<GaussianBlurEffect>();
+        ThrowIfFailed(effect->put_Source(As<IEffectInput>(CreateStubCanvasBitmap()).Get()));
+
+        Vector2 offset{ 10, 20 };
+        float blurAmount = 0;
+
+        RunBenchmark(L"DrawingSession.DrawImage (unchanged effect)", [&]
+        {
+            ThrowIfFailed(f.DS->DrawImage(effect.Get(), offset));
+        });
+
+        // Changing a property makes the next draw push every property down
+        // to the D2D effect again.
+        RunBenchmark(L"DrawingSession.DrawImage (effect with a changed property)", [&]
+        {
+            blurAmount += 1;
+            ThrowIfFailed(effect->put_BlurAmount(blurAmount));
+            ThrowIfFailed(f.DS->DrawImage(effect.Get(), offset));
+        });
+    }
+};
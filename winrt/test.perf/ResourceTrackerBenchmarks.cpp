@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "TestBitmapResourceCreationAdapter.h"
+
+TEST_CLASS(ResourceTrackerBenchmarks)
+{
+    TEST_METHOD_EX(ResourceTracker_GetOrCreate)
+    {
+        auto manager = std::make_shared<CanvasBitmapManager>(std::make_shared<TestBitmapResourceCreationAdapter>());
+        auto d2dBitmap = Make<StubD2DBitmap>();
+
+        // While the wrapper is alive, GetOrCreate finds it in the tracker.
+        auto existingWrapper = manager->GetOrCreate(nullptr, d2dBitmap.Get());
+
+        RunBenchmark(L"ResourceTracker.GetOrCreate (existing wrapper)", [&]
+        {
+            auto wrapper = manager->GetOrCreate(nullptr, d2dBitmap.Get());
+        });
+
+        existingWrapper.Reset();
+
+        RunBenchmark(L"ResourceTracker.GetOrCreate (new wrapper)", [&]
+        {
+            auto wrapper = manager->GetOrCreate(nullptr, d2dBitmap.Get());
+        });
+    }
+};